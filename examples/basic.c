@@ -5,6 +5,7 @@
 
 #include "poc_engine.h"
 #include "../src/scripting.h"
+#include "../src/file_watch.h"
 
 int my_main(podi_application *app) {
     poc_config config = (poc_config){
@@ -16,7 +17,9 @@ int my_main(podi_application *app) {
 #endif
         .enable_validation = true,
         .app_name = "POC Engine Basic Example",
-        .app_version = 1
+        .app_version = 1,
+        // Built by `make archive`; unset to read loose files
+        .archive_path = getenv("POC_ASSET_ARCHIVE")
     };
 
     poc_result result = poc_init(&config);
@@ -92,6 +95,9 @@ int my_main(podi_application *app) {
     // The Lua script created scene objects that will be automatically rendered
     printf("✓ Scene objects created and ready for rendering\n");
 
+    // Reload meshes, materials and scripts when they are saved
+    poc_file_watch_start();
+
     const double target_fps = 120.0;
 
     printf("POC Engine basic example running...\n");
@@ -129,6 +135,14 @@ int my_main(podi_application *app) {
     // Resize coalescing: track current window size
     int last_width = framebuffer_width, last_height = framebuffer_height;
 
+    // Simulation runs on this thread; recording and presenting happens on the
+    // frame loop's render thread from published snapshots. Renderers without
+    // snapshot support get no frame loop and draw inline instead
+    poc_frame_loop *frame_loop = poc_frame_loop_create(ctx);
+    if (!frame_loop) {
+        printf("Rendering on the main thread\n");
+    }
+
     while (!podi_application_should_close(app) && !podi_window_should_close(window)) {
         double current_time = poc_get_time();
 
@@ -280,6 +294,11 @@ int my_main(podi_application *app) {
             poc_sleep(remaining_frame_time);
         }
 
+        // Hand finished background mesh loads to their script callbacks, and
+        // swap in meshes and scripts that were edited on disk
+        poc_mesh_dispatch_loads();
+        poc_scripting_dispatch_reloads(scripting);
+
         // Update camera controller with delta time
         double delta_time = target_frame_time;
         poc_scripting_call_function(scripting, "update", "d", delta_time);
@@ -289,25 +308,53 @@ int my_main(podi_application *app) {
         float g = (sinf(color_time + 2.0f) + 1.0f) * 0.5f;
         float b = (sinf(color_time + 4.0f) + 1.0f) * 0.5f;
 
-        result = poc_context_begin_frame(ctx);
-        if (result == POC_RESULT_SUCCESS) {
+        if (frame_loop) {
             poc_context_clear_color(ctx, r, g, b, 1.0f);
-            // Scene objects are automatically rendered in begin_frame
 
-            result = poc_context_end_frame(ctx);
+            // Scene objects are captured and handed to the render thread
+            result = poc_frame_loop_publish(frame_loop);
             if (result != POC_RESULT_SUCCESS) {
-                printf("Failed to end frame: %s\n", poc_result_to_string(result));
+                printf("Failed to publish frame: %s\n", poc_result_to_string(result));
                 break;
             }
         } else {
-            printf("Failed to begin frame: %s\n", poc_result_to_string(result));
-            break;
+            result = poc_context_begin_frame(ctx);
+            if (result == POC_RESULT_SUCCESS) {
+                poc_context_clear_color(ctx, r, g, b, 1.0f);
+                // Scene objects are automatically rendered in begin_frame
+
+                result = poc_context_end_frame(ctx);
+                if (result != POC_RESULT_SUCCESS) {
+                    printf("Failed to end frame: %s\n", poc_result_to_string(result));
+                    break;
+                }
+            } else {
+                printf("Failed to begin frame: %s\n", poc_result_to_string(result));
+                break;
+            }
         }
 
         last_frame_time = current_time;
         frame_count++;
     }
 
+    if (frame_loop) {
+        poc_frame_loop_stats loop_stats;
+        poc_frame_loop_get_stats(frame_loop, &loop_stats);
+        printf("Frames: %llu published, %llu rendered, %llu dropped (sim %.2f ms, render %.2f ms)\n",
+               (unsigned long long)loop_stats.frames_published,
+               (unsigned long long)loop_stats.frames_rendered,
+               (unsigned long long)loop_stats.frames_dropped,
+               loop_stats.avg_sim_frame_ms, loop_stats.avg_render_frame_ms);
+        poc_frame_loop_destroy(frame_loop);
+    }
+
+    uint64_t triangles_submitted, triangles_total;
+    poc_context_get_triangle_counts(ctx, &triangles_submitted, &triangles_total);
+    printf("Last frame: %llu of %llu triangles submitted after cluster culling, %u draw calls\n",
+           (unsigned long long)triangles_submitted, (unsigned long long)triangles_total,
+           poc_context_get_draw_call_count(ctx));
+
     poc_scripting_shutdown(scripting);
     poc_context_destroy(ctx);
     podi_window_destroy(window);
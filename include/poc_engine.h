@@ -128,6 +128,7 @@ typedef struct {
     bool enable_validation;             /**< Enable validation layers (debug builds) */
     const char *app_name;               /**< Application name (must not be NULL) */
     uint32_t app_version;               /**< Application version number */
+    const char *archive_path;           /**< Packed asset archive to read files from, NULL for loose files only */
 } poc_config;
 
 /**
@@ -261,6 +262,20 @@ poc_result poc_context_load_model(poc_context *ctx, const char *obj_filename);
  */
 poc_renderable *poc_context_create_renderable(poc_context *ctx, const char *name);
 
+/**
+ * @brief Create a renderable that shares another renderable's geometry
+ *
+ * The clone references the source's vertex and index buffers (refcounted, so
+ * either may be destroyed first) and gets its own uniform buffer, transform
+ * and material copy. No mesh data is uploaded.
+ *
+ * @param ctx The rendering context that owns the source. Must not be NULL.
+ * @param source Renderable to share geometry with. Must not be NULL.
+ * @param name Optional name for the clone. Can be NULL.
+ * @return Pointer to the new renderable on success, or NULL on failure
+ */
+poc_renderable *poc_context_clone_renderable(poc_context *ctx, const poc_renderable *source, const char *name);
+
 /**
  * @brief Destroy a renderable object
  *
@@ -275,6 +290,14 @@ poc_renderable *poc_context_create_renderable(poc_context *ctx, const char *name
  */
 void poc_context_destroy_renderable(poc_context *ctx, poc_renderable *renderable);
 
+/**
+ * @brief Get the debug name of a renderable
+ *
+ * @param renderable The renderable. Can be NULL.
+ * @return Name string (never NULL)
+ */
+const char *poc_renderable_get_name(const poc_renderable *renderable);
+
 /**
  * @brief Load a 3D model into a renderable object
  *
@@ -302,6 +325,9 @@ poc_result poc_renderable_load_model(poc_renderable *renderable, const char *obj
  *
  * @note This allows loading mesh data that's already in memory, unlike
  *       poc_renderable_load_model which loads from a file.
+ * @note The new data goes into new GPU buffers. While a frame loop is
+ *       running, the old buffers stay alive until every snapshot that
+ *       referenced them has been drawn, so this is safe between publishes.
  */
 poc_result poc_renderable_load_mesh(poc_renderable *renderable, poc_mesh *mesh);
 
@@ -319,6 +345,17 @@ poc_result poc_renderable_load_mesh(poc_renderable *renderable, poc_mesh *mesh);
  */
 void poc_renderable_set_transform(poc_renderable *renderable, mat4 transform);
 
+/**
+ * @brief Get the transformation matrix a renderable is drawn with
+ *
+ * A renderable owned by a scene object receives the object's transform when
+ * it is next drawn on the calling thread, not when the object moves.
+ *
+ * @param renderable The renderable object. Can be NULL (yields identity).
+ * @param transform Receives the 4x4 transformation matrix
+ */
+void poc_renderable_get_transform(const poc_renderable *renderable, mat4 transform);
+
 /**
  * @brief Get a human-readable string for a result code
  *
@@ -342,7 +379,8 @@ const char *poc_result_to_string(poc_result result);
  * @return Elapsed time in seconds as a double-precision floating point value
  *
  * @note Resolution depends on the system clock, typically nanosecond precision.
- * @warning Only valid after poc_init() has been called.
+ * @note Before poc_init() (e.g. in tools that never open a window) the time
+ *       counts from an arbitrary fixed point, so differences stay valid.
  */
 double poc_get_time(void);
 
@@ -400,6 +438,9 @@ void poc_scene_object_destroy(poc_scene_object *obj);
 /**
  * @brief Load a mesh from an OBJ file
  *
+ * Every call parses the file into a new mesh owned by the caller. Use
+ * poc_asset_acquire_mesh() to share one copy between users.
+ *
  * @param filename Path to the OBJ file
  * @return Pointer to loaded mesh, or NULL on failure
  */
@@ -412,6 +453,226 @@ poc_mesh* poc_mesh_load(const char *filename);
  */
 void poc_mesh_destroy(poc_mesh *mesh);
 
+/**
+ * @brief Get the asset path a mesh was loaded from
+ *
+ * @param mesh The mesh
+ * @return Source path, or "" for meshes built in memory
+ */
+const char* poc_mesh_get_source_path(const poc_mesh *mesh);
+
+/**
+ * @brief Get the CPU memory a mesh currently holds
+ *
+ * Data mapped from a cooked file counts only its resident pages; released
+ * data counts nothing.
+ *
+ * @param mesh The mesh
+ * @return Resident bytes
+ */
+uint64_t poc_mesh_get_resident_bytes(const poc_mesh *mesh);
+
+/**
+ * @brief Release mesh geometry once a renderable has uploaded it
+ *
+ * Off by default. Meshes backed by a cooked file then keep only bounds and
+ * submesh tables on the CPU, and map the file again if another renderable
+ * needs the data.
+ *
+ * @param enabled Whether renderables release geometry after upload
+ */
+void poc_mesh_set_release_after_upload(bool enabled);
+
+/**
+ * @brief Weak reference to a managed mesh
+ *
+ * Does not keep the mesh alive; resolve it with poc_asset_lock_mesh().
+ */
+typedef struct {
+    uint32_t index;       /**< Registry slot, UINT32_MAX for none */
+    uint32_t generation;  /**< Slot generation the handle was taken at */
+} poc_asset_handle;
+
+/**
+ * @brief Asset manager counters
+ */
+typedef struct {
+    uint32_t mesh_count;        /**< Meshes resident in the registry */
+    uint32_t referenced_count;  /**< Resident meshes with at least one reference */
+    uint64_t loaded_bytes;      /**< Vertex, index and submesh bytes of resident meshes */
+    uint64_t resident_bytes;    /**< Part of loaded_bytes actually in CPU memory (see poc_mesh_get_resident_bytes()) */
+    uint64_t hits;              /**< Acquires served from the registry */
+    uint64_t misses;            /**< Acquires that had to load the file */
+    uint64_t purged;            /**< Meshes destroyed by poc_asset_purge() */
+    uint64_t reloads;           /**< Meshes replaced after their files changed on disk */
+    double last_reload_ms;      /**< Time from noticing the last change to the swapped-in mesh being uploaded */
+} poc_asset_stats;
+
+/**
+ * @brief Get a shared mesh for a file, loading it on first use
+ *
+ * The path is normalized, so "models/a.obj" and "./models//a.obj" share a
+ * mesh. Each successful call adds a reference that must be dropped with
+ * poc_asset_release_mesh(); never pass the mesh to poc_mesh_destroy().
+ *
+ * @param path Path to the OBJ file
+ * @return Shared mesh, or NULL if it could not be loaded
+ */
+poc_mesh *poc_asset_acquire_mesh(const char *path);
+
+/**
+ * @brief Add a reference to a mesh (no-op for unmanaged meshes)
+ *
+ * @param mesh Mesh to retain (can be NULL)
+ */
+void poc_asset_retain_mesh(poc_mesh *mesh);
+
+/**
+ * @brief Drop a reference to a mesh (no-op for unmanaged meshes)
+ *
+ * Unreferenced meshes stay resident until poc_asset_purge().
+ *
+ * @param mesh Mesh to release (can be NULL)
+ */
+void poc_asset_release_mesh(poc_mesh *mesh);
+
+/**
+ * @brief Get a weak handle to a managed mesh
+ *
+ * @param mesh Mesh to name
+ * @return Handle, with index UINT32_MAX if the mesh is not managed
+ */
+poc_asset_handle poc_asset_get_handle(const poc_mesh *mesh);
+
+/**
+ * @brief Resolve a weak handle into a new reference
+ *
+ * @param handle Handle from poc_asset_get_handle()
+ * @return Retained mesh, or NULL if it has been purged
+ */
+poc_mesh *poc_asset_lock_mesh(poc_asset_handle handle);
+
+/**
+ * @brief Destroy every mesh that has no references left
+ *
+ * @return Number of meshes destroyed
+ */
+uint32_t poc_asset_purge(void);
+
+/**
+ * @brief Read asset manager counters
+ *
+ * @param stats Output statistics
+ */
+void poc_asset_get_stats(poc_asset_stats *stats);
+
+/**
+ * @brief Pending asynchronous mesh load
+ */
+typedef struct poc_mesh_request poc_mesh_request;
+
+/**
+ * @brief Called from poc_mesh_dispatch_loads() when a load finishes
+ *
+ * @param request The finished request
+ * @param mesh Shared mesh, or NULL if loading failed; retain it to keep it
+ *             past the request
+ * @param user_data Pointer passed to poc_mesh_load_async()
+ */
+typedef void (*poc_mesh_load_callback)(poc_mesh_request *request, poc_mesh *mesh, void *user_data);
+
+/**
+ * @brief Start loading a shared mesh on the job system
+ *
+ * Parsing and cooking run on a worker thread; the GPU upload happens when the
+ * mesh is attached to a scene object. Requests for a resident mesh finish
+ * immediately, and requests for a file that is already loading join that
+ * load. The request holds a reference to the mesh until it is released.
+ *
+ * @param path Path to the OBJ file
+ * @param callback Called on the thread running poc_mesh_dispatch_loads()
+ *                 (can be NULL to poll or wait instead)
+ * @param user_data Passed to @p callback
+ * @return Request to release with poc_mesh_request_release(), or NULL
+ */
+poc_mesh_request *poc_mesh_load_async(const char *path, poc_mesh_load_callback callback, void *user_data);
+
+/**
+ * @brief Check whether a request has finished, successfully or not
+ *
+ * @param request The request
+ * @return true once the load is over
+ */
+bool poc_mesh_request_is_done(const poc_mesh_request *request);
+
+/**
+ * @brief Block until a request finishes
+ *
+ * Runs queued jobs while waiting. Must not be called from inside a job.
+ *
+ * @param request The request
+ * @return Mesh borrowed from the request, or NULL if loading failed
+ */
+poc_mesh *poc_mesh_request_wait(poc_mesh_request *request);
+
+/**
+ * @brief Get the mesh of a finished request without waiting
+ *
+ * @param request The request
+ * @return Mesh borrowed from the request, or NULL if pending or failed
+ */
+poc_mesh *poc_mesh_request_get_mesh(const poc_mesh_request *request);
+
+/**
+ * @brief Drop a request and its mesh reference
+ *
+ * A callback that has not run yet is cancelled.
+ *
+ * @param request Request to release (can be NULL)
+ */
+void poc_mesh_request_release(poc_mesh_request *request);
+
+/**
+ * @brief Run callbacks of finished loads on the calling thread
+ *
+ * Also swaps in meshes reloaded after their files changed and notifies the
+ * reload listeners. Call once per frame from the main thread.
+ *
+ * @return Number of callbacks run and meshes reloaded
+ */
+uint32_t poc_mesh_dispatch_loads(void);
+
+/**
+ * @brief Called from poc_mesh_dispatch_loads() after a mesh was reloaded
+ *
+ * The mesh keeps its address; its geometry, submeshes, materials and bounds
+ * were replaced in place. Anything derived from them (GPU buffers, cached
+ * bounds) has to be rebuilt.
+ *
+ * @param mesh The reloaded shared mesh
+ * @param user_data Pointer passed to poc_asset_add_reload_listener()
+ */
+typedef void (*poc_asset_reload_callback)(poc_mesh *mesh, void *user_data);
+
+/**
+ * @brief Get told when a shared mesh is replaced by a newer version
+ *
+ * While the file watcher runs (see file_watch.h), a change to a mesh's OBJ or
+ * to one of its MTL libraries parses the mesh again on the job system. The
+ * result is swapped in by poc_mesh_dispatch_loads(), which then calls every
+ * listener. A file that fails to parse leaves the previous version in place.
+ *
+ * @param callback Function to call
+ * @param user_data Passed to @p callback
+ * @return true on success
+ */
+bool poc_asset_add_reload_listener(poc_asset_reload_callback callback, void *user_data);
+
+/**
+ * @brief Remove a listener added with poc_asset_add_reload_listener()
+ */
+void poc_asset_remove_reload_listener(poc_asset_reload_callback callback, void *user_data);
+
 /**
  * @brief Set the mesh component of a scene object
  *
@@ -420,6 +681,22 @@ void poc_mesh_destroy(poc_mesh *mesh);
  */
 void poc_scene_object_set_mesh(poc_scene_object *obj, poc_mesh *mesh);
 
+/**
+ * @brief Get the name of a scene object
+ *
+ * @param obj The scene object
+ * @return Name string (never NULL)
+ */
+const char* poc_scene_object_get_name(const poc_scene_object *obj);
+
+/**
+ * @brief Rename a scene object
+ *
+ * @param obj The scene object
+ * @param name New name (NULL clears it)
+ */
+void poc_scene_object_set_name(poc_scene_object *obj, const char *name);
+
 /**
  * @brief Set the position of a scene object
  *
@@ -490,12 +767,158 @@ uint32_t poc_scene_get_next_object_id(poc_scene *scene);
 /**
  * @brief Update all objects in the scene
  *
- * Updates transforms and bounds for all dirty objects.
+ * Updates transforms and bounds for objects changed since the last update;
+ * unchanged objects are not visited.
  *
  * @param scene The scene
  */
 void poc_scene_update(poc_scene *scene);
 
+/**
+ * @brief Get the number of objects changed in the last poc_scene_update
+ *
+ * @param scene The scene
+ * @return Number of changed objects
+ */
+uint32_t poc_scene_get_changed_count(const poc_scene *scene);
+
+/**
+ * @brief Scene memory breakdown
+ *
+ * CPU-side bytes only; GPU buffers held by renderables are not included.
+ */
+typedef struct poc_scene_memory_stats {
+    uint32_t object_count;          /**< Objects in the scene */
+    uint64_t object_bytes;          /**< Object structs, child arrays and prefab instance state */
+    uint64_t bookkeeping_bytes;     /**< Scene arrays: object list, change lists and mesh entries */
+    uint32_t mesh_count;            /**< Distinct meshes referenced by objects */
+    uint64_t mesh_bytes;            /**< Those meshes' structs plus owned vertex and index data */
+    uint32_t string_count;          /**< Strings in the process-wide intern table */
+    uint64_t string_bytes;          /**< Intern table size (shared by every scene) */
+} poc_scene_memory_stats;
+
+/**
+ * @brief Measure the memory a scene uses
+ *
+ * Walks every object; intended for diagnostics, not per-frame use.
+ *
+ * @param scene The scene
+ * @param stats Output statistics
+ */
+void poc_scene_get_memory_stats(const poc_scene *scene, poc_scene_memory_stats *stats);
+
+/**
+ * @brief Two scene objects whose world bounds overlap
+ */
+typedef struct poc_overlap_pair {
+    uint32_t a_id;          /**< ID of the first object */
+    uint32_t b_id;          /**< ID of the second object */
+    poc_scene_object *a;    /**< First object, or NULL if it has left the scene */
+    poc_scene_object *b;    /**< Second object, or NULL if it has left the scene */
+} poc_overlap_pair;
+
+/**
+ * @brief Overlap changes produced by one poc_scene_update()
+ *
+ * The arrays belong to the scene and stay valid until its next update.
+ */
+typedef struct poc_overlap_events {
+    const poc_overlap_pair *enter;  /**< Pairs that started overlapping */
+    uint32_t enter_count;           /**< Number of entered pairs */
+    const poc_overlap_pair *stay;   /**< Pairs that kept overlapping */
+    uint32_t stay_count;            /**< Number of staying pairs */
+    const poc_overlap_pair *exit;   /**< Pairs that stopped overlapping or lost an object */
+    uint32_t exit_count;            /**< Number of exited pairs */
+    uint32_t pair_count;            /**< Overlapping pairs after the update */
+    double update_ms;               /**< Time the broadphase took in that update */
+} poc_overlap_events;
+
+/**
+ * @brief Receives the overlap events of each poc_scene_update()
+ *
+ * @param scene     Scene that was updated
+ * @param events    Events of this update
+ * @param user_data Pointer given to poc_scene_enable_overlaps()
+ */
+typedef void (*poc_overlap_callback)(poc_scene *scene, const poc_overlap_events *events, void *user_data);
+
+/**
+ * @brief Start tracking overlapping objects in a scene
+ *
+ * Every later poc_scene_update() refreshes the broadphase from the objects
+ * that changed and reports which pairs of world AABBs started, kept or
+ * stopped overlapping. Only enabled objects with a mesh take part. Calling
+ * this again replaces the callback.
+ *
+ * @param scene     The scene
+ * @param callback  Called once per update with that update's events (can be NULL)
+ * @param user_data Passed to the callback
+ * @return True on success
+ */
+bool poc_scene_enable_overlaps(poc_scene *scene, poc_overlap_callback callback, void *user_data);
+
+/**
+ * @brief Stop tracking overlaps and free the broadphase
+ *
+ * @param scene The scene
+ */
+void poc_scene_disable_overlaps(poc_scene *scene);
+
+/**
+ * @brief Get the overlap events of the last poc_scene_update()
+ *
+ * @param scene  The scene
+ * @param events Output events (all empty if overlaps are not enabled)
+ * @return True if overlaps are enabled for the scene
+ */
+bool poc_scene_get_overlap_events(const poc_scene *scene, poc_overlap_events *events);
+
+/**
+ * @brief Find enabled objects whose world bounds overlap a box
+ *
+ * Queries use a loose spatial hash that the first query builds and every
+ * later poc_scene_update() keeps current, so they see the bounds of the last
+ * update. Objects without a mesh count as a point at their position. Cost
+ * depends on the size of the queried region, not on the scene.
+ *
+ * @param scene       The scene
+ * @param min         Box minimum corner
+ * @param max         Box maximum corner
+ * @param results     Receives matching objects (can be NULL to only count)
+ * @param max_results Capacity of results
+ * @return Number of matches; if larger than max_results, only max_results were written
+ */
+uint32_t poc_scene_query_aabb(poc_scene *scene, vec3 min, vec3 max,
+                              poc_scene_object **results, uint32_t max_results);
+
+/**
+ * @brief Find enabled objects whose world bounds are within a radius of a point
+ *
+ * @param scene       The scene
+ * @param center      Sphere center
+ * @param radius      Sphere radius
+ * @param results     Receives matching objects (can be NULL to only count)
+ * @param max_results Capacity of results
+ * @return Number of matches; if larger than max_results, only max_results were written
+ */
+uint32_t poc_scene_query_sphere(poc_scene *scene, vec3 center, float radius,
+                                poc_scene_object **results, uint32_t max_results);
+
+/**
+ * @brief Find the k enabled objects whose world bounds are nearest to a point
+ *
+ * Distance is measured to each object's AABB (0 inside it).
+ *
+ * @param scene     The scene
+ * @param point     Query point
+ * @param k         Number of objects wanted
+ * @param results   Receives the objects, nearest first (k entries)
+ * @param distances Receives their distances (k entries)
+ * @return Number of objects written, at most k
+ */
+uint32_t poc_scene_query_knn(poc_scene *scene, vec3 point, uint32_t k,
+                             poc_scene_object **results, float *distances);
+
 /**
  * @brief Perform picking ray cast against all objects in the scene
  *
@@ -519,11 +942,42 @@ bool poc_scene_pick_object(poc_scene *scene,
  */
 bool poc_scene_save_to_file(const poc_scene *scene, const char *path);
 
+/**
+ * @brief Save a scene, appending only what changed since the previous call.
+ *
+ * The first call (or the first after switching paths) writes a full base file.
+ * Later calls append binary records for created, deleted and changed objects
+ * to "<path>.journal", so their cost scales with the edit rather than the
+ * scene. Once the journal grows past half the base size it is folded into a
+ * new base on a job system worker. poc_scene_load_from_file() replays the
+ * journal transparently.
+ *
+ * @param scene Scene to save; keeps tracking changes until destroyed.
+ * @param path  Target base file path.
+ * @return true on success, false otherwise.
+ */
+bool poc_scene_save_incremental(poc_scene *scene, const char *path);
+
+/**
+ * @brief Save a scene partitioned into a square XZ grid for world streaming.
+ *
+ * Objects are grouped into cells by the position of their hierarchy root.
+ * The file still loads with poc_scene_load_from_file(); poc_world_stream_open()
+ * streams it cell by cell instead.
+ *
+ * @param scene     Scene to serialize.
+ * @param path      Target file path.
+ * @param cell_size Edge length of a grid cell in world units (> 0).
+ * @return true on success, false otherwise.
+ */
+bool poc_scene_save_partitioned(const poc_scene *scene, const char *path, float cell_size);
+
 /**
  * @brief Load a scene from disk.
  *
- * The returned scene owns meshes loaded from disk and must be destroyed with
- * poc_scene_destroy(scene, true) when no longer needed.
+ * Changes saved with poc_scene_save_incremental() are replayed from the
+ * file's journal. The returned scene owns meshes loaded from disk and must be
+ * destroyed with poc_scene_destroy(scene, true) when no longer needed.
  *
  * @param path Source file path.
  * @return Newly allocated scene pointer, or NULL on failure.
@@ -550,6 +1004,110 @@ poc_scene* poc_scene_clone(const poc_scene *scene);
  */
 bool poc_scene_copy_from(poc_scene *dest, const poc_scene *source);
 
+/**
+ * @brief In-memory snapshot of a scene's object state
+ *
+ * Holds per-object fields (identity, name, transform, flags, mesh and material
+ * references, hierarchy) in flat arrays. Meshes are referenced, not copied.
+ */
+typedef struct poc_scene_snapshot poc_scene_snapshot;
+
+/**
+ * @brief Capture the object state of a scene without touching disk.
+ *
+ * @param scene Scene to capture.
+ * @return Newly allocated snapshot, or NULL on failure.
+ */
+poc_scene_snapshot* poc_scene_snapshot_capture(const poc_scene *scene);
+
+/**
+ * @brief Build a new scene from a snapshot.
+ *
+ * Objects reference the snapshot's meshes, and each new renderable shares the
+ * captured object's GPU buffers via poc_context_clone_renderable() instead of
+ * re-uploading the mesh, so call this while the captured objects are still
+ * alive (typically right after capture). The new scene does not own any
+ * meshes; destroy it with poc_scene_destroy(scene, true) before the captured
+ * scene releases them.
+ *
+ * @param snapshot Snapshot to instantiate.
+ * @return Newly allocated scene, or NULL on failure.
+ */
+poc_scene* poc_scene_snapshot_instantiate(const poc_scene_snapshot *snapshot);
+
+/**
+ * @brief Restore a scene to the state recorded in a snapshot.
+ *
+ * Objects that still exist are restored in place and only flagged dirty if
+ * they changed; objects created since the capture are destroyed and captured
+ * objects that were destroyed are recreated.
+ *
+ * @param scene    Scene the snapshot was captured from.
+ * @param snapshot Snapshot to restore.
+ * @return true on success, false on allocation failure.
+ */
+bool poc_scene_snapshot_restore(poc_scene *scene, const poc_scene_snapshot *snapshot);
+
+/**
+ * @brief Free a snapshot.
+ */
+void poc_scene_snapshot_destroy(poc_scene_snapshot *snapshot);
+
+/**
+ * @brief Immutable object hierarchy shared by all of its instances
+ */
+typedef struct poc_prefab poc_prefab;
+
+/**
+ * @brief Load a prefab template from a scene file or a GLB model.
+ *
+ * Each path is loaded once per process; later calls return the same prefab
+ * with another reference. Its meshes are shared by every instance. A .glb
+ * file's default scene becomes the template: one node per glTF node, each
+ * with the glTF mesh it references ("model.glb#N").
+ *
+ * @param path Scene file holding the template objects, or a .glb file.
+ * @return Prefab with one reference for the caller, or NULL on failure.
+ */
+poc_prefab* poc_prefab_load(const char *path);
+
+/**
+ * @brief Drop a prefab reference taken by poc_prefab_load().
+ */
+void poc_prefab_release(poc_prefab *prefab);
+
+/**
+ * @brief Create a prefab instance root object.
+ *
+ * The root holds only its transform, a prefab reference and per-node
+ * overrides. Once added to a scene, the next poc_scene_update() expands the
+ * template into child objects placed relative to the root (only within the
+ * range set by poc_scene_set_prefab_range(), if any); they are removed and
+ * destroyed with the root. Scene files store the root with a prefab="path"
+ * line plus an [override] section per changed node.
+ *
+ * @param prefab Template to instantiate (the instance takes its own reference).
+ * @param name   Name of the root object.
+ * @param id     Object ID of the root.
+ * @return New root object, or NULL on failure.
+ */
+poc_scene_object* poc_prefab_instantiate(poc_prefab *prefab, const char *name, uint32_t id);
+
+/**
+ * @brief Keep prefab instances collapsed outside a sphere.
+ *
+ * Instances farther than @p radius from @p center stay collapsed: only the
+ * root and its overrides are in memory, and nothing of the instance is drawn
+ * or found by queries. Expanded instances that end up beyond 1.25 * @p radius
+ * collapse again, keeping node edits as overrides and destroying the node
+ * objects. Call every frame with the camera position.
+ *
+ * @param scene  The scene.
+ * @param center Center of the expansion range.
+ * @param radius Expansion radius, or 0 (the default) to expand every instance.
+ */
+void poc_scene_set_prefab_range(poc_scene *scene, const vec3 center, float radius);
+
 /**
  * @brief Set the active scene for a rendering context
  *
@@ -600,6 +1158,190 @@ void poc_context_set_play_mode(poc_context *ctx, bool enabled);
  */
 bool poc_context_is_play_mode(poc_context *ctx);
 
+/**
+ * @brief Query how many draw calls the last recorded frame issued
+ *
+ * A mesh is drawn with one call per material range, so this is the sum of
+ * the submesh counts of everything that was rendered.
+ *
+ * @param ctx Rendering context to inspect
+ * @return Draw calls of the last frame, 0 if nothing has been rendered
+ */
+uint32_t poc_context_get_draw_call_count(poc_context *ctx);
+
+/**
+ * @brief Enable or disable culling of mesh clusters
+ *
+ * On by default. Meshes are split into clusters of up to 128 triangles at
+ * import; each frame, clusters outside the camera frustum or facing away
+ * from the camera are skipped. Turn it off to compare against drawing
+ * every triangle.
+ *
+ * @param ctx Rendering context to configure
+ * @param enabled Whether clusters are culled
+ */
+void poc_context_set_cluster_culling(poc_context *ctx, bool enabled);
+
+/**
+ * @brief Query how many triangles the last recorded frame drew
+ *
+ * @param ctx Rendering context to inspect
+ * @param submitted Receives the triangles submitted after cluster culling (optional)
+ * @param total Receives the triangles of every renderable that was drawn (optional)
+ */
+void poc_context_get_triangle_counts(poc_context *ctx, uint64_t *submitted, uint64_t *total);
+
+
+/**
+ * @brief Opaque handle to a threaded frame loop
+ *
+ * A frame loop owns a render thread that draws snapshots of the context's
+ * active scene, so simulation of frame N+1 overlaps recording and submission
+ * of frame N.
+ */
+typedef struct poc_frame_loop poc_frame_loop;
+
+/**
+ * @brief Frame loop timing and throughput counters
+ */
+typedef struct {
+    uint64_t frames_published;      /**< Snapshots published by the simulation thread */
+    uint64_t frames_rendered;       /**< Snapshots drawn by the render thread */
+    uint64_t frames_dropped;        /**< Snapshots superseded before the render thread took them */
+    double avg_sim_frame_ms;        /**< Average time between publishes on the simulation thread */
+    double avg_render_frame_ms;     /**< Average time to record, submit and present one snapshot */
+} poc_frame_loop_stats;
+
+/**
+ * @brief Start a render thread for a context
+ *
+ * While the loop exists the context must not be driven with
+ * poc_context_begin_frame()/poc_context_end_frame(); call
+ * poc_frame_loop_publish() once per simulation step instead.
+ *
+ * Returns NULL when the renderer cannot draw from snapshots (currently Metal);
+ * keep driving the context with poc_context_begin_frame()/poc_context_end_frame()
+ * in that case.
+ *
+ * @param ctx Rendering context the render thread draws to
+ * @return New frame loop, or NULL if unsupported or on failure
+ */
+poc_frame_loop *poc_frame_loop_create(poc_context *ctx);
+
+/**
+ * @brief Stop the render thread and return the context to single-threaded use
+ *
+ * @param loop Frame loop to destroy (can be NULL)
+ */
+void poc_frame_loop_destroy(poc_frame_loop *loop);
+
+/**
+ * @brief Publish the current scene state to the render thread
+ *
+ * Updates the active scene, captures transforms, renderables and camera into
+ * a snapshot and hands it over without blocking. If the render thread is still
+ * busy, an older unpublished snapshot is replaced.
+ *
+ * @param loop Frame loop to publish to
+ * @return POC_RESULT_SUCCESS on success, or the error the render thread hit
+ */
+poc_result poc_frame_loop_publish(poc_frame_loop *loop);
+
+/**
+ * @brief Read frame loop statistics
+ *
+ * @param loop Frame loop to inspect
+ * @param stats Output statistics
+ */
+void poc_frame_loop_get_stats(const poc_frame_loop *loop, poc_frame_loop_stats *stats);
+
+
+/**
+ * @brief Opaque handle to a streamed, cell-partitioned world
+ */
+typedef struct poc_world_stream poc_world_stream;
+
+/**
+ * @brief World streaming parameters
+ *
+ * Distances are measured in the XZ plane from the camera to the nearest point
+ * of a cell. Keeping unload_radius above load_radius gives hysteresis so cells
+ * on the boundary do not thrash.
+ */
+typedef struct {
+    float load_radius;              /**< Cells closer than this are requested */
+    float unload_radius;            /**< Resident cells farther than this are evicted */
+    uint64_t memory_budget_bytes;   /**< Mesh memory for streamed cells (0 = unlimited) */
+    uint32_t max_loads_in_flight;   /**< Concurrent background cell loads */
+    double integrate_budget_ms;     /**< Time per update spent creating objects and uploading meshes */
+} poc_world_stream_config;
+
+/**
+ * @brief World streaming counters
+ */
+typedef struct {
+    uint32_t cells_total;           /**< Cells in the world file */
+    uint32_t cells_resident;        /**< Cells whose objects are in the scene */
+    uint32_t cells_loading;         /**< Cells being read, or waiting to be integrated */
+    uint64_t cells_evicted;         /**< Cells evicted since the stream was opened */
+    uint32_t objects_resident;      /**< Streamed objects currently in the scene */
+    uint64_t resident_bytes;        /**< Mesh memory held by the stream */
+    uint64_t memory_budget_bytes;   /**< Configured budget (0 = unlimited) */
+    double last_update_ms;          /**< Time spent in the last poc_world_stream_update() */
+    double max_update_ms;           /**< Longest poc_world_stream_update() so far */
+} poc_world_stream_stats;
+
+/**
+ * @brief Fill a streaming configuration with defaults
+ *
+ * @param config Configuration to initialize
+ */
+void poc_world_stream_config_defaults(poc_world_stream_config *config);
+
+/**
+ * @brief Open a partitioned scene file for streaming into a scene
+ *
+ * Only the cell directory is read here; cells load on later updates. The
+ * stream owns the objects it adds to the scene and holds references to their
+ * meshes; close the stream before destroying the scene.
+ *
+ * @param path   Scene file written by poc_scene_save_partitioned()
+ * @param scene  Scene that receives streamed objects
+ * @param config Streaming parameters, or NULL for defaults
+ * @return New stream, or NULL if the file is missing or not partitioned
+ */
+poc_world_stream *poc_world_stream_open(const char *path, poc_scene *scene, const poc_world_stream_config *config);
+
+/**
+ * @brief Stop streaming and remove every streamed object from the scene
+ *
+ * Waits for in-flight background loads.
+ *
+ * @param stream Stream to close (can be NULL)
+ */
+void poc_world_stream_close(poc_world_stream *stream);
+
+/**
+ * @brief Advance streaming for the current camera position
+ *
+ * Integrates finished background loads within the time budget, requests
+ * cells entering the load radius and evicts cells outside the unload radius
+ * or over the memory budget. Call once per frame from the thread that owns
+ * the scene.
+ *
+ * @param stream          Stream to update
+ * @param camera_position Current camera position
+ */
+void poc_world_stream_update(poc_world_stream *stream, const vec3 camera_position);
+
+/**
+ * @brief Read streaming statistics
+ *
+ * @param stream Stream to inspect
+ * @param stats  Output statistics
+ */
+void poc_world_stream_get_stats(const poc_world_stream *stream, poc_world_stream_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -354,8 +354,14 @@ function ObjectPicker:set_editor_fps_mode(enabled)
     end
 end
 
--- Create global instance
-local picker = ObjectPicker.new()
+-- Create global instance. When the engine reloads this file after an edit,
+-- keep the picker and the scene it built and only swap in the new methods.
+if object_picker_instance then
+    setmetatable(object_picker_instance, ObjectPicker)
+else
+    object_picker_instance = ObjectPicker.new()
+end
+local picker = object_picker_instance
 
 -- Export functions for the engine to call
 function process_mouse_button(button, pressed, x, y, width, height)
@@ -0,0 +1,388 @@
+#define _DEFAULT_SOURCE
+#include "asset_archive.h"
+#include "asset_manager.h"
+#include "file_map.h"
+#include "mesh_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * File layout: header, index sorted by path, path strings, then the file
+ * data with every entry on a POC_ARCHIVE_ALIGNMENT boundary. Native byte
+ * order, like the cooked mesh format.
+ */
+
+#define POCPAK_MAGIC "POCPAK"
+#define POCPAK_VERSION 1
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t entry_count;
+    uint64_t file_size;
+    uint64_t index_offset;
+    uint64_t string_offset;
+    uint64_t string_size;
+} pocpak_header;
+
+typedef struct {
+    uint64_t data_offset;
+    uint64_t size;
+    uint32_t path_offset;
+    uint32_t path_length;
+} pocpak_entry;
+
+static poc_file_map g_archive;
+static const pocpak_header *g_header = NULL;
+
+/*
+ * Lookup
+ */
+
+// Same order as strcmp() on the NUL-terminated paths
+static int compare_path(const char *a, size_t a_length, const char *b, size_t b_length) {
+    int order = memcmp(a, b, a_length < b_length ? a_length : b_length);
+    if (order != 0) {
+        return order;
+    }
+    return a_length < b_length ? -1 : a_length > b_length;
+}
+
+bool poc_archive_find(const char *path, const char **data, size_t *size) {
+    char normalized[POC_ASSET_PATH_MAX];
+    if (!g_header || !path || !poc_asset_normalize_path(path, normalized, sizeof(normalized))) {
+        return false;
+    }
+    size_t length = strlen(normalized);
+
+    const pocpak_entry *entries = (const pocpak_entry *)(g_archive.data + g_header->index_offset);
+    const char *strings = g_archive.data + g_header->string_offset;
+    uint32_t low = 0;
+    uint32_t high = g_header->entry_count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        const pocpak_entry *entry = &entries[middle];
+        int order = compare_path(strings + entry->path_offset, entry->path_length, normalized, length);
+        if (order == 0) {
+            if (data) {
+                *data = entry->size > 0 ? g_archive.data + entry->data_offset : NULL;
+            }
+            if (size) {
+                *size = (size_t)entry->size;
+            }
+            return true;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return false;
+}
+
+/*
+ * Mounting
+ */
+
+static bool archive_valid(const pocpak_header *header, size_t file_size) {
+    if (memcmp(header->magic, POCPAK_MAGIC, sizeof(POCPAK_MAGIC)) != 0 ||
+        header->version != POCPAK_VERSION || header->file_size != file_size ||
+        header->index_offset > file_size ||
+        header->entry_count > (file_size - header->index_offset) / sizeof(pocpak_entry) ||
+        header->string_offset > file_size || header->string_size > file_size - header->string_offset) {
+        return false;
+    }
+
+    // Lookups binary search the index, so it has to be strictly sorted
+    const char *base = (const char *)header;
+    const pocpak_entry *entries = (const pocpak_entry *)(base + header->index_offset);
+    const char *strings = base + header->string_offset;
+    for (uint32_t i = 0; i < header->entry_count; i++) {
+        const pocpak_entry *entry = &entries[i];
+        if (entry->path_offset > header->string_size ||
+            entry->path_length > header->string_size - entry->path_offset ||
+            entry->data_offset % POC_ARCHIVE_ALIGNMENT != 0 || entry->data_offset > file_size ||
+            entry->size > file_size - entry->data_offset) {
+            return false;
+        }
+        if (i > 0 && compare_path(strings + entries[i - 1].path_offset, entries[i - 1].path_length,
+                                  strings + entry->path_offset, entry->path_length) >= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool poc_archive_mount(const char *path) {
+    poc_archive_unmount();
+
+    poc_file_map map;
+    if (!poc_file_map_open(path, &map)) {
+        printf("⚠ Could not open asset archive %s, reading loose files\n", path ? path : "(null)");
+        return false;
+    }
+    if (map.size < sizeof(pocpak_header) || !archive_valid((const pocpak_header *)map.data, map.size)) {
+        printf("⚠ Asset archive %s is damaged or from another version, reading loose files\n", path);
+        poc_file_map_close(&map);
+        return false;
+    }
+
+    g_archive = map;
+    g_header = (const pocpak_header *)map.data;
+    printf("✓ Mounted asset archive %s (%u files, %.1f MiB)\n",
+           path, g_header->entry_count, (double)map.size / (1024.0 * 1024.0));
+    return true;
+}
+
+void poc_archive_unmount(void) {
+    if (!g_header) {
+        return;
+    }
+    g_header = NULL;
+    poc_file_map_close(&g_archive);
+}
+
+bool poc_archive_is_mounted(void) {
+    return g_header != NULL;
+}
+
+/*
+ * Building
+ */
+
+typedef struct {
+    char **items;
+    uint32_t count;
+    uint32_t capacity;
+} path_list;
+
+static bool push_path(path_list *list, const char *path) {
+    if (list->count == list->capacity) {
+        uint32_t capacity = list->capacity > 0 ? list->capacity * 2 : 64;
+        char **items = realloc(list->items, capacity * sizeof(char *));
+        if (!items) {
+            return false;
+        }
+        list->items = items;
+        list->capacity = capacity;
+    }
+
+    char normalized[POC_ASSET_PATH_MAX];
+    if (!poc_asset_normalize_path(path, normalized, sizeof(normalized))) {
+        printf("⚠ Path too long for the archive: %s\n", path);
+        return true;
+    }
+    char *copy = strdup(normalized);
+    if (!copy) {
+        return false;
+    }
+    list->items[list->count++] = copy;
+    return true;
+}
+
+static bool collect(path_list *list, const char *path) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        printf("⚠ Cannot read %s, not packed\n", path);
+        return true;
+    }
+    if (S_ISREG(st.st_mode)) {
+        return push_path(list, path);
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        return true;
+    }
+
+    DIR *directory = opendir(path);
+    if (!directory) {
+        printf("⚠ Cannot read directory %s, not packed\n", path);
+        return true;
+    }
+
+    bool ok = true;
+    struct dirent *item;
+    while (ok && (item = readdir(directory)) != NULL) {
+        if (item->d_name[0] == '.') {
+            continue;
+        }
+        size_t length = strlen(path) + strlen(item->d_name) + 2;
+        char *child = malloc(length);
+        if (!child) {
+            ok = false;
+            break;
+        }
+        snprintf(child, length, "%s/%s", path, item->d_name);
+        ok = collect(list, child);
+        free(child);
+    }
+    closedir(directory);
+    return ok;
+}
+
+static int compare_strings(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+// A cooked mesh is only worth packing if it still matches its sources
+static bool is_stale_cooked_mesh(const char *path) {
+    size_t length = strlen(path);
+    size_t extension = sizeof(POC_MESH_CACHE_EXTENSION) - 1;
+    if (length <= extension || strcmp(path + length - extension, POC_MESH_CACHE_EXTENSION) != 0) {
+        return false;
+    }
+
+    char *source = strndup(path, length - extension);
+    bool stale = !source || !poc_mesh_cache_is_current(source);
+    free(source);
+    return stale;
+}
+
+static uint64_t align_entry(uint64_t offset) {
+    return (offset + POC_ARCHIVE_ALIGNMENT - 1) & ~(uint64_t)(POC_ARCHIVE_ALIGNMENT - 1);
+}
+
+static bool pad_to(FILE *file, uint64_t offset) {
+    static const char padding[POC_ARCHIVE_ALIGNMENT];
+    long position = ftell(file);
+    if (position < 0 || (uint64_t)position > offset) {
+        return false;
+    }
+    uint64_t gap = offset - (uint64_t)position;
+    return gap == 0 || fwrite(padding, 1, gap, file) == gap;
+}
+
+static bool write_archive(const char *path, path_list *list) {
+    pocpak_entry *entries = calloc(list->count > 0 ? list->count : 1, sizeof(pocpak_entry));
+    if (!entries) {
+        return false;
+    }
+
+    pocpak_header header = {
+        .magic = POCPAK_MAGIC,
+        .version = POCPAK_VERSION,
+        .entry_count = list->count,
+        .index_offset = sizeof(pocpak_header),
+    };
+    header.string_offset = header.index_offset + (uint64_t)list->count * sizeof(pocpak_entry);
+
+    // Lay out paths, then data, before writing anything
+    uint64_t string_size = 0;
+    bool ok = true;
+    for (uint32_t i = 0; i < list->count; i++) {
+        entries[i].path_offset = (uint32_t)string_size;
+        entries[i].path_length = (uint32_t)strlen(list->items[i]);
+        string_size += entries[i].path_length;
+    }
+    header.string_size = string_size;
+
+    uint64_t offset = header.string_offset + string_size;
+    for (uint32_t i = 0; ok && i < list->count; i++) {
+        struct stat st;
+        ok = stat(list->items[i], &st) == 0;
+        offset = align_entry(offset);
+        entries[i].data_offset = offset;
+        entries[i].size = ok ? (uint64_t)st.st_size : 0;
+        offset += entries[i].size;
+    }
+    header.file_size = offset;
+
+    FILE *file = ok ? fopen(path, "wb") : NULL;
+    ok = file != NULL;
+    ok = ok && fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && (list->count == 0 || fwrite(entries, sizeof(pocpak_entry), list->count, file) == list->count);
+    for (uint32_t i = 0; ok && i < list->count; i++) {
+        ok = fwrite(list->items[i], 1, entries[i].path_length, file) == entries[i].path_length;
+    }
+
+    for (uint32_t i = 0; ok && i < list->count; i++) {
+        poc_file_map map;
+        ok = pad_to(file, entries[i].data_offset) && poc_file_map_open(list->items[i], &map);
+        if (!ok) {
+            break;
+        }
+        // A file that changed size since the layout was planned would
+        // shift every later entry
+        ok = map.size == entries[i].size && (map.size == 0 || fwrite(map.data, 1, map.size, file) == map.size);
+        poc_file_map_close(&map);
+    }
+
+    if (file) {
+        ok = !ferror(file) && ok;
+        ok = fclose(file) == 0 && ok;
+    }
+    free(entries);
+    return ok;
+}
+
+bool poc_archive_build(const char *output_path, const char *const *inputs, uint32_t input_count) {
+    if (!output_path || (!inputs && input_count > 0) || poc_archive_is_mounted()) {
+        return false;
+    }
+
+    path_list list = {0};
+    bool ok = true;
+    for (uint32_t i = 0; ok && i < input_count; i++) {
+        ok = collect(&list, inputs[i]);
+    }
+
+    // Sort for the lookup's binary search; drop duplicates from overlapping
+    // inputs and cooked meshes that would be rejected at load time
+    if (ok && list.count > 0) {
+        qsort(list.items, list.count, sizeof(char *), compare_strings);
+    }
+    uint32_t kept = 0;
+    for (uint32_t i = 0; ok && i < list.count; i++) {
+        bool duplicate = kept > 0 && strcmp(list.items[kept - 1], list.items[i]) == 0;
+        if (duplicate || is_stale_cooked_mesh(list.items[i])) {
+            if (!duplicate) {
+                printf("⚠ Skipping %s, its sources changed since it was cooked\n", list.items[i]);
+            }
+            free(list.items[i]);
+            continue;
+        }
+        list.items[kept++] = list.items[i];
+    }
+    if (ok) {
+        list.count = kept;
+    }
+
+    // Never pack the archive into itself
+    char normalized_output[POC_ASSET_PATH_MAX];
+    if (ok && poc_asset_normalize_path(output_path, normalized_output, sizeof(normalized_output))) {
+        for (uint32_t i = 0; i < list.count; i++) {
+            if (strcmp(list.items[i], normalized_output) == 0) {
+                free(list.items[i]);
+                memmove(&list.items[i], &list.items[i + 1], (list.count - i - 1) * sizeof(char *));
+                list.count--;
+                break;
+            }
+        }
+    }
+
+    // Write under a private name and rename, so a running engine never maps a partial archive
+    size_t temp_length = strlen(output_path) + 32;
+    char *temp_path = ok ? malloc(temp_length) : NULL;
+    ok = temp_path != NULL;
+    if (ok) {
+        snprintf(temp_path, temp_length, "%s.%ld.tmp", output_path, (long)getpid());
+        ok = write_archive(temp_path, &list) && rename(temp_path, output_path) == 0;
+        if (!ok) {
+            unlink(temp_path);
+        }
+    }
+    if (ok) {
+        printf("✓ Packed %u files into %s\n", list.count, output_path);
+    }
+
+    free(temp_path);
+    for (uint32_t i = 0; i < list.count; i++) {
+        free(list.items[i]);
+    }
+    free(list.items);
+    return ok;
+}
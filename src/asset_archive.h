@@ -0,0 +1,97 @@
+/**
+ * @file asset_archive.h
+ * @brief Packed asset archive (.pocpak) read through one mapping
+ *
+ * Starting the engine opens many small files: OBJ and MTL sources, their
+ * cooked .pocmesh files, SPIR-V shaders, Lua scripts and the Teal compiler.
+ * On a cold page cache or a network filesystem each open and first read is
+ * a round trip. An archive packs them into one file that is mapped once;
+ * lookups are a binary search of its sorted index, and the file data is
+ * read in place.
+ *
+ * While an archive is mounted, poc_file_map_open() serves every path the
+ * archive holds from it, so the OBJ, MTL and cooked mesh loaders, the shader
+ * loader and the scripting system all read archived files without knowing
+ * about the archive. Paths missing from the archive fall back to disk.
+ * Paths are matched after poc_asset_normalize_path(), relative to the
+ * working directory the archive was built from.
+ *
+ * Every entry starts on a POC_ARCHIVE_ALIGNMENT boundary, so an entry keeps
+ * the alignment a standalone mapping would have had: cooked meshes point
+ * into it directly, and page-granular calls (madvise, mincore) work on it.
+ *
+ * An archive is a snapshot. Cooked meshes in it are used without checking
+ * their sources, which poc_archive_build() does when packing instead, and
+ * archived files are not watched for changes.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Conventional file extension of archives */
+#define POC_ARCHIVE_EXTENSION ".pocpak"
+
+/** Alignment of every entry's data, one page on common systems */
+#define POC_ARCHIVE_ALIGNMENT 4096
+
+/**
+ * @brief Pack files and directory trees into an archive
+ *
+ * Directories are walked recursively, skipping names that start with '.'.
+ * Each file is stored under its normalized path as reached from the given
+ * inputs, so inputs should be named relative to the directory the engine
+ * runs in (e.g. "models", "shaders", "deps/teal/tl.lua"). Cooked meshes
+ * whose sources have changed since cooking are left out. The archive is
+ * written under a temporary name and renamed into place.
+ *
+ * Must not be called while an archive is mounted.
+ *
+ * @param output_path Archive to write
+ * @param inputs Files and directories to pack
+ * @param input_count Number of entries in @p inputs
+ * @return true on success
+ */
+bool poc_archive_build(const char *output_path, const char *const *inputs, uint32_t input_count);
+
+/**
+ * @brief Map an archive and serve its files from now on
+ *
+ * Replaces any archive mounted before. Not thread safe: mount before
+ * loading anything and unmount after everything read from the archive
+ * (including meshes pointing into it) is gone.
+ *
+ * @param path Archive to mount
+ * @return true if the archive is valid and mounted
+ */
+bool poc_archive_mount(const char *path);
+
+/**
+ * @brief Unmap the mounted archive, if any
+ */
+void poc_archive_unmount(void);
+
+/**
+ * @brief Check whether an archive is mounted
+ */
+bool poc_archive_is_mounted(void);
+
+/**
+ * @brief Look up a file in the mounted archive
+ *
+ * @param path Path of the file, normalized before the lookup
+ * @param data Receives the first byte of the file (can be NULL)
+ * @param size Receives the file size (can be NULL)
+ * @return true if the archive holds the file
+ */
+bool poc_archive_find(const char *path, const char **data, size_t *size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,882 @@
+#define _POSIX_C_SOURCE 199309L
+#include "asset_manager.h"
+#include "mesh.h"
+#include "job_system.h"
+#include "file_watch.h"
+#include "asset_archive.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+typedef struct {
+    poc_mesh *mesh;             // NULL while the slot is free
+    poc_string_id path;         // Normalized path
+    uint64_t hash;
+    uint64_t bytes;
+    uint32_t ref_count;
+    uint32_t generation;        // Bumped when the slot is freed, invalidating weak handles
+    uint8_t reload;             // RELOAD_* state of the file watcher's reloads
+    uint64_t changed_ns;        // When the latest change to the mesh's files was seen
+} asset_entry;
+
+enum {
+    RELOAD_IDLE,
+    RELOAD_RUNNING,
+    RELOAD_STALE                // Changed again while reloading; reload once more
+};
+
+enum {
+    REQUEST_PENDING,
+    REQUEST_DONE,
+    REQUEST_FAILED
+};
+
+struct poc_mesh_request {
+    poc_mesh *mesh;                     // Holds one reference once loaded
+    atomic_int state;
+    poc_mesh_load_callback callback;    // Cleared when the caller releases first
+    void *user_data;
+    uint32_t refs;                      // Caller, plus the pending completion
+    poc_mesh_request *next;             // Link in a load's waiters or the completion queue
+};
+
+// A file being parsed on a worker, with every request waiting for it
+typedef struct asset_load {
+    char path[POC_ASSET_PATH_MAX];
+    uint64_t hash;
+    poc_mesh_request *waiters;
+    struct asset_load *next;
+} asset_load;
+
+static pthread_mutex_t g_asset_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_load_finished = PTHREAD_COND_INITIALIZER;
+
+// Entries never move index, so a mesh can remember its slot
+static asset_entry *g_entries = NULL;
+static uint32_t g_entry_count = 0;
+static uint32_t g_entry_capacity = 0;
+static uint32_t *g_free_entries = NULL;
+static uint32_t g_free_count = 0;
+
+// Open-addressed hash -> entry index + 1 (0 = empty)
+static uint32_t *g_slots = NULL;
+static uint32_t g_slot_capacity = 0;
+static uint32_t g_resident_count = 0;
+
+// A changed file being parsed again for a resident mesh
+typedef struct asset_reload {
+    uint32_t index;                 // Entry being reloaded
+    uint32_t generation;            // Entry generation, in case it is purged meanwhile
+    char path[POC_ASSET_PATH_MAX];
+    poc_mesh *mesh;                 // New version, NULL if parsing failed
+    uint64_t parse_ns;
+    struct asset_reload *next;
+} asset_reload;
+
+typedef struct {
+    poc_asset_reload_callback callback;
+    void *user_data;
+} reload_listener;
+
+// In-flight loads and requests whose callbacks have not been dispatched yet
+static asset_load *g_loads = NULL;
+static poc_mesh_request *g_completed_head = NULL;
+static poc_mesh_request *g_completed_tail = NULL;
+
+// Finished reloads waiting for poc_mesh_dispatch_loads() to swap them in
+static asset_reload *g_reloaded_head = NULL;
+static asset_reload *g_reloaded_tail = NULL;
+static reload_listener *g_reload_listeners = NULL;
+static uint32_t g_reload_listener_count = 0;
+
+static uint64_t g_loaded_bytes = 0;
+static uint64_t g_hits = 0;
+static uint64_t g_misses = 0;
+static uint64_t g_purged = 0;
+static uint64_t g_reloads = 0;
+static double g_last_reload_ms = 0.0;
+
+static void asset_file_changed(const char *path, void *user_data);
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t hash_path(const char *path) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char *c = path; *c; c++) {
+        hash ^= (uint8_t)*c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint64_t mesh_bytes(const poc_mesh *mesh) {
+    return (uint64_t)mesh->vertex_count * sizeof(poc_vertex) +
+           (uint64_t)mesh->index_count * sizeof(uint32_t) +
+           (uint64_t)mesh->submesh_count * sizeof(poc_submesh) +
+           (uint64_t)mesh->material_count * sizeof(poc_material) +
+           (uint64_t)mesh->cluster_count * sizeof(poc_mesh_cluster);
+}
+
+bool poc_asset_normalize_path(const char *path, char *out, size_t out_size) {
+    if (!path || !out || out_size < 2) {
+        return false;
+    }
+
+    bool absolute = path[0] == '/';
+    size_t length = absolute ? 1 : 0;
+    out[0] = '/';
+    // Components that are ".." and could not be resolved; they stay in front
+    uint32_t parents = 0;
+
+    const char *c = path;
+    while (*c) {
+        while (*c == '/') {
+            c++;
+        }
+        const char *start = c;
+        while (*c && *c != '/') {
+            c++;
+        }
+        size_t part = (size_t)(c - start);
+
+        if (part == 0 || (part == 1 && start[0] == '.')) {
+            continue;
+        }
+        if (part == 2 && start[0] == '.' && start[1] == '.') {
+            size_t root = absolute ? 1 : 0;
+            size_t kept = root + (size_t)parents * 3;
+            if (length > kept) {
+                // Drop the last component and its separator
+                while (length > kept && out[length - 1] != '/') {
+                    length--;
+                }
+                if (length > root) {
+                    length--;
+                }
+                continue;
+            }
+            if (absolute) {
+                continue; // "/.." is "/"
+            }
+            parents++;
+        }
+
+        size_t needed = part + (length > (absolute ? 1u : 0u) ? 1 : 0);
+        if (length + needed + 1 > out_size) {
+            return false;
+        }
+        if (length > (absolute ? 1u : 0u)) {
+            out[length++] = '/';
+        }
+        memcpy(out + length, start, part);
+        length += part;
+    }
+
+    if (length == 0) {
+        out[length++] = '.';
+    }
+    out[length] = '\0';
+    return true;
+}
+
+// Caller holds the mutex. Returns the slot holding the path, or the empty
+// slot where it belongs.
+static uint32_t *find_slot(const char *path, uint64_t hash) {
+    uint32_t mask = g_slot_capacity - 1;
+    uint32_t slot = (uint32_t)hash & mask;
+    while (g_slots[slot] != 0) {
+        const asset_entry *entry = &g_entries[g_slots[slot] - 1];
+        if (entry->hash == hash && strcmp(poc_string_get(entry->path), path) == 0) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return &g_slots[slot];
+}
+
+// Caller holds the mutex. Rebuild the slot table for the resident entries.
+static bool rebuild_slots(uint32_t capacity) {
+    uint32_t *slots = calloc(capacity, sizeof(uint32_t));
+    if (!slots) {
+        return false;
+    }
+
+    uint32_t mask = capacity - 1;
+    for (uint32_t i = 0; i < g_entry_count; i++) {
+        if (!g_entries[i].mesh) {
+            continue;
+        }
+        uint32_t slot = (uint32_t)g_entries[i].hash & mask;
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = i + 1;
+    }
+
+    free(g_slots);
+    g_slots = slots;
+    g_slot_capacity = capacity;
+    return true;
+}
+
+// Caller holds the mutex. Returns a free entry index, or UINT32_MAX.
+static uint32_t allocate_entry(void) {
+    if (g_free_count > 0) {
+        return g_free_entries[--g_free_count];
+    }
+
+    if (g_entry_count >= g_entry_capacity) {
+        uint32_t new_capacity = g_entry_capacity == 0 ? 64 : g_entry_capacity * 2;
+        asset_entry *entries = realloc(g_entries, sizeof(asset_entry) * new_capacity);
+        if (!entries) {
+            return UINT32_MAX;
+        }
+        g_entries = entries;
+
+        uint32_t *free_entries = realloc(g_free_entries, sizeof(uint32_t) * new_capacity);
+        if (!free_entries) {
+            return UINT32_MAX;
+        }
+        g_free_entries = free_entries;
+        g_entry_capacity = new_capacity;
+    }
+
+    memset(&g_entries[g_entry_count], 0, sizeof(asset_entry));
+    return g_entry_count++;
+}
+
+// Caller holds the mutex. Take a reference to a resident mesh, if any.
+static poc_mesh *lookup_locked(const char *path, uint64_t hash) {
+    if (g_slot_capacity == 0) {
+        return NULL;
+    }
+
+    uint32_t index = *find_slot(path, hash);
+    if (index == 0) {
+        return NULL;
+    }
+
+    asset_entry *entry = &g_entries[index - 1];
+    entry->ref_count++;
+    g_hits++;
+    return entry->mesh;
+}
+
+static void watch_source(const char *path, bool watch) {
+    // Archived files are a snapshot and never change
+    if (!path[0] || poc_archive_find(path, NULL, NULL)) {
+        return;
+    }
+    if (watch) {
+        poc_file_watch_add(path, asset_file_changed, NULL);
+    } else {
+        poc_file_watch_remove(path, asset_file_changed, NULL);
+    }
+}
+
+// Caller holds the mutex. Add or drop watches on every file a mesh was built from.
+static void watch_sources_locked(const poc_mesh *mesh, bool watch) {
+    watch_source(poc_mesh_get_source_path(mesh), watch);
+    for (uint32_t i = 0; i < mesh->dependency_count; i++) {
+        watch_source(poc_string_get(mesh->dependencies[i]), watch);
+    }
+}
+
+// Caller holds the mutex. Register a freshly loaded mesh with one reference.
+static bool insert_locked(const char *path, uint64_t hash, poc_mesh *mesh) {
+    // Keep the table at most half full
+    if ((g_resident_count + 1) * 2 > g_slot_capacity &&
+        !rebuild_slots(g_slot_capacity == 0 ? 128 : g_slot_capacity * 2)) {
+        return false;
+    }
+
+    uint32_t index = allocate_entry();
+    if (index == UINT32_MAX) {
+        return false;
+    }
+
+    asset_entry *entry = &g_entries[index];
+    entry->mesh = mesh;
+    entry->path = poc_string_intern(path);
+    entry->hash = hash;
+    entry->bytes = mesh_bytes(mesh);
+    entry->ref_count = 1;
+    entry->reload = RELOAD_IDLE;
+    *find_slot(path, hash) = index + 1;
+
+    mesh->asset_slot = index + 1;
+    watch_sources_locked(mesh, true);
+    g_resident_count++;
+    g_loaded_bytes += entry->bytes;
+    g_misses++;
+    return true;
+}
+
+poc_mesh *poc_asset_acquire_mesh(const char *path) {
+    char normalized[POC_ASSET_PATH_MAX];
+    if (!path || !path[0] || !poc_asset_normalize_path(path, normalized, sizeof(normalized))) {
+        return NULL;
+    }
+    uint64_t hash = hash_path(normalized);
+
+    pthread_mutex_lock(&g_asset_mutex);
+    poc_mesh *mesh = lookup_locked(normalized, hash);
+    pthread_mutex_unlock(&g_asset_mutex);
+    if (mesh) {
+        return mesh;
+    }
+
+    // Parse outside the lock so other lookups and loads proceed
+    poc_mesh *loaded = poc_mesh_load(normalized);
+    if (!loaded) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&g_asset_mutex);
+    // Another thread may have loaded the same file meanwhile
+    mesh = lookup_locked(normalized, hash);
+    bool inserted = !mesh && insert_locked(normalized, hash, loaded);
+    pthread_mutex_unlock(&g_asset_mutex);
+
+    if (inserted) {
+        return loaded;
+    }
+    poc_mesh_destroy(loaded);
+    return mesh;
+}
+
+// Caller holds the mutex. Drop a request reference, freeing it with the last.
+static void drop_request_locked(poc_mesh_request *request) {
+    if (--request->refs > 0) {
+        return;
+    }
+    if (request->mesh) {
+        g_entries[request->mesh->asset_slot - 1].ref_count--;
+    }
+    free(request);
+}
+
+// Caller holds the mutex. Finish a request and queue its callback.
+static void complete_request_locked(poc_mesh_request *request, poc_mesh *mesh) {
+    request->mesh = mesh;
+    atomic_store_explicit(&request->state, mesh ? REQUEST_DONE : REQUEST_FAILED, memory_order_release);
+
+    request->next = NULL;
+    if (!request->callback) {
+        drop_request_locked(request);
+        return;
+    }
+    if (g_completed_tail) {
+        g_completed_tail->next = request;
+    } else {
+        g_completed_head = request;
+    }
+    g_completed_tail = request;
+}
+
+static void load_job(void *user_data) {
+    asset_load *load = user_data;
+    poc_mesh *loaded = poc_mesh_load(load->path);
+
+    pthread_mutex_lock(&g_asset_mutex);
+    for (asset_load **link = &g_loads; *link; link = &(*link)->next) {
+        if (*link == load) {
+            *link = load->next;
+            break;
+        }
+    }
+
+    // A synchronous acquire may have loaded the file meanwhile
+    poc_mesh *mesh = loaded ? lookup_locked(load->path, load->hash) : NULL;
+    if (!mesh && loaded && insert_locked(load->path, load->hash, loaded)) {
+        mesh = loaded;
+        loaded = NULL;
+    }
+
+    // The first waiter takes the reference from the lookup or insert
+    bool first = true;
+    poc_mesh_request *request = load->waiters;
+    while (request) {
+        poc_mesh_request *next = request->next;
+        if (mesh && !first) {
+            g_entries[mesh->asset_slot - 1].ref_count++;
+        }
+        first = false;
+        complete_request_locked(request, mesh);
+        request = next;
+    }
+    pthread_cond_broadcast(&g_load_finished);
+    pthread_mutex_unlock(&g_asset_mutex);
+
+    if (loaded) {
+        poc_mesh_destroy(loaded);
+    }
+    free(load);
+}
+
+poc_mesh_request *poc_mesh_load_async(const char *path, poc_mesh_load_callback callback, void *user_data) {
+    char normalized[POC_ASSET_PATH_MAX];
+    if (!path || !path[0] || !poc_asset_normalize_path(path, normalized, sizeof(normalized))) {
+        return NULL;
+    }
+    uint64_t hash = hash_path(normalized);
+
+    poc_mesh_request *request = calloc(1, sizeof(poc_mesh_request));
+    if (!request) {
+        return NULL;
+    }
+    atomic_init(&request->state, REQUEST_PENDING);
+    request->callback = callback;
+    request->user_data = user_data;
+    request->refs = 2;
+
+    pthread_mutex_lock(&g_asset_mutex);
+    poc_mesh *mesh = lookup_locked(normalized, hash);
+    if (mesh) {
+        complete_request_locked(request, mesh);
+        pthread_mutex_unlock(&g_asset_mutex);
+        return request;
+    }
+
+    // Join a load of the same file that is already running
+    for (asset_load *load = g_loads; load; load = load->next) {
+        if (load->hash == hash && strcmp(load->path, normalized) == 0) {
+            request->next = load->waiters;
+            load->waiters = request;
+            g_hits++;
+            pthread_mutex_unlock(&g_asset_mutex);
+            return request;
+        }
+    }
+
+    asset_load *load = calloc(1, sizeof(asset_load));
+    if (!load) {
+        pthread_mutex_unlock(&g_asset_mutex);
+        free(request);
+        return NULL;
+    }
+    memcpy(load->path, normalized, sizeof(normalized));
+    load->hash = hash;
+    load->waiters = request;
+    load->next = g_loads;
+    g_loads = load;
+    pthread_mutex_unlock(&g_asset_mutex);
+
+    if (!poc_job_submit(load_job, load, NULL)) {
+        load_job(load);
+    }
+    return request;
+}
+
+bool poc_mesh_request_is_done(const poc_mesh_request *request) {
+    return !request ||
+           atomic_load_explicit(&((poc_mesh_request *)request)->state, memory_order_acquire) != REQUEST_PENDING;
+}
+
+poc_mesh *poc_mesh_request_wait(poc_mesh_request *request) {
+    if (!request) {
+        return NULL;
+    }
+
+    // Help with queued jobs first; our load may be one of them
+    while (!poc_mesh_request_is_done(request)) {
+        if (poc_job_run_one()) {
+            continue;
+        }
+
+        pthread_mutex_lock(&g_asset_mutex);
+        while (!poc_mesh_request_is_done(request)) {
+            pthread_cond_wait(&g_load_finished, &g_asset_mutex);
+        }
+        pthread_mutex_unlock(&g_asset_mutex);
+    }
+    return request->mesh;
+}
+
+poc_mesh *poc_mesh_request_get_mesh(const poc_mesh_request *request) {
+    return poc_mesh_request_is_done(request) && request ? request->mesh : NULL;
+}
+
+void poc_mesh_request_release(poc_mesh_request *request) {
+    if (!request) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_asset_mutex);
+    request->callback = NULL;
+    drop_request_locked(request);
+    pthread_mutex_unlock(&g_asset_mutex);
+}
+
+/*
+ * Hot reload
+ */
+
+static void reload_job(void *user_data) {
+    asset_reload *reload = user_data;
+    uint64_t start = now_ns();
+    reload->mesh = poc_mesh_load(reload->path);
+    reload->parse_ns = now_ns() - start;
+
+    pthread_mutex_lock(&g_asset_mutex);
+    reload->next = NULL;
+    if (g_reloaded_tail) {
+        g_reloaded_tail->next = reload;
+    } else {
+        g_reloaded_head = reload;
+    }
+    g_reloaded_tail = reload;
+    pthread_mutex_unlock(&g_asset_mutex);
+}
+
+// Caller holds the mutex. Start parsing an entry's source again; the job is
+// returned for the caller to submit once the mutex is released.
+static asset_reload *begin_reload_locked(uint32_t index) {
+    asset_entry *entry = &g_entries[index];
+    asset_reload *reload = calloc(1, sizeof(asset_reload));
+    if (!reload) {
+        return NULL;
+    }
+    reload->index = index;
+    reload->generation = entry->generation;
+    snprintf(reload->path, sizeof(reload->path), "%s", poc_string_get(entry->path));
+    entry->reload = RELOAD_RUNNING;
+    return reload;
+}
+
+static void submit_reload(asset_reload *reload) {
+    if (!poc_job_submit(reload_job, reload, NULL)) {
+        reload_job(reload);
+    }
+}
+
+static bool depends_on(const asset_entry *entry, const char *path) {
+    if (strcmp(poc_string_get(entry->path), path) == 0) {
+        return true;
+    }
+    for (uint32_t i = 0; i < entry->mesh->dependency_count; i++) {
+        char normalized[POC_ASSET_PATH_MAX];
+        if (poc_asset_normalize_path(poc_string_get(entry->mesh->dependencies[i]), normalized, sizeof(normalized)) &&
+            strcmp(normalized, path) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Runs on the watcher thread: reparse every resident mesh built from the file
+static void asset_file_changed(const char *path, void *user_data) {
+    (void)user_data;
+    uint64_t changed = now_ns();
+    asset_reload *started = NULL;
+
+    pthread_mutex_lock(&g_asset_mutex);
+    for (uint32_t i = 0; i < g_entry_count; i++) {
+        asset_entry *entry = &g_entries[i];
+        if (!entry->mesh || !depends_on(entry, path)) {
+            continue;
+        }
+        entry->changed_ns = changed;
+        if (entry->reload != RELOAD_IDLE) {
+            entry->reload = RELOAD_STALE;
+            continue;
+        }
+        asset_reload *reload = begin_reload_locked(i);
+        if (reload) {
+            reload->next = started;
+            started = reload;
+        }
+    }
+    pthread_mutex_unlock(&g_asset_mutex);
+
+    while (started) {
+        asset_reload *next = started->next;
+        submit_reload(started);
+        started = next;
+    }
+}
+
+// Swap one finished reload into its entry. Main thread only, since the old
+// contents are destroyed and listeners re-upload from the mesh.
+static bool apply_reload(asset_reload *reload) {
+    asset_reload *again = NULL;
+    poc_mesh *mesh = NULL;
+    uint64_t changed = 0;
+
+    pthread_mutex_lock(&g_asset_mutex);
+    asset_entry *entry = &g_entries[reload->index];
+    bool current = entry->mesh && entry->generation == reload->generation;
+    if (current) {
+        changed = entry->changed_ns;
+        if (reload->mesh) {
+            // Nothing else swaps or destroys managed meshes, and renderers
+            // read them on this thread, so swapping under the lock suffices
+            mesh = entry->mesh;
+            poc_mesh_swap_contents(mesh, reload->mesh);
+            watch_sources_locked(mesh, true);
+            watch_sources_locked(reload->mesh, false);
+
+            uint64_t bytes = mesh_bytes(mesh);
+            g_loaded_bytes = g_loaded_bytes - entry->bytes + bytes;
+            entry->bytes = bytes;
+        }
+        if (entry->reload == RELOAD_STALE) {
+            again = begin_reload_locked(reload->index);
+        } else {
+            entry->reload = RELOAD_IDLE;
+        }
+    }
+    pthread_mutex_unlock(&g_asset_mutex);
+
+    if (again) {
+        submit_reload(again);
+    }
+    if (!current) {
+        poc_mesh_destroy(reload->mesh);
+        return false;
+    }
+    if (!mesh) {
+        printf("⚠ Could not reload %s, keeping the previous version\n", reload->path);
+        return false;
+    }
+
+    // The reload now holds the previous contents
+    poc_mesh_destroy(reload->mesh);
+    reload->mesh = NULL;
+
+    pthread_mutex_lock(&g_asset_mutex);
+    uint32_t listener_count = g_reload_listener_count;
+    reload_listener *listeners = listener_count > 0 ? malloc(listener_count * sizeof(reload_listener)) : NULL;
+    if (listeners) {
+        memcpy(listeners, g_reload_listeners, listener_count * sizeof(reload_listener));
+    } else {
+        listener_count = 0;
+    }
+    pthread_mutex_unlock(&g_asset_mutex);
+
+    for (uint32_t i = 0; i < listener_count; i++) {
+        listeners[i].callback(mesh, listeners[i].user_data);
+    }
+    free(listeners);
+
+    double latency = (double)(now_ns() - changed) / 1e6;
+    pthread_mutex_lock(&g_asset_mutex);
+    g_reloads++;
+    g_last_reload_ms = latency;
+    pthread_mutex_unlock(&g_asset_mutex);
+
+    printf("✓ Reloaded %s %.1f ms after the change (parsed in %.1f ms)\n",
+           reload->path, latency, (double)reload->parse_ns / 1e6);
+    return true;
+}
+
+bool poc_asset_add_reload_listener(poc_asset_reload_callback callback, void *user_data) {
+    if (!callback) {
+        return false;
+    }
+
+    pthread_mutex_lock(&g_asset_mutex);
+    reload_listener *listeners = realloc(g_reload_listeners, (g_reload_listener_count + 1) * sizeof(reload_listener));
+    if (!listeners) {
+        pthread_mutex_unlock(&g_asset_mutex);
+        return false;
+    }
+    g_reload_listeners = listeners;
+    g_reload_listeners[g_reload_listener_count++] = (reload_listener){callback, user_data};
+    pthread_mutex_unlock(&g_asset_mutex);
+    return true;
+}
+
+void poc_asset_remove_reload_listener(poc_asset_reload_callback callback, void *user_data) {
+    pthread_mutex_lock(&g_asset_mutex);
+    for (uint32_t i = 0; i < g_reload_listener_count; i++) {
+        if (g_reload_listeners[i].callback == callback && g_reload_listeners[i].user_data == user_data) {
+            g_reload_listeners[i] = g_reload_listeners[--g_reload_listener_count];
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_asset_mutex);
+}
+
+uint32_t poc_mesh_dispatch_loads(void) {
+    pthread_mutex_lock(&g_asset_mutex);
+    poc_mesh_request *request = g_completed_head;
+    g_completed_head = NULL;
+    g_completed_tail = NULL;
+    pthread_mutex_unlock(&g_asset_mutex);
+
+    uint32_t count = 0;
+    while (request) {
+        poc_mesh_request *next = request->next;
+
+        // Callbacks run unlocked; they may start loads or release requests
+        pthread_mutex_lock(&g_asset_mutex);
+        poc_mesh_load_callback callback = request->callback;
+        void *user_data = request->user_data;
+        request->callback = NULL;
+        pthread_mutex_unlock(&g_asset_mutex);
+
+        if (callback) {
+            callback(request, request->mesh, user_data);
+            count++;
+        }
+
+        pthread_mutex_lock(&g_asset_mutex);
+        drop_request_locked(request);
+        pthread_mutex_unlock(&g_asset_mutex);
+        request = next;
+    }
+
+    pthread_mutex_lock(&g_asset_mutex);
+    asset_reload *reload = g_reloaded_head;
+    g_reloaded_head = NULL;
+    g_reloaded_tail = NULL;
+    pthread_mutex_unlock(&g_asset_mutex);
+
+    while (reload) {
+        asset_reload *next = reload->next;
+        count += apply_reload(reload);
+        free(reload);
+        reload = next;
+    }
+    return count;
+}
+
+void poc_asset_retain_mesh(poc_mesh *mesh) {
+    if (!mesh || mesh->asset_slot == 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_asset_mutex);
+    g_entries[mesh->asset_slot - 1].ref_count++;
+    pthread_mutex_unlock(&g_asset_mutex);
+}
+
+void poc_asset_release_mesh(poc_mesh *mesh) {
+    if (!mesh || mesh->asset_slot == 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_asset_mutex);
+    asset_entry *entry = &g_entries[mesh->asset_slot - 1];
+    if (entry->ref_count > 0) {
+        entry->ref_count--;
+    } else {
+        printf("⚠ Asset '%s' released more often than acquired\n", poc_string_get(entry->path));
+    }
+    pthread_mutex_unlock(&g_asset_mutex);
+}
+
+poc_asset_handle poc_asset_get_handle(const poc_mesh *mesh) {
+    poc_asset_handle handle = {UINT32_MAX, 0};
+    if (!mesh || mesh->asset_slot == 0) {
+        return handle;
+    }
+
+    pthread_mutex_lock(&g_asset_mutex);
+    handle.index = mesh->asset_slot - 1;
+    handle.generation = g_entries[handle.index].generation;
+    pthread_mutex_unlock(&g_asset_mutex);
+    return handle;
+}
+
+poc_mesh *poc_asset_lock_mesh(poc_asset_handle handle) {
+    poc_mesh *mesh = NULL;
+
+    pthread_mutex_lock(&g_asset_mutex);
+    if (handle.index < g_entry_count) {
+        asset_entry *entry = &g_entries[handle.index];
+        if (entry->mesh && entry->generation == handle.generation) {
+            entry->ref_count++;
+            mesh = entry->mesh;
+        }
+    }
+    pthread_mutex_unlock(&g_asset_mutex);
+    return mesh;
+}
+
+uint32_t poc_asset_purge(void) {
+    pthread_mutex_lock(&g_asset_mutex);
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < g_entry_count; i++) {
+        if (g_entries[i].mesh && g_entries[i].ref_count == 0) {
+            count++;
+        }
+    }
+    if (count == 0) {
+        pthread_mutex_unlock(&g_asset_mutex);
+        return 0;
+    }
+
+    poc_mesh **doomed = malloc(sizeof(poc_mesh *) * count);
+    if (!doomed) {
+        pthread_mutex_unlock(&g_asset_mutex);
+        return 0;
+    }
+
+    uint32_t doomed_count = 0;
+    uint64_t freed_bytes = 0;
+    for (uint32_t i = 0; i < g_entry_count; i++) {
+        asset_entry *entry = &g_entries[i];
+        if (!entry->mesh || entry->ref_count > 0) {
+            continue;
+        }
+        watch_sources_locked(entry->mesh, false);
+        doomed[doomed_count++] = entry->mesh;
+        freed_bytes += entry->bytes;
+        g_loaded_bytes -= entry->bytes;
+        entry->mesh = NULL;
+        entry->generation++;
+        g_free_entries[g_free_count++] = i;
+    }
+    g_resident_count -= doomed_count;
+    g_purged += doomed_count;
+
+    // Freed entries leave holes in the probe chains; re-insert the rest
+    rebuild_slots(g_slot_capacity);
+    pthread_mutex_unlock(&g_asset_mutex);
+
+    for (uint32_t i = 0; i < doomed_count; i++) {
+        doomed[i]->asset_slot = 0;
+        poc_mesh_destroy(doomed[i]);
+    }
+    free(doomed);
+
+    printf("✓ Purged %u unreferenced meshes (%.1f KiB)\n", doomed_count, (double)freed_bytes / 1024.0);
+    return doomed_count;
+}
+
+void poc_asset_get_stats(poc_asset_stats *stats) {
+    if (!stats) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    pthread_mutex_lock(&g_asset_mutex);
+    for (uint32_t i = 0; i < g_entry_count; i++) {
+        if (!g_entries[i].mesh) {
+            continue;
+        }
+        if (g_entries[i].ref_count > 0) {
+            stats->referenced_count++;
+        }
+        // Sampled, not tracked: mapped pages come and go with memory pressure
+        stats->resident_bytes += poc_mesh_get_resident_bytes(g_entries[i].mesh);
+    }
+    stats->mesh_count = g_resident_count;
+    stats->loaded_bytes = g_loaded_bytes;
+    stats->hits = g_hits;
+    stats->misses = g_misses;
+    stats->purged = g_purged;
+    stats->reloads = g_reloads;
+    stats->last_reload_ms = g_last_reload_ms;
+    pthread_mutex_unlock(&g_asset_mutex);
+}
@@ -0,0 +1,78 @@
+/**
+ * @file asset_manager.h
+ * @brief Process-wide registry of loaded meshes
+ *
+ * Every mesh loaded by path goes through the asset manager, so the same file
+ * is parsed once no matter how many scenes, prefabs, streams, renderables or
+ * scripts ask for it. Paths are normalized lexically ("a/./b//../c.obj"
+ * becomes "a/c.obj") and looked up by hash.
+ *
+ * Managed meshes are reference counted: scene objects, prefabs, snapshots and
+ * script handles each hold a reference. A mesh whose count drops to zero
+ * stays resident, so the next acquire is a cache hit, until
+ * poc_asset_purge() destroys it. Weak handles name a mesh without keeping it
+ * alive and fail to resolve once it has been purged.
+ *
+ * Managed meshes must never be passed to poc_mesh_destroy(). Meshes created
+ * in memory are not managed; retaining or releasing them does nothing.
+ *
+ * All functions are thread safe. Loads run outside the registry lock, so two
+ * threads missing on the same path at once both parse it and the loser's
+ * copy is dropped.
+ *
+ * Asynchronous loads parse on the job system. Concurrent requests for one
+ * file share a single load; finished requests queue their callbacks until
+ * poc_mesh_dispatch_loads() runs them on the main thread. Synchronous
+ * acquires never wait on an asynchronous load, since a job blocking on
+ * another queued job could deadlock a small worker pool.
+ *
+ * Every resident mesh has its source files registered with the file
+ * watcher. When one changes, the mesh is parsed again in the background and
+ * poc_mesh_dispatch_loads() swaps the new contents into the existing mesh,
+ * so pointers and handles stay valid.
+ */
+
+#pragma once
+
+#include "poc_engine.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Normalize an asset path lexically
+ *
+ * Removes empty and "." components and resolves ".." against the preceding
+ * component. Symbolic links are not followed.
+ *
+ * @param path Path to normalize
+ * @param out Output buffer
+ * @param out_size Size of @p out
+ * @return true on success, false if the result does not fit
+ */
+bool poc_asset_normalize_path(const char *path, char *out, size_t out_size);
+
+poc_mesh *poc_asset_acquire_mesh(const char *path);
+void poc_asset_retain_mesh(poc_mesh *mesh);
+void poc_asset_release_mesh(poc_mesh *mesh);
+poc_asset_handle poc_asset_get_handle(const poc_mesh *mesh);
+poc_mesh *poc_asset_lock_mesh(poc_asset_handle handle);
+uint32_t poc_asset_purge(void);
+void poc_asset_get_stats(poc_asset_stats *stats);
+
+poc_mesh_request *poc_mesh_load_async(const char *path, poc_mesh_load_callback callback, void *user_data);
+bool poc_mesh_request_is_done(const poc_mesh_request *request);
+poc_mesh *poc_mesh_request_wait(poc_mesh_request *request);
+poc_mesh *poc_mesh_request_get_mesh(const poc_mesh_request *request);
+void poc_mesh_request_release(poc_mesh_request *request);
+uint32_t poc_mesh_dispatch_loads(void);
+bool poc_asset_add_reload_listener(poc_asset_reload_callback callback, void *user_data);
+void poc_asset_remove_reload_listener(poc_asset_reload_callback callback, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,727 @@
+#include "broadphase.h"
+#include "scene.h"
+#include "../include/poc_engine.h"
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+#define SAP_DEAD_PROXY UINT32_MAX
+
+// Band values after the real bands: oversized boxes, then boxes that take no
+// part (disabled, no bounds or removed), so a sorted sweep stops early
+#define SAP_BAND_LARGE (UINT32_MAX - 1)
+#define SAP_BAND_INACTIVE UINT32_MAX
+
+// Re-sort from scratch instead of inserting when this many entries are new
+#define SAP_RESORT_MIN_APPENDED 64
+
+// Updates between re-evaluations of the sweep axis and band size
+#define SAP_LAYOUT_INTERVAL 32
+
+// Change the layout only when the new one is clearly better, since it costs a
+// full re-sort
+#define SAP_LAYOUT_HYSTERESIS 1.5f
+
+// Sorted record; carries the whole box so the sweep never touches the proxies
+typedef struct {
+    float min[3];
+    float max[3];
+    uint32_t band;      // Band along band_axis, or SAP_BAND_LARGE / _INACTIVE
+    uint32_t proxy;     // SAP_DEAD_PROXY once the object left
+} sap_entry;
+
+typedef struct {
+    poc_scene_object *object;   // NULL once removed (the slot is recycled after the next update)
+    uint32_t id;
+    uint32_t entry;             // Index into entries
+} sap_proxy;
+
+typedef struct {
+    uint32_t start;
+    uint32_t end;
+} sap_run;
+
+struct poc_broadphase {
+    poc_scene *scene;
+
+    // Entries sorted by (band, min on axis). Bands slice space along
+    // band_axis so an object is only swept against its own band and the one
+    // below it.
+    sap_entry *entries;
+    uint32_t entry_count;
+    uint32_t entry_capacity;
+    uint32_t dead_entries;      // Entries to compact away on the next update
+    uint32_t appended_entries;  // Unsorted entries at the tail
+    uint32_t axis;
+    uint32_t band_axis;
+    float band_origin;
+    float band_size;
+    uint32_t updates_since_layout;
+    bool resort;
+
+    sap_run *runs;              // Sweep scratch: one run per non-empty band
+    uint32_t run_capacity;
+
+    sap_proxy *proxies;
+    uint32_t proxy_count;
+    uint32_t proxy_capacity;
+    uint32_t *free_proxies;     // Reusable proxy slots
+    uint32_t free_count;
+    uint32_t free_capacity;
+    uint32_t *released_proxies; // Removed since the last update; still named by old pairs
+    uint32_t released_count;
+    uint32_t released_capacity;
+
+    // Overlapping pairs as (lower proxy << 32 | higher proxy), sorted
+    uint64_t *pairs;
+    uint32_t pair_count;
+    uint32_t pair_capacity;
+    uint64_t *next_pairs;
+    uint32_t next_pair_count;
+    uint32_t next_pair_capacity;
+    uint64_t *sort_scratch;
+    uint32_t sort_scratch_capacity;
+    uint32_t *radix_counts;
+
+    poc_overlap_pair *enter;
+    uint32_t enter_count;
+    uint32_t enter_capacity;
+    poc_overlap_pair *stay;
+    uint32_t stay_count;
+    uint32_t stay_capacity;
+    poc_overlap_pair *exit;
+    uint32_t exit_count;
+    uint32_t exit_capacity;
+    double update_ms;
+
+    poc_overlap_callback callback;
+    void *user_data;
+};
+
+// Grow a buffer geometrically; capacities start at 16
+static bool reserve(void **buffer, uint32_t *capacity, uint32_t needed, size_t element_size) {
+    if (needed <= *capacity) {
+        return true;
+    }
+
+    uint32_t new_capacity = *capacity == 0 ? 16 : *capacity;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    void *new_buffer = realloc(*buffer, element_size * new_capacity);
+    if (!new_buffer) {
+        return false;
+    }
+    *buffer = new_buffer;
+    *capacity = new_capacity;
+    return true;
+}
+
+static bool object_participates(const poc_scene_object *object) {
+    return object->enabled &&
+           object->world_aabb_min[0] <= object->world_aabb_max[0] &&
+           object->world_aabb_min[1] <= object->world_aabb_max[1] &&
+           object->world_aabb_min[2] <= object->world_aabb_max[2];
+}
+
+// A box may drift this far (in bands) out of its band before it is moved to
+// another one, so jittering objects do not hop between bands every update.
+// Boxes taller than a band minus twice the slack go into the large band,
+// which keeps pairs between nonadjacent bands impossible.
+#define SAP_BAND_SLACK 0.125f
+
+static uint32_t classify_entry(const poc_broadphase *broadphase, const sap_entry *entry, uint32_t previous_band) {
+    const uint32_t axis = broadphase->band_axis;
+    const float size = broadphase->band_size;
+    if (entry->max[axis] - entry->min[axis] > size * (1.0f - 2.0f * SAP_BAND_SLACK)) {
+        return SAP_BAND_LARGE;
+    }
+
+    float band = (entry->min[axis] - broadphase->band_origin) / size;
+    if (previous_band < SAP_BAND_LARGE &&
+        band >= (float)previous_band - SAP_BAND_SLACK && band < (float)previous_band + 1.0f + SAP_BAND_SLACK) {
+        return previous_band;
+    }
+
+    band = floorf(band);
+    if (!(band > 0.0f)) {
+        return 0;
+    }
+    return band < (float)(SAP_BAND_LARGE - 1) ? (uint32_t)band : SAP_BAND_LARGE - 1;
+}
+
+static void fill_entry(const poc_broadphase *broadphase, sap_entry *entry, const poc_scene_object *object) {
+    memcpy(entry->min, object->world_aabb_min, sizeof(entry->min));
+    memcpy(entry->max, object->world_aabb_max, sizeof(entry->max));
+    entry->band = object_participates(object) ? classify_entry(broadphase, entry, entry->band) : SAP_BAND_INACTIVE;
+}
+
+static bool add_proxy(poc_broadphase *broadphase, poc_scene_object *object) {
+    if (!reserve((void **)&broadphase->entries, &broadphase->entry_capacity,
+                 broadphase->entry_count + 1, sizeof(sap_entry))) {
+        return false;
+    }
+
+    uint32_t proxy_index;
+    if (broadphase->free_count > 0) {
+        proxy_index = broadphase->free_proxies[--broadphase->free_count];
+    } else {
+        if (!reserve((void **)&broadphase->proxies, &broadphase->proxy_capacity,
+                     broadphase->proxy_count + 1, sizeof(sap_proxy))) {
+            return false;
+        }
+        proxy_index = broadphase->proxy_count++;
+    }
+
+    sap_entry *entry = &broadphase->entries[broadphase->entry_count];
+    entry->band = SAP_BAND_INACTIVE;
+    fill_entry(broadphase, entry, object);
+    entry->proxy = proxy_index;
+
+    sap_proxy *proxy = &broadphase->proxies[proxy_index];
+    proxy->object = object;
+    proxy->id = object->id;
+    proxy->entry = broadphase->entry_count++;
+
+    broadphase->appended_entries++;
+    object->broadphase_proxy = proxy_index + 1;
+    return true;
+}
+
+poc_broadphase *poc_broadphase_create(poc_scene *scene) {
+    if (!scene) {
+        return NULL;
+    }
+
+    poc_broadphase *broadphase = calloc(1, sizeof(poc_broadphase));
+    if (!broadphase) {
+        return NULL;
+    }
+
+    broadphase->scene = scene;
+    broadphase->band_axis = 2;
+    broadphase->band_size = 1.0f;
+    broadphase->radix_counts = malloc(sizeof(uint32_t) * 65536);
+    if (!broadphase->radix_counts) {
+        free(broadphase);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < scene->object_count; i++) {
+        if (scene->objects[i] && !add_proxy(broadphase, scene->objects[i])) {
+            poc_broadphase_destroy(broadphase);
+            return NULL;
+        }
+    }
+
+    // The first update sorts and sweeps everything
+    broadphase->resort = true;
+    return broadphase;
+}
+
+void poc_broadphase_destroy(poc_broadphase *broadphase) {
+    if (!broadphase) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < broadphase->proxy_count; i++) {
+        if (broadphase->proxies[i].object) {
+            broadphase->proxies[i].object->broadphase_proxy = 0;
+        }
+    }
+
+    free(broadphase->entries);
+    free(broadphase->runs);
+    free(broadphase->proxies);
+    free(broadphase->free_proxies);
+    free(broadphase->released_proxies);
+    free(broadphase->pairs);
+    free(broadphase->next_pairs);
+    free(broadphase->sort_scratch);
+    free(broadphase->radix_counts);
+    free(broadphase->enter);
+    free(broadphase->stay);
+    free(broadphase->exit);
+    free(broadphase);
+}
+
+void poc_broadphase_set_callback(poc_broadphase *broadphase, poc_overlap_callback callback, void *user_data) {
+    if (!broadphase) {
+        return;
+    }
+
+    broadphase->callback = callback;
+    broadphase->user_data = user_data;
+}
+
+void poc_broadphase_remove(poc_broadphase *broadphase, poc_scene_object *object) {
+    if (!broadphase || !object || object->broadphase_proxy == 0) {
+        return;
+    }
+
+    uint32_t proxy_index = object->broadphase_proxy - 1;
+    object->broadphase_proxy = 0;
+
+    sap_proxy *proxy = &broadphase->proxies[proxy_index];
+    proxy->object = NULL;
+    broadphase->entries[proxy->entry].proxy = SAP_DEAD_PROXY;
+    broadphase->entries[proxy->entry].band = SAP_BAND_INACTIVE;
+    broadphase->dead_entries++;
+
+    // The slot must outlive the pairs that still name it, so it is only
+    // recycled after the next update has reported their exits. If memory
+    // runs out the slot is simply never reused.
+    if (reserve((void **)&broadphase->released_proxies, &broadphase->released_capacity,
+                broadphase->released_count + 1, sizeof(uint32_t)) &&
+        reserve((void **)&broadphase->free_proxies, &broadphase->free_capacity,
+                broadphase->free_count + broadphase->released_count + 1, sizeof(uint32_t))) {
+        broadphase->released_proxies[broadphase->released_count++] = proxy_index;
+    }
+}
+
+static inline bool entry_less(const sap_entry *a, const sap_entry *b, uint32_t axis) {
+    return a->band < b->band || (a->band == b->band && a->min[axis] < b->min[axis]);
+}
+
+static int compare_entries(const void *a, const void *b, uint32_t axis) {
+    const sap_entry *entry_a = a;
+    const sap_entry *entry_b = b;
+    return entry_less(entry_a, entry_b, axis) ? -1 : entry_less(entry_b, entry_a, axis) ? 1 : 0;
+}
+
+static int compare_entries_x(const void *a, const void *b) { return compare_entries(a, b, 0); }
+static int compare_entries_y(const void *a, const void *b) { return compare_entries(a, b, 1); }
+static int compare_entries_z(const void *a, const void *b) { return compare_entries(a, b, 2); }
+
+static void sort_entries(poc_broadphase *broadphase) {
+    sap_entry *entries = broadphase->entries;
+    const uint32_t count = broadphase->entry_count;
+    const uint32_t axis = broadphase->axis;
+
+    if (broadphase->resort ||
+        (broadphase->appended_entries >= SAP_RESORT_MIN_APPENDED && broadphase->appended_entries > count / 8)) {
+        static int (*const compare[3])(const void *, const void *) = {
+            compare_entries_x, compare_entries_y, compare_entries_z
+        };
+        qsort(entries, count, sizeof(sap_entry), compare[axis]);
+    } else {
+        // Nearly sorted after coherent motion: each entry moves a few slots
+        for (uint32_t i = 1; i < count; i++) {
+            if (!entry_less(&entries[i], &entries[i - 1], axis)) {
+                continue;
+            }
+            sap_entry moving = entries[i];
+            uint32_t j = i;
+            while (j > 0 && entry_less(&moving, &entries[j - 1], axis)) {
+                entries[j] = entries[j - 1];
+                j--;
+            }
+            entries[j] = moving;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        broadphase->proxies[entries[i].proxy].entry = i;
+    }
+
+    broadphase->resort = false;
+    broadphase->appended_entries = 0;
+}
+
+// Drop entries of removed objects, keeping the order
+static void compact_entries(poc_broadphase *broadphase) {
+    uint32_t write_index = 0;
+    for (uint32_t i = 0; i < broadphase->entry_count; i++) {
+        if (broadphase->entries[i].proxy != SAP_DEAD_PROXY) {
+            broadphase->entries[write_index++] = broadphase->entries[i];
+        }
+    }
+    broadphase->entry_count = write_index;
+    broadphase->dead_entries = 0;
+}
+
+// Sweep along the axis where centers spread most and band along the next
+// one. Bands are about twice the mean box size there, so most boxes fit in
+// one band and a band holds few boxes per unit of sweep axis.
+static void choose_layout(poc_broadphase *broadphase) {
+    double sum[3] = {0.0, 0.0, 0.0};
+    double sum_squares[3] = {0.0, 0.0, 0.0};
+    double extent[3] = {0.0, 0.0, 0.0};
+    float lowest[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+    uint32_t active = 0;
+
+    for (uint32_t i = 0; i < broadphase->entry_count; i++) {
+        const sap_entry *entry = &broadphase->entries[i];
+        if (entry->band == SAP_BAND_INACTIVE) {
+            continue;
+        }
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            double center = 0.5 * ((double)entry->min[axis] + (double)entry->max[axis]);
+            sum[axis] += center;
+            sum_squares[axis] += center * center;
+            extent[axis] += (double)entry->max[axis] - (double)entry->min[axis];
+            lowest[axis] = fminf(lowest[axis], entry->min[axis]);
+        }
+        active++;
+    }
+
+    broadphase->updates_since_layout = 0;
+    if (active < 2) {
+        return;
+    }
+
+    float variance[3];
+    for (uint32_t axis = 0; axis < 3; axis++) {
+        double mean = sum[axis] / active;
+        variance[axis] = (float)fmax(sum_squares[axis] / active - mean * mean, 0.0);
+    }
+
+    uint32_t sweep_axis = broadphase->axis;
+    for (uint32_t axis = 0; axis < 3; axis++) {
+        if (variance[axis] > variance[sweep_axis] * SAP_LAYOUT_HYSTERESIS) {
+            sweep_axis = axis;
+        }
+    }
+    uint32_t band_axis = (sweep_axis + 1) % 3;
+    uint32_t other_axis = (sweep_axis + 2) % 3;
+    if (variance[other_axis] > variance[band_axis]) {
+        band_axis = other_axis;
+    }
+
+    // Point-like boxes still get about sqrt(n) bands across the spread
+    float band_size = (float)(2.0 * extent[band_axis] / active) / (1.0f - 2.0f * SAP_BAND_SLACK);
+    band_size = fmaxf(band_size, 4.0f * sqrtf(variance[band_axis]) / sqrtf((float)active));
+    if (!(band_size > 0.0f)) {
+        band_size = 1.0f;
+    }
+
+    bool layout_changed = sweep_axis != broadphase->axis || band_axis != broadphase->band_axis ||
+                          band_size > broadphase->band_size * SAP_LAYOUT_HYSTERESIS ||
+                          band_size * SAP_LAYOUT_HYSTERESIS < broadphase->band_size;
+    if (!layout_changed && !broadphase->resort) {
+        return;
+    }
+
+    if (layout_changed) {
+        broadphase->axis = sweep_axis;
+        broadphase->band_axis = band_axis;
+        broadphase->band_size = band_size;
+    }
+    broadphase->band_origin = lowest[broadphase->band_axis];
+
+    for (uint32_t i = 0; i < broadphase->entry_count; i++) {
+        sap_entry *entry = &broadphase->entries[i];
+        if (entry->band != SAP_BAND_INACTIVE) {
+            entry->band = classify_entry(broadphase, entry, SAP_BAND_INACTIVE);
+        }
+    }
+    broadphase->resort = true;
+}
+
+static bool push_pair(poc_broadphase *broadphase, uint32_t proxy_a, uint32_t proxy_b) {
+    if (!reserve((void **)&broadphase->next_pairs, &broadphase->next_pair_capacity,
+                 broadphase->next_pair_count + 1, sizeof(uint64_t))) {
+        return false;
+    }
+
+    uint64_t low = proxy_a < proxy_b ? proxy_a : proxy_b;
+    uint64_t high = proxy_a < proxy_b ? proxy_b : proxy_a;
+    broadphase->next_pairs[broadphase->next_pair_count++] = (low << 32) | high;
+    return true;
+}
+
+static inline bool overlaps_across(const sap_entry *a, const sap_entry *b, uint32_t axis_b, uint32_t axis_c) {
+    return a->min[axis_b] <= b->max[axis_b] && b->min[axis_b] <= a->max[axis_b] &&
+           a->min[axis_c] <= b->max[axis_c] && b->min[axis_c] <= a->max[axis_c];
+}
+
+// Pairs within one sorted run
+static bool sweep_run(poc_broadphase *broadphase, sap_run run) {
+    const sap_entry *entries = broadphase->entries;
+    const uint32_t axis = broadphase->axis;
+    const uint32_t axis_b = (axis + 1) % 3;
+    const uint32_t axis_c = (axis + 2) % 3;
+
+    for (uint32_t i = run.start; i < run.end; i++) {
+        const sap_entry *a = &entries[i];
+        // Sorted by min, so every later entry starting before a ends
+        // overlaps it on the sweep axis
+        for (uint32_t j = i + 1; j < run.end && entries[j].min[axis] <= a->max[axis]; j++) {
+            if (overlaps_across(a, &entries[j], axis_b, axis_c) && !push_pair(broadphase, a->proxy, entries[j].proxy)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Pairs between two sorted runs, merging them by min
+static bool sweep_runs(poc_broadphase *broadphase, sap_run first, sap_run second) {
+    const sap_entry *entries = broadphase->entries;
+    const uint32_t axis = broadphase->axis;
+    const uint32_t axis_b = (axis + 1) % 3;
+    const uint32_t axis_c = (axis + 2) % 3;
+
+    uint32_t i = first.start;
+    uint32_t j = second.start;
+    while (i < first.end && j < second.end) {
+        if (entries[i].min[axis] <= entries[j].min[axis]) {
+            const sap_entry *a = &entries[i++];
+            for (uint32_t k = j; k < second.end && entries[k].min[axis] <= a->max[axis]; k++) {
+                if (overlaps_across(a, &entries[k], axis_b, axis_c) && !push_pair(broadphase, a->proxy, entries[k].proxy)) {
+                    return false;
+                }
+            }
+        } else {
+            const sap_entry *b = &entries[j++];
+            for (uint32_t k = i; k < first.end && entries[k].min[axis] <= b->max[axis]; k++) {
+                if (overlaps_across(b, &entries[k], axis_b, axis_c) && !push_pair(broadphase, b->proxy, entries[k].proxy)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static bool sweep(poc_broadphase *broadphase) {
+    const sap_entry *entries = broadphase->entries;
+    const uint32_t count = broadphase->entry_count;
+
+    broadphase->next_pair_count = 0;
+
+    // Split the sorted entries into per-band runs; inactive entries sort last
+    uint32_t run_count = 0;
+    sap_run large = {0, 0};
+    for (uint32_t i = 0; i < count && entries[i].band != SAP_BAND_INACTIVE;) {
+        sap_run run = {i, i + 1};
+        while (run.end < count && entries[run.end].band == entries[i].band) {
+            run.end++;
+        }
+        i = run.end;
+
+        if (entries[run.start].band == SAP_BAND_LARGE) {
+            large = run;
+            continue;
+        }
+        if (!reserve((void **)&broadphase->runs, &broadphase->run_capacity, run_count + 1, sizeof(sap_run))) {
+            return false;
+        }
+        broadphase->runs[run_count++] = run;
+    }
+
+    // A box in a band ends before the band after next starts, so only
+    // neighboring bands can share pairs
+    for (uint32_t r = 0; r < run_count; r++) {
+        sap_run run = broadphase->runs[r];
+        if (!sweep_run(broadphase, run)) {
+            return false;
+        }
+        if (r > 0 && entries[broadphase->runs[r - 1].start].band + 1 == entries[run.start].band &&
+            !sweep_runs(broadphase, broadphase->runs[r - 1], run)) {
+            return false;
+        }
+        if (large.end > large.start && !sweep_runs(broadphase, run, large)) {
+            return false;
+        }
+    }
+
+    return sweep_run(broadphase, large);
+}
+
+// LSD radix sort on 16-bit digits; digits every key shares are skipped
+static bool sort_pairs(poc_broadphase *broadphase) {
+    const uint32_t count = broadphase->next_pair_count;
+    if (count < 2) {
+        return true;
+    }
+    if (!reserve((void **)&broadphase->sort_scratch, &broadphase->sort_scratch_capacity,
+                 count, sizeof(uint64_t))) {
+        return false;
+    }
+
+    uint64_t *keys = broadphase->next_pairs;
+    uint64_t *scratch = broadphase->sort_scratch;
+    uint32_t *counts = broadphase->radix_counts;
+
+    for (uint32_t shift = 0; shift < 64; shift += 16) {
+        memset(counts, 0, sizeof(uint32_t) * 65536);
+        for (uint32_t i = 0; i < count; i++) {
+            counts[(keys[i] >> shift) & 0xFFFF]++;
+        }
+        if (counts[(keys[0] >> shift) & 0xFFFF] == count) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t digit = 0; digit < 65536; digit++) {
+            uint32_t digit_count = counts[digit];
+            counts[digit] = offset;
+            offset += digit_count;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            scratch[counts[(keys[i] >> shift) & 0xFFFF]++] = keys[i];
+        }
+
+        uint64_t *swap = keys;
+        keys = scratch;
+        scratch = swap;
+    }
+
+    // Keep the sorted keys in next_pairs and the other buffer as scratch
+    if (keys != broadphase->next_pairs) {
+        uint32_t scratch_capacity = broadphase->sort_scratch_capacity;
+        broadphase->sort_scratch = broadphase->next_pairs;
+        broadphase->sort_scratch_capacity = broadphase->next_pair_capacity;
+        broadphase->next_pairs = keys;
+        broadphase->next_pair_capacity = scratch_capacity;
+    }
+    return true;
+}
+
+static void fill_pair(const poc_broadphase *broadphase, poc_overlap_pair *pair, uint64_t key) {
+    const sap_proxy *a = &broadphase->proxies[key >> 32];
+    const sap_proxy *b = &broadphase->proxies[key & 0xFFFFFFFFu];
+    pair->a_id = a->id;
+    pair->b_id = b->id;
+    pair->a = a->object;
+    pair->b = b->object;
+}
+
+// Classify pairs by merging the previous and the new sorted lists
+static bool diff_pairs(poc_broadphase *broadphase) {
+    const uint64_t *old_pairs = broadphase->pairs;
+    const uint64_t *new_pairs = broadphase->next_pairs;
+    const uint32_t old_count = broadphase->pair_count;
+    const uint32_t new_count = broadphase->next_pair_count;
+
+    if (!reserve((void **)&broadphase->enter, &broadphase->enter_capacity, new_count, sizeof(poc_overlap_pair)) ||
+        !reserve((void **)&broadphase->stay, &broadphase->stay_capacity, new_count, sizeof(poc_overlap_pair)) ||
+        !reserve((void **)&broadphase->exit, &broadphase->exit_capacity, old_count, sizeof(poc_overlap_pair))) {
+        return false;
+    }
+
+    broadphase->enter_count = 0;
+    broadphase->stay_count = 0;
+    broadphase->exit_count = 0;
+
+    uint32_t i = 0;
+    uint32_t j = 0;
+    while (i < old_count || j < new_count) {
+        if (j >= new_count || (i < old_count && old_pairs[i] < new_pairs[j])) {
+            fill_pair(broadphase, &broadphase->exit[broadphase->exit_count++], old_pairs[i++]);
+        } else if (i >= old_count || new_pairs[j] < old_pairs[i]) {
+            fill_pair(broadphase, &broadphase->enter[broadphase->enter_count++], new_pairs[j++]);
+        } else {
+            fill_pair(broadphase, &broadphase->stay[broadphase->stay_count++], new_pairs[j++]);
+            i++;
+        }
+    }
+
+    // The new list becomes the current one; keep both allocations
+    uint64_t *swap = broadphase->pairs;
+    uint32_t swap_capacity = broadphase->pair_capacity;
+    broadphase->pairs = broadphase->next_pairs;
+    broadphase->pair_capacity = broadphase->next_pair_capacity;
+    broadphase->pair_count = new_count;
+    broadphase->next_pairs = swap;
+    broadphase->next_pair_capacity = swap_capacity;
+    broadphase->next_pair_count = 0;
+    return true;
+}
+
+// Nothing moved: every pair stays
+static bool report_unchanged(poc_broadphase *broadphase) {
+    if (!reserve((void **)&broadphase->stay, &broadphase->stay_capacity,
+                 broadphase->pair_count, sizeof(poc_overlap_pair))) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < broadphase->pair_count; i++) {
+        fill_pair(broadphase, &broadphase->stay[i], broadphase->pairs[i]);
+    }
+    broadphase->stay_count = broadphase->pair_count;
+    broadphase->enter_count = 0;
+    broadphase->exit_count = 0;
+    return true;
+}
+
+void poc_broadphase_update(poc_broadphase *broadphase, poc_scene_object **changed, uint32_t count) {
+    if (!broadphase) {
+        return;
+    }
+
+    double start_time = poc_get_time();
+
+    bool structure_changed = broadphase->resort || broadphase->dead_entries > 0 || broadphase->appended_entries > 0;
+    for (uint32_t i = 0; i < count; i++) {
+        poc_scene_object *object = changed[i];
+        if (object->broadphase_proxy == 0) {
+            add_proxy(broadphase, object);
+        } else {
+            const sap_proxy *proxy = &broadphase->proxies[object->broadphase_proxy - 1];
+            fill_entry(broadphase, &broadphase->entries[proxy->entry], object);
+        }
+    }
+
+    bool success;
+    if (count == 0 && !structure_changed) {
+        success = report_unchanged(broadphase);
+    } else {
+        if (broadphase->dead_entries > 0) {
+            compact_entries(broadphase);
+        }
+        if (broadphase->resort || ++broadphase->updates_since_layout >= SAP_LAYOUT_INTERVAL) {
+            choose_layout(broadphase);
+        }
+        sort_entries(broadphase);
+        success = sweep(broadphase) && sort_pairs(broadphase) && diff_pairs(broadphase);
+    }
+
+    if (!success) {
+        // Out of memory: report nothing rather than half a diff, and rebuild
+        // from scratch next time
+        broadphase->enter_count = 0;
+        broadphase->stay_count = 0;
+        broadphase->exit_count = 0;
+        broadphase->resort = true;
+    }
+
+    // Exits naming removed proxies have been reported; recycle their slots
+    for (uint32_t i = 0; success && i < broadphase->released_count; i++) {
+        broadphase->free_proxies[broadphase->free_count++] = broadphase->released_proxies[i];
+    }
+    if (success) {
+        broadphase->released_count = 0;
+    }
+
+    broadphase->update_ms = (poc_get_time() - start_time) * 1000.0;
+
+    if (broadphase->callback) {
+        poc_overlap_events events;
+        poc_broadphase_get_events(broadphase, &events);
+        broadphase->callback(broadphase->scene, &events, broadphase->user_data);
+    }
+}
+
+void poc_broadphase_get_events(const poc_broadphase *broadphase, poc_overlap_events *events) {
+    if (!events) {
+        return;
+    }
+
+    memset(events, 0, sizeof(*events));
+    if (!broadphase) {
+        return;
+    }
+
+    events->enter = broadphase->enter;
+    events->enter_count = broadphase->enter_count;
+    events->stay = broadphase->stay;
+    events->stay_count = broadphase->stay_count;
+    events->exit = broadphase->exit;
+    events->exit_count = broadphase->exit_count;
+    events->pair_count = broadphase->pair_count;
+    events->update_ms = broadphase->update_ms;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file broadphase.h
+ * @brief Sweep-and-prune overlap tracking for scene objects
+ *
+ * Each participating object has a proxy holding a copy of its world AABB.
+ * Space is cut into bands along a second axis, and the proxies are kept
+ * sorted by band, then by their minimum along the sweep axis (the axis where
+ * object centers are most spread out). A box fits in one band and reaches at
+ * most into the next one, so each band is swept against itself and its
+ * neighbor. Boxes too tall for a band share one extra band that is swept
+ * against all the others.
+ *
+ * Every scene update refreshes only the proxies of changed objects and
+ * re-sorts them with an insertion sort, which costs close to O(n) while
+ * motion is coherent. The sweep collects the overlapping pairs, and diffing
+ * them against the previous update's sorted pair list yields the enter, stay
+ * and exit events.
+ *
+ * Objects take part while they are enabled and have valid world bounds
+ * (that is, a mesh).
+ */
+
+#pragma once
+
+#include "scene_object.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Broadphase state owned by one scene
+ */
+typedef struct poc_broadphase poc_broadphase;
+
+/**
+ * @brief Create a broadphase holding every object already in a scene
+ *
+ * @param scene Scene to track
+ * @return New broadphase, or NULL on failure
+ */
+poc_broadphase *poc_broadphase_create(struct poc_scene *scene);
+
+/**
+ * @brief Destroy a broadphase and detach the objects it tracks
+ */
+void poc_broadphase_destroy(poc_broadphase *broadphase);
+
+/**
+ * @brief Set the callback invoked after every update
+ */
+void poc_broadphase_set_callback(poc_broadphase *broadphase, poc_overlap_callback callback, void *user_data);
+
+/**
+ * @brief Stop tracking an object that is leaving the scene
+ *
+ * Its pairs are reported as exits by the next update.
+ */
+void poc_broadphase_remove(poc_broadphase *broadphase, poc_scene_object *object);
+
+/**
+ * @brief Refresh changed objects, recompute pairs and report events
+ *
+ * Called by poc_scene_update() after world bounds have been updated.
+ *
+ * @param broadphase Broadphase to update
+ * @param changed Objects changed this update (new objects included)
+ * @param count Number of changed objects
+ */
+void poc_broadphase_update(poc_broadphase *broadphase, poc_scene_object **changed, uint32_t count);
+
+/**
+ * @brief Get the events produced by the last update
+ */
+void poc_broadphase_get_events(const poc_broadphase *broadphase, poc_overlap_events *events);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,86 @@
+#define _DEFAULT_SOURCE
+#include "file_map.h"
+#include "asset_archive.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool poc_file_map_open(const char *path, poc_file_map *map) {
+    memset(map, 0, sizeof(*map));
+    if (!path) return false;
+
+    if (poc_archive_find(path, &map->data, &map->size)) {
+        map->archived = true;
+        return true;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return false;
+    }
+    map->device = (uint64_t)st.st_dev;
+    map->inode = (uint64_t)st.st_ino;
+
+    // mmap rejects zero-length mappings; an empty file is still a valid file
+    if (st.st_size == 0) {
+        close(fd);
+        return true;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file
+    close(fd);
+    if (data == MAP_FAILED) {
+        memset(map, 0, sizeof(*map));
+        return false;
+    }
+
+    map->data = data;
+    map->size = (size_t)st.st_size;
+    return true;
+}
+
+void poc_file_map_advise_sequential(const poc_file_map *map) {
+    if (!map || !map->data) return;
+    madvise((void *)map->data, map->size, MADV_SEQUENTIAL);
+}
+
+size_t poc_file_map_resident_bytes(const poc_file_map *map) {
+    if (!map || !map->data) return 0;
+
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t pages = (map->size + page - 1) / page;
+#ifdef POC_PLATFORM_MACOS
+    char *residency = malloc(pages);
+#else
+    unsigned char *residency = malloc(pages);
+#endif
+    if (!residency) return 0;
+
+    size_t resident = 0;
+    if (mincore((void *)map->data, map->size, residency) == 0) {
+        for (size_t i = 0; i < pages; i++) {
+            if (residency[i] & 1) resident++;
+        }
+    }
+    free(residency);
+
+    // The last page is only partly file data
+    size_t bytes = resident * page;
+    return bytes < map->size ? bytes : map->size;
+}
+
+void poc_file_map_close(poc_file_map *map) {
+    if (!map) return;
+    if (map->data && !map->archived) {
+        munmap((void *)map->data, map->size);
+    }
+    memset(map, 0, sizeof(*map));
+}
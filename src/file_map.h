@@ -0,0 +1,70 @@
+/**
+ * @file file_map.h
+ * @brief Read-only memory mapping of whole files
+ *
+ * Loaders scan mapped files in place instead of copying them through stdio
+ * buffers. The page cache backs the mapping, so a file that was read
+ * recently costs no disk I/O and no extra copy.
+ *
+ * Files held by a mounted asset archive (see asset_archive.h) are served
+ * from the archive's mapping instead of being opened.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief A mapped file
+ *
+ * An empty file maps to data == NULL with size 0.
+ */
+typedef struct {
+    const char *data; /**< First byte of the file (not NUL-terminated) */
+    size_t size;      /**< File size in bytes */
+    bool archived;    /**< Borrowed from the mounted asset archive; closing does not unmap */
+    uint64_t device;  /**< Device of the mapped file; 0 when archived */
+    uint64_t inode;   /**< Inode of the mapped file; 0 when archived */
+} poc_file_map;
+
+/**
+ * @brief Map a file for reading
+ *
+ * @param path File to map
+ * @param map Receives the mapping (zeroed on failure)
+ * @return true on success, false if the file cannot be opened or mapped
+ */
+bool poc_file_map_open(const char *path, poc_file_map *map);
+
+/**
+ * @brief Hint that the mapping will be read front to back
+ */
+void poc_file_map_advise_sequential(const poc_file_map *map);
+
+/**
+ * @brief Count the bytes of a mapping currently held in memory
+ *
+ * Pages the kernel has dropped under memory pressure, or never faulted in,
+ * are not counted.
+ *
+ * @param map The mapping
+ * @return Resident bytes, rounded to whole pages
+ */
+size_t poc_file_map_resident_bytes(const poc_file_map *map);
+
+/**
+ * @brief Unmap a file mapped with poc_file_map_open()
+ *
+ * Safe to call on a zeroed mapping.
+ */
+void poc_file_map_close(poc_file_map *map);
+
+#ifdef __cplusplus
+}
+#endif
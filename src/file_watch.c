@@ -0,0 +1,357 @@
+#define _DEFAULT_SOURCE
+#include "file_watch.h"
+#include "asset_manager.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#ifdef POC_PLATFORM_LINUX
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
+typedef struct {
+    char path[POC_ASSET_PATH_MAX];
+    uint32_t directory;         // Index into g_directories
+    poc_file_changed_callback callback;
+    void *user_data;
+    uint32_t refs;
+} watched_file;
+
+typedef struct {
+    char path[POC_ASSET_PATH_MAX];
+    int wd;                     // inotify watch, -1 while not watched
+    uint32_t files;             // Registrations in this directory
+} watched_directory;
+
+// Both arrays only grow; entries without references are reused
+static pthread_mutex_t g_watch_mutex = PTHREAD_MUTEX_INITIALIZER;
+// Held by the watcher thread while it runs callbacks
+static pthread_mutex_t g_callback_mutex = PTHREAD_MUTEX_INITIALIZER;
+static watched_file *g_files = NULL;
+static uint32_t g_file_count = 0;
+static watched_directory *g_directories = NULL;
+static uint32_t g_directory_count = 0;
+
+static bool g_running = false;
+#ifdef POC_PLATFORM_LINUX
+static pthread_t g_thread;
+static int g_inotify = -1;
+static int g_wake[2] = {-1, -1};    // Written to stop the thread
+
+#define WATCH_EVENTS (IN_CLOSE_WRITE | IN_MOVED_TO)
+#endif
+
+static void directory_of(const char *path, char *out) {
+    const char *slash = strrchr(path, '/');
+    if (!slash) {
+        strcpy(out, ".");
+        return;
+    }
+    size_t length = slash == path ? 1 : (size_t)(slash - path);
+    memcpy(out, path, length);
+    out[length] = '\0';
+}
+
+// Caller holds the mutex
+static uint32_t find_directory(const char *path) {
+    for (uint32_t i = 0; i < g_directory_count; i++) {
+        if (g_directories[i].files > 0 && strcmp(g_directories[i].path, path) == 0) {
+            return i;
+        }
+    }
+    return UINT32_MAX;
+}
+
+// Caller holds the mutex
+static void watch_directory_locked(watched_directory *directory) {
+#ifdef POC_PLATFORM_LINUX
+    if (g_running && directory->wd < 0) {
+        directory->wd = inotify_add_watch(g_inotify, directory->path, WATCH_EVENTS);
+        if (directory->wd < 0) {
+            printf("⚠ Cannot watch directory %s for changes\n", directory->path);
+        }
+    }
+#else
+    (void)directory;
+#endif
+}
+
+// Caller holds the mutex
+static void unwatch_directory_locked(watched_directory *directory) {
+#ifdef POC_PLATFORM_LINUX
+    if (directory->wd >= 0 && g_inotify >= 0) {
+        inotify_rm_watch(g_inotify, directory->wd);
+    }
+#endif
+    directory->wd = -1;
+}
+
+bool poc_file_watch_add(const char *path, poc_file_changed_callback callback, void *user_data) {
+    char normalized[POC_ASSET_PATH_MAX];
+    if (!path || !callback || !poc_asset_normalize_path(path, normalized, sizeof(normalized))) {
+        return false;
+    }
+    char directory_path[POC_ASSET_PATH_MAX];
+    directory_of(normalized, directory_path);
+
+    pthread_mutex_lock(&g_watch_mutex);
+    for (uint32_t i = 0; i < g_file_count; i++) {
+        watched_file *file = &g_files[i];
+        if (file->refs > 0 && file->callback == callback && file->user_data == user_data &&
+            strcmp(file->path, normalized) == 0) {
+            file->refs++;
+            pthread_mutex_unlock(&g_watch_mutex);
+            return true;
+        }
+    }
+
+    uint32_t directory = find_directory(directory_path);
+    if (directory == UINT32_MAX) {
+        for (directory = 0; directory < g_directory_count && g_directories[directory].files > 0; directory++) {
+        }
+        if (directory == g_directory_count) {
+            watched_directory *directories = realloc(g_directories, (g_directory_count + 1) * sizeof(watched_directory));
+            if (!directories) {
+                pthread_mutex_unlock(&g_watch_mutex);
+                return false;
+            }
+            g_directories = directories;
+            g_directory_count++;
+        }
+        memcpy(g_directories[directory].path, directory_path, sizeof(directory_path));
+        g_directories[directory].wd = -1;
+        g_directories[directory].files = 0;
+    }
+
+    uint32_t index;
+    for (index = 0; index < g_file_count && g_files[index].refs > 0; index++) {
+    }
+    if (index == g_file_count) {
+        watched_file *files = realloc(g_files, (g_file_count + 1) * sizeof(watched_file));
+        if (!files) {
+            pthread_mutex_unlock(&g_watch_mutex);
+            return false;
+        }
+        g_files = files;
+        g_file_count++;
+    }
+
+    watched_file *file = &g_files[index];
+    memcpy(file->path, normalized, sizeof(normalized));
+    file->directory = directory;
+    file->callback = callback;
+    file->user_data = user_data;
+    file->refs = 1;
+
+    g_directories[directory].files++;
+    watch_directory_locked(&g_directories[directory]);
+    pthread_mutex_unlock(&g_watch_mutex);
+    return true;
+}
+
+void poc_file_watch_remove(const char *path, poc_file_changed_callback callback, void *user_data) {
+    char normalized[POC_ASSET_PATH_MAX];
+    if (!path || !poc_asset_normalize_path(path, normalized, sizeof(normalized))) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_watch_mutex);
+    for (uint32_t i = 0; i < g_file_count; i++) {
+        watched_file *file = &g_files[i];
+        if (file->refs == 0 || file->callback != callback || file->user_data != user_data ||
+            strcmp(file->path, normalized) != 0) {
+            continue;
+        }
+        if (--file->refs == 0) {
+            watched_directory *directory = &g_directories[file->directory];
+            if (--directory->files == 0) {
+                unwatch_directory_locked(directory);
+            }
+        }
+        break;
+    }
+    pthread_mutex_unlock(&g_watch_mutex);
+}
+
+#ifdef POC_PLATFORM_LINUX
+
+typedef struct {
+    poc_file_changed_callback callback;
+    void *user_data;
+} pending_call;
+
+// Call everything registered for one changed file, outside the lock so
+// callbacks may take their own subsystem's locks
+static void notify_change(int wd, const char *name) {
+    char path[POC_ASSET_PATH_MAX];
+    pending_call *calls = NULL;
+    uint32_t call_count = 0;
+
+    pthread_mutex_lock(&g_watch_mutex);
+    for (uint32_t d = 0; d < g_directory_count; d++) {
+        if (g_directories[d].files == 0 || g_directories[d].wd != wd) {
+            continue;
+        }
+
+        char joined[POC_ASSET_PATH_MAX * 2];
+        if (strcmp(g_directories[d].path, ".") == 0) {
+            snprintf(joined, sizeof(joined), "%s", name);
+        } else {
+            snprintf(joined, sizeof(joined), "%s/%s", g_directories[d].path, name);
+        }
+        if (!poc_asset_normalize_path(joined, path, sizeof(path))) {
+            break;
+        }
+
+        for (uint32_t i = 0; i < g_file_count; i++) {
+            const watched_file *file = &g_files[i];
+            if (file->refs == 0 || file->directory != d || strcmp(file->path, path) != 0) {
+                continue;
+            }
+            pending_call *grown = realloc(calls, (call_count + 1) * sizeof(pending_call));
+            if (!grown) {
+                printf("⚠ Out of memory notifying watchers of %s; some callbacks were skipped\n", path);
+                break;
+            }
+            calls = grown;
+            calls[call_count++] = (pending_call){file->callback, file->user_data};
+        }
+        break;
+    }
+    pthread_mutex_unlock(&g_watch_mutex);
+
+    pthread_mutex_lock(&g_callback_mutex);
+    for (uint32_t i = 0; i < call_count; i++) {
+        calls[i].callback(path, calls[i].user_data);
+    }
+    pthread_mutex_unlock(&g_callback_mutex);
+    free(calls);
+}
+
+static void *watch_thread(void *arg) {
+    (void)arg;
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    for (;;) {
+        struct pollfd fds[2] = {
+            {.fd = g_inotify, .events = POLLIN},
+            {.fd = g_wake[0], .events = POLLIN},
+        };
+        if (poll(fds, 2, -1) < 0) {
+            continue;
+        }
+        if (fds[1].revents) {
+            break;
+        }
+
+        ssize_t length;
+        while ((length = read(g_inotify, buffer, sizeof(buffer))) > 0) {
+            for (char *p = buffer; p < buffer + length;) {
+                const struct inotify_event *event = (const struct inotify_event *)p;
+                if (event->len > 0 && (event->mask & WATCH_EVENTS)) {
+                    notify_change(event->wd, event->name);
+                }
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+    }
+    return NULL;
+}
+
+bool poc_file_watch_start(void) {
+    pthread_mutex_lock(&g_watch_mutex);
+    if (g_running) {
+        pthread_mutex_unlock(&g_watch_mutex);
+        return true;
+    }
+
+    g_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (g_inotify < 0 || pipe(g_wake) != 0) {
+        if (g_inotify >= 0) {
+            close(g_inotify);
+        }
+        g_inotify = -1;
+        pthread_mutex_unlock(&g_watch_mutex);
+        printf("⚠ Could not set up file watching\n");
+        return false;
+    }
+
+    g_running = true;
+    for (uint32_t i = 0; i < g_directory_count; i++) {
+        if (g_directories[i].files > 0) {
+            watch_directory_locked(&g_directories[i]);
+        }
+    }
+
+    if (pthread_create(&g_thread, NULL, watch_thread, NULL) != 0) {
+        g_running = false;
+        for (uint32_t i = 0; i < g_directory_count; i++) {
+            unwatch_directory_locked(&g_directories[i]);
+        }
+        close(g_inotify);
+        close(g_wake[0]);
+        close(g_wake[1]);
+        g_inotify = -1;
+        pthread_mutex_unlock(&g_watch_mutex);
+        return false;
+    }
+    pthread_mutex_unlock(&g_watch_mutex);
+
+    printf("✓ Watching %u directories for asset changes\n", g_directory_count);
+    return true;
+}
+
+void poc_file_watch_stop(void) {
+    pthread_mutex_lock(&g_watch_mutex);
+    if (!g_running) {
+        pthread_mutex_unlock(&g_watch_mutex);
+        return;
+    }
+    g_running = false;
+    pthread_mutex_unlock(&g_watch_mutex);
+
+    // The thread takes the mutex to dispatch, so join without holding it
+    char wake = 1;
+    if (write(g_wake[1], &wake, 1) != 1) {
+        printf("⚠ Could not wake the file watcher\n");
+    }
+    pthread_join(g_thread, NULL);
+
+    pthread_mutex_lock(&g_watch_mutex);
+    for (uint32_t i = 0; i < g_directory_count; i++) {
+        unwatch_directory_locked(&g_directories[i]);
+    }
+    close(g_inotify);
+    close(g_wake[0]);
+    close(g_wake[1]);
+    g_inotify = -1;
+    pthread_mutex_unlock(&g_watch_mutex);
+}
+
+#else
+
+bool poc_file_watch_start(void) {
+    printf("⚠ File watching is not supported on this platform\n");
+    return false;
+}
+
+void poc_file_watch_stop(void) {
+}
+
+#endif
+
+bool poc_file_watch_is_running(void) {
+    pthread_mutex_lock(&g_watch_mutex);
+    bool running = g_running;
+    pthread_mutex_unlock(&g_watch_mutex);
+    return running;
+}
+
+void poc_file_watch_flush(void) {
+    pthread_mutex_lock(&g_callback_mutex);
+    pthread_mutex_unlock(&g_callback_mutex);
+}
@@ -0,0 +1,88 @@
+/**
+ * @file file_watch.h
+ * @brief Notify subsystems when files they loaded change on disk
+ *
+ * A background thread waits on inotify for the directories of watched
+ * files and calls the callbacks registered for a file once a writer closes
+ * it or renames a new version over it. Directories are watched instead of
+ * files so exporters that save through a temporary file and rename it
+ * into place are seen too.
+ *
+ * Files can be registered before the watcher starts; they are picked up
+ * when it does. Callbacks run on the watcher thread and must only record
+ * the change (schedule a reload, set a flag); the subsystem applies it on
+ * its own thread.
+ *
+ * Only Linux has a watcher; elsewhere poc_file_watch_start() fails and
+ * registrations are kept but never fire.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Called on the watcher thread when a watched file changed
+ *
+ * @param path Normalized path the file was registered under
+ * @param user_data Value given to poc_file_watch_add()
+ */
+typedef void (*poc_file_changed_callback)(const char *path, void *user_data);
+
+/**
+ * @brief Start the watcher thread
+ *
+ * @return true if the watcher is running (also if it already was)
+ */
+bool poc_file_watch_start(void);
+
+/**
+ * @brief Stop the watcher thread
+ *
+ * Registrations stay and are watched again by the next start. Returns
+ * after any running callback has finished.
+ */
+void poc_file_watch_stop(void);
+
+/**
+ * @brief Check whether the watcher thread is running
+ */
+bool poc_file_watch_is_running(void);
+
+/**
+ * @brief Register a callback for changes to a file
+ *
+ * Registering the same path, callback and user data again only counts a
+ * reference, so the callback still runs once per change.
+ *
+ * @param path File to watch; it does not need to exist yet
+ * @param callback Function to call on changes
+ * @param user_data Passed to @p callback
+ * @return true on success
+ */
+bool poc_file_watch_add(const char *path, poc_file_changed_callback callback, void *user_data);
+
+/**
+ * @brief Drop one registration made with poc_file_watch_add()
+ *
+ * A callback the watcher thread already started may still be running; use
+ * poc_file_watch_flush() before freeing what its user data points to.
+ */
+void poc_file_watch_remove(const char *path, poc_file_changed_callback callback, void *user_data);
+
+/**
+ * @brief Wait until no callback is running on the watcher thread
+ *
+ * Must not be called from a callback, or while holding a lock a callback
+ * takes.
+ */
+void poc_file_watch_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,204 @@
+#define _POSIX_C_SOURCE 200809L
+#include "frame_loop.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+
+// Triple buffer state word: low two bits hold the index of the most recently
+// published slot, FRESH marks that the render thread has not taken it yet
+#define SNAPSHOT_SLOT_COUNT 3
+#define SNAPSHOT_INDEX_MASK 0x3u
+#define SNAPSHOT_FRESH_BIT 0x4u
+
+struct poc_frame_loop {
+    poc_context *ctx;
+    poc_render_snapshot snapshots[SNAPSHOT_SLOT_COUNT];
+
+    // Slot ownership: the simulation thread writes write_index, the render
+    // thread reads read_index, and the remaining slot is exchanged atomically
+    uint32_t write_index;
+    uint32_t read_index;
+    atomic_uint shared_state;
+
+    pthread_t render_thread;
+    sem_t frame_ready;
+    atomic_bool running;
+    atomic_int render_error;
+
+    // Statistics
+    atomic_uint_fast64_t frames_published;
+    atomic_uint_fast64_t frames_rendered;
+    double last_publish_time;
+    double sim_time_accum;
+    atomic_uint_fast64_t render_time_us_accum;
+};
+
+static void *render_thread_main(void *arg) {
+    poc_frame_loop *loop = arg;
+
+    while (atomic_load_explicit(&loop->running, memory_order_acquire)) {
+        unsigned int state = atomic_load_explicit(&loop->shared_state, memory_order_acquire);
+        if (!(state & SNAPSHOT_FRESH_BIT)) {
+            // Nothing new to draw; sleep until the simulation publishes
+            sem_wait(&loop->frame_ready);
+            continue;
+        }
+
+        // Take the freshest snapshot, handing our previous slot back
+        unsigned int previous = atomic_exchange_explicit(&loop->shared_state, loop->read_index,
+                                                         memory_order_acq_rel);
+        loop->read_index = previous & SNAPSHOT_INDEX_MASK;
+
+        double start = poc_get_time();
+        poc_result result = poc_context_draw_snapshot(loop->ctx, &loop->snapshots[loop->read_index]);
+        double elapsed = poc_get_time() - start;
+
+        atomic_fetch_add_explicit(&loop->render_time_us_accum, (uint_fast64_t)(elapsed * 1000000.0),
+                                  memory_order_relaxed);
+        atomic_fetch_add_explicit(&loop->frames_rendered, 1, memory_order_relaxed);
+
+        if (result != POC_RESULT_SUCCESS) {
+            printf("Render thread failed to draw frame: %s\n", poc_result_to_string(result));
+            atomic_store_explicit(&loop->render_error, (int)result, memory_order_release);
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+poc_frame_loop *poc_frame_loop_create(poc_context *ctx) {
+    if (!ctx) {
+        return NULL;
+    }
+
+    if (!poc_context_supports_snapshots(ctx)) {
+        printf("⚠ Renderer cannot draw from snapshots, frame loop not started\n");
+        return NULL;
+    }
+
+    poc_frame_loop *loop = malloc(sizeof(poc_frame_loop));
+    if (!loop) {
+        printf("Failed to allocate frame loop\n");
+        return NULL;
+    }
+
+    memset(loop, 0, sizeof(poc_frame_loop));
+    loop->ctx = ctx;
+    loop->write_index = 0;
+    atomic_init(&loop->shared_state, 1u);
+    loop->read_index = 2;
+    atomic_init(&loop->running, true);
+    atomic_init(&loop->render_error, POC_RESULT_SUCCESS);
+    atomic_init(&loop->frames_published, 0);
+    atomic_init(&loop->frames_rendered, 0);
+    atomic_init(&loop->render_time_us_accum, 0);
+
+    if (sem_init(&loop->frame_ready, 0, 0) != 0) {
+        printf("Failed to create frame loop semaphore\n");
+        free(loop);
+        return NULL;
+    }
+
+    poc_context_set_threaded(ctx, true);
+
+    if (pthread_create(&loop->render_thread, NULL, render_thread_main, loop) != 0) {
+        printf("Failed to start render thread\n");
+        poc_context_set_threaded(ctx, false);
+        sem_destroy(&loop->frame_ready);
+        free(loop);
+        return NULL;
+    }
+
+    printf("✓ Frame loop started (simulation and render threads decoupled)\n");
+    return loop;
+}
+
+void poc_frame_loop_destroy(poc_frame_loop *loop) {
+    if (!loop) {
+        return;
+    }
+
+    atomic_store_explicit(&loop->running, false, memory_order_release);
+    sem_post(&loop->frame_ready);
+    pthread_join(loop->render_thread, NULL);
+
+    // Back to single-threaded operation; releases any deferred GPU resources
+    poc_context_set_threaded(loop->ctx, false);
+
+    for (uint32_t i = 0; i < SNAPSHOT_SLOT_COUNT; i++) {
+        free(loop->snapshots[i].items);
+        free(loop->snapshots[i].materials);
+    }
+
+    sem_destroy(&loop->frame_ready);
+    free(loop);
+}
+
+poc_result poc_frame_loop_publish(poc_frame_loop *loop) {
+    if (!loop) {
+        return POC_RESULT_ERROR_INIT_FAILED;
+    }
+
+    int render_error = atomic_load_explicit(&loop->render_error, memory_order_acquire);
+    if (render_error != POC_RESULT_SUCCESS) {
+        return (poc_result)render_error;
+    }
+
+    poc_render_snapshot *snapshot = &loop->snapshots[loop->write_index];
+    poc_result result = poc_context_capture_snapshot(loop->ctx, snapshot);
+    if (result != POC_RESULT_SUCCESS) {
+        return result;
+    }
+
+    // Publish and take back whichever slot was waiting (possibly never drawn)
+    unsigned int previous = atomic_exchange_explicit(&loop->shared_state,
+                                                     loop->write_index | SNAPSHOT_FRESH_BIT,
+                                                     memory_order_acq_rel);
+    loop->write_index = previous & SNAPSHOT_INDEX_MASK;
+
+    // The render thread only sleeps after seeing FRESH clear, so wake it on
+    // that transition alone; posting every publish would grow the count
+    // without bound while it is busy drawing
+    if (!(previous & SNAPSHOT_FRESH_BIT)) {
+        sem_post(&loop->frame_ready);
+    }
+
+    double now = poc_get_time();
+    if (loop->last_publish_time > 0.0) {
+        loop->sim_time_accum += now - loop->last_publish_time;
+    }
+    loop->last_publish_time = now;
+    atomic_fetch_add_explicit(&loop->frames_published, 1, memory_order_relaxed);
+
+    return POC_RESULT_SUCCESS;
+}
+
+void poc_frame_loop_get_stats(const poc_frame_loop *loop, poc_frame_loop_stats *stats) {
+    if (!stats) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(poc_frame_loop_stats));
+    if (!loop) {
+        return;
+    }
+
+    poc_frame_loop *mutable_loop = (poc_frame_loop *)loop;
+    stats->frames_published = atomic_load_explicit(&mutable_loop->frames_published, memory_order_relaxed);
+    stats->frames_rendered = atomic_load_explicit(&mutable_loop->frames_rendered, memory_order_relaxed);
+    stats->frames_dropped = stats->frames_published > stats->frames_rendered + 1
+        ? stats->frames_published - stats->frames_rendered - 1
+        : 0;
+
+    if (stats->frames_published > 1) {
+        stats->avg_sim_frame_ms = loop->sim_time_accum * 1000.0 / (double)(stats->frames_published - 1);
+    }
+    if (stats->frames_rendered > 0) {
+        uint_fast64_t render_us = atomic_load_explicit(&mutable_loop->render_time_us_accum, memory_order_relaxed);
+        stats->avg_render_frame_ms = (double)render_us / 1000.0 / (double)stats->frames_rendered;
+    }
+}
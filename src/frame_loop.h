@@ -0,0 +1,111 @@
+/**
+ * @file frame_loop.h
+ * @brief Render snapshots shared between the simulation and render threads
+ *
+ * The frame loop runs simulation (scripts, scene update) on the calling thread
+ * while a dedicated render thread records and submits the previous frame. The
+ * two sides exchange compact render snapshots through a lock-free triple buffer.
+ */
+
+#pragma once
+
+#include "poc_engine.h"
+#include "obj_loader.h"
+#include <cglm/cglm.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Backend GPU resources of one renderable's mesh
+ *
+ * Immutable once built. Loading another mesh into the renderable replaces
+ * it, and the backend keeps the old one alive until every snapshot that
+ * referenced it has been drawn.
+ */
+typedef struct poc_renderable_gpu poc_renderable_gpu;
+
+/**
+ * @brief One visible object in a render snapshot
+ *
+ * The render thread never dereferences the object's poc_renderable, which
+ * the simulation thread keeps changing; everything it reads is here.
+ */
+typedef struct poc_render_item {
+    poc_renderable_gpu *gpu;    /**< Buffers, ranges and uniform slots to draw with */
+    uint32_t object_id;         /**< Scene object ID the item was captured from */
+    uint32_t first_material;    /**< Index of the item's first material in the snapshot */
+    uint32_t material_count;    /**< One material per uniform slot of gpu */
+    mat4 model;                 /**< World transform at capture time */
+} poc_render_item;
+
+/**
+ * @brief Everything the render thread needs to draw one frame
+ *
+ * Captured on the simulation thread; read-only once published.
+ */
+typedef struct poc_render_snapshot {
+    uint64_t frame;             /**< Monotonic snapshot number assigned at capture */
+    poc_render_item *items;     /**< Visible objects */
+    uint32_t item_count;        /**< Number of visible objects */
+    uint32_t item_capacity;     /**< Capacity of items array */
+    poc_material *materials;    /**< Per-range materials of all items */
+    uint32_t material_count;    /**< Number of materials */
+    uint32_t material_capacity; /**< Capacity of materials array */
+
+    mat4 view;                  /**< Camera view matrix */
+    mat4 proj;                  /**< Camera projection matrix (Vulkan clip space) */
+    vec3 view_pos;              /**< Camera position */
+    float clear_color[4];       /**< Clear color for the frame */
+    bool play_mode;             /**< Lit (play) or unlit (edit) shading */
+} poc_render_snapshot;
+
+/**
+ * @brief Check whether the context's renderer can capture and draw snapshots
+ *
+ * @param ctx The rendering context
+ * @return True if poc_context_capture_snapshot and poc_context_draw_snapshot
+ *         are implemented for the active renderer
+ */
+bool poc_context_supports_snapshots(const poc_context *ctx);
+
+/**
+ * @brief Capture the context's active scene and camera into a snapshot
+ *
+ * Runs poc_scene_update on the active scene, then records every visible object
+ * that has GPU resources. Called on the simulation thread.
+ *
+ * @param ctx The rendering context
+ * @param snapshot Snapshot to fill (its item array is reused and grown as needed)
+ * @return POC_RESULT_SUCCESS on success, or an error code on failure
+ */
+poc_result poc_context_capture_snapshot(poc_context *ctx, poc_render_snapshot *snapshot);
+
+/**
+ * @brief Record, submit and present one frame from a snapshot
+ *
+ * Called on the render thread. Does not read the scene or camera directly.
+ *
+ * @param ctx The rendering context
+ * @param snapshot Snapshot to draw
+ * @return POC_RESULT_SUCCESS on success, or an error code on failure
+ */
+poc_result poc_context_draw_snapshot(poc_context *ctx, const poc_render_snapshot *snapshot);
+
+/**
+ * @brief Switch the context between single-threaded and render-thread operation
+ *
+ * While threaded, renderable destruction is deferred until the render thread
+ * can no longer reference the renderable, and queue access is serialized.
+ *
+ * @param ctx The rendering context
+ * @param threaded True when a render thread owns frame submission
+ */
+void poc_context_set_threaded(poc_context *ctx, bool threaded);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,1242 @@
+#include "gltf_loader.h"
+#include "poc_engine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stddef.h>
+#include <math.h>
+
+#define GLB_MAGIC 0x46546C67u       // "glTF"
+#define GLB_VERSION 2u
+#define GLB_CHUNK_JSON 0x4E4F534Au  // "JSON"
+#define GLB_CHUNK_BIN 0x004E4942u   // "BIN\0"
+
+#define GLTF_MODE_TRIANGLES 4u
+#define GLTF_BYTE 5120u
+#define GLTF_UNSIGNED_BYTE 5121u
+#define GLTF_SHORT 5122u
+#define GLTF_UNSIGNED_SHORT 5123u
+#define GLTF_UNSIGNED_INT 5125u
+#define GLTF_FLOAT 5126u
+
+// Deepest JSON nesting accepted; glTF itself needs about six levels
+#define JSON_MAX_DEPTH 64
+#define JSON_NONE UINT32_MAX
+
+/*
+ * JSON
+ *
+ * The chunk is parsed into a flat token array in document order. Containers
+ * record their element count and the index just past their subtree, so
+ * siblings are skipped without walking children. Object members are a key
+ * token followed by the value's tokens. Strings and numbers keep their span
+ * in the chunk and are decoded only when read.
+ */
+
+typedef enum {
+    JSON_NULL,
+    JSON_BOOL,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT
+} json_type;
+
+typedef struct {
+    json_type type;
+    uint32_t start;             /**< Offset of the text; string contents exclude the quotes */
+    uint32_t length;            /**< Length of the text */
+    uint32_t count;             /**< Elements or members of a container */
+    uint32_t end;               /**< Index of the first token after this value */
+} json_token;
+
+typedef struct {
+    const char *text;
+    uint32_t size;
+    uint32_t pos;
+    json_token *tokens;
+    uint32_t count;
+    uint32_t capacity;
+} json_parser;
+
+static void skip_whitespace(json_parser *p) {
+    while (p->pos < p->size &&
+           (p->text[p->pos] == ' ' || p->text[p->pos] == '\t' ||
+            p->text[p->pos] == '\n' || p->text[p->pos] == '\r')) {
+        p->pos++;
+    }
+}
+
+static uint32_t push_token(json_parser *p, json_type type, uint32_t start) {
+    if (p->count == p->capacity) {
+        uint32_t capacity = p->capacity == 0 ? 256 : p->capacity * 2;
+        json_token *tokens = realloc(p->tokens, capacity * sizeof(json_token));
+        if (!tokens) {
+            return JSON_NONE;
+        }
+        p->tokens = tokens;
+        p->capacity = capacity;
+    }
+    p->tokens[p->count] = (json_token){type, start, 0, 0, p->count + 1};
+    return p->count++;
+}
+
+static bool parse_string(json_parser *p) {
+    uint32_t start = ++p->pos;
+    while (p->pos < p->size && p->text[p->pos] != '"') {
+        p->pos += p->text[p->pos] == '\\' ? 2 : 1;
+    }
+    if (p->pos >= p->size) {
+        return false;
+    }
+    uint32_t token = push_token(p, JSON_STRING, start);
+    if (token == JSON_NONE) {
+        return false;
+    }
+    p->tokens[token].length = p->pos++ - start;
+    return true;
+}
+
+static bool parse_value(json_parser *p, uint32_t depth);
+
+static bool parse_container(json_parser *p, uint32_t depth, bool object) {
+    if (depth >= JSON_MAX_DEPTH) {
+        return false;
+    }
+    uint32_t token = push_token(p, object ? JSON_OBJECT : JSON_ARRAY, p->pos++);
+    if (token == JSON_NONE) {
+        return false;
+    }
+
+    char close = object ? '}' : ']';
+    uint32_t count = 0;
+    skip_whitespace(p);
+    if (p->pos < p->size && p->text[p->pos] == close) {
+        p->pos++;
+    } else {
+        for (;;) {
+            if (object) {
+                skip_whitespace(p);
+                if (p->pos >= p->size || p->text[p->pos] != '"' || !parse_string(p)) {
+                    return false;
+                }
+                skip_whitespace(p);
+                if (p->pos >= p->size || p->text[p->pos++] != ':') {
+                    return false;
+                }
+            }
+            if (!parse_value(p, depth + 1)) {
+                return false;
+            }
+            count++;
+
+            skip_whitespace(p);
+            if (p->pos >= p->size) {
+                return false;
+            }
+            char c = p->text[p->pos++];
+            if (c == close) {
+                break;
+            }
+            if (c != ',') {
+                return false;
+            }
+        }
+    }
+
+    p->tokens[token].count = count;
+    p->tokens[token].end = p->count;
+    return true;
+}
+
+static bool parse_literal(json_parser *p, json_type type, const char *literal) {
+    uint32_t length = (uint32_t)strlen(literal);
+    if (p->size - p->pos < length || memcmp(p->text + p->pos, literal, length) != 0) {
+        return false;
+    }
+    uint32_t token = push_token(p, type, p->pos);
+    if (token == JSON_NONE) {
+        return false;
+    }
+    p->tokens[token].length = length;
+    p->pos += length;
+    return true;
+}
+
+static bool parse_value(json_parser *p, uint32_t depth) {
+    skip_whitespace(p);
+    if (p->pos >= p->size) {
+        return false;
+    }
+
+    char c = p->text[p->pos];
+    if (c == '{' || c == '[') {
+        return parse_container(p, depth, c == '{');
+    }
+    if (c == '"') {
+        return parse_string(p);
+    }
+    if (c == 't') {
+        return parse_literal(p, JSON_BOOL, "true");
+    }
+    if (c == 'f') {
+        return parse_literal(p, JSON_BOOL, "false");
+    }
+    if (c == 'n') {
+        return parse_literal(p, JSON_NULL, "null");
+    }
+
+    uint32_t start = p->pos;
+    while (p->pos < p->size && strchr("+-.eE0123456789", p->text[p->pos]) && p->text[p->pos] != '\0') {
+        p->pos++;
+    }
+    if (p->pos == start) {
+        return false;
+    }
+    uint32_t token = push_token(p, JSON_NUMBER, start);
+    if (token == JSON_NONE) {
+        return false;
+    }
+    p->tokens[token].length = p->pos - start;
+    return true;
+}
+
+/*
+ * Document
+ */
+
+typedef struct {
+    poc_file_map map;
+    const char *json;
+    const uint8_t *bin;
+    uint64_t bin_size;
+    json_token *tokens;
+
+    // Top-level arrays, resolved to token indices once
+    uint32_t *accessors, accessor_count;
+    uint32_t *views, view_count;
+    uint32_t *meshes, mesh_count;
+    uint32_t *materials, material_count;
+    uint32_t *nodes, node_count;
+} gltf_document;
+
+static const json_token *token_at(const gltf_document *doc, uint32_t token) {
+    return token != JSON_NONE ? &doc->tokens[token] : NULL;
+}
+
+static bool token_equals(const gltf_document *doc, uint32_t token, const char *text) {
+    const json_token *t = token_at(doc, token);
+    size_t length = strlen(text);
+    return t && t->type == JSON_STRING && t->length == length && memcmp(doc->json + t->start, text, length) == 0;
+}
+
+static uint32_t json_member(const gltf_document *doc, uint32_t object, const char *key) {
+    const json_token *t = token_at(doc, object);
+    if (!t || t->type != JSON_OBJECT) {
+        return JSON_NONE;
+    }
+    uint32_t member = object + 1;
+    for (uint32_t i = 0; i < t->count; i++) {
+        if (token_equals(doc, member, key)) {
+            return member + 1;
+        }
+        member = doc->tokens[member + 1].end;
+    }
+    return JSON_NONE;
+}
+
+static uint32_t json_element(const gltf_document *doc, uint32_t array, uint32_t index) {
+    const json_token *t = token_at(doc, array);
+    if (!t || t->type != JSON_ARRAY || index >= t->count) {
+        return JSON_NONE;
+    }
+    uint32_t element = array + 1;
+    for (uint32_t i = 0; i < index; i++) {
+        element = doc->tokens[element].end;
+    }
+    return element;
+}
+
+static double json_number(const gltf_document *doc, uint32_t token, double fallback) {
+    const json_token *t = token_at(doc, token);
+    if (!t || t->type != JSON_NUMBER || t->length >= 64) {
+        return fallback;
+    }
+    // The chunk is not NUL-terminated
+    char text[64];
+    memcpy(text, doc->json + t->start, t->length);
+    text[t->length] = '\0';
+    char *end;
+    double value = strtod(text, &end);
+    return end == text + t->length ? value : fallback;
+}
+
+// Non-negative integer member; anything else yields the fallback
+static uint64_t json_uint(const gltf_document *doc, uint32_t token, uint64_t fallback) {
+    double value = json_number(doc, token, -1.0);
+    if (value < 0.0 || value > 9007199254740992.0 || value != floor(value)) {
+        return fallback;
+    }
+    return (uint64_t)value;
+}
+
+static bool json_true(const gltf_document *doc, uint32_t token) {
+    const json_token *t = token_at(doc, token);
+    return t && t->type == JSON_BOOL && t->length == 4;
+}
+
+static uint32_t member_index(const gltf_document *doc, uint32_t object, const char *key) {
+    uint64_t value = json_uint(doc, json_member(doc, object, key), UINT32_MAX);
+    return value < UINT32_MAX ? (uint32_t)value : UINT32_MAX;
+}
+
+static void read_floats(const gltf_document *doc, uint32_t array, float *out, uint32_t count) {
+    const json_token *t = token_at(doc, array);
+    if (!t || t->type != JSON_ARRAY || t->count != count) {
+        return;
+    }
+    uint32_t element = array + 1;
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = (float)json_number(doc, element, out[i]);
+        element = doc->tokens[element].end;
+    }
+}
+
+// Decode a string with the common escapes; others are kept as '?'
+static void read_string(const gltf_document *doc, uint32_t token, char *out, size_t out_size) {
+    const json_token *t = token_at(doc, token);
+    size_t length = 0;
+    if (t && t->type == JSON_STRING) {
+        const char *s = doc->json + t->start;
+        for (uint32_t i = 0; i < t->length && length + 1 < out_size; i++) {
+            char c = s[i];
+            if (c == '\\' && i + 1 < t->length) {
+                c = s[++i];
+                if (c == 'n') c = '\n';
+                else if (c == 't') c = '\t';
+                else if (c == 'u') { c = '?'; i += 4; }
+                else if (c != '"' && c != '\\' && c != '/') c = '?';
+            }
+            out[length++] = c;
+        }
+    }
+    out[length] = '\0';
+}
+
+static bool index_array(const gltf_document *doc, const char *key, uint32_t **out, uint32_t *out_count) {
+    uint32_t array = json_member(doc, 0, key);
+    const json_token *t = token_at(doc, array);
+    *out = NULL;
+    *out_count = 0;
+    if (!t || t->type != JSON_ARRAY || t->count == 0) {
+        return true;
+    }
+
+    *out = malloc(t->count * sizeof(uint32_t));
+    if (!*out) {
+        return false;
+    }
+    uint32_t element = array + 1;
+    for (uint32_t i = 0; i < t->count; i++) {
+        (*out)[i] = element;
+        element = doc->tokens[element].end;
+    }
+    *out_count = t->count;
+    return true;
+}
+
+static uint32_t read_u32(const char *p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static void close_document(gltf_document *doc) {
+    free(doc->tokens);
+    free(doc->accessors);
+    free(doc->views);
+    free(doc->meshes);
+    free(doc->materials);
+    free(doc->nodes);
+    poc_file_map_close(&doc->map);
+    memset(doc, 0, sizeof(*doc));
+}
+
+static bool open_document(const char *path, gltf_document *doc) {
+    memset(doc, 0, sizeof(*doc));
+    if (!poc_file_map_open(path, &doc->map)) {
+        printf("⚠ Could not open %s\n", path);
+        return false;
+    }
+
+    const char *data = doc->map.data;
+    uint64_t size = doc->map.size;
+    if (size < 20 || read_u32(data) != GLB_MAGIC || read_u32(data + 4) != GLB_VERSION ||
+        read_u32(data + 8) > size || read_u32(data + 16) != GLB_CHUNK_JSON) {
+        printf("⚠ %s is not a binary glTF 2.0 file\n", path);
+        close_document(doc);
+        return false;
+    }
+    size = read_u32(data + 8);
+
+    uint64_t json_size = read_u32(data + 12);
+    if (20 + json_size > size || json_size > UINT32_MAX / 2) {
+        printf("⚠ %s has a truncated JSON chunk\n", path);
+        close_document(doc);
+        return false;
+    }
+    doc->json = data + 20;
+
+    // The binary chunk is optional and follows the 4-byte aligned JSON chunk
+    uint64_t bin_header = 20 + ((json_size + 3) & ~(uint64_t)3);
+    if (bin_header + 8 <= size && read_u32(data + bin_header + 4) == GLB_CHUNK_BIN) {
+        uint64_t bin_size = read_u32(data + bin_header);
+        if (bin_header + 8 + bin_size <= size) {
+            doc->bin = (const uint8_t *)data + bin_header + 8;
+            doc->bin_size = bin_size;
+        }
+    }
+
+    json_parser parser = {doc->json, (uint32_t)json_size, 0, NULL, 0, 0};
+    bool parsed = parse_value(&parser, 0) && parser.tokens[0].type == JSON_OBJECT;
+    doc->tokens = parser.tokens;
+    if (!parsed) {
+        printf("⚠ %s has malformed JSON near byte %u\n", path, parser.pos);
+        close_document(doc);
+        return false;
+    }
+
+    if (!index_array(doc, "accessors", &doc->accessors, &doc->accessor_count) ||
+        !index_array(doc, "bufferViews", &doc->views, &doc->view_count) ||
+        !index_array(doc, "meshes", &doc->meshes, &doc->mesh_count) ||
+        !index_array(doc, "materials", &doc->materials, &doc->material_count) ||
+        !index_array(doc, "nodes", &doc->nodes, &doc->node_count)) {
+        close_document(doc);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Accessors
+ */
+
+typedef struct {
+    const uint8_t *data;        /**< First element */
+    uint32_t count;             /**< Number of elements */
+    uint32_t component_type;    /**< GLTF_FLOAT, GLTF_UNSIGNED_SHORT, ... */
+    uint32_t components;        /**< 1 for SCALAR up to 4 for VEC4 */
+    uint32_t stride;            /**< Bytes from one element to the next */
+    bool normalized;            /**< Integer components map to [0, 1] or [-1, 1] */
+    bool has_bounds;            /**< min and max were given */
+    float min[3];               /**< Per-component minimum (first three components) */
+    float max[3];               /**< Per-component maximum */
+} gltf_accessor;
+
+static uint32_t component_size(uint32_t component_type) {
+    switch (component_type) {
+        case GLTF_BYTE:
+        case GLTF_UNSIGNED_BYTE: return 1;
+        case GLTF_SHORT:
+        case GLTF_UNSIGNED_SHORT: return 2;
+        case GLTF_UNSIGNED_INT:
+        case GLTF_FLOAT: return 4;
+        default: return 0;
+    }
+}
+
+static uint32_t type_components(const gltf_document *doc, uint32_t type) {
+    if (token_equals(doc, type, "SCALAR")) return 1;
+    if (token_equals(doc, type, "VEC2")) return 2;
+    if (token_equals(doc, type, "VEC3")) return 3;
+    if (token_equals(doc, type, "VEC4")) return 4;
+    return 0;
+}
+
+static bool resolve_accessor(const gltf_document *doc, uint32_t index, gltf_accessor *out) {
+    memset(out, 0, sizeof(*out));
+    if (index >= doc->accessor_count) {
+        return false;
+    }
+    uint32_t accessor = doc->accessors[index];
+    uint32_t view_index = member_index(doc, accessor, "bufferView");
+    if (view_index >= doc->view_count || json_member(doc, accessor, "sparse") != JSON_NONE) {
+        return false;
+    }
+    uint32_t view = doc->views[view_index];
+    if (json_uint(doc, json_member(doc, view, "buffer"), UINT32_MAX) != 0 || !doc->bin) {
+        return false;
+    }
+
+    out->component_type = (uint32_t)json_uint(doc, json_member(doc, accessor, "componentType"), 0);
+    out->components = type_components(doc, json_member(doc, accessor, "type"));
+    uint64_t count = json_uint(doc, json_member(doc, accessor, "count"), 0);
+    uint32_t element_size = component_size(out->component_type) * out->components;
+    if (element_size == 0 || count == 0 || count > UINT32_MAX) {
+        return false;
+    }
+
+    uint64_t view_offset = json_uint(doc, json_member(doc, view, "byteOffset"), 0);
+    uint64_t view_length = json_uint(doc, json_member(doc, view, "byteLength"), UINT64_MAX);
+    uint64_t stride = json_uint(doc, json_member(doc, view, "byteStride"), element_size);
+    uint64_t offset = json_uint(doc, json_member(doc, accessor, "byteOffset"), 0);
+    if (view_length > doc->bin_size || view_offset > doc->bin_size - view_length ||
+        stride < element_size || stride > 252 ||
+        offset + stride * (count - 1) + element_size > view_length) {
+        return false;
+    }
+
+    out->data = doc->bin + view_offset + offset;
+    out->count = (uint32_t)count;
+    out->stride = (uint32_t)stride;
+    out->normalized = json_true(doc, json_member(doc, accessor, "normalized"));
+
+    uint32_t min = json_member(doc, accessor, "min");
+    uint32_t max = json_member(doc, accessor, "max");
+    if (out->components == 3 && token_at(doc, min) && token_at(doc, max) &&
+        doc->tokens[min].count == 3 && doc->tokens[max].count == 3) {
+        read_floats(doc, min, out->min, 3);
+        read_floats(doc, max, out->max, 3);
+        out->has_bounds = true;
+    }
+    return true;
+}
+
+// Read up to count components of one element as floats, zero-filling the rest
+static void read_element(const gltf_accessor *a, uint32_t index, float *out, uint32_t count) {
+    const uint8_t *p = a->data + (size_t)index * a->stride;
+    for (uint32_t c = 0; c < count; c++) {
+        float value = 0.0f;
+        if (c < a->components) {
+            switch (a->component_type) {
+                case GLTF_FLOAT: memcpy(&value, p + c * 4, 4); break;
+                case GLTF_BYTE: {
+                    int8_t v = (int8_t)p[c];
+                    value = a->normalized ? fmaxf((float)v / 127.0f, -1.0f) : (float)v;
+                    break;
+                }
+                case GLTF_UNSIGNED_BYTE:
+                    value = a->normalized ? (float)p[c] / 255.0f : (float)p[c];
+                    break;
+                case GLTF_SHORT: {
+                    int16_t v;
+                    memcpy(&v, p + c * 2, 2);
+                    value = a->normalized ? fmaxf((float)v / 32767.0f, -1.0f) : (float)v;
+                    break;
+                }
+                case GLTF_UNSIGNED_SHORT: {
+                    uint16_t v;
+                    memcpy(&v, p + c * 2, 2);
+                    value = a->normalized ? (float)v / 65535.0f : (float)v;
+                    break;
+                }
+                case GLTF_UNSIGNED_INT: {
+                    uint32_t v;
+                    memcpy(&v, p + c * 4, 4);
+                    value = (float)v;
+                    break;
+                }
+            }
+        }
+        out[c] = value;
+    }
+}
+
+static uint32_t read_index(const gltf_accessor *a, uint32_t index) {
+    const uint8_t *p = a->data + (size_t)index * a->stride;
+    if (a->component_type == GLTF_UNSIGNED_BYTE) {
+        return p[0];
+    }
+    if (a->component_type == GLTF_UNSIGNED_SHORT) {
+        uint16_t v;
+        memcpy(&v, p, 2);
+        return v;
+    }
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+/*
+ * Meshes
+ */
+
+typedef struct {
+    uint32_t position, normal, texcoord, indices; /**< Accessor indices, UINT32_MAX if absent */
+    gltf_accessor position_data, normal_data, texcoord_data, index_data;
+    uint32_t material;          /**< glTF material index, or UINT32_MAX */
+    uint32_t order;             /**< Position in the glTF primitive list */
+    uint32_t index_count;       /**< Indices used, a multiple of three */
+    uint32_t vertex_base;       /**< First vertex in the converted array */
+} gltf_primitive;
+
+static bool split_path(const char *path, char *file, size_t file_size, uint32_t *mesh_index) {
+    const char *separator = strrchr(path, POC_GLTF_MESH_SEPARATOR);
+    size_t length = separator ? (size_t)(separator - path) : strlen(path);
+    if (length + 1 > file_size) {
+        return false;
+    }
+    memcpy(file, path, length);
+    file[length] = '\0';
+
+    *mesh_index = 0;
+    if (separator) {
+        char *end;
+        unsigned long value = strtoul(separator + 1, &end, 10);
+        if (end == separator + 1 || *end != '\0' || value >= UINT32_MAX) {
+            return false;
+        }
+        *mesh_index = (uint32_t)value;
+    }
+    return true;
+}
+
+bool poc_gltf_is_path(const char *path) {
+    if (!path) {
+        return false;
+    }
+    const char *separator = strrchr(path, POC_GLTF_MESH_SEPARATOR);
+    size_t length = separator ? (size_t)(separator - path) : strlen(path);
+    return length >= 4 && strncasecmp(path + length - 4, ".glb", 4) == 0;
+}
+
+static bool read_primitives(const gltf_document *doc, uint32_t mesh,
+                            gltf_primitive **out, uint32_t *out_count) {
+    uint32_t list = json_member(doc, mesh, "primitives");
+    const json_token *t = token_at(doc, list);
+    *out = NULL;
+    *out_count = 0;
+    if (!t || t->type != JSON_ARRAY || t->count == 0) {
+        return false;
+    }
+
+    gltf_primitive *primitives = calloc(t->count, sizeof(gltf_primitive));
+    if (!primitives) {
+        return false;
+    }
+
+    uint32_t count = 0;
+    uint32_t element = list + 1;
+    for (uint32_t i = 0; i < t->count; i++, element = doc->tokens[element].end) {
+        if (json_uint(doc, json_member(doc, element, "mode"), GLTF_MODE_TRIANGLES) != GLTF_MODE_TRIANGLES) {
+            printf("⚠ Skipping a primitive that is not a triangle list\n");
+            continue;
+        }
+
+        gltf_primitive *primitive = &primitives[count];
+        primitive->order = i;
+        uint32_t attributes = json_member(doc, element, "attributes");
+        primitive->position = member_index(doc, attributes, "POSITION");
+        primitive->normal = member_index(doc, attributes, "NORMAL");
+        primitive->texcoord = member_index(doc, attributes, "TEXCOORD_0");
+        primitive->indices = member_index(doc, element, "indices");
+        primitive->material = member_index(doc, element, "material");
+        if (primitive->material >= doc->material_count) {
+            primitive->material = UINT32_MAX;
+        }
+
+        gltf_accessor *position = &primitive->position_data;
+        if (!resolve_accessor(doc, primitive->position, position) || position->components != 3) {
+            printf("⚠ Skipping a primitive without readable positions\n");
+            continue;
+        }
+        if (primitive->normal != UINT32_MAX &&
+            (!resolve_accessor(doc, primitive->normal, &primitive->normal_data) ||
+             primitive->normal_data.components != 3 || primitive->normal_data.count != position->count)) {
+            primitive->normal = UINT32_MAX;
+        }
+        if (primitive->texcoord != UINT32_MAX &&
+            (!resolve_accessor(doc, primitive->texcoord, &primitive->texcoord_data) ||
+             primitive->texcoord_data.components != 2 || primitive->texcoord_data.count != position->count)) {
+            primitive->texcoord = UINT32_MAX;
+        }
+
+        uint64_t index_count = position->count;
+        if (primitive->indices != UINT32_MAX) {
+            gltf_accessor *indices = &primitive->index_data;
+            if (!resolve_accessor(doc, primitive->indices, indices) || indices->components != 1 ||
+                indices->component_type == GLTF_BYTE || indices->component_type == GLTF_SHORT ||
+                indices->component_type == GLTF_FLOAT) {
+                printf("⚠ Skipping a primitive with unreadable indices\n");
+                continue;
+            }
+            index_count = indices->count;
+        }
+        primitive->index_count = (uint32_t)(index_count - index_count % 3);
+        if (primitive->index_count > 0) {
+            count++;
+        }
+    }
+
+    if (count == 0) {
+        free(primitives);
+        return false;
+    }
+    *out = primitives;
+    *out_count = count;
+    return true;
+}
+
+// Whether every primitive reads one shared poc_vertex-shaped accessor set and
+// its 32-bit indices follow the previous primitive's
+static bool is_zero_copy(const gltf_primitive *primitives, uint32_t count) {
+    const gltf_primitive *first = &primitives[0];
+    const gltf_accessor *position = &first->position_data;
+    const gltf_accessor *normal = &first->normal_data;
+    const gltf_accessor *texcoord = &first->texcoord_data;
+    if (first->normal == UINT32_MAX || first->texcoord == UINT32_MAX ||
+        position->component_type != GLTF_FLOAT || normal->component_type != GLTF_FLOAT ||
+        texcoord->component_type != GLTF_FLOAT ||
+        position->stride != sizeof(poc_vertex) || normal->stride != sizeof(poc_vertex) ||
+        texcoord->stride != sizeof(poc_vertex) ||
+        normal->data != position->data + offsetof(poc_vertex, normal) ||
+        texcoord->data != position->data + offsetof(poc_vertex, texcoord) ||
+        (uintptr_t)position->data % _Alignof(poc_vertex) != 0) {
+        return false;
+    }
+
+    const uint8_t *next_index = first->index_data.data;
+    for (uint32_t i = 0; i < count; i++) {
+        const gltf_primitive *primitive = &primitives[i];
+        const gltf_accessor *indices = &primitive->index_data;
+        if (primitive->position != first->position || primitive->normal != first->normal ||
+            primitive->texcoord != first->texcoord || primitive->indices == UINT32_MAX ||
+            indices->component_type != GLTF_UNSIGNED_INT || indices->stride != sizeof(uint32_t) ||
+            indices->data != next_index || (uintptr_t)indices->data % sizeof(uint32_t) != 0 ||
+            indices->count != primitive->index_count) {
+            return false;
+        }
+        next_index += (size_t)indices->count * sizeof(uint32_t);
+    }
+    return true;
+}
+
+static void read_material(const gltf_document *doc, uint32_t index, poc_material *out) {
+    uint32_t material = doc->materials[index];
+    uint32_t pbr = json_member(doc, material, "pbrMetallicRoughness");
+    float base[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    read_floats(doc, json_member(doc, pbr, "baseColorFactor"), base, 4);
+    float metallic = (float)json_number(doc, json_member(doc, pbr, "metallicFactor"), 1.0);
+    float roughness = (float)json_number(doc, json_member(doc, pbr, "roughnessFactor"), 1.0);
+    metallic = fminf(fmaxf(metallic, 0.0f), 1.0f);
+    roughness = fminf(fmaxf(roughness, 0.05f), 1.0f);
+
+    // Approximate metallic-roughness with the Phong terms the shader uses;
+    // metals tint their highlight instead of losing their diffuse colour
+    memset(out, 0, sizeof(*out));
+    for (int c = 0; c < 3; c++) {
+        out->diffuse[c] = base[c];
+        out->ambient[c] = base[c] * 0.2f;
+        out->specular[c] = 0.04f + (base[c] - 0.04f) * metallic;
+    }
+    float r4 = roughness * roughness * roughness * roughness;
+    out->shininess = fminf(fmaxf(2.0f / r4 - 2.0f, 1.0f), 1024.0f);
+    out->opacity = token_equals(doc, json_member(doc, material, "alphaMode"), "OPAQUE") ||
+                   json_member(doc, material, "alphaMode") == JSON_NONE ? 1.0f : base[3];
+    out->illum_model = 2;
+
+    char name[256];
+    read_string(doc, json_member(doc, material, "name"), name, sizeof(name));
+    if (!name[0]) {
+        snprintf(name, sizeof(name), "material_%u", index);
+    }
+    out->name = poc_string_intern(name);
+}
+
+// Order primitives by material so each material's triangles end up
+// contiguous; primitives without one sort last, ties keep file order
+static int compare_primitive_material(const void *a, const void *b) {
+    const gltf_primitive *pa = a;
+    const gltf_primitive *pb = b;
+    if (pa->material != pb->material) {
+        return pa->material < pb->material ? -1 : 1;
+    }
+    return pa->order < pb->order ? -1 : (pa->order > pb->order ? 1 : 0);
+}
+
+// Build submeshes and the mesh's material table in primitive order,
+// merging neighbours with the same material
+static bool build_submeshes(const gltf_document *doc, poc_mesh *mesh,
+                            const gltf_primitive *primitives, uint32_t count) {
+    poc_submesh *submeshes = malloc(count * sizeof(poc_submesh));
+    poc_material *materials = malloc(count * sizeof(poc_material));
+    uint32_t *used = malloc(count * sizeof(uint32_t));
+    if (!submeshes || !materials || !used) {
+        free(submeshes);
+        free(materials);
+        free(used);
+        return false;
+    }
+
+    uint32_t submesh_count = 0;
+    uint32_t material_count = 0;
+    uint32_t index_base = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const gltf_primitive *primitive = &primitives[i];
+        if (i == 0 || primitive->material != primitives[i - 1].material) {
+            uint32_t material_index = UINT32_MAX;
+            if (primitive->material != UINT32_MAX) {
+                for (material_index = 0; material_index < material_count; material_index++) {
+                    if (used[material_index] == primitive->material) {
+                        break;
+                    }
+                }
+                if (material_index == material_count) {
+                    used[material_count] = primitive->material;
+                    read_material(doc, primitive->material, &materials[material_count++]);
+                }
+            }
+            submeshes[submesh_count++] = (poc_submesh){index_base, 0, material_index};
+        }
+        submeshes[submesh_count - 1].index_count += primitive->index_count;
+        index_base += primitive->index_count;
+    }
+    free(used);
+
+    mesh->submeshes = submeshes;
+    mesh->submesh_count = submesh_count;
+    mesh->materials = materials;
+    mesh->material_count = material_count;
+    if (submeshes[0].material_index != UINT32_MAX) {
+        mesh->material = materials[submeshes[0].material_index];
+        mesh->has_material = true;
+    }
+    return true;
+}
+
+static bool indices_in_range(const uint32_t *indices, uint32_t count, uint32_t vertex_count) {
+    uint32_t largest = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        largest = indices[i] > largest ? indices[i] : largest;
+    }
+    return count == 0 || largest < vertex_count;
+}
+
+// Point the mesh into the mapping; bounds come from the POSITION min/max,
+// so no vertex page is read here
+static bool map_primitives(poc_mesh *mesh, const gltf_primitive *primitives, uint32_t count) {
+    const gltf_accessor *position = &primitives[0].position_data;
+    uint64_t index_count = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        index_count += primitives[i].index_count;
+    }
+    if (index_count > UINT32_MAX ||
+        !indices_in_range((const uint32_t *)primitives[0].index_data.data, (uint32_t)index_count, position->count)) {
+        return false;
+    }
+
+    mesh->vertices = (poc_vertex *)position->data;
+    mesh->vertex_count = position->count;
+    mesh->indices = (uint32_t *)primitives[0].index_data.data;
+    mesh->index_count = (uint32_t)index_count;
+    mesh->owns_data = false;
+
+    if (position->has_bounds) {
+        glm_vec3_copy((float *)position->min, mesh->local_aabb_min);
+        glm_vec3_copy((float *)position->max, mesh->local_aabb_max);
+        glm_vec3_center(mesh->local_aabb_min, mesh->local_aabb_max, mesh->center);
+        mesh->bounding_radius = 0.5f * glm_vec3_distance(mesh->local_aabb_min, mesh->local_aabb_max);
+    } else {
+        poc_mesh_calculate_bounds(mesh);
+    }
+    return true;
+}
+
+// Move mapped geometry onto the heap. Loose files are watched for hot reload
+// and exporters rewrite them in place, which a private mapping does not
+// isolate us from: pages not yet faulted in would read the new contents, and
+// a shorter file raises SIGBUS. Archives are snapshots, so only they stay mapped.
+static bool copy_mapped_geometry(poc_mesh *mesh) {
+    poc_vertex *vertices = malloc((size_t)mesh->vertex_count * sizeof(poc_vertex));
+    uint32_t *indices = malloc((size_t)mesh->index_count * sizeof(uint32_t));
+    if (!vertices || !indices) {
+        free(vertices);
+        free(indices);
+        return false;
+    }
+    memcpy(vertices, mesh->vertices, (size_t)mesh->vertex_count * sizeof(poc_vertex));
+    memcpy(indices, mesh->indices, (size_t)mesh->index_count * sizeof(uint32_t));
+    mesh->vertices = vertices;
+    mesh->indices = indices;
+    mesh->owns_data = true;
+    return true;
+}
+
+// Area-weighted face normals for vertices whose primitive had none
+static void generate_normals(poc_vertex *vertices, const uint32_t *indices, uint32_t index_count) {
+    for (uint32_t i = 0; i + 2 < index_count; i += 3) {
+        poc_vertex *a = &vertices[indices[i]];
+        poc_vertex *b = &vertices[indices[i + 1]];
+        poc_vertex *c = &vertices[indices[i + 2]];
+        vec3 ab, ac, face;
+        glm_vec3_sub(b->position, a->position, ab);
+        glm_vec3_sub(c->position, a->position, ac);
+        glm_vec3_cross(ab, ac, face);
+        glm_vec3_add(a->normal, face, a->normal);
+        glm_vec3_add(b->normal, face, b->normal);
+        glm_vec3_add(c->normal, face, c->normal);
+    }
+}
+
+// Copy every primitive into one interleaved heap array, primitives that
+// share attribute accessors sharing their vertices
+static bool convert_primitives(poc_mesh *mesh, gltf_primitive *primitives, uint32_t count) {
+    uint64_t vertex_total = 0;
+    uint64_t index_total = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        gltf_primitive *primitive = &primitives[i];
+        primitive->vertex_base = UINT32_MAX;
+        for (uint32_t j = 0; j < i; j++) {
+            if (primitives[j].position == primitive->position && primitives[j].normal == primitive->normal &&
+                primitives[j].texcoord == primitive->texcoord) {
+                primitive->vertex_base = primitives[j].vertex_base;
+                break;
+            }
+        }
+        if (primitive->vertex_base == UINT32_MAX) {
+            primitive->vertex_base = (uint32_t)(vertex_total < UINT32_MAX ? vertex_total : 0);
+            vertex_total += primitive->position_data.count;
+        }
+        index_total += primitive->index_count;
+    }
+    if (vertex_total > UINT32_MAX || index_total > UINT32_MAX) {
+        printf("⚠ GLB mesh has too many vertices for one mesh\n");
+        return false;
+    }
+
+    poc_vertex *vertices = calloc(vertex_total, sizeof(poc_vertex));
+    uint32_t *indices = malloc(index_total * sizeof(uint32_t));
+    if (!vertices || !indices) {
+        free(vertices);
+        free(indices);
+        return false;
+    }
+
+    uint32_t index_base = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const gltf_primitive *primitive = &primitives[i];
+        const uint32_t vertex_count = primitive->position_data.count;
+        poc_vertex *base = &vertices[primitive->vertex_base];
+        bool first_use = true;
+        for (uint32_t j = 0; j < i; j++) {
+            first_use = first_use && primitives[j].vertex_base != primitive->vertex_base;
+        }
+        if (first_use) {
+            for (uint32_t v = 0; v < vertex_count; v++) {
+                read_element(&primitive->position_data, v, base[v].position, 3);
+                if (primitive->normal != UINT32_MAX) {
+                    read_element(&primitive->normal_data, v, base[v].normal, 3);
+                }
+                if (primitive->texcoord != UINT32_MAX) {
+                    read_element(&primitive->texcoord_data, v, base[v].texcoord, 2);
+                }
+            }
+        }
+
+        uint32_t *out = &indices[index_base];
+        for (uint32_t j = 0; j < primitive->index_count; j++) {
+            uint32_t index = primitive->indices != UINT32_MAX ? read_index(&primitive->index_data, j) : j;
+            if (index >= vertex_count) {
+                printf("⚠ GLB primitive references vertex %u of %u\n", index, vertex_count);
+                free(vertices);
+                free(indices);
+                return false;
+            }
+            out[j] = primitive->vertex_base + index;
+        }
+        if (primitive->normal == UINT32_MAX) {
+            generate_normals(vertices, out, primitive->index_count);
+        }
+        index_base += primitive->index_count;
+    }
+
+    // Normalize generated normals; vertices no triangle touched point up
+    for (uint32_t i = 0; i < count; i++) {
+        if (primitives[i].normal != UINT32_MAX) {
+            continue;
+        }
+        poc_vertex *base = &vertices[primitives[i].vertex_base];
+        for (uint32_t v = 0; v < primitives[i].position_data.count; v++) {
+            if (glm_vec3_norm2(base[v].normal) > 0.0f) {
+                glm_vec3_normalize(base[v].normal);
+            } else {
+                glm_vec3_copy((vec3){0.0f, 1.0f, 0.0f}, base[v].normal);
+            }
+        }
+    }
+
+    poc_mesh_set_data(mesh, vertices, (uint32_t)vertex_total, indices, (uint32_t)index_total, true);
+    return true;
+}
+
+poc_mesh* poc_gltf_load_mesh(const char *path) {
+    char file[POC_ASSET_PATH_MAX];
+    uint32_t mesh_index;
+    if (!path || !split_path(path, file, sizeof(file), &mesh_index)) {
+        return NULL;
+    }
+
+    gltf_document doc;
+    if (!open_document(file, &doc)) {
+        return NULL;
+    }
+    if (mesh_index >= doc.mesh_count) {
+        printf("⚠ %s has no mesh %u\n", file, mesh_index);
+        close_document(&doc);
+        return NULL;
+    }
+
+    gltf_primitive *primitives;
+    uint32_t primitive_count;
+    poc_mesh *mesh = poc_mesh_create();
+    if (!mesh || !read_primitives(&doc, doc.meshes[mesh_index], &primitives, &primitive_count)) {
+        printf("⚠ Mesh %u of %s has no triangles to import\n", mesh_index, file);
+        poc_mesh_destroy(mesh);
+        close_document(&doc);
+        return NULL;
+    }
+
+    bool zero_copy = is_zero_copy(primitives, primitive_count);
+    if (!zero_copy) {
+        qsort(primitives, primitive_count, sizeof(gltf_primitive), compare_primitive_material);
+    }
+    bool loaded = (zero_copy ? map_primitives(mesh, primitives, primitive_count) &&
+                               (doc.map.archived || copy_mapped_geometry(mesh))
+                             : convert_primitives(mesh, primitives, primitive_count)) &&
+                  build_submeshes(&doc, mesh, primitives, primitive_count);
+    free(primitives);
+    if (!loaded) {
+        printf("⚠ Could not import mesh %u of %s\n", mesh_index, file);
+        poc_mesh_destroy(mesh);
+        close_document(&doc);
+        return NULL;
+    }
+
+    mesh->source_path = poc_string_intern(path);
+    if (strcmp(file, path) != 0) {
+        // Watch the file itself, not the "#N" path
+        mesh->dependencies = malloc(sizeof(poc_string_id));
+        if (mesh->dependencies) {
+            mesh->dependencies[0] = poc_string_intern(file);
+            mesh->dependency_count = 1;
+        }
+    }
+
+    bool mapped = zero_copy && doc.map.archived;
+    if (mapped) {
+        // The mesh keeps the mapping its data points into
+        mesh->mapping = doc.map;
+        doc.map = (poc_file_map){0};
+    }
+    close_document(&doc);
+
+    printf("✓ Loaded GLB mesh %s (%u vertices, %u indices, %u submeshes, %s)\n",
+           path, mesh->vertex_count, mesh->index_count, poc_mesh_get_submesh_count(mesh),
+           mapped ? "zero-copy" : zero_copy ? "copied" : "converted");
+    return mesh;
+}
+
+bool poc_gltf_map_geometry(poc_mesh *mesh) {
+    if (!mesh) {
+        return false;
+    }
+
+    poc_mesh *fresh = poc_gltf_load_mesh(poc_mesh_get_source_path(mesh));
+    bool mapped = fresh && fresh->mapping.data &&
+                  fresh->vertex_count == mesh->vertex_count && fresh->index_count == mesh->index_count;
+    if (mapped) {
+        if (mesh->owns_data) {
+            free(mesh->vertices);
+            free(mesh->indices);
+        }
+        poc_file_map_close(&mesh->mapping);
+
+        mesh->vertices = fresh->vertices;
+        mesh->indices = fresh->indices;
+        mesh->owns_data = false;
+        mesh->geometry_released = false;
+        mesh->mapping = fresh->mapping;
+        fresh->mapping = (poc_file_map){0};
+    }
+    poc_mesh_destroy(fresh);
+    return mapped;
+}
+
+/*
+ * Nodes
+ */
+
+// Euler angles (degrees) of a rotation matrix for the T * Ry * Rx * Rz * S
+// order poc_scene_object uses. cglm matrices are column major: m[col][row].
+static void rotation_to_euler(mat4 m, vec3 out) {
+    float sx = -m[2][1];
+    if (fabsf(sx) < 0.99999f) {
+        out[0] = asinf(sx);
+        out[1] = atan2f(m[2][0], m[2][2]);
+        out[2] = atan2f(m[0][1], m[1][1]);
+    } else {
+        // Gimbal lock: only y + z or y - z is defined, so keep z at zero
+        out[0] = sx > 0.0f ? GLM_PI_2f : -GLM_PI_2f;
+        out[1] = atan2f(-m[0][2], m[0][0]);
+        out[2] = 0.0f;
+    }
+    glm_vec3_scale(out, 180.0f / GLM_PIf, out);
+}
+
+static void read_transform(const gltf_document *doc, uint32_t node, poc_gltf_node *out) {
+    glm_vec3_zero(out->position);
+    glm_vec3_zero(out->rotation);
+    glm_vec3_one(out->scale);
+
+    mat4 rotation;
+    uint32_t matrix = json_member(doc, node, "matrix");
+    if (token_at(doc, matrix) && doc->tokens[matrix].count == 16) {
+        mat4 m;
+        read_floats(doc, matrix, (float *)m, 16);
+        vec4 translation;
+        glm_decompose(m, translation, rotation, out->scale);
+        glm_vec3_copy(translation, out->position);
+    } else {
+        versor q = {0.0f, 0.0f, 0.0f, 1.0f};
+        read_floats(doc, json_member(doc, node, "translation"), out->position, 3);
+        read_floats(doc, json_member(doc, node, "rotation"), q, 4);
+        read_floats(doc, json_member(doc, node, "scale"), out->scale, 3);
+        glm_quat_normalize(q);
+        glm_quat_mat4(q, rotation);
+    }
+    rotation_to_euler(rotation, out->rotation);
+}
+
+// Node states besides the output position of placed nodes
+#define NODE_UNSEEN UINT32_MAX
+#define NODE_QUEUED (UINT32_MAX - 1)
+
+// Queue the unseen nodes an index array lists so they pop in list order;
+// returns the new stack depth
+static uint32_t push_nodes(const gltf_document *doc, uint32_t array, uint32_t parent,
+                           uint32_t *stack, uint32_t depth, uint32_t *parents, uint32_t *placed) {
+    const json_token *t = token_at(doc, array);
+    if (!t || t->type != JSON_ARRAY) {
+        return depth;
+    }
+
+    uint32_t first = depth;
+    uint32_t element = array + 1;
+    for (uint32_t i = 0; i < t->count; i++, element = doc->tokens[element].end) {
+        uint64_t index = json_uint(doc, element, UINT32_MAX);
+        if (index < doc->node_count && placed[index] == NODE_UNSEEN) {
+            placed[index] = NODE_QUEUED;
+            parents[index] = parent;
+            stack[depth++] = (uint32_t)index;
+        }
+    }
+    for (uint32_t a = first, b = depth; a + 1 < b; a++, b--) {
+        uint32_t swapped = stack[a];
+        stack[a] = stack[b - 1];
+        stack[b - 1] = swapped;
+    }
+    return depth;
+}
+
+bool poc_gltf_load_nodes(const char *path, poc_gltf_node **out_nodes, uint32_t *out_count) {
+    if (!path || !out_nodes || !out_count) {
+        return false;
+    }
+    *out_nodes = NULL;
+    *out_count = 0;
+
+    gltf_document doc;
+    if (!open_document(path, &doc)) {
+        return false;
+    }
+    if (doc.node_count == 0) {
+        printf("⚠ %s has no nodes\n", path);
+        close_document(&doc);
+        return false;
+    }
+
+    // Depth-first from the default scene's roots; a node listed twice (a
+    // malformed file) keeps its first place, so the stack never overflows
+    uint32_t *stack = malloc(doc.node_count * sizeof(uint32_t));
+    uint32_t *parents = malloc(doc.node_count * sizeof(uint32_t));
+    uint32_t *placed = malloc(doc.node_count * sizeof(uint32_t));
+    poc_gltf_node *nodes = calloc(doc.node_count, sizeof(poc_gltf_node));
+    if (!stack || !parents || !placed || !nodes) {
+        free(stack);
+        free(parents);
+        free(placed);
+        free(nodes);
+        close_document(&doc);
+        return false;
+    }
+    for (uint32_t i = 0; i < doc.node_count; i++) {
+        placed[i] = NODE_UNSEEN;
+    }
+
+    uint32_t scene_index = member_index(&doc, 0, "scene");
+    uint32_t scene = json_element(&doc, json_member(&doc, 0, "scenes"), scene_index != UINT32_MAX ? scene_index : 0);
+    uint32_t depth = push_nodes(&doc, json_member(&doc, scene, "nodes"), POC_GLTF_NO_PARENT,
+                                stack, 0, parents, placed);
+    if (depth == 0) {
+        // No scene: every node nobody lists as a child is a root
+        bool *is_child = calloc(doc.node_count, sizeof(bool));
+        for (uint32_t n = 0; is_child && n < doc.node_count; n++) {
+            uint32_t children = json_member(&doc, doc.nodes[n], "children");
+            const json_token *t = token_at(&doc, children);
+            uint32_t element = children + 1;
+            for (uint32_t c = 0; t && t->type == JSON_ARRAY && c < t->count; c++, element = doc.tokens[element].end) {
+                uint64_t child = json_uint(&doc, element, UINT32_MAX);
+                if (child < doc.node_count) {
+                    is_child[child] = true;
+                }
+            }
+        }
+        for (uint32_t n = doc.node_count; is_child && n-- > 0;) {
+            if (!is_child[n]) {
+                placed[n] = NODE_QUEUED;
+                parents[n] = POC_GLTF_NO_PARENT;
+                stack[depth++] = n;
+            }
+        }
+        free(is_child);
+    }
+
+    uint32_t count = 0;
+    while (depth > 0) {
+        uint32_t index = stack[--depth];
+        placed[index] = count;
+
+        uint32_t node = doc.nodes[index];
+        poc_gltf_node *out = &nodes[count++];
+        out->parent = parents[index];
+        read_transform(&doc, node, out);
+        out->mesh = member_index(&doc, node, "mesh");
+        if (out->mesh >= doc.mesh_count) {
+            out->mesh = UINT32_MAX;
+        }
+
+        char name[256];
+        read_string(&doc, json_member(&doc, node, "name"), name, sizeof(name));
+        if (!name[0]) {
+            snprintf(name, sizeof(name), "node_%u", index);
+        }
+        out->name = poc_string_intern(name);
+
+        depth = push_nodes(&doc, json_member(&doc, node, "children"), placed[index],
+                           stack, depth, parents, placed);
+    }
+
+    free(stack);
+    free(parents);
+    free(placed);
+    close_document(&doc);
+
+    if (count == 0) {
+        free(nodes);
+        return false;
+    }
+    *out_nodes = nodes;
+    *out_count = count;
+    return true;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file gltf_loader.h
+ * @brief Binary glTF 2.0 (.glb) import
+ *
+ * A GLB file is a JSON chunk describing meshes, materials and nodes,
+ * followed by one binary chunk holding the vertex and index data. The file
+ * is mapped and only the JSON chunk is parsed; the binary chunk is read in
+ * place.
+ *
+ * Each glTF mesh becomes one poc_mesh, addressed as "file.glb#N" for mesh
+ * N ("file.glb" alone is mesh 0), so the asset manager, scene files and
+ * hot reload handle GLB meshes like any other mesh path. Its primitives
+ * become submeshes and their glTF materials the mesh's materials.
+ *
+ * When a mesh's primitives share one interleaved vertex accessor set laid
+ * out exactly like poc_vertex (float position, normal and TEXCOORD_0 at a
+ * 32-byte stride) and their 32-bit indices are stored back to back, a
+ * mesh served from the mounted asset archive points straight into the
+ * mapping (owns_data is false), like a cooked mesh: nothing is copied and
+ * pages fault in when the renderer reads them. The same layout in a loose
+ * file is copied out in one block, since exporters rewrite loose files in
+ * place while hot reload watches them. Any other layout (separate attribute views, 8/16-bit indices, quantized
+ * or missing attributes) is converted into heap arrays and goes through the
+ * same optimization as an OBJ import.
+ *
+ * The node hierarchy is loaded as a prefab: poc_prefab_load() accepts a GLB
+ * file and poc_prefab_instantiate() expands its nodes into scene objects.
+ *
+ * Not supported: external .gltf/.bin files and data URIs, sparse
+ * accessors, skins, morph targets, cameras, textures, and primitive modes
+ * other than triangle lists. Texture coordinates are kept as stored.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mesh.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Separates a GLB path from the index of one of its meshes */
+#define POC_GLTF_MESH_SEPARATOR '#'
+
+/** Parent of root nodes */
+#define POC_GLTF_NO_PARENT UINT32_MAX
+
+/**
+ * @brief One node of a GLB file's default scene
+ */
+typedef struct {
+    poc_string_id name;         /**< Interned node name */
+    uint32_t parent;            /**< Index of the parent node, or POC_GLTF_NO_PARENT */
+    vec3 position;              /**< Translation relative to the parent */
+    vec3 rotation;              /**< Euler angles in degrees, in poc_scene_object order */
+    vec3 scale;                 /**< Scale factors */
+    uint32_t mesh;              /**< glTF mesh index, or UINT32_MAX for a node without geometry */
+} poc_gltf_node;
+
+/**
+ * @brief Check whether a mesh path names a GLB file or one of its meshes
+ *
+ * @param path Mesh path, e.g. "models/ship.glb" or "models/ship.glb#2"
+ * @return true if the file part ends in ".glb"
+ */
+bool poc_gltf_is_path(const char *path);
+
+/**
+ * @brief Load one mesh of a GLB file
+ *
+ * @param path GLB path, optionally followed by POC_GLTF_MESH_SEPARATOR and a mesh index
+ * @return New mesh, or NULL on failure
+ */
+poc_mesh* poc_gltf_load_mesh(const char *path);
+
+/**
+ * @brief Point released geometry of a zero-copy GLB mesh back into its file
+ *
+ * The counterpart of poc_mesh_cache_map_geometry() for meshes that read
+ * their data from an archived GLB mapping. Fails, leaving the mesh
+ * untouched, if the file no longer has the same layout and counts.
+ *
+ * @param mesh Mesh loaded by poc_gltf_load_mesh()
+ * @return true if the mesh now reads from the mapping
+ */
+bool poc_gltf_map_geometry(poc_mesh *mesh);
+
+/**
+ * @brief Read the node hierarchy of a GLB file's default scene
+ *
+ * Nodes are ordered so every parent precedes its children. Matrix
+ * transforms are decomposed; any shear is lost.
+ *
+ * @param path GLB file
+ * @param out_nodes Receives a malloc'd node array (free with free())
+ * @param out_count Receives the number of nodes
+ * @return true on success
+ */
+bool poc_gltf_load_nodes(const char *path, poc_gltf_node **out_nodes, uint32_t *out_count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,244 @@
+#define _POSIX_C_SOURCE 200809L
+#include "job_system.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define JOB_SYSTEM_MAX_WORKERS 64
+
+typedef struct {
+    poc_job_fn fn;
+    void *user_data;
+    poc_job_counter *counter;
+} job_entry;
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t job_available;
+    pthread_cond_t job_finished;
+
+    // Ring buffer of queued jobs
+    job_entry *jobs;
+    uint32_t head;
+    uint32_t count;
+    uint32_t capacity;
+
+    pthread_t workers[JOB_SYSTEM_MAX_WORKERS];
+    uint32_t worker_count;
+    bool running;
+} job_system;
+
+static job_system g_jobs = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .job_available = PTHREAD_COND_INITIALIZER,
+    .job_finished = PTHREAD_COND_INITIALIZER,
+};
+
+static bool grow_queue_locked(void) {
+    uint32_t new_capacity = g_jobs.capacity == 0 ? 64 : g_jobs.capacity * 2;
+    job_entry *new_jobs = malloc(sizeof(job_entry) * new_capacity);
+    if (!new_jobs) {
+        return false;
+    }
+
+    // Unwrap the ring into the new buffer
+    for (uint32_t i = 0; i < g_jobs.count; i++) {
+        new_jobs[i] = g_jobs.jobs[(g_jobs.head + i) % g_jobs.capacity];
+    }
+
+    free(g_jobs.jobs);
+    g_jobs.jobs = new_jobs;
+    g_jobs.head = 0;
+    g_jobs.capacity = new_capacity;
+    return true;
+}
+
+static bool pop_job_locked(job_entry *out) {
+    if (g_jobs.count == 0) {
+        return false;
+    }
+
+    *out = g_jobs.jobs[g_jobs.head];
+    g_jobs.head = (g_jobs.head + 1) % g_jobs.capacity;
+    g_jobs.count--;
+    return true;
+}
+
+static void run_job(const job_entry *job) {
+    job->fn(job->user_data);
+
+    if (job->counter) {
+        if (atomic_fetch_sub_explicit(&job->counter->pending, 1, memory_order_acq_rel) == 1) {
+            // Wake waiters; the lock orders this with their pending check
+            pthread_mutex_lock(&g_jobs.mutex);
+            pthread_cond_broadcast(&g_jobs.job_finished);
+            pthread_mutex_unlock(&g_jobs.mutex);
+        }
+    }
+}
+
+static void *worker_main(void *arg) {
+    (void)arg;
+
+    pthread_mutex_lock(&g_jobs.mutex);
+    for (;;) {
+        job_entry job;
+        if (pop_job_locked(&job)) {
+            pthread_mutex_unlock(&g_jobs.mutex);
+            run_job(&job);
+            pthread_mutex_lock(&g_jobs.mutex);
+            continue;
+        }
+
+        if (!g_jobs.running) {
+            break;
+        }
+
+        pthread_cond_wait(&g_jobs.job_available, &g_jobs.mutex);
+    }
+    pthread_mutex_unlock(&g_jobs.mutex);
+
+    return NULL;
+}
+
+static bool start_workers_locked(uint32_t worker_count) {
+    if (g_jobs.running) {
+        return true;
+    }
+
+    if (worker_count == 0) {
+        long cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+        worker_count = cpu_count > 1 ? (uint32_t)(cpu_count - 1) : 1;
+    }
+    if (worker_count > JOB_SYSTEM_MAX_WORKERS) {
+        worker_count = JOB_SYSTEM_MAX_WORKERS;
+    }
+
+    g_jobs.running = true;
+    g_jobs.worker_count = 0;
+    for (uint32_t i = 0; i < worker_count; i++) {
+        if (pthread_create(&g_jobs.workers[i], NULL, worker_main, NULL) != 0) {
+            printf("⚠ Failed to start job worker %u\n", i);
+            break;
+        }
+        g_jobs.worker_count++;
+    }
+
+    if (g_jobs.worker_count == 0) {
+        g_jobs.running = false;
+        return false;
+    }
+
+    printf("✓ Job system started with %u workers\n", g_jobs.worker_count);
+    return true;
+}
+
+bool poc_jobs_init(uint32_t worker_count) {
+    pthread_mutex_lock(&g_jobs.mutex);
+    bool running = start_workers_locked(worker_count);
+    pthread_mutex_unlock(&g_jobs.mutex);
+    return running;
+}
+
+void poc_jobs_shutdown(void) {
+    pthread_mutex_lock(&g_jobs.mutex);
+    if (!g_jobs.running) {
+        pthread_mutex_unlock(&g_jobs.mutex);
+        return;
+    }
+    g_jobs.running = false;
+    pthread_cond_broadcast(&g_jobs.job_available);
+    uint32_t worker_count = g_jobs.worker_count;
+    pthread_mutex_unlock(&g_jobs.mutex);
+
+    // Workers drain the queue before exiting
+    for (uint32_t i = 0; i < worker_count; i++) {
+        pthread_join(g_jobs.workers[i], NULL);
+    }
+
+    pthread_mutex_lock(&g_jobs.mutex);
+    free(g_jobs.jobs);
+    g_jobs.jobs = NULL;
+    g_jobs.head = 0;
+    g_jobs.count = 0;
+    g_jobs.capacity = 0;
+    g_jobs.worker_count = 0;
+    pthread_mutex_unlock(&g_jobs.mutex);
+}
+
+uint32_t poc_jobs_get_worker_count(void) {
+    pthread_mutex_lock(&g_jobs.mutex);
+    start_workers_locked(0);
+    uint32_t worker_count = g_jobs.worker_count;
+    pthread_mutex_unlock(&g_jobs.mutex);
+    return worker_count;
+}
+
+bool poc_job_submit(poc_job_fn fn, void *user_data, poc_job_counter *counter) {
+    if (!fn) {
+        return false;
+    }
+
+    pthread_mutex_lock(&g_jobs.mutex);
+
+    if (!start_workers_locked(0) ||
+        (g_jobs.count >= g_jobs.capacity && !grow_queue_locked())) {
+        pthread_mutex_unlock(&g_jobs.mutex);
+        return false;
+    }
+
+    if (counter) {
+        atomic_fetch_add_explicit(&counter->pending, 1, memory_order_relaxed);
+    }
+
+    uint32_t tail = (g_jobs.head + g_jobs.count) % g_jobs.capacity;
+    g_jobs.jobs[tail] = (job_entry){ .fn = fn, .user_data = user_data, .counter = counter };
+    g_jobs.count++;
+
+    pthread_cond_signal(&g_jobs.job_available);
+    pthread_mutex_unlock(&g_jobs.mutex);
+    return true;
+}
+
+void poc_job_wait(poc_job_counter *counter) {
+    if (!counter) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_jobs.mutex);
+    while (atomic_load_explicit(&counter->pending, memory_order_acquire) != 0) {
+        // Help out rather than sleeping while our own jobs sit in the queue
+        job_entry job;
+        if (pop_job_locked(&job)) {
+            pthread_mutex_unlock(&g_jobs.mutex);
+            run_job(&job);
+            pthread_mutex_lock(&g_jobs.mutex);
+            continue;
+        }
+
+        pthread_cond_wait(&g_jobs.job_finished, &g_jobs.mutex);
+    }
+    pthread_mutex_unlock(&g_jobs.mutex);
+}
+
+bool poc_job_run_one(void) {
+    pthread_mutex_lock(&g_jobs.mutex);
+    job_entry job;
+    bool popped = pop_job_locked(&job);
+    pthread_mutex_unlock(&g_jobs.mutex);
+
+    if (popped) {
+        run_job(&job);
+    }
+    return popped;
+}
+
+bool poc_job_is_done(const poc_job_counter *counter) {
+    if (!counter) {
+        return true;
+    }
+
+    return atomic_load_explicit(&((poc_job_counter *)counter)->pending, memory_order_acquire) == 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file job_system.h
+ * @brief Process-wide worker thread pool for background and parallel work
+ *
+ * Jobs are plain function pointers with a user pointer. Callers that need to
+ * wait for a batch attach a poc_job_counter and call poc_job_wait(), which
+ * runs queued jobs on the waiting thread instead of blocking idle.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Job entry point
+ *
+ * @param user_data Pointer passed to poc_job_submit()
+ */
+typedef void (*poc_job_fn)(void *user_data);
+
+/**
+ * @brief Completion counter shared by a batch of jobs
+ *
+ * Zero-initialize before the first submit. The counter must outlive every
+ * job submitted against it.
+ */
+typedef struct poc_job_counter {
+    atomic_uint pending; /**< Jobs submitted but not yet finished */
+} poc_job_counter;
+
+/**
+ * @brief Start the worker pool
+ *
+ * Called lazily by poc_job_submit(); calling it explicitly chooses the size.
+ *
+ * @param worker_count Number of worker threads, or 0 for one less than the
+ *                     number of online CPUs (at least one)
+ * @return true if the pool is running
+ */
+bool poc_jobs_init(uint32_t worker_count);
+
+/**
+ * @brief Stop the worker pool, finishing queued jobs first
+ */
+void poc_jobs_shutdown(void);
+
+/**
+ * @brief Number of worker threads (starting the pool if needed)
+ */
+uint32_t poc_jobs_get_worker_count(void);
+
+/**
+ * @brief Queue a job for a worker thread
+ *
+ * @param fn Job function
+ * @param user_data Pointer handed to the job
+ * @param counter Optional counter incremented now and decremented when the job finishes
+ * @return true if queued; on false the job was not run and the counter is unchanged
+ */
+bool poc_job_submit(poc_job_fn fn, void *user_data, poc_job_counter *counter);
+
+/**
+ * @brief Wait until every job attached to a counter has finished
+ *
+ * The calling thread executes queued jobs while it waits.
+ *
+ * @param counter Counter to wait on
+ */
+void poc_job_wait(poc_job_counter *counter);
+
+/**
+ * @brief Run one queued job on the calling thread, if there is one
+ *
+ * For waits on something other than a counter, so the waiting thread can
+ * help instead of sleeping while the work it needs sits in the queue.
+ *
+ * @return true if a job was run
+ */
+bool poc_job_run_one(void);
+
+/**
+ * @brief Check whether every job attached to a counter has finished
+ */
+bool poc_job_is_done(const poc_job_counter *counter);
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,6 +6,7 @@
 #include "scene.h"
 #include "scene_object.h"
 #include "mesh.h"
+#include "world_stream.h"
 #include <podi.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -17,6 +18,8 @@
 #define SCENE_METATABLE "POCEngine.Scene"
 #define SCENE_OBJECT_METATABLE "POCEngine.SceneObject"
 #define MESH_METATABLE "POCEngine.Mesh"
+#define WORLD_STREAM_METATABLE "POCEngine.WorldStream"
+#define MESH_REQUEST_METATABLE "POCEngine.MeshRequest"
 
 // Forward declarations for binding functions
 static int lua_poc_get_time(lua_State *L);
@@ -36,15 +39,38 @@ static int lua_poc_get_cursor_position(lua_State *L);
 static int lua_poc_create_scene(lua_State *L);
 static int lua_poc_bind_scene(lua_State *L);
 static int lua_poc_create_scene_object(lua_State *L);
+static int lua_poc_prefab_instantiate(lua_State *L);
 static int lua_poc_load_mesh(lua_State *L);
 static int lua_poc_pick_object(lua_State *L);
 static int lua_poc_scene_add_object(lua_State *L);
 static int lua_poc_scene_object_set_mesh(lua_State *L);
 static int lua_poc_scene_object_set_position(lua_State *L);
 static int lua_poc_scene_save(lua_State *L);
+static int lua_poc_scene_save_incremental(lua_State *L);
 static int lua_poc_scene_load(lua_State *L);
+static int lua_poc_scene_get_memory_stats(lua_State *L);
+static int lua_poc_scene_enable_overlaps(lua_State *L);
+static int lua_poc_scene_disable_overlaps(lua_State *L);
+static int lua_poc_scene_get_overlaps(lua_State *L);
+static int lua_poc_scene_query_sphere(lua_State *L);
+static int lua_poc_scene_query_aabb(lua_State *L);
+static int lua_poc_scene_query_knn(lua_State *L);
 static int lua_poc_scene_clone(lua_State *L);
 static int lua_poc_scene_copy_from(lua_State *L);
+static int lua_poc_scene_save_partitioned(lua_State *L);
+static int lua_poc_world_stream_open(lua_State *L);
+static int lua_poc_world_stream_update(lua_State *L);
+static int lua_poc_world_stream_get_stats(lua_State *L);
+static int lua_poc_purge_assets(lua_State *L);
+static int lua_poc_get_asset_stats(lua_State *L);
+static int lua_poc_set_mesh_release_after_upload(lua_State *L);
+static int lua_mesh_gc(lua_State *L);
+static int lua_poc_load_mesh_async(lua_State *L);
+static int lua_poc_mesh_request_is_done(lua_State *L);
+static int lua_poc_mesh_request_await(lua_State *L);
+static int lua_poc_mesh_request_get(lua_State *L);
+static int lua_mesh_request_gc(lua_State *L);
+static int lua_poc_world_stream_close(lua_State *L);
 static int lua_poc_set_play_mode(lua_State *L);
 static int lua_poc_is_play_mode(lua_State *L);
 
@@ -77,6 +103,11 @@ static podi_window *g_active_window = NULL;
 static poc_scene *g_active_scene = NULL;
 static poc_camera *g_active_camera = NULL;
 
+// Scratch for spatial query results, reused across calls
+static poc_scene_object **g_query_objects = NULL;
+static float *g_query_distances = NULL;
+static uint32_t g_query_capacity = 0;
+
 void poc_scripting_register_bindings(lua_State *L) {
     if (!L) return;
 
@@ -121,8 +152,20 @@ void poc_scripting_register_bindings(lua_State *L) {
     luaL_newmetatable(L, SCENE_OBJECT_METATABLE);
     lua_pop(L, 1);
 
-    // Create Mesh metatable
+    // Create Mesh metatable; each userdata holds an asset reference
     luaL_newmetatable(L, MESH_METATABLE);
+    lua_pushcfunction(L, lua_mesh_gc);
+    lua_setfield(L, -2, "__gc");
+    lua_pop(L, 1);
+
+    // Create WorldStream metatable
+    luaL_newmetatable(L, WORLD_STREAM_METATABLE);
+    lua_pop(L, 1);
+
+    // Create MeshRequest metatable; collecting a request cancels its callback
+    luaL_newmetatable(L, MESH_REQUEST_METATABLE);
+    lua_pushcfunction(L, lua_mesh_request_gc);
+    lua_setfield(L, -2, "__gc");
     lua_pop(L, 1);
 
     // Create POC table
@@ -171,9 +214,24 @@ void poc_scripting_register_bindings(lua_State *L) {
     lua_pushcfunction(L, lua_poc_create_scene_object);
     lua_setfield(L, -2, "create_scene_object");
 
+    lua_pushcfunction(L, lua_poc_prefab_instantiate);
+    lua_setfield(L, -2, "prefab_instantiate");
+
     lua_pushcfunction(L, lua_poc_load_mesh);
     lua_setfield(L, -2, "load_mesh");
 
+    lua_pushcfunction(L, lua_poc_load_mesh_async);
+    lua_setfield(L, -2, "load_mesh_async");
+
+    lua_pushcfunction(L, lua_poc_mesh_request_is_done);
+    lua_setfield(L, -2, "mesh_request_is_done");
+
+    lua_pushcfunction(L, lua_poc_mesh_request_await);
+    lua_setfield(L, -2, "mesh_request_await");
+
+    lua_pushcfunction(L, lua_poc_mesh_request_get);
+    lua_setfield(L, -2, "mesh_request_get");
+
     lua_pushcfunction(L, lua_poc_pick_object);
     lua_setfield(L, -2, "pick_object");
 
@@ -189,15 +247,66 @@ void poc_scripting_register_bindings(lua_State *L) {
     lua_pushcfunction(L, lua_poc_scene_save);
     lua_setfield(L, -2, "scene_save");
 
+    lua_pushcfunction(L, lua_poc_scene_save_incremental);
+    lua_setfield(L, -2, "scene_save_incremental");
+
     lua_pushcfunction(L, lua_poc_scene_load);
     lua_setfield(L, -2, "scene_load");
 
     lua_pushcfunction(L, lua_poc_scene_clone);
     lua_setfield(L, -2, "scene_clone");
 
+    lua_pushcfunction(L, lua_poc_scene_get_memory_stats);
+    lua_setfield(L, -2, "scene_get_memory_stats");
+
+    // Overlap queries
+    lua_pushcfunction(L, lua_poc_scene_enable_overlaps);
+    lua_setfield(L, -2, "scene_enable_overlaps");
+
+    lua_pushcfunction(L, lua_poc_scene_disable_overlaps);
+    lua_setfield(L, -2, "scene_disable_overlaps");
+
+    lua_pushcfunction(L, lua_poc_scene_get_overlaps);
+    lua_setfield(L, -2, "scene_get_overlaps");
+
+    lua_pushcfunction(L, lua_poc_scene_query_sphere);
+    lua_setfield(L, -2, "scene_query_sphere");
+
+    lua_pushcfunction(L, lua_poc_scene_query_aabb);
+    lua_setfield(L, -2, "scene_query_aabb");
+
+    lua_pushcfunction(L, lua_poc_scene_query_knn);
+    lua_setfield(L, -2, "scene_query_knn");
+
     lua_pushcfunction(L, lua_poc_scene_copy_from);
     lua_setfield(L, -2, "scene_copy_from");
 
+    // World streaming
+    lua_pushcfunction(L, lua_poc_scene_save_partitioned);
+    lua_setfield(L, -2, "scene_save_partitioned");
+
+    lua_pushcfunction(L, lua_poc_world_stream_open);
+    lua_setfield(L, -2, "world_stream_open");
+
+    lua_pushcfunction(L, lua_poc_world_stream_update);
+    lua_setfield(L, -2, "world_stream_update");
+
+    lua_pushcfunction(L, lua_poc_world_stream_get_stats);
+    lua_setfield(L, -2, "world_stream_get_stats");
+
+    lua_pushcfunction(L, lua_poc_world_stream_close);
+    lua_setfield(L, -2, "world_stream_close");
+
+    // Asset manager
+    lua_pushcfunction(L, lua_poc_purge_assets);
+    lua_setfield(L, -2, "purge_assets");
+
+    lua_pushcfunction(L, lua_poc_get_asset_stats);
+    lua_setfield(L, -2, "get_asset_stats");
+
+    lua_pushcfunction(L, lua_poc_set_mesh_release_after_upload);
+    lua_setfield(L, -2, "set_mesh_release_after_upload");
+
     // Cursor control functions
     lua_pushcfunction(L, lua_poc_set_cursor_mode);
     lua_setfield(L, -2, "set_cursor_mode");
@@ -701,10 +810,37 @@ static int lua_poc_create_scene_object(lua_State *L) {
     return 1;
 }
 
+static int lua_poc_prefab_instantiate(lua_State *L) {
+    const char *path = luaL_checkstring(L, 1);
+    const char *name = luaL_checkstring(L, 2);
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 3);
+
+    poc_prefab *prefab = poc_prefab_load(path);
+    if (!prefab) {
+        lua_pushnil(L);
+        lua_pushfstring(L, "Failed to load prefab from '%s'", path);
+        return 2;
+    }
+
+    // The instance holds its own reference
+    poc_scene_object *obj = poc_prefab_instantiate(prefab, name, id);
+    poc_prefab_release(prefab);
+    if (!obj) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Failed to create prefab instance");
+        return 2;
+    }
+
+    poc_scene_object **userdata = (poc_scene_object **)lua_newuserdata(L, sizeof(poc_scene_object *));
+    *userdata = obj;
+    luaL_setmetatable(L, SCENE_OBJECT_METATABLE);
+    return 1;
+}
+
 static int lua_poc_load_mesh(lua_State *L) {
     const char *filename = luaL_checkstring(L, 1);
 
-    poc_mesh *mesh = poc_mesh_load(filename);
+    poc_mesh *mesh = poc_asset_acquire_mesh(filename);
     if (!mesh) {
         lua_pushnil(L);
         lua_pushfstring(L, "Failed to load mesh from '%s'", filename);
@@ -717,6 +853,129 @@ static int lua_poc_load_mesh(lua_State *L) {
     return 1;
 }
 
+static int lua_mesh_gc(lua_State *L) {
+    poc_mesh **mesh_ptr = (poc_mesh **)luaL_checkudata(L, 1, MESH_METATABLE);
+    if (mesh_ptr && *mesh_ptr) {
+        poc_asset_release_mesh(*mesh_ptr);
+        *mesh_ptr = NULL;
+    }
+    return 0;
+}
+
+// MeshRequest userdata. While a callback is pending the userdata is anchored
+// in the registry, so it cannot be collected before the callback runs.
+typedef struct {
+    poc_mesh_request *request;
+    lua_State *L;           // Main thread; the caller may be a finished coroutine
+    int callback_ref;
+    int anchor_ref;
+} lua_mesh_request;
+
+static void push_mesh_userdata(lua_State *L, poc_mesh *mesh) {
+    poc_asset_retain_mesh(mesh);
+    poc_mesh **userdata = (poc_mesh **)lua_newuserdata(L, sizeof(poc_mesh *));
+    *userdata = mesh;
+    luaL_setmetatable(L, MESH_METATABLE);
+}
+
+static void lua_mesh_request_loaded(poc_mesh_request *request, poc_mesh *mesh, void *user_data) {
+    (void)request;
+    lua_mesh_request *handle = (lua_mesh_request *)user_data;
+    lua_State *L = handle->L;
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, handle->callback_ref);
+    if (mesh) {
+        push_mesh_userdata(L, mesh);
+    } else {
+        lua_pushnil(L);
+    }
+    if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
+        printf("Mesh load callback error: %s\n", lua_tostring(L, -1));
+        lua_pop(L, 1);
+    }
+
+    luaL_unref(L, LUA_REGISTRYINDEX, handle->callback_ref);
+    handle->callback_ref = LUA_NOREF;
+    luaL_unref(L, LUA_REGISTRYINDEX, handle->anchor_ref);
+    handle->anchor_ref = LUA_NOREF;
+}
+
+static int lua_poc_load_mesh_async(lua_State *L) {
+    const char *filename = luaL_checkstring(L, 1);
+    bool has_callback = !lua_isnoneornil(L, 2);
+    if (has_callback) {
+        luaL_checktype(L, 2, LUA_TFUNCTION);
+    }
+
+    lua_mesh_request *handle = (lua_mesh_request *)lua_newuserdata(L, sizeof(lua_mesh_request));
+    handle->request = NULL;
+    handle->callback_ref = LUA_NOREF;
+    handle->anchor_ref = LUA_NOREF;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
+    handle->L = lua_tothread(L, -1);
+    lua_pop(L, 1);
+    luaL_setmetatable(L, MESH_REQUEST_METATABLE);
+
+    if (has_callback) {
+        lua_pushvalue(L, 2);
+        handle->callback_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+        lua_pushvalue(L, -1);
+        handle->anchor_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    }
+
+    handle->request = poc_mesh_load_async(filename, has_callback ? lua_mesh_request_loaded : NULL, handle);
+    if (!handle->request) {
+        luaL_unref(L, LUA_REGISTRYINDEX, handle->callback_ref);
+        handle->callback_ref = LUA_NOREF;
+        luaL_unref(L, LUA_REGISTRYINDEX, handle->anchor_ref);
+        handle->anchor_ref = LUA_NOREF;
+        lua_pushnil(L);
+        lua_pushfstring(L, "Failed to start loading mesh from '%s'", filename);
+        return 2;
+    }
+    return 1;
+}
+
+static int lua_poc_mesh_request_is_done(lua_State *L) {
+    lua_mesh_request *handle = (lua_mesh_request *)luaL_checkudata(L, 1, MESH_REQUEST_METATABLE);
+    lua_pushboolean(L, poc_mesh_request_is_done(handle->request));
+    return 1;
+}
+
+static int lua_poc_mesh_request_await(lua_State *L) {
+    lua_mesh_request *handle = (lua_mesh_request *)luaL_checkudata(L, 1, MESH_REQUEST_METATABLE);
+
+    poc_mesh *mesh = poc_mesh_request_wait(handle->request);
+    if (!mesh) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Failed to load mesh");
+        return 2;
+    }
+    push_mesh_userdata(L, mesh);
+    return 1;
+}
+
+static int lua_poc_mesh_request_get(lua_State *L) {
+    lua_mesh_request *handle = (lua_mesh_request *)luaL_checkudata(L, 1, MESH_REQUEST_METATABLE);
+
+    poc_mesh *mesh = poc_mesh_request_get_mesh(handle->request);
+    if (!mesh) {
+        lua_pushnil(L);
+        return 1;
+    }
+    push_mesh_userdata(L, mesh);
+    return 1;
+}
+
+static int lua_mesh_request_gc(lua_State *L) {
+    lua_mesh_request *handle = (lua_mesh_request *)luaL_checkudata(L, 1, MESH_REQUEST_METATABLE);
+    if (handle->request) {
+        poc_mesh_request_release(handle->request);
+        handle->request = NULL;
+    }
+    return 0;
+}
+
 static int lua_poc_pick_object(lua_State *L) {
     float x = (float)luaL_checknumber(L, 1);
     float y = (float)luaL_checknumber(L, 2);
@@ -758,7 +1017,7 @@ static int lua_poc_pick_object(lua_State *L) {
         poc_scene_object *obj = g_active_scene->objects[i];
         if (obj) {
             printf("🎯 OBJECT[%d]: %s ID=%d Position(%.2f, %.2f, %.2f) Renderable=%s\n",
-                   i, obj->name, obj->id,
+                   i, poc_string_get(obj->name), obj->id,
                    obj->position[0], obj->position[1], obj->position[2],
                    poc_scene_object_is_renderable(obj) ? "YES" : "NO");
             if (poc_scene_object_is_renderable(obj)) {
@@ -781,7 +1040,7 @@ static int lua_poc_pick_object(lua_State *L) {
         lua_pushinteger(L, hit.object->id);
         lua_setfield(L, -2, "object_id");
 
-        lua_pushstring(L, hit.object->name);
+        lua_pushstring(L, poc_string_get(hit.object->name));
         lua_setfield(L, -2, "object_name");
 
         lua_pushnumber(L, hit.distance);
@@ -868,6 +1127,240 @@ static int lua_poc_scene_save(lua_State *L) {
     return 1;
 }
 
+static int lua_poc_scene_save_incremental(lua_State *L) {
+    poc_scene **scene_ptr = (poc_scene **)luaL_checkudata(L, 1, SCENE_METATABLE);
+    const char *path = luaL_checkstring(L, 2);
+
+    if (!scene_ptr || !*scene_ptr) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Invalid scene object");
+        return 2;
+    }
+
+    if (!poc_scene_save_incremental(*scene_ptr, path)) {
+        lua_pushnil(L);
+        lua_pushfstring(L, "Failed to save scene incrementally to '%s'", path);
+        return 2;
+    }
+
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+static int lua_poc_scene_get_memory_stats(lua_State *L) {
+    poc_scene **scene_ptr = (poc_scene **)luaL_checkudata(L, 1, SCENE_METATABLE);
+
+    if (!scene_ptr || !*scene_ptr) {
+        return luaL_error(L, "Invalid scene object");
+    }
+
+    poc_scene_memory_stats stats;
+    poc_scene_get_memory_stats(*scene_ptr, &stats);
+
+    lua_newtable(L);
+    lua_pushinteger(L, stats.object_count);
+    lua_setfield(L, -2, "object_count");
+    lua_pushinteger(L, (lua_Integer)stats.object_bytes);
+    lua_setfield(L, -2, "object_bytes");
+    lua_pushinteger(L, (lua_Integer)stats.bookkeeping_bytes);
+    lua_setfield(L, -2, "bookkeeping_bytes");
+    lua_pushinteger(L, stats.mesh_count);
+    lua_setfield(L, -2, "mesh_count");
+    lua_pushinteger(L, (lua_Integer)stats.mesh_bytes);
+    lua_setfield(L, -2, "mesh_bytes");
+    lua_pushinteger(L, stats.string_count);
+    lua_setfield(L, -2, "string_count");
+    lua_pushinteger(L, (lua_Integer)stats.string_bytes);
+    lua_setfield(L, -2, "string_bytes");
+    return 1;
+}
+
+static int lua_poc_scene_enable_overlaps(lua_State *L) {
+    poc_scene **scene_ptr = (poc_scene **)luaL_checkudata(L, 1, SCENE_METATABLE);
+
+    if (!scene_ptr || !*scene_ptr) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Invalid scene object");
+        return 2;
+    }
+
+    // Scripts poll the batched events; the C callback slot stays free
+    if (!poc_scene_enable_overlaps(*scene_ptr, NULL, NULL)) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Failed to enable overlap tracking");
+        return 2;
+    }
+
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+static int lua_poc_scene_disable_overlaps(lua_State *L) {
+    poc_scene **scene_ptr = (poc_scene **)luaL_checkudata(L, 1, SCENE_METATABLE);
+
+    if (scene_ptr && *scene_ptr) {
+        poc_scene_disable_overlaps(*scene_ptr);
+    }
+    return 0;
+}
+
+// Pairs as a flat id list {a1, b1, a2, b2, ...}: one table per category
+// instead of one per pair keeps large batches cheap
+static void push_overlap_pairs(lua_State *L, const poc_overlap_pair *pairs, uint32_t count, const char *field) {
+    lua_createtable(L, (int)(count * 2), 0);
+    for (uint32_t i = 0; i < count; i++) {
+        lua_pushinteger(L, pairs[i].a_id);
+        lua_rawseti(L, -2, (lua_Integer)i * 2 + 1);
+        lua_pushinteger(L, pairs[i].b_id);
+        lua_rawseti(L, -2, (lua_Integer)i * 2 + 2);
+    }
+    lua_setfield(L, -2, field);
+}
+
+static int lua_poc_scene_get_overlaps(lua_State *L) {
+    poc_scene **scene_ptr = (poc_scene **)luaL_checkudata(L, 1, SCENE_METATABLE);
+
+    if (!scene_ptr || !*scene_ptr) {
+        return luaL_error(L, "Invalid scene object");
+    }
+
+    poc_overlap_events events;
+    if (!poc_scene_get_overlap_events(*scene_ptr, &events)) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Overlap tracking is not enabled for this scene");
+        return 2;
+    }
+
+    lua_createtable(L, 0, 5);
+    push_overlap_pairs(L, events.enter, events.enter_count, "enter");
+    push_overlap_pairs(L, events.stay, events.stay_count, "stay");
+    push_overlap_pairs(L, events.exit, events.exit_count, "exit");
+    lua_pushinteger(L, events.pair_count);
+    lua_setfield(L, -2, "pair_count");
+    lua_pushnumber(L, events.update_ms);
+    lua_setfield(L, -2, "update_ms");
+    return 1;
+}
+
+static bool reserve_query_scratch(uint32_t needed) {
+    if (needed <= g_query_capacity) {
+        return true;
+    }
+
+    uint32_t new_capacity = g_query_capacity == 0 ? 64 : g_query_capacity;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    poc_scene_object **objects = realloc(g_query_objects, sizeof(poc_scene_object *) * new_capacity);
+    if (!objects) {
+        return false;
+    }
+    g_query_objects = objects;
+
+    float *distances = realloc(g_query_distances, sizeof(float) * new_capacity);
+    if (!distances) {
+        return false;
+    }
+    g_query_distances = distances;
+    g_query_capacity = new_capacity;
+    return true;
+}
+
+// Fill the table at table_index (or a new one if it is not a table) with
+// count values, clearing leftovers from a previous call, and push it
+static void push_query_list(lua_State *L, int table_index, uint32_t count, bool distances) {
+    if (lua_istable(L, table_index)) {
+        lua_pushvalue(L, table_index);
+    } else {
+        lua_createtable(L, (int)count, 0);
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (distances) {
+            lua_pushnumber(L, g_query_distances[i]);
+        } else {
+            lua_pushinteger(L, g_query_objects[i]->id);
+        }
+        lua_rawseti(L, -2, (lua_Integer)i + 1);
+    }
+    for (lua_Integer i = (lua_Integer)count + 1; lua_rawgeti(L, -1, i) != LUA_TNIL; i++) {
+        lua_pop(L, 1);
+        lua_pushnil(L);
+        lua_rawseti(L, -2, i);
+    }
+    lua_pop(L, 1);
+}
+
+// Object ids within radius of a point: POC.scene_query_sphere(scene, x, y, z, radius [, out])
+static int lua_poc_scene_query_sphere(lua_State *L) {
+    poc_scene **scene_ptr = (poc_scene **)luaL_checkudata(L, 1, SCENE_METATABLE);
+    vec3 center = {(float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3), (float)luaL_checknumber(L, 4)};
+    float radius = (float)luaL_checknumber(L, 5);
+
+    if (!scene_ptr || !*scene_ptr) {
+        return luaL_error(L, "Invalid scene object");
+    }
+
+    uint32_t count = poc_scene_query_sphere(*scene_ptr, center, radius, g_query_objects, g_query_capacity);
+    if (count > g_query_capacity) {
+        if (!reserve_query_scratch(count)) {
+            return luaL_error(L, "Out of memory for query results");
+        }
+        poc_scene_query_sphere(*scene_ptr, center, radius, g_query_objects, g_query_capacity);
+    }
+
+    push_query_list(L, 6, count, false);
+    lua_pushinteger(L, count);
+    return 2;
+}
+
+// Object ids overlapping a box: POC.scene_query_aabb(scene, min_x, min_y, min_z, max_x, max_y, max_z [, out])
+static int lua_poc_scene_query_aabb(lua_State *L) {
+    poc_scene **scene_ptr = (poc_scene **)luaL_checkudata(L, 1, SCENE_METATABLE);
+    vec3 min = {(float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3), (float)luaL_checknumber(L, 4)};
+    vec3 max = {(float)luaL_checknumber(L, 5), (float)luaL_checknumber(L, 6), (float)luaL_checknumber(L, 7)};
+
+    if (!scene_ptr || !*scene_ptr) {
+        return luaL_error(L, "Invalid scene object");
+    }
+
+    uint32_t count = poc_scene_query_aabb(*scene_ptr, min, max, g_query_objects, g_query_capacity);
+    if (count > g_query_capacity) {
+        if (!reserve_query_scratch(count)) {
+            return luaL_error(L, "Out of memory for query results");
+        }
+        poc_scene_query_aabb(*scene_ptr, min, max, g_query_objects, g_query_capacity);
+    }
+
+    push_query_list(L, 8, count, false);
+    lua_pushinteger(L, count);
+    return 2;
+}
+
+// Nearest object ids and their distances: POC.scene_query_knn(scene, x, y, z, k [, out_ids [, out_distances]])
+static int lua_poc_scene_query_knn(lua_State *L) {
+    poc_scene **scene_ptr = (poc_scene **)luaL_checkudata(L, 1, SCENE_METATABLE);
+    vec3 point = {(float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3), (float)luaL_checknumber(L, 4)};
+    lua_Integer k = luaL_checkinteger(L, 5);
+
+    if (!scene_ptr || !*scene_ptr) {
+        return luaL_error(L, "Invalid scene object");
+    }
+    if (k < 0 || k > INT32_MAX) {
+        return luaL_error(L, "k out of range");
+    }
+
+    if (!reserve_query_scratch((uint32_t)k)) {
+        return luaL_error(L, "Out of memory for query results");
+    }
+    uint32_t count = poc_scene_query_knn(*scene_ptr, point, (uint32_t)k, g_query_objects, g_query_distances);
+
+    push_query_list(L, 6, count, false);
+    push_query_list(L, 7, count, true);
+    return 2;
+}
+
 static int lua_poc_scene_load(lua_State *L) {
     const char *path = luaL_checkstring(L, 1);
 
@@ -925,6 +1418,165 @@ static int lua_poc_scene_copy_from(lua_State *L) {
     return 1;
 }
 
+static int lua_poc_scene_save_partitioned(lua_State *L) {
+    poc_scene **scene_ptr = (poc_scene **)luaL_checkudata(L, 1, SCENE_METATABLE);
+    const char *path = luaL_checkstring(L, 2);
+    float cell_size = (float)luaL_checknumber(L, 3);
+
+    if (!scene_ptr || !*scene_ptr) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Invalid scene object");
+        return 2;
+    }
+
+    if (!poc_scene_save_partitioned(*scene_ptr, path, cell_size)) {
+        lua_pushnil(L);
+        lua_pushfstring(L, "Failed to save partitioned scene to '%s'", path);
+        return 2;
+    }
+
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+static float get_config_number(lua_State *L, int index, const char *field, float fallback) {
+    lua_getfield(L, index, field);
+    float value = lua_isnumber(L, -1) ? (float)lua_tonumber(L, -1) : fallback;
+    lua_pop(L, 1);
+    return value;
+}
+
+static int lua_poc_world_stream_open(lua_State *L) {
+    poc_scene **scene_ptr = (poc_scene **)luaL_checkudata(L, 1, SCENE_METATABLE);
+    const char *path = luaL_checkstring(L, 2);
+
+    if (!scene_ptr || !*scene_ptr) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Invalid scene object");
+        return 2;
+    }
+
+    // Optional config table; missing fields keep their defaults
+    poc_world_stream_config config;
+    poc_world_stream_config_defaults(&config);
+    if (lua_istable(L, 3)) {
+        config.load_radius = get_config_number(L, 3, "load_radius", config.load_radius);
+        config.unload_radius = get_config_number(L, 3, "unload_radius", config.unload_radius);
+        config.memory_budget_bytes = (uint64_t)get_config_number(L, 3, "memory_budget_mb",
+                                                                 (float)(config.memory_budget_bytes >> 20)) << 20;
+        config.max_loads_in_flight = (uint32_t)get_config_number(L, 3, "max_loads_in_flight",
+                                                                 (float)config.max_loads_in_flight);
+        config.integrate_budget_ms = get_config_number(L, 3, "integrate_budget_ms",
+                                                       (float)config.integrate_budget_ms);
+    }
+
+    poc_world_stream *stream = poc_world_stream_open(path, *scene_ptr, &config);
+    if (!stream) {
+        lua_pushnil(L);
+        lua_pushfstring(L, "Failed to open world stream '%s'", path);
+        return 2;
+    }
+
+    poc_world_stream **userdata = (poc_world_stream **)lua_newuserdata(L, sizeof(poc_world_stream *));
+    *userdata = stream;
+    luaL_setmetatable(L, WORLD_STREAM_METATABLE);
+    return 1;
+}
+
+static int lua_poc_world_stream_update(lua_State *L) {
+    poc_world_stream **stream_ptr = (poc_world_stream **)luaL_checkudata(L, 1, WORLD_STREAM_METATABLE);
+    float x = (float)luaL_checknumber(L, 2);
+    float y = (float)luaL_checknumber(L, 3);
+    float z = (float)luaL_checknumber(L, 4);
+
+    if (!stream_ptr || !*stream_ptr) {
+        return luaL_error(L, "World stream is closed");
+    }
+
+    vec3 camera_position = {x, y, z};
+    poc_world_stream_update(*stream_ptr, camera_position);
+    return 0;
+}
+
+static int lua_poc_world_stream_get_stats(lua_State *L) {
+    poc_world_stream **stream_ptr = (poc_world_stream **)luaL_checkudata(L, 1, WORLD_STREAM_METATABLE);
+
+    if (!stream_ptr || !*stream_ptr) {
+        return luaL_error(L, "World stream is closed");
+    }
+
+    poc_world_stream_stats stats;
+    poc_world_stream_get_stats(*stream_ptr, &stats);
+
+    lua_newtable(L);
+    lua_pushinteger(L, stats.cells_total);
+    lua_setfield(L, -2, "cells_total");
+    lua_pushinteger(L, stats.cells_resident);
+    lua_setfield(L, -2, "cells_resident");
+    lua_pushinteger(L, stats.cells_loading);
+    lua_setfield(L, -2, "cells_loading");
+    lua_pushinteger(L, (lua_Integer)stats.cells_evicted);
+    lua_setfield(L, -2, "cells_evicted");
+    lua_pushinteger(L, stats.objects_resident);
+    lua_setfield(L, -2, "objects_resident");
+    lua_pushinteger(L, (lua_Integer)stats.resident_bytes);
+    lua_setfield(L, -2, "resident_bytes");
+    lua_pushinteger(L, (lua_Integer)stats.memory_budget_bytes);
+    lua_setfield(L, -2, "memory_budget_bytes");
+    lua_pushnumber(L, stats.last_update_ms);
+    lua_setfield(L, -2, "last_update_ms");
+    lua_pushnumber(L, stats.max_update_ms);
+    lua_setfield(L, -2, "max_update_ms");
+    return 1;
+}
+
+static int lua_poc_purge_assets(lua_State *L) {
+    lua_pushinteger(L, poc_asset_purge());
+    return 1;
+}
+
+static int lua_poc_get_asset_stats(lua_State *L) {
+    poc_asset_stats stats;
+    poc_asset_get_stats(&stats);
+
+    lua_newtable(L);
+    lua_pushinteger(L, stats.mesh_count);
+    lua_setfield(L, -2, "mesh_count");
+    lua_pushinteger(L, stats.referenced_count);
+    lua_setfield(L, -2, "referenced_count");
+    lua_pushinteger(L, (lua_Integer)stats.loaded_bytes);
+    lua_setfield(L, -2, "loaded_bytes");
+    lua_pushinteger(L, (lua_Integer)stats.resident_bytes);
+    lua_setfield(L, -2, "resident_bytes");
+    lua_pushinteger(L, (lua_Integer)stats.hits);
+    lua_setfield(L, -2, "hits");
+    lua_pushinteger(L, (lua_Integer)stats.misses);
+    lua_setfield(L, -2, "misses");
+    lua_pushinteger(L, (lua_Integer)stats.purged);
+    lua_setfield(L, -2, "purged");
+    lua_pushinteger(L, (lua_Integer)stats.reloads);
+    lua_setfield(L, -2, "reloads");
+    lua_pushnumber(L, stats.last_reload_ms);
+    lua_setfield(L, -2, "last_reload_ms");
+    return 1;
+}
+
+static int lua_poc_set_mesh_release_after_upload(lua_State *L) {
+    luaL_checktype(L, 1, LUA_TBOOLEAN);
+    poc_mesh_set_release_after_upload(lua_toboolean(L, 1));
+    return 0;
+}
+
+static int lua_poc_world_stream_close(lua_State *L) {
+    poc_world_stream **stream_ptr = (poc_world_stream **)luaL_checkudata(L, 1, WORLD_STREAM_METATABLE);
+
+    if (stream_ptr && *stream_ptr) {
+        poc_world_stream_close(*stream_ptr);
+        *stream_ptr = NULL;
+    }
+    return 0;
+}
+
 static int lua_poc_set_play_mode(lua_State *L) {
     bool enabled = lua_toboolean(L, 1);
 
@@ -1,10 +1,24 @@
 #include "mesh.h"
+#include "mesh_optimize.h"
+#include "mesh_cluster.h"
+#include "mesh_cache.h"
+#include "asset_archive.h"
+#include "gltf_loader.h"
 #include "poc_engine.h"
 #include <stdlib.h>
 #include <string.h>
+#include <stdatomic.h>
 #include <float.h>
 #include <math.h>
 
+#if defined(POC_ARCH_X64)
+#include <immintrin.h>
+#elif defined(POC_ARCH_ARM64)
+#include <arm_neon.h>
+#endif
+
+static atomic_bool g_release_after_upload = false;
+
 poc_mesh* poc_mesh_create(void) {
     poc_mesh *mesh = malloc(sizeof(poc_mesh));
     if (!mesh) {
@@ -24,11 +38,158 @@ poc_mesh* poc_mesh_create(void) {
     return mesh;
 }
 
+// Order groups by material so each material's triangles end up contiguous;
+// groups without a material sort last, ties keep file order
+static int compare_group_material(const void *a, const void *b) {
+    const poc_mesh_group *ga = *(const poc_mesh_group *const *)a;
+    const poc_mesh_group *gb = *(const poc_mesh_group *const *)b;
+    if (ga->material_index != gb->material_index) {
+        return ga->material_index < gb->material_index ? -1 : 1;
+    }
+    return ga < gb ? -1 : (ga > gb ? 1 : 0);
+}
+
+// Pack every non-empty group into one vertex/index array with one submesh
+// per material
+static bool pack_model_groups(poc_mesh *mesh, poc_model *model) {
+    uint32_t group_count = 0;
+    uint64_t vertex_total = 0;
+    uint64_t index_total = 0;
+    for (uint32_t obj_idx = 0; obj_idx < model->object_count; obj_idx++) {
+        for (uint32_t grp_idx = 0; grp_idx < model->objects[obj_idx].group_count; grp_idx++) {
+            poc_mesh_group *group = &model->objects[obj_idx].groups[grp_idx];
+            if (group->vertex_count > 0) {
+                group_count++;
+                vertex_total += group->vertex_count;
+                index_total += group->index_count;
+            }
+            // Treat dangling material references like missing ones
+            if (group->material_index >= model->material_count) {
+                group->material_index = UINT32_MAX;
+            }
+        }
+    }
+
+    if (group_count == 0) {
+        printf("Warning: No geometry found in OBJ file\n");
+        return false;
+    }
+    if (vertex_total > UINT32_MAX || index_total > UINT32_MAX) {
+        printf("Warning: OBJ file has too many vertices for one mesh\n");
+        return false;
+    }
+
+    // Groups are already addressed by their position in the model's arrays,
+    // so sorting pointers to them keeps file order among equal materials
+    poc_mesh_group **groups = malloc(group_count * sizeof(poc_mesh_group *));
+    poc_vertex *vertices = malloc(vertex_total * sizeof(poc_vertex));
+    uint32_t *indices = malloc((index_total > 0 ? index_total : 1) * sizeof(uint32_t));
+    poc_submesh *submeshes = malloc(group_count * sizeof(poc_submesh));
+    poc_material *materials = malloc((model->material_count > 0 ? model->material_count : 1) * sizeof(poc_material));
+    if (!groups || !vertices || !indices || !submeshes || !materials) {
+        free(groups);
+        free(vertices);
+        free(indices);
+        free(submeshes);
+        free(materials);
+        return false;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t obj_idx = 0; obj_idx < model->object_count; obj_idx++) {
+        for (uint32_t grp_idx = 0; grp_idx < model->objects[obj_idx].group_count; grp_idx++) {
+            if (model->objects[obj_idx].groups[grp_idx].vertex_count > 0) {
+                groups[count++] = &model->objects[obj_idx].groups[grp_idx];
+            }
+        }
+    }
+    qsort(groups, group_count, sizeof(poc_mesh_group *), compare_group_material);
+
+    uint32_t vertex_base = 0;
+    uint32_t index_base = 0;
+    uint32_t submesh_count = 0;
+    uint32_t material_count = 0;
+    for (uint32_t i = 0; i < group_count; i++) {
+        const poc_mesh_group *group = groups[i];
+        memcpy(&vertices[vertex_base], group->vertices, group->vertex_count * sizeof(poc_vertex));
+        for (uint32_t j = 0; j < group->index_count; j++) {
+            indices[index_base + j] = group->indices[j] + vertex_base;
+        }
+
+        if (i == 0 || group->material_index != groups[i - 1]->material_index) {
+            uint32_t material_index = UINT32_MAX;
+            if (group->material_index != UINT32_MAX) {
+                material_index = material_count;
+                materials[material_count++] = model->materials[group->material_index];
+            }
+            submeshes[submesh_count++] = (poc_submesh){index_base, 0, material_index};
+        }
+        submeshes[submesh_count - 1].index_count += group->index_count;
+
+        vertex_base += group->vertex_count;
+        index_base += group->index_count;
+    }
+    free(groups);
+
+    poc_mesh_set_data(mesh, vertices, (uint32_t)vertex_total, indices, (uint32_t)index_total, true);
+    mesh->submeshes = submeshes;
+    mesh->submesh_count = submesh_count;
+    mesh->materials = materials;
+    mesh->material_count = material_count;
+
+    if (submeshes[0].material_index != UINT32_MAX) {
+        mesh->material = materials[submeshes[0].material_index];
+        mesh->has_material = true;
+    }
+    return true;
+}
+
+// Reorder for the post-transform cache, overdraw and vertex fetch, then
+// split into culling clusters; an order the optimizer was told to keep is
+// only cut into runs, not regrouped. Meshes that do not own their data
+// keep their order and are only cut into runs.
+static void optimize_imported(poc_mesh *mesh) {
+    poc_mesh_optimize_stats optimize_stats;
+    bool optimized = poc_mesh_get_optimize_on_load() && poc_mesh_optimize(mesh, &optimize_stats);
+    if (optimized) {
+        printf("✓ Optimized mesh in %.1f ms: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (%u clusters)\n",
+               optimize_stats.milliseconds,
+               optimize_stats.before.acmr, optimize_stats.after.acmr,
+               optimize_stats.before.atvr, optimize_stats.after.atvr,
+               optimize_stats.clusters);
+    }
+
+    if (poc_mesh_get_cluster_on_load() && poc_mesh_build_clusters(mesh, optimized)) {
+        printf("✓ Split mesh into %u culling clusters of up to %u triangles\n",
+               mesh->cluster_count, POC_MESH_CLUSTER_TRIANGLES);
+    }
+}
+
 poc_mesh* poc_mesh_load(const char *filename) {
     if (!filename) {
         return NULL;
     }
 
+    // GLB meshes are already binary and, when their layout allows it, read
+    // in place, so they are neither parsed as text nor cooked
+    if (poc_gltf_is_path(filename)) {
+        poc_mesh *imported = poc_gltf_load_mesh(filename);
+        if (imported) {
+            optimize_imported(imported);
+        }
+        return imported;
+    }
+
+    // A cooked file that still matches its sources skips parsing entirely
+    if (poc_mesh_cache_is_enabled()) {
+        poc_mesh *cooked = poc_mesh_cache_load(filename);
+        if (cooked) {
+            printf("✓ Loaded cooked mesh %s%s (%u vertices, %u indices)\n",
+                   filename, POC_MESH_CACHE_EXTENSION, cooked->vertex_count, cooked->index_count);
+            return cooked;
+        }
+    }
+
     poc_mesh *mesh = poc_mesh_create();
     if (!mesh) {
         return NULL;
@@ -43,66 +204,63 @@ poc_mesh* poc_mesh_load(const char *filename) {
         return NULL;
     }
 
-    // Find the first non-empty group in any object
-    poc_mesh_group *group = NULL;
-    for (uint32_t obj_idx = 0; obj_idx < model.object_count && !group; obj_idx++) {
+    // Report how much welding face corners into shared vertices saved
+    uint64_t welded_vertices = 0;
+    for (uint32_t obj_idx = 0; obj_idx < model.object_count; obj_idx++) {
         for (uint32_t grp_idx = 0; grp_idx < model.objects[obj_idx].group_count; grp_idx++) {
-            if (model.objects[obj_idx].groups[grp_idx].vertex_count > 0) {
-                group = &model.objects[obj_idx].groups[grp_idx];
-                break;
-            }
+            welded_vertices += model.objects[obj_idx].groups[grp_idx].vertex_count;
         }
     }
-
-    if (!group) {
-        printf("Warning: No geometry found in OBJ file\n");
-        poc_model_destroy(&model);
-        poc_mesh_destroy(mesh);
-        return NULL;
+    if (welded_vertices > 0) {
+        printf("✓ Welded %llu face corners into %llu vertices (%.1fx, %.1f KB saved)\n",
+               (unsigned long long)model.corner_count, (unsigned long long)welded_vertices,
+               (double)model.corner_count / (double)welded_vertices,
+               (double)(model.corner_count - welded_vertices) * sizeof(poc_vertex) / 1024.0);
     }
 
-    // Copy the vertex data since the model will be destroyed
-    size_t vertex_size = sizeof(poc_vertex) * group->vertex_count;
-    size_t index_size = sizeof(uint32_t) * group->index_count;
-
-    poc_vertex *vertex_copy = malloc(vertex_size);
-    uint32_t *index_copy = malloc(index_size);
-
-    if (!vertex_copy || (group->index_count > 0 && !index_copy)) {
-        free(vertex_copy);
-        free(index_copy);
+    if (!pack_model_groups(mesh, &model)) {
         poc_model_destroy(&model);
         poc_mesh_destroy(mesh);
         return NULL;
     }
 
-    memcpy(vertex_copy, group->vertices, vertex_size);
-    if (group->index_count > 0) {
-        memcpy(index_copy, group->indices, index_size);
-    }
-
-    // Set the geometry data (mesh takes ownership of copied data)
-    poc_mesh_set_data(mesh, vertex_copy, group->vertex_count,
-                     index_copy, group->index_count, true);
-
-    // Copy material data if the group has a material
-    if (group->material_index != UINT32_MAX && group->material_index < model.material_count) {
-        mesh->material = model.materials[group->material_index];
-        mesh->has_material = true;
-        printf("✓ Copied material '%s' for mesh\n", mesh->material.name);
+    if (mesh->submesh_count > 1) {
+        printf("✓ Packed %u materials into one mesh (%u vertices, %u indices)\n",
+               mesh->submesh_count, mesh->vertex_count, mesh->index_count);
+    } else if (mesh->has_material) {
+        printf("✓ Copied material '%s' for mesh\n", poc_string_get(mesh->material.name));
     } else {
-        mesh->has_material = false;
         printf("⚠ No material found for mesh group, using default\n");
     }
 
-    poc_model_destroy(&model);
+    optimize_imported(mesh);
 
     // Store the asset path for serialization/reference purposes
-    if (filename) {
-        strncpy(mesh->source_path, filename, POC_ASSET_PATH_MAX - 1);
-        mesh->source_path[POC_ASSET_PATH_MAX - 1] = '\0';
+    mesh->source_path = poc_string_intern(filename);
+    if (model.material_library_count > 0) {
+        mesh->dependencies = malloc(model.material_library_count * sizeof(poc_string_id));
+        if (mesh->dependencies) {
+            memcpy(mesh->dependencies, model.material_libraries, model.material_library_count * sizeof(poc_string_id));
+            mesh->dependency_count = model.material_library_count;
+        }
     }
 
+    // Cook after optimizing so later loads get the optimized order for free,
+    // then read from the cooked file so the page cache backs the data.
+    // Archived sources have no directory on disk to cook into.
+    if (poc_mesh_cache_is_enabled() && !poc_archive_find(filename, NULL, NULL)) {
+        if (!poc_mesh_cache_write(mesh, filename, model.material_libraries, model.material_library_count)) {
+            printf("⚠ Could not write cooked mesh %s%s\n", filename, POC_MESH_CACHE_EXTENSION);
+        } else if (poc_mesh_cache_map_geometry(mesh)) {
+            printf("✓ Mapped cooked mesh %s%s, freed %.1f KB of parsed data\n",
+                   filename, POC_MESH_CACHE_EXTENSION,
+                   (double)((uint64_t)mesh->vertex_count * sizeof(poc_vertex) +
+                            (uint64_t)mesh->index_count * sizeof(uint32_t)) / 1024.0);
+        }
+    }
+
+    poc_model_destroy(&model);
+
     return mesh;
 }
 
@@ -119,60 +277,136 @@ void poc_mesh_set_data(poc_mesh *mesh,
         free(mesh->vertices);
         free(mesh->indices);
     }
+    poc_file_map_close(&mesh->mapping);
+
+    // Submesh ranges described the previous index data
+    free(mesh->submeshes);
+    free(mesh->materials);
+    mesh->submeshes = NULL;
+    mesh->submesh_count = 0;
+    mesh->materials = NULL;
+    mesh->material_count = 0;
+    free(mesh->clusters);
+    mesh->clusters = NULL;
+    mesh->cluster_count = 0;
 
     mesh->vertices = vertices;
     mesh->vertex_count = vertex_count;
     mesh->indices = indices;
     mesh->index_count = index_count;
     mesh->owns_data = owns_data;
+    mesh->geometry_released = false;
 
     // Calculate bounds from the new data
     poc_mesh_calculate_bounds(mesh);
 }
 
-void poc_mesh_calculate_bounds(poc_mesh *mesh) {
-    if (!mesh || !mesh->vertices || mesh->vertex_count == 0) {
-        return;
+// Vertices sampled to estimate the center before the bounds pass
+#define BOUNDS_CENTER_SAMPLES 256
+
+// The radius must be measured from the AABB center, which is only known
+// after a full pass. Instead the center is estimated first from the box of
+// an evenly spaced sample, and one pass then finds the AABB with SIMD
+// min/max together with the farthest distance from the estimate. Positions
+// are loaded four floats at a time; the fourth lane (normal.x) is masked off.
+#if defined(POC_ARCH_X64)
+static float scan_bounds(const poc_vertex *vertices, uint32_t count, const vec3 estimate,
+                         vec3 out_min, vec3 out_max) {
+    const __m128 xyz_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const __m128 center = _mm_setr_ps(estimate[0], estimate[1], estimate[2], 0.0f);
+    __m128 box_min = _mm_and_ps(_mm_loadu_ps(vertices[0].position), xyz_mask);
+    __m128 box_max = box_min;
+    __m128 farthest = _mm_setzero_ps();
+
+    for (uint32_t i = 0; i < count; i++) {
+        __m128 p = _mm_and_ps(_mm_loadu_ps(vertices[i].position), xyz_mask);
+        box_min = _mm_min_ps(box_min, p);
+        box_max = _mm_max_ps(box_max, p);
+
+        __m128 d = _mm_sub_ps(p, center);
+        __m128 dd = _mm_mul_ps(d, d);
+        __m128 sum = _mm_add_ss(dd, _mm_shuffle_ps(dd, dd, _MM_SHUFFLE(1, 1, 1, 1)));
+        farthest = _mm_max_ss(farthest, _mm_add_ss(sum, _mm_shuffle_ps(dd, dd, _MM_SHUFFLE(2, 2, 2, 2))));
     }
 
-    // Initialize bounds
-    vec3 min_bounds = {FLT_MAX, FLT_MAX, FLT_MAX};
-    vec3 max_bounds = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
-
-    // Find min/max of all vertex positions
-    for (uint32_t i = 0; i < mesh->vertex_count; i++) {
-        const vec3 *pos = &mesh->vertices[i].position;
-
-        // Update min bounds
-        if ((*pos)[0] < min_bounds[0]) min_bounds[0] = (*pos)[0];
-        if ((*pos)[1] < min_bounds[1]) min_bounds[1] = (*pos)[1];
-        if ((*pos)[2] < min_bounds[2]) min_bounds[2] = (*pos)[2];
-
-        // Update max bounds
-        if ((*pos)[0] > max_bounds[0]) max_bounds[0] = (*pos)[0];
-        if ((*pos)[1] > max_bounds[1]) max_bounds[1] = (*pos)[1];
-        if ((*pos)[2] > max_bounds[2]) max_bounds[2] = (*pos)[2];
+    float values[4];
+    _mm_storeu_ps(values, box_min);
+    glm_vec3_copy(values, out_min);
+    _mm_storeu_ps(values, box_max);
+    glm_vec3_copy(values, out_max);
+    return sqrtf(_mm_cvtss_f32(farthest));
+}
+#elif defined(POC_ARCH_ARM64)
+static float scan_bounds(const poc_vertex *vertices, uint32_t count, const vec3 estimate,
+                         vec3 out_min, vec3 out_max) {
+    const float center_values[4] = {estimate[0], estimate[1], estimate[2], 0.0f};
+    const float32x4_t center = vld1q_f32(center_values);
+    float32x4_t box_min = vsetq_lane_f32(0.0f, vld1q_f32(vertices[0].position), 3);
+    float32x4_t box_max = box_min;
+    float farthest = 0.0f;
+
+    for (uint32_t i = 0; i < count; i++) {
+        float32x4_t p = vsetq_lane_f32(0.0f, vld1q_f32(vertices[i].position), 3);
+        box_min = vminq_f32(box_min, p);
+        box_max = vmaxq_f32(box_max, p);
+
+        float32x4_t d = vsubq_f32(p, center);
+        farthest = fmaxf(farthest, vaddvq_f32(vmulq_f32(d, d)));
     }
 
-    // Store bounds
-    glm_vec3_copy(min_bounds, mesh->local_aabb_min);
-    glm_vec3_copy(max_bounds, mesh->local_aabb_max);
+    float values[4];
+    vst1q_f32(values, box_min);
+    glm_vec3_copy(values, out_min);
+    vst1q_f32(values, box_max);
+    glm_vec3_copy(values, out_max);
+    return sqrtf(farthest);
+}
+#else
+static float scan_bounds(const poc_vertex *vertices, uint32_t count, const vec3 estimate,
+                         vec3 out_min, vec3 out_max) {
+    glm_vec3_copy((float *)vertices[0].position, out_min);
+    glm_vec3_copy((float *)vertices[0].position, out_max);
+    float farthest = 0.0f;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const float *p = vertices[i].position;
+        glm_vec3_minv(out_min, (float *)p, out_min);
+        glm_vec3_maxv(out_max, (float *)p, out_max);
+
+        vec3 d;
+        glm_vec3_sub((float *)p, (float *)estimate, d);
+        farthest = fmaxf(farthest, glm_vec3_norm2(d));
+    }
+    return sqrtf(farthest);
+}
+#endif
 
-    // Calculate center
-    glm_vec3_add(min_bounds, max_bounds, mesh->center);
-    glm_vec3_scale(mesh->center, 0.5f, mesh->center);
+void poc_mesh_calculate_bounds(poc_mesh *mesh) {
+    if (!mesh || !mesh->vertices || mesh->vertex_count == 0) {
+        return;
+    }
 
-    // Calculate bounding radius (distance from center to farthest vertex)
-    float max_distance_sq = 0.0f;
-    for (uint32_t i = 0; i < mesh->vertex_count; i++) {
-        vec3 diff;
-        glm_vec3_sub(mesh->vertices[i].position, mesh->center, diff);
-        float distance_sq = glm_vec3_norm2(diff);
-        if (distance_sq > max_distance_sq) {
-            max_distance_sq = distance_sq;
-        }
+    // Center of the sample's box; the last vertex is always included
+    uint32_t stride = mesh->vertex_count / BOUNDS_CENTER_SAMPLES + 1;
+    vec3 sample_min, sample_max;
+    glm_vec3_copy(mesh->vertices[mesh->vertex_count - 1].position, sample_min);
+    glm_vec3_copy(mesh->vertices[mesh->vertex_count - 1].position, sample_max);
+    for (uint32_t i = 0; i < mesh->vertex_count; i += stride) {
+        glm_vec3_minv(sample_min, mesh->vertices[i].position, sample_min);
+        glm_vec3_maxv(sample_max, mesh->vertices[i].position, sample_max);
     }
-    mesh->bounding_radius = sqrtf(max_distance_sq);
+    vec3 estimate;
+    glm_vec3_center(sample_min, sample_max, estimate);
+
+    float from_estimate = scan_bounds(mesh->vertices, mesh->vertex_count, estimate,
+                                      mesh->local_aabb_min, mesh->local_aabb_max);
+
+    // Both the sphere around the estimate, pushed out by the estimate's
+    // error, and the box's half diagonal enclose every vertex; keep the tighter
+    glm_vec3_center(mesh->local_aabb_min, mesh->local_aabb_max, mesh->center);
+    float shifted = glm_vec3_distance(estimate, mesh->center) + from_estimate;
+    float half_diagonal = 0.5f * glm_vec3_distance(mesh->local_aabb_min, mesh->local_aabb_max);
+    mesh->bounding_radius = fminf(shifted, half_diagonal);
 }
 
 void poc_mesh_destroy(poc_mesh *mesh) {
@@ -185,24 +419,128 @@ void poc_mesh_destroy(poc_mesh *mesh) {
         free(mesh->vertices);
         free(mesh->indices);
     }
+    poc_file_map_close(&mesh->mapping);
+    free(mesh->submeshes);
+    free(mesh->materials);
+    free(mesh->clusters);
+    free(mesh->dependencies);
 
     free(mesh);
 }
 
+void poc_mesh_swap_contents(poc_mesh *a, poc_mesh *b) {
+    if (!a || !b || a == b) {
+        return;
+    }
+
+    poc_mesh swapped = *a;
+    *a = *b;
+    *b = swapped;
+
+    // The slot belongs to the address, not the contents
+    uint32_t slot = a->asset_slot;
+    a->asset_slot = b->asset_slot;
+    b->asset_slot = slot;
+}
+
+bool poc_mesh_release_geometry(poc_mesh *mesh) {
+    if (!mesh || mesh->geometry_released || !mesh->mapping.data) {
+        return false;
+    }
+
+    poc_file_map_close(&mesh->mapping);
+    mesh->vertices = NULL;
+    mesh->indices = NULL;
+    mesh->geometry_released = true;
+    return true;
+}
+
+bool poc_mesh_restore_geometry(poc_mesh *mesh) {
+    if (!mesh) {
+        return false;
+    }
+    if (!mesh->geometry_released) {
+        return mesh->vertices != NULL;
+    }
+    if (poc_gltf_is_path(poc_mesh_get_source_path(mesh))) {
+        return poc_gltf_map_geometry(mesh);
+    }
+    return poc_mesh_cache_map_geometry(mesh);
+}
+
+uint64_t poc_mesh_get_resident_bytes(const poc_mesh *mesh) {
+    if (!mesh) {
+        return 0;
+    }
+
+    uint64_t bytes = (uint64_t)mesh->submesh_count * sizeof(poc_submesh) +
+                     (uint64_t)mesh->material_count * sizeof(poc_material) +
+                     (uint64_t)mesh->cluster_count * sizeof(poc_mesh_cluster);
+    if (mesh->mapping.data) {
+        bytes += poc_file_map_resident_bytes(&mesh->mapping);
+    } else if (mesh->owns_data && !mesh->geometry_released) {
+        bytes += (uint64_t)mesh->vertex_count * sizeof(poc_vertex) +
+                 (uint64_t)mesh->index_count * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+void poc_mesh_set_release_after_upload(bool enabled) {
+    atomic_store_explicit(&g_release_after_upload, enabled, memory_order_relaxed);
+}
+
+bool poc_mesh_get_release_after_upload(void) {
+    return atomic_load_explicit(&g_release_after_upload, memory_order_relaxed);
+}
+
+const char* poc_mesh_get_source_path(const poc_mesh *mesh) {
+    return mesh ? poc_string_get(mesh->source_path) : "";
+}
+
 uint32_t poc_mesh_get_triangle_count(const poc_mesh *mesh) {
     if (!mesh) {
         return 0;
     }
 
-    if (mesh->indices && mesh->index_count > 0) {
+    // Counts survive poc_mesh_release_geometry(), the arrays do not
+    if (mesh->index_count > 0) {
         return mesh->index_count / 3;
-    } else if (mesh->vertices && mesh->vertex_count > 0) {
-        return mesh->vertex_count / 3;
     }
-
-    return 0;
+    return mesh->vertex_count / 3;
 }
 
 bool poc_mesh_is_valid(const poc_mesh *mesh) {
-    return mesh && mesh->vertices && mesh->vertex_count > 0;
+    return mesh && (mesh->vertices || mesh->geometry_released) && mesh->vertex_count > 0;
+}
+
+uint32_t poc_mesh_get_submesh_count(const poc_mesh *mesh) {
+    if (!poc_mesh_is_valid(mesh)) {
+        return 0;
+    }
+    return mesh->submesh_count > 0 ? mesh->submesh_count : 1;
+}
+
+bool poc_mesh_get_submesh(const poc_mesh *mesh, uint32_t index,
+                          poc_submesh *out_range, const poc_material **out_material) {
+    if (!out_range || index >= poc_mesh_get_submesh_count(mesh)) {
+        return false;
+    }
+
+    const poc_material *material = NULL;
+    if (mesh->submesh_count > 0) {
+        *out_range = mesh->submeshes[index];
+        if (out_range->material_index < mesh->material_count) {
+            material = &mesh->materials[out_range->material_index];
+        }
+    } else {
+        out_range->index_offset = 0;
+        out_range->index_count = mesh->index_count > 0 ? mesh->index_count : mesh->vertex_count;
+        out_range->material_index = mesh->has_material ? 0 : UINT32_MAX;
+        material = mesh->has_material ? &mesh->material : NULL;
+    }
+
+    if (out_material) {
+        *out_material = material;
+    }
+    return true;
 }
@@ -13,11 +13,40 @@
 #include <stdbool.h>
 #include "poc_engine.h"
 #include "obj_loader.h"
+#include "file_map.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief A range of a mesh's index buffer drawn with one material
+ *
+ * Multi-material models keep every group in one shared vertex/index buffer;
+ * each material's triangles form one contiguous range.
+ */
+typedef struct {
+    uint32_t index_offset;      /**< First index of the range */
+    uint32_t index_count;       /**< Number of indices in the range */
+    uint32_t material_index;    /**< Index into the mesh's materials, UINT32_MAX for the default material */
+} poc_submesh;
+
+/**
+ * @brief A cluster of up to POC_MESH_CLUSTER_TRIANGLES neighbouring triangles
+ *
+ * Clusters are contiguous index ranges inside one submesh, so the clusters
+ * that survive culling can be drawn as runs of the shared index buffer. The
+ * bounding sphere and normal cone are in mesh local space.
+ */
+typedef struct {
+    uint32_t index_offset;      /**< First index of the cluster */
+    uint32_t index_count;       /**< Number of indices in the cluster */
+    vec3 center;                /**< Bounding sphere center */
+    float radius;               /**< Bounding sphere radius */
+    vec3 cone_axis;             /**< Average facing direction of the triangles */
+    float cone_cutoff;          /**< Sine of the cone's half angle; 1 if the cluster can never face away */
+} poc_mesh_cluster;
+
 /**
  * @brief Mesh data structure containing geometry and bounds
  *
@@ -40,14 +69,35 @@ typedef struct poc_mesh {
     float bounding_radius;      /**< Radius of bounding sphere from center */
 
     // Material data
-    poc_material material;      /**< Material properties for rendering */
+    poc_material material;      /**< Material of the first submesh (the whole mesh if it has one material) */
     bool has_material;          /**< Whether this mesh has valid material data */
 
+    // Submeshes; a mesh without any is drawn as one range with the material above
+    poc_submesh *submeshes;     /**< Index ranges with their materials (owned) */
+    uint32_t submesh_count;     /**< Number of submeshes */
+    poc_material *materials;    /**< Materials referenced by submeshes (owned) */
+    uint32_t material_count;    /**< Number of materials */
+
+    // Culling clusters in index order; none if the mesh was not clustered
+    poc_mesh_cluster *clusters; /**< Cluster ranges with their bounds (owned) */
+    uint32_t cluster_count;     /**< Number of clusters */
+
     // Resource management
     bool owns_data;             /**< Whether this mesh owns the vertex/index data */
+    bool geometry_released;     /**< Vertex/index data dropped after upload; counts and bounds remain */
+    poc_file_map mapping;       /**< Cooked file the vertex/index data points into, if any */
+    // Identity of the cooked file the data was mapped from, so restoring
+    // released geometry maps that same file and not a later re-cook
+    uint64_t cooked_hash;       /**< Source hash in the cooked header; 0 if never mapped from one */
+    uint64_t cooked_size;       /**< Size of the cooked file */
+    uint64_t cooked_device;     /**< Device of the cooked file; 0 when archived */
+    uint64_t cooked_inode;      /**< Inode of the cooked file; 0 when archived */
+    uint32_t asset_slot;        /**< Asset manager slot + 1, or 0 if the mesh is not managed */
 
     // Metadata
-    char source_path[POC_ASSET_PATH_MAX]; /**< Source asset path used to create mesh */
+    poc_string_id source_path;  /**< Interned source asset path used to create mesh */
+    poc_string_id *dependencies; /**< Interned paths of other files the mesh was built from, e.g. MTL libraries (owned) */
+    uint32_t dependency_count;  /**< Number of dependencies */
 } poc_mesh;
 
 /**
@@ -63,8 +113,13 @@ poc_mesh* poc_mesh_create(void);
  * @brief Load mesh from OBJ file
  *
  * Loads geometry data from an OBJ file and calculates bounding information.
+ * Every group of every object is packed into the mesh's single vertex and
+ * index array; groups sharing a material become one submesh.
+ *
+ * Paths naming a GLB file ("model.glb", "model.glb#2") are imported by
+ * poc_gltf_load_mesh() instead.
  *
- * @param filename Path to the OBJ file
+ * @param filename Path to the OBJ or GLB file
  * @return Pointer to loaded mesh, or NULL on failure
  */
 poc_mesh* poc_mesh_load(const char *filename);
@@ -74,6 +129,7 @@ poc_mesh* poc_mesh_load(const char *filename);
  *
  * Sets the vertex and index data for a mesh and calculates bounds.
  * The mesh will take ownership of the data if owns_data is true.
+ * Any submeshes are discarded, since they describe the old index data.
  *
  * @param mesh The mesh to modify
  * @param vertices Array of vertices
@@ -90,7 +146,9 @@ void poc_mesh_set_data(poc_mesh *mesh,
 /**
  * @brief Calculate bounding information from mesh vertices
  *
- * Recalculates the AABB, center, and bounding radius from the current vertex data.
+ * Recalculates the AABB, center, and bounding radius from the current vertex data
+ * in a single pass. The center is the AABB center; the radius encloses every
+ * vertex but can be a little larger than the tightest sphere around it.
  * This is called automatically when setting mesh data.
  *
  * @param mesh The mesh to calculate bounds for
@@ -101,11 +159,73 @@ void poc_mesh_calculate_bounds(poc_mesh *mesh);
  * @brief Destroy a mesh and free its resources
  *
  * Frees the mesh structure and optionally frees vertex/index data if owned.
+ * Data that points into a cooked file mapping is released by unmapping it.
  *
  * @param mesh The mesh to destroy
  */
 void poc_mesh_destroy(poc_mesh *mesh);
 
+/**
+ * @brief Exchange everything two meshes hold except their asset slots
+ *
+ * Used to replace a managed mesh with a freshly loaded version in place, so
+ * every pointer to it sees the new data. Not thread safe; nothing may read
+ * either mesh meanwhile.
+ *
+ * @param a First mesh
+ * @param b Second mesh
+ */
+void poc_mesh_swap_contents(poc_mesh *a, poc_mesh *b);
+
+/**
+ * @brief Drop a mesh's CPU vertex and index data, keeping counts and bounds
+ *
+ * Only meshes backed by a cooked file or GLB mapping can be released, since
+ * poc_mesh_restore_geometry() maps the file again when the data is needed.
+ * Submeshes, materials and bounds stay, which is everything culling and
+ * picking read. Not thread safe; call from the thread that renders.
+ *
+ * @param mesh The mesh
+ * @return true if the data was released
+ */
+bool poc_mesh_release_geometry(poc_mesh *mesh);
+
+/**
+ * @brief Make released vertex and index data available again
+ *
+ * @param mesh The mesh
+ * @return true if the mesh has vertex data (whether or not it was released)
+ */
+bool poc_mesh_restore_geometry(poc_mesh *mesh);
+
+/**
+ * @brief Get the CPU memory a mesh currently holds
+ *
+ * Heap-owned vertex and index data count in full. Mapped data counts only
+ * the pages that are resident, since the kernel can drop and re-read the
+ * rest; released data counts nothing. Submesh and material tables are
+ * always included.
+ *
+ * @param mesh The mesh
+ * @return Resident bytes
+ */
+uint64_t poc_mesh_get_resident_bytes(const poc_mesh *mesh);
+
+/**
+ * @brief Release mesh geometry as soon as a renderable has uploaded it
+ *
+ * Off by default. With it on, only bounds and submesh tables stay in CPU
+ * memory for meshes that came from (or were cooked into) a .pocmesh file.
+ *
+ * @param enabled Whether renderables release geometry after upload
+ */
+void poc_mesh_set_release_after_upload(bool enabled);
+
+/**
+ * @brief Check whether renderables release geometry after upload
+ */
+bool poc_mesh_get_release_after_upload(void);
+
 /**
  * @brief Get the number of triangles in the mesh
  *
@@ -117,11 +237,44 @@ uint32_t poc_mesh_get_triangle_count(const poc_mesh *mesh);
 /**
  * @brief Check if mesh has valid geometry data
  *
+ * A mesh whose geometry was released is still valid.
+ *
  * @param mesh The mesh to check
  * @return True if mesh has vertices, false otherwise
  */
 bool poc_mesh_is_valid(const poc_mesh *mesh);
 
+/**
+ * @brief Get the submesh ranges of a mesh
+ *
+ * A mesh without explicit submeshes reports one range covering all of its
+ * indices (or vertices, if it is not indexed) with the mesh material.
+ *
+ * @param mesh The mesh to query
+ * @param index Submesh index, less than poc_mesh_get_submesh_count()
+ * @param out_range Receives the range
+ * @param out_material Receives the range's material, or NULL for the default material
+ * @return true if @p index is valid
+ */
+bool poc_mesh_get_submesh(const poc_mesh *mesh, uint32_t index,
+                          poc_submesh *out_range, const poc_material **out_material);
+
+/**
+ * @brief Get the number of submesh ranges poc_mesh_get_submesh() reports
+ *
+ * @param mesh The mesh to query
+ * @return Number of ranges (at least 1 for a valid mesh)
+ */
+uint32_t poc_mesh_get_submesh_count(const poc_mesh *mesh);
+
+/**
+ * @brief Get the asset path a mesh was loaded from
+ *
+ * @param mesh The mesh
+ * @return Source path, or "" for meshes built in memory
+ */
+const char* poc_mesh_get_source_path(const poc_mesh *mesh);
+
 #ifdef __cplusplus
 }
 #endif
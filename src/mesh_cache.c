@@ -0,0 +1,788 @@
+#define _DEFAULT_SOURCE
+#include "mesh_cache.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static atomic_bool g_cache_enabled = true;
+
+// Distinguishes temporary files of cooks running at once in this process
+static atomic_uint g_cook_counter;
+
+/*
+ * File layout. Every section starts on a POCMESH_ALIGNMENT boundary; counts
+ * and offsets live in the header. Data is stored in native byte order,
+ * which the vertex stride check and the version guard against mixing up.
+ */
+
+#define POCMESH_MAGIC "POCMESH"
+#define POCMESH_ALIGNMENT 64
+
+// Dependency size marking a source that did not exist when cooking
+#define POCMESH_MISSING UINT64_MAX
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t vertex_stride;
+    uint64_t file_size;
+    uint64_t source_hash;           // Combined content hash of all dependencies
+    uint32_t vertex_count;
+    uint32_t index_count;
+    uint32_t submesh_count;
+    uint32_t material_count;
+    uint32_t lod_count;
+    uint32_t dependency_count;
+    uint32_t cluster_count;
+    uint32_t reserved;
+    float aabb_min[3];
+    float aabb_max[3];
+    float center[3];
+    float bounding_radius;
+    uint64_t vertex_offset;
+    uint64_t index_offset;
+    uint64_t submesh_offset;
+    uint64_t material_offset;
+    uint64_t lod_offset;
+    uint64_t cluster_offset;
+    uint64_t dependency_offset;
+    uint64_t string_offset;
+    uint64_t string_size;
+} pocmesh_header;
+
+typedef struct {
+    uint32_t index_offset;
+    uint32_t index_count;
+    uint32_t material_index;        // UINT32_MAX for the default material
+    uint32_t reserved;
+} pocmesh_submesh;
+
+typedef struct {
+    float ambient[3];
+    float diffuse[3];
+    float specular[3];
+    float shininess;
+    float opacity;
+    int32_t illum_model;
+    uint32_t name_offset;           // Into the string section
+    uint32_t name_length;
+} pocmesh_material;
+
+// A reduced-detail index range over the shared vertex array
+typedef struct {
+    uint32_t index_offset;
+    uint32_t index_count;
+    float screen_error;
+    uint32_t reserved;
+} pocmesh_lod;
+
+// A culling cluster: an index range with its bounding sphere and normal cone
+typedef struct {
+    uint32_t index_offset;
+    uint32_t index_count;
+    float center[3];
+    float radius;
+    float cone_axis[3];
+    float cone_cutoff;
+} pocmesh_cluster;
+
+typedef struct {
+    uint64_t size;                  // POCMESH_MISSING if absent at cook time
+    int64_t mtime_ns;
+    uint64_t hash;
+    uint32_t path_offset;           // Into the string section
+    uint32_t path_length;
+} pocmesh_dependency;
+
+/*
+ * Hashing (XXH64 with seed 0)
+ */
+
+#define HASH_P1 0x9E3779B185EBCA87ull
+#define HASH_P2 0xC2B2AE3D27D4EB4Full
+#define HASH_P3 0x165667B19E3779F9ull
+#define HASH_P4 0x85EBCA77C2B2AE63ull
+#define HASH_P5 0x27D4EB2F165667C5ull
+
+static uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static uint64_t read64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint32_t read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint64_t hash_round(uint64_t acc, uint64_t input) {
+    acc += input * HASH_P2;
+    acc = rotl64(acc, 31);
+    return acc * HASH_P1;
+}
+
+static uint64_t hash_merge(uint64_t acc, uint64_t lane) {
+    acc ^= hash_round(0, lane);
+    return acc * HASH_P1 + HASH_P4;
+}
+
+uint64_t poc_mesh_cache_hash(const void *data, size_t size) {
+    const uint8_t *p = data;
+    const uint8_t *end = p + size;
+    uint64_t h;
+
+    if (size >= 32) {
+        uint64_t v1 = HASH_P1 + HASH_P2;
+        uint64_t v2 = HASH_P2;
+        uint64_t v3 = 0;
+        uint64_t v4 = 0 - HASH_P1;
+        const uint8_t *limit = end - 32;
+        do {
+            v1 = hash_round(v1, read64(p));
+            v2 = hash_round(v2, read64(p + 8));
+            v3 = hash_round(v3, read64(p + 16));
+            v4 = hash_round(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = hash_merge(h, v1);
+        h = hash_merge(h, v2);
+        h = hash_merge(h, v3);
+        h = hash_merge(h, v4);
+    } else {
+        h = HASH_P5;
+    }
+    h += size;
+
+    for (; end - p >= 8; p += 8) {
+        h ^= hash_round(0, read64(p));
+        h = rotl64(h, 27) * HASH_P1 + HASH_P4;
+    }
+    if (end - p >= 4) {
+        h ^= (uint64_t)read32(p) * HASH_P1;
+        h = rotl64(h, 23) * HASH_P2 + HASH_P3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        h ^= (uint64_t)*p * HASH_P5;
+        h = rotl64(h, 11) * HASH_P1;
+    }
+
+    h ^= h >> 33;
+    h *= HASH_P2;
+    h ^= h >> 29;
+    h *= HASH_P3;
+    h ^= h >> 32;
+    return h;
+}
+
+/*
+ * Source tracking
+ */
+
+static int64_t mtime_ns(const struct stat *st) {
+#ifdef POC_PLATFORM_MACOS
+    return (int64_t)st->st_mtimespec.tv_sec * 1000000000 + st->st_mtimespec.tv_nsec;
+#else
+    return (int64_t)st->st_mtim.tv_sec * 1000000000 + st->st_mtim.tv_nsec;
+#endif
+}
+
+static bool hash_file(const char *path, uint64_t *hash) {
+    poc_file_map map;
+    if (!poc_file_map_open(path, &map)) {
+        return false;
+    }
+    poc_file_map_advise_sequential(&map);
+    *hash = poc_mesh_cache_hash(map.data, map.size);
+    poc_file_map_close(&map);
+    return true;
+}
+
+static bool describe_source(const char *path, pocmesh_dependency *dependency) {
+    memset(dependency, 0, sizeof(*dependency));
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        dependency->size = POCMESH_MISSING;
+        return true;
+    }
+    dependency->size = (uint64_t)st.st_size;
+    dependency->mtime_ns = mtime_ns(&st);
+    return hash_file(path, &dependency->hash);
+}
+
+// Returns whether a recorded source still has the same content. Sets
+// *touched if only its mtime changed, so the caller can refresh the record.
+static bool source_matches(const char *path, const pocmesh_dependency *dependency, int64_t *touched) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        return dependency->size == POCMESH_MISSING;
+    }
+    if (dependency->size == POCMESH_MISSING || (uint64_t)st.st_size != dependency->size) {
+        return false;
+    }
+    if (mtime_ns(&st) == dependency->mtime_ns) {
+        return true;
+    }
+
+    uint64_t hash;
+    if (!hash_file(path, &hash) || hash != dependency->hash) {
+        return false;
+    }
+    *touched = mtime_ns(&st);
+    return true;
+}
+
+static char *cache_path_for(const char *source_path) {
+    size_t length = strlen(source_path);
+    char *path = malloc(length + sizeof(POC_MESH_CACHE_EXTENSION));
+    if (!path) {
+        return NULL;
+    }
+    memcpy(path, source_path, length);
+    memcpy(path + length, POC_MESH_CACHE_EXTENSION, sizeof(POC_MESH_CACHE_EXTENSION));
+    return path;
+}
+
+/*
+ * Loading
+ */
+
+static bool section_fits(uint64_t offset, uint64_t count, uint64_t element_size, uint64_t file_size) {
+    if (offset % POCMESH_ALIGNMENT != 0 || offset > file_size) {
+        return false;
+    }
+    return count <= (file_size - offset) / element_size;
+}
+
+static bool header_valid(const pocmesh_header *header, size_t file_size) {
+    if (memcmp(header->magic, POCMESH_MAGIC, sizeof(POCMESH_MAGIC)) != 0 ||
+        header->version != POC_MESH_CACHE_VERSION ||
+        header->vertex_stride != sizeof(poc_vertex) ||
+        header->file_size != file_size) {
+        return false;
+    }
+    return section_fits(header->vertex_offset, header->vertex_count, sizeof(poc_vertex), file_size) &&
+           section_fits(header->index_offset, header->index_count, sizeof(uint32_t), file_size) &&
+           section_fits(header->submesh_offset, header->submesh_count, sizeof(pocmesh_submesh), file_size) &&
+           section_fits(header->material_offset, header->material_count, sizeof(pocmesh_material), file_size) &&
+           section_fits(header->lod_offset, header->lod_count, sizeof(pocmesh_lod), file_size) &&
+           section_fits(header->cluster_offset, header->cluster_count, sizeof(pocmesh_cluster), file_size) &&
+           section_fits(header->dependency_offset, header->dependency_count, sizeof(pocmesh_dependency), file_size) &&
+           section_fits(header->string_offset, header->string_size, 1, file_size);
+}
+
+static bool ranges_valid(const pocmesh_header *header, const char *base) {
+    const pocmesh_submesh *submeshes = (const pocmesh_submesh *)(base + header->submesh_offset);
+    for (uint32_t i = 0; i < header->submesh_count; i++) {
+        if (submeshes[i].index_offset > header->index_count ||
+            submeshes[i].index_count > header->index_count - submeshes[i].index_offset ||
+            (submeshes[i].material_index != UINT32_MAX && submeshes[i].material_index >= header->material_count)) {
+            return false;
+        }
+    }
+    const pocmesh_lod *lods = (const pocmesh_lod *)(base + header->lod_offset);
+    for (uint32_t i = 0; i < header->lod_count; i++) {
+        if (lods[i].index_offset > header->index_count ||
+            lods[i].index_count > header->index_count - lods[i].index_offset) {
+            return false;
+        }
+    }
+    const pocmesh_cluster *clusters = (const pocmesh_cluster *)(base + header->cluster_offset);
+    for (uint32_t i = 0; i < header->cluster_count; i++) {
+        if (clusters[i].index_offset > header->index_count ||
+            clusters[i].index_count > header->index_count - clusters[i].index_offset) {
+            return false;
+        }
+    }
+    const pocmesh_material *materials = (const pocmesh_material *)(base + header->material_offset);
+    for (uint32_t i = 0; i < header->material_count; i++) {
+        if (materials[i].name_offset > header->string_size ||
+            materials[i].name_length > header->string_size - materials[i].name_offset) {
+            return false;
+        }
+    }
+    const pocmesh_dependency *dependencies = (const pocmesh_dependency *)(base + header->dependency_offset);
+    for (uint32_t i = 0; i < header->dependency_count; i++) {
+        if (dependencies[i].path_offset > header->string_size ||
+            dependencies[i].path_length > header->string_size - dependencies[i].path_offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Check every recorded source; refresh records whose mtime moved but whose
+// content did not, so the next load skips hashing them
+static bool sources_valid(const char *cache_path, const pocmesh_header *header, const char *base) {
+    const pocmesh_dependency *dependencies = (const pocmesh_dependency *)(base + header->dependency_offset);
+    const char *strings = base + header->string_offset;
+
+    for (uint32_t i = 0; i < header->dependency_count; i++) {
+        char *path = malloc(dependencies[i].path_length + 1);
+        if (!path) {
+            return false;
+        }
+        memcpy(path, strings + dependencies[i].path_offset, dependencies[i].path_length);
+        path[dependencies[i].path_length] = '\0';
+
+        int64_t touched = 0;
+        bool matches = source_matches(path, &dependencies[i], &touched);
+        free(path);
+        if (!matches) {
+            return false;
+        }
+
+        if (touched != 0) {
+            int fd = open(cache_path, O_WRONLY);
+            if (fd >= 0) {
+                off_t offset = (off_t)(header->dependency_offset + i * sizeof(pocmesh_dependency) +
+                                       offsetof(pocmesh_dependency, mtime_ns));
+                if (pwrite(fd, &touched, sizeof(touched), offset) != (ssize_t)sizeof(touched)) {
+                    printf("⚠ Could not refresh source time in %s\n", cache_path);
+                }
+                close(fd);
+            }
+        }
+    }
+    return true;
+}
+
+static void decode_material(const pocmesh_material *source, const char *strings, poc_material *material) {
+    memcpy(material->ambient, source->ambient, sizeof(vec3));
+    memcpy(material->diffuse, source->diffuse, sizeof(vec3));
+    memcpy(material->specular, source->specular, sizeof(vec3));
+    material->shininess = source->shininess;
+    material->opacity = source->opacity;
+    material->illum_model = source->illum_model;
+    material->name = poc_string_intern_n(strings + source->name_offset, source->name_length);
+}
+
+// Submesh and material tables are small; copy them out of the mapping
+static bool load_submeshes(poc_mesh *mesh, const pocmesh_header *header, const char *base) {
+    const pocmesh_submesh *submeshes = (const pocmesh_submesh *)(base + header->submesh_offset);
+    const pocmesh_material *materials = (const pocmesh_material *)(base + header->material_offset);
+    const char *strings = base + header->string_offset;
+
+    if (header->submesh_count > 0) {
+        mesh->submeshes = malloc(header->submesh_count * sizeof(poc_submesh));
+        if (!mesh->submeshes) {
+            return false;
+        }
+        for (uint32_t i = 0; i < header->submesh_count; i++) {
+            mesh->submeshes[i] = (poc_submesh){
+                submeshes[i].index_offset, submeshes[i].index_count, submeshes[i].material_index
+            };
+        }
+        mesh->submesh_count = header->submesh_count;
+    }
+
+    if (header->material_count > 0) {
+        mesh->materials = malloc(header->material_count * sizeof(poc_material));
+        if (!mesh->materials) {
+            return false;
+        }
+        for (uint32_t i = 0; i < header->material_count; i++) {
+            decode_material(&materials[i], strings, &mesh->materials[i]);
+        }
+        mesh->material_count = header->material_count;
+    }
+
+    if (mesh->submesh_count > 0 && mesh->submeshes[0].material_index != UINT32_MAX) {
+        mesh->material = mesh->materials[mesh->submeshes[0].material_index];
+        mesh->has_material = true;
+    }
+    return true;
+}
+
+// Cluster bounds are read every frame by the culler; keep them off the mapping
+// so releasing geometry after upload does not drop them
+static bool load_clusters(poc_mesh *mesh, const pocmesh_header *header, const char *base) {
+    if (header->cluster_count == 0) {
+        return true;
+    }
+
+    const pocmesh_cluster *clusters = (const pocmesh_cluster *)(base + header->cluster_offset);
+    mesh->clusters = malloc(header->cluster_count * sizeof(poc_mesh_cluster));
+    if (!mesh->clusters) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->cluster_count; i++) {
+        poc_mesh_cluster *cluster = &mesh->clusters[i];
+        cluster->index_offset = clusters[i].index_offset;
+        cluster->index_count = clusters[i].index_count;
+        memcpy(cluster->center, clusters[i].center, sizeof(vec3));
+        cluster->radius = clusters[i].radius;
+        memcpy(cluster->cone_axis, clusters[i].cone_axis, sizeof(vec3));
+        cluster->cone_cutoff = clusters[i].cone_cutoff;
+    }
+    mesh->cluster_count = header->cluster_count;
+    return true;
+}
+
+// The source itself is the first record; the rest are what the mesh depends on
+static bool load_dependencies(poc_mesh *mesh, const pocmesh_header *header, const char *base) {
+    if (header->dependency_count < 2) {
+        return true;
+    }
+
+    const pocmesh_dependency *dependencies = (const pocmesh_dependency *)(base + header->dependency_offset);
+    const char *strings = base + header->string_offset;
+    mesh->dependencies = malloc((header->dependency_count - 1) * sizeof(poc_string_id));
+    if (!mesh->dependencies) {
+        return false;
+    }
+    for (uint32_t i = 1; i < header->dependency_count; i++) {
+        mesh->dependencies[i - 1] = poc_string_intern_n(strings + dependencies[i].path_offset, dependencies[i].path_length);
+    }
+    mesh->dependency_count = header->dependency_count - 1;
+    return true;
+}
+
+// Map the cooked file of a source; with check_sources, also check it is
+// still current
+static const pocmesh_header *open_cooked(const char *source_path, poc_file_map *map, bool check_sources) {
+    char *cache_path = cache_path_for(source_path);
+    if (!cache_path) {
+        return NULL;
+    }
+
+    if (!poc_file_map_open(cache_path, map)) {
+        free(cache_path);
+        return NULL;
+    }
+
+    // Archived cooked files were checked against their sources when packing
+    const pocmesh_header *header = (const pocmesh_header *)map->data;
+    if (map->size < sizeof(pocmesh_header) || !header_valid(header, map->size) ||
+        !ranges_valid(header, map->data) ||
+        (check_sources && !map->archived && !sources_valid(cache_path, header, map->data))) {
+        poc_file_map_close(map);
+        free(cache_path);
+        return NULL;
+    }
+    free(cache_path);
+    return header;
+}
+
+static void record_cooked(poc_mesh *mesh, const pocmesh_header *header, const poc_file_map *map) {
+    mesh->cooked_hash = header->source_hash;
+    mesh->cooked_size = map->size;
+    mesh->cooked_device = map->device;
+    mesh->cooked_inode = map->inode;
+}
+
+// Re-cooking renames a new file into place, so the inode tells a replaced
+// file apart even when its counts match. The mtime does not: loading the
+// same source elsewhere refreshes source times inside the file.
+static bool is_recorded_cooked(const poc_mesh *mesh, const pocmesh_header *header, const poc_file_map *map) {
+    return mesh->cooked_hash == header->source_hash && mesh->cooked_size == map->size &&
+           mesh->cooked_device == map->device && mesh->cooked_inode == map->inode;
+}
+
+bool poc_mesh_cache_is_current(const char *source_path) {
+    if (!source_path) {
+        return false;
+    }
+
+    poc_file_map map;
+    if (!open_cooked(source_path, &map, true)) {
+        return false;
+    }
+    poc_file_map_close(&map);
+    return true;
+}
+
+poc_mesh* poc_mesh_cache_load(const char *source_path) {
+    if (!source_path) {
+        return NULL;
+    }
+
+    poc_file_map map;
+    const pocmesh_header *header = open_cooked(source_path, &map, true);
+    if (!header) {
+        return NULL;
+    }
+
+    poc_mesh *mesh = poc_mesh_create();
+    if (!mesh) {
+        poc_file_map_close(&map);
+        return NULL;
+    }
+
+    // The mapping is read-only; the mesh borrows from it instead of owning
+    mesh->vertices = (poc_vertex *)(map.data + header->vertex_offset);
+    mesh->vertex_count = header->vertex_count;
+    mesh->indices = header->index_count > 0 ? (uint32_t *)(map.data + header->index_offset) : NULL;
+    mesh->index_count = header->index_count;
+    mesh->owns_data = false;
+
+    // Bounds were computed at cook time; recomputing would fault in every vertex page
+    memcpy(mesh->local_aabb_min, header->aabb_min, sizeof(vec3));
+    memcpy(mesh->local_aabb_max, header->aabb_max, sizeof(vec3));
+    memcpy(mesh->center, header->center, sizeof(vec3));
+    mesh->bounding_radius = header->bounding_radius;
+
+    if (!load_submeshes(mesh, header, map.data) || !load_clusters(mesh, header, map.data) ||
+        !load_dependencies(mesh, header, map.data)) {
+        poc_mesh_destroy(mesh);
+        poc_file_map_close(&map);
+        return NULL;
+    }
+
+    record_cooked(mesh, header, &map);
+    mesh->mapping = map;
+    mesh->source_path = poc_string_intern(source_path);
+    return mesh;
+}
+
+bool poc_mesh_cache_map_geometry(poc_mesh *mesh) {
+    const char *source_path = poc_mesh_get_source_path(mesh);
+    if (!mesh || !source_path[0]) {
+        return false;
+    }
+
+    // Geometry mapped before must come back from that same file, whatever
+    // the sources look like now; anything else may not fit the submesh and
+    // cluster tables. A first mapping needs a file current with the sources.
+    bool recorded = mesh->cooked_size != 0;
+    poc_file_map map;
+    const pocmesh_header *header = open_cooked(source_path, &map, !recorded);
+    if (!header) {
+        return false;
+    }
+
+    if (recorded && !is_recorded_cooked(mesh, header, &map)) {
+        printf("⚠ Cooked mesh %s%s was replaced since it was loaded; reload the mesh to use it\n",
+               source_path, POC_MESH_CACHE_EXTENSION);
+        poc_file_map_close(&map);
+        return false;
+    }
+
+    // Submesh ranges index into the data; a file cooked from edited sources does not fit them
+    if (header->vertex_count != mesh->vertex_count || header->index_count != mesh->index_count) {
+        poc_file_map_close(&map);
+        return false;
+    }
+
+    if (mesh->owns_data) {
+        free(mesh->vertices);
+        free(mesh->indices);
+    }
+    poc_file_map_close(&mesh->mapping);
+
+    mesh->vertices = (poc_vertex *)(map.data + header->vertex_offset);
+    mesh->indices = header->index_count > 0 ? (uint32_t *)(map.data + header->index_offset) : NULL;
+    mesh->owns_data = false;
+    mesh->geometry_released = false;
+    record_cooked(mesh, header, &map);
+    mesh->mapping = map;
+    return true;
+}
+
+/*
+ * Writing
+ */
+
+static uint64_t align_offset(uint64_t offset) {
+    return (offset + POCMESH_ALIGNMENT - 1) & ~(uint64_t)(POCMESH_ALIGNMENT - 1);
+}
+
+static bool write_section(FILE *file, uint64_t offset, const void *data, size_t size) {
+    static const char padding[POCMESH_ALIGNMENT];
+    long position = ftell(file);
+    if (position < 0 || (uint64_t)position > offset) {
+        return false;
+    }
+    if (offset > (uint64_t)position && fwrite(padding, 1, offset - (uint64_t)position, file) != offset - (uint64_t)position) {
+        return false;
+    }
+    return size == 0 || fwrite(data, 1, size, file) == size;
+}
+
+// Appends a string to the string section and returns its offset
+static uint32_t add_string(char *strings, uint32_t *string_size, const char *text, uint32_t length) {
+    uint32_t offset = *string_size;
+    memcpy(strings + offset, text, length);
+    *string_size += length;
+    return offset;
+}
+
+static bool write_cooked_file(const char *path, pocmesh_header *header, const poc_mesh *mesh,
+                              const pocmesh_submesh *submeshes, const pocmesh_material *materials,
+                              const pocmesh_cluster *clusters, const pocmesh_dependency *dependencies,
+                              const char *strings) {
+    // Exclusive create: never write into a temporary file another cook owns
+    FILE *file = fopen(path, "wbx");
+    if (!file) {
+        return false;
+    }
+
+    bool ok = write_section(file, 0, header, sizeof(*header)) &&
+              write_section(file, header->vertex_offset, mesh->vertices, header->vertex_count * sizeof(poc_vertex)) &&
+              write_section(file, header->index_offset, mesh->indices, header->index_count * sizeof(uint32_t)) &&
+              write_section(file, header->submesh_offset, submeshes, header->submesh_count * sizeof(pocmesh_submesh)) &&
+              write_section(file, header->material_offset, materials, header->material_count * sizeof(pocmesh_material)) &&
+              write_section(file, header->lod_offset, NULL, 0) &&
+              write_section(file, header->cluster_offset, clusters, header->cluster_count * sizeof(pocmesh_cluster)) &&
+              write_section(file, header->dependency_offset, dependencies, header->dependency_count * sizeof(pocmesh_dependency)) &&
+              write_section(file, header->string_offset, strings, header->string_size);
+
+    ok = !ferror(file) && ok;
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        unlink(path);
+    }
+    return ok;
+}
+
+bool poc_mesh_cache_write(const poc_mesh *mesh, const char *source_path,
+                          const poc_string_id *dependencies, uint32_t dependency_count) {
+    if (!mesh || !mesh->vertices || mesh->vertex_count == 0 || !source_path) {
+        return false;
+    }
+
+    // The source itself is always the first dependency
+    uint32_t total_dependencies = dependency_count + 1;
+    const char **paths = malloc(total_dependencies * sizeof(const char *));
+    pocmesh_dependency *records = calloc(total_dependencies, sizeof(pocmesh_dependency));
+    if (!paths || !records) {
+        free(paths);
+        free(records);
+        return false;
+    }
+    paths[0] = source_path;
+    for (uint32_t i = 0; i < dependency_count; i++) {
+        paths[i + 1] = poc_string_get(dependencies[i]);
+    }
+
+    uint64_t string_capacity = 0;
+    for (uint32_t i = 0; i < total_dependencies; i++) {
+        string_capacity += strlen(paths[i]);
+    }
+
+    // A mesh without explicit submeshes is stored as one range with its material
+    uint32_t submesh_count = poc_mesh_get_submesh_count(mesh);
+    const poc_material *materials = mesh->submesh_count > 0 ? mesh->materials : &mesh->material;
+    uint32_t material_count = mesh->submesh_count > 0 ? mesh->material_count : (mesh->has_material ? 1 : 0);
+    for (uint32_t i = 0; i < material_count; i++) {
+        string_capacity += strlen(poc_string_get(materials[i].name));
+    }
+
+    pocmesh_submesh *submeshes = calloc(submesh_count, sizeof(pocmesh_submesh));
+    pocmesh_material *material_records = calloc(material_count > 0 ? material_count : 1, sizeof(pocmesh_material));
+    pocmesh_cluster *clusters = calloc(mesh->cluster_count > 0 ? mesh->cluster_count : 1, sizeof(pocmesh_cluster));
+    char *strings = string_capacity <= UINT32_MAX ? malloc(string_capacity + 1) : NULL;
+    bool ok = submeshes && material_records && clusters && strings;
+    uint32_t string_size = 0;
+    uint64_t source_hash = 0;
+    for (uint32_t i = 0; ok && i < total_dependencies; i++) {
+        ok = describe_source(paths[i], &records[i]);
+        records[i].path_length = (uint32_t)strlen(paths[i]);
+        records[i].path_offset = ok ? add_string(strings, &string_size, paths[i], records[i].path_length) : 0;
+        source_hash = source_hash * HASH_P1 + records[i].hash;
+    }
+
+    for (uint32_t i = 0; ok && i < submesh_count; i++) {
+        poc_submesh range;
+        poc_mesh_get_submesh(mesh, i, &range, NULL);
+        submeshes[i].index_offset = range.index_offset;
+        submeshes[i].index_count = range.index_count;
+        submeshes[i].material_index = range.material_index;
+    }
+    for (uint32_t i = 0; ok && i < mesh->cluster_count; i++) {
+        const poc_mesh_cluster *source = &mesh->clusters[i];
+        clusters[i].index_offset = source->index_offset;
+        clusters[i].index_count = source->index_count;
+        memcpy(clusters[i].center, source->center, sizeof(vec3));
+        clusters[i].radius = source->radius;
+        memcpy(clusters[i].cone_axis, source->cone_axis, sizeof(vec3));
+        clusters[i].cone_cutoff = source->cone_cutoff;
+    }
+    for (uint32_t i = 0; ok && i < material_count; i++) {
+        const poc_material *source = &materials[i];
+        pocmesh_material *record = &material_records[i];
+        memcpy(record->ambient, source->ambient, sizeof(vec3));
+        memcpy(record->diffuse, source->diffuse, sizeof(vec3));
+        memcpy(record->specular, source->specular, sizeof(vec3));
+        record->shininess = source->shininess;
+        record->opacity = source->opacity;
+        record->illum_model = source->illum_model;
+        const char *name = poc_string_get(source->name);
+        record->name_length = (uint32_t)strlen(name);
+        record->name_offset = add_string(strings, &string_size, name, record->name_length);
+    }
+
+    pocmesh_header header = {
+        .magic = POCMESH_MAGIC,
+        .version = POC_MESH_CACHE_VERSION,
+        .vertex_stride = sizeof(poc_vertex),
+        .source_hash = source_hash,
+        .vertex_count = mesh->vertex_count,
+        .index_count = mesh->index_count,
+        .submesh_count = submesh_count,
+        .material_count = material_count,
+        .lod_count = 0,
+        .dependency_count = total_dependencies,
+        .cluster_count = mesh->cluster_count,
+        .bounding_radius = mesh->bounding_radius,
+        .string_size = string_size,
+    };
+    memcpy(header.aabb_min, mesh->local_aabb_min, sizeof(vec3));
+    memcpy(header.aabb_max, mesh->local_aabb_max, sizeof(vec3));
+    memcpy(header.center, mesh->center, sizeof(vec3));
+
+    header.vertex_offset = align_offset(sizeof(header));
+    header.index_offset = align_offset(header.vertex_offset + (uint64_t)header.vertex_count * sizeof(poc_vertex));
+    header.submesh_offset = align_offset(header.index_offset + (uint64_t)header.index_count * sizeof(uint32_t));
+    header.material_offset = align_offset(header.submesh_offset + header.submesh_count * sizeof(pocmesh_submesh));
+    header.lod_offset = align_offset(header.material_offset + header.material_count * sizeof(pocmesh_material));
+    header.cluster_offset = align_offset(header.lod_offset + header.lod_count * sizeof(pocmesh_lod));
+    header.dependency_offset = align_offset(header.cluster_offset + (uint64_t)header.cluster_count * sizeof(pocmesh_cluster));
+    header.string_offset = align_offset(header.dependency_offset + header.dependency_count * sizeof(pocmesh_dependency));
+    header.file_size = header.string_offset + header.string_size;
+
+    // Write under a name private to this process and call, then rename, so
+    // readers see old or new but never partial, even when several threads
+    // cook the same file at once
+    char *cache_path = ok ? cache_path_for(source_path) : NULL;
+    char *temp_path = cache_path ? malloc(strlen(cache_path) + 48) : NULL;
+    ok = temp_path != NULL;
+    if (ok) {
+        unsigned int cook = atomic_fetch_add_explicit(&g_cook_counter, 1, memory_order_relaxed);
+        snprintf(temp_path, strlen(cache_path) + 48, "%s.%ld.%u.tmp", cache_path, (long)getpid(), cook);
+        ok = write_cooked_file(temp_path, &header, mesh, submeshes, material_records, clusters, records, strings);
+        if (ok && rename(temp_path, cache_path) != 0) {
+            unlink(temp_path);
+            ok = false;
+        }
+    }
+
+    free(temp_path);
+    free(cache_path);
+    free(strings);
+    free(clusters);
+    free(material_records);
+    free(submeshes);
+    free(records);
+    free(paths);
+    return ok;
+}
+
+void poc_mesh_cache_set_enabled(bool enabled) {
+    atomic_store_explicit(&g_cache_enabled, enabled, memory_order_relaxed);
+}
+
+bool poc_mesh_cache_is_enabled(void) {
+    return atomic_load_explicit(&g_cache_enabled, memory_order_relaxed);
+}
@@ -0,0 +1,127 @@
+/**
+ * @file mesh_cache.h
+ * @brief Cooked binary mesh cache (.pocmesh)
+ *
+ * Parsing OBJ text is by far the most expensive part of loading a mesh, so
+ * poc_mesh_load() cooks every mesh it parses into a binary file next to the
+ * source (`model.obj` -> `model.obj.pocmesh`) and loads that on later runs.
+ *
+ * A cooked file holds the optimized vertex and index arrays, bounds,
+ * materials, submesh ranges, culling clusters and optional LOD index ranges. Sections are
+ * 64-byte aligned so the loader maps the file and points the mesh straight
+ * into the mapping (owns_data is false): nothing is parsed or copied, and
+ * pages fault in only when the renderer reads them.
+ *
+ * The file records every source it was built from (the OBJ and its MTL
+ * libraries) with size, modification time and a 64-bit content hash. A
+ * cooked file is used only if each source still matches: size and mtime
+ * are checked first, and a source whose mtime changed (a fresh checkout,
+ * a touch) is hashed and accepted if its content is unchanged. Files
+ * written by a different format version or vertex layout are ignored and
+ * re-cooked.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mesh.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bump whenever the cooked layout or the import pipeline changes output.
+ *
+ * History:
+ *   1  First layout: one mesh, no submesh ranges. The packed submesh and
+ *      material tables were added later without a bump, so a version 1
+ *      file can hold either layout, and a loader built in between could
+ *      misread an older file. That stale-cache window is accepted as
+ *      closed: every later loader rejects version 1 outright.
+ *   2  Culling cluster tables.
+ *   3  Soft cluster boundaries no longer see the hard pass's cache state,
+ *      which changes the optimized triangle order.
+ */
+#define POC_MESH_CACHE_VERSION 3
+
+/** Suffix appended to the source path to name its cooked file */
+#define POC_MESH_CACHE_EXTENSION ".pocmesh"
+
+/**
+ * @brief Load the cooked version of a source asset
+ *
+ * @param source_path Path of the source asset (e.g. an OBJ file)
+ * @return Mesh backed by the cooked file mapping, or NULL if there is no
+ *         valid cooked file for the current source contents
+ */
+poc_mesh* poc_mesh_cache_load(const char *source_path);
+
+/**
+ * @brief Check whether a source asset has a cooked file matching its contents
+ *
+ * @param source_path Path of the source asset
+ * @return true if poc_mesh_cache_load() would use the cooked file
+ */
+bool poc_mesh_cache_is_current(const char *source_path);
+
+/**
+ * @brief Point a mesh's vertex and index data into its cooked file
+ *
+ * Replaces heap-owned or released geometry with the mapping of the cooked
+ * file for the mesh's source path. Fails, leaving the mesh untouched, if
+ * there is no current cooked file or its vertex and index counts differ.
+ * A mesh that was mapped before only maps that same file again, without
+ * looking at the sources; if it was replaced since, this fails.
+ *
+ * @param mesh Mesh loaded from a source asset
+ * @return true if the mesh now reads from the mapping
+ */
+bool poc_mesh_cache_map_geometry(poc_mesh *mesh);
+
+/**
+ * @brief Write a cooked file for a mesh loaded from source
+ *
+ * The file is written under a temporary name and renamed into place, so a
+ * concurrent reader never sees a partial file. Failure (e.g. a read-only
+ * asset directory) is not an error for the caller; the mesh is simply
+ * parsed again next time.
+ *
+ * @param mesh Mesh to cook
+ * @param source_path Path of the source asset the mesh was loaded from
+ * @param dependencies Additional source files the mesh depends on (MTL libraries)
+ * @param dependency_count Number of entries in @p dependencies
+ * @return true if the cooked file was written
+ */
+bool poc_mesh_cache_write(const poc_mesh *mesh, const char *source_path,
+                          const poc_string_id *dependencies, uint32_t dependency_count);
+
+/**
+ * @brief Enable or disable the cooked cache in poc_mesh_load()
+ *
+ * On by default. Tools that measure parsing switch it off.
+ *
+ * @param enabled Whether poc_mesh_load() reads and writes cooked files
+ */
+void poc_mesh_cache_set_enabled(bool enabled);
+
+/**
+ * @brief Check whether poc_mesh_load() uses the cooked cache
+ */
+bool poc_mesh_cache_is_enabled(void);
+
+/**
+ * @brief Hash a block of memory
+ *
+ * 64-bit, four independent lanes, several GB/s; not cryptographic.
+ *
+ * @param data Bytes to hash (may be NULL if size is 0)
+ * @param size Number of bytes
+ * @return Hash value
+ */
+uint64_t poc_mesh_cache_hash(const void *data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
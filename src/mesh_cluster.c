@@ -0,0 +1,305 @@
+#include "mesh_cluster.h"
+#include "mesh_optimize.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <math.h>
+
+static atomic_bool g_cluster_on_load = true;
+
+/*
+ * Building
+ */
+
+typedef struct {
+    const uint32_t *indices;
+    uint32_t *offsets;    // vertex -> first entry in triangles (vertex_count + 1)
+    uint32_t *triangles;  // triangles using each vertex
+    bool *emitted;        // per triangle
+    uint32_t *queue;      // vertices of the growing cluster, in the order they joined
+    uint32_t *destination;
+    uint32_t written;     // triangles written to destination
+} cluster_state;
+
+typedef struct {
+    poc_mesh_cluster *items;
+    uint32_t count;
+    uint32_t capacity;
+} cluster_list;
+
+static bool push_cluster(cluster_list *list, uint32_t index_offset, uint32_t index_count) {
+    if (list->count == list->capacity) {
+        uint32_t capacity = list->capacity > 0 ? list->capacity * 2 : 64;
+        poc_mesh_cluster *items = realloc(list->items, capacity * sizeof(poc_mesh_cluster));
+        if (!items) {
+            return false;
+        }
+        list->items = items;
+        list->capacity = capacity;
+    }
+    list->items[list->count++] = (poc_mesh_cluster){.index_offset = index_offset, .index_count = index_count};
+    return true;
+}
+
+static void build_adjacency(cluster_state *state, uint32_t index_count, uint32_t vertex_count) {
+    for (uint32_t i = 0; i < index_count; i++) {
+        state->offsets[state->indices[i] + 1]++;
+    }
+    for (uint32_t v = 0; v < vertex_count; v++) {
+        state->offsets[v + 1] += state->offsets[v];
+    }
+
+    // Fill each slice from its end; afterwards offsets[v + 1] holds the
+    // start of v, so shift down by one
+    for (uint32_t i = index_count; i-- > 0;) {
+        uint32_t v = state->indices[i];
+        state->triangles[--state->offsets[v + 1]] = i / 3;
+    }
+    for (uint32_t v = 0; v < vertex_count; v++) {
+        state->offsets[v] = state->offsets[v + 1];
+    }
+    state->offsets[vertex_count] = index_count;
+}
+
+static uint32_t emit_triangle(cluster_state *state, uint32_t triangle, uint32_t queued) {
+    state->emitted[triangle] = true;
+    for (uint32_t k = 0; k < 3; k++) {
+        uint32_t v = state->indices[triangle * 3 + k];
+        state->destination[state->written * 3 + k] = v;
+        state->queue[queued++] = v;
+    }
+    state->written++;
+    return queued;
+}
+
+// Grow clusters breadth-first through shared vertices. When a patch runs
+// out of neighbours before it is full, the next triangle in the existing
+// order continues it, so meshes with split vertices still fill clusters.
+static bool cluster_range(cluster_state *state, uint32_t first, uint32_t end, cluster_list *list) {
+    uint32_t seed = first;
+    while (seed < end) {
+        uint32_t cluster_begin = state->written;
+        uint32_t queued = 0;
+        uint32_t visited = 0;
+        while (state->written - cluster_begin < POC_MESH_CLUSTER_TRIANGLES) {
+            if (visited == queued) {
+                while (seed < end && state->emitted[seed]) {
+                    seed++;
+                }
+                if (seed == end) {
+                    break;
+                }
+                queued = emit_triangle(state, seed, queued);
+                continue;
+            }
+
+            uint32_t v = state->queue[visited++];
+            for (uint32_t i = state->offsets[v]; i < state->offsets[v + 1] &&
+                 state->written - cluster_begin < POC_MESH_CLUSTER_TRIANGLES; i++) {
+                uint32_t triangle = state->triangles[i];
+                if (triangle >= first && triangle < end && !state->emitted[triangle]) {
+                    queued = emit_triangle(state, triangle, queued);
+                }
+            }
+        }
+
+        if (state->written > cluster_begin &&
+            !push_cluster(list, cluster_begin * 3, (state->written - cluster_begin) * 3)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool reorder_into_clusters(poc_mesh *mesh, cluster_list *list) {
+    uint32_t triangle_count = mesh->index_count / 3;
+    cluster_state state = {
+        .indices = mesh->indices,
+        .offsets = calloc((size_t)mesh->vertex_count + 1, sizeof(uint32_t)),
+        .triangles = malloc((size_t)mesh->index_count * sizeof(uint32_t)),
+        .emitted = calloc(triangle_count, sizeof(bool)),
+        .queue = malloc(POC_MESH_CLUSTER_TRIANGLES * 3 * sizeof(uint32_t)),
+        .destination = malloc((size_t)mesh->index_count * sizeof(uint32_t)),
+    };
+
+    bool ok = state.offsets && state.triangles && state.emitted && state.queue && state.destination;
+    if (ok) {
+        build_adjacency(&state, mesh->index_count, mesh->vertex_count);
+    }
+
+    // Clusters never cross a submesh, so every range stays contiguous
+    uint32_t range_count = poc_mesh_get_submesh_count(mesh);
+    for (uint32_t i = 0; ok && i < range_count; i++) {
+        poc_submesh range;
+        poc_mesh_get_submesh(mesh, i, &range, NULL);
+        state.written = range.index_offset / 3;
+        ok = cluster_range(&state, range.index_offset / 3, (range.index_offset + range.index_count) / 3, list);
+    }
+
+    // Triangles outside every submesh keep their place
+    for (uint32_t t = 0; ok && t < triangle_count; t++) {
+        if (!state.emitted[t]) {
+            memcpy(&state.destination[t * 3], &mesh->indices[t * 3], 3 * sizeof(uint32_t));
+        }
+    }
+    if (ok) {
+        memcpy(mesh->indices, state.destination, (size_t)mesh->index_count * sizeof(uint32_t));
+    }
+
+    free(state.destination);
+    free(state.queue);
+    free(state.emitted);
+    free(state.triangles);
+    free(state.offsets);
+    return ok;
+}
+
+static bool split_into_clusters(const poc_mesh *mesh, cluster_list *list) {
+    uint32_t range_count = poc_mesh_get_submesh_count(mesh);
+    for (uint32_t i = 0; i < range_count; i++) {
+        poc_submesh range;
+        poc_mesh_get_submesh(mesh, i, &range, NULL);
+        uint32_t end = range.index_offset + range.index_count;
+        for (uint32_t offset = range.index_offset; offset < end; offset += POC_MESH_CLUSTER_TRIANGLES * 3) {
+            uint32_t count = end - offset < POC_MESH_CLUSTER_TRIANGLES * 3 ? end - offset : POC_MESH_CLUSTER_TRIANGLES * 3;
+            if (!push_cluster(list, offset, count)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Sphere around the cluster's box center, and the cone of its face normals
+static void compute_cluster_bounds(const poc_mesh *mesh, poc_mesh_cluster *cluster) {
+    const uint32_t *indices = mesh->indices + cluster->index_offset;
+    vec3 box_min, box_max;
+    glm_vec3_copy(mesh->vertices[indices[0]].position, box_min);
+    glm_vec3_copy(mesh->vertices[indices[0]].position, box_max);
+    for (uint32_t i = 1; i < cluster->index_count; i++) {
+        glm_vec3_minv(box_min, mesh->vertices[indices[i]].position, box_min);
+        glm_vec3_maxv(box_max, mesh->vertices[indices[i]].position, box_max);
+    }
+    glm_vec3_center(box_min, box_max, cluster->center);
+
+    float radius_sq = 0.0f;
+    for (uint32_t i = 0; i < cluster->index_count; i++) {
+        float distance_sq = glm_vec3_distance2(cluster->center, mesh->vertices[indices[i]].position);
+        if (distance_sq > radius_sq) {
+            radius_sq = distance_sq;
+        }
+    }
+    cluster->radius = sqrtf(radius_sq);
+
+    // Unit normals, so small triangles count as much as large ones when
+    // deciding whether the whole cluster can face away
+    vec3 normals[POC_MESH_CLUSTER_TRIANGLES];
+    uint32_t normal_count = 0;
+    vec3 axis = GLM_VEC3_ZERO_INIT;
+    for (uint32_t i = 0; i + 2 < cluster->index_count; i += 3) {
+        vec3 edge1, edge2, normal;
+        glm_vec3_sub(mesh->vertices[indices[i + 1]].position, mesh->vertices[indices[i]].position, edge1);
+        glm_vec3_sub(mesh->vertices[indices[i + 2]].position, mesh->vertices[indices[i]].position, edge2);
+        glm_vec3_cross(edge1, edge2, normal);
+        float length = glm_vec3_norm(normal);
+        if (length <= 0.0f || normal_count == POC_MESH_CLUSTER_TRIANGLES) {
+            continue;
+        }
+        glm_vec3_scale(normal, 1.0f / length, normals[normal_count]);
+        glm_vec3_add(axis, normals[normal_count], axis);
+        normal_count++;
+    }
+
+    float axis_length = glm_vec3_norm(axis);
+    float min_dot = -1.0f;
+    if (axis_length > 0.0f) {
+        glm_vec3_scale(axis, 1.0f / axis_length, axis);
+        min_dot = 1.0f;
+        for (uint32_t i = 0; i < normal_count; i++) {
+            min_dot = fminf(min_dot, glm_vec3_dot(axis, normals[i]));
+        }
+    }
+    glm_vec3_copy(axis, cluster->cone_axis);
+
+    // The cluster faces away from any viewer within 90 degrees minus the
+    // spread of the cone; past a hemisphere of spread that never happens
+    cluster->cone_cutoff = min_dot > 0.0f ? sqrtf(1.0f - min_dot * min_dot) : 1.0f;
+}
+
+bool poc_mesh_build_clusters(poc_mesh *mesh, bool reorder) {
+    if (!mesh || !mesh->vertices || !mesh->indices || mesh->index_count < 3 ||
+        mesh->index_count % 3 != 0 || (reorder && !mesh->owns_data)) {
+        return false;
+    }
+
+    cluster_list list = {0};
+    bool ok = reorder ? reorder_into_clusters(mesh, &list) : split_into_clusters(mesh, &list);
+
+    // Regrouping triangles scattered the first-use order of vertices
+    uint32_t used = mesh->vertex_count;
+    if (ok && reorder) {
+        ok = poc_mesh_optimize_vertex_fetch(mesh->vertices, mesh->vertex_count,
+                                            mesh->indices, mesh->index_count, &used);
+    }
+    if (!ok || list.count == 0) {
+        free(list.items);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < list.count; i++) {
+        compute_cluster_bounds(mesh, &list.items[i]);
+    }
+
+    free(mesh->clusters);
+    mesh->clusters = list.items;
+    mesh->cluster_count = list.count;
+    return true;
+}
+
+void poc_mesh_set_cluster_on_load(bool enabled) {
+    atomic_store_explicit(&g_cluster_on_load, enabled, memory_order_relaxed);
+}
+
+bool poc_mesh_get_cluster_on_load(void) {
+    return atomic_load_explicit(&g_cluster_on_load, memory_order_relaxed);
+}
+
+/*
+ * Culling
+ */
+
+void poc_cluster_view_init(poc_cluster_view *view, mat4 view_projection, mat4 model, vec3 camera_position) {
+    if (!view) {
+        return;
+    }
+
+    // Planes of clip * model bound the frustum in the object's own space
+    mat4 clip_from_local;
+    glm_mat4_mul(view_projection, model, clip_from_local);
+    glm_frustum_planes(clip_from_local, view->planes);
+
+    mat4 local_from_world;
+    glm_mat4_inv(model, local_from_world);
+    glm_mat4_mulv3(local_from_world, camera_position, 1.0f, view->camera);
+
+    view->cull_backfaces = glm_mat4_det(model) > 0.0f;
+}
+
+bool poc_cluster_is_visible(const poc_cluster_view *view, const poc_mesh_cluster *cluster) {
+    for (int i = 0; i < 6; i++) {
+        if (glm_vec3_dot((float *)view->planes[i], (float *)cluster->center) + view->planes[i][3] < -cluster->radius) {
+            return false;
+        }
+    }
+
+    if (!view->cull_backfaces || cluster->cone_cutoff >= 1.0f) {
+        return true;
+    }
+
+    // Hidden if the camera sees every point of the sphere from behind
+    // every triangle plane in the cone
+    vec3 to_center;
+    glm_vec3_sub((float *)cluster->center, (float *)view->camera, to_center);
+    return glm_vec3_dot(to_center, (float *)cluster->cone_axis) <
+           cluster->cone_cutoff * glm_vec3_norm(to_center) + cluster->radius;
+}
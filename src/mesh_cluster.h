@@ -0,0 +1,103 @@
+/**
+ * @file mesh_cluster.h
+ * @brief Triangle clusters for culling parts of large meshes
+ *
+ * Frustum culling whole objects leaves big meshes (terrain, buildings)
+ * all-or-nothing: a mesh that is half on screen rasterizes every triangle.
+ * At import each submesh is split into clusters of at most
+ * POC_MESH_CLUSTER_TRIANGLES neighbouring triangles. A cluster stores a
+ * bounding sphere and a normal cone, so per frame it can be dropped when it
+ * is outside the frustum or when every triangle in it faces away from the
+ * camera. Visible clusters that are adjacent in the index buffer are drawn
+ * with one call.
+ *
+ * Clusters are grown from a seed triangle through shared vertices, which
+ * keeps them compact (and their spheres small) and keeps the reuse the
+ * vertex cache optimizer set up. Seeds are taken in the existing triangle
+ * order, so the overdraw ordering survives at cluster granularity.
+ *
+ * The culling tests run in mesh local space. Frustum planes are taken from
+ * the combined clip-from-local matrix and the camera is moved into local
+ * space, so non-uniform scale needs no special handling.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mesh.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum triangles per cluster */
+#define POC_MESH_CLUSTER_TRIANGLES 128
+
+/**
+ * @brief Per-object culling state derived from the camera and the object transform
+ */
+typedef struct {
+    vec4 planes[6];             /**< Frustum planes in local space, normals pointing inward, normalized */
+    vec3 camera;                /**< Camera position in local space */
+    bool cull_backfaces;        /**< False for mirroring transforms, whose winding flips */
+} poc_cluster_view;
+
+/**
+ * @brief Split a mesh into culling clusters
+ *
+ * Replaces any clusters the mesh already has. With @p reorder, triangles of
+ * each submesh are regrouped so every cluster is a compact patch and
+ * vertices are renumbered in the new order of first use; this needs a mesh
+ * that owns its data. Without it the existing triangle order is kept and
+ * clusters are consecutive runs of it, which suits authored orders that
+ * must not change.
+ *
+ * Meshes without an index buffer are not clustered.
+ *
+ * @param mesh Mesh to cluster
+ * @param reorder Whether triangles may be reordered within their submesh
+ * @return true if the mesh has clusters afterwards
+ */
+bool poc_mesh_build_clusters(poc_mesh *mesh, bool reorder);
+
+/**
+ * @brief Prepare cluster culling for one object
+ *
+ * @param view Receives the local-space culling state
+ * @param view_projection Projection times view matrix of the camera
+ * @param model Object to world transform
+ * @param camera_position Camera position in world space
+ */
+void poc_cluster_view_init(poc_cluster_view *view, mat4 view_projection, mat4 model, vec3 camera_position);
+
+/**
+ * @brief Test one cluster against the frustum and its normal cone
+ *
+ * Conservative: a cluster that is reported hidden has no triangle that
+ * could be visible, but some reported visible may still be culled by the
+ * rasterizer.
+ *
+ * @param view Culling state from poc_cluster_view_init()
+ * @param cluster Cluster to test
+ * @return true if the cluster has to be drawn
+ */
+bool poc_cluster_is_visible(const poc_cluster_view *view, const poc_mesh_cluster *cluster);
+
+/**
+ * @brief Enable or disable clustering in poc_mesh_load()
+ *
+ * On by default.
+ *
+ * @param enabled Whether loaded meshes are clustered
+ */
+void poc_mesh_set_cluster_on_load(bool enabled);
+
+/**
+ * @brief Check whether poc_mesh_load() clusters meshes
+ */
+bool poc_mesh_get_cluster_on_load(void);
+
+#ifdef __cplusplus
+}
+#endif
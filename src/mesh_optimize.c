@@ -0,0 +1,480 @@
+#include "mesh_optimize.h"
+#include "../include/poc_engine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+static atomic_bool g_optimize_on_load = true;
+
+static bool indices_in_range(const uint32_t *indices, uint32_t index_count, uint32_t vertex_count) {
+    for (uint32_t i = 0; i < index_count; i++) {
+        if (indices[i] >= vertex_count) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// FIFO cache emulated with timestamps: a vertex is resident while fewer than
+// cache_size misses happened since it was loaded. Returns 1 on a miss.
+static uint32_t touch_cache(uint32_t *cache, uint32_t vertex, uint32_t cache_size, uint32_t *timestamp) {
+    if (*timestamp - cache[vertex] > cache_size) {
+        cache[vertex] = (*timestamp)++;
+        return 1;
+    }
+    return 0;
+}
+
+static uint32_t touch_triangle(uint32_t *cache, const uint32_t *triangle, uint32_t cache_size, uint32_t *timestamp) {
+    return touch_cache(cache, triangle[0], cache_size, timestamp) +
+           touch_cache(cache, triangle[1], cache_size, timestamp) +
+           touch_cache(cache, triangle[2], cache_size, timestamp);
+}
+
+poc_vertex_cache_stats poc_mesh_analyze_vertex_cache(const uint32_t *indices, uint32_t index_count,
+                                                     uint32_t vertex_count, uint32_t cache_size) {
+    poc_vertex_cache_stats stats = {0};
+    if (!indices || index_count < 3 || vertex_count == 0 || cache_size == 0 ||
+        !indices_in_range(indices, index_count, vertex_count)) {
+        return stats;
+    }
+
+    uint32_t *cache = calloc(vertex_count, sizeof(uint32_t));
+    if (!cache) {
+        return stats;
+    }
+
+    uint32_t timestamp = cache_size + 1;
+    uint64_t misses = 0;
+    for (uint32_t i = 0; i < index_count; i++) {
+        misses += touch_cache(cache, indices[i], cache_size, &timestamp);
+    }
+
+    // Every referenced vertex misses at least once, so it has a timestamp
+    uint32_t referenced = 0;
+    for (uint32_t v = 0; v < vertex_count; v++) {
+        referenced += cache[v] != 0;
+    }
+    free(cache);
+
+    stats.acmr = (float)((double)misses / (double)(index_count / 3));
+    stats.atvr = (float)((double)misses / (double)referenced);
+    return stats;
+}
+
+/*
+ * Tipsify
+ */
+
+typedef struct {
+    const uint32_t *indices;
+    uint32_t vertex_count;
+    uint32_t cache_size;
+    uint32_t *offsets;    // vertex -> first entry in triangles (vertex_count + 1)
+    uint32_t *triangles;  // triangles using each vertex
+    uint32_t *live;       // triangles not yet emitted, per vertex
+    uint32_t *cache;      // cache timestamps
+    uint32_t *dead_end;   // recently used vertices, most recent on top
+    uint32_t dead_end_top;
+    uint32_t cursor;      // next vertex to try when the dead-end stack runs dry
+    uint32_t timestamp;
+} tipsify_state;
+
+static void build_adjacency(tipsify_state *state, uint32_t index_count) {
+    memset(state->offsets, 0, (state->vertex_count + 1) * sizeof(uint32_t));
+    for (uint32_t i = 0; i < index_count; i++) {
+        state->offsets[state->indices[i] + 1]++;
+    }
+    for (uint32_t v = 0; v < state->vertex_count; v++) {
+        state->live[v] = state->offsets[v + 1];
+        state->offsets[v + 1] += state->offsets[v];
+    }
+
+    // Fill using live as a per-vertex write cursor, then restore the counts
+    for (uint32_t i = 0; i < index_count; i++) {
+        uint32_t v = state->indices[i];
+        state->triangles[state->offsets[v + 1] - state->live[v]--] = i / 3;
+    }
+    for (uint32_t v = 0; v < state->vertex_count; v++) {
+        state->live[v] = state->offsets[v + 1] - state->offsets[v];
+    }
+}
+
+static uint32_t skip_dead_end(tipsify_state *state) {
+    while (state->dead_end_top > 0) {
+        uint32_t v = state->dead_end[--state->dead_end_top];
+        if (state->live[v] > 0) {
+            return v;
+        }
+    }
+    while (state->cursor < state->vertex_count) {
+        uint32_t v = state->cursor++;
+        if (state->live[v] > 0) {
+            return v;
+        }
+    }
+    return UINT32_MAX;
+}
+
+// Prefer the candidate that entered the cache earliest but will still be
+// resident after its remaining triangles are emitted
+static uint32_t next_fan_vertex(tipsify_state *state, uint32_t candidates_begin) {
+    uint32_t best = UINT32_MAX;
+    int64_t best_priority = -1;
+    for (uint32_t i = candidates_begin; i < state->dead_end_top; i++) {
+        uint32_t v = state->dead_end[i];
+        if (state->live[v] == 0) {
+            continue;
+        }
+        int64_t age = (int64_t)state->timestamp - state->cache[v];
+        int64_t priority = 0;
+        if (age + 2 * (int64_t)state->live[v] <= state->cache_size) {
+            priority = age;
+        }
+        if (priority > best_priority) {
+            best_priority = priority;
+            best = v;
+        }
+    }
+    return best != UINT32_MAX ? best : skip_dead_end(state);
+}
+
+static void tipsify(tipsify_state *state, bool *emitted, uint32_t *destination) {
+    uint32_t written = 0;
+    uint32_t fan = 0;
+    while (fan != UINT32_MAX) {
+        uint32_t candidates_begin = state->dead_end_top;
+        for (uint32_t i = state->offsets[fan]; i < state->offsets[fan + 1]; i++) {
+            uint32_t triangle = state->triangles[i];
+            if (emitted[triangle]) {
+                continue;
+            }
+            emitted[triangle] = true;
+            for (uint32_t k = 0; k < 3; k++) {
+                uint32_t v = state->indices[triangle * 3 + k];
+                destination[written++] = v;
+                state->dead_end[state->dead_end_top++] = v;
+                state->live[v]--;
+                touch_cache(state->cache, v, state->cache_size, &state->timestamp);
+            }
+        }
+        fan = next_fan_vertex(state, candidates_begin);
+    }
+}
+
+bool poc_mesh_optimize_vertex_cache(uint32_t *indices, uint32_t index_count,
+                                    uint32_t vertex_count, uint32_t cache_size) {
+    if (!indices || index_count % 3 != 0 || cache_size == 0 ||
+        !indices_in_range(indices, index_count, vertex_count)) {
+        return false;
+    }
+    if (index_count == 0) {
+        return true;
+    }
+
+    tipsify_state state = {
+        .indices = malloc(index_count * sizeof(uint32_t)),
+        .vertex_count = vertex_count,
+        .cache_size = cache_size,
+        .offsets = malloc(((size_t)vertex_count + 1) * sizeof(uint32_t)),
+        .triangles = malloc(index_count * sizeof(uint32_t)),
+        .live = malloc(vertex_count * sizeof(uint32_t)),
+        .cache = calloc(vertex_count, sizeof(uint32_t)),
+        .dead_end = malloc(index_count * sizeof(uint32_t)),
+        .timestamp = cache_size + 1,
+    };
+    bool *emitted = calloc(index_count / 3, sizeof(bool));
+
+    bool ok = state.indices && state.offsets && state.triangles && state.live &&
+              state.cache && state.dead_end && emitted;
+    if (ok) {
+        memcpy((uint32_t *)state.indices, indices, index_count * sizeof(uint32_t));
+        build_adjacency(&state, index_count);
+        tipsify(&state, emitted, indices);
+    }
+
+    free((uint32_t *)state.indices);
+    free(state.offsets);
+    free(state.triangles);
+    free(state.live);
+    free(state.cache);
+    free(state.dead_end);
+    free(emitted);
+    return ok;
+}
+
+/*
+ * Overdraw
+ */
+
+// A triangle whose three vertices all miss starts a disjoint patch
+static uint32_t find_hard_boundaries(const uint32_t *indices, uint32_t triangle_count,
+                                     uint32_t *cache, uint32_t vertex_count, uint32_t *boundaries) {
+    memset(cache, 0, vertex_count * sizeof(uint32_t));
+    uint32_t timestamp = POC_MESH_CACHE_SIZE + 1;
+    uint32_t count = 0;
+    for (uint32_t t = 0; t < triangle_count; t++) {
+        uint32_t misses = touch_triangle(cache, &indices[t * 3], POC_MESH_CACHE_SIZE, &timestamp);
+        if (t == 0 || misses == 3) {
+            boundaries[count++] = t;
+        }
+    }
+    return count;
+}
+
+// Split each patch as soon as its running ACMR reaches the patch's own ACMR
+// times the threshold; smaller clusters sort better for a small cache cost
+static uint32_t find_soft_boundaries(const uint32_t *indices, uint32_t triangle_count,
+                                     const uint32_t *hard, uint32_t hard_count,
+                                     uint32_t *cache, uint32_t vertex_count,
+                                     float threshold, uint32_t *boundaries) {
+    // The hard pass leaves its timestamps behind; stale ones would count as hits
+    memset(cache, 0, vertex_count * sizeof(uint32_t));
+    uint32_t timestamp = POC_MESH_CACHE_SIZE + 1;
+    uint32_t count = 0;
+    for (uint32_t c = 0; c < hard_count; c++) {
+        uint32_t begin = hard[c];
+        uint32_t end = c + 1 < hard_count ? hard[c + 1] : triangle_count;
+
+        uint32_t patch_misses = 0;
+        for (uint32_t t = begin; t < end; t++) {
+            patch_misses += touch_triangle(cache, &indices[t * 3], POC_MESH_CACHE_SIZE, &timestamp);
+        }
+        float target = threshold * (float)patch_misses / (float)(end - begin);
+
+        // Advancing the timestamp past the cache size flushes it
+        timestamp += POC_MESH_CACHE_SIZE + 1;
+        boundaries[count++] = begin;
+
+        uint32_t running_misses = 0;
+        uint32_t running_triangles = 0;
+        for (uint32_t t = begin; t + 1 < end; t++) {
+            running_misses += touch_triangle(cache, &indices[t * 3], POC_MESH_CACHE_SIZE, &timestamp);
+            running_triangles++;
+            if ((float)running_misses / (float)running_triangles <= target) {
+                boundaries[count++] = t + 1;
+                timestamp += POC_MESH_CACHE_SIZE + 1;
+                running_misses = 0;
+                running_triangles = 0;
+            }
+        }
+    }
+    return count;
+}
+
+typedef struct {
+    float key;
+    uint32_t cluster;
+} cluster_sort_entry;
+
+static int compare_clusters(const void *a, const void *b) {
+    const cluster_sort_entry *ca = a;
+    const cluster_sort_entry *cb = b;
+    if (ca->key != cb->key) {
+        return ca->key > cb->key ? -1 : 1;
+    }
+    return ca->cluster < cb->cluster ? -1 : (ca->cluster > cb->cluster ? 1 : 0);
+}
+
+static float cluster_sort_key(const uint32_t *indices, uint32_t begin, uint32_t end,
+                              const poc_vertex *vertices, const vec3 center, float radius) {
+    vec3 centroid = {0.0f, 0.0f, 0.0f};
+    vec3 normal = {0.0f, 0.0f, 0.0f};
+    float area = 0.0f;
+    for (uint32_t t = begin; t < end; t++) {
+        const float *p0 = vertices[indices[t * 3 + 0]].position;
+        const float *p1 = vertices[indices[t * 3 + 1]].position;
+        const float *p2 = vertices[indices[t * 3 + 2]].position;
+
+        vec3 e1, e2, n;
+        glm_vec3_sub((float *)p1, (float *)p0, e1);
+        glm_vec3_sub((float *)p2, (float *)p0, e2);
+        glm_vec3_cross(e1, e2, n);
+        float weight = glm_vec3_norm(n);
+
+        vec3 triangle_center;
+        glm_vec3_add((float *)p0, (float *)p1, triangle_center);
+        glm_vec3_add(triangle_center, (float *)p2, triangle_center);
+        glm_vec3_muladds(triangle_center, weight / 3.0f, centroid);
+        glm_vec3_add(normal, n, normal);
+        area += weight;
+    }
+
+    float normal_length = glm_vec3_norm(normal);
+    if (area <= 0.0f || normal_length <= 0.0f) {
+        return 0.0f;
+    }
+    glm_vec3_scale(centroid, 1.0f / area, centroid);
+    glm_vec3_scale(normal, 1.0f / normal_length, normal);
+
+    vec3 offset;
+    glm_vec3_sub(centroid, (float *)center, offset);
+    return glm_vec3_dot(offset, normal) / radius;
+}
+
+uint32_t poc_mesh_optimize_overdraw(uint32_t *indices, uint32_t index_count,
+                                    const poc_vertex *vertices, uint32_t vertex_count,
+                                    const vec3 center, float radius, float threshold) {
+    if (!indices || !vertices || index_count < 6 || index_count % 3 != 0 || !(radius > 0.0f) ||
+        !indices_in_range(indices, index_count, vertex_count)) {
+        return 0;
+    }
+
+    uint32_t triangle_count = index_count / 3;
+    uint32_t *cache = malloc(vertex_count * sizeof(uint32_t));
+    uint32_t *hard = malloc(triangle_count * sizeof(uint32_t));
+    uint32_t *soft = malloc(triangle_count * sizeof(uint32_t));
+    cluster_sort_entry *order = NULL;
+    uint32_t *sorted = NULL;
+    uint32_t cluster_count = 0;
+
+    if (cache && hard && soft) {
+        uint32_t hard_count = find_hard_boundaries(indices, triangle_count, cache, vertex_count, hard);
+        cluster_count = find_soft_boundaries(indices, triangle_count, hard, hard_count,
+                                             cache, vertex_count, threshold, soft);
+        order = malloc(cluster_count * sizeof(cluster_sort_entry));
+        sorted = malloc(index_count * sizeof(uint32_t));
+    }
+
+    if (order && sorted) {
+        for (uint32_t c = 0; c < cluster_count; c++) {
+            uint32_t end = c + 1 < cluster_count ? soft[c + 1] : triangle_count;
+            order[c].key = cluster_sort_key(indices, soft[c], end, vertices, center, radius);
+            order[c].cluster = c;
+        }
+        qsort(order, cluster_count, sizeof(cluster_sort_entry), compare_clusters);
+
+        uint32_t written = 0;
+        for (uint32_t i = 0; i < cluster_count; i++) {
+            uint32_t c = order[i].cluster;
+            uint32_t end = c + 1 < cluster_count ? soft[c + 1] : triangle_count;
+            uint32_t count = (end - soft[c]) * 3;
+            memcpy(&sorted[written], &indices[soft[c] * 3], count * sizeof(uint32_t));
+            written += count;
+        }
+        memcpy(indices, sorted, index_count * sizeof(uint32_t));
+    } else {
+        cluster_count = 0;
+    }
+
+    free(cache);
+    free(hard);
+    free(soft);
+    free(order);
+    free(sorted);
+    return cluster_count;
+}
+
+/*
+ * Vertex fetch
+ */
+
+bool poc_mesh_optimize_vertex_fetch(poc_vertex *vertices, uint32_t vertex_count,
+                                    uint32_t *indices, uint32_t index_count,
+                                    uint32_t *out_vertex_count) {
+    if (!vertices || !indices || !out_vertex_count || vertex_count == 0 ||
+        !indices_in_range(indices, index_count, vertex_count)) {
+        return false;
+    }
+
+    uint32_t *remap = malloc(vertex_count * sizeof(uint32_t));
+    poc_vertex *reordered = malloc(vertex_count * sizeof(poc_vertex));
+    if (!remap || !reordered) {
+        free(remap);
+        free(reordered);
+        return false;
+    }
+    memset(remap, 0xff, vertex_count * sizeof(uint32_t));
+
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < index_count; i++) {
+        uint32_t v = indices[i];
+        if (remap[v] == UINT32_MAX) {
+            remap[v] = used++;
+        }
+        indices[i] = remap[v];
+    }
+
+    for (uint32_t v = 0; v < vertex_count; v++) {
+        if (remap[v] != UINT32_MAX) {
+            reordered[remap[v]] = vertices[v];
+        }
+    }
+    memcpy(vertices, reordered, used * sizeof(poc_vertex));
+    free(reordered);
+    free(remap);
+
+    *out_vertex_count = used;
+    return true;
+}
+
+/*
+ * Whole-mesh stage
+ */
+
+bool poc_mesh_optimize(poc_mesh *mesh, poc_mesh_optimize_stats *stats) {
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+    }
+    if (!mesh || !mesh->owns_data || !mesh->vertices || !mesh->indices ||
+        mesh->index_count < 3 || mesh->index_count % 3 != 0) {
+        return false;
+    }
+
+    double start_time = poc_get_time();
+    poc_vertex_cache_stats before = poc_mesh_analyze_vertex_cache(mesh->indices, mesh->index_count,
+                                                                  mesh->vertex_count, POC_MESH_CACHE_SIZE);
+
+    // Triangles may only move within their submesh, so each range is
+    // optimized on its own; all ranges share the vertex renumbering
+    uint32_t clusters = 0;
+    uint32_t range_count = poc_mesh_get_submesh_count(mesh);
+    for (uint32_t i = 0; i < range_count; i++) {
+        poc_submesh range;
+        poc_mesh_get_submesh(mesh, i, &range, NULL);
+        uint32_t *indices = mesh->indices + range.index_offset;
+        if (!poc_mesh_optimize_vertex_cache(indices, range.index_count,
+                                            mesh->vertex_count, POC_MESH_CACHE_SIZE)) {
+            return false;
+        }
+        clusters += poc_mesh_optimize_overdraw(indices, range.index_count,
+                                               mesh->vertices, mesh->vertex_count,
+                                               mesh->center, mesh->bounding_radius,
+                                               POC_MESH_OVERDRAW_THRESHOLD);
+    }
+
+    uint32_t used = mesh->vertex_count;
+    if (!poc_mesh_optimize_vertex_fetch(mesh->vertices, mesh->vertex_count,
+                                        mesh->indices, mesh->index_count, &used)) {
+        return false;
+    }
+
+    uint32_t removed = mesh->vertex_count - used;
+    if (removed > 0) {
+        mesh->vertex_count = used;
+        poc_vertex *shrunk = realloc(mesh->vertices, used * sizeof(poc_vertex));
+        if (shrunk) {
+            mesh->vertices = shrunk;
+        }
+        poc_mesh_calculate_bounds(mesh);
+    }
+
+    if (stats) {
+        stats->before = before;
+        stats->after = poc_mesh_analyze_vertex_cache(mesh->indices, mesh->index_count,
+                                                     mesh->vertex_count, POC_MESH_CACHE_SIZE);
+        stats->clusters = clusters;
+        stats->removed_vertices = removed;
+        stats->milliseconds = (poc_get_time() - start_time) * 1000.0;
+    }
+    return true;
+}
+
+void poc_mesh_set_optimize_on_load(bool enabled) {
+    atomic_store_explicit(&g_optimize_on_load, enabled, memory_order_relaxed);
+}
+
+bool poc_mesh_get_optimize_on_load(void) {
+    return atomic_load_explicit(&g_optimize_on_load, memory_order_relaxed);
+}
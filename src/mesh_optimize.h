@@ -0,0 +1,158 @@
+/**
+ * @file mesh_optimize.h
+ * @brief Index and vertex reordering for GPU-friendly meshes
+ *
+ * The optimize stage runs three reorderings, in this order:
+ *
+ * 1. Vertex cache: triangles are reordered with Tipsify (Sander et al.,
+ *    "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw")
+ *    so that consecutive triangles share vertices that are still in the
+ *    post-transform cache.
+ * 2. Overdraw: the cache-friendly sequence is cut into clusters at points
+ *    where the cache is cold anyway, and clusters that face away from the
+ *    mesh center are drawn first. Outer surfaces then tend to occlude inner
+ *    ones, for little loss in cache efficiency.
+ * 3. Vertex fetch: vertices are renumbered in order of first use so the
+ *    vertex fetcher reads memory front to back. Unreferenced vertices are
+ *    dropped.
+ *
+ * Efficiency is reported as ACMR (cache misses per triangle, lower is
+ * better, about 0.5 is the practical floor for regular grids) and ATVR
+ * (cache misses per referenced vertex, 1.0 is optimal), both measured with
+ * a FIFO cache of POC_MESH_CACHE_SIZE entries.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mesh.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Post-transform cache size assumed by the optimizer and the statistics */
+#define POC_MESH_CACHE_SIZE 16
+
+/**
+ * @brief Cluster ACMR may exceed the whole-cluster ACMR by this factor
+ * before the overdraw pass stops splitting it further
+ */
+#define POC_MESH_OVERDRAW_THRESHOLD 1.05f
+
+/**
+ * @brief Vertex cache efficiency of an index buffer
+ */
+typedef struct {
+    float acmr; /**< Average cache miss ratio: misses per triangle */
+    float atvr; /**< Average transform to vertex ratio: misses per referenced vertex */
+} poc_vertex_cache_stats;
+
+/**
+ * @brief Result of poc_mesh_optimize()
+ */
+typedef struct {
+    poc_vertex_cache_stats before; /**< Cache efficiency of the input order */
+    poc_vertex_cache_stats after;  /**< Cache efficiency of the optimized order */
+    uint32_t clusters;             /**< Clusters sorted by the overdraw pass */
+    uint32_t removed_vertices;     /**< Unreferenced vertices dropped */
+    double milliseconds;           /**< Time spent optimizing */
+} poc_mesh_optimize_stats;
+
+/**
+ * @brief Simulate a FIFO post-transform cache over an index buffer
+ *
+ * @param indices Triangle list
+ * @param index_count Number of indices (multiple of 3)
+ * @param vertex_count Number of vertices the indices refer to
+ * @param cache_size Number of cache entries
+ * @return ACMR and ATVR (both 0 for an empty buffer)
+ */
+poc_vertex_cache_stats poc_mesh_analyze_vertex_cache(const uint32_t *indices, uint32_t index_count,
+                                                     uint32_t vertex_count, uint32_t cache_size);
+
+/**
+ * @brief Reorder triangles for post-transform cache reuse (Tipsify)
+ *
+ * Runs in linear time. Triangle winding is preserved.
+ *
+ * @param indices Triangle list, reordered in place
+ * @param index_count Number of indices (multiple of 3)
+ * @param vertex_count Number of vertices the indices refer to
+ * @param cache_size Number of cache entries to optimize for
+ * @return true on success, false on invalid input or allocation failure
+ */
+bool poc_mesh_optimize_vertex_cache(uint32_t *indices, uint32_t index_count,
+                                    uint32_t vertex_count, uint32_t cache_size);
+
+/**
+ * @brief Reorder clusters of triangles to reduce overdraw
+ *
+ * Expects a cache-optimized index buffer. Clusters are sorted by how far
+ * their area-weighted centroid lies in front of @p center along their
+ * average normal, relative to @p radius, so outward-facing shells draw
+ * before what they cover.
+ *
+ * @param indices Triangle list, reordered in place
+ * @param index_count Number of indices (multiple of 3)
+ * @param vertices Vertex positions
+ * @param vertex_count Number of vertices
+ * @param center Mesh center
+ * @param radius Bounding radius around @p center (the pass is skipped if not positive)
+ * @param threshold Allowed cluster ACMR growth, see POC_MESH_OVERDRAW_THRESHOLD
+ * @return Number of clusters sorted, 0 if the pass was skipped or failed
+ */
+uint32_t poc_mesh_optimize_overdraw(uint32_t *indices, uint32_t index_count,
+                                    const poc_vertex *vertices, uint32_t vertex_count,
+                                    const vec3 center, float radius, float threshold);
+
+/**
+ * @brief Renumber vertices in order of first use
+ *
+ * @param vertices Vertex array, reordered in place
+ * @param vertex_count Number of vertices
+ * @param indices Triangle list, remapped in place
+ * @param index_count Number of indices
+ * @param out_vertex_count Receives the number of referenced vertices, which
+ *        now occupy the front of @p vertices
+ * @return true on success, false on invalid input or allocation failure
+ */
+bool poc_mesh_optimize_vertex_fetch(poc_vertex *vertices, uint32_t vertex_count,
+                                    uint32_t *indices, uint32_t index_count,
+                                    uint32_t *out_vertex_count);
+
+/**
+ * @brief Run all three reorderings on a mesh
+ *
+ * Must run before the mesh is uploaded. Meshes that do not own their data
+ * are left untouched, since their arrays may be shared or read-only.
+ * Triangles are only reordered within their submesh, so ranges stay valid.
+ * Bounds are recalculated if unreferenced vertices were dropped.
+ *
+ * @param mesh Mesh to optimize
+ * @param stats Optional statistics output
+ * @return true if the mesh was optimized
+ */
+bool poc_mesh_optimize(poc_mesh *mesh, poc_mesh_optimize_stats *stats);
+
+/**
+ * @brief Enable or disable optimization in poc_mesh_load()
+ *
+ * On by default. Assets that need their authored triangle order (for
+ * example meshes drawn with order-dependent blending) can be loaded with
+ * optimization switched off and optimized selectively with
+ * poc_mesh_optimize().
+ *
+ * @param enabled Whether loaded meshes are optimized
+ */
+void poc_mesh_set_optimize_on_load(bool enabled);
+
+/**
+ * @brief Check whether poc_mesh_load() optimizes meshes
+ */
+bool poc_mesh_get_optimize_on_load(void);
+
+#ifdef __cplusplus
+}
+#endif
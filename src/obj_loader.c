@@ -1,8 +1,12 @@
+#define _POSIX_C_SOURCE 200809L
 #include "obj_loader.h"
+#include "file_map.h"
+#include "job_system.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdatomic.h>
 #include <cglm/cglm.h>
 
 const char *poc_obj_result_to_string(poc_obj_result result) {
@@ -21,542 +25,1604 @@ static char *extract_directory(const char *filepath) {
     const char *last_slash = strrchr(filepath, '/');
     if (!last_slash) {
         char *dir = malloc(3);
-        strcpy(dir, "./");
+        if (dir) strcpy(dir, "./");
         return dir;
     }
 
     size_t dir_len = last_slash - filepath + 1;
     char *dir = malloc(dir_len + 1);
-    strncpy(dir, filepath, dir_len);
+    if (!dir) return NULL;
+    memcpy(dir, filepath, dir_len);
     dir[dir_len] = '\0';
     return dir;
 }
 
-static poc_obj_result parse_mtl_file(const char *mtl_filename, poc_model *model) {
-    FILE *file = fopen(mtl_filename, "r");
-    if (!file) {
-        return POC_OBJ_RESULT_ERROR_MTL_NOT_FOUND;
-    }
+void poc_calculate_face_normal(const vec3 v0, const vec3 v1, const vec3 v2, vec3 normal) {
+    vec3 edge1, edge2;
+    // Manually copy values to avoid const issues
+    edge1[0] = v1[0] - v0[0];
+    edge1[1] = v1[1] - v0[1];
+    edge1[2] = v1[2] - v0[2];
 
-    char line[1024];
-    poc_material *current_material = NULL;
+    edge2[0] = v2[0] - v0[0];
+    edge2[1] = v2[1] - v0[1];
+    edge2[2] = v2[2] - v0[2];
 
-    while (fgets(line, sizeof(line), file)) {
-        // Remove newline
-        line[strcspn(line, "\n")] = '\0';
+    glm_vec3_crossn(edge1, edge2, normal);
+}
 
-        if (strncmp(line, "newmtl ", 7) == 0) {
-            // Allocate new material
-            model->materials = realloc(model->materials,
-                (model->material_count + 1) * sizeof(poc_material));
-            if (!model->materials) {
-                fclose(file);
-                return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+// --- OBJ scanning ---
+//
+// The OBJ file is mapped and scanned in place. Mapped files are not
+// NUL-terminated, so every scanner takes the end of the current line and
+// never reads past it.
+
+static inline bool is_blank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+static inline bool is_digit(char c) {
+    return (unsigned char)(c - '0') < 10;
+}
+
+static inline const char *skip_blanks(const char *p, const char *end) {
+    while (p < end && is_blank(*p)) p++;
+    return p;
+}
+
+// Powers of ten that are exact in a double
+static const double k_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+ * Scan a decimal float ("-1.5", ".25", "3e-2").
+ *
+ * Up to 19 significant digits are gathered into an integer and scaled once
+ * by a power of ten, which is exact for the values OBJ exporters write and
+ * within one float ulp otherwise. Returns the position after the number, or
+ * NULL if there is no number.
+ */
+static const char *scan_float(const char *p, const char *end, float *out) {
+    p = skip_blanks(p, end);
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    bool any_digits = false;
+
+    while (p < end && is_digit(*p)) {
+        if (mantissa < 1000000000000000000ull) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        } else {
+            exponent++;
+        }
+        any_digits = true;
+        p++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && is_digit(*p)) {
+            if (mantissa < 1000000000000000000ull) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                exponent--;
             }
+            any_digits = true;
+            p++;
+        }
+    }
+    if (!any_digits) return NULL;
 
-            current_material = &model->materials[model->material_count];
-            memset(current_material, 0, sizeof(poc_material));
-
-            // Set default values
-            glm_vec3_copy((vec3){0.2f, 0.2f, 0.2f}, current_material->ambient);
-            glm_vec3_copy((vec3){0.8f, 0.8f, 0.8f}, current_material->diffuse);
-            glm_vec3_copy((vec3){1.0f, 1.0f, 1.0f}, current_material->specular);
-            current_material->shininess = 32.0f;
-            current_material->opacity = 1.0f;
-            current_material->illum_model = 2;
-
-            strncpy(current_material->name, line + 7, sizeof(current_material->name) - 1);
-            model->material_count++;
-        } else if (current_material) {
-            if (strncmp(line, "Ka ", 3) == 0) {
-                sscanf(line + 3, "%f %f %f",
-                    &current_material->ambient[0],
-                    &current_material->ambient[1],
-                    &current_material->ambient[2]);
-            } else if (strncmp(line, "Kd ", 3) == 0) {
-                sscanf(line + 3, "%f %f %f",
-                    &current_material->diffuse[0],
-                    &current_material->diffuse[1],
-                    &current_material->diffuse[2]);
-            } else if (strncmp(line, "Ks ", 3) == 0) {
-                sscanf(line + 3, "%f %f %f",
-                    &current_material->specular[0],
-                    &current_material->specular[1],
-                    &current_material->specular[2]);
-            } else if (strncmp(line, "Ns ", 3) == 0) {
-                sscanf(line + 3, "%f", &current_material->shininess);
-            } else if (strncmp(line, "d ", 2) == 0) {
-                sscanf(line + 2, "%f", &current_material->opacity);
-            } else if (strncmp(line, "illum ", 6) == 0) {
-                sscanf(line + 6, "%d", &current_material->illum_model);
+    // Only take the exponent if digits follow, like strtof()
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool exponent_negative = false;
+        if (q < end && (*q == '-' || *q == '+')) {
+            exponent_negative = *q == '-';
+            q++;
+        }
+        if (q < end && is_digit(*q)) {
+            int value = 0;
+            while (q < end && is_digit(*q)) {
+                if (value < 10000) value = value * 10 + (*q - '0');
+                q++;
             }
+            exponent += exponent_negative ? -value : value;
+            p = q;
         }
     }
 
-    fclose(file);
-    return POC_OBJ_RESULT_SUCCESS;
+    double value = (double)mantissa;
+    if (exponent < 0) {
+        value = exponent >= -22 ? value / k_pow10[-exponent] : value / pow(10.0, -exponent);
+    } else if (exponent > 0) {
+        value = exponent <= 22 ? value * k_pow10[exponent] : value * pow(10.0, exponent);
+    }
+
+    *out = (float)(negative ? -value : value);
+    return p;
+}
+
+/**
+ * Scan a decimal integer. Returns the position after it, or NULL if there is
+ * no number.
+ */
+static const char *scan_int(const char *p, const char *end, int32_t *out) {
+    p = skip_blanks(p, end);
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    if (p >= end || !is_digit(*p)) return NULL;
+
+    int64_t value = 0;
+    while (p < end && is_digit(*p)) {
+        if (value <= INT32_MAX) value = value * 10 + (*p - '0');
+        p++;
+    }
+    if (value > INT32_MAX) value = INT32_MAX;
+
+    *out = (int32_t)(negative ? -value : value);
+    return p;
 }
 
-static uint32_t find_material_index(const poc_model *model, const char *material_name) {
-    for (uint32_t i = 0; i < model->material_count; i++) {
-        if (strcmp(model->materials[i].name, material_name) == 0) {
-            return i;
+/**
+ * Scan one face corner: "v", "v/vt", "v//vn" or "v/vt/vn". Missing indices
+ * are returned as 0. Returns the position after the corner, or NULL if it
+ * is malformed.
+ */
+static const char *scan_face_corner(const char *p, const char *end, int32_t *v, int32_t *vt, int32_t *vn) {
+    *vt = 0;
+    *vn = 0;
+
+    p = scan_int(p, end, v);
+    if (!p) return NULL;
+
+    if (p < end && *p == '/') {
+        p++;
+        if (p < end && *p != '/' && !is_blank(*p)) {
+            p = scan_int(p, end, vt);
+            if (!p) return NULL;
+        }
+        if (p < end && *p == '/') {
+            p++;
+            if (p < end && !is_blank(*p)) {
+                p = scan_int(p, end, vn);
+                if (!p) return NULL;
+            }
         }
     }
-    return 0; // Default to first material or 0 if none found
+
+    // Corners are separated by blanks; anything else glued on is malformed
+    if (p < end && !is_blank(*p)) return NULL;
+    return p;
 }
 
-void poc_calculate_face_normal(const vec3 v0, const vec3 v1, const vec3 v2, vec3 normal) {
-    vec3 edge1, edge2;
-    // Manually copy values to avoid const issues
-    edge1[0] = v1[0] - v0[0];
-    edge1[1] = v1[1] - v0[1];
-    edge1[2] = v1[2] - v0[2];
+// Trim blanks around the argument of a statement such as "o name"
+static const char *trim_argument(const char *p, const char *end, const char **out_end) {
+    p = skip_blanks(p, end);
+    while (end > p && is_blank(end[-1])) end--;
+    *out_end = end;
+    return p;
+}
 
-    edge2[0] = v2[0] - v0[0];
-    edge2[1] = v2[1] - v0[1];
-    edge2[2] = v2[2] - v0[2];
+// Copy a range of the mapped file into a NUL-terminated string
+static char *copy_range(const char *begin, const char *end) {
+    size_t length = (size_t)(end - begin);
+    char *copy = malloc(length + 1);
+    if (!copy) return NULL;
+    memcpy(copy, begin, length);
+    copy[length] = '\0';
+    return copy;
+}
 
-    glm_vec3_crossn(edge1, edge2, normal);
+/**
+ * Grow an array geometrically so it holds at least needed elements.
+ */
+static bool grow_array(void **data, uint32_t *capacity, uint64_t needed, size_t element_size) {
+    if (needed <= *capacity) return true;
+    if (needed > UINT32_MAX) return false;
+
+    uint64_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < needed) new_capacity *= 2;
+    if (new_capacity > UINT32_MAX) new_capacity = UINT32_MAX;
+
+    void *grown = realloc(*data, (size_t)new_capacity * element_size);
+    if (!grown) return false;
+
+    *data = grown;
+    *capacity = (uint32_t)new_capacity;
+    return true;
 }
 
-void poc_calculate_smooth_normals(poc_model *model) {
-    // Reset all normals to zero
-    for (uint32_t obj_idx = 0; obj_idx < model->object_count; obj_idx++) {
-        poc_mesh_object *object = &model->objects[obj_idx];
-        for (uint32_t grp_idx = 0; grp_idx < object->group_count; grp_idx++) {
-            poc_mesh_group *group = &object->groups[grp_idx];
-            for (uint32_t v_idx = 0; v_idx < group->vertex_count; v_idx++) {
-                glm_vec3_zero(group->vertices[v_idx].normal);
-            }
+// --- Chunked parsing ---
+//
+// Large files are cut at line boundaries into chunks that are parsed in
+// parallel. A chunk only records what it reads: its own attribute arrays,
+// its faces with the indices exactly as written, and the o/g/usemtl/s/mtllib
+// statements along with how many faces preceded them. A serial fix-up pass
+// replays the statements in file order to build objects and groups, and
+// hands every group the face ranges (segments) that belong to it together
+// with their place in the group's index array.
+//
+// Face corners are then welded: every distinct (v, vt, vn) triple of a group
+// becomes one vertex. Each chunk welds its own segments in parallel, each
+// group merges the distinct triples of its segments in file order, and the
+// chunks finally rewrite their indices and fill in the vertices they
+// introduced. Vertices come out in order of first use either way, so none of
+// this depends on where the chunks were cut and every chunk count gives the
+// same model.
+
+// Files below twice this size are parsed as one chunk on the calling thread
+#define OBJ_MIN_CHUNK_BYTES (4u << 20)
+
+// Chunks per thread, so that uneven chunks still keep every thread busy
+#define OBJ_CHUNKS_PER_THREAD 4
+
+static atomic_uint g_chunk_count_override;
+
+typedef enum {
+    OBJ_STATEMENT_OBJECT,
+    OBJ_STATEMENT_GROUP,
+    OBJ_STATEMENT_MATERIAL,
+    OBJ_STATEMENT_SMOOTHING,
+    OBJ_STATEMENT_MTLLIB
+} obj_statement_type;
+
+// A statement that changes the parse state, replayed by the fix-up pass
+typedef struct {
+    obj_statement_type type;
+    uint32_t face;              // Faces of the chunk read before the statement
+    const char *argument;       // Trimmed argument, inside the mapped file
+    uint32_t length;
+    uint32_t smoothing_group;
+} obj_statement;
+
+// A face, with the attribute counts of its chunk when it was read so that
+// relative indices can be resolved once the chunk's offsets are known
+typedef struct {
+    uint32_t first_corner;
+    uint32_t position_count;
+    uint32_t texcoord_count;
+    uint32_t normal_count;
+} obj_face;
+
+// Faces [face_begin, face_end) of one chunk that belong to one group
+typedef struct {
+    uint32_t chunk;
+    uint32_t object;
+    uint32_t group;
+    uint32_t face_begin;
+    uint32_t face_end;
+    uint32_t index_offset;      // Where the range starts in the group's indices
+    uint32_t index_count;
+    uint32_t unique_begin;      // Distinct triples of the range in its chunk
+    uint32_t unique_count;
+    uint32_t new_begin;         // First group vertex introduced by the range
+} obj_segment;
+
+typedef struct {
+    const char *begin;
+    const char *end;
+
+    vec3 *positions;
+    vec3 *normals;
+    vec2 *texcoords;
+    uint32_t position_count;
+    uint32_t normal_count;
+    uint32_t texcoord_count;
+    uint32_t position_capacity;
+    uint32_t normal_capacity;
+    uint32_t texcoord_capacity;
+
+    obj_face *faces;
+    int32_t (*corners)[3];      // v, vt, vn as written; 0 when absent
+    obj_statement *statements;
+    uint32_t face_count;
+    uint32_t corner_count;
+    uint32_t statement_count;
+    uint32_t face_capacity;
+    uint32_t corner_capacity;
+    uint32_t statement_capacity;
+
+    poc_obj_result result;
+
+    // Distinct resolved (v, vt, vn) triples of the chunk's segments, and the
+    // group vertex each one became
+    uint32_t (*uniques)[3];
+    uint32_t *unique_vertices;
+    uint32_t unique_count;
+    uint32_t unique_capacity;
+
+    // Set by the fix-up pass
+    poc_model *model;
+    obj_segment *segments;
+    uint32_t first_segment;
+    uint32_t segment_count;
+    uint32_t position_base;
+    uint32_t normal_base;
+    uint32_t texcoord_base;
+} obj_chunk;
+
+static bool add_statement(obj_chunk *chunk, obj_statement_type type, const char *argument,
+                          const char *argument_end, uint32_t smoothing_group) {
+    if (chunk->statement_count == chunk->statement_capacity &&
+        !grow_array((void **)&chunk->statements, &chunk->statement_capacity,
+                    (uint64_t)chunk->statement_count + 1, sizeof(obj_statement))) {
+        return false;
+    }
+
+    chunk->statements[chunk->statement_count++] = (obj_statement){
+        .type = type,
+        .face = chunk->face_count,
+        .argument = argument,
+        .length = (uint32_t)(argument_end - argument),
+        .smoothing_group = smoothing_group,
+    };
+    return true;
+}
+
+/**
+ * Record one face. Faces with fewer than three corners are dropped.
+ */
+static poc_obj_result parse_face(obj_chunk *chunk, const char *p, const char *end) {
+    uint32_t first_corner = chunk->corner_count;
+
+    for (;;) {
+        p = skip_blanks(p, end);
+        if (p >= end) break;
+
+        if (chunk->corner_count == chunk->corner_capacity &&
+            !grow_array((void **)&chunk->corners, &chunk->corner_capacity,
+                        (uint64_t)chunk->corner_count + 1, sizeof(chunk->corners[0]))) {
+            return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+        }
+
+        int32_t *corner = chunk->corners[chunk->corner_count];
+        p = scan_face_corner(p, end, &corner[0], &corner[1], &corner[2]);
+        if (!p) {
+            return POC_OBJ_RESULT_ERROR_INVALID_FORMAT;
         }
+        chunk->corner_count++;
     }
 
-    // Accumulate face normals for each vertex
-    for (uint32_t obj_idx = 0; obj_idx < model->object_count; obj_idx++) {
-        poc_mesh_object *object = &model->objects[obj_idx];
-        for (uint32_t grp_idx = 0; grp_idx < object->group_count; grp_idx++) {
-            poc_mesh_group *group = &object->groups[grp_idx];
+    uint32_t corner_count = chunk->corner_count - first_corner;
+    if (corner_count < 3) {
+        printf("Warning: Face has %u vertices, expected at least 3\n", corner_count);
+        chunk->corner_count = first_corner;
+        return POC_OBJ_RESULT_SUCCESS;
+    }
 
-            for (uint32_t i = 0; i < group->index_count; i += 3) {
-                uint32_t i0 = group->indices[i];
-                uint32_t i1 = group->indices[i + 1];
-                uint32_t i2 = group->indices[i + 2];
-
-                vec3 face_normal;
-                poc_calculate_face_normal(
-                    group->vertices[i0].position,
-                    group->vertices[i1].position,
-                    group->vertices[i2].position,
-                    face_normal
-                );
-
-                // Add face normal to each vertex normal
-                glm_vec3_add(group->vertices[i0].normal, face_normal, group->vertices[i0].normal);
-                glm_vec3_add(group->vertices[i1].normal, face_normal, group->vertices[i1].normal);
-                glm_vec3_add(group->vertices[i2].normal, face_normal, group->vertices[i2].normal);
+    if (chunk->face_count == chunk->face_capacity &&
+        !grow_array((void **)&chunk->faces, &chunk->face_capacity,
+                    (uint64_t)chunk->face_count + 1, sizeof(obj_face))) {
+        return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+    }
+
+    chunk->faces[chunk->face_count++] = (obj_face){
+        .first_corner = first_corner,
+        .position_count = chunk->position_count,
+        .texcoord_count = chunk->texcoord_count,
+        .normal_count = chunk->normal_count,
+    };
+    return POC_OBJ_RESULT_SUCCESS;
+}
+
+static bool keyword_is(const char *keyword, size_t length, const char *expected) {
+    return strlen(expected) == length && memcmp(keyword, expected, length) == 0;
+}
+
+/**
+ * Parse one line, without its line break.
+ */
+static poc_obj_result parse_line(obj_chunk *chunk, const char *p, const char *end) {
+    p = skip_blanks(p, end);
+    if (p >= end || *p == '#') return POC_OBJ_RESULT_SUCCESS;
+
+    const char *keyword = p;
+    while (p < end && !is_blank(*p)) p++;
+    size_t keyword_length = (size_t)(p - keyword);
+
+    if (keyword_length == 1 && keyword[0] == 'v') {
+        vec3 pos;
+        if ((p = scan_float(p, end, &pos[0])) && (p = scan_float(p, end, &pos[1])) &&
+            (p = scan_float(p, end, &pos[2]))) {
+            if (chunk->position_count == chunk->position_capacity &&
+                !grow_array((void **)&chunk->positions, &chunk->position_capacity,
+                            (uint64_t)chunk->position_count + 1, sizeof(vec3))) {
+                return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+            }
+            glm_vec3_copy(pos, chunk->positions[chunk->position_count++]);
+        }
+    } else if (keyword_length == 1 && keyword[0] == 'f') {
+        return parse_face(chunk, p, end);
+    } else if (keyword_length == 2 && keyword[0] == 'v' && keyword[1] == 't') {
+        vec2 tc;
+        if ((p = scan_float(p, end, &tc[0])) && (p = scan_float(p, end, &tc[1]))) {
+            if (chunk->texcoord_count == chunk->texcoord_capacity &&
+                !grow_array((void **)&chunk->texcoords, &chunk->texcoord_capacity,
+                            (uint64_t)chunk->texcoord_count + 1, sizeof(vec2))) {
+                return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+            }
+            glm_vec2_copy(tc, chunk->texcoords[chunk->texcoord_count++]);
+        }
+    } else if (keyword_length == 2 && keyword[0] == 'v' && keyword[1] == 'n') {
+        vec3 norm;
+        if ((p = scan_float(p, end, &norm[0])) && (p = scan_float(p, end, &norm[1])) &&
+            (p = scan_float(p, end, &norm[2]))) {
+            if (chunk->normal_count == chunk->normal_capacity &&
+                !grow_array((void **)&chunk->normals, &chunk->normal_capacity,
+                            (uint64_t)chunk->normal_count + 1, sizeof(vec3))) {
+                return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
             }
+            glm_vec3_copy(norm, chunk->normals[chunk->normal_count++]);
+        }
+    } else {
+        obj_statement_type type;
+        if (keyword_length == 1 && keyword[0] == 'o') {
+            type = OBJ_STATEMENT_OBJECT;
+        } else if (keyword_length == 1 && keyword[0] == 'g') {
+            type = OBJ_STATEMENT_GROUP;
+        } else if (keyword_length == 1 && keyword[0] == 's') {
+            type = OBJ_STATEMENT_SMOOTHING;
+        } else if (keyword_is(keyword, keyword_length, "usemtl")) {
+            type = OBJ_STATEMENT_MATERIAL;
+        } else if (keyword_is(keyword, keyword_length, "mtllib")) {
+            type = OBJ_STATEMENT_MTLLIB;
+        } else {
+            return POC_OBJ_RESULT_SUCCESS;
+        }
+
+        const char *argument_end;
+        const char *argument = trim_argument(p, end, &argument_end);
+
+        int32_t smoothing = 0;
+        if (type == OBJ_STATEMENT_SMOOTHING &&
+            !(argument_end - argument == 3 && memcmp(argument, "off", 3) == 0)) {
+            scan_int(argument, argument_end, &smoothing);
+        }
+
+        if (!add_statement(chunk, type, argument, argument_end, (uint32_t)smoothing)) {
+            return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
         }
     }
 
-    // Normalize all vertex normals
-    for (uint32_t obj_idx = 0; obj_idx < model->object_count; obj_idx++) {
-        poc_mesh_object *object = &model->objects[obj_idx];
-        for (uint32_t grp_idx = 0; grp_idx < object->group_count; grp_idx++) {
-            poc_mesh_group *group = &object->groups[grp_idx];
-            for (uint32_t v_idx = 0; v_idx < group->vertex_count; v_idx++) {
-                glm_vec3_normalize(group->vertices[v_idx].normal);
+    return POC_OBJ_RESULT_SUCCESS;
+}
+
+static void parse_chunk_job(void *user_data) {
+    obj_chunk *chunk = user_data;
+    const char *p = chunk->begin;
+    const char *end = chunk->end;
+
+    chunk->result = POC_OBJ_RESULT_SUCCESS;
+    while (chunk->result == POC_OBJ_RESULT_SUCCESS && p < end) {
+        const char *line_end = memchr(p, '\n', (size_t)(end - p));
+        const char *next = line_end ? line_end + 1 : end;
+        if (!line_end) line_end = end;
+        if (line_end > p && line_end[-1] == '\r') line_end--;
+
+        chunk->result = parse_line(chunk, p, line_end);
+        p = next;
+    }
+}
+
+/**
+ * Fix-up state. The current object is always the last one in the model and
+ * the current group the last one in that object.
+ */
+typedef struct {
+    poc_model *model;
+    const char *dir;
+
+    uint32_t object_capacity;
+    uint32_t group_capacity;       // Of the current object
+    uint32_t material_capacity;
+    uint32_t material_index;
+    uint32_t smoothing_group;
+
+    // Open-addressing table from material names to the index of the first
+    // material defined with that name
+    uint32_t *material_slots;      // Material indices, UINT32_MAX when empty
+    uint32_t material_mask;
+
+    const obj_chunk *chunks;
+    obj_segment *segments;
+    uint32_t segment_count;
+    uint32_t segment_capacity;
+    uint64_t corner_count;         // Face corners before welding
+} obj_fixup;
+
+static poc_mesh_object *fixup_object(obj_fixup *fixup) {
+    return &fixup->model->objects[fixup->model->object_count - 1];
+}
+
+static poc_mesh_group *fixup_group(obj_fixup *fixup) {
+    poc_mesh_object *object = fixup_object(fixup);
+    return &object->groups[object->group_count - 1];
+}
+
+static bool begin_group(obj_fixup *fixup, const char *name, size_t name_length) {
+    poc_mesh_object *object = fixup_object(fixup);
+    if (!grow_array((void **)&object->groups, &fixup->group_capacity,
+                    (uint64_t)object->group_count + 1, sizeof(poc_mesh_group))) {
+        return false;
+    }
+
+    poc_mesh_group *group = &object->groups[object->group_count++];
+    memset(group, 0, sizeof(poc_mesh_group));
+    group->name = poc_string_intern_n(name, name_length);
+    group->material_index = fixup->material_index;
+    group->smoothing_group = fixup->smoothing_group;
+    return true;
+}
+
+// Start an object along with its "default" group
+static bool begin_object(obj_fixup *fixup, const char *name, size_t name_length) {
+    poc_model *model = fixup->model;
+    if (!grow_array((void **)&model->objects, &fixup->object_capacity,
+                    (uint64_t)model->object_count + 1, sizeof(poc_mesh_object))) {
+        return false;
+    }
+
+    poc_mesh_object *object = &model->objects[model->object_count++];
+    memset(object, 0, sizeof(poc_mesh_object));
+    object->name = poc_string_intern_n(name, name_length);
+    fixup->group_capacity = 0;
+
+    return begin_group(fixup, "default", strlen("default"));
+}
+
+// Give faces [face_begin, face_end) of a chunk to the current group
+static bool add_segment(obj_fixup *fixup, const obj_chunk *chunk, uint32_t face_begin, uint32_t face_end) {
+    if (face_begin == face_end) return true;
+
+    uint32_t corner_begin = chunk->faces[face_begin].first_corner;
+    uint32_t corner_end = face_end < chunk->face_count ? chunk->faces[face_end].first_corner : chunk->corner_count;
+    uint64_t corner_count = corner_end - corner_begin;
+    uint64_t index_count = 3 * (corner_count - 2 * (uint64_t)(face_end - face_begin));
+
+    poc_mesh_group *group = fixup_group(fixup);
+    if (group->index_count + index_count > UINT32_MAX) {
+        return false;
+    }
+
+    if (fixup->segment_count == fixup->segment_capacity &&
+        !grow_array((void **)&fixup->segments, &fixup->segment_capacity,
+                    (uint64_t)fixup->segment_count + 1, sizeof(obj_segment))) {
+        return false;
+    }
+
+    poc_mesh_object *object = fixup_object(fixup);
+    fixup->segments[fixup->segment_count++] = (obj_segment){
+        .chunk = (uint32_t)(chunk - fixup->chunks),
+        .object = fixup->model->object_count - 1,
+        .group = object->group_count - 1,
+        .face_begin = face_begin,
+        .face_end = face_end,
+        .index_offset = group->index_count,
+        .index_count = (uint32_t)index_count,
+    };
+
+    group->index_count += (uint32_t)index_count;
+    fixup->corner_count += corner_count;
+    return true;
+}
+
+// --- Material libraries ---
+
+static inline uint32_t hash_material_name(poc_string_id name) {
+    uint32_t hash = name * 0x9E3779B1u;
+    return hash ^ (hash >> 16);
+}
+
+// Slot holding the material named name, or the empty slot where it belongs
+static uint32_t material_slot(const obj_fixup *fixup, poc_string_id name) {
+    const poc_material *materials = fixup->model->materials;
+    uint32_t slot = hash_material_name(name) & fixup->material_mask;
+    while (fixup->material_slots[slot] != UINT32_MAX &&
+           materials[fixup->material_slots[slot]].name != name) {
+        slot = (slot + 1) & fixup->material_mask;
+    }
+    return slot;
+}
+
+// Make a material findable by name. A later material with the same name
+// stays unreachable, as with a linear search.
+static bool add_material_name(obj_fixup *fixup, uint32_t index) {
+    const poc_model *model = fixup->model;
+    uint64_t size = fixup->material_slots ? (uint64_t)fixup->material_mask + 1 : 0;
+
+    // Keep the table at most half full, rebuilding it from the materials
+    if ((uint64_t)model->material_count * 2 > size) {
+        size = size ? size * 2 : 64;
+        if (size > UINT32_MAX) return false;
+        uint32_t *slots = malloc(size * sizeof(uint32_t));
+        if (!slots) return false;
+        memset(slots, 0xFF, size * sizeof(uint32_t));
+        free(fixup->material_slots);
+        fixup->material_slots = slots;
+        fixup->material_mask = (uint32_t)size - 1;
+
+        for (uint32_t i = 0; i < index; i++) {
+            uint32_t slot = material_slot(fixup, model->materials[i].name);
+            if (fixup->material_slots[slot] == UINT32_MAX) {
+                fixup->material_slots[slot] = i;
             }
         }
     }
+
+    uint32_t slot = material_slot(fixup, model->materials[index].name);
+    if (fixup->material_slots[slot] == UINT32_MAX) {
+        fixup->material_slots[slot] = index;
+    }
+    return true;
 }
 
-poc_obj_result poc_model_load(const char *obj_filename, poc_model *model) {
-    memset(model, 0, sizeof(poc_model));
+// Index of the material named name, or UINT32_MAX if no library defines it
+static uint32_t find_material_index(const obj_fixup *fixup, const char *material_name) {
+    // A name that was never interned cannot match any material
+    poc_string_id name;
+    if (!fixup->material_slots || !poc_string_find(material_name, &name)) {
+        return UINT32_MAX;
+    }
+    return fixup->material_slots[material_slot(fixup, name)];
+}
 
-    FILE *file = fopen(obj_filename, "r");
-    if (!file) {
-        return POC_OBJ_RESULT_ERROR_FILE_NOT_FOUND;
+// Scan up to count floats into out; like sscanf(), stops at the first that
+// is missing and keeps the values scanned before it
+static void scan_floats(const char *p, const char *end, float *out, uint32_t count) {
+    for (uint32_t i = 0; i < count && p; i++) {
+        p = scan_float(p, end, &out[i]);
     }
+}
 
-    char line[1024];
-    char *dir = extract_directory(obj_filename);
+/**
+ * Parse one MTL line, without its line break. current is the index of the
+ * material being defined, or UINT32_MAX before the first newmtl.
+ */
+static poc_obj_result parse_mtl_line(obj_fixup *fixup, uint32_t *current, const char *p, const char *end) {
+    p = skip_blanks(p, end);
+    if (p >= end || *p == '#') return POC_OBJ_RESULT_SUCCESS;
 
-    // Current parsing state
-    poc_mesh_object *current_object = NULL;
-    poc_mesh_group *current_group = NULL;
-    uint32_t current_material_index = 0;
-    uint32_t current_smoothing_group = 0;
-
-    // Temporary arrays for face parsing
-    uint32_t *temp_indices = NULL;
-    poc_vertex *temp_vertices = NULL;
-    uint32_t temp_vertex_count = 0;
-    uint32_t temp_index_count = 0;
-    uint32_t temp_capacity = 1024;
-
-    temp_vertices = malloc(temp_capacity * sizeof(poc_vertex));
-    temp_indices = malloc(temp_capacity * sizeof(uint32_t));
-
-    if (!temp_vertices || !temp_indices) {
-        free(temp_vertices);
-        free(temp_indices);
-        free(dir);
-        fclose(file);
-        return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+    const char *keyword = p;
+    while (p < end && !is_blank(*p)) p++;
+    size_t keyword_length = (size_t)(p - keyword);
+
+    poc_model *model = fixup->model;
+    if (keyword_is(keyword, keyword_length, "newmtl")) {
+        const char *name_end;
+        const char *name = trim_argument(p, end, &name_end);
+
+        if (!grow_array((void **)&model->materials, &fixup->material_capacity,
+                        (uint64_t)model->material_count + 1, sizeof(poc_material))) {
+            return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+        }
+
+        poc_material *material = &model->materials[model->material_count];
+        memset(material, 0, sizeof(poc_material));
+
+        // Set default values
+        glm_vec3_copy((vec3){0.2f, 0.2f, 0.2f}, material->ambient);
+        glm_vec3_copy((vec3){0.8f, 0.8f, 0.8f}, material->diffuse);
+        glm_vec3_copy((vec3){1.0f, 1.0f, 1.0f}, material->specular);
+        material->shininess = 32.0f;
+        material->opacity = 1.0f;
+        material->illum_model = 2;
+        material->name = poc_string_intern_n(name, (size_t)(name_end - name));
+
+        *current = model->material_count++;
+        if (!add_material_name(fixup, *current)) {
+            return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+        }
+    } else if (*current != UINT32_MAX) {
+        poc_material *material = &model->materials[*current];
+        if (keyword_is(keyword, keyword_length, "Ka")) {
+            scan_floats(p, end, material->ambient, 3);
+        } else if (keyword_is(keyword, keyword_length, "Kd")) {
+            scan_floats(p, end, material->diffuse, 3);
+        } else if (keyword_is(keyword, keyword_length, "Ks")) {
+            scan_floats(p, end, material->specular, 3);
+        } else if (keyword_is(keyword, keyword_length, "Ns")) {
+            scan_float(p, end, &material->shininess);
+        } else if (keyword_is(keyword, keyword_length, "d")) {
+            scan_float(p, end, &material->opacity);
+        } else if (keyword_is(keyword, keyword_length, "illum")) {
+            int32_t illum;
+            if (scan_int(p, end, &illum)) {
+                material->illum_model = illum;
+            }
+        }
     }
+    return POC_OBJ_RESULT_SUCCESS;
+}
 
-    // Create default object and group for OBJ files without explicit declarations
-    model->objects = malloc(sizeof(poc_mesh_object));
-    if (!model->objects) {
-        free(temp_vertices);
-        free(temp_indices);
-        free(dir);
-        fclose(file);
-        return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+// Append the materials of an MTL library to the model
+static poc_obj_result parse_mtl_file(const char *mtl_filename, obj_fixup *fixup) {
+    // Map rather than open, so libraries in the asset archive are found too
+    poc_file_map map;
+    if (!poc_file_map_open(mtl_filename, &map)) {
+        return POC_OBJ_RESULT_ERROR_MTL_NOT_FOUND;
     }
 
-    current_object = &model->objects[0];
-    memset(current_object, 0, sizeof(poc_mesh_object));
-    strcpy(current_object->name, "default");
-    model->object_count = 1;
+    const char *p = map.data;
+    const char *end = map.data + map.size;
+    uint32_t current = UINT32_MAX;
 
-    current_object->groups = malloc(sizeof(poc_mesh_group));
-    if (!current_object->groups) {
-        free(model->objects);
-        free(temp_vertices);
-        free(temp_indices);
-        free(dir);
-        fclose(file);
-        return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+    poc_obj_result result = POC_OBJ_RESULT_SUCCESS;
+    while (result == POC_OBJ_RESULT_SUCCESS && p < end) {
+        const char *line_end = memchr(p, '\n', (size_t)(end - p));
+        const char *next = line_end ? line_end + 1 : end;
+        if (!line_end) line_end = end;
+        if (line_end > p && line_end[-1] == '\r') line_end--;
+
+        result = parse_mtl_line(fixup, &current, p, line_end);
+        p = next;
     }
 
-    current_group = &current_object->groups[0];
-    memset(current_group, 0, sizeof(poc_mesh_group));
-    strcpy(current_group->name, "default");
-    current_object->group_count = 1;
+    poc_file_map_close(&map);
+    return result;
+}
 
-    while (fgets(line, sizeof(line), file)) {
-        line[strcspn(line, "\n")] = '\0';
+static poc_obj_result apply_statement(obj_fixup *fixup, const obj_statement *statement) {
+    poc_model *model = fixup->model;
+
+    switch (statement->type) {
+        case OBJ_STATEMENT_OBJECT:
+            if (!begin_object(fixup, statement->argument, statement->length)) {
+                return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+            }
+            break;
+        case OBJ_STATEMENT_GROUP:
+            if (!begin_group(fixup, statement->argument, statement->length)) {
+                return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+            }
+            break;
+        case OBJ_STATEMENT_SMOOTHING:
+            fixup->smoothing_group = statement->smoothing_group;
+            fixup_group(fixup)->smoothing_group = fixup->smoothing_group;
+            break;
+        case OBJ_STATEMENT_MATERIAL: {
+            char *material_name = copy_range(statement->argument, statement->argument + statement->length);
+            if (!material_name) return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+            fixup->material_index = find_material_index(fixup, material_name);
+            if (fixup->material_index == UINT32_MAX) {
+                printf("Warning: Material '%s' not found, using the default material\n", material_name);
+            }
+            fixup_group(fixup)->material_index = fixup->material_index;
+            free(material_name);
+            break;
+        }
+        case OBJ_STATEMENT_MTLLIB: {
+            size_t dir_length = strlen(fixup->dir);
+            char *mtl_filename = malloc(dir_length + statement->length + 1);
+            if (!mtl_filename) return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+            memcpy(mtl_filename, fixup->dir, dir_length);
+            memcpy(mtl_filename + dir_length, statement->argument, statement->length);
+            mtl_filename[dir_length + statement->length] = '\0';
 
-        if (strncmp(line, "mtllib ", 7) == 0) {
-            char mtl_filename[512];
-            snprintf(mtl_filename, sizeof(mtl_filename), "%s%s", dir, line + 7);
-            poc_obj_result mtl_result = parse_mtl_file(mtl_filename, model);
+            poc_obj_result mtl_result = parse_mtl_file(mtl_filename, fixup);
+            if (mtl_result == POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY) {
+                free(mtl_filename);
+                return mtl_result;
+            }
             if (mtl_result != POC_OBJ_RESULT_SUCCESS) {
                 printf("Warning: Could not load MTL file: %s\n", mtl_filename);
             }
-        } else if (strncmp(line, "v ", 2) == 0) {
-            vec3 pos;
-            if (sscanf(line + 2, "%f %f %f", &pos[0], &pos[1], &pos[2]) == 3) {
-                model->positions = realloc(model->positions,
-                    (model->position_count + 1) * sizeof(vec3));
-                if (!model->positions) {
-                    free(temp_vertices);
-                    free(temp_indices);
-                    free(dir);
-                    fclose(file);
-                    return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
-                }
-                glm_vec3_copy(pos, model->positions[model->position_count]);
-                model->position_count++;
+
+            // Remember the library so caches and watchers can track it too
+            poc_string_id *libraries = realloc(model->material_libraries,
+                                               (model->material_library_count + 1) * sizeof(poc_string_id));
+            if (!libraries) {
+                free(mtl_filename);
+                return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
             }
-        } else if (strncmp(line, "vt ", 3) == 0) {
-            vec2 tc;
-            if (sscanf(line + 3, "%f %f", &tc[0], &tc[1]) == 2) {
-                model->texcoords = realloc(model->texcoords,
-                    (model->texcoord_count + 1) * sizeof(vec2));
-                if (!model->texcoords) {
-                    free(temp_vertices);
-                    free(temp_indices);
-                    free(dir);
-                    fclose(file);
-                    return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
-                }
-                glm_vec2_copy(tc, model->texcoords[model->texcoord_count]);
-                model->texcoord_count++;
+            model->material_libraries = libraries;
+            model->material_libraries[model->material_library_count++] = poc_string_intern(mtl_filename);
+            free(mtl_filename);
+            break;
+        }
+    }
+    return POC_OBJ_RESULT_SUCCESS;
+}
+
+// Join the chunks' attribute arrays and note where each chunk starts
+static bool gather_attributes(poc_model *model, obj_chunk *chunks, uint32_t chunk_count) {
+    uint64_t position_total = 0, normal_total = 0, texcoord_total = 0;
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        chunks[i].position_base = (uint32_t)position_total;
+        chunks[i].normal_base = (uint32_t)normal_total;
+        chunks[i].texcoord_base = (uint32_t)texcoord_total;
+        position_total += chunks[i].position_count;
+        normal_total += chunks[i].normal_count;
+        texcoord_total += chunks[i].texcoord_count;
+    }
+    if (position_total > UINT32_MAX || normal_total > UINT32_MAX || texcoord_total > UINT32_MAX) {
+        return false;
+    }
+
+    // A single chunk hands its arrays over as they are
+    if (chunk_count == 1) {
+        model->positions = chunks[0].positions;
+        model->normals = chunks[0].normals;
+        model->texcoords = chunks[0].texcoords;
+        chunks[0].positions = NULL;
+        chunks[0].normals = NULL;
+        chunks[0].texcoords = NULL;
+    } else {
+        model->positions = position_total ? malloc(position_total * sizeof(vec3)) : NULL;
+        model->normals = normal_total ? malloc(normal_total * sizeof(vec3)) : NULL;
+        model->texcoords = texcoord_total ? malloc(texcoord_total * sizeof(vec2)) : NULL;
+        if ((position_total && !model->positions) || (normal_total && !model->normals) ||
+            (texcoord_total && !model->texcoords)) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < chunk_count; i++) {
+            obj_chunk *chunk = &chunks[i];
+            if (chunk->position_count) {
+                memcpy(model->positions[chunk->position_base], chunk->positions, chunk->position_count * sizeof(vec3));
             }
-        } else if (strncmp(line, "vn ", 3) == 0) {
-            vec3 norm;
-            if (sscanf(line + 3, "%f %f %f", &norm[0], &norm[1], &norm[2]) == 3) {
-                model->normals = realloc(model->normals,
-                    (model->normal_count + 1) * sizeof(vec3));
-                if (!model->normals) {
-                    free(temp_vertices);
-                    free(temp_indices);
-                    free(dir);
-                    fclose(file);
-                    return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
-                }
-                glm_vec3_copy(norm, model->normals[model->normal_count]);
-                model->normal_count++;
+            if (chunk->normal_count) {
+                memcpy(model->normals[chunk->normal_base], chunk->normals, chunk->normal_count * sizeof(vec3));
             }
-        } else if (strncmp(line, "o ", 2) == 0) {
-            // Finalize current group if any
-            if (current_group && temp_vertex_count > 0) {
-                current_group->vertices = malloc(temp_vertex_count * sizeof(poc_vertex));
-                current_group->indices = malloc(temp_index_count * sizeof(uint32_t));
-                if (!current_group->vertices || !current_group->indices) {
-                    free(temp_vertices);
-                    free(temp_indices);
-                    free(dir);
-                    fclose(file);
-                    return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
-                }
-                memcpy(current_group->vertices, temp_vertices, temp_vertex_count * sizeof(poc_vertex));
-                memcpy(current_group->indices, temp_indices, temp_index_count * sizeof(uint32_t));
-                current_group->vertex_count = temp_vertex_count;
-                current_group->index_count = temp_index_count;
-                temp_vertex_count = 0;
-                temp_index_count = 0;
+            if (chunk->texcoord_count) {
+                memcpy(model->texcoords[chunk->texcoord_base], chunk->texcoords, chunk->texcoord_count * sizeof(vec2));
             }
+        }
+    }
+
+    model->position_count = (uint32_t)position_total;
+    model->normal_count = (uint32_t)normal_total;
+    model->texcoord_count = (uint32_t)texcoord_total;
+    return true;
+}
+
+/**
+ * Serial fix-up: replay the statements in file order, split the faces into
+ * group segments and size every group.
+ */
+static poc_obj_result fix_up_chunks(obj_fixup *fixup, obj_chunk *chunks, uint32_t chunk_count) {
+    poc_model *model = fixup->model;
+
+    // Create default object and group for OBJ files without explicit declarations
+    if (!begin_object(fixup, "default", strlen("default"))) {
+        return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        obj_chunk *chunk = &chunks[i];
+        chunk->first_segment = fixup->segment_count;
 
-            // Create new object
-            model->objects = realloc(model->objects,
-                (model->object_count + 1) * sizeof(poc_mesh_object));
-            if (!model->objects) {
-                free(temp_vertices);
-                free(temp_indices);
-                free(dir);
-                fclose(file);
+        uint32_t face = 0;
+        for (uint32_t s = 0; s < chunk->statement_count; s++) {
+            const obj_statement *statement = &chunk->statements[s];
+            if (!add_segment(fixup, chunk, face, statement->face)) {
                 return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
             }
+            face = statement->face;
+
+            poc_obj_result result = apply_statement(fixup, statement);
+            if (result != POC_OBJ_RESULT_SUCCESS) return result;
+        }
+        if (!add_segment(fixup, chunk, face, chunk->face_count)) {
+            return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+        }
+
+        chunk->segment_count = fixup->segment_count - chunk->first_segment;
+    }
+
+    if (!gather_attributes(model, chunks, chunk_count)) {
+        return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (uint32_t i = 0; i < model->object_count; i++) {
+        poc_mesh_object *object = &model->objects[i];
+        for (uint32_t j = 0; j < object->group_count; j++) {
+            poc_mesh_group *group = &object->groups[j];
+            if (group->index_count == 0) continue;
 
-            current_object = &model->objects[model->object_count];
-            memset(current_object, 0, sizeof(poc_mesh_object));
-            strncpy(current_object->name, line + 2, sizeof(current_object->name) - 1);
-            model->object_count++;
-
-            // Create default group for the object
-            current_object->groups = malloc(sizeof(poc_mesh_group));
-            if (!current_object->groups) {
-                free(temp_vertices);
-                free(temp_indices);
-                free(dir);
-                fclose(file);
+            group->indices = malloc(group->index_count * sizeof(uint32_t));
+            if (!group->indices) {
                 return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
             }
-            current_group = &current_object->groups[0];
-            memset(current_group, 0, sizeof(poc_mesh_group));
-            strcpy(current_group->name, "default");
-            current_group->material_index = current_material_index;
-            current_group->smoothing_group = current_smoothing_group;
-            current_object->group_count = 1;
-        } else if (strncmp(line, "g ", 2) == 0) {
-            // Finalize current group if any
-            if (current_group && temp_vertex_count > 0) {
-                current_group->vertices = malloc(temp_vertex_count * sizeof(poc_vertex));
-                current_group->indices = malloc(temp_index_count * sizeof(uint32_t));
-                if (!current_group->vertices || !current_group->indices) {
-                    free(temp_vertices);
-                    free(temp_indices);
-                    free(dir);
-                    fclose(file);
-                    return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
-                }
-                memcpy(current_group->vertices, temp_vertices, temp_vertex_count * sizeof(poc_vertex));
-                memcpy(current_group->indices, temp_indices, temp_index_count * sizeof(uint32_t));
-                current_group->vertex_count = temp_vertex_count;
-                current_group->index_count = temp_index_count;
-                temp_vertex_count = 0;
-                temp_index_count = 0;
+        }
+    }
+
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        chunks[i].model = model;
+        chunks[i].segments = fixup->segments;
+    }
+    return POC_OBJ_RESULT_SUCCESS;
+}
+
+// Run a job for every item of an array, the first one on the calling thread
+static void run_jobs(poc_job_fn fn, void *items, uint32_t count, size_t stride) {
+    char *item = items;
+    poc_job_counter counter = {0};
+    for (uint32_t i = 1; i < count; i++) {
+        if (!poc_job_submit(fn, item + i * stride, &counter)) {
+            fn(item + i * stride);
+        }
+    }
+    fn(item);
+    if (count > 1) {
+        poc_job_wait(&counter);
+    }
+}
+
+// Resolve an OBJ index against the count of attributes read before it:
+// 1-based, or negative to count back from the newest. Returns UINT32_MAX if
+// the index is absent or out of range.
+static inline uint32_t resolve_index(int32_t index, uint32_t count) {
+    int64_t resolved = index > 0 ? (int64_t)index - 1 : (int64_t)count + index;
+    return resolved >= 0 && resolved < count ? (uint32_t)resolved : UINT32_MAX;
+}
+
+// Faces that are close in the file mostly use nearby positions, so the slot
+// follows the position index to keep probes in cache. Sixteen slots per
+// position, picked by the texcoord and normal, leave room for the corners
+// that share a position but not their attributes.
+static inline uint32_t hash_triple(const uint32_t triple[3]) {
+    uint32_t attributes = triple[1] * 0x9E3779B1u ^ triple[2] * 0x85EBCA77u;
+    return triple[0] * 16u + (attributes >> 28);
+}
+
+/**
+ * Open-addressing table from (v, vt, vn) triples to ids. The triples are kept
+ * by the caller in an array indexed by id.
+ */
+typedef struct {
+    uint32_t *slots;            // Ids, UINT32_MAX when empty
+    uint32_t mask;
+    uint32_t capacity;
+} weld_table;
+
+// Empty the table and size it for entries ids
+static bool weld_table_reset(weld_table *table, uint64_t entries) {
+    uint64_t size = 64;
+    while (size < entries * 2) size *= 2;
+    if (size > UINT32_MAX) return false;
+
+    if (size > table->capacity) {
+        uint32_t *slots = realloc(table->slots, size * sizeof(uint32_t));
+        if (!slots) return false;
+        table->slots = slots;
+        table->capacity = (uint32_t)size;
+    }
+
+    table->mask = (uint32_t)size - 1;
+    memset(table->slots, 0xFF, size * sizeof(uint32_t));
+    return true;
+}
+
+// Double the table once it is half full, re-inserting the count ids whose
+// triples are in keys
+static bool weld_table_reserve(weld_table *table, const uint32_t (*keys)[3], uint32_t count) {
+    uint64_t size = (uint64_t)table->mask + 1;
+    if ((uint64_t)count * 2 < size) return true;
+
+    size *= 2;
+    if (size > UINT32_MAX) return false;
+    if (size > table->capacity) {
+        uint32_t *slots = realloc(table->slots, size * sizeof(uint32_t));
+        if (!slots) return false;
+        table->slots = slots;
+        table->capacity = (uint32_t)size;
+    }
+
+    table->mask = (uint32_t)size - 1;
+    memset(table->slots, 0xFF, size * sizeof(uint32_t));
+    for (uint32_t id = 0; id < count; id++) {
+        uint32_t slot = hash_triple(keys[id]) & table->mask;
+        while (table->slots[slot] != UINT32_MAX) {
+            slot = (slot + 1) & table->mask;
+        }
+        table->slots[slot] = id;
+    }
+    return true;
+}
+
+// Find a triple, or add it with id next_id. The caller stores the triple at
+// keys[next_id] when that id comes back.
+static inline uint32_t weld_table_insert(weld_table *table, const uint32_t (*keys)[3], const uint32_t triple[3],
+                                         uint32_t next_id) {
+    uint32_t slot = hash_triple(triple) & table->mask;
+    for (;;) {
+        uint32_t id = table->slots[slot];
+        if (id == UINT32_MAX) {
+            table->slots[slot] = next_id;
+            return next_id;
+        }
+        if (keys[id][0] == triple[0] && keys[id][1] == triple[1] && keys[id][2] == triple[2]) {
+            return id;
+        }
+        slot = (slot + 1) & table->mask;
+    }
+}
+
+/**
+ * Weld the corners of one segment into distinct triples, appended to the
+ * chunk's list, and write its fan triangles as indices into that list.
+ */
+static bool weld_segment(obj_chunk *chunk, obj_segment *segment, weld_table *table) {
+    const poc_model *model = chunk->model;
+    poc_mesh_group *group = &model->objects[segment->object].groups[segment->group];
+    uint32_t corner_begin = chunk->faces[segment->face_begin].first_corner;
+    uint32_t corner_end = segment->face_end < chunk->face_count ?
+        chunk->faces[segment->face_end].first_corner : chunk->corner_count;
+    uint32_t corner_count = corner_end - corner_begin;
+
+    // Reserve the triples for the worst case of no shared corners (untouched
+    // pages cost nothing), but size the table for the usual sharing and let
+    // it grow
+    if (!grow_array((void **)&chunk->uniques, &chunk->unique_capacity,
+                    (uint64_t)chunk->unique_count + corner_count, sizeof(chunk->uniques[0])) ||
+        !weld_table_reset(table, corner_count / 4)) {
+        return false;
+    }
+
+    uint32_t (*keys)[3] = &chunk->uniques[chunk->unique_count];
+    uint32_t key_count = 0;
+    uint32_t *index = &group->indices[segment->index_offset];
+
+    for (uint32_t f = segment->face_begin; f < segment->face_end; f++) {
+        const obj_face *face = &chunk->faces[f];
+        uint32_t face_end = f + 1 < chunk->face_count ? chunk->faces[f + 1].first_corner : chunk->corner_count;
+        uint32_t position_count = chunk->position_base + face->position_count;
+        uint32_t texcoord_count = chunk->texcoord_base + face->texcoord_count;
+        uint32_t normal_count = chunk->normal_base + face->normal_count;
+
+        uint32_t first = 0;
+        uint32_t previous = 0;
+        for (uint32_t c = face->first_corner; c < face_end; c++) {
+            const int32_t *corner = chunk->corners[c];
+            uint32_t triple[3] = {
+                resolve_index(corner[0], position_count),
+                resolve_index(corner[1], texcoord_count),
+                resolve_index(corner[2], normal_count),
+            };
+
+            if (!weld_table_reserve(table, (const uint32_t (*)[3])keys, key_count)) {
+                return false;
+            }
+            uint32_t id = weld_table_insert(table, (const uint32_t (*)[3])keys, triple, key_count);
+            if (id == key_count) {
+                memcpy(keys[key_count++], triple, sizeof(triple));
             }
 
-            // Ensure we have an object
-            if (!current_object) {
-                model->objects = realloc(model->objects,
-                    (model->object_count + 1) * sizeof(poc_mesh_object));
-                if (!model->objects) {
-                    free(temp_vertices);
-                    free(temp_indices);
-                    free(dir);
-                    fclose(file);
-                    return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+            // Triangulate as a fan around the first corner
+            if (c == face->first_corner) {
+                first = id;
+            } else if (c >= face->first_corner + 2) {
+                *index++ = first;
+                *index++ = previous;
+                *index++ = id;
+            }
+            previous = id;
+        }
+    }
+
+    segment->unique_begin = chunk->unique_count;
+    segment->unique_count = key_count;
+    chunk->unique_count += key_count;
+    return true;
+}
+
+static void weld_chunk_job(void *user_data) {
+    obj_chunk *chunk = user_data;
+    weld_table table = {0};
+
+    for (uint32_t s = 0; s < chunk->segment_count; s++) {
+        if (!weld_segment(chunk, &chunk->segments[chunk->first_segment + s], &table)) {
+            chunk->result = POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+    }
+
+    free(table.slots);
+}
+
+// The segments of one group, merged by weld_group_job()
+typedef struct {
+    poc_mesh_group *group;
+    obj_chunk *chunks;
+    obj_segment **segments;     // In file order
+    uint32_t segment_count;
+    poc_obj_result result;
+} obj_weld_group;
+
+/**
+ * Merge the distinct triples of a group's segments into the group's
+ * vertices, in file order, and note the vertex each triple became.
+ */
+static void weld_group_job(void *user_data) {
+    obj_weld_group *weld = user_data;
+    poc_mesh_group *group = weld->group;
+
+    uint64_t total = 0;
+    for (uint32_t s = 0; s < weld->segment_count; s++) {
+        total += weld->segments[s]->unique_count;
+    }
+
+    uint32_t vertex_count = 0;
+    if (weld->segment_count == 1) {
+        // Nothing to merge: the segment's triples are the group's vertices
+        obj_segment *segment = weld->segments[0];
+        obj_chunk *chunk = &weld->chunks[segment->chunk];
+        for (uint32_t u = 0; u < segment->unique_count; u++) {
+            chunk->unique_vertices[segment->unique_begin + u] = u;
+        }
+        segment->new_begin = 0;
+        vertex_count = segment->unique_count;
+    } else {
+        weld_table table = {0};
+        uint32_t (*keys)[3] = total ? malloc(total * sizeof(keys[0])) : NULL;
+        if ((total && !keys) || !weld_table_reset(&table, total)) {
+            free(keys);
+            free(table.slots);
+            weld->result = POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+            return;
+        }
+
+        for (uint32_t s = 0; s < weld->segment_count; s++) {
+            obj_segment *segment = weld->segments[s];
+            obj_chunk *chunk = &weld->chunks[segment->chunk];
+            segment->new_begin = vertex_count;
+
+            for (uint32_t u = 0; u < segment->unique_count; u++) {
+                const uint32_t *triple = chunk->uniques[segment->unique_begin + u];
+                uint32_t id = weld_table_insert(&table, (const uint32_t (*)[3])keys, triple, vertex_count);
+                if (id == vertex_count) {
+                    memcpy(keys[vertex_count++], triple, sizeof(keys[0]));
                 }
-                current_object = &model->objects[model->object_count];
-                memset(current_object, 0, sizeof(poc_mesh_object));
-                strcpy(current_object->name, "default");
-                model->object_count++;
+                chunk->unique_vertices[segment->unique_begin + u] = id;
             }
+        }
 
-            // Create new group
-            current_object->groups = realloc(current_object->groups,
-                (current_object->group_count + 1) * sizeof(poc_mesh_group));
-            if (!current_object->groups) {
-                free(temp_vertices);
-                free(temp_indices);
-                free(dir);
-                fclose(file);
-                return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+        free(keys);
+        free(table.slots);
+    }
+
+    group->vertex_count = vertex_count;
+    group->vertices = vertex_count ? malloc(vertex_count * sizeof(poc_vertex)) : NULL;
+    if (vertex_count && !group->vertices) {
+        weld->result = POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+    }
+}
+
+/**
+ * Point a chunk's indices at group vertices and fill in the vertices its
+ * segments introduced.
+ */
+static void fill_chunk_job(void *user_data) {
+    obj_chunk *chunk = user_data;
+    const poc_model *model = chunk->model;
+
+    for (uint32_t s = 0; s < chunk->segment_count; s++) {
+        const obj_segment *segment = &chunk->segments[chunk->first_segment + s];
+        poc_mesh_group *group = &model->objects[segment->object].groups[segment->group];
+        const uint32_t *vertex_of = &chunk->unique_vertices[segment->unique_begin];
+
+        uint32_t *indices = &group->indices[segment->index_offset];
+        for (uint32_t i = 0; i < segment->index_count; i++) {
+            indices[i] = vertex_of[indices[i]];
+        }
+
+        for (uint32_t u = 0; u < segment->unique_count; u++) {
+            uint32_t id = vertex_of[u];
+            if (id < segment->new_begin) continue;    // Introduced by an earlier segment
+
+            const uint32_t *triple = chunk->uniques[segment->unique_begin + u];
+            poc_vertex *vertex = &group->vertices[id];
+
+            if (triple[0] != UINT32_MAX) {
+                glm_vec3_copy(model->positions[triple[0]], vertex->position);
+            } else {
+                glm_vec3_zero(vertex->position);
             }
 
-            current_group = &current_object->groups[current_object->group_count];
-            memset(current_group, 0, sizeof(poc_mesh_group));
-            strncpy(current_group->name, line + 2, sizeof(current_group->name) - 1);
-            current_group->material_index = current_material_index;
-            current_group->smoothing_group = current_smoothing_group;
-            current_object->group_count++;
-        } else if (strncmp(line, "usemtl ", 7) == 0) {
-            current_material_index = find_material_index(model, line + 7);
-            if (current_group) {
-                current_group->material_index = current_material_index;
+            if (triple[1] != UINT32_MAX) {
+                glm_vec2_copy(model->texcoords[triple[1]], vertex->texcoord);
+            } else {
+                glm_vec2_zero(vertex->texcoord);
             }
-        } else if (strncmp(line, "s ", 2) == 0) {
-            if (strcmp(line + 2, "off") == 0) {
-                current_smoothing_group = 0;
+
+            if (triple[2] != UINT32_MAX) {
+                glm_vec3_copy(model->normals[triple[2]], vertex->normal);
             } else {
-                current_smoothing_group = atoi(line + 2);
+                glm_vec3_zero(vertex->normal);
             }
-            if (current_group) {
-                current_group->smoothing_group = current_smoothing_group;
+        }
+    }
+}
+
+/**
+ * Weld every group: chunks in parallel, then groups in parallel, then chunks
+ * again.
+ */
+static poc_obj_result weld_chunks(poc_model *model, obj_chunk *chunks, uint32_t chunk_count,
+                                  obj_segment *segments, uint32_t segment_count) {
+    run_jobs(weld_chunk_job, chunks, chunk_count, sizeof(obj_chunk));
+
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        obj_chunk *chunk = &chunks[i];
+        if (chunk->result != POC_OBJ_RESULT_SUCCESS) return chunk->result;
+
+        chunk->unique_vertices = chunk->unique_count ? malloc(chunk->unique_count * sizeof(uint32_t)) : NULL;
+        if (chunk->unique_count && !chunk->unique_vertices) return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+    }
+
+    // Number the groups and bucket the segments by group, keeping file order
+    uint32_t *group_base = malloc((model->object_count + 1) * sizeof(uint32_t));
+    if (!group_base) return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+    group_base[0] = 0;
+    for (uint32_t i = 0; i < model->object_count; i++) {
+        group_base[i + 1] = group_base[i] + model->objects[i].group_count;
+    }
+    uint32_t group_count = group_base[model->object_count];
+
+    obj_weld_group *welds = calloc(group_count, sizeof(obj_weld_group));
+    obj_segment **bucketed = segment_count ? malloc(segment_count * sizeof(obj_segment *)) : NULL;
+    if (!welds || (segment_count && !bucketed)) {
+        free(group_base);
+        free(welds);
+        free(bucketed);
+        return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (uint32_t s = 0; s < segment_count; s++) {
+        welds[group_base[segments[s].object] + segments[s].group].segment_count++;
+    }
+
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < model->object_count; i++) {
+        for (uint32_t j = 0; j < model->objects[i].group_count; j++) {
+            obj_weld_group *weld = &welds[group_base[i] + j];
+            weld->group = &model->objects[i].groups[j];
+            weld->chunks = chunks;
+            weld->segments = &bucketed[offset];
+            offset += weld->segment_count;
+            weld->segment_count = 0;
+        }
+    }
+
+    for (uint32_t s = 0; s < segment_count; s++) {
+        obj_weld_group *weld = &welds[group_base[segments[s].object] + segments[s].group];
+        weld->segments[weld->segment_count++] = &segments[s];
+    }
+
+    // Only groups with faces get a job
+    uint32_t weld_count = 0;
+    for (uint32_t g = 0; g < group_count; g++) {
+        if (welds[g].segment_count > 0) {
+            welds[weld_count++] = welds[g];
+        }
+    }
+
+    poc_obj_result result = POC_OBJ_RESULT_SUCCESS;
+    if (weld_count > 0) {
+        run_jobs(weld_group_job, welds, weld_count, sizeof(obj_weld_group));
+    }
+    for (uint32_t g = 0; g < weld_count && result == POC_OBJ_RESULT_SUCCESS; g++) {
+        result = welds[g].result;
+    }
+
+    free(group_base);
+    free(welds);
+    free(bucketed);
+
+    if (result == POC_OBJ_RESULT_SUCCESS) {
+        run_jobs(fill_chunk_job, chunks, chunk_count, sizeof(obj_chunk));
+    }
+    return result;
+}
+
+static uint32_t choose_chunk_count(size_t size) {
+    uint64_t count = atomic_load_explicit(&g_chunk_count_override, memory_order_relaxed);
+    if (count == 0) {
+        if (size < 2 * (size_t)OBJ_MIN_CHUNK_BYTES) return 1;
+        count = (uint64_t)(poc_jobs_get_worker_count() + 1) * OBJ_CHUNKS_PER_THREAD;
+        if (count > size / OBJ_MIN_CHUNK_BYTES) count = size / OBJ_MIN_CHUNK_BYTES;
+    }
+    // Every chunk needs at least one byte
+    if (count > size) count = size;
+    return count > 0 ? (uint32_t)count : 1;
+}
+
+static void free_chunk(obj_chunk *chunk) {
+    free(chunk->positions);
+    free(chunk->normals);
+    free(chunk->texcoords);
+    free(chunk->faces);
+    free(chunk->corners);
+    free(chunk->statements);
+    free(chunk->uniques);
+    free(chunk->unique_vertices);
+}
+
+void poc_obj_set_chunk_count(uint32_t chunk_count) {
+    atomic_store_explicit(&g_chunk_count_override, chunk_count, memory_order_relaxed);
+}
+
+// --- Normal generation ---
+//
+// Corners without a "vn" are welded with a zero normal. Only groups that
+// have such vertices get normals generated, and only those vertices are
+// written, so normals from the file are never replaced. Face normals are
+// area weighted (the unnormalized cross product) and summed per smoothing
+// id: in a smoothing group every vertex at the same position shares one id,
+// so the surface stays smooth across texture seams; with smoothing off a
+// vertex only averages the faces that use it. Triangles are split across
+// jobs, each summing into its own array, and the arrays are then added up
+// in parallel over ids.
+
+#define NORMAL_TRIANGLES_PER_JOB 16384
+
+typedef struct {
+    const poc_mesh_group *group;
+    const uint32_t *smoothing_ids;  // Vertex -> smoothing id, NULL when ids are vertex indices
+    vec3 **partials;                // One accumulator per accumulate job
+    uint32_t partial_count;
+    uint32_t partial;               // This job's accumulator
+    uint32_t begin;                 // Triangle, id or vertex range, by phase
+    uint32_t end;
+} normal_job;
+
+static inline bool is_zero_normal(const vec3 normal) {
+    return normal[0] == 0.0f && normal[1] == 0.0f && normal[2] == 0.0f;
+}
+
+static inline uint32_t hash_position(const vec3 position) {
+    uint32_t bits[3];
+    // Adding zero folds -0.0 into 0.0, which compares equal
+    for (int i = 0; i < 3; i++) {
+        float value = position[i] + 0.0f;
+        memcpy(&bits[i], &value, sizeof(float));
+    }
+    return (bits[0] * 0x8DA6B343u) ^ (bits[1] * 0xD8163841u) ^ (bits[2] * 0xCB1AB31Fu);
+}
+
+// Give vertices that share a position the same id. Returns the id count, or
+// 0 if out of memory.
+static uint32_t weld_positions(const poc_mesh_group *group, uint32_t *ids) {
+    weld_table table = {0};
+    if (!weld_table_reset(&table, group->vertex_count)) {
+        return 0;
+    }
+
+    // Slots hold the first vertex at a position; its id is looked up in ids
+    uint32_t count = 0;
+    for (uint32_t v = 0; v < group->vertex_count; v++) {
+        const float *position = group->vertices[v].position;
+        uint32_t slot = hash_position(position) & table.mask;
+        for (;;) {
+            uint32_t first = table.slots[slot];
+            if (first == UINT32_MAX) {
+                table.slots[slot] = v;
+                ids[v] = count++;
+                break;
             }
-        } else if (strncmp(line, "f ", 2) == 0) {
-            // Ensure we have an object and group
-            if (!current_object) {
-                model->objects = realloc(model->objects,
-                    (model->object_count + 1) * sizeof(poc_mesh_object));
-                if (!model->objects) {
-                    free(temp_vertices);
-                    free(temp_indices);
-                    free(dir);
-                    fclose(file);
-                    return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
-                }
-                current_object = &model->objects[model->object_count];
-                memset(current_object, 0, sizeof(poc_mesh_object));
-                strcpy(current_object->name, "default");
-                model->object_count++;
-
-                current_object->groups = malloc(sizeof(poc_mesh_group));
-                if (!current_object->groups) {
-                    free(temp_vertices);
-                    free(temp_indices);
-                    free(dir);
-                    fclose(file);
-                    return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
-                }
-                current_group = &current_object->groups[0];
-                memset(current_group, 0, sizeof(poc_mesh_group));
-                strcpy(current_group->name, "default");
-                current_group->material_index = current_material_index;
-                current_group->smoothing_group = current_smoothing_group;
-                current_object->group_count = 1;
+            const float *other = group->vertices[first].position;
+            if (other[0] == position[0] && other[1] == position[1] && other[2] == position[2]) {
+                ids[v] = ids[first];
+                break;
             }
+            slot = (slot + 1) & table.mask;
+        }
+    }
 
-            // Parse face (supporting triangles only for now)
-            char *face_data = line + 2;
-            uint32_t face_vertices[3];
-            uint32_t vertex_count = 0;
-
-            char *token = strtok(face_data, " ");
-            while (token && vertex_count < 3) {
-                int v_idx = 0, vt_idx = 0, vn_idx = 0;
-
-                if (sscanf(token, "%d/%d/%d", &v_idx, &vt_idx, &vn_idx) == 3) {
-                    // v/vt/vn format
-                } else if (sscanf(token, "%d//%d", &v_idx, &vn_idx) == 2) {
-                    // v//vn format
-                    vt_idx = 0;
-                } else if (sscanf(token, "%d/%d", &v_idx, &vt_idx) == 2) {
-                    // v/vt format
-                    vn_idx = 0;
-                } else if (sscanf(token, "%d", &v_idx) == 1) {
-                    // v format only
-                    vt_idx = 0;
-                    vn_idx = 0;
-                } else {
-                    free(temp_vertices);
-                    free(temp_indices);
-                    free(dir);
-                    fclose(file);
-                    return POC_OBJ_RESULT_ERROR_INVALID_FORMAT;
-                }
+    free(table.slots);
+    return count;
+}
 
-                // Convert to 0-based indices
-                v_idx = (v_idx > 0) ? v_idx - 1 : (int)model->position_count + v_idx;
-                vt_idx = (vt_idx > 0) ? vt_idx - 1 : (vt_idx < 0) ? (int)model->texcoord_count + vt_idx : -1;
-                vn_idx = (vn_idx > 0) ? vn_idx - 1 : (vn_idx < 0) ? (int)model->normal_count + vn_idx : -1;
-
-                // Create vertex
-                if (temp_vertex_count >= temp_capacity) {
-                    temp_capacity *= 2;
-                    temp_vertices = realloc(temp_vertices, temp_capacity * sizeof(poc_vertex));
-                    temp_indices = realloc(temp_indices, temp_capacity * sizeof(uint32_t));
-                    if (!temp_vertices || !temp_indices) {
-                        free(temp_vertices);
-                        free(temp_indices);
-                        free(dir);
-                        fclose(file);
-                        return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
-                    }
-                }
+static void accumulate_normals_job(void *user_data) {
+    normal_job *job = user_data;
+    const poc_mesh_group *group = job->group;
+    vec3 *sums = job->partials[job->partial];
 
-                poc_vertex *vertex = &temp_vertices[temp_vertex_count];
+    for (uint32_t t = job->begin; t < job->end; t++) {
+        const uint32_t *triangle = &group->indices[t * 3];
+        const float *p0 = group->vertices[triangle[0]].position;
+        const float *p1 = group->vertices[triangle[1]].position;
+        const float *p2 = group->vertices[triangle[2]].position;
 
-                // Position
-                if (v_idx >= 0 && v_idx < (int)model->position_count) {
-                    glm_vec3_copy(model->positions[v_idx], vertex->position);
-                } else {
-                    glm_vec3_zero(vertex->position);
-                }
+        vec3 edge1 = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+        vec3 edge2 = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+        vec3 face_normal;
+        glm_vec3_cross(edge1, edge2, face_normal);
 
-                // Texture coordinates
-                if (vt_idx >= 0 && vt_idx < (int)model->texcoord_count) {
-                    glm_vec2_copy(model->texcoords[vt_idx], vertex->texcoord);
-                } else {
-                    glm_vec2_zero(vertex->texcoord);
-                }
+        for (int c = 0; c < 3; c++) {
+            uint32_t id = job->smoothing_ids ? job->smoothing_ids[triangle[c]] : triangle[c];
+            glm_vec3_add(sums[id], face_normal, sums[id]);
+        }
+    }
+}
 
-                // Normal
-                if (vn_idx >= 0 && vn_idx < (int)model->normal_count) {
-                    glm_vec3_copy(model->normals[vn_idx], vertex->normal);
-                } else {
-                    glm_vec3_zero(vertex->normal);
-                }
+static void resolve_normals_job(void *user_data) {
+    normal_job *job = user_data;
+    vec3 *sums = job->partials[0];
 
-                face_vertices[vertex_count] = temp_vertex_count;
-                temp_vertex_count++;
-                vertex_count++;
+    for (uint32_t id = job->begin; id < job->end; id++) {
+        for (uint32_t p = 1; p < job->partial_count; p++) {
+            glm_vec3_add(sums[id], job->partials[p][id], sums[id]);
+        }
+        glm_vec3_normalize(sums[id]);
+    }
+}
 
-                token = strtok(NULL, " ");
-            }
+static void apply_normals_job(void *user_data) {
+    normal_job *job = user_data;
+    const vec3 *sums = (const vec3 *)job->partials[0];
+    poc_vertex *vertices = job->group->vertices;
 
-            if (vertex_count == 3) {
-                temp_indices[temp_index_count++] = face_vertices[0];
-                temp_indices[temp_index_count++] = face_vertices[1];
-                temp_indices[temp_index_count++] = face_vertices[2];
-            } else {
-                printf("Warning: Face has %u vertices, expected 3\n", vertex_count);
+    for (uint32_t v = job->begin; v < job->end; v++) {
+        if (is_zero_normal(vertices[v].normal)) {
+            uint32_t id = job->smoothing_ids ? job->smoothing_ids[v] : v;
+            glm_vec3_copy((float *)sums[id], vertices[v].normal);
+        }
+    }
+}
+
+// Split [0, count) into at most job_count ranges and run fn over them
+static void run_range_jobs(poc_job_fn fn, normal_job *jobs, uint32_t job_count, uint32_t count) {
+    for (uint32_t j = 0; j < job_count; j++) {
+        jobs[j].partial = j;
+        jobs[j].begin = (uint32_t)((uint64_t)count * j / job_count);
+        jobs[j].end = (uint32_t)((uint64_t)count * (j + 1) / job_count);
+    }
+    run_jobs(fn, jobs, job_count, sizeof(normal_job));
+}
+
+static bool generate_group_normals(poc_mesh_group *group) {
+    uint32_t triangle_count = group->index_count / 3;
+
+    uint32_t *smoothing_ids = NULL;
+    uint32_t id_count = group->vertex_count;
+    if (group->smoothing_group != 0) {
+        smoothing_ids = malloc(group->vertex_count * sizeof(uint32_t));
+        id_count = smoothing_ids ? weld_positions(group, smoothing_ids) : 0;
+        if (id_count == 0) {
+            free(smoothing_ids);
+            return false;
+        }
+    }
+
+    uint64_t wanted = ((uint64_t)triangle_count + NORMAL_TRIANGLES_PER_JOB - 1) / NORMAL_TRIANGLES_PER_JOB;
+    uint32_t job_count = poc_jobs_get_worker_count() + 1;
+    if (wanted < job_count) job_count = wanted > 0 ? (uint32_t)wanted : 1;
+
+    normal_job *jobs = calloc(job_count, sizeof(normal_job));
+    vec3 **partials = calloc(job_count, sizeof(vec3 *));
+    bool ok = jobs && partials;
+    for (uint32_t j = 0; ok && j < job_count; j++) {
+        partials[j] = calloc(id_count, sizeof(vec3));
+        ok = partials[j] != NULL;
+    }
+
+    if (ok) {
+        for (uint32_t j = 0; j < job_count; j++) {
+            jobs[j] = (normal_job){
+                .group = group,
+                .smoothing_ids = smoothing_ids,
+                .partials = partials,
+                .partial_count = job_count,
+            };
+        }
+        run_range_jobs(accumulate_normals_job, jobs, job_count, triangle_count);
+        run_range_jobs(resolve_normals_job, jobs, job_count, id_count);
+        run_range_jobs(apply_normals_job, jobs, job_count, group->vertex_count);
+    }
+
+    for (uint32_t j = 0; partials && j < job_count; j++) {
+        free(partials[j]);
+    }
+    free(partials);
+    free(jobs);
+    free(smoothing_ids);
+    return ok;
+}
+
+void poc_calculate_smooth_normals(poc_model *model) {
+    for (uint32_t obj_idx = 0; obj_idx < model->object_count; obj_idx++) {
+        poc_mesh_object *object = &model->objects[obj_idx];
+        for (uint32_t grp_idx = 0; grp_idx < object->group_count; grp_idx++) {
+            poc_mesh_group *group = &object->groups[grp_idx];
+
+            bool missing = false;
+            for (uint32_t v = 0; v < group->vertex_count && !missing; v++) {
+                missing = is_zero_normal(group->vertices[v].normal);
+            }
+            if (missing && group->index_count >= 3 && !generate_group_normals(group)) {
+                printf("Warning: Out of memory generating normals for group '%s'\n",
+                       poc_string_get(group->name));
             }
         }
     }
+}
 
-    // Finalize last group
-    if (current_group && temp_vertex_count > 0) {
-        current_group->vertices = malloc(temp_vertex_count * sizeof(poc_vertex));
-        current_group->indices = malloc(temp_index_count * sizeof(uint32_t));
-        if (!current_group->vertices || !current_group->indices) {
-            free(temp_vertices);
-            free(temp_indices);
-            free(dir);
-            fclose(file);
-            return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+poc_obj_result poc_model_load(const char *obj_filename, poc_model *model) {
+    memset(model, 0, sizeof(poc_model));
+
+    poc_file_map file;
+    if (!poc_file_map_open(obj_filename, &file)) {
+        return POC_OBJ_RESULT_ERROR_FILE_NOT_FOUND;
+    }
+    poc_file_map_advise_sequential(&file);
+
+    char *dir = extract_directory(obj_filename);
+    uint32_t chunk_count = choose_chunk_count(file.size);
+    obj_chunk *chunks = calloc(chunk_count, sizeof(obj_chunk));
+    if (!dir || !chunks) {
+        free(dir);
+        free(chunks);
+        poc_file_map_close(&file);
+        return POC_OBJ_RESULT_ERROR_OUT_OF_MEMORY;
+    }
+
+    // Cut at the line break following each even split point
+    const char *end = file.data + file.size;
+    const char *begin = file.data;
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        const char *chunk_end = end;
+        if (i + 1 < chunk_count) {
+            chunk_end = file.data + (size_t)((uint64_t)file.size * (i + 1) / chunk_count);
+            if (chunk_end < begin) chunk_end = begin;
+            const char *line_break = memchr(chunk_end, '\n', (size_t)(end - chunk_end));
+            chunk_end = line_break ? line_break + 1 : end;
         }
-        memcpy(current_group->vertices, temp_vertices, temp_vertex_count * sizeof(poc_vertex));
-        memcpy(current_group->indices, temp_indices, temp_index_count * sizeof(uint32_t));
-        current_group->vertex_count = temp_vertex_count;
-        current_group->index_count = temp_index_count;
+        chunks[i].begin = begin;
+        chunks[i].end = chunk_end;
+        begin = chunk_end;
     }
 
-    // Calculate smooth normals for groups that don't have explicit normals
-    poc_calculate_smooth_normals(model);
+    run_jobs(parse_chunk_job, chunks, chunk_count, sizeof(obj_chunk));
+
+    // Report the first failure in file order, as a serial parse would
+    poc_obj_result result = POC_OBJ_RESULT_SUCCESS;
+    for (uint32_t i = 0; i < chunk_count && result == POC_OBJ_RESULT_SUCCESS; i++) {
+        result = chunks[i].result;
+    }
+
+    obj_fixup fixup = {
+        .model = model,
+        .dir = dir,
+        .chunks = chunks,
+    };
+    if (result == POC_OBJ_RESULT_SUCCESS) {
+        result = fix_up_chunks(&fixup, chunks, chunk_count);
+    }
 
-    free(temp_vertices);
-    free(temp_indices);
+    if (result == POC_OBJ_RESULT_SUCCESS) {
+        result = weld_chunks(model, chunks, chunk_count, fixup.segments, fixup.segment_count);
+        model->corner_count = fixup.corner_count;
+    }
+
+    if (result == POC_OBJ_RESULT_SUCCESS) {
+        // Fill in normals for corners the file gave none
+        poc_calculate_smooth_normals(model);
+    } else {
+        poc_model_destroy(model);
+    }
+
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        free_chunk(&chunks[i]);
+    }
+    free(chunks);
+    free(fixup.segments);
+    free(fixup.material_slots);
     free(dir);
-    fclose(file);
+    poc_file_map_close(&file);
 
-    return POC_OBJ_RESULT_SUCCESS;
+    return result;
 }
 
 void poc_model_destroy(poc_model *model) {
@@ -575,6 +1641,7 @@ void poc_model_destroy(poc_model *model) {
 
     // Free materials
     free(model->materials);
+    free(model->material_libraries);
 
     // Free raw data arrays
     free(model->positions);
@@ -11,12 +11,16 @@
  * - Vertex positions (v)
  * - Vertex normals (vn)
  * - Texture coordinates (vt)
- * - Faces with indices (f)
+ * - Faces with indices (f); polygons are split into triangle fans
  * - Objects (o)
  * - Groups (g)
  * - Smoothing groups (s)
  * - Material library references (mtllib)
- * - Material usage (usemtl)
+ * - Material usage (usemtl); a name no library defines leaves the group
+ *   without a material (material_index UINT32_MAX)
+ *
+ * Face corners of a group that use the same position, texcoord and normal
+ * indices share one vertex, so every group gets an indexed vertex buffer.
  *
  * @section supported_mtl Supported MTL Features
  * - Ambient color (Ka)
@@ -26,6 +30,8 @@
  * - Opacity/transparency (d)
  * - Illumination model (illum)
  *
+ * When several materials share a name, usemtl selects the first one.
+ *
  * @section memory_management Memory Management
  * All loaded models must be freed using poc_model_destroy() to prevent memory leaks.
  * The caller is responsible for calling this function when the model is no longer needed.
@@ -46,6 +52,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <cglm/cglm.h>
+#include "string_table.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -76,7 +83,7 @@ typedef struct {
     float shininess;    /**< Shininess exponent (Ns) - specular highlight size */
     float opacity;      /**< Opacity (d) - 1.0 = opaque, 0.0 = transparent */
     int illum_model;    /**< Illumination model (illum) - lighting calculation type */
-    char name[256];     /**< Material name for identification */
+    poc_string_id name; /**< Interned material name */
 } poc_material;
 
 /**
@@ -86,13 +93,13 @@ typedef struct {
  * and smoothing settings. They correspond to 'g' commands in OBJ files.
  */
 typedef struct {
-    poc_vertex *vertices;       /**< Array of vertices for this group */
+    poc_vertex *vertices;       /**< Array of distinct vertices for this group, in order of first use */
     uint32_t *indices;          /**< Array of face indices for this group */
     uint32_t vertex_count;      /**< Number of vertices in the array */
     uint32_t index_count;       /**< Number of indices in the array */
     uint32_t material_index;    /**< Index into the materials array (UINT32_MAX if none) */
     uint32_t smoothing_group;   /**< Smoothing group ID (0 = no smoothing) */
-    char name[256];             /**< Group name from OBJ file */
+    poc_string_id name;         /**< Interned group name from OBJ file */
 } poc_mesh_group;
 
 /**
@@ -104,7 +111,7 @@ typedef struct {
 typedef struct {
     poc_mesh_group *groups;     /**< Array of mesh groups in this object */
     uint32_t group_count;       /**< Number of groups in the array */
-    char name[256];             /**< Object name from OBJ file */
+    poc_string_id name;         /**< Interned object name from OBJ file */
 } poc_mesh_object;
 
 /**
@@ -126,6 +133,11 @@ typedef struct {
     uint32_t position_count;        /**< Number of raw positions */
     uint32_t normal_count;          /**< Number of raw normals */
     uint32_t texcoord_count;        /**< Number of raw texture coordinates */
+
+    uint64_t corner_count;          /**< Face corners read, before welding them into vertices */
+
+    poc_string_id *material_libraries; /**< Interned paths of the MTL files referenced by mtllib */
+    uint32_t material_library_count;   /**< Number of material library paths */
 } poc_model;
 
 /**
@@ -156,6 +168,7 @@ typedef enum {
  *
  * @note The model structure will be initialized even on failure (safe to call poc_model_destroy).
  * @note MTL files are expected to be in the same directory as the OBJ file.
+ * @note Large files are parsed in parallel on the job system threads.
  * @warning Must call poc_model_destroy() when done to free allocated memory.
  *
  * @example
@@ -171,6 +184,19 @@ typedef enum {
  */
 poc_obj_result poc_model_load(const char *obj_filename, poc_model *model);
 
+/**
+ * @brief Override how many chunks poc_model_load() splits a file into
+ *
+ * Files of a few megabytes and up are normally cut at line boundaries into
+ * several chunks per job system thread and parsed in parallel. The model is
+ * the same for any chunk count; the override exists for benchmarking and
+ * debugging.
+ *
+ * @param chunk_count Chunks per file, 1 to parse on the calling thread, or 0
+ *                    to restore the automatic choice
+ */
+void poc_obj_set_chunk_count(uint32_t chunk_count);
+
 /**
  * @brief Free all memory associated with a loaded model
  *
@@ -216,18 +242,20 @@ const char *poc_obj_result_to_string(poc_obj_result result);
 void poc_calculate_face_normal(const vec3 v0, const vec3 v1, const vec3 v2, vec3 normal);
 
 /**
- * @brief Calculate smooth vertex normals for the entire model
+ * @brief Generate vertex normals where the OBJ file supplied none
  *
- * Computes smooth vertex normals by averaging face normals for vertices that
- * are in the same smoothing group. Vertices in smoothing group 0 get face normals
- * (hard edges), while other smoothing groups get averaged normals (smooth edges).
+ * Vertices with a zero normal (face corners without a "vn" index) get the
+ * area-weighted average of the faces around them; normals read from the
+ * file are kept. In a group with a smoothing group set ('s 1' and up),
+ * vertices at the same position share one normal, so UV seams do not show
+ * as hard edges. With smoothing off ('s off' or no 's' at all) each vertex
+ * averages only the faces that use it. Triangles are processed in parallel
+ * on the job system.
  *
  * @param model Pointer to the model to process. Must not be NULL and must be
  *              a valid loaded model.
  *
- * @note This function modifies the normal vectors in the model's vertex data.
- * @note Smoothing groups are specified by 's' commands in OBJ files.
- * @note This is called automatically during model loading if smoothing groups are present.
+ * @note Called automatically by poc_model_load().
  */
 void poc_calculate_smooth_normals(poc_model *model);
 
@@ -5,6 +5,11 @@
 #include <string.h>
 #include <time.h>
 
+#include "frame_loop.h"
+#include "job_system.h"
+#include "file_watch.h"
+#include "asset_archive.h"
+
 #ifdef POC_PLATFORM_LINUX
 #include "vulkan_renderer.h"
 #endif
@@ -58,6 +63,12 @@ poc_result poc_init(const poc_config *config) {
     }
 #endif
 
+    // Mount before contexts load their shaders and scripts load assets; a
+    // missing archive falls back to loose files
+    if (config->archive_path) {
+        poc_archive_mount(config->archive_path);
+    }
+
     // Initialize the application start time
     clock_gettime(CLOCK_MONOTONIC, &g_start_time);
 
@@ -73,6 +84,14 @@ void poc_shutdown(void) {
         return;
     }
 
+    // No more reloads get started once the watcher is gone, and background
+    // jobs finish before any backend state goes away
+    poc_file_watch_stop();
+    poc_jobs_shutdown();
+
+    // Meshes nothing references anymore are kept for reuse until now
+    poc_asset_purge();
+
 #ifdef POC_PLATFORM_LINUX
     if (g_current_renderer == POC_RENDERER_VULKAN) {
         vulkan_shutdown();
@@ -85,6 +104,9 @@ void poc_shutdown(void) {
     }
 #endif
 
+    // Purged meshes no longer point into the archive
+    poc_archive_unmount();
+
     g_initialized = false;
     printf("POC Engine shut down\n");
 }
@@ -233,14 +255,11 @@ const char *poc_result_to_string(poc_result result) {
 }
 
 double poc_get_time(void) {
-    if (!g_initialized) {
-        return 0.0;
-    }
-
     struct timespec current_time;
     clock_gettime(CLOCK_MONOTONIC, &current_time);
 
-    // Calculate elapsed time since application start
+    // Calculate elapsed time since application start; before poc_init() the
+    // start time is zero, so this counts from the clock's own origin
     double elapsed_seconds = (double)(current_time.tv_sec - g_start_time.tv_sec);
     elapsed_seconds += (double)(current_time.tv_nsec - g_start_time.tv_nsec) / 1000000000.0;
 
@@ -380,3 +399,139 @@ bool poc_context_is_play_mode(poc_context *ctx) {
 
     return false;
 }
+
+uint32_t poc_context_get_draw_call_count(poc_context *ctx) {
+    if (!ctx) {
+        return 0;
+    }
+
+#ifdef POC_PLATFORM_LINUX
+    if (g_current_renderer == POC_RENDERER_VULKAN) {
+        return vulkan_context_get_draw_call_count(ctx);
+    }
+#endif
+
+#ifdef POC_PLATFORM_MACOS
+    if (g_current_renderer == POC_RENDERER_METAL) {
+        // TODO: Count Metal draw calls when implemented
+        return 0;
+    }
+#endif
+
+    return 0;
+}
+
+void poc_context_set_cluster_culling(poc_context *ctx, bool enabled) {
+    if (!ctx) {
+        return;
+    }
+
+#ifdef POC_PLATFORM_LINUX
+    if (g_current_renderer == POC_RENDERER_VULKAN) {
+        vulkan_context_set_cluster_culling(ctx, enabled);
+    }
+#endif
+
+#ifdef POC_PLATFORM_MACOS
+    if (g_current_renderer == POC_RENDERER_METAL) {
+        // TODO: Cull clusters once the Metal renderer draws meshes
+        (void)enabled;
+    }
+#endif
+}
+
+void poc_context_get_triangle_counts(poc_context *ctx, uint64_t *submitted, uint64_t *total) {
+    if (submitted) {
+        *submitted = 0;
+    }
+    if (total) {
+        *total = 0;
+    }
+    if (!ctx) {
+        return;
+    }
+
+#ifdef POC_PLATFORM_LINUX
+    if (g_current_renderer == POC_RENDERER_VULKAN) {
+        vulkan_context_get_triangle_counts(ctx, submitted, total);
+    }
+#endif
+}
+
+bool poc_context_supports_snapshots(const poc_context *ctx) {
+    if (!ctx) {
+        return false;
+    }
+
+#ifdef POC_PLATFORM_LINUX
+    if (g_current_renderer == POC_RENDERER_VULKAN) {
+        return true;
+    }
+#endif
+
+    // TODO: Metal snapshot capture and rendering
+    return false;
+}
+
+poc_result poc_context_capture_snapshot(poc_context *ctx, poc_render_snapshot *snapshot) {
+    if (!ctx || !snapshot) {
+        return POC_RESULT_ERROR_INIT_FAILED;
+    }
+
+#ifdef POC_PLATFORM_LINUX
+    if (g_current_renderer == POC_RENDERER_VULKAN) {
+        return vulkan_context_capture_snapshot(ctx, snapshot);
+    }
+#endif
+
+#ifdef POC_PLATFORM_MACOS
+    if (g_current_renderer == POC_RENDERER_METAL) {
+        // TODO: Implement Metal snapshot capture
+        return POC_RESULT_ERROR_INIT_FAILED;
+    }
+#endif
+
+    return POC_RESULT_ERROR_INIT_FAILED;
+}
+
+poc_result poc_context_draw_snapshot(poc_context *ctx, const poc_render_snapshot *snapshot) {
+    if (!ctx || !snapshot) {
+        return POC_RESULT_ERROR_INIT_FAILED;
+    }
+
+#ifdef POC_PLATFORM_LINUX
+    if (g_current_renderer == POC_RENDERER_VULKAN) {
+        return vulkan_context_draw_snapshot(ctx, snapshot);
+    }
+#endif
+
+#ifdef POC_PLATFORM_MACOS
+    if (g_current_renderer == POC_RENDERER_METAL) {
+        // TODO: Implement Metal snapshot rendering
+        return POC_RESULT_ERROR_INIT_FAILED;
+    }
+#endif
+
+    return POC_RESULT_ERROR_INIT_FAILED;
+}
+
+void poc_context_set_threaded(poc_context *ctx, bool threaded) {
+    if (!ctx) {
+        return;
+    }
+
+#ifdef POC_PLATFORM_LINUX
+    if (g_current_renderer == POC_RENDERER_VULKAN) {
+        vulkan_context_set_threaded(ctx, threaded);
+        return;
+    }
+#endif
+
+#ifdef POC_PLATFORM_MACOS
+    if (g_current_renderer == POC_RENDERER_METAL) {
+        // TODO: Implement Metal render thread support
+        (void)threaded;
+        return;
+    }
+#endif
+}
@@ -0,0 +1,626 @@
+#include "prefab.h"
+#include "scene.h"
+#include "scene_file.h"
+#include "scene_journal.h"
+#include "gltf_loader.h"
+#include "../include/poc_engine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Access to global context for renderable sharing
+extern poc_context *g_active_context;
+
+// Loaded prefabs, looked up by path (main thread only)
+static poc_prefab **g_prefabs = NULL;
+static uint32_t g_prefab_count = 0;
+static uint32_t g_prefab_capacity = 0;
+
+static bool register_prefab(poc_prefab *prefab) {
+    if (g_prefab_count >= g_prefab_capacity) {
+        uint32_t new_capacity = g_prefab_capacity == 0 ? 8 : g_prefab_capacity * 2;
+        poc_prefab **new_prefabs = realloc(g_prefabs, sizeof(poc_prefab *) * new_capacity);
+        if (!new_prefabs) {
+            return false;
+        }
+        g_prefabs = new_prefabs;
+        g_prefab_capacity = new_capacity;
+    }
+
+    g_prefabs[g_prefab_count++] = prefab;
+    return true;
+}
+
+static void unregister_prefab(poc_prefab *prefab) {
+    for (uint32_t i = 0; i < g_prefab_count; i++) {
+        if (g_prefabs[i] == prefab) {
+            g_prefabs[i] = g_prefabs[--g_prefab_count];
+            break;
+        }
+    }
+
+    if (g_prefab_count == 0) {
+        free(g_prefabs);
+        g_prefabs = NULL;
+        g_prefab_capacity = 0;
+    }
+}
+
+static void free_prefab(poc_prefab *prefab) {
+    for (uint32_t i = 0; i < prefab->mesh_count; i++) {
+        poc_asset_release_mesh(prefab->meshes[i]);
+    }
+    free(prefab->meshes);
+    free(prefab->nodes);
+    free(prefab);
+}
+
+// Hold one reference per distinct mesh; the asset manager maps equivalent
+// paths to the same mesh
+static poc_mesh *acquire_prefab_mesh(poc_prefab *prefab, const char *path, uint32_t *mesh_capacity) {
+    poc_mesh *mesh = poc_asset_acquire_mesh(path);
+    if (!mesh) {
+        printf("Failed to load mesh '%s' for prefab '%s'\n", path, prefab->path);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < prefab->mesh_count; i++) {
+        if (prefab->meshes[i] == mesh) {
+            poc_asset_release_mesh(mesh);
+            return mesh;
+        }
+    }
+
+    if (prefab->mesh_count >= *mesh_capacity) {
+        uint32_t new_capacity = *mesh_capacity == 0 ? 4 : *mesh_capacity * 2;
+        poc_mesh **new_meshes = realloc(prefab->meshes, sizeof(poc_mesh *) * new_capacity);
+        if (!new_meshes) {
+            poc_asset_release_mesh(mesh);
+            return NULL;
+        }
+        prefab->meshes = new_meshes;
+        *mesh_capacity = new_capacity;
+    }
+
+    prefab->meshes[prefab->mesh_count++] = mesh;
+    return mesh;
+}
+
+// Order template nodes so every parent precedes its children. Parents that are
+// missing or form a cycle turn the node into a direct child of the root.
+static bool build_prefab_nodes(poc_prefab *prefab, const poc_scene_file_records *records) {
+    const uint32_t count = records->count;
+    prefab->nodes = calloc(count, sizeof(poc_prefab_node));
+    uint32_t *record_parents = malloc(sizeof(uint32_t) * count);
+    uint32_t *node_of_record = malloc(sizeof(uint32_t) * count);
+    if (!prefab->nodes || !record_parents || !node_of_record) {
+        free(record_parents);
+        free(node_of_record);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        record_parents[i] = POC_PREFAB_NO_PARENT;
+        node_of_record[i] = POC_PREFAB_NO_PARENT;
+        if (records->objects[i].parent_id == 0) {
+            continue;
+        }
+        for (uint32_t j = 0; j < count; j++) {
+            if (j != i && records->objects[j].id_set && records->objects[j].id == records->objects[i].parent_id) {
+                record_parents[i] = j;
+                break;
+            }
+        }
+    }
+
+    uint32_t placed = 0;
+    while (placed < count) {
+        bool progress = false;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t parent = record_parents[i];
+            if (node_of_record[i] != POC_PREFAB_NO_PARENT ||
+                (parent != POC_PREFAB_NO_PARENT && node_of_record[parent] == POC_PREFAB_NO_PARENT)) {
+                continue;
+            }
+
+            node_of_record[i] = placed;
+            prefab->nodes[placed].parent = parent != POC_PREFAB_NO_PARENT ? node_of_record[parent] : POC_PREFAB_NO_PARENT;
+            placed++;
+            progress = true;
+        }
+
+        if (!progress) {
+            // Cycle: break it at the first unplaced record
+            for (uint32_t i = 0; i < count; i++) {
+                if (node_of_record[i] == POC_PREFAB_NO_PARENT) {
+                    record_parents[i] = POC_PREFAB_NO_PARENT;
+                    break;
+                }
+            }
+        }
+    }
+
+    uint32_t mesh_capacity = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const poc_scene_file_object *record = &records->objects[i];
+        poc_prefab_node *node = &prefab->nodes[node_of_record[i]];
+
+        node->name = poc_string_intern(record->name[0] ? record->name : "PrefabNode");
+        memcpy(node->position, record->position, sizeof(node->position));
+        memcpy(node->rotation, record->rotation, sizeof(node->rotation));
+        memcpy(node->scale, record->scale, sizeof(node->scale));
+        node->visible = record->visible;
+        node->enabled = record->enabled;
+
+        if (record->mesh_path[0] != '\0') {
+            node->mesh = acquire_prefab_mesh(prefab, record->mesh_path, &mesh_capacity);
+        }
+    }
+    prefab->node_count = count;
+
+    free(record_parents);
+    free(node_of_record);
+    return true;
+}
+
+// Build the template from a GLB file's node hierarchy. Nodes already come
+// parents first; each glTF mesh is acquired as "path#N".
+static bool build_gltf_nodes(poc_prefab *prefab) {
+    poc_gltf_node *gltf_nodes;
+    uint32_t count;
+    if (!poc_gltf_load_nodes(prefab->path, &gltf_nodes, &count)) {
+        return false;
+    }
+
+    prefab->nodes = calloc(count, sizeof(poc_prefab_node));
+    if (!prefab->nodes) {
+        free(gltf_nodes);
+        return false;
+    }
+
+    uint32_t mesh_capacity = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const poc_gltf_node *source = &gltf_nodes[i];
+        poc_prefab_node *node = &prefab->nodes[i];
+
+        node->name = source->name;
+        node->parent = source->parent != POC_GLTF_NO_PARENT ? source->parent : POC_PREFAB_NO_PARENT;
+        memcpy(node->position, source->position, sizeof(node->position));
+        memcpy(node->rotation, source->rotation, sizeof(node->rotation));
+        memcpy(node->scale, source->scale, sizeof(node->scale));
+        node->visible = true;
+        node->enabled = true;
+
+        if (source->mesh != UINT32_MAX) {
+            char mesh_path[POC_ASSET_PATH_MAX];
+            int length = snprintf(mesh_path, sizeof(mesh_path), "%s%c%u",
+                                  prefab->path, POC_GLTF_MESH_SEPARATOR, source->mesh);
+            if (length > 0 && (size_t)length < sizeof(mesh_path)) {
+                node->mesh = acquire_prefab_mesh(prefab, mesh_path, &mesh_capacity);
+            }
+        }
+    }
+    prefab->node_count = count;
+
+    free(gltf_nodes);
+    return true;
+}
+
+poc_prefab *poc_prefab_load(const char *path) {
+    if (!path || !path[0]) {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < g_prefab_count; i++) {
+        if (strcmp(g_prefabs[i]->path, path) == 0) {
+            g_prefabs[i]->ref_count++;
+            return g_prefabs[i];
+        }
+    }
+
+    if (poc_gltf_is_path(path)) {
+        poc_prefab *prefab = calloc(1, sizeof(poc_prefab));
+        if (!prefab) {
+            return NULL;
+        }
+        strncpy(prefab->path, path, sizeof(prefab->path) - 1);
+        prefab->ref_count = 1;
+
+        if (!build_gltf_nodes(prefab) || !register_prefab(prefab)) {
+            printf("Failed to load prefab '%s'\n", path);
+            free_prefab(prefab);
+            return NULL;
+        }
+        printf("✓ Loaded prefab '%s' (%u nodes, %u meshes)\n", path, prefab->node_count, prefab->mesh_count);
+        return prefab;
+    }
+
+    poc_scene_file_records records;
+    if (!poc_scene_file_read_records(path, &records)) {
+        return NULL;
+    }
+    if (!poc_scene_journal_replay(path, &records)) {
+        printf("Warning: Failed to replay journal for prefab '%s'\n", path);
+    }
+
+    poc_prefab *prefab = calloc(1, sizeof(poc_prefab));
+    if (!prefab) {
+        poc_scene_file_records_free(&records);
+        return NULL;
+    }
+    strncpy(prefab->path, path, sizeof(prefab->path) - 1);
+    prefab->ref_count = 1;
+
+    bool success = records.count > 0 && build_prefab_nodes(prefab, &records) && register_prefab(prefab);
+    poc_scene_file_records_free(&records);
+    if (!success) {
+        printf("Failed to load prefab '%s'\n", path);
+        free_prefab(prefab);
+        return NULL;
+    }
+
+    printf("✓ Loaded prefab '%s' (%u nodes, %u meshes)\n", path, prefab->node_count, prefab->mesh_count);
+    return prefab;
+}
+
+void poc_prefab_release(poc_prefab *prefab) {
+    if (!prefab || --prefab->ref_count > 0) {
+        return;
+    }
+
+    unregister_prefab(prefab);
+    free_prefab(prefab);
+}
+
+poc_prefab_instance *poc_prefab_instance_create(poc_prefab *prefab) {
+    if (!prefab) {
+        return NULL;
+    }
+
+    poc_prefab_instance *instance = calloc(1, sizeof(poc_prefab_instance));
+    if (!instance) {
+        return NULL;
+    }
+
+    instance->prefab = prefab;
+    prefab->ref_count++;
+    return instance;
+}
+
+poc_scene_object *poc_prefab_instantiate(poc_prefab *prefab, const char *name, uint32_t id) {
+    if (!prefab) {
+        return NULL;
+    }
+
+    poc_scene_object *root = poc_scene_object_create(name, id);
+    if (!root) {
+        return NULL;
+    }
+
+    root->prefab_instance = poc_prefab_instance_create(prefab);
+    if (!root->prefab_instance) {
+        poc_scene_object_destroy(root);
+        return NULL;
+    }
+
+    return root;
+}
+
+// Children come after their parents, so destroy back to front
+static void destroy_nodes(poc_prefab_instance *instance) {
+    if (!instance->nodes) {
+        return;
+    }
+
+    for (uint32_t i = instance->prefab->node_count; i-- > 0;) {
+        poc_scene_object *node = instance->nodes[i];
+        if (node) {
+            node->prefab_root = NULL;
+            poc_scene_object_destroy(node);
+        }
+    }
+    free(instance->nodes);
+    instance->nodes = NULL;
+}
+
+void poc_prefab_instance_destroy(poc_prefab_instance *instance) {
+    if (!instance) {
+        return;
+    }
+
+    destroy_nodes(instance);
+    poc_prefab_release(instance->prefab);
+    free(instance->overrides);
+    free(instance);
+}
+
+static void apply_override(poc_scene_object *node, const poc_prefab_override *override) {
+    if (override->fields & POC_SCENE_OBJECT_FIELD_TRANSFORM) {
+        memcpy(node->position, override->position, sizeof(node->position));
+        memcpy(node->rotation, override->rotation, sizeof(node->rotation));
+        memcpy(node->scale, override->scale, sizeof(node->scale));
+    }
+    if (override->fields & POC_SCENE_OBJECT_FIELD_FLAGS) {
+        node->visible = override->visible;
+        node->enabled = override->enabled;
+    }
+}
+
+// Attach a mesh, sharing the GPU buffers of a node already rendering it
+static void attach_node_mesh(poc_scene_object *node, poc_mesh *mesh, const poc_scene_object *source) {
+    if (source && source->mesh == mesh && source->renderable && g_active_context) {
+        node->renderable = poc_context_clone_renderable(g_active_context, source->renderable, poc_string_get(node->name));
+        if (node->renderable) {
+            node->mesh = mesh;
+            poc_asset_retain_mesh(mesh);
+            return;
+        }
+    }
+
+    poc_scene_object_set_mesh(node, mesh);
+}
+
+bool poc_prefab_instance_expand(poc_scene_object *root, const poc_scene_object *source_root) {
+    poc_prefab_instance *instance = root ? root->prefab_instance : NULL;
+    if (!instance || instance->nodes) {
+        return true;
+    }
+    if (!root->scene) {
+        return false;
+    }
+
+    const poc_prefab *prefab = instance->prefab;
+    const poc_prefab_instance *source = source_root ? source_root->prefab_instance : NULL;
+    if (source && (source->prefab != prefab || !source->nodes)) {
+        source = NULL;
+    }
+
+    poc_scene_object **nodes = calloc(prefab->node_count, sizeof(poc_scene_object *));
+    if (!nodes) {
+        return false;
+    }
+
+    // instance->nodes stays NULL until the end, so the setters used here are
+    // not mistaken for edits of the instance
+    uint32_t override_index = 0;
+    for (uint32_t i = 0; i < prefab->node_count; i++) {
+        const poc_prefab_node *template = &prefab->nodes[i];
+        poc_scene_object *node = poc_scene_object_create(NULL, poc_scene_get_next_object_id(root->scene));
+        if (!node) {
+            break;
+        }
+
+        node->name = template->name;
+        memcpy(node->position, template->position, sizeof(node->position));
+        memcpy(node->rotation, template->rotation, sizeof(node->rotation));
+        memcpy(node->scale, template->scale, sizeof(node->scale));
+        node->visible = template->visible;
+        node->enabled = template->enabled;
+        while (override_index < instance->override_count && instance->overrides[override_index].node < i) {
+            override_index++;
+        }
+        if (override_index < instance->override_count && instance->overrides[override_index].node == i) {
+            apply_override(node, &instance->overrides[override_index]);
+        }
+
+        node->prefab_root = root;
+        if (template->mesh) {
+            attach_node_mesh(node, template->mesh, source ? source->nodes[i] : NULL);
+        }
+
+        if (!poc_scene_add_object(root->scene, node)) {
+            node->prefab_root = NULL;
+            poc_scene_object_destroy(node);
+            break;
+        }
+        nodes[i] = node;
+        poc_scene_object_add_child(template->parent != POC_PREFAB_NO_PARENT ? nodes[template->parent] : root, node);
+    }
+
+    instance->nodes = nodes;
+    for (uint32_t i = 0; i < prefab->node_count; i++) {
+        if (!nodes[i]) {
+            printf("Failed to expand prefab '%s' for object %s\n", prefab->path, poc_string_get(root->name));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool poc_prefab_instance_collapse(poc_scene_object *root) {
+    poc_prefab_instance *instance = root ? root->prefab_instance : NULL;
+    if (!instance || !instance->nodes) {
+        return true;
+    }
+
+    // Node edits live on only as overrides
+    if (!poc_prefab_instance_sync_overrides(instance)) {
+        return false;
+    }
+
+    // Leave the scene in one sweep, then destroy without touching it again
+    if (root->scene) {
+        poc_scene_remove_objects(root->scene, instance->nodes, instance->prefab->node_count);
+    }
+    destroy_nodes(instance);
+    return true;
+}
+
+static int compare_override_node(const void *a, const void *b) {
+    uint32_t na = ((const poc_prefab_override *)a)->node;
+    uint32_t nb = ((const poc_prefab_override *)b)->node;
+    return (na > nb) - (na < nb);
+}
+
+bool poc_prefab_instance_set_overrides(poc_prefab_instance *instance,
+                                       const poc_prefab_override *overrides, uint32_t count) {
+    if (!instance || (count > 0 && !overrides)) {
+        return false;
+    }
+
+    if (count > instance->override_capacity) {
+        poc_prefab_override *new_overrides = realloc(instance->overrides, sizeof(poc_prefab_override) * count);
+        if (!new_overrides) {
+            return false;
+        }
+        instance->overrides = new_overrides;
+        instance->override_capacity = count;
+    }
+
+    // Merge duplicate entries; later entries win per field
+    uint32_t stored = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const poc_prefab_override *override = &overrides[i];
+        if (override->node >= instance->prefab->node_count || override->fields == 0) {
+            continue;
+        }
+
+        poc_prefab_override *target = NULL;
+        for (uint32_t j = 0; j < stored; j++) {
+            if (instance->overrides[j].node == override->node) {
+                target = &instance->overrides[j];
+                break;
+            }
+        }
+
+        if (!target) {
+            instance->overrides[stored++] = *override;
+            continue;
+        }
+        uint32_t fields = target->fields | override->fields;
+        poc_prefab_override merged = *override;
+        if (!(override->fields & POC_SCENE_OBJECT_FIELD_TRANSFORM)) {
+            memcpy(merged.position, target->position, sizeof(merged.position));
+            memcpy(merged.rotation, target->rotation, sizeof(merged.rotation));
+            memcpy(merged.scale, target->scale, sizeof(merged.scale));
+        }
+        if (!(override->fields & POC_SCENE_OBJECT_FIELD_FLAGS)) {
+            merged.visible = target->visible;
+            merged.enabled = target->enabled;
+        }
+        merged.fields = fields;
+        *target = merged;
+    }
+    instance->override_count = stored;
+    if (stored > 1) {
+        qsort(instance->overrides, stored, sizeof(poc_prefab_override), compare_override_node);
+    }
+
+    if (!instance->nodes) {
+        return true;
+    }
+
+    // Expanded nodes go back to the template, then take the new overrides
+    uint32_t override_index = 0;
+    for (uint32_t i = 0; i < instance->prefab->node_count; i++) {
+        poc_scene_object *node = instance->nodes[i];
+        if (!node) {
+            continue;
+        }
+
+        const poc_prefab_node *template = &instance->prefab->nodes[i];
+        memcpy(node->position, template->position, sizeof(node->position));
+        memcpy(node->rotation, template->rotation, sizeof(node->rotation));
+        memcpy(node->scale, template->scale, sizeof(node->scale));
+        node->visible = template->visible;
+        node->enabled = template->enabled;
+        while (override_index < stored && instance->overrides[override_index].node < i) {
+            override_index++;
+        }
+        if (override_index < stored && instance->overrides[override_index].node == i) {
+            apply_override(node, &instance->overrides[override_index]);
+        }
+        poc_scene_object_mark_changed(node, POC_SCENE_OBJECT_FIELD_TRANSFORM | POC_SCENE_OBJECT_FIELD_FLAGS);
+    }
+
+    return true;
+}
+
+bool poc_prefab_instance_sync_overrides(poc_prefab_instance *instance) {
+    if (!instance) {
+        return false;
+    }
+    if (!instance->nodes) {
+        return true;
+    }
+
+    const poc_prefab *prefab = instance->prefab;
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < prefab->node_count; i++) {
+        const poc_scene_object *node = instance->nodes[i];
+        const poc_prefab_node *template = &prefab->nodes[i];
+        if (!node) {
+            continue;
+        }
+
+        uint32_t fields = 0;
+        if (memcmp(node->position, template->position, sizeof(template->position)) != 0 ||
+            memcmp(node->rotation, template->rotation, sizeof(template->rotation)) != 0 ||
+            memcmp(node->scale, template->scale, sizeof(template->scale)) != 0) {
+            fields |= POC_SCENE_OBJECT_FIELD_TRANSFORM;
+        }
+        if (node->visible != template->visible || node->enabled != template->enabled) {
+            fields |= POC_SCENE_OBJECT_FIELD_FLAGS;
+        }
+        if (fields == 0) {
+            continue;
+        }
+
+        if (count >= instance->override_capacity) {
+            uint32_t new_capacity = instance->override_capacity == 0 ? 4 : instance->override_capacity * 2;
+            poc_prefab_override *new_overrides = realloc(instance->overrides, sizeof(poc_prefab_override) * new_capacity);
+            if (!new_overrides) {
+                return false;
+            }
+            instance->overrides = new_overrides;
+            instance->override_capacity = new_capacity;
+        }
+
+        poc_prefab_override *override = &instance->overrides[count++];
+        override->node = i;
+        override->fields = fields;
+        memcpy(override->position, node->position, sizeof(override->position));
+        memcpy(override->rotation, node->rotation, sizeof(override->rotation));
+        memcpy(override->scale, node->scale, sizeof(override->scale));
+        override->visible = node->visible;
+        override->enabled = node->enabled;
+    }
+
+    instance->override_count = count;
+    return true;
+}
+
+void poc_prefab_instance_invalidate(poc_scene_object *root) {
+    poc_prefab_instance *instance = root ? root->prefab_instance : NULL;
+    if (!instance || !instance->nodes) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < instance->prefab->node_count; i++) {
+        poc_scene_object *node = instance->nodes[i];
+        if (!node) {
+            continue;
+        }
+
+        node->transform_dirty = true;
+        node->bounds_dirty = true;
+        if (node->scene && !node->change_queued) {
+            poc_scene_mark_object_dirty(node->scene, node);
+        }
+    }
+}
+
+void poc_prefab_instance_forget_node(poc_scene_object *root, const poc_scene_object *node) {
+    poc_prefab_instance *instance = root ? root->prefab_instance : NULL;
+    if (!instance || !instance->nodes) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < instance->prefab->node_count; i++) {
+        if (instance->nodes[i] == node) {
+            instance->nodes[i] = NULL;
+            return;
+        }
+    }
+}
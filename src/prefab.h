@@ -0,0 +1,177 @@
+/**
+ * @file prefab.h
+ * @brief Shared prefab templates and their scene instances
+ *
+ * A prefab is a small object hierarchy loaded once from a scene file and never
+ * modified afterwards; its meshes are loaded once and shared by every
+ * instance. An instance is a single scene object (the root) carrying a
+ * reference to the prefab plus a sparse list of per-node overrides. The
+ * template nodes are expanded into real child objects of the root the first
+ * time the scene updates the root, so renderers and queries see ordinary
+ * objects, while scene files store only the root and its overrides. With a
+ * prefab range set (poc_scene_set_prefab_range), only instances near its
+ * center are expanded and those that leave it collapse again.
+ *
+ * Expanded nodes belong to their instance: they are removed and destroyed
+ * together with the root, are placed relative to it, and are never written to
+ * scene files themselves.
+ */
+
+#pragma once
+
+#include "scene_object.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct poc_scene;
+
+#define POC_PREFAB_NO_PARENT UINT32_MAX
+
+/**
+ * @brief One immutable node of a prefab template
+ */
+typedef struct poc_prefab_node {
+    poc_string_id name;         /**< Interned node name */
+    uint32_t parent;            /**< Index of the parent node, or POC_PREFAB_NO_PARENT for the root's children */
+    float position[3];          /**< Position relative to the parent */
+    float rotation[3];          /**< Euler angles in degrees */
+    float scale[3];             /**< Scale factors */
+    bool visible;               /**< Default visibility */
+    bool enabled;               /**< Default enabled state */
+    poc_mesh *mesh;             /**< Shared mesh (referenced by the prefab), or NULL */
+} poc_prefab_node;
+
+/**
+ * @brief Prefab template shared by all of its instances
+ */
+typedef struct poc_prefab {
+    char path[POC_ASSET_PATH_MAX]; /**< Source file path, also the cache key */
+    poc_prefab_node *nodes;        /**< Nodes ordered so parents precede children */
+    uint32_t node_count;           /**< Number of nodes */
+    poc_mesh **meshes;             /**< Distinct meshes the prefab holds a reference to */
+    uint32_t mesh_count;           /**< Number of referenced meshes */
+    uint32_t ref_count;            /**< Instances and callers holding the prefab */
+} poc_prefab;
+
+/**
+ * @brief Per-instance change to one template node
+ */
+typedef struct poc_prefab_override {
+    uint32_t node;              /**< Index of the overridden node */
+    uint32_t fields;            /**< POC_SCENE_OBJECT_FIELD_TRANSFORM and/or _FLAGS */
+    float position[3];          /**< Position, if TRANSFORM is set */
+    float rotation[3];          /**< Rotation, if TRANSFORM is set */
+    float scale[3];             /**< Scale, if TRANSFORM is set */
+    bool visible;               /**< Visibility, if FLAGS is set */
+    bool enabled;               /**< Enabled state, if FLAGS is set */
+} poc_prefab_override;
+
+/**
+ * @brief Instance state attached to a root scene object
+ */
+typedef struct poc_prefab_instance {
+    poc_prefab *prefab;                /**< Template (reference held) */
+    poc_prefab_override *overrides;    /**< Overrides sorted by node index */
+    uint32_t override_count;           /**< Number of overrides */
+    uint32_t override_capacity;        /**< Capacity of overrides */
+    poc_scene_object **nodes;          /**< Expanded node objects, NULL while collapsed */
+} poc_prefab_instance;
+
+/**
+ * @brief Load a prefab, or take another reference to an already loaded one
+ *
+ * The file is an ordinary scene file; its objects become the template nodes.
+ * A .glb file contributes its node hierarchy instead (see gltf_loader.h).
+ *
+ * @param path Scene file or GLB path
+ * @return Prefab with one reference for the caller, or NULL on failure
+ */
+poc_prefab *poc_prefab_load(const char *path);
+
+/**
+ * @brief Drop a reference; the prefab and its meshes are freed at zero
+ */
+void poc_prefab_release(poc_prefab *prefab);
+
+/**
+ * @brief Create an instance root object for a prefab
+ *
+ * @param prefab Template to instantiate (a reference is taken)
+ * @param name Name of the root object
+ * @param id Object ID of the root
+ * @return New collapsed root object, or NULL on failure
+ */
+poc_scene_object *poc_prefab_instantiate(poc_prefab *prefab, const char *name, uint32_t id);
+
+/**
+ * @brief Create collapsed instance state referencing a prefab
+ */
+poc_prefab_instance *poc_prefab_instance_create(poc_prefab *prefab);
+
+/**
+ * @brief Destroy instance state, its expanded nodes and its prefab reference
+ */
+void poc_prefab_instance_destroy(poc_prefab_instance *instance);
+
+/**
+ * @brief Expand a root's template nodes into child objects of its scene
+ *
+ * Does nothing if the root is already expanded. Called by poc_scene_update for
+ * newly added roots.
+ *
+ * @param root Instance root (must belong to a scene)
+ * @param source_root Optional expanded instance of the same prefab whose GPU
+ *        buffers the new nodes may share
+ * @return true on success
+ */
+bool poc_prefab_instance_expand(poc_scene_object *root, const poc_scene_object *source_root);
+
+/**
+ * @brief Fold an expanded instance back into its root and overrides
+ *
+ * Node edits are stored as overrides first; the nodes then leave the scene
+ * and are destroyed along with their renderables. Does nothing if the root
+ * is collapsed.
+ *
+ * @param root Instance root
+ * @return true on success; false leaves the instance expanded
+ */
+bool poc_prefab_instance_collapse(poc_scene_object *root);
+
+/**
+ * @brief Replace an instance's overrides, applying them to expanded nodes
+ *
+ * @param instance Instance to update
+ * @param overrides Overrides in any order; entries for unknown nodes are dropped
+ * @param count Number of overrides
+ * @return true on success
+ */
+bool poc_prefab_instance_set_overrides(poc_prefab_instance *instance,
+                                       const poc_prefab_override *overrides, uint32_t count);
+
+/**
+ * @brief Recompute the override list from the expanded nodes' current state
+ *
+ * Collapsed instances keep their stored overrides.
+ *
+ * @return true on success
+ */
+bool poc_prefab_instance_sync_overrides(poc_prefab_instance *instance);
+
+/**
+ * @brief Flag every expanded node of a root for a transform rebuild
+ */
+void poc_prefab_instance_invalidate(poc_scene_object *root);
+
+/**
+ * @brief Stop tracking a node object that is being destroyed on its own
+ */
+void poc_prefab_instance_forget_node(poc_scene_object *root, const poc_scene_object *node);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,4 +1,8 @@
 #include "scene.h"
+#include "scene_journal.h"
+#include "prefab.h"
+#include "broadphase.h"
+#include "spatial_hash.h"
 #include <stdlib.h>
 #include <string.h>
 #include <float.h>
@@ -21,28 +25,76 @@ void poc_scene_destroy(poc_scene *scene, bool destroy_objects) {
         return;
     }
 
-    if (destroy_objects && scene->objects) {
+    poc_scene_journal_destroy(scene->journal);
+    scene->journal = NULL;
+    poc_broadphase_destroy(scene->broadphase);
+    scene->broadphase = NULL;
+    poc_spatial_hash_destroy(scene->spatial_hash);
+    scene->spatial_hash = NULL;
+
+    if (scene->objects) {
+        // Detach everything first so destruction does not re-enter scene
+        // removal; expanded prefab nodes are left to their instance root
         for (uint32_t i = 0; i < scene->object_count; i++) {
-            if (scene->objects[i]) {
-                poc_scene_object_destroy(scene->objects[i]);
+            poc_scene_object *object = scene->objects[i];
+            if (object) {
+                object->scene = NULL;
+                object->change_queued = false;
+                if (object->prefab_root) {
+                    scene->objects[i] = NULL;
+                }
             }
         }
-    }
 
-    if (scene->mesh_assets) {
-        for (uint32_t i = 0; i < scene->mesh_asset_count; i++) {
-            poc_scene_mesh_entry *entry = &scene->mesh_assets[i];
-            if (entry->owned && entry->mesh) {
-                poc_mesh_destroy(entry->mesh);
-            }
+        for (uint32_t i = 0; destroy_objects && i < scene->object_count; i++) {
+            poc_scene_object_destroy(scene->objects[i]);
         }
-        free(scene->mesh_assets);
     }
 
+    free(scene->dirty_objects);
+    free(scene->changed_objects);
     free(scene->objects);
     free(scene);
 }
 
+// Drop an object from the dirty and changed lists (order is irrelevant)
+static void scene_forget_object(poc_scene *scene, poc_scene_object *object) {
+    if (scene->journal && !object->prefab_root) {
+        poc_scene_journal_track_removal(scene->journal, object);
+    }
+    poc_broadphase_remove(scene->broadphase, object);
+    poc_spatial_hash_remove(scene->spatial_hash, object);
+
+    // An instance root takes its expanded nodes along
+    if (object->prefab_instance && object->prefab_instance->nodes) {
+        for (uint32_t i = 0; i < object->prefab_instance->prefab->node_count; i++) {
+            poc_scene_object *node = object->prefab_instance->nodes[i];
+            if (node && node->scene == scene) {
+                scene_forget_object(scene, node);
+            }
+        }
+    }
+
+    if (object->change_queued) {
+        for (uint32_t i = 0; i < scene->dirty_count; i++) {
+            if (scene->dirty_objects[i] == object) {
+                scene->dirty_objects[i] = scene->dirty_objects[--scene->dirty_count];
+                break;
+            }
+        }
+        object->change_queued = false;
+    }
+
+    for (uint32_t i = 0; i < scene->changed_count; i++) {
+        if (scene->changed_objects[i] == object) {
+            scene->changed_objects[i] = scene->changed_objects[--scene->changed_count];
+            break;
+        }
+    }
+
+    object->scene = NULL;
+}
+
 bool poc_scene_add_object(poc_scene *scene, poc_scene_object *object) {
     if (!scene || !object) {
         return false;
@@ -63,6 +115,11 @@ bool poc_scene_add_object(poc_scene *scene, poc_scene_object *object) {
     scene->objects[scene->object_count] = object;
     scene->object_count++;
 
+    // New objects go through the next update so consumers pick them up
+    object->scene = scene;
+    object->change_queued = false;
+    poc_scene_object_mark_dirty(object);
+
     return true;
 }
 
@@ -71,6 +128,11 @@ bool poc_scene_remove_object(poc_scene *scene, poc_scene_object *object) {
         return false;
     }
 
+    // Instance roots leave with their nodes, which needs the batch sweep
+    if (object->prefab_instance && object->prefab_instance->nodes) {
+        return poc_scene_remove_objects(scene, &object, 1) == 1;
+    }
+
     for (uint32_t i = 0; i < scene->object_count; i++) {
         if (scene->objects[i] == object) {
             // Remove by shifting remaining elements
@@ -78,6 +140,7 @@ bool poc_scene_remove_object(poc_scene *scene, poc_scene_object *object) {
                 scene->objects[j] = scene->objects[j + 1];
             }
             scene->object_count--;
+            scene_forget_object(scene, object);
             return true;
         }
     }
@@ -85,6 +148,37 @@ bool poc_scene_remove_object(poc_scene *scene, poc_scene_object *object) {
     return false;
 }
 
+uint32_t poc_scene_remove_objects(poc_scene *scene, poc_scene_object **objects, uint32_t count) {
+    if (!scene || !objects || count == 0) {
+        return 0;
+    }
+
+    // Detach first, then compact once: attached objects always point back at
+    // their scene, so anything left pointing elsewhere is being removed
+    uint32_t removed = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (objects[i] && objects[i]->scene == scene) {
+            scene_forget_object(scene, objects[i]);
+            removed++;
+        }
+    }
+
+    if (removed == 0) {
+        return 0;
+    }
+
+    uint32_t write_index = 0;
+    for (uint32_t i = 0; i < scene->object_count; i++) {
+        poc_scene_object *object = scene->objects[i];
+        if (object && object->scene == scene) {
+            scene->objects[write_index++] = object;
+        }
+    }
+    scene->object_count = write_index;
+
+    return removed;
+}
+
 poc_scene_object* poc_scene_remove_object_by_id(poc_scene *scene, uint32_t id) {
     if (!scene) {
         return NULL;
@@ -93,12 +187,17 @@ poc_scene_object* poc_scene_remove_object_by_id(poc_scene *scene, uint32_t id) {
     for (uint32_t i = 0; i < scene->object_count; i++) {
         if (scene->objects[i] && scene->objects[i]->id == id) {
             poc_scene_object *object = scene->objects[i];
+            if (object->prefab_instance && object->prefab_instance->nodes) {
+                poc_scene_remove_objects(scene, &object, 1);
+                return object;
+            }
 
             // Remove by shifting remaining elements
             for (uint32_t j = i; j < scene->object_count - 1; j++) {
                 scene->objects[j] = scene->objects[j + 1];
             }
             scene->object_count--;
+            scene_forget_object(scene, object);
 
             return object;
         }
@@ -129,15 +228,282 @@ uint32_t poc_scene_get_next_object_id(poc_scene *scene) {
     return scene->next_object_id++;
 }
 
+void poc_scene_mark_object_dirty(poc_scene *scene, poc_scene_object *object) {
+    if (!scene || !object || object->change_queued) {
+        return;
+    }
+
+    // Expand array if needed
+    if (scene->dirty_count >= scene->dirty_capacity) {
+        uint32_t new_capacity = scene->dirty_capacity == 0 ? 16 : scene->dirty_capacity * 2;
+        poc_scene_object **new_dirty = realloc(scene->dirty_objects,
+                                               sizeof(poc_scene_object*) * new_capacity);
+        if (!new_dirty) {
+            return; // Object keeps its dirty flags and is picked up on the next mark
+        }
+        scene->dirty_objects = new_dirty;
+        scene->dirty_capacity = new_capacity;
+    }
+
+    scene->dirty_objects[scene->dirty_count++] = object;
+    object->change_queued = true;
+}
+
+// Collapse instances this much beyond the range, so one standing on the
+// boundary does not expand and collapse every frame
+#define PREFAB_COLLAPSE_MARGIN 1.25f
+
+void poc_scene_set_prefab_range(poc_scene *scene, const vec3 center, float radius) {
+    if (!scene) {
+        return;
+    }
+
+    radius = radius > 0.0f ? radius : 0.0f;
+    if (radius != scene->prefab_radius) {
+        scene->prefab_sweep_pending = true;
+    }
+    scene->prefab_center[0] = center[0];
+    scene->prefab_center[1] = center[1];
+    scene->prefab_center[2] = center[2];
+    scene->prefab_radius = radius;
+}
+
+// Distance of an instance root from the range center, in range radii
+static float prefab_range_distance(const poc_scene *scene, poc_scene_object *root) {
+    if (scene->prefab_radius == 0.0f) {
+        return 0.0f;
+    }
+
+    const mat4 *transform = poc_scene_object_get_transform_matrix(root);
+    vec3 position = {(*transform)[3][0], (*transform)[3][1], (*transform)[3][2]};
+    vec3 center = {scene->prefab_center[0], scene->prefab_center[1], scene->prefab_center[2]};
+    return glm_vec3_distance(position, center) / scene->prefab_radius;
+}
+
+// Expand instances that came into range and collapse those that left it
+static void sweep_prefab_range(poc_scene *scene) {
+    uint32_t root_count = 0;
+    for (uint32_t i = 0; i < scene->object_count; i++) {
+        if (scene->objects[i] && scene->objects[i]->prefab_instance) {
+            root_count++;
+        }
+    }
+
+    // Expanding and collapsing both reshape the object list; walk a copy
+    poc_scene_object **roots = root_count > 0 ? malloc(sizeof(poc_scene_object *) * root_count) : NULL;
+    if (root_count > 0 && !roots) {
+        return; // Stays pending and is retried next update
+    }
+    root_count = 0;
+    for (uint32_t i = 0; i < scene->object_count; i++) {
+        if (scene->objects[i] && scene->objects[i]->prefab_instance) {
+            roots[root_count++] = scene->objects[i];
+        }
+    }
+
+    for (uint32_t i = 0; i < root_count; i++) {
+        float distance = prefab_range_distance(scene, roots[i]);
+        if (!roots[i]->prefab_instance->nodes) {
+            if (distance <= 1.0f) {
+                poc_prefab_instance_expand(roots[i], NULL);
+            }
+        } else if (distance > PREFAB_COLLAPSE_MARGIN) {
+            poc_prefab_instance_collapse(roots[i]);
+        }
+    }
+    free(roots);
+
+    glm_vec3_copy(scene->prefab_center, scene->prefab_sweep_center);
+    scene->prefab_sweep_pending = false;
+}
+
 void poc_scene_update(poc_scene *scene) {
     if (!scene) {
         return;
     }
 
+    // Prefab instances added since the last update expand now when in range;
+    // their nodes join the dirty list and are processed in this same update.
+    // Expanded roots that moved out of range are left to the sweep below.
+    for (uint32_t i = 0; i < scene->dirty_count; i++) {
+        poc_scene_object *object = scene->dirty_objects[i];
+        if (!object->prefab_instance) {
+            continue;
+        }
+
+        float distance = prefab_range_distance(scene, object);
+        if (!object->prefab_instance->nodes) {
+            if (distance <= 1.0f) {
+                poc_prefab_instance_expand(object, NULL);
+            }
+        } else if (distance > PREFAB_COLLAPSE_MARGIN) {
+            scene->prefab_sweep_pending = true;
+        }
+    }
+
+    if (scene->prefab_radius > 0.0f || scene->prefab_sweep_pending) {
+        if (scene->prefab_sweep_pending ||
+            glm_vec3_distance(scene->prefab_center, scene->prefab_sweep_center) > scene->prefab_radius * 0.125f) {
+            sweep_prefab_range(scene);
+        }
+    }
+
+    // The dirty list becomes this update's changed list; swapping the two
+    // buffers keeps both allocations alive across frames
+    poc_scene_object **processed = scene->dirty_objects;
+    uint32_t processed_capacity = scene->dirty_capacity;
+    uint32_t count = scene->dirty_count;
+
+    scene->dirty_objects = scene->changed_objects;
+    scene->dirty_capacity = scene->changed_capacity;
+    scene->dirty_count = 0;
+
+    scene->changed_objects = processed;
+    scene->changed_capacity = processed_capacity;
+    scene->changed_count = count;
+
+    for (uint32_t i = 0; i < count; i++) {
+        processed[i]->change_queued = false;
+    }
+
+    poc_scene_object_update_bounds_list(processed, count);
+
+    if (scene->broadphase) {
+        poc_broadphase_update(scene->broadphase, processed, count);
+    }
+    if (scene->spatial_hash) {
+        poc_spatial_hash_update(scene->spatial_hash, processed, count);
+    }
+}
+
+bool poc_scene_enable_overlaps(poc_scene *scene, poc_overlap_callback callback, void *user_data) {
+    if (!scene) {
+        return false;
+    }
+
+    if (!scene->broadphase) {
+        scene->broadphase = poc_broadphase_create(scene);
+        if (!scene->broadphase) {
+            return false;
+        }
+    }
+
+    poc_broadphase_set_callback(scene->broadphase, callback, user_data);
+    return true;
+}
+
+void poc_scene_disable_overlaps(poc_scene *scene) {
+    if (!scene) {
+        return;
+    }
+
+    poc_broadphase_destroy(scene->broadphase);
+    scene->broadphase = NULL;
+}
+
+bool poc_scene_get_overlap_events(const poc_scene *scene, poc_overlap_events *events) {
+    poc_broadphase_get_events(scene ? scene->broadphase : NULL, events);
+    return scene && scene->broadphase;
+}
+
+// The spatial hash is built by the first query and kept up to date by every
+// update after that
+static poc_spatial_hash *scene_spatial_hash(poc_scene *scene) {
+    if (scene && !scene->spatial_hash) {
+        scene->spatial_hash = poc_spatial_hash_create(scene);
+    }
+    return scene ? scene->spatial_hash : NULL;
+}
+
+uint32_t poc_scene_query_aabb(poc_scene *scene, vec3 min, vec3 max,
+                              poc_scene_object **results, uint32_t max_results) {
+    return poc_spatial_hash_query_aabb(scene_spatial_hash(scene), min, max, results, max_results);
+}
+
+uint32_t poc_scene_query_sphere(poc_scene *scene, vec3 center, float radius,
+                                poc_scene_object **results, uint32_t max_results) {
+    return poc_spatial_hash_query_sphere(scene_spatial_hash(scene), center, radius, results, max_results);
+}
+
+uint32_t poc_scene_query_knn(poc_scene *scene, vec3 point, uint32_t k,
+                             poc_scene_object **results, float *distances) {
+    return poc_spatial_hash_query_knn(scene_spatial_hash(scene), point, k, results, distances);
+}
+
+poc_scene_object** poc_scene_get_changed_objects(poc_scene *scene, uint32_t *out_count) {
+    if (!scene || !out_count) {
+        if (out_count) {
+            *out_count = 0;
+        }
+        return NULL;
+    }
+
+    *out_count = scene->changed_count;
+    return scene->changed_objects;
+}
+
+uint32_t poc_scene_get_changed_count(const poc_scene *scene) {
+    return scene ? scene->changed_count : 0;
+}
+
+static int compare_mesh_pointer(const void *a, const void *b) {
+    uintptr_t mesh_a = (uintptr_t)*(poc_mesh *const *)a;
+    uintptr_t mesh_b = (uintptr_t)*(poc_mesh *const *)b;
+    return (mesh_a > mesh_b) - (mesh_a < mesh_b);
+}
+
+void poc_scene_get_memory_stats(const poc_scene *scene, poc_scene_memory_stats *stats) {
+    if (!stats) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    stats->string_bytes = poc_string_table_memory(&stats->string_count);
+    if (!scene) {
+        return;
+    }
+
+    stats->bookkeeping_bytes = sizeof(poc_scene) +
+                               sizeof(poc_scene_object *) * scene->object_capacity +
+                               sizeof(poc_scene_object *) * scene->dirty_capacity +
+                               sizeof(poc_scene_object *) * scene->changed_capacity;
+
+    // Meshes are shared; count each one once
+    poc_mesh **meshes = malloc(sizeof(poc_mesh *) * (scene->object_count > 0 ? scene->object_count : 1));
+    uint32_t mesh_refs = 0;
+
     for (uint32_t i = 0; i < scene->object_count; i++) {
-        if (scene->objects[i]) {
-            poc_scene_object_update_transform(scene->objects[i]);
+        const poc_scene_object *object = scene->objects[i];
+        if (!object) {
+            continue;
+        }
+
+        stats->object_count++;
+        stats->object_bytes += sizeof(poc_scene_object) + sizeof(poc_scene_object *) * object->child_capacity;
+        if (object->prefab_instance) {
+            const poc_prefab_instance *instance = object->prefab_instance;
+            stats->object_bytes += sizeof(poc_prefab_instance) +
+                                   sizeof(poc_prefab_override) * instance->override_capacity;
+            if (instance->nodes) {
+                stats->object_bytes += sizeof(poc_scene_object *) * instance->prefab->node_count;
+            }
+        }
+        if (object->mesh && meshes) {
+            meshes[mesh_refs++] = object->mesh;
+        }
+    }
+
+    if (meshes) {
+        qsort(meshes, mesh_refs, sizeof(poc_mesh *), compare_mesh_pointer);
+        for (uint32_t i = 0; i < mesh_refs; i++) {
+            if (i > 0 && meshes[i] == meshes[i - 1]) {
+                continue;
+            }
+            const poc_mesh *mesh = meshes[i];
+            stats->mesh_count++;
+            stats->mesh_bytes += sizeof(poc_mesh) + poc_mesh_get_resident_bytes(mesh);
         }
+        free(meshes);
     }
 }
 
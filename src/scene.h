@@ -35,16 +35,6 @@ typedef struct poc_hit_result {
     vec3 point;                 /**< World-space hit point on AABB surface */
 } poc_hit_result;
 
-/**
- * @brief Mesh asset entry tracking ownership within a scene
- */
-typedef struct poc_scene_mesh_entry {
-    char path[POC_ASSET_PATH_MAX]; /**< Asset path used to load the mesh */
-    poc_mesh *mesh;                /**< Mesh resource */
-    uint32_t ref_count;            /**< Number of scene objects referencing the mesh */
-    bool owned;                    /**< Whether the scene owns and should destroy the mesh */
-} poc_scene_mesh_entry;
-
 /**
  * @brief Scene containing a collection of objects
  */
@@ -54,10 +44,29 @@ typedef struct poc_scene {
     uint32_t object_capacity;      /**< Capacity of objects array */
     uint32_t next_object_id;       /**< Next available object ID */
 
-    // Asset tracking for serialized scenes
-    poc_scene_mesh_entry *mesh_assets; /**< Mesh assets owned by the scene */
-    uint32_t mesh_asset_count;         /**< Number of mesh asset entries */
-    uint32_t mesh_asset_capacity;      /**< Capacity of mesh asset array */
+    // Change journal: objects touched since the last update, and the set the
+    // last update processed (consumed by the renderer and spatial structures)
+    poc_scene_object **dirty_objects;  /**< Objects changed since the last update */
+    uint32_t dirty_count;              /**< Number of queued dirty objects */
+    uint32_t dirty_capacity;           /**< Capacity of dirty list */
+    poc_scene_object **changed_objects; /**< Objects processed by the last update */
+    uint32_t changed_count;            /**< Number of objects changed last update */
+    uint32_t changed_capacity;         /**< Capacity of changed list */
+
+    // Incremental save state (NULL until poc_scene_save_incremental is used)
+    struct poc_scene_journal *journal; /**< Pending changes for the scene journal */
+
+    // Overlap tracking (NULL until poc_scene_enable_overlaps is used)
+    struct poc_broadphase *broadphase; /**< Sweep-and-prune state */
+
+    // Proximity queries (NULL until the first poc_scene_query_* call)
+    struct poc_spatial_hash *spatial_hash; /**< Loose grid over object bounds */
+
+    // Prefab expansion range (radius 0 until poc_scene_set_prefab_range is used)
+    vec3 prefab_center;            /**< Point prefab instances expand around */
+    float prefab_radius;           /**< Instances farther away stay collapsed; 0 expands all */
+    vec3 prefab_sweep_center;      /**< Center at the last sweep over every instance */
+    bool prefab_sweep_pending;     /**< Sweep every instance on the next update */
 } poc_scene;
 
 /**
@@ -95,6 +104,19 @@ bool poc_scene_add_object(poc_scene *scene, poc_scene_object *object);
  */
 bool poc_scene_remove_object(poc_scene *scene, poc_scene_object *object);
 
+/**
+ * @brief Remove a batch of objects from the scene in one pass
+ *
+ * Costs one sweep over the scene instead of one per object. Objects not in the
+ * scene are ignored.
+ *
+ * @param scene The scene
+ * @param objects Objects to remove
+ * @param count Number of entries in objects
+ * @return Number of objects removed
+ */
+uint32_t poc_scene_remove_objects(poc_scene *scene, poc_scene_object **objects, uint32_t count);
+
 /**
  * @brief Remove an object from the scene by ID
  *
@@ -121,15 +143,149 @@ poc_scene_object* poc_scene_find_object_by_id(poc_scene *scene, uint32_t id);
  */
 uint32_t poc_scene_get_next_object_id(poc_scene *scene);
 
+/**
+ * @brief Queue an object on the scene's dirty list
+ *
+ * Called by scene object setters; an object is queued at most once per update.
+ *
+ * @param scene The scene
+ * @param object The changed object (must belong to the scene)
+ */
+void poc_scene_mark_object_dirty(poc_scene *scene, poc_scene_object *object);
+
 /**
  * @brief Update all objects in the scene
  *
- * Updates transforms and bounds for all dirty objects.
+ * Updates transforms and bounds for the objects on the dirty list only, so the
+ * cost is proportional to the number of changed objects. The processed objects
+ * become the scene's changed set until the next update.
  *
  * @param scene The scene
  */
 void poc_scene_update(poc_scene *scene);
 
+/**
+ * @brief Keep prefab instances collapsed outside a sphere
+ *
+ * Instances whose root lies farther than @p radius from @p center are not
+ * expanded, and expanded instances beyond 1.25 * @p radius collapse back into
+ * their root and overrides, releasing their node objects and renderables.
+ * Collapsed instances are neither drawn nor found by queries. Meant to be
+ * called every frame with the camera position; every instance is revisited
+ * only once the center has moved an eighth of the radius. A radius of 0 (the
+ * default) expands every instance.
+ *
+ * @param scene The scene
+ * @param center Center of the expansion range
+ * @param radius Expansion radius, or 0 to expand every instance
+ */
+void poc_scene_set_prefab_range(poc_scene *scene, const vec3 center, float radius);
+
+/**
+ * @brief Get the objects processed by the last poc_scene_update
+ *
+ * @param scene The scene
+ * @param out_count Output parameter for number of changed objects
+ * @return Array of changed objects (valid until the next update), or NULL
+ */
+poc_scene_object** poc_scene_get_changed_objects(poc_scene *scene, uint32_t *out_count);
+
+/**
+ * @brief Get the number of objects changed in the last poc_scene_update
+ *
+ * @param scene The scene
+ * @return Number of changed objects
+ */
+uint32_t poc_scene_get_changed_count(const poc_scene *scene);
+
+/**
+ * @brief Measure the memory a scene uses
+ *
+ * Walks every object; intended for diagnostics, not per-frame use. The stats
+ * struct is declared in poc_engine.h.
+ *
+ * @param scene The scene
+ * @param stats Output statistics
+ */
+void poc_scene_get_memory_stats(const poc_scene *scene, poc_scene_memory_stats *stats);
+
+/**
+ * @brief Start tracking overlapping objects in a scene
+ *
+ * Every later poc_scene_update() refreshes the broadphase from the objects
+ * that changed and reports which pairs of world AABBs started, kept or
+ * stopped overlapping. Only enabled objects with a mesh take part. Calling
+ * this again replaces the callback.
+ *
+ * @param scene     The scene
+ * @param callback  Called once per update with that update's events (can be NULL)
+ * @param user_data Passed to the callback
+ * @return True on success
+ */
+bool poc_scene_enable_overlaps(poc_scene *scene, poc_overlap_callback callback, void *user_data);
+
+/**
+ * @brief Stop tracking overlaps and free the broadphase
+ *
+ * @param scene The scene
+ */
+void poc_scene_disable_overlaps(poc_scene *scene);
+
+/**
+ * @brief Get the overlap events of the last poc_scene_update()
+ *
+ * @param scene  The scene
+ * @param events Output events (all empty if overlaps are not enabled)
+ * @return True if overlaps are enabled for the scene
+ */
+bool poc_scene_get_overlap_events(const poc_scene *scene, poc_overlap_events *events);
+
+/**
+ * @brief Find enabled objects whose world bounds overlap a box
+ *
+ * Queries use a loose spatial hash that the first query builds and every
+ * later poc_scene_update() keeps current, so they see the bounds of the last
+ * update. Objects without a mesh count as a point at their position. Cost
+ * depends on the size of the queried region, not on the scene.
+ *
+ * @param scene       The scene
+ * @param min         Box minimum corner
+ * @param max         Box maximum corner
+ * @param results     Receives matching objects (can be NULL to only count)
+ * @param max_results Capacity of results
+ * @return Number of matches; if larger than max_results, only max_results were written
+ */
+uint32_t poc_scene_query_aabb(poc_scene *scene, vec3 min, vec3 max,
+                              poc_scene_object **results, uint32_t max_results);
+
+/**
+ * @brief Find enabled objects whose world bounds are within a radius of a point
+ *
+ * @param scene       The scene
+ * @param center      Sphere center
+ * @param radius      Sphere radius
+ * @param results     Receives matching objects (can be NULL to only count)
+ * @param max_results Capacity of results
+ * @return Number of matches; if larger than max_results, only max_results were written
+ */
+uint32_t poc_scene_query_sphere(poc_scene *scene, vec3 center, float radius,
+                                poc_scene_object **results, uint32_t max_results);
+
+/**
+ * @brief Find the k enabled objects whose world bounds are nearest to a point
+ *
+ * Distance is measured to each object's AABB (0 inside it).
+ *
+ * @param scene     The scene
+ * @param point     Query point
+ * @param k         Number of objects wanted
+ * @param results   Receives the objects, nearest first (k entries)
+ * @param distances Receives their distances (k entries)
+ * @return Number of objects written, at most k
+ */
+uint32_t poc_scene_query_knn(poc_scene *scene, vec3 point, uint32_t k,
+                             poc_scene_object **results, float *distances);
+
 /**
  * @brief Perform ray-AABB intersection test against an object
  *
@@ -169,10 +325,17 @@ bool poc_scene_pick_object(poc_scene *scene,
 poc_scene_object** poc_scene_get_renderable_objects(poc_scene *scene, uint32_t *out_count);
 
 bool poc_scene_save_to_file(const poc_scene *scene, const char *path);
+bool poc_scene_save_incremental(poc_scene *scene, const char *path);
+bool poc_scene_save_partitioned(const poc_scene *scene, const char *path, float cell_size);
 poc_scene* poc_scene_load_from_file(const char *path);
 poc_scene* poc_scene_clone(const poc_scene *scene);
 bool poc_scene_copy_from(poc_scene *dest, const poc_scene *source);
 
+poc_scene_snapshot* poc_scene_snapshot_capture(const poc_scene *scene);
+poc_scene* poc_scene_snapshot_instantiate(const poc_scene_snapshot *snapshot);
+bool poc_scene_snapshot_restore(poc_scene *scene, const poc_scene_snapshot *snapshot);
+void poc_scene_snapshot_destroy(poc_scene_snapshot *snapshot);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,213 @@
+/**
+ * @file scene_file.h
+ * @brief Shared reader and writer for the text scene file format
+ *
+ * Version 1 files hold a flat list of [object] records, optionally tagged with
+ * the append-only journal (see scene_journal.h) whose first journal_offset
+ * bytes they already contain. Version 2 files add a grid partition: a
+ * top-level cell_size and [cell x z] ... [endcell] sections grouping the
+ * objects whose root lies in that XZ cell. Flat loaders ignore the
+ * cell markers, so partitioned files still load as ordinary scenes, while the
+ * world streamer reads one cell at a time from its recorded file offset.
+ *
+ * A record with a prefab="path" line is a prefab instance root (see prefab.h);
+ * the [override] sections following it list its changed template nodes.
+ */
+
+#pragma once
+
+#include "poc_engine.h"
+#include "scene_object.h"
+#include "prefab.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define POC_SCENE_FILE_HEADER "poc_scene"
+#define POC_SCENE_FILE_VERSION 1
+#define POC_SCENE_FILE_VERSION_PARTITIONED 2
+
+/**
+ * @brief One [object] record as stored in a scene file
+ */
+typedef struct poc_scene_file_object {
+    uint32_t id;
+    uint32_t parent_id;
+    bool id_set;
+    char name[256];
+    float position[3];
+    float rotation[3];
+    float scale[3];
+    bool visible;
+    bool enabled;
+    char mesh_path[POC_ASSET_PATH_MAX];
+    char prefab_path[POC_ASSET_PATH_MAX];
+} poc_scene_file_object;
+
+/**
+ * @brief One [override] section, attached to the prefab instance before it
+ */
+typedef struct poc_scene_file_override {
+    uint32_t owner_id;             /**< ID of the instance root record */
+    poc_prefab_override override;  /**< Node override */
+} poc_scene_file_override;
+
+/**
+ * @brief Location of one cell section inside a partitioned scene file
+ */
+typedef struct poc_scene_file_cell {
+    int32_t x;             /**< Cell column (floor(x / cell_size)) */
+    int32_t z;             /**< Cell row (floor(z / cell_size)) */
+    long offset;           /**< File offset of the first line after [cell x z] */
+    uint32_t object_count; /**< Number of [object] records in the section */
+} poc_scene_file_cell;
+
+/**
+ * @brief Cell directory of a partitioned scene file
+ */
+typedef struct poc_scene_file_index {
+    float cell_size;             /**< Edge length of a cell in world units */
+    uint32_t next_id;            /**< next_id stored in the file */
+    poc_scene_file_cell *cells;  /**< Cell sections in file order */
+    uint32_t cell_count;         /**< Number of cells */
+} poc_scene_file_index;
+
+/**
+ * @brief Every record of a scene file plus its top-level settings
+ */
+typedef struct poc_scene_file_records {
+    poc_scene_file_object *objects; /**< Records in file order */
+    uint32_t count;                 /**< Number of records */
+    uint32_t capacity;              /**< Capacity of objects */
+    uint32_t next_id;               /**< next_id stored in the file, or 0 if absent */
+    uint64_t journal_id;            /**< Journal this base belongs to, or 0 if none */
+    uint64_t journal_offset;        /**< Journal bytes already folded into this base */
+    poc_scene_file_override *overrides; /**< Prefab overrides of all records */
+    uint32_t override_count;        /**< Number of overrides */
+    uint32_t override_capacity;     /**< Capacity of overrides */
+} poc_scene_file_records;
+
+/**
+ * @brief Reset a record to the format's defaults
+ */
+void poc_scene_file_object_init(poc_scene_file_object *object);
+
+/**
+ * @brief Create a scene object from a record (transform and flags, no mesh)
+ *
+ * Prefab records become collapsed instance roots with the template's defaults.
+ *
+ * @return New object, or NULL on allocation failure
+ */
+poc_scene_object *poc_scene_file_object_instantiate(const poc_scene_file_object *record);
+
+/**
+ * @brief Fill a record from a live scene object
+ */
+void poc_scene_file_object_from_scene_object(poc_scene_file_object *record, const poc_scene_object *object);
+
+/**
+ * @brief Read every record of a scene file, ignoring cell sections
+ *
+ * Does not touch meshes or the renderer, so it is safe on worker threads.
+ *
+ * @param path Scene file path
+ * @param records Output; release with poc_scene_file_records_free()
+ * @return true on success
+ */
+bool poc_scene_file_read_records(const char *path, poc_scene_file_records *records);
+
+/**
+ * @brief Write records as a flat scene file
+ *
+ * @return true on success
+ */
+bool poc_scene_file_write_records(const char *path, const poc_scene_file_records *records);
+
+/**
+ * @brief Write a scene as a flat scene file tagged with a journal position
+ *
+ * @param scene Scene to write
+ * @param path Target file path
+ * @param journal_id Journal the file belongs to (0 for none)
+ * @param journal_offset Journal bytes the file already contains
+ * @return true on success
+ */
+bool poc_scene_file_write_scene(const poc_scene *scene, const char *path,
+                                uint64_t journal_id, uint64_t journal_offset);
+
+/**
+ * @brief Append a record, growing the array as needed
+ *
+ * @return true on success
+ */
+bool poc_scene_file_records_append(poc_scene_file_records *records, const poc_scene_file_object *object);
+
+/**
+ * @brief Append a prefab override, growing the array as needed
+ *
+ * @return true on success
+ */
+bool poc_scene_file_records_append_override(poc_scene_file_records *records,
+                                            const poc_scene_file_override *override);
+
+/**
+ * @brief Drop every override belonging to one instance root
+ */
+void poc_scene_file_records_remove_overrides(poc_scene_file_records *records, uint32_t owner_id);
+
+/**
+ * @brief Release a record set
+ */
+void poc_scene_file_records_free(poc_scene_file_records *records);
+
+/**
+ * @brief Compute the grid cell containing a world position
+ */
+void poc_scene_file_cell_of(float cell_size, const float position[3], int32_t *out_x, int32_t *out_z);
+
+/**
+ * @brief Scan a partitioned scene file and record where each cell starts
+ *
+ * @param path Scene file path
+ * @param index Output index; release with poc_scene_file_index_free()
+ * @return true if the file is a valid version 2 file with a cell_size
+ */
+bool poc_scene_file_read_index(const char *path, poc_scene_file_index *index);
+
+/**
+ * @brief Release a cell index
+ */
+void poc_scene_file_index_free(poc_scene_file_index *index);
+
+/**
+ * @brief Read the object records of one cell
+ *
+ * Safe to call from worker threads; each call opens its own file handle.
+ * Prefab overrides saved in the cell are read along with their instances.
+ * Only the objects and overrides of @p records are filled.
+ *
+ * @param path Scene file path
+ * @param cell Cell to read (from poc_scene_file_read_index)
+ * @param records Output; release with poc_scene_file_records_free()
+ * @return true on success
+ */
+bool poc_scene_file_read_cell(const char *path, const poc_scene_file_cell *cell,
+                              poc_scene_file_records *records);
+
+/**
+ * @brief Hand a prefab instance the overrides stored for its record
+ *
+ * @param records Records the instance was read with
+ * @param object Object created from one of the records, matched by ID
+ * @return true if the object's overrides (if any) were applied
+ */
+bool poc_scene_file_records_apply_overrides(const poc_scene_file_records *records, poc_scene_object *object);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,904 @@
+#define _POSIX_C_SOURCE 200809L
+#include "scene_journal.h"
+#include "job_system.h"
+#include "prefab.h"
+#include "poc_engine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+
+// Journal files are machine-local autosave data and use native byte order
+#define JOURNAL_MAGIC "PSJ1"
+#define JOURNAL_VERSION 1u
+#define JOURNAL_HEADER_SIZE 24u   // magic, version, journal id, previous journal id
+
+// Fold the journal into the base once it exceeds half the base size
+#define JOURNAL_COMPACT_MIN_BYTES (256u * 1024u)
+
+#define JOURNAL_NO_RECORD UINT32_MAX
+
+enum {
+    JOURNAL_RECORD_UPSERT = 1,  // Create an object or overwrite the fields in its mask
+    JOURNAL_RECORD_DELETE = 2,  // Remove an object
+    JOURNAL_RECORD_NEXT_ID = 3  // Update the scene's next object id
+};
+
+typedef struct {
+    char *base_path;
+    char *old_journal_path;
+    char *output_path;
+    uint64_t old_id;
+    uint64_t new_id;
+    bool success;
+} compaction_task;
+
+struct poc_scene_journal {
+    char *base_path;
+    char *journal_path;
+    char *old_journal_path;
+    char *base_temp_path;
+    char *compact_temp_path;
+
+    FILE *file;                 // Current journal, positioned at its end
+    uint64_t journal_id;
+    uint64_t journal_bytes;
+    uint64_t base_bytes;
+    uint32_t saved_next_id;
+    bool needs_full_save;       // Set when tracking or the files can no longer be trusted
+
+    // Changes since the last save
+    poc_scene_object **pending;
+    uint32_t pending_count;
+    uint32_t pending_capacity;
+    uint32_t *removed_ids;
+    uint32_t removed_count;
+    uint32_t removed_capacity;
+
+    // Background compaction of the rotated journal
+    compaction_task compaction;
+    poc_job_counter compaction_counter;
+    bool compaction_running;
+};
+
+// === Binary encoding ===
+
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+} byte_buffer;
+
+static void buffer_put(byte_buffer *buffer, const void *bytes, size_t count) {
+    if (buffer->failed) {
+        return;
+    }
+
+    if (buffer->size + count > buffer->capacity) {
+        size_t new_capacity = buffer->capacity == 0 ? 4096 : buffer->capacity * 2;
+        while (new_capacity < buffer->size + count) {
+            new_capacity *= 2;
+        }
+        uint8_t *new_data = realloc(buffer->data, new_capacity);
+        if (!new_data) {
+            buffer->failed = true;
+            return;
+        }
+        buffer->data = new_data;
+        buffer->capacity = new_capacity;
+    }
+
+    memcpy(buffer->data + buffer->size, bytes, count);
+    buffer->size += count;
+}
+
+static void buffer_put_u8(byte_buffer *buffer, uint8_t value) {
+    buffer_put(buffer, &value, sizeof(value));
+}
+
+static void buffer_put_u32(byte_buffer *buffer, uint32_t value) {
+    buffer_put(buffer, &value, sizeof(value));
+}
+
+static void buffer_put_string(byte_buffer *buffer, const char *value) {
+    size_t length = strlen(value);
+    uint16_t stored = length > UINT16_MAX ? UINT16_MAX : (uint16_t)length;
+    buffer_put(buffer, &stored, sizeof(stored));
+    buffer_put(buffer, value, stored);
+}
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    size_t position;
+    bool ok;
+} byte_reader;
+
+static void reader_get(byte_reader *reader, void *out, size_t count) {
+    if (!reader->ok || reader->size - reader->position < count) {
+        reader->ok = false;
+        memset(out, 0, count);
+        return;
+    }
+
+    memcpy(out, reader->data + reader->position, count);
+    reader->position += count;
+}
+
+static void reader_get_string(byte_reader *reader, char *out, size_t out_size) {
+    uint16_t length = 0;
+    reader_get(reader, &length, sizeof(length));
+    if (!reader->ok || reader->size - reader->position < length) {
+        reader->ok = false;
+        out[0] = '\0';
+        return;
+    }
+
+    size_t copied = length < out_size - 1 ? length : out_size - 1;
+    memcpy(out, reader->data + reader->position, copied);
+    out[copied] = '\0';
+    reader->position += length;
+}
+
+static void encode_header(uint8_t header[JOURNAL_HEADER_SIZE], uint64_t journal_id, uint64_t previous_id) {
+    uint32_t version = JOURNAL_VERSION;
+    memcpy(header, JOURNAL_MAGIC, 4);
+    memcpy(header + 4, &version, sizeof(version));
+    memcpy(header + 8, &journal_id, sizeof(journal_id));
+    memcpy(header + 16, &previous_id, sizeof(previous_id));
+}
+
+static bool decode_header(const uint8_t *data, size_t size, uint64_t *journal_id, uint64_t *previous_id) {
+    uint32_t version = 0;
+    if (size < JOURNAL_HEADER_SIZE || memcmp(data, JOURNAL_MAGIC, 4) != 0) {
+        return false;
+    }
+
+    memcpy(&version, data + 4, sizeof(version));
+    memcpy(journal_id, data + 8, sizeof(*journal_id));
+    memcpy(previous_id, data + 16, sizeof(*previous_id));
+    return version == JOURNAL_VERSION;
+}
+
+// Records are [u32 length][u8 type][u8 fields][u32 id][payload]; length
+// covers everything after itself so a torn final record is detected
+static size_t begin_record(byte_buffer *buffer, uint8_t type, uint8_t fields, uint32_t id) {
+    size_t start = buffer->size;
+    buffer_put_u32(buffer, 0);
+    buffer_put_u8(buffer, type);
+    buffer_put_u8(buffer, fields);
+    buffer_put_u32(buffer, id);
+    return start;
+}
+
+static void end_record(byte_buffer *buffer, size_t start) {
+    if (buffer->failed) {
+        return;
+    }
+
+    uint32_t length = (uint32_t)(buffer->size - start - sizeof(uint32_t));
+    memcpy(buffer->data + start, &length, sizeof(length));
+}
+
+static void encode_upsert(byte_buffer *buffer, const poc_scene_object *object, uint8_t fields) {
+    size_t start = begin_record(buffer, JOURNAL_RECORD_UPSERT, fields, object->id);
+
+    if (fields & POC_SCENE_OBJECT_FIELD_TRANSFORM) {
+        buffer_put(buffer, object->position, sizeof(float) * 3);
+        buffer_put(buffer, object->rotation, sizeof(float) * 3);
+        buffer_put(buffer, object->scale, sizeof(float) * 3);
+    }
+    if (fields & POC_SCENE_OBJECT_FIELD_FLAGS) {
+        buffer_put_u8(buffer, (uint8_t)((object->visible ? 1 : 0) | (object->enabled ? 2 : 0)));
+    }
+    if (fields & POC_SCENE_OBJECT_FIELD_NAME) {
+        buffer_put_string(buffer, poc_string_get(object->name));
+    }
+    if (fields & POC_SCENE_OBJECT_FIELD_MESH) {
+        buffer_put_string(buffer, object->mesh ? poc_string_get(object->mesh->source_path) : "");
+    }
+    if (fields & POC_SCENE_OBJECT_FIELD_PARENT) {
+        buffer_put_u32(buffer, object->parent ? object->parent->id : 0);
+    }
+    if (fields & POC_SCENE_OBJECT_FIELD_PREFAB) {
+        // Prefab path, then the instance's full override list
+        poc_prefab_instance *instance = object->prefab_instance;
+        if (instance && !poc_prefab_instance_sync_overrides(instance)) {
+            buffer->failed = true;
+        }
+        buffer_put_string(buffer, instance ? instance->prefab->path : "");
+        buffer_put_u32(buffer, instance ? instance->override_count : 0);
+        for (uint32_t i = 0; instance && i < instance->override_count; i++) {
+            const poc_prefab_override *override = &instance->overrides[i];
+            buffer_put_u32(buffer, override->node);
+            buffer_put_u8(buffer, (uint8_t)override->fields);
+            if (override->fields & POC_SCENE_OBJECT_FIELD_TRANSFORM) {
+                buffer_put(buffer, override->position, sizeof(float) * 3);
+                buffer_put(buffer, override->rotation, sizeof(float) * 3);
+                buffer_put(buffer, override->scale, sizeof(float) * 3);
+            }
+            if (override->fields & POC_SCENE_OBJECT_FIELD_FLAGS) {
+                buffer_put_u8(buffer, (uint8_t)((override->visible ? 1 : 0) | (override->enabled ? 2 : 0)));
+            }
+        }
+    }
+
+    end_record(buffer, start);
+}
+
+// === Replay ===
+
+typedef struct {
+    poc_scene_file_records *records;
+    uint32_t *slots;            // Open-addressed id -> record index
+    uint32_t slot_capacity;
+    bool *removed;              // Parallel to records; deleted records are dropped at the end
+    uint32_t removed_capacity;
+} replay_state;
+
+static uint32_t hash_id(uint32_t id) {
+    id ^= id >> 16;
+    id *= 0x7feb352dU;
+    id ^= id >> 15;
+    id *= 0x846ca68bU;
+    id ^= id >> 16;
+    return id;
+}
+
+static uint32_t *find_slot(replay_state *state, uint32_t id) {
+    uint32_t mask = state->slot_capacity - 1;
+    uint32_t slot = hash_id(id) & mask;
+    while (state->slots[slot] != JOURNAL_NO_RECORD &&
+           state->records->objects[state->slots[slot]].id != id) {
+        slot = (slot + 1) & mask;
+    }
+    return &state->slots[slot];
+}
+
+static bool rebuild_slots(replay_state *state, uint32_t min_capacity) {
+    uint32_t capacity = 64;
+    while (capacity < min_capacity * 2) {
+        capacity *= 2;
+    }
+
+    uint32_t *slots = malloc(sizeof(uint32_t) * capacity);
+    if (!slots) {
+        return false;
+    }
+
+    free(state->slots);
+    state->slots = slots;
+    state->slot_capacity = capacity;
+    memset(slots, 0xFF, sizeof(uint32_t) * capacity);
+
+    for (uint32_t i = 0; i < state->records->count; i++) {
+        if (state->records->objects[i].id_set) {
+            *find_slot(state, state->records->objects[i].id) = i;
+        }
+    }
+    return true;
+}
+
+static bool ensure_removed_capacity(replay_state *state, uint32_t count) {
+    if (count <= state->removed_capacity) {
+        return true;
+    }
+
+    uint32_t new_capacity = state->removed_capacity == 0 ? 64 : state->removed_capacity;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+
+    bool *removed = realloc(state->removed, sizeof(bool) * new_capacity);
+    if (!removed) {
+        return false;
+    }
+    memset(removed + state->removed_capacity, 0, sizeof(bool) * (new_capacity - state->removed_capacity));
+    state->removed = removed;
+    state->removed_capacity = new_capacity;
+    return true;
+}
+
+static bool replay_state_init(replay_state *state, poc_scene_file_records *records) {
+    memset(state, 0, sizeof(*state));
+    state->records = records;
+    return rebuild_slots(state, records->count) && ensure_removed_capacity(state, records->count);
+}
+
+static void replay_state_free(replay_state *state) {
+    free(state->slots);
+    free(state->removed);
+}
+
+// Find or create the record for an id
+static poc_scene_file_object *upsert_record(replay_state *state, uint32_t id) {
+    uint32_t *slot = find_slot(state, id);
+    if (*slot != JOURNAL_NO_RECORD) {
+        poc_scene_file_object *record = &state->records->objects[*slot];
+        if (state->removed[*slot]) {
+            // Recreated after a delete: start again from defaults
+            state->removed[*slot] = false;
+            poc_scene_file_records_remove_overrides(state->records, id);
+            poc_scene_file_object_init(record);
+            record->id = id;
+            record->id_set = true;
+        }
+        return record;
+    }
+
+    poc_scene_file_object record;
+    poc_scene_file_object_init(&record);
+    record.id = id;
+    record.id_set = true;
+
+    uint32_t index = state->records->count;
+    if (!ensure_removed_capacity(state, index + 1) ||
+        !poc_scene_file_records_append(state->records, &record)) {
+        return NULL;
+    }
+    state->removed[index] = false;
+
+    if (state->records->count * 2 > state->slot_capacity) {
+        if (!rebuild_slots(state, state->records->count)) {
+            return NULL;
+        }
+    } else {
+        *find_slot(state, id) = index;
+    }
+
+    return &state->records->objects[index];
+}
+
+// Apply records from offset onward; stops quietly at a torn final record.
+// Fails if the journal ends before offset, i.e. it lost records the base
+// says were already written.
+static bool apply_journal(replay_state *state, const uint8_t *data, size_t size, uint64_t offset) {
+    if (offset < JOURNAL_HEADER_SIZE) {
+        offset = JOURNAL_HEADER_SIZE;
+    }
+    if (offset > size) {
+        printf("⚠ Scene journal is shorter than its base expects (%llu of %llu bytes)\n",
+               (unsigned long long)size, (unsigned long long)offset);
+        return false;
+    }
+
+    size_t position = (size_t)offset;
+    while (size - position >= sizeof(uint32_t)) {
+        uint32_t length = 0;
+        memcpy(&length, data + position, sizeof(length));
+        position += sizeof(length);
+        if (length > size - position) {
+            break;
+        }
+
+        byte_reader reader = { .data = data + position, .size = length, .position = 0, .ok = true };
+        position += length;
+
+        uint8_t type = 0;
+        uint8_t fields = 0;
+        uint32_t id = 0;
+        reader_get(&reader, &type, sizeof(type));
+        reader_get(&reader, &fields, sizeof(fields));
+        reader_get(&reader, &id, sizeof(id));
+        if (!reader.ok) {
+            break;
+        }
+
+        if (type == JOURNAL_RECORD_NEXT_ID) {
+            state->records->next_id = id;
+        } else if (type == JOURNAL_RECORD_DELETE) {
+            uint32_t *slot = find_slot(state, id);
+            if (*slot != JOURNAL_NO_RECORD) {
+                state->removed[*slot] = true;
+                poc_scene_file_records_remove_overrides(state->records, id);
+            }
+        } else if (type == JOURNAL_RECORD_UPSERT) {
+            poc_scene_file_object *record = upsert_record(state, id);
+            if (!record) {
+                return false;
+            }
+
+            if (fields & POC_SCENE_OBJECT_FIELD_TRANSFORM) {
+                reader_get(&reader, record->position, sizeof(record->position));
+                reader_get(&reader, record->rotation, sizeof(record->rotation));
+                reader_get(&reader, record->scale, sizeof(record->scale));
+            }
+            if (fields & POC_SCENE_OBJECT_FIELD_FLAGS) {
+                uint8_t flags = 0;
+                reader_get(&reader, &flags, sizeof(flags));
+                record->visible = (flags & 1) != 0;
+                record->enabled = (flags & 2) != 0;
+            }
+            if (fields & POC_SCENE_OBJECT_FIELD_NAME) {
+                reader_get_string(&reader, record->name, sizeof(record->name));
+            }
+            if (fields & POC_SCENE_OBJECT_FIELD_MESH) {
+                reader_get_string(&reader, record->mesh_path, sizeof(record->mesh_path));
+            }
+            if (fields & POC_SCENE_OBJECT_FIELD_PARENT) {
+                reader_get(&reader, &record->parent_id, sizeof(record->parent_id));
+            }
+            if (fields & POC_SCENE_OBJECT_FIELD_PREFAB) {
+                reader_get_string(&reader, record->prefab_path, sizeof(record->prefab_path));
+                uint32_t override_count = 0;
+                reader_get(&reader, &override_count, sizeof(override_count));
+                poc_scene_file_records_remove_overrides(state->records, id);
+
+                for (uint32_t i = 0; i < override_count && reader.ok; i++) {
+                    poc_scene_file_override entry;
+                    memset(&entry, 0, sizeof(entry));
+                    entry.owner_id = id;
+                    uint8_t override_fields = 0;
+                    reader_get(&reader, &entry.override.node, sizeof(entry.override.node));
+                    reader_get(&reader, &override_fields, sizeof(override_fields));
+                    entry.override.fields = override_fields;
+                    if (override_fields & POC_SCENE_OBJECT_FIELD_TRANSFORM) {
+                        reader_get(&reader, entry.override.position, sizeof(entry.override.position));
+                        reader_get(&reader, entry.override.rotation, sizeof(entry.override.rotation));
+                        reader_get(&reader, entry.override.scale, sizeof(entry.override.scale));
+                    }
+                    if (override_fields & POC_SCENE_OBJECT_FIELD_FLAGS) {
+                        uint8_t flags = 0;
+                        reader_get(&reader, &flags, sizeof(flags));
+                        entry.override.visible = (flags & 1) != 0;
+                        entry.override.enabled = (flags & 2) != 0;
+                    }
+                    if (reader.ok && !poc_scene_file_records_append_override(state->records, &entry)) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// Drop deleted records, keeping file order
+static void compact_records(replay_state *state) {
+    poc_scene_file_records *records = state->records;
+    uint32_t write_index = 0;
+    for (uint32_t i = 0; i < records->count; i++) {
+        if (!state->removed[i]) {
+            records->objects[write_index++] = records->objects[i];
+        }
+    }
+    records->count = write_index;
+}
+
+static uint8_t *read_file_bytes(const char *path, size_t *out_size) {
+    *out_size = 0;
+
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+
+    uint8_t *data = NULL;
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        size = ftell(file);
+    }
+    if (size > 0 && fseek(file, 0, SEEK_SET) == 0) {
+        data = malloc((size_t)size);
+        if (data && fread(data, 1, (size_t)size, file) != (size_t)size) {
+            free(data);
+            data = NULL;
+        }
+    }
+
+    fclose(file);
+    if (data) {
+        *out_size = (size_t)size;
+    }
+    return data;
+}
+
+static char *path_with_suffix(const char *path, const char *suffix) {
+    size_t length = strlen(path) + strlen(suffix) + 1;
+    char *result = malloc(length);
+    if (result) {
+        snprintf(result, length, "%s%s", path, suffix);
+    }
+    return result;
+}
+
+bool poc_scene_journal_replay(const char *base_path, poc_scene_file_records *records) {
+    if (!base_path || !records || records->journal_id == 0) {
+        return true;
+    }
+
+    char *journal_path = path_with_suffix(base_path, ".journal");
+    char *old_journal_path = path_with_suffix(base_path, ".journal.old");
+    if (!journal_path || !old_journal_path) {
+        free(journal_path);
+        free(old_journal_path);
+        return false;
+    }
+
+    size_t current_size = 0;
+    size_t old_size = 0;
+    uint8_t *current = read_file_bytes(journal_path, &current_size);
+    uint8_t *old = read_file_bytes(old_journal_path, &old_size);
+    uint64_t current_id = 0, current_previous = 0, old_id = 0, old_previous = 0;
+    bool has_current = current && decode_header(current, current_size, &current_id, &current_previous);
+    bool has_old = old && decode_header(old, old_size, &old_id, &old_previous);
+
+    const uint64_t base_id = records->journal_id;
+    replay_state state;
+    bool success = replay_state_init(&state, records);
+    uint32_t applied = 0;
+
+    if (success && has_old && old_id == base_id) {
+        // Interrupted compaction: the rotated journal continues this base and
+        // the current one continues the rotated journal
+        success = apply_journal(&state, old, old_size, records->journal_offset);
+        applied++;
+        if (success && has_current && current_previous == base_id) {
+            success = apply_journal(&state, current, current_size, JOURNAL_HEADER_SIZE);
+            applied++;
+        }
+    } else if (success && has_current && current_id == base_id) {
+        success = apply_journal(&state, current, current_size, records->journal_offset);
+        applied++;
+    }
+
+    if (success) {
+        compact_records(&state);
+        records->journal_id = 0;
+        records->journal_offset = 0;
+        if (applied > 0) {
+            printf("✓ Replayed scene journal for '%s'\n", base_path);
+        }
+    }
+
+    replay_state_free(&state);
+    free(current);
+    free(old);
+    free(journal_path);
+    free(old_journal_path);
+    return success;
+}
+
+// === Background compaction ===
+
+static void compaction_job(void *user_data) {
+    compaction_task *task = user_data;
+    task->success = false;
+
+    poc_scene_file_records records;
+    if (!poc_scene_file_read_records(task->base_path, &records)) {
+        return;
+    }
+
+    size_t size = 0;
+    uint8_t *data = read_file_bytes(task->old_journal_path, &size);
+    uint64_t journal_id = 0, previous_id = 0;
+    replay_state state;
+
+    if (records.journal_id == task->old_id && data &&
+        decode_header(data, size, &journal_id, &previous_id) && journal_id == task->old_id &&
+        replay_state_init(&state, &records)) {
+        if (apply_journal(&state, data, size, records.journal_offset)) {
+            compact_records(&state);
+            records.journal_id = task->new_id;
+            records.journal_offset = JOURNAL_HEADER_SIZE;
+            task->success = poc_scene_file_write_records(task->output_path, &records);
+        }
+        replay_state_free(&state);
+    }
+
+    free(data);
+    poc_scene_file_records_free(&records);
+}
+
+static uint64_t file_size(const char *path) {
+    struct stat info;
+    return stat(path, &info) == 0 ? (uint64_t)info.st_size : 0;
+}
+
+// Swap in a finished compaction; with wait set, block until it finishes
+static void finish_compaction(poc_scene_journal *journal, bool wait) {
+    if (!journal->compaction_running) {
+        return;
+    }
+    if (!wait && !poc_job_is_done(&journal->compaction_counter)) {
+        return;
+    }
+
+    poc_job_wait(&journal->compaction_counter);
+    journal->compaction_running = false;
+
+    if (journal->compaction.success && rename(journal->compact_temp_path, journal->base_path) == 0) {
+        unlink(journal->old_journal_path);
+        journal->base_bytes = file_size(journal->base_path);
+        printf("✓ Compacted scene journal into '%s' (%.1f KB)\n",
+               journal->base_path, (double)journal->base_bytes / 1024.0);
+    } else {
+        // The rotated journal is still needed, so the next save rewrites the base
+        unlink(journal->compact_temp_path);
+        journal->needs_full_save = true;
+        printf("⚠ Scene journal compaction failed for '%s'\n", journal->base_path);
+    }
+}
+
+static uint64_t new_journal_id(void) {
+    static atomic_uint_fast64_t counter;
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    uint64_t id = ((uint64_t)now.tv_sec << 30) ^ (uint64_t)now.tv_nsec ^ ((uint64_t)getpid() << 44);
+    id += atomic_fetch_add(&counter, 1) + 1;
+    return id != 0 ? id : 1;
+}
+
+static bool open_journal(poc_scene_journal *journal, uint64_t journal_id, uint64_t previous_id) {
+    journal->file = fopen(journal->journal_path, "wb");
+    if (!journal->file) {
+        printf("Failed to open scene journal '%s' for writing\n", journal->journal_path);
+        return false;
+    }
+
+    uint8_t header[JOURNAL_HEADER_SIZE];
+    encode_header(header, journal_id, previous_id);
+    if (fwrite(header, 1, sizeof(header), journal->file) != sizeof(header) || fflush(journal->file) != 0) {
+        fclose(journal->file);
+        journal->file = NULL;
+        return false;
+    }
+
+    journal->journal_id = journal_id;
+    journal->journal_bytes = JOURNAL_HEADER_SIZE;
+    return true;
+}
+
+static void maybe_start_compaction(poc_scene_journal *journal) {
+    uint64_t threshold = journal->base_bytes / 2;
+    if (threshold < JOURNAL_COMPACT_MIN_BYTES) {
+        threshold = JOURNAL_COMPACT_MIN_BYTES;
+    }
+    if (journal->compaction_running || journal->journal_bytes < threshold) {
+        return;
+    }
+
+    // Rotate: the old journal keeps continuing the current base until the
+    // compacted base replaces it
+    uint64_t old_id = journal->journal_id;
+    fclose(journal->file);
+    journal->file = NULL;
+    if (rename(journal->journal_path, journal->old_journal_path) != 0 ||
+        !open_journal(journal, new_journal_id(), old_id)) {
+        journal->needs_full_save = true;
+        return;
+    }
+
+    journal->compaction = (compaction_task){
+        .base_path = journal->base_path,
+        .old_journal_path = journal->old_journal_path,
+        .output_path = journal->compact_temp_path,
+        .old_id = old_id,
+        .new_id = journal->journal_id,
+        .success = false
+    };
+    journal->compaction_running = true;
+
+    if (!poc_job_submit(compaction_job, &journal->compaction, &journal->compaction_counter)) {
+        compaction_job(&journal->compaction);
+    }
+}
+
+// === Tracking ===
+
+static void clear_pending(poc_scene_journal *journal) {
+    for (uint32_t i = 0; i < journal->pending_count; i++) {
+        journal->pending[i]->journal_fields = 0;
+    }
+    journal->pending_count = 0;
+    journal->removed_count = 0;
+}
+
+void poc_scene_journal_track(poc_scene_journal *journal, poc_scene_object *object, uint32_t fields) {
+    if (!journal || !object || fields == 0) {
+        return;
+    }
+
+    if (object->journal_fields == 0) {
+        if (journal->pending_count >= journal->pending_capacity) {
+            uint32_t new_capacity = journal->pending_capacity == 0 ? 16 : journal->pending_capacity * 2;
+            poc_scene_object **new_pending = realloc(journal->pending, sizeof(poc_scene_object *) * new_capacity);
+            if (!new_pending) {
+                journal->needs_full_save = true;
+                return;
+            }
+            journal->pending = new_pending;
+            journal->pending_capacity = new_capacity;
+        }
+        journal->pending[journal->pending_count++] = object;
+    }
+
+    object->journal_fields |= (uint8_t)fields;
+}
+
+void poc_scene_journal_track_removal(poc_scene_journal *journal, poc_scene_object *object) {
+    if (!journal || !object) {
+        return;
+    }
+
+    // Keep creation order for the remaining entries
+    if (object->journal_fields != 0) {
+        for (uint32_t i = 0; i < journal->pending_count; i++) {
+            if (journal->pending[i] == object) {
+                memmove(&journal->pending[i], &journal->pending[i + 1],
+                        sizeof(poc_scene_object *) * (journal->pending_count - i - 1));
+                journal->pending_count--;
+                break;
+            }
+        }
+        object->journal_fields = 0;
+    }
+
+    if (journal->removed_count >= journal->removed_capacity) {
+        uint32_t new_capacity = journal->removed_capacity == 0 ? 16 : journal->removed_capacity * 2;
+        uint32_t *new_removed = realloc(journal->removed_ids, sizeof(uint32_t) * new_capacity);
+        if (!new_removed) {
+            journal->needs_full_save = true;
+            return;
+        }
+        journal->removed_ids = new_removed;
+        journal->removed_capacity = new_capacity;
+    }
+    journal->removed_ids[journal->removed_count++] = object->id;
+}
+
+// === Saving ===
+
+static poc_scene_journal *journal_create(const char *path) {
+    poc_scene_journal *journal = calloc(1, sizeof(poc_scene_journal));
+    if (!journal) {
+        return NULL;
+    }
+
+    journal->base_path = path_with_suffix(path, "");
+    journal->journal_path = path_with_suffix(path, ".journal");
+    journal->old_journal_path = path_with_suffix(path, ".journal.old");
+    journal->base_temp_path = path_with_suffix(path, ".tmp");
+    journal->compact_temp_path = path_with_suffix(path, ".compact.tmp");
+    journal->needs_full_save = true;
+
+    if (!journal->base_path || !journal->journal_path || !journal->old_journal_path ||
+        !journal->base_temp_path || !journal->compact_temp_path) {
+        poc_scene_journal_destroy(journal);
+        return NULL;
+    }
+
+    return journal;
+}
+
+void poc_scene_journal_destroy(poc_scene_journal *journal) {
+    if (!journal) {
+        return;
+    }
+
+    finish_compaction(journal, true);
+    if (journal->file) {
+        fclose(journal->file);
+    }
+
+    clear_pending(journal);
+    free(journal->pending);
+    free(journal->removed_ids);
+    free(journal->base_path);
+    free(journal->journal_path);
+    free(journal->old_journal_path);
+    free(journal->base_temp_path);
+    free(journal->compact_temp_path);
+    free(journal);
+}
+
+// Write a fresh base and start an empty journal continuing it
+static bool write_full_save(poc_scene *scene, poc_scene_journal *journal) {
+    finish_compaction(journal, true);
+    if (journal->file) {
+        fclose(journal->file);
+        journal->file = NULL;
+    }
+
+    uint64_t journal_id = new_journal_id();
+    if (!poc_scene_file_write_scene(scene, journal->base_temp_path, journal_id, JOURNAL_HEADER_SIZE) ||
+        rename(journal->base_temp_path, journal->base_path) != 0) {
+        printf("Failed to write scene base '%s'\n", journal->base_path);
+        unlink(journal->base_temp_path);
+        return false;
+    }
+
+    // The new base no longer matches any older journal
+    unlink(journal->old_journal_path);
+    if (!open_journal(journal, journal_id, 0)) {
+        return false;
+    }
+
+    clear_pending(journal);
+    journal->saved_next_id = scene->next_object_id;
+    journal->base_bytes = file_size(journal->base_path);
+    journal->needs_full_save = false;
+
+    printf("✓ Saved scene base '%s' (%u objects); later saves append to the journal\n",
+           journal->base_path, scene->object_count);
+    return true;
+}
+
+static bool append_changes(poc_scene *scene, poc_scene_journal *journal) {
+    if (journal->pending_count == 0 && journal->removed_count == 0 &&
+        journal->saved_next_id == scene->next_object_id) {
+        return true;
+    }
+
+    // Deletes first: an id deleted and recreated since the last save must
+    // end up existing
+    byte_buffer buffer = {0};
+    for (uint32_t i = 0; i < journal->removed_count; i++) {
+        size_t start = begin_record(&buffer, JOURNAL_RECORD_DELETE, 0, journal->removed_ids[i]);
+        end_record(&buffer, start);
+    }
+    for (uint32_t i = 0; i < journal->pending_count; i++) {
+        const poc_scene_object *object = journal->pending[i];
+        encode_upsert(&buffer, object, object->journal_fields);
+    }
+    if (journal->saved_next_id != scene->next_object_id) {
+        size_t start = begin_record(&buffer, JOURNAL_RECORD_NEXT_ID, 0, scene->next_object_id);
+        end_record(&buffer, start);
+    }
+
+    bool written = !buffer.failed &&
+                   fwrite(buffer.data, 1, buffer.size, journal->file) == buffer.size &&
+                   fflush(journal->file) == 0;
+    size_t size = buffer.size;
+    free(buffer.data);
+
+    if (!written) {
+        // A partial append is ignored on replay; rewrite everything instead
+        journal->needs_full_save = true;
+        return write_full_save(scene, journal);
+    }
+
+    journal->journal_bytes += size;
+    journal->saved_next_id = scene->next_object_id;
+    clear_pending(journal);
+    return true;
+}
+
+bool poc_scene_save_incremental(poc_scene *scene, const char *path) {
+    if (!scene || !path) {
+        return false;
+    }
+
+    if (scene->journal && strcmp(scene->journal->base_path, path) != 0) {
+        poc_scene_journal_destroy(scene->journal);
+        scene->journal = NULL;
+    }
+
+    if (!scene->journal) {
+        scene->journal = journal_create(path);
+        if (!scene->journal) {
+            return false;
+        }
+    }
+
+    poc_scene_journal *journal = scene->journal;
+    finish_compaction(journal, false);
+
+    if (journal->needs_full_save || !journal->file) {
+        return write_full_save(scene, journal);
+    }
+
+    if (!append_changes(scene, journal)) {
+        return false;
+    }
+
+    maybe_start_compaction(journal);
+    return true;
+}
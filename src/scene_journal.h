@@ -0,0 +1,69 @@
+/**
+ * @file scene_journal.h
+ * @brief Append-only change journal for incremental scene saves
+ *
+ * poc_scene_save_incremental() writes a full base file once, then appends a
+ * compact binary record per created, deleted or changed object to
+ * "<path>.journal". The base file names the journal it belongs to and how many
+ * journal bytes it already contains, so loading replays exactly the missing
+ * tail. When the journal outgrows the base it is rotated to
+ * "<path>.journal.old" and folded into a new base on a job system worker;
+ * the new base is swapped in with rename() on the next save. Every step leaves
+ * a base/journal pair that loads to the last saved state.
+ */
+
+#pragma once
+
+#include "scene.h"
+#include "scene_file.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Pending changes and file state for one journaled scene
+ */
+typedef struct poc_scene_journal poc_scene_journal;
+
+/**
+ * @brief Record that an object changed since the last save
+ *
+ * @param journal Journal of the object's scene
+ * @param object Changed object
+ * @param fields Mask of poc_scene_object_field bits that changed
+ */
+void poc_scene_journal_track(poc_scene_journal *journal, poc_scene_object *object, uint32_t fields);
+
+/**
+ * @brief Record that an object left the scene
+ *
+ * @param journal Journal of the scene the object is leaving
+ * @param object Removed object
+ */
+void poc_scene_journal_track_removal(poc_scene_journal *journal, poc_scene_object *object);
+
+/**
+ * @brief Finish background work and release a journal
+ *
+ * The files on disk stay valid; pending unsaved changes are dropped.
+ */
+void poc_scene_journal_destroy(poc_scene_journal *journal);
+
+/**
+ * @brief Apply the journal belonging to a base file to its records
+ *
+ * Does nothing if the base carries no journal tag or the journal on disk does
+ * not match it. Afterwards the records no longer reference a journal.
+ *
+ * @param base_path Path of the base scene file
+ * @param records Records read from base_path
+ * @return false if the journal could not be read or applied
+ */
+bool poc_scene_journal_replay(const char *base_path, poc_scene_file_records *records);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,12 +1,30 @@
 #include "scene_object.h"
+#include "scene.h"
+#include "scene_journal.h"
+#include "prefab.h"
 #include "../include/poc_engine.h"
 #include <stdlib.h>
 #include <string.h>
 #include <float.h>
+#include <stdatomic.h>
+
+#if defined(POC_ARCH_X64)
+#include <immintrin.h>
+#elif defined(POC_ARCH_ARM64)
+#include <arm_neon.h>
+#endif
 
 // Access to global context for renderable creation
 extern poc_context *g_active_context;
 
+// Unique across objects, so a renderable that only remembers a generation
+// cannot mistake another object's matrix for the one it holds
+static _Atomic uint64_t next_transform_generation = 1;
+
+static uint64_t new_transform_generation(void) {
+    return atomic_fetch_add_explicit(&next_transform_generation, 1, memory_order_relaxed);
+}
+
 poc_scene_object* poc_scene_object_create(const char *name, uint32_t id) {
     poc_scene_object *obj = malloc(sizeof(poc_scene_object));
     if (!obj) {
@@ -17,10 +35,7 @@ poc_scene_object* poc_scene_object_create(const char *name, uint32_t id) {
 
     // Set identification
     obj->id = id;
-    if (name) {
-        strncpy(obj->name, name, sizeof(obj->name) - 1);
-        obj->name[sizeof(obj->name) - 1] = '\0';
-    }
+    obj->name = poc_string_intern(name);
 
     // Initialize transform to identity
     glm_vec3_zero(obj->position);
@@ -28,6 +43,7 @@ poc_scene_object* poc_scene_object_create(const char *name, uint32_t id) {
     glm_vec3_one(obj->scale);
     glm_mat4_identity(obj->transform_matrix);
     obj->transform_dirty = false;
+    obj->transform_generation = new_transform_generation();
 
     // Initialize bounds to invalid values
     glm_vec3_copy((vec3){FLT_MAX, FLT_MAX, FLT_MAX}, obj->world_aabb_min);
@@ -46,6 +62,20 @@ void poc_scene_object_destroy(poc_scene_object *obj) {
         return;
     }
 
+    // Detach from the owning scene so its dirty lists never hold a stale pointer
+    if (obj->scene) {
+        poc_scene_remove_object(obj->scene, obj);
+    }
+
+    // Expanded prefab nodes go with their instance
+    if (obj->prefab_root) {
+        poc_prefab_instance_forget_node(obj->prefab_root, obj);
+    }
+    if (obj->prefab_instance) {
+        poc_prefab_instance_destroy(obj->prefab_instance);
+        obj->prefab_instance = NULL;
+    }
+
     // Remove from parent
     if (obj->parent) {
         poc_scene_object_remove_child(obj->parent, obj);
@@ -66,10 +96,27 @@ void poc_scene_object_destroy(poc_scene_object *obj) {
         poc_context_destroy_renderable(g_active_context, obj->renderable);
     }
 
-    // Note: We don't destroy mesh or material as they may be shared
+    // Meshes are shared; drop this object's reference. Materials are not owned
+    poc_asset_release_mesh(obj->mesh);
     free(obj);
 }
 
+const char* poc_scene_object_get_name(const poc_scene_object *obj) {
+    return obj ? poc_string_get(obj->name) : "";
+}
+
+void poc_scene_object_set_name(poc_scene_object *obj, const char *name) {
+    if (!obj) {
+        return;
+    }
+
+    poc_string_id id = poc_string_intern(name);
+    if (id != obj->name) {
+        obj->name = id;
+        poc_scene_object_mark_changed(obj, POC_SCENE_OBJECT_FIELD_NAME);
+    }
+}
+
 void poc_scene_object_set_mesh(poc_scene_object *obj, poc_mesh *mesh) {
     if (!obj) {
         return;
@@ -81,17 +128,20 @@ void poc_scene_object_set_mesh(poc_scene_object *obj, poc_mesh *mesh) {
         obj->renderable = NULL;
     }
 
+    // Retain before releasing in case the mesh is set again
+    poc_asset_retain_mesh(mesh);
+    poc_asset_release_mesh(obj->mesh);
     obj->mesh = mesh;
-    obj->bounds_dirty = true;
+    poc_scene_object_mark_changed(obj, POC_SCENE_OBJECT_FIELD_MESH);
 
     // Create new renderable if we have a valid mesh and context
     if (mesh && poc_mesh_is_valid(mesh) && g_active_context) {
-        obj->renderable = poc_context_create_renderable(g_active_context, obj->name);
+        obj->renderable = poc_context_create_renderable(g_active_context, poc_string_get(obj->name));
         if (obj->renderable) {
             // Load the mesh data into the renderable
             poc_result result = poc_renderable_load_mesh(obj->renderable, mesh);
             if (result != POC_RESULT_SUCCESS) {
-                printf("Failed to load mesh into renderable for object %s\n", obj->name);
+                printf("Failed to load mesh into renderable for object %s\n", poc_string_get(obj->name));
                 poc_context_destroy_renderable(g_active_context, obj->renderable);
                 obj->renderable = NULL;
             }
@@ -118,8 +168,7 @@ void poc_scene_object_set_position(poc_scene_object *obj, vec3 position) {
     }
 
     glm_vec3_copy(position, obj->position);
-    obj->transform_dirty = true;
-    obj->bounds_dirty = true;
+    poc_scene_object_mark_changed(obj, POC_SCENE_OBJECT_FIELD_TRANSFORM);
 }
 
 void poc_scene_object_set_rotation(poc_scene_object *obj, vec3 rotation) {
@@ -128,8 +177,7 @@ void poc_scene_object_set_rotation(poc_scene_object *obj, vec3 rotation) {
     }
 
     glm_vec3_copy(rotation, obj->rotation);
-    obj->transform_dirty = true;
-    obj->bounds_dirty = true;
+    poc_scene_object_mark_changed(obj, POC_SCENE_OBJECT_FIELD_TRANSFORM);
 }
 
 void poc_scene_object_set_scale(poc_scene_object *obj, vec3 scale) {
@@ -138,8 +186,7 @@ void poc_scene_object_set_scale(poc_scene_object *obj, vec3 scale) {
     }
 
     glm_vec3_copy(scale, obj->scale);
-    obj->transform_dirty = true;
-    obj->bounds_dirty = true;
+    poc_scene_object_mark_changed(obj, POC_SCENE_OBJECT_FIELD_TRANSFORM);
 }
 
 void poc_scene_object_set_transform(poc_scene_object *obj,
@@ -153,15 +200,45 @@ void poc_scene_object_set_transform(poc_scene_object *obj,
     glm_vec3_copy(position, obj->position);
     glm_vec3_copy(rotation, obj->rotation);
     glm_vec3_copy(scale, obj->scale);
-    obj->transform_dirty = true;
-    obj->bounds_dirty = true;
+    poc_scene_object_mark_changed(obj, POC_SCENE_OBJECT_FIELD_TRANSFORM);
 }
 
-void poc_scene_object_update_transform(poc_scene_object *obj) {
-    if (!obj || !obj->transform_dirty) {
+void poc_scene_object_mark_dirty(poc_scene_object *obj) {
+    poc_scene_object_mark_changed(obj, POC_SCENE_OBJECT_FIELD_ALL);
+}
+
+void poc_scene_object_mark_changed(poc_scene_object *obj, uint32_t fields) {
+    if (!obj) {
         return;
     }
 
+    obj->transform_dirty = true;
+    obj->bounds_dirty = true;
+
+    // Expanded prefab nodes are placed relative to their instance root
+    poc_scene_object *prefab_root = obj->prefab_root ? obj->prefab_root : obj;
+    if (prefab_root->prefab_instance && (fields & (POC_SCENE_OBJECT_FIELD_TRANSFORM | POC_SCENE_OBJECT_FIELD_PARENT))) {
+        poc_prefab_instance_invalidate(prefab_root);
+    }
+
+    if (obj->scene) {
+        if (!obj->change_queued) {
+            poc_scene_mark_object_dirty(obj->scene, obj);
+        }
+        if (obj->scene->journal) {
+            // Node edits are saved as overrides on the root; expansion itself
+            // (before the instance records its nodes) is not an edit
+            if (!obj->prefab_root) {
+                poc_scene_journal_track(obj->scene->journal, obj, fields);
+            } else if (obj->prefab_root->prefab_instance && obj->prefab_root->prefab_instance->nodes) {
+                poc_scene_journal_track(obj->scene->journal, obj->prefab_root, POC_SCENE_OBJECT_FIELD_PREFAB);
+            }
+        }
+    }
+}
+
+// Rebuild the transform matrix without touching bounds
+static void scene_object_rebuild_matrix(poc_scene_object *obj) {
     // Build transform matrix from components
     mat4 translation, rotation_x, rotation_y, rotation_z, scaling, temp;
 
@@ -178,7 +255,25 @@ void poc_scene_object_update_transform(poc_scene_object *obj) {
     glm_mat4_mul(rotation_y, temp, temp);
     glm_mat4_mul(translation, temp, obj->transform_matrix);
 
+    // Expanded prefab nodes are local to their parent node or instance root
+    if (obj->prefab_root && obj->parent) {
+        if (obj->parent->transform_dirty) {
+            scene_object_rebuild_matrix(obj->parent);
+        }
+        glm_mat4_copy(obj->transform_matrix, temp);
+        glm_mat4_mul(obj->parent->transform_matrix, temp, obj->transform_matrix);
+    }
+
     obj->transform_dirty = false;
+    obj->transform_generation = new_transform_generation();
+}
+
+void poc_scene_object_update_transform(poc_scene_object *obj) {
+    if (!obj || !obj->transform_dirty) {
+        return;
+    }
+
+    scene_object_rebuild_matrix(obj);
 
     // Update bounds since transform changed
     poc_scene_object_update_bounds(obj);
@@ -193,52 +288,150 @@ const mat4* poc_scene_object_get_transform_matrix(poc_scene_object *obj) {
     return &obj->transform_matrix;
 }
 
+// Transform a local AABB into a world AABB using the center/extent form:
+// center' = M * center, extent' = |M3x3| * extent. This is exact for the
+// box that encloses all 8 transformed corners, without transforming them.
+#if defined(POC_ARCH_X64)
+static inline void transform_aabb(const mat4 m, const vec3 local_min, const vec3 local_max,
+                                  vec3 out_min, vec3 out_max) {
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+
+    __m128 lmin = _mm_setr_ps(local_min[0], local_min[1], local_min[2], 0.0f);
+    __m128 lmax = _mm_setr_ps(local_max[0], local_max[1], local_max[2], 0.0f);
+    __m128 center = _mm_mul_ps(_mm_add_ps(lmax, lmin), half);
+    __m128 extent = _mm_mul_ps(_mm_sub_ps(lmax, lmin), half);
+
+    __m128 col0 = _mm_loadu_ps(m[0]);
+    __m128 col1 = _mm_loadu_ps(m[1]);
+    __m128 col2 = _mm_loadu_ps(m[2]);
+    __m128 col3 = _mm_loadu_ps(m[3]);
+
+    __m128 world_center = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(col0, _mm_shuffle_ps(center, center, _MM_SHUFFLE(0, 0, 0, 0))),
+                   _mm_mul_ps(col1, _mm_shuffle_ps(center, center, _MM_SHUFFLE(1, 1, 1, 1)))),
+        _mm_add_ps(_mm_mul_ps(col2, _mm_shuffle_ps(center, center, _MM_SHUFFLE(2, 2, 2, 2))),
+                   col3));
+
+    __m128 world_extent = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign_mask, col0),
+                              _mm_shuffle_ps(extent, extent, _MM_SHUFFLE(0, 0, 0, 0))),
+                   _mm_mul_ps(_mm_andnot_ps(sign_mask, col1),
+                              _mm_shuffle_ps(extent, extent, _MM_SHUFFLE(1, 1, 1, 1)))),
+        _mm_mul_ps(_mm_andnot_ps(sign_mask, col2),
+                   _mm_shuffle_ps(extent, extent, _MM_SHUFFLE(2, 2, 2, 2))));
+
+    float result_min[4];
+    float result_max[4];
+    _mm_storeu_ps(result_min, _mm_sub_ps(world_center, world_extent));
+    _mm_storeu_ps(result_max, _mm_add_ps(world_center, world_extent));
+
+    out_min[0] = result_min[0]; out_min[1] = result_min[1]; out_min[2] = result_min[2];
+    out_max[0] = result_max[0]; out_max[1] = result_max[1]; out_max[2] = result_max[2];
+}
+#elif defined(POC_ARCH_ARM64)
+static inline void transform_aabb(const mat4 m, const vec3 local_min, const vec3 local_max,
+                                  vec3 out_min, vec3 out_max) {
+    float lmin_values[4] = {local_min[0], local_min[1], local_min[2], 0.0f};
+    float lmax_values[4] = {local_max[0], local_max[1], local_max[2], 0.0f};
+    float32x4_t lmin = vld1q_f32(lmin_values);
+    float32x4_t lmax = vld1q_f32(lmax_values);
+    float32x4_t center = vmulq_n_f32(vaddq_f32(lmax, lmin), 0.5f);
+    float32x4_t extent = vmulq_n_f32(vsubq_f32(lmax, lmin), 0.5f);
+
+    float32x4_t col0 = vld1q_f32(m[0]);
+    float32x4_t col1 = vld1q_f32(m[1]);
+    float32x4_t col2 = vld1q_f32(m[2]);
+    float32x4_t col3 = vld1q_f32(m[3]);
+
+    float32x4_t world_center = vfmaq_laneq_f32(col3, col0, center, 0);
+    world_center = vfmaq_laneq_f32(world_center, col1, center, 1);
+    world_center = vfmaq_laneq_f32(world_center, col2, center, 2);
+
+    float32x4_t world_extent = vmulq_laneq_f32(vabsq_f32(col0), extent, 0);
+    world_extent = vfmaq_laneq_f32(world_extent, vabsq_f32(col1), extent, 1);
+    world_extent = vfmaq_laneq_f32(world_extent, vabsq_f32(col2), extent, 2);
+
+    float result_min[4];
+    float result_max[4];
+    vst1q_f32(result_min, vsubq_f32(world_center, world_extent));
+    vst1q_f32(result_max, vaddq_f32(world_center, world_extent));
+
+    out_min[0] = result_min[0]; out_min[1] = result_min[1]; out_min[2] = result_min[2];
+    out_max[0] = result_max[0]; out_max[1] = result_max[1]; out_max[2] = result_max[2];
+}
+#else
+static inline void transform_aabb(const mat4 m, const vec3 local_min, const vec3 local_max,
+                                  vec3 out_min, vec3 out_max) {
+    vec3 center, extent;
+    for (int i = 0; i < 3; i++) {
+        center[i] = (local_max[i] + local_min[i]) * 0.5f;
+        extent[i] = (local_max[i] - local_min[i]) * 0.5f;
+    }
+
+    // cglm matrices are column-major: m[column][row]
+    for (int row = 0; row < 3; row++) {
+        float world_center = m[3][row];
+        float world_extent = 0.0f;
+        for (int col = 0; col < 3; col++) {
+            world_center += m[col][row] * center[col];
+            world_extent += fabsf(m[col][row]) * extent[col];
+        }
+        out_min[row] = world_center - world_extent;
+        out_max[row] = world_center + world_extent;
+    }
+}
+#endif
+
 void poc_scene_object_update_bounds(poc_scene_object *obj) {
     if (!obj || !obj->bounds_dirty || !obj->mesh || !poc_mesh_is_valid(obj->mesh)) {
         return;
     }
 
     // Ensure transform is up to date
-    poc_scene_object_update_transform(obj);
+    if (obj->transform_dirty) {
+        scene_object_rebuild_matrix(obj);
+    }
+
+    transform_aabb(obj->transform_matrix,
+                   obj->mesh->local_aabb_min, obj->mesh->local_aabb_max,
+                   obj->world_aabb_min, obj->world_aabb_max);
+    obj->bounds_dirty = false;
+}
 
-    // Transform the 8 corners of the local AABB to world space
-    vec3 corners[8];
-    const vec3 *min = &obj->mesh->local_aabb_min;
-    const vec3 *max = &obj->mesh->local_aabb_max;
+#define BOUNDS_PREFETCH_DISTANCE 4
 
-    // Define all 8 corners of the AABB
-    glm_vec3_copy((vec3){(*min)[0], (*min)[1], (*min)[2]}, corners[0]);
-    glm_vec3_copy((vec3){(*max)[0], (*min)[1], (*min)[2]}, corners[1]);
-    glm_vec3_copy((vec3){(*min)[0], (*max)[1], (*min)[2]}, corners[2]);
-    glm_vec3_copy((vec3){(*max)[0], (*max)[1], (*min)[2]}, corners[3]);
-    glm_vec3_copy((vec3){(*min)[0], (*min)[1], (*max)[2]}, corners[4]);
-    glm_vec3_copy((vec3){(*max)[0], (*min)[1], (*max)[2]}, corners[5]);
-    glm_vec3_copy((vec3){(*min)[0], (*max)[1], (*max)[2]}, corners[6]);
-    glm_vec3_copy((vec3){(*max)[0], (*max)[1], (*max)[2]}, corners[7]);
+void poc_scene_object_update_bounds_list(poc_scene_object **objects, uint32_t count) {
+    if (!objects) {
+        return;
+    }
 
-    // Transform all corners and find new min/max
-    vec3 world_min = {FLT_MAX, FLT_MAX, FLT_MAX};
-    vec3 world_max = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (uint32_t i = 0; i < count; i++) {
+        poc_scene_object *obj = objects[i];
 
-    for (int i = 0; i < 8; i++) {
-        vec4 corner_homogeneous = {corners[i][0], corners[i][1], corners[i][2], 1.0f};
-        vec4 transformed;
+        // Objects are scattered across the heap, so fetching a few ahead
+        // hides more of the miss latency than the arithmetic costs
+        if (i + BOUNDS_PREFETCH_DISTANCE < count && objects[i + BOUNDS_PREFETCH_DISTANCE]) {
+            __builtin_prefetch(objects[i + BOUNDS_PREFETCH_DISTANCE]);
+            __builtin_prefetch(objects[i + BOUNDS_PREFETCH_DISTANCE]->transform_matrix);
+        }
+        if (!obj) {
+            continue;
+        }
 
-        glm_mat4_mulv(obj->transform_matrix, corner_homogeneous, transformed);
+        if (obj->transform_dirty) {
+            scene_object_rebuild_matrix(obj);
+        }
 
-        // Update world bounds
-        if (transformed[0] < world_min[0]) world_min[0] = transformed[0];
-        if (transformed[1] < world_min[1]) world_min[1] = transformed[1];
-        if (transformed[2] < world_min[2]) world_min[2] = transformed[2];
+        if (!obj->bounds_dirty || !obj->mesh || !poc_mesh_is_valid(obj->mesh)) {
+            continue;
+        }
 
-        if (transformed[0] > world_max[0]) world_max[0] = transformed[0];
-        if (transformed[1] > world_max[1]) world_max[1] = transformed[1];
-        if (transformed[2] > world_max[2]) world_max[2] = transformed[2];
+        transform_aabb(obj->transform_matrix,
+                       obj->mesh->local_aabb_min, obj->mesh->local_aabb_max,
+                       obj->world_aabb_min, obj->world_aabb_max);
+        obj->bounds_dirty = false;
     }
-
-    glm_vec3_copy(world_min, obj->world_aabb_min);
-    glm_vec3_copy(world_max, obj->world_aabb_max);
-    obj->bounds_dirty = false;
 }
 
 bool poc_scene_object_is_renderable(const poc_scene_object *obj) {
@@ -273,8 +466,7 @@ void poc_scene_object_add_child(poc_scene_object *parent, poc_scene_object *chil
     child->parent = parent;
 
     // Child transform becomes relative to parent
-    child->transform_dirty = true;
-    child->bounds_dirty = true;
+    poc_scene_object_mark_changed(child, POC_SCENE_OBJECT_FIELD_PARENT);
 }
 
 void poc_scene_object_remove_child(poc_scene_object *parent, poc_scene_object *child) {
@@ -291,6 +483,7 @@ void poc_scene_object_remove_child(poc_scene_object *parent, poc_scene_object *c
             }
             parent->child_count--;
             child->parent = NULL;
+            poc_scene_object_mark_changed(child, POC_SCENE_OBJECT_FIELD_PARENT);
             break;
         }
     }
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "mesh.h"
+#include "string_table.h"
 #include <cglm/cglm.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -19,6 +20,21 @@ extern "C" {
 
 // Forward declarations
 typedef struct poc_renderable poc_renderable;
+struct poc_scene;
+struct poc_prefab_instance;
+
+/**
+ * @brief Persistent object fields, used to describe what a change touched
+ */
+typedef enum poc_scene_object_field {
+    POC_SCENE_OBJECT_FIELD_TRANSFORM = 1 << 0, /**< Position, rotation and scale */
+    POC_SCENE_OBJECT_FIELD_FLAGS     = 1 << 1, /**< Visible and enabled */
+    POC_SCENE_OBJECT_FIELD_NAME      = 1 << 2, /**< Name */
+    POC_SCENE_OBJECT_FIELD_MESH      = 1 << 3, /**< Mesh reference */
+    POC_SCENE_OBJECT_FIELD_PARENT    = 1 << 4, /**< Parent link */
+    POC_SCENE_OBJECT_FIELD_PREFAB    = 1 << 5, /**< Prefab reference and node overrides */
+    POC_SCENE_OBJECT_FIELD_ALL       = 0x3F
+} poc_scene_object_field;
 
 /**
  * @brief Scene object representing an entity in the 3D world
@@ -29,7 +45,7 @@ typedef struct poc_renderable poc_renderable;
 typedef struct poc_scene_object {
     // Identification
     uint32_t id;                /**< Unique object ID */
-    char name[256];             /**< Human-readable name */
+    poc_string_id name;         /**< Interned human-readable name */
 
     // Transform components
     vec3 position;              /**< Local position */
@@ -37,6 +53,7 @@ typedef struct poc_scene_object {
     vec3 scale;                 /**< Scale factors */
     mat4 transform_matrix;      /**< Computed world transform matrix */
     bool transform_dirty;       /**< Whether transform needs recalculation */
+    uint64_t transform_generation; /**< Process-wide unique stamp, renewed whenever transform_matrix is rebuilt */
 
     // Components
     poc_mesh *mesh;             /**< Mesh component (optional) */
@@ -57,6 +74,17 @@ typedef struct poc_scene_object {
     // State
     bool visible;               /**< Whether object should be rendered */
     bool enabled;               /**< Whether object is active in scene */
+
+    // Prefabs (see prefab.h)
+    struct poc_prefab_instance *prefab_instance; /**< Prefab this object instantiates (instance roots only) */
+    struct poc_scene_object *prefab_root;        /**< Instance root owning this expanded node, or NULL */
+
+    // Change tracking
+    struct poc_scene *scene;    /**< Scene the object belongs to (NULL if detached) */
+    bool change_queued;         /**< Whether the object is on the scene's dirty list */
+    uint8_t journal_fields;     /**< poc_scene_object_field bits changed since the last journaled save */
+    uint32_t broadphase_proxy;  /**< Proxy index + 1 in the scene's broadphase, 0 if untracked */
+    uint32_t spatial_proxy;     /**< Proxy index + 1 in the scene's spatial hash, 0 if untracked */
 } poc_scene_object;
 
 /**
@@ -74,12 +102,29 @@ poc_scene_object* poc_scene_object_create(const char *name, uint32_t id);
  * @brief Destroy a scene object and free its resources
  *
  * Destroys the scene object but does not destroy referenced components
- * (mesh, material) as they may be shared.
+ * (mesh, material) as they may be shared. If the object still belongs to a
+ * scene it is removed from that scene first.
  *
  * @param obj The scene object to destroy
  */
 void poc_scene_object_destroy(poc_scene_object *obj);
 
+/**
+ * @brief Get the name of a scene object
+ *
+ * @param obj The scene object
+ * @return Name string (never NULL; valid for the lifetime of the process)
+ */
+const char* poc_scene_object_get_name(const poc_scene_object *obj);
+
+/**
+ * @brief Rename a scene object
+ *
+ * @param obj The scene object
+ * @param name New name (NULL clears it)
+ */
+void poc_scene_object_set_name(poc_scene_object *obj, const char *name);
+
 /**
  * @brief Set the mesh component of a scene object
  *
@@ -138,6 +183,28 @@ void poc_scene_object_set_transform(poc_scene_object *obj,
                                     vec3 rotation,
                                     vec3 scale);
 
+/**
+ * @brief Flag an object as changed for this frame
+ *
+ * Marks transform and bounds dirty and pushes the object onto its scene's
+ * dirty list so poc_scene_update only visits changed objects. All setters
+ * call this; use it directly after writing object fields by hand.
+ *
+ * @param obj The scene object
+ */
+void poc_scene_object_mark_dirty(poc_scene_object *obj);
+
+/**
+ * @brief Flag an object as changed, naming the persistent fields involved
+ *
+ * Same as poc_scene_object_mark_dirty, but lets incremental saves record only
+ * the touched fields. Setters use this with the field they write.
+ *
+ * @param obj The scene object
+ * @param fields Mask of poc_scene_object_field bits
+ */
+void poc_scene_object_mark_changed(poc_scene_object *obj, uint32_t fields);
+
 /**
  * @brief Update the transform matrix from position/rotation/scale
  *
@@ -161,13 +228,26 @@ const mat4* poc_scene_object_get_transform_matrix(poc_scene_object *obj);
 /**
  * @brief Update world-space bounding box from mesh and transform
  *
- * Recalculates world AABB by transforming the local mesh bounds.
- * Called automatically when transform or mesh changes.
+ * Recalculates world AABB from the local mesh bounds using the center/extent
+ * form (center' = M * c, extent' = |M| * e), which yields the same box as
+ * transforming all 8 corners. Called automatically when transform or mesh changes.
  *
  * @param obj The scene object
  */
 void poc_scene_object_update_bounds(poc_scene_object *obj);
 
+/**
+ * @brief Update transforms and world-space bounds for a list of objects
+ *
+ * Same per-object center/extent transform as poc_scene_object_update_bounds,
+ * run over the list while prefetching objects a few entries ahead. Rebuilds
+ * dirty transforms and refreshes dirty bounds; clean objects are skipped.
+ *
+ * @param objects Array of object pointers (NULL entries are skipped)
+ * @param count Number of entries in the array
+ */
+void poc_scene_object_update_bounds_list(poc_scene_object **objects, uint32_t count);
+
 /**
  * @brief Check if object has valid renderable geometry
  *
@@ -1,27 +1,18 @@
 #include "scene.h"
 #include "scene_object.h"
+#include "scene_file.h"
+#include "scene_journal.h"
+#include "prefab.h"
 #include "mesh.h"
+#include "asset_manager.h"
 #include "poc_engine.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <math.h>
 
-#define SCENE_FILE_HEADER "poc_scene"
-#define SCENE_FILE_VERSION 1
-
-typedef struct parsed_object {
-    uint32_t id;
-    uint32_t parent_id;
-    bool id_set;
-    char name[256];
-    float position[3];
-    float rotation[3];
-    float scale[3];
-    bool visible;
-    bool enabled;
-    char mesh_path[POC_ASSET_PATH_MAX];
-} parsed_object;
+typedef poc_scene_file_object parsed_object;
 
 static char *trim_whitespace(char *str) {
     if (!str) {
@@ -89,7 +80,7 @@ static void write_quoted_string(FILE *file, const char *key, const char *value)
     fprintf(file, "\"\n");
 }
 
-static void parsed_object_init(parsed_object *object) {
+void poc_scene_file_object_init(poc_scene_file_object *object) {
     memset(object, 0, sizeof(*object));
     object->visible = true;
     object->enabled = true;
@@ -98,58 +89,197 @@ static void parsed_object_init(parsed_object *object) {
     object->scale[2] = 1.0f;
 }
 
-static bool ensure_mesh_capacity(poc_scene *scene) {
-    if (scene->mesh_asset_count < scene->mesh_asset_capacity) {
-        return true;
+// Apply one key=value line inside an [object] section
+static void parse_object_field(parsed_object *current, char *line) {
+    char *equals = strchr(line, '=');
+    if (!equals) {
+        return;
     }
 
-    uint32_t new_capacity = scene->mesh_asset_capacity == 0 ? 8 : scene->mesh_asset_capacity * 2;
-    poc_scene_mesh_entry *entries = realloc(scene->mesh_assets,
-                                            sizeof(poc_scene_mesh_entry) * new_capacity);
-    if (!entries) {
-        return false;
+    *equals = '\0';
+    char *key = trim_whitespace(line);
+    char *value = trim_whitespace(equals + 1);
+
+    if (strcmp(key, "id") == 0) {
+        current->id = (uint32_t)strtoul(value, NULL, 10);
+        current->id_set = true;
+    } else if (strcmp(key, "name") == 0) {
+        parse_quoted_string(value, current->name, sizeof(current->name));
+    } else if (strcmp(key, "position") == 0) {
+        sscanf(value, "%f %f %f", &current->position[0], &current->position[1], &current->position[2]);
+    } else if (strcmp(key, "rotation") == 0) {
+        sscanf(value, "%f %f %f", &current->rotation[0], &current->rotation[1], &current->rotation[2]);
+    } else if (strcmp(key, "scale") == 0) {
+        sscanf(value, "%f %f %f", &current->scale[0], &current->scale[1], &current->scale[2]);
+    } else if (strcmp(key, "visible") == 0) {
+        current->visible = (int)strtol(value, NULL, 10) != 0;
+    } else if (strcmp(key, "enabled") == 0) {
+        current->enabled = (int)strtol(value, NULL, 10) != 0;
+    } else if (strcmp(key, "parent") == 0) {
+        current->parent_id = (uint32_t)strtoul(value, NULL, 10);
+    } else if (strcmp(key, "mesh") == 0) {
+        parse_quoted_string(value, current->mesh_path, sizeof(current->mesh_path));
+    } else if (strcmp(key, "prefab") == 0) {
+        parse_quoted_string(value, current->prefab_path, sizeof(current->prefab_path));
+    }
+}
+
+// Apply one key=value line inside an [override] section
+static void parse_override_field(poc_prefab_override *current, char *line) {
+    char *equals = strchr(line, '=');
+    if (!equals) {
+        return;
     }
 
-    scene->mesh_assets = entries;
-    scene->mesh_asset_capacity = new_capacity;
-    return true;
+    *equals = '\0';
+    char *key = trim_whitespace(line);
+    char *value = trim_whitespace(equals + 1);
+
+    if (strcmp(key, "node") == 0) {
+        current->node = (uint32_t)strtoul(value, NULL, 10);
+    } else if (strcmp(key, "position") == 0) {
+        sscanf(value, "%f %f %f", &current->position[0], &current->position[1], &current->position[2]);
+        current->fields |= POC_SCENE_OBJECT_FIELD_TRANSFORM;
+    } else if (strcmp(key, "rotation") == 0) {
+        sscanf(value, "%f %f %f", &current->rotation[0], &current->rotation[1], &current->rotation[2]);
+        current->fields |= POC_SCENE_OBJECT_FIELD_TRANSFORM;
+    } else if (strcmp(key, "scale") == 0) {
+        sscanf(value, "%f %f %f", &current->scale[0], &current->scale[1], &current->scale[2]);
+        current->fields |= POC_SCENE_OBJECT_FIELD_TRANSFORM;
+    } else if (strcmp(key, "visible") == 0) {
+        current->visible = (int)strtol(value, NULL, 10) != 0;
+        current->fields |= POC_SCENE_OBJECT_FIELD_FLAGS;
+    } else if (strcmp(key, "enabled") == 0) {
+        current->enabled = (int)strtol(value, NULL, 10) != 0;
+        current->fields |= POC_SCENE_OBJECT_FIELD_FLAGS;
+    }
+}
+
+static void init_override(poc_prefab_override *override) {
+    memset(override, 0, sizeof(*override));
+    override->scale[0] = 1.0f;
+    override->scale[1] = 1.0f;
+    override->scale[2] = 1.0f;
+    override->visible = true;
+    override->enabled = true;
 }
 
-static poc_mesh* scene_acquire_mesh(poc_scene *scene, const char *path) {
-    if (!scene || !path || !path[0]) {
+poc_scene_object *poc_scene_file_object_instantiate(const poc_scene_file_object *record) {
+    if (!record) {
+        return NULL;
+    }
+
+    poc_scene_object *obj = poc_scene_object_create(record->name[0] ? record->name : "SceneObject", record->id);
+    if (!obj) {
         return NULL;
     }
 
-    for (uint32_t i = 0; i < scene->mesh_asset_count; i++) {
-        poc_scene_mesh_entry *entry = &scene->mesh_assets[i];
-        if (strcmp(entry->path, path) == 0) {
-            entry->ref_count++;
-            return entry->mesh;
+    poc_scene_object_set_transform(obj, (vec3){record->position[0], record->position[1], record->position[2]},
+                                   (vec3){record->rotation[0], record->rotation[1], record->rotation[2]},
+                                   (vec3){record->scale[0], record->scale[1], record->scale[2]});
+    obj->visible = record->visible;
+    obj->enabled = record->enabled;
+
+    if (record->prefab_path[0] != '\0') {
+        poc_prefab *prefab = poc_prefab_load(record->prefab_path);
+        obj->prefab_instance = poc_prefab_instance_create(prefab);
+        poc_prefab_release(prefab);
+        if (!obj->prefab_instance) {
+            printf("Warning: Failed to instantiate prefab '%s'\n", record->prefab_path);
         }
     }
+    return obj;
+}
 
-    poc_mesh *mesh = poc_mesh_load(path);
-    if (!mesh) {
-        printf("Failed to load mesh '%s' while reading scene file\n", path);
-        return NULL;
+void poc_scene_file_cell_of(float cell_size, const float position[3], int32_t *out_x, int32_t *out_z) {
+    *out_x = (int32_t)floorf(position[0] / cell_size);
+    *out_z = (int32_t)floorf(position[2] / cell_size);
+}
+
+void poc_scene_file_object_from_scene_object(poc_scene_file_object *record, const poc_scene_object *object) {
+    poc_scene_file_object_init(record);
+    record->id = object->id;
+    record->id_set = true;
+    record->parent_id = object->parent ? object->parent->id : 0;
+    strncpy(record->name, poc_string_get(object->name), sizeof(record->name) - 1);
+    memcpy(record->position, object->position, sizeof(record->position));
+    memcpy(record->rotation, object->rotation, sizeof(record->rotation));
+    memcpy(record->scale, object->scale, sizeof(record->scale));
+    record->visible = object->visible;
+    record->enabled = object->enabled;
+
+    if (object->mesh && object->mesh->source_path != POC_STRING_EMPTY) {
+        strncpy(record->mesh_path, poc_string_get(object->mesh->source_path), sizeof(record->mesh_path) - 1);
+    }
+    if (object->prefab_instance) {
+        snprintf(record->prefab_path, sizeof(record->prefab_path), "%s", object->prefab_instance->prefab->path);
     }
+}
 
-    if (!ensure_mesh_capacity(scene)) {
-        poc_mesh_destroy(mesh);
-        return NULL;
+static void write_record(FILE *file, const parsed_object *record,
+                         const poc_prefab_override *overrides, uint32_t override_count) {
+    fprintf(file, "[object]\n");
+    fprintf(file, "id=%u\n", record->id);
+    write_quoted_string(file, "name", record->name);
+    fprintf(file, "position=%.6f %.6f %.6f\n",
+            record->position[0], record->position[1], record->position[2]);
+    fprintf(file, "rotation=%.6f %.6f %.6f\n",
+            record->rotation[0], record->rotation[1], record->rotation[2]);
+    fprintf(file, "scale=%.6f %.6f %.6f\n",
+            record->scale[0], record->scale[1], record->scale[2]);
+    fprintf(file, "visible=%d\n", record->visible ? 1 : 0);
+    fprintf(file, "enabled=%d\n", record->enabled ? 1 : 0);
+    fprintf(file, "parent=%u\n", record->parent_id);
+    write_quoted_string(file, "mesh", record->mesh_path);
+    if (record->prefab_path[0] != '\0') {
+        write_quoted_string(file, "prefab", record->prefab_path);
     }
+    fprintf(file, "[end]\n");
+
+    for (uint32_t i = 0; i < override_count; i++) {
+        const poc_prefab_override *override = &overrides[i];
+        fprintf(file, "[override]\n");
+        fprintf(file, "node=%u\n", override->node);
+        if (override->fields & POC_SCENE_OBJECT_FIELD_TRANSFORM) {
+            fprintf(file, "position=%.6f %.6f %.6f\n",
+                    override->position[0], override->position[1], override->position[2]);
+            fprintf(file, "rotation=%.6f %.6f %.6f\n",
+                    override->rotation[0], override->rotation[1], override->rotation[2]);
+            fprintf(file, "scale=%.6f %.6f %.6f\n",
+                    override->scale[0], override->scale[1], override->scale[2]);
+        }
+        if (override->fields & POC_SCENE_OBJECT_FIELD_FLAGS) {
+            fprintf(file, "visible=%d\n", override->visible ? 1 : 0);
+            fprintf(file, "enabled=%d\n", override->enabled ? 1 : 0);
+        }
+        fprintf(file, "[end]\n");
+    }
+}
 
-    poc_scene_mesh_entry *entry = &scene->mesh_assets[scene->mesh_asset_count++];
-    memset(entry, 0, sizeof(*entry));
-    strncpy(entry->path, path, POC_ASSET_PATH_MAX - 1);
-    entry->mesh = mesh;
-    entry->ref_count = 1;
-    entry->owned = true;
+// Expanded prefab nodes are saved as their root's overrides, not as objects
+static void write_object(FILE *file, const poc_scene_object *object) {
+    parsed_object record;
+    poc_scene_file_object_from_scene_object(&record, object);
 
-    return mesh;
+    poc_prefab_instance *instance = object->prefab_instance;
+    if (instance && poc_prefab_instance_sync_overrides(instance)) {
+        write_record(file, &record, instance->overrides, instance->override_count);
+    } else {
+        write_record(file, &record, NULL, 0);
+    }
 }
 
-bool poc_scene_save_to_file(const poc_scene *scene, const char *path) {
+static void write_flat_header(FILE *file, uint32_t next_id, uint64_t journal_id, uint64_t journal_offset) {
+    fprintf(file, "%s v%d\n", POC_SCENE_FILE_HEADER, POC_SCENE_FILE_VERSION);
+    fprintf(file, "next_id=%u\n", next_id);
+    if (journal_id != 0) {
+        fprintf(file, "journal_id=%llu\n", (unsigned long long)journal_id);
+        fprintf(file, "journal_offset=%llu\n", (unsigned long long)journal_offset);
+    }
+}
+
+bool poc_scene_file_write_scene(const poc_scene *scene, const char *path,
+                                uint64_t journal_id, uint64_t journal_offset) {
     if (!scene || !path) {
         return false;
     }
@@ -160,63 +290,496 @@ bool poc_scene_save_to_file(const poc_scene *scene, const char *path) {
         return false;
     }
 
-    fprintf(file, "%s v%d\n", SCENE_FILE_HEADER, SCENE_FILE_VERSION);
-    fprintf(file, "next_id=%u\n", scene->next_object_id);
+    write_flat_header(file, scene->next_object_id, journal_id, journal_offset);
 
     for (uint32_t i = 0; i < scene->object_count; i++) {
         const poc_scene_object *object = scene->objects[i];
-        if (!object) {
+        if (!object || object->prefab_root) {
             continue;
         }
 
-        fprintf(file, "[object]\n");
-        fprintf(file, "id=%u\n", object->id);
-        write_quoted_string(file, "name", object->name);
-        fprintf(file, "position=%.6f %.6f %.6f\n",
-                object->position[0], object->position[1], object->position[2]);
-        fprintf(file, "rotation=%.6f %.6f %.6f\n",
-                object->rotation[0], object->rotation[1], object->rotation[2]);
-        fprintf(file, "scale=%.6f %.6f %.6f\n",
-                object->scale[0], object->scale[1], object->scale[2]);
-        fprintf(file, "visible=%d\n", object->visible ? 1 : 0);
-        fprintf(file, "enabled=%d\n", object->enabled ? 1 : 0);
-        uint32_t parent_id = object->parent ? object->parent->id : 0;
-        fprintf(file, "parent=%u\n", parent_id);
-
-        const char *mesh_path = "";
-        if (object->mesh && object->mesh->source_path[0] != '\0') {
-            mesh_path = object->mesh->source_path;
-        }
-        write_quoted_string(file, "mesh", mesh_path);
-        fprintf(file, "[end]\n");
+        write_object(file, object);
+    }
+
+    bool success = !ferror(file);
+    success = fclose(file) == 0 && success;
+    return success;
+}
+
+static int compare_file_override(const void *a, const void *b) {
+    const poc_scene_file_override *lhs = a;
+    const poc_scene_file_override *rhs = b;
+    if (lhs->owner_id != rhs->owner_id) {
+        return lhs->owner_id < rhs->owner_id ? -1 : 1;
+    }
+    return (lhs->override.node > rhs->override.node) - (lhs->override.node < rhs->override.node);
+}
+
+// Locate the run of owner_id in an ascending owner array
+static void find_override_range(const uint32_t *owners, uint32_t count, uint32_t owner_id,
+                                uint32_t *out_first, uint32_t *out_count) {
+    uint32_t low = 0;
+    uint32_t high = count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (owners[mid] < owner_id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    uint32_t end = low;
+    while (end < count && owners[end] == owner_id) {
+        end++;
+    }
+    *out_first = low;
+    *out_count = end - low;
+}
+
+// Split the overrides into parallel arrays sorted by owner, then node
+static bool group_overrides(const poc_scene_file_records *records,
+                            poc_prefab_override **out_overrides, uint32_t **out_owners) {
+    *out_overrides = NULL;
+    *out_owners = NULL;
+    if (records->override_count == 0) {
+        return true;
+    }
+
+    poc_scene_file_override *sorted = malloc(sizeof(poc_scene_file_override) * records->override_count);
+    poc_prefab_override *overrides = malloc(sizeof(poc_prefab_override) * records->override_count);
+    uint32_t *owners = malloc(sizeof(uint32_t) * records->override_count);
+    if (!sorted || !overrides || !owners) {
+        free(sorted);
+        free(overrides);
+        free(owners);
+        return false;
+    }
+
+    memcpy(sorted, records->overrides, sizeof(poc_scene_file_override) * records->override_count);
+    qsort(sorted, records->override_count, sizeof(poc_scene_file_override), compare_file_override);
+    for (uint32_t i = 0; i < records->override_count; i++) {
+        overrides[i] = sorted[i].override;
+        owners[i] = sorted[i].owner_id;
+    }
+    free(sorted);
+
+    *out_overrides = overrides;
+    *out_owners = owners;
+    return true;
+}
+
+bool poc_scene_file_write_records(const char *path, const poc_scene_file_records *records) {
+    if (!path || !records) {
+        return false;
+    }
+
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        printf("Failed to open scene file '%s' for writing\n", path);
+        return false;
+    }
+
+    write_flat_header(file, records->next_id, records->journal_id, records->journal_offset);
+
+    // Group each instance's overrides so they can follow its record
+    poc_prefab_override *overrides = NULL;
+    uint32_t *override_owners = NULL;
+    if (!group_overrides(records, &overrides, &override_owners)) {
+        fclose(file);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < records->count; i++) {
+        const parsed_object *record = &records->objects[i];
+        uint32_t first = 0;
+        uint32_t count = 0;
+        if (record->prefab_path[0] != '\0' && record->id_set) {
+            find_override_range(override_owners, records->override_count, record->id, &first, &count);
+        }
+        write_record(file, record, overrides ? overrides + first : NULL, count);
+    }
+    free(overrides);
+    free(override_owners);
+
+    bool success = !ferror(file);
+    success = fclose(file) == 0 && success;
+    return success;
+}
+
+bool poc_scene_save_to_file(const poc_scene *scene, const char *path) {
+    return poc_scene_file_write_scene(scene, path, 0, 0);
+}
+
+typedef struct {
+    int32_t x;
+    int32_t z;
+    uint32_t object_index;
+} cell_assignment;
+
+static int compare_cell_assignment(const void *a, const void *b) {
+    const cell_assignment *lhs = a;
+    const cell_assignment *rhs = b;
+    if (lhs->x != rhs->x) {
+        return lhs->x < rhs->x ? -1 : 1;
+    }
+    if (lhs->z != rhs->z) {
+        return lhs->z < rhs->z ? -1 : 1;
+    }
+    // Keep scene order within a cell so saves are stable
+    return lhs->object_index < rhs->object_index ? -1 : (lhs->object_index > rhs->object_index ? 1 : 0);
+}
+
+bool poc_scene_save_partitioned(const poc_scene *scene, const char *path, float cell_size) {
+    if (!scene || !path || !(cell_size > 0.0f)) {
+        return false;
+    }
+
+    cell_assignment *assignments = NULL;
+    if (scene->object_count > 0) {
+        assignments = malloc(sizeof(cell_assignment) * scene->object_count);
+        if (!assignments) {
+            return false;
+        }
+    }
+
+    // Objects follow the cell of their hierarchy root so parents and children
+    // always stream in together
+    uint32_t assignment_count = 0;
+    for (uint32_t i = 0; i < scene->object_count; i++) {
+        const poc_scene_object *object = scene->objects[i];
+        if (!object || object->prefab_root) {
+            continue;
+        }
+
+        const poc_scene_object *root = object;
+        while (root->parent) {
+            root = root->parent;
+        }
+
+        cell_assignment *assignment = &assignments[assignment_count++];
+        poc_scene_file_cell_of(cell_size, root->position, &assignment->x, &assignment->z);
+        assignment->object_index = i;
+    }
+
+    qsort(assignments, assignment_count, sizeof(cell_assignment), compare_cell_assignment);
+
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        printf("Failed to open scene file '%s' for writing\n", path);
+        free(assignments);
+        return false;
+    }
+
+    fprintf(file, "%s v%d\n", POC_SCENE_FILE_HEADER, POC_SCENE_FILE_VERSION_PARTITIONED);
+    fprintf(file, "next_id=%u\n", scene->next_object_id);
+    fprintf(file, "cell_size=%.6f\n", cell_size);
+
+    uint32_t cell_count = 0;
+    for (uint32_t i = 0; i < assignment_count; i++) {
+        const cell_assignment *assignment = &assignments[i];
+        bool new_cell = i == 0 || assignment->x != assignments[i - 1].x || assignment->z != assignments[i - 1].z;
+        if (new_cell) {
+            if (i > 0) {
+                fprintf(file, "[endcell]\n");
+            }
+            fprintf(file, "[cell %d %d]\n", assignment->x, assignment->z);
+            cell_count++;
+        }
+
+        write_object(file, scene->objects[assignment->object_index]);
+    }
+    if (assignment_count > 0) {
+        fprintf(file, "[endcell]\n");
     }
 
     fclose(file);
+    free(assignments);
+
+    printf("✓ Saved partitioned scene '%s' (%u objects in %u cells of %.1f units)\n",
+           path, assignment_count, cell_count, cell_size);
     return true;
 }
 
-poc_scene* poc_scene_load_from_file(const char *path) {
-    if (!path) {
-        return NULL;
+bool poc_scene_file_read_index(const char *path, poc_scene_file_index *index) {
+    if (!path || !index) {
+        return false;
     }
 
+    memset(index, 0, sizeof(*index));
+
     FILE *file = fopen(path, "r");
     if (!file) {
         printf("Failed to open scene file '%s' for reading\n", path);
-        return NULL;
+        return false;
+    }
+
+    char line[1024];
+    bool header_seen = false;
+    int version = 0;
+    uint32_t cell_capacity = 0;
+    poc_scene_file_cell *current_cell = NULL;
+
+    while (fgets(line, sizeof(line), file)) {
+        char *trimmed = trim_whitespace(line);
+        if (!trimmed || trimmed[0] == '\0' || trimmed[0] == '#') {
+            continue;
+        }
+
+        if (!header_seen) {
+            if (sscanf(trimmed, "%*s v%d", &version) != 1 ||
+                strncmp(trimmed, POC_SCENE_FILE_HEADER, strlen(POC_SCENE_FILE_HEADER)) != 0) {
+                printf("Invalid scene file header: %s\n", trimmed);
+                break;
+            }
+            header_seen = true;
+            continue;
+        }
+
+        int32_t cell_x, cell_z;
+        if (sscanf(trimmed, "[cell %d %d]", &cell_x, &cell_z) == 2) {
+            if (index->cell_count >= cell_capacity) {
+                uint32_t new_capacity = cell_capacity == 0 ? 16 : cell_capacity * 2;
+                poc_scene_file_cell *new_cells = realloc(index->cells, sizeof(poc_scene_file_cell) * new_capacity);
+                if (!new_cells) {
+                    poc_scene_file_index_free(index);
+                    fclose(file);
+                    return false;
+                }
+                index->cells = new_cells;
+                cell_capacity = new_capacity;
+            }
+
+            current_cell = &index->cells[index->cell_count++];
+            current_cell->x = cell_x;
+            current_cell->z = cell_z;
+            current_cell->offset = ftell(file);
+            current_cell->object_count = 0;
+        } else if (strcmp(trimmed, "[endcell]") == 0) {
+            current_cell = NULL;
+        } else if (strcmp(trimmed, "[object]") == 0) {
+            if (current_cell) {
+                current_cell->object_count++;
+            }
+        } else if (!current_cell && strncmp(trimmed, "next_id=", 8) == 0) {
+            index->next_id = (uint32_t)strtoul(trimmed + 8, NULL, 10);
+        } else if (!current_cell && strncmp(trimmed, "cell_size=", 10) == 0) {
+            index->cell_size = strtof(trimmed + 10, NULL);
+        }
+    }
+
+    fclose(file);
+
+    if (!header_seen || version < POC_SCENE_FILE_VERSION_PARTITIONED || !(index->cell_size > 0.0f)) {
+        printf("Scene file '%s' is not partitioned into cells\n", path);
+        poc_scene_file_index_free(index);
+        return false;
     }
 
-    parsed_object *objects = NULL;
-    size_t object_count = 0;
-    size_t object_capacity = 0;
+    return true;
+}
+
+void poc_scene_file_index_free(poc_scene_file_index *index) {
+    if (!index) {
+        return;
+    }
+
+    free(index->cells);
+    memset(index, 0, sizeof(*index));
+}
+
+bool poc_scene_file_read_cell(const char *path, const poc_scene_file_cell *cell,
+                              poc_scene_file_records *records) {
+    if (!path || !cell || !records) {
+        return false;
+    }
+
+    memset(records, 0, sizeof(*records));
+
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        printf("Failed to open scene file '%s' for reading\n", path);
+        return false;
+    }
+
+    if (fseek(file, cell->offset, SEEK_SET) != 0) {
+        fclose(file);
+        return false;
+    }
+
+    bool in_object = false;
+    bool in_override = false;
+    bool success = true;
+    parsed_object current;
+    poc_scene_file_object_init(&current);
+    poc_scene_file_override current_override;
+
+    char line[1024];
+    while (fgets(line, sizeof(line), file)) {
+        char *trimmed = trim_whitespace(line);
+        if (!trimmed || trimmed[0] == '\0' || trimmed[0] == '#') {
+            continue;
+        }
+
+        if (!in_object) {
+            if (strcmp(trimmed, "[endcell]") == 0) {
+                break;
+            }
+            if (strcmp(trimmed, "[object]") == 0) {
+                poc_scene_file_object_init(&current);
+                in_object = true;
+            } else if (strcmp(trimmed, "[override]") == 0) {
+                // Belongs to the record just read, as in a flat file
+                const parsed_object *owner = records->count > 0 ? &records->objects[records->count - 1] : NULL;
+                current_override.owner_id = owner && owner->id_set && owner->prefab_path[0] ? owner->id : 0;
+                init_override(&current_override.override);
+                in_override = true;
+                in_object = true;
+            }
+            continue;
+        }
+
+        if (in_override) {
+            if (strcmp(trimmed, "[end]") == 0) {
+                if (current_override.owner_id != 0 &&
+                    !poc_scene_file_records_append_override(records, &current_override)) {
+                    success = false;
+                    break;
+                }
+                in_override = false;
+                in_object = false;
+                continue;
+            }
+
+            parse_override_field(&current_override.override, trimmed);
+            continue;
+        }
+
+        if (strcmp(trimmed, "[end]") == 0) {
+            if (!poc_scene_file_records_append(records, &current)) {
+                success = false;
+                break;
+            }
+            in_object = false;
+            continue;
+        }
+
+        parse_object_field(&current, trimmed);
+    }
+
+    fclose(file);
+
+    if (!success || in_object) {
+        poc_scene_file_records_free(records);
+        return false;
+    }
+
+    return true;
+}
+
+bool poc_scene_file_records_apply_overrides(const poc_scene_file_records *records, poc_scene_object *object) {
+    if (!records || !object || !object->prefab_instance) {
+        return false;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < records->override_count; i++) {
+        if (records->overrides[i].owner_id == object->id) {
+            count++;
+        }
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    poc_prefab_override *overrides = malloc(sizeof(poc_prefab_override) * count);
+    if (!overrides) {
+        return false;
+    }
+    uint32_t stored = 0;
+    for (uint32_t i = 0; i < records->override_count; i++) {
+        if (records->overrides[i].owner_id == object->id) {
+            overrides[stored++] = records->overrides[i].override;
+        }
+    }
+
+    bool applied = poc_prefab_instance_set_overrides(object->prefab_instance, overrides, count);
+    free(overrides);
+    return applied;
+}
+
+bool poc_scene_file_records_append(poc_scene_file_records *records, const poc_scene_file_object *object) {
+    if (records->count >= records->capacity) {
+        uint32_t new_capacity = records->capacity == 0 ? 8 : records->capacity * 2;
+        parsed_object *new_objects = realloc(records->objects, new_capacity * sizeof(parsed_object));
+        if (!new_objects) {
+            return false;
+        }
+        records->objects = new_objects;
+        records->capacity = new_capacity;
+    }
+
+    records->objects[records->count++] = *object;
+    return true;
+}
+
+bool poc_scene_file_records_append_override(poc_scene_file_records *records,
+                                            const poc_scene_file_override *override) {
+    if (records->override_count >= records->override_capacity) {
+        uint32_t new_capacity = records->override_capacity == 0 ? 8 : records->override_capacity * 2;
+        poc_scene_file_override *new_overrides = realloc(records->overrides,
+                                                         new_capacity * sizeof(poc_scene_file_override));
+        if (!new_overrides) {
+            return false;
+        }
+        records->overrides = new_overrides;
+        records->override_capacity = new_capacity;
+    }
+
+    records->overrides[records->override_count++] = *override;
+    return true;
+}
+
+void poc_scene_file_records_remove_overrides(poc_scene_file_records *records, uint32_t owner_id) {
+    uint32_t write_index = 0;
+    for (uint32_t i = 0; i < records->override_count; i++) {
+        if (records->overrides[i].owner_id != owner_id) {
+            records->overrides[write_index++] = records->overrides[i];
+        }
+    }
+    records->override_count = write_index;
+}
+
+void poc_scene_file_records_free(poc_scene_file_records *records) {
+    if (!records) {
+        return;
+    }
+
+    free(records->overrides);
+    free(records->objects);
+    memset(records, 0, sizeof(*records));
+}
+
+bool poc_scene_file_read_records(const char *path, poc_scene_file_records *records) {
+    if (!path || !records) {
+        return false;
+    }
+
+    memset(records, 0, sizeof(*records));
+
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        printf("Failed to open scene file '%s' for reading\n", path);
+        return false;
+    }
 
     char line[1024];
     bool header_seen = false;
     bool in_object = false;
+    bool in_override = false;
     parsed_object current;
-    parsed_object_init(&current);
-    uint32_t next_id = 1;
-    bool next_id_set = false;
+    poc_scene_file_object_init(&current);
+    poc_scene_file_override current_override;
 
     while (fgets(line, sizeof(line), file)) {
         char *trimmed = trim_whitespace(line);
@@ -226,11 +789,11 @@ poc_scene* poc_scene_load_from_file(const char *path) {
 
         if (!header_seen) {
             int version = 0;
-            if (sscanf(trimmed, "%*s v%d", &version) != 1 || strncmp(trimmed, SCENE_FILE_HEADER, strlen(SCENE_FILE_HEADER)) != 0) {
+            if (sscanf(trimmed, "%*s v%d", &version) != 1 || strncmp(trimmed, POC_SCENE_FILE_HEADER, strlen(POC_SCENE_FILE_HEADER)) != 0) {
                 printf("Invalid scene file header: %s\n", trimmed);
-                free(objects);
+                poc_scene_file_records_free(records);
                 fclose(file);
-                return NULL;
+                return false;
             }
             header_seen = true;
             continue;
@@ -238,13 +801,32 @@ poc_scene* poc_scene_load_from_file(const char *path) {
 
         if (!in_object) {
             if (strncmp(trimmed, "next_id=", 8) == 0) {
-                next_id = (uint32_t)strtoul(trimmed + 8, NULL, 10);
-                next_id_set = true;
+                records->next_id = (uint32_t)strtoul(trimmed + 8, NULL, 10);
+                continue;
+            }
+
+            if (strncmp(trimmed, "journal_id=", 11) == 0) {
+                records->journal_id = strtoull(trimmed + 11, NULL, 10);
+                continue;
+            }
+
+            if (strncmp(trimmed, "journal_offset=", 15) == 0) {
+                records->journal_offset = strtoull(trimmed + 15, NULL, 10);
                 continue;
             }
 
             if (strcmp(trimmed, "[object]") == 0) {
-                parsed_object_init(&current);
+                poc_scene_file_object_init(&current);
+                in_object = true;
+                continue;
+            }
+
+            if (strcmp(trimmed, "[override]") == 0) {
+                // Belongs to the record just read; orphans are dropped at [end]
+                const parsed_object *owner = records->count > 0 ? &records->objects[records->count - 1] : NULL;
+                current_override.owner_id = owner && owner->id_set && owner->prefab_path[0] ? owner->id : 0;
+                init_override(&current_override.override);
+                in_override = true;
                 in_object = true;
                 continue;
             }
@@ -253,106 +835,127 @@ poc_scene* poc_scene_load_from_file(const char *path) {
             continue;
         }
 
-        if (strcmp(trimmed, "[end]") == 0) {
-            if (object_count >= object_capacity) {
-                size_t new_capacity = object_capacity == 0 ? 8 : object_capacity * 2;
-                parsed_object *new_objects = realloc(objects, new_capacity * sizeof(parsed_object));
-                if (!new_objects) {
-                    free(objects);
+        if (in_override) {
+            if (strcmp(trimmed, "[end]") == 0) {
+                if (current_override.owner_id != 0 &&
+                    !poc_scene_file_records_append_override(records, &current_override)) {
+                    poc_scene_file_records_free(records);
                     fclose(file);
-                    return NULL;
+                    return false;
                 }
-                objects = new_objects;
-                object_capacity = new_capacity;
+                in_override = false;
+                in_object = false;
+                continue;
             }
 
-            objects[object_count++] = current;
-            in_object = false;
+            parse_override_field(&current_override.override, trimmed);
             continue;
         }
 
-        char *equals = strchr(trimmed, '=');
-        if (!equals) {
+        if (strcmp(trimmed, "[end]") == 0) {
+            if (!poc_scene_file_records_append(records, &current)) {
+                poc_scene_file_records_free(records);
+                fclose(file);
+                return false;
+            }
+            in_object = false;
             continue;
         }
 
-        *equals = '\0';
-        char *key = trim_whitespace(trimmed);
-        char *value = trim_whitespace(equals + 1);
-
-        if (strcmp(key, "id") == 0) {
-            current.id = (uint32_t)strtoul(value, NULL, 10);
-            current.id_set = true;
-        } else if (strcmp(key, "name") == 0) {
-            parse_quoted_string(value, current.name, sizeof(current.name));
-        } else if (strcmp(key, "position") == 0) {
-            sscanf(value, "%f %f %f", &current.position[0], &current.position[1], &current.position[2]);
-        } else if (strcmp(key, "rotation") == 0) {
-            sscanf(value, "%f %f %f", &current.rotation[0], &current.rotation[1], &current.rotation[2]);
-        } else if (strcmp(key, "scale") == 0) {
-            sscanf(value, "%f %f %f", &current.scale[0], &current.scale[1], &current.scale[2]);
-        } else if (strcmp(key, "visible") == 0) {
-            current.visible = (int)strtol(value, NULL, 10) != 0;
-        } else if (strcmp(key, "enabled") == 0) {
-            current.enabled = (int)strtol(value, NULL, 10) != 0;
-        } else if (strcmp(key, "parent") == 0) {
-            current.parent_id = (uint32_t)strtoul(value, NULL, 10);
-        } else if (strcmp(key, "mesh") == 0) {
-            parse_quoted_string(value, current.mesh_path, sizeof(current.mesh_path));
-        }
+        parse_object_field(&current, trimmed);
     }
 
     fclose(file);
 
     if (in_object) {
         printf("Scene file '%s' ended before [end]\n", path);
-        free(objects);
+        poc_scene_file_records_free(records);
+        return false;
+    }
+
+    return true;
+}
+
+static void release_mesh_requests(poc_mesh_request **requests, size_t count) {
+    if (!requests) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        poc_mesh_request_release(requests[i]);
+    }
+    free(requests);
+}
+
+poc_scene* poc_scene_load_from_file(const char *path) {
+    if (!path) {
         return NULL;
     }
 
+    poc_scene_file_records records;
+    if (!poc_scene_file_read_records(path, &records)) {
+        return NULL;
+    }
+
+    // Fold in edits saved incrementally since the base was written
+    if (!poc_scene_journal_replay(path, &records)) {
+        printf("Warning: Failed to replay journal for '%s'; loading base file only\n", path);
+    }
+
+    parsed_object *objects = records.objects;
+    size_t object_count = records.count;
+
     poc_scene *scene = poc_scene_create();
     if (!scene) {
-        free(objects);
+        poc_scene_file_records_free(&records);
         return NULL;
     }
 
     poc_scene_object **created_objects = NULL;
+    poc_mesh_request **mesh_requests = NULL;
     if (object_count > 0) {
         created_objects = calloc(object_count, sizeof(poc_scene_object*));
-        if (!created_objects) {
+        mesh_requests = calloc(object_count, sizeof(poc_mesh_request*));
+        if (!created_objects || !mesh_requests) {
+            free(created_objects);
+            free(mesh_requests);
             poc_scene_destroy(scene, true);
-            free(objects);
+            poc_scene_file_records_free(&records);
             return NULL;
         }
     }
 
+    // Start every mesh at once so the scene loads in about the time of its largest mesh
+    for (size_t i = 0; i < object_count; i++) {
+        if (objects[i].mesh_path[0] != '\0') {
+            mesh_requests[i] = poc_mesh_load_async(objects[i].mesh_path, NULL, NULL);
+        }
+    }
+
     uint32_t max_id = 0;
 
     for (size_t i = 0; i < object_count; i++) {
         parsed_object *src = &objects[i];
 
-        uint32_t object_id = src->id_set ? src->id : poc_scene_get_next_object_id(scene);
-        if (object_id > max_id) {
-            max_id = object_id;
+        if (!src->id_set) {
+            src->id = poc_scene_get_next_object_id(scene);
+        }
+        if (src->id > max_id) {
+            max_id = src->id;
         }
 
-        poc_scene_object *obj = poc_scene_object_create(src->name[0] ? src->name : "SceneObject", object_id);
+        poc_scene_object *obj = poc_scene_file_object_instantiate(src);
         if (!obj) {
             printf("Failed to create scene object while loading '%s'\n", path);
             poc_scene_destroy(scene, true);
+            release_mesh_requests(mesh_requests, object_count);
             free(created_objects);
-            free(objects);
+            poc_scene_file_records_free(&records);
             return NULL;
         }
 
-        poc_scene_object_set_transform(obj, (vec3){src->position[0], src->position[1], src->position[2]},
-                                       (vec3){src->rotation[0], src->rotation[1], src->rotation[2]},
-                                       (vec3){src->scale[0], src->scale[1], src->scale[2]});
-        obj->visible = src->visible;
-        obj->enabled = src->enabled;
-
         if (src->mesh_path[0] != '\0') {
-            poc_mesh *mesh = scene_acquire_mesh(scene, src->mesh_path);
+            // The object takes its own reference; the request's goes with it
+            poc_mesh *mesh = poc_mesh_request_wait(mesh_requests[i]);
             if (mesh) {
                 poc_scene_object_set_mesh(obj, mesh);
             } else {
@@ -364,8 +967,9 @@ poc_scene* poc_scene_load_from_file(const char *path) {
             printf("Failed to add scene object while loading '%s'\n", path);
             poc_scene_object_destroy(obj);
             poc_scene_destroy(scene, true);
+            release_mesh_requests(mesh_requests, object_count);
             free(created_objects);
-            free(objects);
+            poc_scene_file_records_free(&records);
             return NULL;
         }
 
@@ -388,17 +992,50 @@ poc_scene* poc_scene_load_from_file(const char *path) {
         }
     }
 
-    if (next_id_set) {
-        scene->next_object_id = next_id;
+    // Prefab instances take their node overrides while still collapsed
+    poc_prefab_override *overrides = NULL;
+    uint32_t *override_owners = NULL;
+    if (group_overrides(&records, &overrides, &override_owners)) {
+        for (size_t i = 0; overrides && i < object_count; i++) {
+            poc_scene_object *obj = created_objects[i];
+            if (!obj || !obj->prefab_instance) {
+                continue;
+            }
+
+            uint32_t first = 0;
+            uint32_t count = 0;
+            find_override_range(override_owners, records.override_count, obj->id, &first, &count);
+            if (count > 0) {
+                poc_prefab_instance_set_overrides(obj->prefab_instance, overrides + first, count);
+            }
+        }
+    } else {
+        printf("Warning: Failed to apply prefab overrides in '%s'\n", path);
+    }
+    free(overrides);
+    free(override_owners);
+
+    if (records.next_id != 0) {
+        scene->next_object_id = records.next_id;
     } else {
         scene->next_object_id = max_id + 1;
     }
 
+    release_mesh_requests(mesh_requests, object_count);
     free(created_objects);
-    free(objects);
+    poc_scene_file_records_free(&records);
     return scene;
 }
 
+// New collapsed instance of the same prefab carrying the source's overrides
+static poc_prefab_instance *clone_prefab_instance(poc_prefab_instance *source) {
+    poc_prefab_instance *instance = poc_prefab_instance_create(source->prefab);
+    if (instance && poc_prefab_instance_sync_overrides(source)) {
+        poc_prefab_instance_set_overrides(instance, source->overrides, source->override_count);
+    }
+    return instance;
+}
+
 poc_scene* poc_scene_clone(const poc_scene *scene) {
     if (!scene) {
         return NULL;
@@ -423,17 +1060,22 @@ poc_scene* poc_scene_clone(const poc_scene *scene) {
 
     for (uint32_t i = 0; i < scene->object_count; i++) {
         poc_scene_object *src = scene->objects[i];
-        if (!src) {
+        if (!src || src->prefab_root) {
             continue;
         }
 
-        poc_scene_object *dst = poc_scene_object_create(src->name, src->id);
+        poc_scene_object *dst = poc_scene_object_create(poc_string_get(src->name), src->id);
         if (!dst) {
             poc_scene_destroy(clone, true);
             free(created);
             return NULL;
         }
 
+        // Prefab nodes are not copied; the cloned instance expands its own
+        if (src->prefab_instance) {
+            dst->prefab_instance = clone_prefab_instance(src->prefab_instance);
+        }
+
         poc_scene_object_set_transform(dst, src->position, src->rotation, src->scale);
         dst->visible = src->visible;
         dst->enabled = src->enabled;
@@ -505,7 +1147,8 @@ bool poc_scene_copy_from(poc_scene *dest, const poc_scene *source) {
             poc_scene_object *obj = dest->objects[i];
             entries[i].object = obj;
             entries[i].id = obj ? obj->id : 0;
-            entries[i].processed = false;
+            // Expanded prefab nodes live and die with their instance root
+            entries[i].processed = obj && obj->prefab_root;
         }
     }
 
@@ -524,15 +1167,20 @@ bool poc_scene_copy_from(poc_scene *dest, const poc_scene *source) {
 
     for (uint32_t i = 0; i < source->object_count && success; i++) {
         poc_scene_object *src_obj = source->objects[i];
-        if (!src_obj) {
+        if (!src_obj || src_obj->prefab_root) {
             continue;
         }
 
         poc_scene_object *dst_obj = NULL;
         uint32_t entry_index = UINT32_MAX;
+        const poc_prefab *src_prefab = src_obj->prefab_instance ? src_obj->prefab_instance->prefab : NULL;
 
         for (uint32_t entry = 0; entry < original_count; entry++) {
-            if (entries && entries[entry].id == src_obj->id && entries[entry].object) {
+            const poc_scene_object *candidate = entries ? entries[entry].object : NULL;
+            const poc_prefab *candidate_prefab = candidate && candidate->prefab_instance ?
+                                                 candidate->prefab_instance->prefab : NULL;
+            if (candidate && !entries[entry].processed && entries[entry].id == src_obj->id &&
+                candidate_prefab == src_prefab) {
                 dst_obj = entries[entry].object;
                 entries[entry].processed = true;
                 entry_index = entry;
@@ -541,11 +1189,14 @@ bool poc_scene_copy_from(poc_scene *dest, const poc_scene *source) {
         }
 
         if (!dst_obj) {
-            dst_obj = poc_scene_object_create(src_obj->name, src_obj->id);
+            dst_obj = poc_scene_object_create(poc_string_get(src_obj->name), src_obj->id);
             if (!dst_obj) {
                 success = false;
                 break;
             }
+            if (src_obj->prefab_instance) {
+                dst_obj->prefab_instance = clone_prefab_instance(src_obj->prefab_instance);
+            }
 
             if (!poc_scene_add_object(dest, dst_obj)) {
                 poc_scene_object_destroy(dst_obj);
@@ -553,8 +1204,12 @@ bool poc_scene_copy_from(poc_scene *dest, const poc_scene *source) {
                 break;
             }
         } else {
-            strncpy(dst_obj->name, src_obj->name, sizeof(dst_obj->name) - 1);
-            dst_obj->name[sizeof(dst_obj->name) - 1] = '\0';
+            dst_obj->name = src_obj->name;
+
+            if (src_obj->prefab_instance && poc_prefab_instance_sync_overrides(src_obj->prefab_instance)) {
+                poc_prefab_instance_set_overrides(dst_obj->prefab_instance, src_obj->prefab_instance->overrides,
+                                                  src_obj->prefab_instance->override_count);
+            }
         }
 
         poc_scene_object_set_transform(dst_obj, src_obj->position, src_obj->rotation, src_obj->scale);
@@ -598,13 +1253,24 @@ bool poc_scene_copy_from(poc_scene *dest, const poc_scene *source) {
                 continue;
             }
 
-            if (obj->children) {
+            // Links inside a prefab instance are owned by the instance
+            uint32_t kept = 0;
+            for (uint32_t c = 0; c < obj->child_count; c++) {
+                poc_scene_object *child = obj->children[c];
+                if (child && child->prefab_root &&
+                    (child->prefab_root == obj || child->prefab_root == obj->prefab_root)) {
+                    obj->children[kept++] = child;
+                }
+            }
+            obj->child_count = kept;
+            if (kept == 0) {
                 free(obj->children);
+                obj->children = NULL;
+                obj->child_capacity = 0;
+            }
+            if (!obj->prefab_root) {
+                obj->parent = NULL;
             }
-            obj->children = NULL;
-            obj->child_count = 0;
-            obj->child_capacity = 0;
-            obj->parent = NULL;
         }
 
         for (uint32_t i = 0; i < binding_count; i++) {
@@ -629,44 +1295,5 @@ bool poc_scene_copy_from(poc_scene *dest, const poc_scene *source) {
 
     dest->next_object_id = source->next_object_id;
 
-    if (!success) {
-        return false;
-    }
-
-    if (dest->mesh_assets) {
-        for (uint32_t i = 0; i < dest->mesh_asset_count; i++) {
-            poc_scene_mesh_entry *entry = &dest->mesh_assets[i];
-            if (entry->owned && entry->mesh) {
-                poc_mesh_destroy(entry->mesh);
-            }
-        }
-        free(dest->mesh_assets);
-        dest->mesh_assets = NULL;
-        dest->mesh_asset_capacity = 0;
-        dest->mesh_asset_count = 0;
-    }
-
-    if (source->mesh_asset_count > 0) {
-        dest->mesh_assets = malloc(sizeof(poc_scene_mesh_entry) * source->mesh_asset_count);
-        if (!dest->mesh_assets) {
-            dest->mesh_asset_capacity = 0;
-            dest->mesh_asset_count = 0;
-            return false;
-        }
-
-        memcpy(dest->mesh_assets, source->mesh_assets,
-               sizeof(poc_scene_mesh_entry) * source->mesh_asset_count);
-        dest->mesh_asset_count = source->mesh_asset_count;
-        dest->mesh_asset_capacity = source->mesh_asset_count;
-        for (uint32_t i = 0; i < dest->mesh_asset_count; i++) {
-            dest->mesh_assets[i].owned = true;
-            source->mesh_assets[i].owned = false;
-        }
-    } else {
-        dest->mesh_assets = NULL;
-        dest->mesh_asset_capacity = 0;
-        dest->mesh_asset_count = 0;
-    }
-
-    return true;
+    return success;
 }
@@ -0,0 +1,498 @@
+#include "scene.h"
+#include "prefab.h"
+#include "../include/poc_engine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Access to global context for renderable sharing
+extern poc_context *g_active_context;
+
+#define SNAPSHOT_NO_PARENT UINT32_MAX
+
+struct poc_scene_snapshot {
+    uint32_t object_count;
+    uint32_t next_object_id;
+
+    // Captured objects, used only to match live objects on restore
+    poc_scene_object **objects;
+    uint32_t *ids;
+    uint32_t *parent_indices;   // Index into these arrays, or SNAPSHOT_NO_PARENT
+
+    // Per-object state
+    poc_string_id *names;
+    vec3 *positions;
+    vec3 *rotations;
+    vec3 *scales;
+    poc_mesh **meshes;
+    poc_material **materials;
+    bool *visible;
+    bool *enabled;
+
+    // Prefabs: collapsed copies of instance roots, and for expanded nodes the
+    // index of their root entry and their template node
+    poc_prefab_instance **instances;
+    uint32_t *prefab_roots;     // SNAPSHOT_NO_PARENT for objects that are not prefab nodes
+    uint32_t *prefab_nodes;
+};
+
+typedef struct {
+    poc_scene_object *object;
+    uint32_t index;
+} object_slot;
+
+static int compare_object_slot(const void *a, const void *b) {
+    uintptr_t pa = (uintptr_t)((const object_slot *)a)->object;
+    uintptr_t pb = (uintptr_t)((const object_slot *)b)->object;
+    return (pa > pb) - (pa < pb);
+}
+
+static object_slot *find_object_slot(object_slot *slots, uint32_t count, const poc_scene_object *object) {
+    object_slot key = { .object = (poc_scene_object *)object };
+    return bsearch(&key, slots, count, sizeof(object_slot), compare_object_slot);
+}
+
+// Sorted pointer -> index table for the scene's objects (NULL entries skipped)
+static object_slot *build_object_slots(poc_scene_object **objects, uint32_t count, uint32_t *out_count) {
+    *out_count = 0;
+    if (count == 0) {
+        return NULL;
+    }
+
+    object_slot *slots = malloc(sizeof(object_slot) * count);
+    if (!slots) {
+        return NULL;
+    }
+
+    uint32_t slot_count = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (objects[i]) {
+            slots[slot_count] = (object_slot){ .object = objects[i], .index = slot_count };
+            slot_count++;
+        }
+    }
+
+    qsort(slots, slot_count, sizeof(object_slot), compare_object_slot);
+    *out_count = slot_count;
+    return slots;
+}
+
+static int compare_object_id(const void *a, const void *b) {
+    uint32_t ia = (*(poc_scene_object *const *)a)->id;
+    uint32_t ib = (*(poc_scene_object *const *)b)->id;
+    return (ia > ib) - (ia < ib);
+}
+
+static poc_scene_object **find_object_by_id(poc_scene_object **objects, uint32_t count, uint32_t id) {
+    poc_scene_object key = { .id = id };
+    poc_scene_object *key_ptr = &key;
+    return bsearch(&key_ptr, objects, count, sizeof(poc_scene_object *), compare_object_id);
+}
+
+static bool allocate_snapshot_arrays(poc_scene_snapshot *snapshot, uint32_t count) {
+    snapshot->objects = malloc(sizeof(poc_scene_object *) * count);
+    snapshot->ids = malloc(sizeof(uint32_t) * count);
+    snapshot->parent_indices = malloc(sizeof(uint32_t) * count);
+    snapshot->names = malloc(sizeof(*snapshot->names) * count);
+    snapshot->positions = malloc(sizeof(vec3) * count);
+    snapshot->rotations = malloc(sizeof(vec3) * count);
+    snapshot->scales = malloc(sizeof(vec3) * count);
+    snapshot->meshes = malloc(sizeof(poc_mesh *) * count);
+    snapshot->materials = malloc(sizeof(poc_material *) * count);
+    snapshot->visible = malloc(sizeof(bool) * count);
+    snapshot->enabled = malloc(sizeof(bool) * count);
+    snapshot->instances = calloc(count, sizeof(poc_prefab_instance *));
+    snapshot->prefab_roots = malloc(sizeof(uint32_t) * count);
+    snapshot->prefab_nodes = malloc(sizeof(uint32_t) * count);
+
+    return snapshot->objects && snapshot->ids && snapshot->parent_indices && snapshot->names &&
+           snapshot->positions && snapshot->rotations && snapshot->scales && snapshot->meshes &&
+           snapshot->materials && snapshot->visible && snapshot->enabled && snapshot->instances &&
+           snapshot->prefab_roots && snapshot->prefab_nodes;
+}
+
+void poc_scene_snapshot_destroy(poc_scene_snapshot *snapshot) {
+    if (!snapshot) {
+        return;
+    }
+
+    free(snapshot->objects);
+    free(snapshot->ids);
+    free(snapshot->parent_indices);
+    free(snapshot->names);
+    free(snapshot->positions);
+    free(snapshot->rotations);
+    free(snapshot->scales);
+    for (uint32_t i = 0; snapshot->meshes && i < snapshot->object_count; i++) {
+        poc_asset_release_mesh(snapshot->meshes[i]);
+    }
+    free(snapshot->meshes);
+    free(snapshot->materials);
+    free(snapshot->visible);
+    free(snapshot->enabled);
+    for (uint32_t i = 0; snapshot->instances && i < snapshot->object_count; i++) {
+        poc_prefab_instance_destroy(snapshot->instances[i]);
+    }
+    free(snapshot->instances);
+    free(snapshot->prefab_roots);
+    free(snapshot->prefab_nodes);
+    free(snapshot);
+}
+
+poc_scene_snapshot *poc_scene_snapshot_capture(const poc_scene *scene) {
+    if (!scene) {
+        return NULL;
+    }
+
+    poc_scene_snapshot *snapshot = calloc(1, sizeof(poc_scene_snapshot));
+    if (!snapshot) {
+        return NULL;
+    }
+
+    snapshot->next_object_id = scene->next_object_id;
+    if (scene->object_count == 0) {
+        return snapshot;
+    }
+
+    uint32_t slot_count = 0;
+    object_slot *slots = build_object_slots(scene->objects, scene->object_count, &slot_count);
+    if (!slots || !allocate_snapshot_arrays(snapshot, slot_count)) {
+        free(slots);
+        poc_scene_snapshot_destroy(snapshot);
+        return NULL;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < scene->object_count; i++) {
+        poc_scene_object *object = scene->objects[i];
+        if (!object) {
+            continue;
+        }
+
+        snapshot->objects[count] = object;
+        snapshot->ids[count] = object->id;
+        snapshot->names[count] = object->name;
+        glm_vec3_copy(object->position, snapshot->positions[count]);
+        glm_vec3_copy(object->rotation, snapshot->rotations[count]);
+        glm_vec3_copy(object->scale, snapshot->scales[count]);
+        // Held so the mesh survives a purge while only the snapshot uses it
+        snapshot->meshes[count] = object->mesh;
+        poc_asset_retain_mesh(object->mesh);
+        snapshot->materials[count] = object->material;
+        snapshot->visible[count] = object->visible;
+        snapshot->enabled[count] = object->enabled;
+
+        // Parents outside the scene are not part of the snapshot
+        object_slot *parent = object->parent ? find_object_slot(slots, slot_count, object->parent) : NULL;
+        snapshot->parent_indices[count] = parent ? parent->index : SNAPSHOT_NO_PARENT;
+
+        snapshot->prefab_roots[count] = SNAPSHOT_NO_PARENT;
+        snapshot->prefab_nodes[count] = 0;
+        if (object->prefab_instance) {
+            snapshot->instances[count] = poc_prefab_instance_create(object->prefab_instance->prefab);
+            if (snapshot->instances[count] && poc_prefab_instance_sync_overrides(object->prefab_instance)) {
+                poc_prefab_instance_set_overrides(snapshot->instances[count], object->prefab_instance->overrides,
+                                                  object->prefab_instance->override_count);
+            }
+        }
+        object_slot *root = object->prefab_root ? find_object_slot(slots, slot_count, object->prefab_root) : NULL;
+        const poc_prefab_instance *instance = root ? object->prefab_root->prefab_instance : NULL;
+        for (uint32_t node = 0; instance && instance->nodes && node < instance->prefab->node_count; node++) {
+            if (instance->nodes[node] == object) {
+                snapshot->prefab_roots[count] = root->index;
+                snapshot->prefab_nodes[count] = node;
+                break;
+            }
+        }
+        count++;
+    }
+    snapshot->object_count = count;
+
+    free(slots);
+    return snapshot;
+}
+
+// Attach a mesh, sharing the GPU buffers of an object already rendering it
+static void attach_shared_mesh(poc_scene_object *object, poc_mesh *mesh, const poc_scene_object *source) {
+    if (mesh && source && source->mesh == mesh && source->renderable && g_active_context) {
+        object->renderable = poc_context_clone_renderable(g_active_context, source->renderable, poc_string_get(object->name));
+        if (object->renderable) {
+            object->mesh = mesh;
+            poc_asset_retain_mesh(mesh);
+            poc_scene_object_mark_dirty(object);
+            return;
+        }
+    }
+
+    poc_scene_object_set_mesh(object, mesh);
+}
+
+static poc_scene_object *create_snapshot_object(const poc_scene_snapshot *snapshot, uint32_t index,
+                                                const poc_scene_object *source) {
+    poc_scene_object *object = poc_scene_object_create(poc_string_get(snapshot->names[index]), snapshot->ids[index]);
+    if (!object) {
+        return NULL;
+    }
+
+    glm_vec3_copy(snapshot->positions[index], object->position);
+    glm_vec3_copy(snapshot->rotations[index], object->rotation);
+    glm_vec3_copy(snapshot->scales[index], object->scale);
+    object->visible = snapshot->visible[index];
+    object->enabled = snapshot->enabled[index];
+    object->material = snapshot->materials[index];
+
+    const poc_prefab_instance *instance = snapshot->instances[index];
+    if (instance) {
+        object->prefab_instance = poc_prefab_instance_create(instance->prefab);
+        if (object->prefab_instance) {
+            poc_prefab_instance_set_overrides(object->prefab_instance, instance->overrides, instance->override_count);
+        }
+    }
+
+    if (snapshot->meshes[index]) {
+        attach_shared_mesh(object, snapshot->meshes[index], source);
+    } else {
+        poc_scene_object_mark_dirty(object);
+    }
+
+    return object;
+}
+
+poc_scene *poc_scene_snapshot_instantiate(const poc_scene_snapshot *snapshot) {
+    if (!snapshot) {
+        return NULL;
+    }
+
+    poc_scene *scene = poc_scene_create();
+    if (!scene) {
+        return NULL;
+    }
+    scene->next_object_id = snapshot->next_object_id;
+
+    if (snapshot->object_count == 0) {
+        return scene;
+    }
+
+    poc_scene_object **created = malloc(sizeof(poc_scene_object *) * snapshot->object_count);
+    if (!created) {
+        poc_scene_destroy(scene, true);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < snapshot->object_count; i++) {
+        // Prefab nodes come from their root's expansion below
+        if (snapshot->prefab_roots[i] != SNAPSHOT_NO_PARENT) {
+            created[i] = NULL;
+            continue;
+        }
+
+        created[i] = create_snapshot_object(snapshot, i, snapshot->objects[i]);
+        if (!created[i] || !poc_scene_add_object(scene, created[i])) {
+            poc_scene_object_destroy(created[i]);
+            poc_scene_destroy(scene, true);
+            free(created);
+            return NULL;
+        }
+    }
+
+    // Expand instances right away so their nodes share the captured GPU buffers
+    for (uint32_t i = 0; i < snapshot->object_count; i++) {
+        if (created[i] && created[i]->prefab_instance) {
+            poc_prefab_instance_expand(created[i], snapshot->objects[i]);
+        }
+    }
+    for (uint32_t i = 0; i < snapshot->object_count; i++) {
+        uint32_t root = snapshot->prefab_roots[i];
+        const poc_prefab_instance *instance = root != SNAPSHOT_NO_PARENT && created[root] ?
+                                              created[root]->prefab_instance : NULL;
+        if (instance && instance->nodes && instance->nodes[snapshot->prefab_nodes[i]]) {
+            created[i] = instance->nodes[snapshot->prefab_nodes[i]];
+            created[i]->id = snapshot->ids[i];
+        }
+    }
+
+    for (uint32_t i = 0; i < snapshot->object_count; i++) {
+        uint32_t parent = snapshot->parent_indices[i];
+        if (parent != SNAPSHOT_NO_PARENT && snapshot->prefab_roots[i] == SNAPSHOT_NO_PARENT &&
+            created[parent] && created[i]) {
+            poc_scene_object_add_child(created[parent], created[i]);
+        }
+    }
+
+    free(created);
+    return scene;
+}
+
+// Write captured state back into a live object; returns whether anything changed
+static bool restore_object(poc_scene_object *object, const poc_scene_snapshot *snapshot, uint32_t index) {
+    bool changed = memcmp(object->position, snapshot->positions[index], sizeof(vec3)) != 0 ||
+                   memcmp(object->rotation, snapshot->rotations[index], sizeof(vec3)) != 0 ||
+                   memcmp(object->scale, snapshot->scales[index], sizeof(vec3)) != 0 ||
+                   object->visible != snapshot->visible[index] ||
+                   object->enabled != snapshot->enabled[index];
+
+    object->name = snapshot->names[index];
+    glm_vec3_copy(snapshot->positions[index], object->position);
+    glm_vec3_copy(snapshot->rotations[index], object->rotation);
+    glm_vec3_copy(snapshot->scales[index], object->scale);
+    object->visible = snapshot->visible[index];
+    object->enabled = snapshot->enabled[index];
+    object->material = snapshot->materials[index];
+
+    if (object->mesh != snapshot->meshes[index]) {
+        poc_scene_object_set_mesh(object, snapshot->meshes[index]);
+        return true;
+    }
+
+    return changed;
+}
+
+bool poc_scene_snapshot_restore(poc_scene *scene, const poc_scene_snapshot *snapshot) {
+    if (!scene || !snapshot) {
+        return false;
+    }
+
+    const uint32_t count = snapshot->object_count;
+    uint32_t live_count = 0;
+    object_slot *live = build_object_slots(scene->objects, scene->object_count, &live_count);
+    poc_scene_object **resolved = count > 0 ? calloc(count, sizeof(poc_scene_object *)) : NULL;
+    poc_scene_object **stale = live_count > 0 ? malloc(sizeof(poc_scene_object *) * live_count) : NULL;
+    poc_scene_object **extra_nodes = live_count > 0 ? malloc(sizeof(poc_scene_object *) * live_count) : NULL;
+    if ((scene->object_count > 0 && !live) || (count > 0 && !resolved) ||
+        (live_count > 0 && (!stale || !extra_nodes))) {
+        free(live);
+        free(resolved);
+        free(stale);
+        free(extra_nodes);
+        return false;
+    }
+
+    // Match captured objects to live ones by pointer and id; a matched slot is
+    // claimed by clearing its object so duplicates cannot match twice
+    for (uint32_t i = 0; i < count; i++) {
+        object_slot *slot = find_object_slot(live, live_count, snapshot->objects[i]);
+        if (slot && slot->index != UINT32_MAX && slot->object->id == snapshot->ids[i]) {
+            resolved[i] = slot->object;
+            slot->index = UINT32_MAX;
+        }
+    }
+
+    // Unclaimed live objects are stale unless they carry the id of a captured
+    // object that was destroyed and recreated since the capture. Prefab nodes
+    // are never stale themselves: they stay or go with their instance root.
+    uint32_t stale_count = 0;
+    uint32_t extra_count = 0;
+    for (uint32_t i = 0; i < live_count; i++) {
+        if (live[i].index == UINT32_MAX) {
+            continue;
+        }
+        if (live[i].object->prefab_root) {
+            extra_nodes[extra_count++] = live[i].object;
+        } else {
+            stale[stale_count++] = live[i].object;
+        }
+    }
+    if (stale_count > 0) {
+        qsort(stale, stale_count, sizeof(poc_scene_object *), compare_object_id);
+        for (uint32_t i = 0; i < count; i++) {
+            if (resolved[i]) {
+                continue;
+            }
+
+            poc_scene_object **match = find_object_by_id(stale, stale_count, snapshot->ids[i]);
+            if (match) {
+                resolved[i] = *match;
+                memmove(match, match + 1, sizeof(poc_scene_object *) * (size_t)(stale + stale_count - match - 1));
+                stale_count--;
+            }
+        }
+    }
+    poc_scene_remove_objects(scene, stale, stale_count);
+
+    // Nodes of removed roots left the scene with them
+    uint32_t kept_extras = 0;
+    for (uint32_t i = 0; i < extra_count; i++) {
+        if (extra_nodes[i]->scene == scene) {
+            extra_nodes[kept_extras++] = extra_nodes[i];
+        }
+    }
+    extra_count = kept_extras;
+
+    for (uint32_t i = 0; i < stale_count; i++) {
+        poc_scene_object_destroy(stale[i]);
+    }
+    free(stale);
+    free(live);
+
+    bool success = true;
+    uint32_t restored = 0;
+    uint32_t recreated = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (resolved[i]) {
+            if (restore_object(resolved[i], snapshot, i)) {
+                poc_scene_object_mark_dirty(resolved[i]);
+            }
+            restored++;
+            continue;
+        }
+
+        // A missing node is recreated by its root's expansion, not on its own
+        if (snapshot->prefab_roots[i] != SNAPSHOT_NO_PARENT) {
+            continue;
+        }
+
+        // Destroyed since the capture: rebuild it (this path uploads its mesh)
+        poc_scene_object *object = create_snapshot_object(snapshot, i, NULL);
+        if (!object || !poc_scene_add_object(scene, object)) {
+            poc_scene_object_destroy(object);
+            success = false;
+            continue;
+        }
+        resolved[i] = object;
+        recreated++;
+    }
+
+    // Rebuild the hierarchy, touching only links that differ
+    for (uint32_t i = 0; i < count; i++) {
+        poc_scene_object *object = resolved[i];
+        if (!object || snapshot->prefab_roots[i] != SNAPSHOT_NO_PARENT) {
+            continue;
+        }
+
+        uint32_t parent_index = snapshot->parent_indices[i];
+        poc_scene_object *parent = parent_index != SNAPSHOT_NO_PARENT ? resolved[parent_index] : NULL;
+        if (object->parent == parent) {
+            continue;
+        }
+
+        if (parent) {
+            poc_scene_object_add_child(parent, object);
+        } else {
+            poc_scene_object_remove_child(object->parent, object);
+        }
+    }
+
+    // Restore the captured object order; the scene holds exactly these objects
+    // plus any prefab nodes expanded after the capture
+    uint32_t ordered = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (resolved[i]) {
+            scene->objects[ordered++] = resolved[i];
+        }
+    }
+    for (uint32_t i = 0; i < extra_count; i++) {
+        scene->objects[ordered++] = extra_nodes[i];
+    }
+    scene->object_count = ordered;
+    scene->next_object_id = snapshot->next_object_id;
+
+    if (stale_count > 0 || recreated > 0) {
+        printf("✓ Restored scene snapshot: %u restored, %u recreated, %u removed\n",
+               restored, recreated, stale_count);
+    }
+
+    free(resolved);
+    free(extra_nodes);
+    return success;
+}
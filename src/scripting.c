@@ -1,20 +1,87 @@
+#define _POSIX_C_SOURCE 199309L
 #include "scripting.h"
+#include "file_watch.h"
+#include "asset_archive.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
 #include <errno.h>
+#include <time.h>
+#include <stdatomic.h>
 
 // Forward declaration for Lua bindings
 extern void poc_scripting_register_bindings(lua_State *L);
 extern void poc_math_register_bindings(lua_State *L);
 
+// A script file run by poc_scripting_load_file(), watched for changes
+typedef struct {
+    char path[1024];
+    _Atomic uint64_t changed_ns;    // When a change was seen, 0 if none is pending
+} script_file;
+
 struct poc_scripting {
     lua_State *L;
     poc_script_config config;
     char last_error[1024];
+    script_file **files;
+    uint32_t file_count;
 };
 
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Runs on the watcher thread; the script is run again by poc_scripting_dispatch_reloads()
+static void script_file_changed(const char *path, void *user_data) {
+    (void)path;
+    script_file *file = user_data;
+    atomic_store_explicit(&file->changed_ns, now_ns(), memory_order_release);
+}
+
+// Run a script from the asset archive if it holds one, from disk otherwise.
+// Like luaL_dofile(), results stay on the stack and errors are left on top.
+static int run_file(lua_State *L, const char *path) {
+    const char *data;
+    size_t size;
+    if (!poc_archive_find(path, &data, &size)) {
+        return luaL_dofile(L, path);
+    }
+
+    char chunk_name[1100];
+    snprintf(chunk_name, sizeof(chunk_name), "@%s", path);
+    int result = luaL_loadbuffer(L, data ? data : "", size, chunk_name);
+    return result != LUA_OK ? result : lua_pcall(L, 0, LUA_MULTRET, 0);
+}
+
+static void watch_script(poc_scripting *scripting, const char *full_path) {
+    for (uint32_t i = 0; i < scripting->file_count; i++) {
+        if (strcmp(scripting->files[i]->path, full_path) == 0) {
+            return;
+        }
+    }
+
+    script_file **files = realloc(scripting->files, (scripting->file_count + 1) * sizeof(script_file *));
+    if (!files) {
+        return;
+    }
+    scripting->files = files;
+
+    script_file *file = calloc(1, sizeof(script_file));
+    if (!file) {
+        return;
+    }
+    snprintf(file->path, sizeof(file->path), "%s", full_path);
+    atomic_init(&file->changed_ns, 0);
+    if (!poc_file_watch_add(file->path, script_file_changed, file)) {
+        free(file);
+        return;
+    }
+    scripting->files[scripting->file_count++] = file;
+}
+
 poc_scripting *poc_scripting_init(const poc_script_config *config) {
     if (!config) {
         printf("poc_scripting_init: config cannot be NULL\n");
@@ -48,6 +115,8 @@ poc_scripting *poc_scripting_init(const poc_script_config *config) {
 
     // Clear error message
     scripting->last_error[0] = '\0';
+    scripting->files = NULL;
+    scripting->file_count = 0;
 
     // Register POC Engine API bindings
     poc_scripting_register_bindings(scripting->L);
@@ -55,7 +124,7 @@ poc_scripting *poc_scripting_init(const poc_script_config *config) {
 
     // If Teal checking is enabled, load the Teal compiler
     if (config->enable_teal_checking) {
-        int result = luaL_dofile(scripting->L, "deps/teal/tl.lua");
+        int result = run_file(scripting->L, "deps/teal/tl.lua");
         if (result != LUA_OK) {
             snprintf(scripting->last_error, sizeof(scripting->last_error),
                     "Failed to load Teal compiler: %s", lua_tostring(scripting->L, -1));
@@ -76,6 +145,15 @@ void poc_scripting_shutdown(poc_scripting *scripting) {
         return;
     }
 
+    for (uint32_t i = 0; i < scripting->file_count; i++) {
+        poc_file_watch_remove(scripting->files[i]->path, script_file_changed, scripting->files[i]);
+    }
+    poc_file_watch_flush();
+    for (uint32_t i = 0; i < scripting->file_count; i++) {
+        free(scripting->files[i]);
+    }
+    free(scripting->files);
+
     if (scripting->L) {
         lua_close(scripting->L);
     }
@@ -98,17 +176,22 @@ poc_script_result poc_scripting_load_file(poc_scripting *scripting, const char *
         full_path[sizeof(full_path) - 1] = '\0';
     }
 
-    // Check if file exists
-    FILE *file = fopen(full_path, "r");
-    if (!file) {
-        snprintf(scripting->last_error, sizeof(scripting->last_error),
-                "Script file not found: %.500s (%.100s)", full_path, strerror(errno));
-        return POC_SCRIPT_ERROR_FILE_NOT_FOUND;
+    // Check if file exists; archived scripts are a snapshot and never change
+    if (!poc_archive_find(full_path, NULL, NULL)) {
+        FILE *file = fopen(full_path, "r");
+        if (!file) {
+            snprintf(scripting->last_error, sizeof(scripting->last_error),
+                    "Script file not found: %.500s (%.100s)", full_path, strerror(errno));
+            return POC_SCRIPT_ERROR_FILE_NOT_FOUND;
+        }
+        fclose(file);
+
+        // Run it again whenever it is saved, also if this first run fails
+        watch_script(scripting, full_path);
     }
-    fclose(file);
 
     // Load and execute the file
-    int result = luaL_dofile(scripting->L, full_path);
+    int result = run_file(scripting->L, full_path);
     if (result != LUA_OK) {
         snprintf(scripting->last_error, sizeof(scripting->last_error),
                 "Lua error: %s", lua_tostring(scripting->L, -1));
@@ -126,6 +209,35 @@ poc_script_result poc_scripting_load_file(poc_scripting *scripting, const char *
     return POC_SCRIPT_SUCCESS;
 }
 
+uint32_t poc_scripting_dispatch_reloads(poc_scripting *scripting) {
+    if (!scripting) {
+        return 0;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < scripting->file_count; i++) {
+        script_file *file = scripting->files[i];
+        uint64_t changed = atomic_exchange_explicit(&file->changed_ns, 0, memory_order_acquire);
+        if (changed == 0) {
+            continue;
+        }
+
+        // Re-running the chunk replaces the functions it defines; state it
+        // keeps in globals is the script's to preserve
+        if (run_file(scripting->L, file->path) != LUA_OK) {
+            snprintf(scripting->last_error, sizeof(scripting->last_error),
+                    "Lua error: %s", lua_tostring(scripting->L, -1));
+            lua_pop(scripting->L, 1);
+            printf("⚠ Could not reload script %s: %s\n", file->path, scripting->last_error);
+            continue;
+        }
+        printf("✓ Reloaded script %s %.1f ms after the change\n",
+               file->path, (double)(now_ns() - changed) / 1e6);
+        count++;
+    }
+    return count;
+}
+
 poc_script_result poc_scripting_execute_string(poc_scripting *scripting,
                                                const char *script_code,
                                                const char *script_name) {
@@ -85,6 +85,19 @@ void poc_scripting_shutdown(poc_scripting *scripting);
  */
 poc_script_result poc_scripting_load_file(poc_scripting *scripting, const char *filename);
 
+/**
+ * @brief Run scripts again that changed on disk since they were loaded
+ *
+ * Every file run through poc_scripting_load_file() is registered with the
+ * file watcher (see file_watch.h). Call once per frame from the thread that
+ * owns the Lua state; a script that fails to run keeps its previous
+ * definitions.
+ *
+ * @param scripting The scripting system. Can be NULL (no-op).
+ * @return Number of scripts reloaded
+ */
+uint32_t poc_scripting_dispatch_reloads(poc_scripting *scripting);
+
 /**
  * @brief Execute a Lua script from a string
  *
@@ -0,0 +1,625 @@
+#include "spatial_hash.h"
+#include "scene.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#define SPATIAL_NONE UINT32_MAX
+
+// Levels of the hierarchy; cells double in size from one level to the next
+#define SPATIAL_LEVELS 16
+
+// Proxy bucket value for boxes too big even for the top level
+#define SPATIAL_HUGE UINT32_MAX
+
+// Smallest bucket table
+#define SPATIAL_MIN_BUCKETS 64
+
+// Cell coordinates are clamped to this so they stay far from int overflow
+#define SPATIAL_CELL_LIMIT (1 << 29)
+
+typedef struct {
+    poc_scene_object *object;   // NULL for free slots
+    float min[3];
+    float max[3];
+    int32_t cell[3];
+    uint32_t level;
+    uint32_t bucket;            // Bucket of the cell, or SPATIAL_HUGE
+    uint32_t prev;              // Neighbors in the bucket (or huge) list
+    uint32_t next;
+} spatial_proxy;
+
+typedef struct {
+    uint32_t count;             // Proxies on this level
+    // Cells that may hold objects; only grows between rebuilds, which is
+    // enough to bound query ranges
+    int32_t cell_min[3];
+    int32_t cell_max[3];
+} spatial_level;
+
+struct poc_spatial_hash {
+    poc_scene *scene;
+    float cell_size;            // Level 0 cell size
+    spatial_level levels[SPATIAL_LEVELS];
+
+    uint32_t *buckets;          // First proxy of each bucket, SPATIAL_NONE if empty
+    uint32_t bucket_count;      // Power of two
+    uint32_t huge_head;         // Boxes bigger than a top-level cell
+
+    spatial_proxy *proxies;
+    uint32_t proxy_count;
+    uint32_t proxy_capacity;
+    uint32_t live_count;
+    uint32_t *free_proxies;
+    uint32_t free_count;
+    uint32_t free_capacity;
+};
+
+// Grow a buffer geometrically; capacities start at 16
+static bool reserve(void **buffer, uint32_t *capacity, uint32_t needed, size_t element_size) {
+    if (needed <= *capacity) {
+        return true;
+    }
+
+    uint32_t new_capacity = *capacity == 0 ? 16 : *capacity;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    void *new_buffer = realloc(*buffer, element_size * new_capacity);
+    if (!new_buffer) {
+        return false;
+    }
+    *buffer = new_buffer;
+    *capacity = new_capacity;
+    return true;
+}
+
+// World AABB, or the world position as a point for objects without bounds
+static void object_bounds(const poc_scene_object *object, float min[3], float max[3]) {
+    bool valid = object->world_aabb_min[0] <= object->world_aabb_max[0] &&
+                 object->world_aabb_min[1] <= object->world_aabb_max[1] &&
+                 object->world_aabb_min[2] <= object->world_aabb_max[2];
+    for (int axis = 0; axis < 3; axis++) {
+        min[axis] = valid ? object->world_aabb_min[axis] : object->transform_matrix[3][axis];
+        max[axis] = valid ? object->world_aabb_max[axis] : object->transform_matrix[3][axis];
+    }
+}
+
+static float level_cell_size(const poc_spatial_hash *hash, uint32_t level) {
+    return ldexpf(hash->cell_size, (int)level);
+}
+
+static int32_t cell_coordinate(float value, float cell_size) {
+    float cell = floorf(value / cell_size);
+    if (!(cell > -SPATIAL_CELL_LIMIT)) {
+        return -SPATIAL_CELL_LIMIT;
+    }
+    return cell < SPATIAL_CELL_LIMIT ? (int32_t)cell : SPATIAL_CELL_LIMIT;
+}
+
+static uint32_t cell_bucket(const poc_spatial_hash *hash, uint32_t level, int32_t x, int32_t y, int32_t z) {
+    uint32_t h = (uint32_t)x * 73856093u ^ (uint32_t)y * 19349663u ^ (uint32_t)z * 83492791u ^ level * 2654435761u;
+    return (h ^ (h >> 16)) & (hash->bucket_count - 1);
+}
+
+// Smallest level whose cells are at least as big as the box, so the box
+// reaches at most half a cell past the cell holding its center
+static uint32_t proxy_level(const poc_spatial_hash *hash, const spatial_proxy *proxy) {
+    float extent = fmaxf(proxy->max[0] - proxy->min[0],
+                         fmaxf(proxy->max[1] - proxy->min[1], proxy->max[2] - proxy->min[2]));
+    uint32_t level = 0;
+    float cell_size = hash->cell_size;
+    while (extent > cell_size && level < SPATIAL_LEVELS) {
+        cell_size *= 2.0f;
+        level++;
+    }
+    return level;
+}
+
+static uint32_t *list_head(poc_spatial_hash *hash, uint32_t bucket) {
+    return bucket == SPATIAL_HUGE ? &hash->huge_head : &hash->buckets[bucket];
+}
+
+static void link_proxy(poc_spatial_hash *hash, uint32_t index) {
+    spatial_proxy *proxy = &hash->proxies[index];
+
+    proxy->level = proxy_level(hash, proxy);
+    if (proxy->level == SPATIAL_LEVELS) {
+        proxy->bucket = SPATIAL_HUGE;
+    } else {
+        spatial_level *level = &hash->levels[proxy->level];
+        float cell_size = level_cell_size(hash, proxy->level);
+        for (int axis = 0; axis < 3; axis++) {
+            proxy->cell[axis] = cell_coordinate(0.5f * (proxy->min[axis] + proxy->max[axis]), cell_size);
+            if (proxy->cell[axis] < level->cell_min[axis]) level->cell_min[axis] = proxy->cell[axis];
+            if (proxy->cell[axis] > level->cell_max[axis]) level->cell_max[axis] = proxy->cell[axis];
+        }
+        proxy->bucket = cell_bucket(hash, proxy->level, proxy->cell[0], proxy->cell[1], proxy->cell[2]);
+        level->count++;
+    }
+
+    uint32_t *head = list_head(hash, proxy->bucket);
+    proxy->prev = SPATIAL_NONE;
+    proxy->next = *head;
+    if (*head != SPATIAL_NONE) {
+        hash->proxies[*head].prev = index;
+    }
+    *head = index;
+}
+
+static void unlink_proxy(poc_spatial_hash *hash, uint32_t index) {
+    spatial_proxy *proxy = &hash->proxies[index];
+
+    if (proxy->prev != SPATIAL_NONE) {
+        hash->proxies[proxy->prev].next = proxy->next;
+    } else {
+        *list_head(hash, proxy->bucket) = proxy->next;
+    }
+    if (proxy->next != SPATIAL_NONE) {
+        hash->proxies[proxy->next].prev = proxy->prev;
+    }
+
+    if (proxy->bucket != SPATIAL_HUGE) {
+        hash->levels[proxy->level].count--;
+    }
+}
+
+// Base cells about twice the average box size keep most boxes on level 0
+// while a cell holds only a handful of them
+static void choose_cell_size(poc_spatial_hash *hash) {
+    double extent = 0.0;
+    uint32_t sized = 0;
+    for (uint32_t i = 0; i < hash->proxy_count; i++) {
+        const spatial_proxy *proxy = &hash->proxies[i];
+        if (!proxy->object) {
+            continue;
+        }
+        float largest = fmaxf(proxy->max[0] - proxy->min[0],
+                              fmaxf(proxy->max[1] - proxy->min[1], proxy->max[2] - proxy->min[2]));
+        if (largest > 0.0f) {
+            extent += largest;
+            sized++;
+        }
+    }
+
+    float cell_size = sized > 0 ? (float)(2.0 * extent / sized) : 1.0f;
+    hash->cell_size = cell_size > 1e-4f ? cell_size : 1e-4f;
+}
+
+// Re-bucket every proxy into a table of bucket_count buckets
+static bool rebuild(poc_spatial_hash *hash, uint32_t bucket_count) {
+    uint32_t *buckets = malloc(sizeof(uint32_t) * bucket_count);
+    if (!buckets) {
+        return false;
+    }
+    memset(buckets, 0xFF, sizeof(uint32_t) * bucket_count);
+
+    free(hash->buckets);
+    hash->buckets = buckets;
+    hash->bucket_count = bucket_count;
+    hash->huge_head = SPATIAL_NONE;
+    for (uint32_t level = 0; level < SPATIAL_LEVELS; level++) {
+        hash->levels[level].count = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            hash->levels[level].cell_min[axis] = INT32_MAX;
+            hash->levels[level].cell_max[axis] = INT32_MIN;
+        }
+    }
+
+    for (uint32_t i = 0; i < hash->proxy_count; i++) {
+        if (hash->proxies[i].object) {
+            link_proxy(hash, i);
+        }
+    }
+    return true;
+}
+
+static bool add_proxy(poc_spatial_hash *hash, poc_scene_object *object) {
+    uint32_t index;
+    if (hash->free_count > 0) {
+        index = hash->free_proxies[--hash->free_count];
+    } else {
+        if (!reserve((void **)&hash->proxies, &hash->proxy_capacity, hash->proxy_count + 1, sizeof(spatial_proxy))) {
+            return false;
+        }
+        index = hash->proxy_count++;
+    }
+
+    spatial_proxy *proxy = &hash->proxies[index];
+    proxy->object = object;
+    object_bounds(object, proxy->min, proxy->max);
+    link_proxy(hash, index);
+
+    hash->live_count++;
+    object->spatial_proxy = index + 1;
+    return true;
+}
+
+poc_spatial_hash *poc_spatial_hash_create(poc_scene *scene) {
+    if (!scene) {
+        return NULL;
+    }
+
+    poc_spatial_hash *hash = calloc(1, sizeof(poc_spatial_hash));
+    if (!hash) {
+        return NULL;
+    }
+    hash->scene = scene;
+
+    // Proxies first so the cell size can be derived from their bounds
+    for (uint32_t i = 0; i < scene->object_count; i++) {
+        poc_scene_object *object = scene->objects[i];
+        if (!object) {
+            continue;
+        }
+        if (!reserve((void **)&hash->proxies, &hash->proxy_capacity, hash->proxy_count + 1, sizeof(spatial_proxy))) {
+            poc_spatial_hash_destroy(hash);
+            return NULL;
+        }
+        spatial_proxy *proxy = &hash->proxies[hash->proxy_count];
+        proxy->object = object;
+        object_bounds(object, proxy->min, proxy->max);
+        object->spatial_proxy = ++hash->proxy_count;
+    }
+    hash->live_count = hash->proxy_count;
+
+    uint32_t bucket_count = SPATIAL_MIN_BUCKETS;
+    while (bucket_count < hash->live_count) {
+        bucket_count *= 2;
+    }
+    choose_cell_size(hash);
+    if (!rebuild(hash, bucket_count)) {
+        poc_spatial_hash_destroy(hash);
+        return NULL;
+    }
+    return hash;
+}
+
+void poc_spatial_hash_destroy(poc_spatial_hash *hash) {
+    if (!hash) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < hash->proxy_count; i++) {
+        if (hash->proxies[i].object) {
+            hash->proxies[i].object->spatial_proxy = 0;
+        }
+    }
+
+    free(hash->buckets);
+    free(hash->proxies);
+    free(hash->free_proxies);
+    free(hash);
+}
+
+void poc_spatial_hash_remove(poc_spatial_hash *hash, poc_scene_object *object) {
+    if (!hash || !object || object->spatial_proxy == 0) {
+        return;
+    }
+
+    uint32_t index = object->spatial_proxy - 1;
+    object->spatial_proxy = 0;
+
+    unlink_proxy(hash, index);
+    hash->proxies[index].object = NULL;
+    hash->live_count--;
+
+    // If memory runs out the slot is simply never reused
+    if (reserve((void **)&hash->free_proxies, &hash->free_capacity, hash->free_count + 1, sizeof(uint32_t))) {
+        hash->free_proxies[hash->free_count++] = index;
+    }
+}
+
+void poc_spatial_hash_update(poc_spatial_hash *hash, poc_scene_object **changed, uint32_t count) {
+    if (!hash) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        poc_scene_object *object = changed[i];
+        if (object->spatial_proxy == 0) {
+            add_proxy(hash, object);
+            continue;
+        }
+
+        uint32_t index = object->spatial_proxy - 1;
+        spatial_proxy *proxy = &hash->proxies[index];
+        object_bounds(object, proxy->min, proxy->max);
+
+        // Most moves stay within the cell
+        uint32_t level = proxy_level(hash, proxy);
+        bool same_cell = level == proxy->level;
+        if (same_cell && level < SPATIAL_LEVELS) {
+            float cell_size = level_cell_size(hash, level);
+            for (int axis = 0; axis < 3; axis++) {
+                same_cell &= cell_coordinate(0.5f * (proxy->min[axis] + proxy->max[axis]), cell_size) == proxy->cell[axis];
+            }
+        }
+        if (!same_cell) {
+            unlink_proxy(hash, index);
+            link_proxy(hash, index);
+        }
+    }
+
+    // Keep about one object per bucket; a failed rebuild keeps the old table
+    if (hash->live_count > hash->bucket_count) {
+        uint32_t bucket_count = hash->bucket_count;
+        while (bucket_count < hash->live_count) {
+            bucket_count *= 2;
+        }
+        rebuild(hash, bucket_count);
+    }
+}
+
+typedef struct {
+    float min[3];
+    float max[3];
+    float center[3];
+    float radius_squared;
+    bool sphere;
+} spatial_query;
+
+static float distance_squared_to_box(const float point[3], const float min[3], const float max[3]) {
+    float distance_squared = 0.0f;
+    for (int axis = 0; axis < 3; axis++) {
+        float gap = fmaxf(fmaxf(min[axis] - point[axis], point[axis] - max[axis]), 0.0f);
+        distance_squared += gap * gap;
+    }
+    return distance_squared;
+}
+
+static bool query_matches(const spatial_query *query, const spatial_proxy *proxy) {
+    if (!proxy->object->enabled) {
+        return false;
+    }
+    if (query->sphere) {
+        return distance_squared_to_box(query->center, proxy->min, proxy->max) <= query->radius_squared;
+    }
+    return proxy->min[0] <= query->max[0] && query->min[0] <= proxy->max[0] &&
+           proxy->min[1] <= query->max[1] && query->min[1] <= proxy->max[1] &&
+           proxy->min[2] <= query->max[2] && query->min[2] <= proxy->max[2];
+}
+
+typedef void (*spatial_visitor)(void *context, const spatial_proxy *proxy);
+
+// Pass every proxy whose box may overlap [min, max] to visit. Returns true
+// if that covered every proxy in the hash.
+static bool visit_region(const poc_spatial_hash *hash, const float min[3], const float max[3],
+                         spatial_visitor visit, void *context) {
+    int32_t low[SPATIAL_LEVELS][3];
+    int32_t high[SPATIAL_LEVELS][3];
+    uint64_t cells = 0;
+    bool complete = true;
+
+    for (uint32_t level = 0; level < SPATIAL_LEVELS; level++) {
+        const spatial_level *state = &hash->levels[level];
+        if (state->count == 0) {
+            continue;
+        }
+
+        // A box reaches at most half a cell past the cell holding its center
+        float cell_size = level_cell_size(hash, level);
+        float margin = 0.5f * cell_size;
+        uint64_t level_cells = 1;
+        for (int axis = 0; axis < 3; axis++) {
+            low[level][axis] = cell_coordinate(min[axis] - margin, cell_size);
+            high[level][axis] = cell_coordinate(max[axis] + margin, cell_size);
+            complete &= low[level][axis] <= state->cell_min[axis] && high[level][axis] >= state->cell_max[axis];
+            if (low[level][axis] < state->cell_min[axis]) low[level][axis] = state->cell_min[axis];
+            if (high[level][axis] > state->cell_max[axis]) high[level][axis] = state->cell_max[axis];
+            uint64_t span = low[level][axis] <= high[level][axis]
+                          ? (uint64_t)((int64_t)high[level][axis] - low[level][axis] + 1) : 0;
+            // Saturate just past bucket_count so a huge or unbounded query
+            // cannot wrap the product and skip the full-scan fallback
+            if (span == 0 || level_cells == 0) {
+                level_cells = 0;
+            } else if (span > hash->bucket_count || level_cells > hash->bucket_count / span) {
+                level_cells = (uint64_t)hash->bucket_count + 1;
+            } else {
+                level_cells *= span;
+            }
+        }
+        cells += level_cells;
+    }
+
+    // Covering more cells than there are buckets: every object is a
+    // candidate anyway, so scan them in memory order
+    if (cells > hash->bucket_count) {
+        for (uint32_t i = 0; i < hash->proxy_count; i++) {
+            if (hash->proxies[i].object) {
+                visit(context, &hash->proxies[i]);
+            }
+        }
+        return true;
+    }
+
+    for (uint32_t i = hash->huge_head; i != SPATIAL_NONE; i = hash->proxies[i].next) {
+        visit(context, &hash->proxies[i]);
+    }
+
+    for (uint32_t level = 0; level < SPATIAL_LEVELS; level++) {
+        if (hash->levels[level].count == 0) {
+            continue;
+        }
+        for (int32_t x = low[level][0]; x <= high[level][0]; x++) {
+            for (int32_t y = low[level][1]; y <= high[level][1]; y++) {
+                for (int32_t z = low[level][2]; z <= high[level][2]; z++) {
+                    uint32_t bucket = cell_bucket(hash, level, x, y, z);
+                    for (uint32_t i = hash->buckets[bucket]; i != SPATIAL_NONE; i = hash->proxies[i].next) {
+                        const spatial_proxy *proxy = &hash->proxies[i];
+                        // Buckets are shared by colliding cells; each object
+                        // is visited from its own cell only
+                        if (proxy->level == level && proxy->cell[0] == x && proxy->cell[1] == y && proxy->cell[2] == z) {
+                            visit(context, proxy);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return complete;
+}
+
+typedef struct {
+    spatial_query query;
+    poc_scene_object **results;
+    uint32_t max_results;
+    uint32_t found;
+} spatial_collector;
+
+static void collect(void *context, const spatial_proxy *proxy) {
+    spatial_collector *collector = context;
+    if (query_matches(&collector->query, proxy)) {
+        if (collector->found < collector->max_results) {
+            collector->results[collector->found] = proxy->object;
+        }
+        collector->found++;
+    }
+}
+
+uint32_t poc_spatial_hash_query_aabb(const poc_spatial_hash *hash, const float min[3], const float max[3],
+                                     poc_scene_object **results, uint32_t max_results) {
+    if (!hash || !min || !max) {
+        return 0;
+    }
+
+    spatial_collector collector = {
+        .query = {.sphere = false},
+        .results = results,
+        .max_results = results ? max_results : 0,
+    };
+    memcpy(collector.query.min, min, sizeof(collector.query.min));
+    memcpy(collector.query.max, max, sizeof(collector.query.max));
+    visit_region(hash, min, max, collect, &collector);
+    return collector.found;
+}
+
+uint32_t poc_spatial_hash_query_sphere(const poc_spatial_hash *hash, const float center[3], float radius,
+                                       poc_scene_object **results, uint32_t max_results) {
+    if (!hash || !center || !(radius >= 0.0f)) {
+        return 0;
+    }
+
+    spatial_collector collector = {
+        .query = {.radius_squared = radius * radius, .sphere = true},
+        .results = results,
+        .max_results = results ? max_results : 0,
+    };
+    for (int axis = 0; axis < 3; axis++) {
+        collector.query.center[axis] = center[axis];
+        collector.query.min[axis] = center[axis] - radius;
+        collector.query.max[axis] = center[axis] + radius;
+    }
+    visit_region(hash, collector.query.min, collector.query.max, collect, &collector);
+    return collector.found;
+}
+
+// Max-heap on squared distance kept in the caller's arrays
+typedef struct {
+    poc_scene_object **objects;
+    float *distances;
+    uint32_t count;
+    uint32_t capacity;
+    float point[3];
+} knn_heap;
+
+static void heap_swap(knn_heap *heap, uint32_t a, uint32_t b) {
+    poc_scene_object *object = heap->objects[a];
+    float distance = heap->distances[a];
+    heap->objects[a] = heap->objects[b];
+    heap->distances[a] = heap->distances[b];
+    heap->objects[b] = object;
+    heap->distances[b] = distance;
+}
+
+static void heap_sift_down(knn_heap *heap, uint32_t index, uint32_t count) {
+    for (;;) {
+        uint32_t largest = index;
+        uint32_t left = index * 2 + 1;
+        uint32_t right = left + 1;
+        if (left < count && heap->distances[left] > heap->distances[largest]) largest = left;
+        if (right < count && heap->distances[right] > heap->distances[largest]) largest = right;
+        if (largest == index) {
+            return;
+        }
+        heap_swap(heap, index, largest);
+        index = largest;
+    }
+}
+
+static void heap_offer(void *context, const spatial_proxy *proxy) {
+    knn_heap *heap = context;
+    if (!proxy->object->enabled) {
+        return;
+    }
+
+    float distance_squared = distance_squared_to_box(heap->point, proxy->min, proxy->max);
+    if (heap->count < heap->capacity) {
+        uint32_t index = heap->count++;
+        heap->objects[index] = proxy->object;
+        heap->distances[index] = distance_squared;
+        while (index > 0 && heap->distances[(index - 1) / 2] < heap->distances[index]) {
+            heap_swap(heap, index, (index - 1) / 2);
+            index = (index - 1) / 2;
+        }
+    } else if (distance_squared < heap->distances[0]) {
+        heap->objects[0] = proxy->object;
+        heap->distances[0] = distance_squared;
+        heap_sift_down(heap, 0, heap->count);
+    }
+}
+
+uint32_t poc_spatial_hash_query_knn(const poc_spatial_hash *hash, const float point[3], uint32_t k,
+                                    poc_scene_object **results, float *distances) {
+    if (!hash || !point || k == 0 || !results || !distances) {
+        return 0;
+    }
+
+    knn_heap heap = {.objects = results, .distances = distances, .capacity = k};
+    memcpy(heap.point, point, sizeof(heap.point));
+
+    // Start from the distance to the occupied region so a point far outside
+    // it does not sweep empty space first
+    float gap_squared = FLT_MAX;
+    for (uint32_t level = 0; level < SPATIAL_LEVELS; level++) {
+        const spatial_level *state = &hash->levels[level];
+        if (state->count == 0) {
+            continue;
+        }
+        float cell_size = level_cell_size(hash, level);
+        float min[3];
+        float max[3];
+        for (int axis = 0; axis < 3; axis++) {
+            min[axis] = ((float)state->cell_min[axis] - 0.5f) * cell_size;
+            max[axis] = ((float)state->cell_max[axis] + 1.5f) * cell_size;
+        }
+        gap_squared = fminf(gap_squared, distance_squared_to_box(point, min, max));
+    }
+    float start = gap_squared < FLT_MAX ? sqrtf(gap_squared) : 0.0f;
+
+    // Gather around the point with a doubling radius. Every object within
+    // the radius is visited, so once k objects lie inside it nothing
+    // unvisited can be nearer.
+    for (float radius = start + hash->cell_size;; radius *= 2.0f) {
+        float min[3] = {point[0] - radius, point[1] - radius, point[2] - radius};
+        float max[3] = {point[0] + radius, point[1] + radius, point[2] + radius};
+
+        heap.count = 0;
+        bool complete = visit_region(hash, min, max, heap_offer, &heap);
+        if (complete || (heap.count == k && heap.distances[0] <= radius * radius) || !isfinite(radius)) {
+            break;
+        }
+    }
+
+    // Heap sort into ascending distance
+    for (uint32_t end = heap.count; end > 1; end--) {
+        heap_swap(&heap, 0, end - 1);
+        heap_sift_down(&heap, 0, end - 1);
+    }
+    for (uint32_t i = 0; i < heap.count; i++) {
+        distances[i] = sqrtf(distances[i]);
+    }
+    return heap.count;
+}
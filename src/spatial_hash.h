@@ -0,0 +1,92 @@
+/**
+ * @file spatial_hash.h
+ * @brief Loose uniform grid for radius, box and nearest-neighbor queries
+ *
+ * Every object sits in exactly one cell, picked by the center of its world
+ * AABB (or its world position if it has no mesh). The grid is loose: a box
+ * may reach half a cell past its cell, so a query only widens its range by
+ * half a cell instead of inserting boxes into every cell they touch. Boxes
+ * bigger than a base cell go to coarser levels whose cells double in size,
+ * so a few huge objects do not force big cells on everything else.
+ *
+ * Cells of all levels are hashed into one bucket table that grows with the
+ * object count, so empty space costs nothing and a query only touches the
+ * cells it covers. Each scene update moves the changed objects between
+ * buckets.
+ */
+
+#pragma once
+
+#include "scene_object.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Spatial hash owned by one scene
+ */
+typedef struct poc_spatial_hash poc_spatial_hash;
+
+/**
+ * @brief Create a spatial hash holding every object already in a scene
+ *
+ * The cell size is derived from the objects' average size.
+ *
+ * @param scene Scene to index
+ * @return New spatial hash, or NULL on failure
+ */
+poc_spatial_hash *poc_spatial_hash_create(struct poc_scene *scene);
+
+/**
+ * @brief Destroy a spatial hash and detach the objects it tracks
+ */
+void poc_spatial_hash_destroy(poc_spatial_hash *hash);
+
+/**
+ * @brief Stop tracking an object that is leaving the scene
+ */
+void poc_spatial_hash_remove(poc_spatial_hash *hash, poc_scene_object *object);
+
+/**
+ * @brief Move changed objects to their new cells
+ *
+ * Called by poc_scene_update() after world bounds have been updated.
+ *
+ * @param hash Spatial hash to update
+ * @param changed Objects changed this update (new objects included)
+ * @param count Number of changed objects
+ */
+void poc_spatial_hash_update(poc_spatial_hash *hash, poc_scene_object **changed, uint32_t count);
+
+/**
+ * @brief Find enabled objects whose bounds overlap a box
+ *
+ * @return Number of matches; only the first max_results are written
+ */
+uint32_t poc_spatial_hash_query_aabb(const poc_spatial_hash *hash, const float min[3], const float max[3],
+                                     poc_scene_object **results, uint32_t max_results);
+
+/**
+ * @brief Find enabled objects whose bounds are within radius of a point
+ *
+ * @return Number of matches; only the first max_results are written
+ */
+uint32_t poc_spatial_hash_query_sphere(const poc_spatial_hash *hash, const float center[3], float radius,
+                                       poc_scene_object **results, uint32_t max_results);
+
+/**
+ * @brief Find the k enabled objects whose bounds are nearest to a point
+ *
+ * Both output arrays must hold k entries; they double as the search heap.
+ *
+ * @return Number of results written (at most k), nearest first
+ */
+uint32_t poc_spatial_hash_query_knn(const poc_spatial_hash *hash, const float point[3], uint32_t k,
+                                    poc_scene_object **results, float *distances);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,213 @@
+#include "string_table.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+// Entries live in fixed pages so readers never see them move; the page
+// directory itself is a static array and is never reallocated.
+#define STRING_PAGE_BITS 12
+#define STRING_PAGE_SIZE (1u << STRING_PAGE_BITS)
+#define STRING_MAX_PAGES 1024
+#define STRING_BLOCK_SIZE (64u * 1024u)
+
+typedef struct {
+    const char *text;
+    uint32_t length;
+    uint32_t hash;
+} string_entry;
+
+static pthread_mutex_t g_string_mutex = PTHREAD_MUTEX_INITIALIZER;
+static string_entry *g_string_pages[STRING_MAX_PAGES];
+static atomic_uint g_string_count = 1;      // Id 0 is the empty string
+
+// Open-addressed hash -> id slots (0 = empty), guarded by the mutex
+static uint32_t *g_string_slots = NULL;
+static uint32_t g_string_slot_capacity = 0;
+
+// Character storage: strings are packed into blocks that are never freed
+static char *g_string_block = NULL;
+static size_t g_string_block_used = 0;
+static size_t g_string_bytes = 0;
+
+static uint32_t hash_string(const char *string, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)string[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static string_entry *entry_for_id(uint32_t id) {
+    return &g_string_pages[id >> STRING_PAGE_BITS][id & (STRING_PAGE_SIZE - 1)];
+}
+
+// Caller holds the mutex. Returns the slot holding the string, or the empty
+// slot where it belongs.
+static uint32_t *find_slot(const char *string, size_t length, uint32_t hash) {
+    uint32_t mask = g_string_slot_capacity - 1;
+    uint32_t slot = hash & mask;
+    while (g_string_slots[slot] != 0) {
+        const string_entry *entry = entry_for_id(g_string_slots[slot]);
+        if (entry->hash == hash && entry->length == length && memcmp(entry->text, string, length) == 0) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return &g_string_slots[slot];
+}
+
+static bool grow_slots(void) {
+    uint32_t new_capacity = g_string_slot_capacity == 0 ? 1024 : g_string_slot_capacity * 2;
+    uint32_t *new_slots = calloc(new_capacity, sizeof(uint32_t));
+    if (!new_slots) {
+        return false;
+    }
+
+    uint32_t count = atomic_load_explicit(&g_string_count, memory_order_relaxed);
+    free(g_string_slots);
+    g_string_slots = new_slots;
+    g_string_slot_capacity = new_capacity;
+
+    uint32_t mask = new_capacity - 1;
+    for (uint32_t id = 1; id < count; id++) {
+        uint32_t slot = entry_for_id(id)->hash & mask;
+        while (new_slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        new_slots[slot] = id;
+    }
+    return true;
+}
+
+static char *store_text(const char *string, size_t length) {
+    size_t size = length + 1;
+    char *text;
+
+    if (size > STRING_BLOCK_SIZE / 4) {
+        // Long strings get their own allocation instead of wasting a block tail
+        text = malloc(size);
+        if (!text) {
+            return NULL;
+        }
+        g_string_bytes += size;
+    } else {
+        if (!g_string_block || g_string_block_used + size > STRING_BLOCK_SIZE) {
+            char *block = malloc(STRING_BLOCK_SIZE);
+            if (!block) {
+                return NULL;
+            }
+            g_string_block = block;
+            g_string_block_used = 0;
+            g_string_bytes += STRING_BLOCK_SIZE;
+        }
+        text = g_string_block + g_string_block_used;
+        g_string_block_used += size;
+    }
+
+    memcpy(text, string, length);
+    text[length] = '\0';
+    return text;
+}
+
+poc_string_id poc_string_intern_n(const char *string, size_t length) {
+    if (!string || length == 0 || length > UINT32_MAX) {
+        return POC_STRING_EMPTY;
+    }
+
+    uint32_t hash = hash_string(string, length);
+
+    pthread_mutex_lock(&g_string_mutex);
+
+    uint32_t count = atomic_load_explicit(&g_string_count, memory_order_relaxed);
+    if ((uint64_t)count * 2 >= g_string_slot_capacity && !grow_slots()) {
+        pthread_mutex_unlock(&g_string_mutex);
+        return POC_STRING_EMPTY;
+    }
+
+    uint32_t *slot = find_slot(string, length, hash);
+    if (*slot != 0) {
+        poc_string_id id = *slot;
+        pthread_mutex_unlock(&g_string_mutex);
+        return id;
+    }
+
+    uint32_t page = count >> STRING_PAGE_BITS;
+    if (page >= STRING_MAX_PAGES) {
+        pthread_mutex_unlock(&g_string_mutex);
+        return POC_STRING_EMPTY;
+    }
+    if (!g_string_pages[page]) {
+        g_string_pages[page] = malloc(sizeof(string_entry) * STRING_PAGE_SIZE);
+        if (!g_string_pages[page]) {
+            pthread_mutex_unlock(&g_string_mutex);
+            return POC_STRING_EMPTY;
+        }
+        g_string_bytes += sizeof(string_entry) * STRING_PAGE_SIZE;
+    }
+
+    char *text = store_text(string, length);
+    if (!text) {
+        pthread_mutex_unlock(&g_string_mutex);
+        return POC_STRING_EMPTY;
+    }
+
+    string_entry *entry = entry_for_id(count);
+    entry->text = text;
+    entry->length = (uint32_t)length;
+    entry->hash = hash;
+    *slot = count;
+
+    // Publish the entry for lock-free readers
+    atomic_store_explicit(&g_string_count, count + 1, memory_order_release);
+    pthread_mutex_unlock(&g_string_mutex);
+    return count;
+}
+
+poc_string_id poc_string_intern(const char *string) {
+    return string ? poc_string_intern_n(string, strlen(string)) : POC_STRING_EMPTY;
+}
+
+bool poc_string_find(const char *string, poc_string_id *out_id) {
+    if (!string || !out_id) {
+        return false;
+    }
+
+    size_t length = strlen(string);
+    if (length == 0) {
+        *out_id = POC_STRING_EMPTY;
+        return true;
+    }
+
+    uint32_t hash = hash_string(string, length);
+
+    pthread_mutex_lock(&g_string_mutex);
+    bool found = false;
+    if (g_string_slot_capacity > 0) {
+        uint32_t *slot = find_slot(string, length, hash);
+        if (*slot != 0) {
+            *out_id = *slot;
+            found = true;
+        }
+    }
+    pthread_mutex_unlock(&g_string_mutex);
+    return found;
+}
+
+const char *poc_string_get(poc_string_id id) {
+    if (id == POC_STRING_EMPTY || id >= atomic_load_explicit(&g_string_count, memory_order_acquire)) {
+        return "";
+    }
+    return entry_for_id(id)->text;
+}
+
+size_t poc_string_table_memory(uint32_t *out_count) {
+    pthread_mutex_lock(&g_string_mutex);
+    size_t bytes = g_string_bytes + sizeof(uint32_t) * g_string_slot_capacity;
+    if (out_count) {
+        *out_count = atomic_load_explicit(&g_string_count, memory_order_relaxed) - 1;
+    }
+    pthread_mutex_unlock(&g_string_mutex);
+    return bytes;
+}
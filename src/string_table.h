@@ -0,0 +1,78 @@
+/**
+ * @file string_table.h
+ * @brief Process-wide string interning
+ *
+ * Names and asset paths are stored once in a global table and referenced by
+ * 32-bit ids, so structs that carry them stay small and cheap to copy, and
+ * equal strings compare by id. Interned strings are never freed; the table
+ * lives for the whole process.
+ *
+ * Interning is safe from any thread. poc_string_get() takes no lock: the
+ * returned pointer stays valid forever.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Id of an interned string
+ */
+typedef uint32_t poc_string_id;
+
+/**
+ * @brief Id of the empty string, valid without interning anything
+ */
+#define POC_STRING_EMPTY 0u
+
+/**
+ * @brief Intern a NUL-terminated string
+ *
+ * @param string String to intern (NULL is treated as "")
+ * @return Id of the string, or POC_STRING_EMPTY if out of memory
+ */
+poc_string_id poc_string_intern(const char *string);
+
+/**
+ * @brief Intern the first length bytes of a string
+ *
+ * @param string Characters to intern (need not be NUL-terminated)
+ * @param length Number of bytes
+ * @return Id of the string, or POC_STRING_EMPTY if out of memory
+ */
+poc_string_id poc_string_intern_n(const char *string, size_t length);
+
+/**
+ * @brief Look up a string without adding it
+ *
+ * @param string String to find
+ * @param out_id Receives the id if found
+ * @return true if the string has been interned
+ */
+bool poc_string_find(const char *string, poc_string_id *out_id);
+
+/**
+ * @brief Get the characters of an interned string
+ *
+ * @param id String id
+ * @return NUL-terminated string, or "" for unknown ids
+ */
+const char *poc_string_get(poc_string_id id);
+
+/**
+ * @brief Report the size of the table
+ *
+ * @param out_count Receives the number of distinct strings (can be NULL)
+ * @return Bytes held by the table (characters, entries and hash slots)
+ */
+size_t poc_string_table_memory(uint32_t *out_count);
+
+#ifdef __cplusplus
+}
+#endif
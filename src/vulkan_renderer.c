@@ -9,6 +9,7 @@
 #include "scene.h"
 #include "scene_object.h"
 #include "mesh.h"
+#include "mesh_cluster.h"
 #include <vulkan/vulkan.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -17,6 +18,8 @@
 #include <math.h>
 #include <errno.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <cglm/cglm.h>
 #include "../deps/podi/src/internal.h"
 
@@ -53,6 +56,9 @@ void podi_window_set_fullscreen_exclusive(podi_window *window, bool enabled);
 static void cleanup_depth_resources(poc_context *ctx);
 static poc_result create_depth_resources(poc_context *ctx);
 static poc_renderable* create_renderable_from_scene_object(poc_context *ctx, poc_scene_object *obj);
+static void free_renderable_gpu(poc_renderable_gpu *gpu);
+static void release_renderable_geometry(poc_renderable_gpu *gpu);
+static poc_result create_renderable_uniforms(poc_context *ctx, poc_renderable_gpu *gpu);
 
 // Title bar height constant (logical pixels) for client-side decorations
 #define PODI_TITLE_BAR_HEIGHT 40
@@ -79,8 +85,22 @@ typedef struct {
     vec4 render_params;
 } UniformBufferObject;
 
-// Renderable object structure
-struct poc_renderable {
+// One submesh of a renderable: an index range drawn with material i, whose
+// uniforms live in slot i of the renderable's uniform buffer. Its culling
+// clusters, if any, are a contiguous run of the renderable's clusters.
+typedef struct {
+    uint32_t first_index;
+    uint32_t index_count;
+    uint32_t first_cluster;
+    uint32_t cluster_count;
+} renderable_range;
+
+// GPU resources of the mesh a renderable currently shows. Built on the
+// simulation thread and never modified afterwards, except for the uniform
+// cache, which only the thread recording frames touches. Loading another
+// mesh builds a new one; while a render thread runs the old one is retired
+// until no snapshot or frame in flight can still reference it.
+struct poc_renderable_gpu {
     // Geometry data
     VkBuffer vertex_buffer;
     VkDeviceMemory vertex_buffer_memory;
@@ -88,22 +108,43 @@ struct poc_renderable {
     VkDeviceMemory index_buffer_memory;
     uint32_t vertex_count;
     uint32_t index_count;
+    atomic_uint *geometry_refs; // Shared by clones of this renderable; last owner frees the buffers
 
-    // Per-object uniform resources
+    // Per-object uniform resources, one slot per range
     VkBuffer uniform_buffer;
     VkDeviceMemory uniform_buffer_memory;
     void *uniform_buffer_mapped;
+    VkDeviceSize uniform_stride;
     VkDescriptorSet descriptor_set;
 
-    // Material properties
-    poc_material material;
-    bool has_material;
+    // Submesh ranges sharing the vertex/index buffers; none means one
+    // range over all indices
+    renderable_range *ranges;
+    uint32_t range_count;
+
+    // Material of each uniform slot (default material where a range has none)
+    poc_material *materials;
+
+    // Culling clusters of all ranges, in index order (copied from the mesh)
+    poc_mesh_cluster *clusters;
+    uint32_t cluster_count;
+
+    // Uniform cache: model matrix and frame globals version last written
+    uint64_t uniform_globals_version;
+    mat4 uniform_model;
+};
+
+// Renderable object structure
+struct poc_renderable {
+    // Current GPU resources; NULL until a mesh is loaded
+    poc_renderable_gpu *gpu;
 
     // Transform
     mat4 model_matrix;
+    uint64_t transform_generation;  // Scene object transform generation model_matrix holds; 0 if none
 
     // Identification
-    char name[256];
+    poc_string_id name;  // Interned
 
     // Context reference (for resource cleanup)
     poc_context *ctx;
@@ -134,6 +175,7 @@ typedef struct {
     VkInstance instance;
     VkDebugUtilsMessengerEXT debug_messenger;
     VkPhysicalDevice physical_device;
+    VkDeviceSize min_uniform_alignment;
     VkDevice device;
     VkQueue graphics_queue;
     VkQueue present_queue;
@@ -145,6 +187,14 @@ typedef struct {
 
 #define MAX_FRAMES_IN_FLIGHT 2
 
+// Renderable GPU resources replaced or destroyed while the render thread may
+// still reference them
+typedef struct {
+    poc_renderable_gpu *gpu;
+    uint64_t retire_after_snapshot;  // First snapshot that no longer contains it
+    uint64_t safe_render_frame;      // Render frame at which that snapshot was drawn (0 = not yet)
+} retired_renderable;
+
 struct poc_context {
     vulkan_state *vk;
     VkSurfaceKHR surface;
@@ -188,6 +238,28 @@ struct poc_context {
     // Camera system
     poc_camera *camera;
 
+    // Frame-global uniform state; renderable UBOs are only rewritten when
+    // this (tracked by version) or the renderable's transform changed
+    mat4 frame_view;
+    mat4 frame_proj;
+    mat4 frame_view_proj;
+    vec3 frame_view_pos;
+    float frame_play_flag;
+    uint64_t frame_globals_version;
+
+    // Draw calls recorded so far this frame, and the total of the last
+    // recorded frame for readers on other threads
+    uint32_t frame_draw_calls;
+    atomic_uint draw_calls;
+
+    // Triangles drawn after cluster culling and triangles in every drawn
+    // renderable, counted like draw calls
+    atomic_bool cluster_culling;
+    uint64_t frame_triangles_submitted;
+    uint64_t frame_triangles_total;
+    atomic_uint_fast64_t triangles_submitted;
+    atomic_uint_fast64_t triangles_total;
+
     // Model rendering support (DEPRECATED - use renderables instead)
     VkBuffer vertex_buffer;
     VkDeviceMemory vertex_buffer_memory;
@@ -208,8 +280,7 @@ struct poc_context {
 
     // Play/Edit mode state
     bool play_mode;
-    bool play_scene_cache_valid;
-    char play_scene_cache_path[PATH_MAX];
+    poc_scene_snapshot *play_snapshot; // Edit scene state captured on entering play mode
     bool has_camera_backup;
     poc_camera camera_backup;
     bool has_window_backup;
@@ -220,6 +291,20 @@ struct poc_context {
     VkImage depth_image;
     VkDeviceMemory depth_image_memory;
     VkImageView depth_image_view;
+
+    // Render thread support (see frame_loop.h)
+    atomic_bool render_thread_active;
+    pthread_mutex_t queue_mutex;           // Serializes graphics/present queue access
+    VkCommandPool upload_command_pool;     // Transfers issued off the render thread
+    const poc_render_snapshot *frame_snapshot;  // Snapshot being drawn by begin_frame, if any
+    atomic_uint_fast64_t snapshot_counter;
+    uint64_t render_frame_counter;
+    float snapshot_clear_color[4];
+
+    pthread_mutex_t retire_mutex;
+    retired_renderable *retired_renderables;
+    uint32_t retired_count;
+    uint32_t retired_capacity;
 };
 
 static vulkan_state g_vk_state = {0};
@@ -718,6 +803,7 @@ static poc_result select_physical_device(VkSurfaceKHR surface) {
     printf("  Present queue family: %u\n", best_indices.present_family);
 
     g_vk_state.physical_device = best_device;
+    g_vk_state.min_uniform_alignment = properties.limits.minUniformBufferOffsetAlignment;
     g_vk_state.graphics_family_index = best_indices.graphics_family;
     g_vk_state.present_family_index = best_indices.present_family;
 
@@ -1126,7 +1212,10 @@ static poc_result create_swapchain_internal(poc_context *ctx, VkSwapchainKHR old
     ctx->swapchain_colorspace = surface_format.colorSpace;
     ctx->swapchain_extent = extent;
 
-    if (ctx->camera && extent.width > 0 && extent.height > 0) {
+    // With a render thread the camera belongs to the simulation side, which
+    // picks up the new aspect ratio when capturing the next snapshot
+    if (ctx->camera && extent.width > 0 && extent.height > 0 &&
+        !atomic_load(&ctx->render_thread_active)) {
         float aspect_ratio = (float)extent.width / (float)extent.height;
         poc_camera_set_aspect_ratio(ctx->camera, aspect_ratio);
     }
@@ -1194,11 +1283,18 @@ static void cleanup_swapchain_images(poc_context *ctx) {
     ctx->swapchain_image_count = 0;
 }
 
+// vkDeviceWaitIdle requires every queue to be externally synchronized
+static void device_wait_idle_locked(poc_context *ctx) {
+    pthread_mutex_lock(&ctx->queue_mutex);
+    vkDeviceWaitIdle(g_vk_state.device);
+    pthread_mutex_unlock(&ctx->queue_mutex);
+}
+
 static void cleanup_pipeline_dependent_resources(poc_context *ctx) {
     if (!ctx || !g_vk_state.device) return;
 
     // Ensure device is idle before cleanup
-    vkDeviceWaitIdle(g_vk_state.device);
+    device_wait_idle_locked(ctx);
 
     // Destroy framebuffers (dependent on swapchain image views)
     if (ctx->framebuffers) {
@@ -1250,7 +1346,7 @@ static poc_result recreate_swapchain(poc_context *ctx) {
     printf("Recreating swapchain...\n");
 
     // Wait for device to be idle
-    vkDeviceWaitIdle(g_vk_state.device);
+    device_wait_idle_locked(ctx);
 
     // Clean up old swapchain resources
     cleanup_swapchain_images(ctx);
@@ -1296,6 +1392,16 @@ static poc_result create_command_pool(poc_context *ctx) {
 
     VK_CHECK(vkCreateCommandPool(g_vk_state.device, &pool_info, NULL, &ctx->command_pool));
 
+    // Buffer uploads get their own pool so they can be recorded on the
+    // simulation thread while the render thread records frames
+    VkCommandPoolCreateInfo upload_pool_info = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+        .queueFamilyIndex = g_vk_state.graphics_family_index
+    };
+
+    VK_CHECK(vkCreateCommandPool(g_vk_state.device, &upload_pool_info, NULL, &ctx->upload_command_pool));
+
     printf("✓ Command pool created\n");
     return POC_RESULT_SUCCESS;
 }
@@ -1346,53 +1452,36 @@ static poc_result create_sync_objects(poc_context *ctx) {
     return POC_RESULT_SUCCESS;
 }
 
-static char *read_file(const char *filename, size_t *file_size) {
-    FILE *file = fopen(filename, "rb");
-    if (!file) {
+// Mapped, so shaders in the asset archive are read in place. Mappings are
+// page aligned, which satisfies SPIR-V's 4-byte alignment.
+static bool read_file(const char *filename, poc_file_map *file) {
+    if (!poc_file_map_open(filename, file)) {
         printf("Failed to open file: %s\n", filename);
-        return NULL;
-    }
-
-    fseek(file, 0, SEEK_END);
-    *file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-
-    char *buffer = malloc(*file_size);
-    if (!buffer) {
-        printf("Failed to allocate memory for file: %s\n", filename);
-        fclose(file);
-        return NULL;
+        return false;
     }
-
-    size_t read_size = fread(buffer, 1, *file_size, file);
-    fclose(file);
-
-    if (read_size != *file_size) {
-        printf("Failed to read entire file: %s\n", filename);
-        free(buffer);
-        return NULL;
+    if (file->size == 0) {
+        printf("File is empty: %s\n", filename);
+        return false;
     }
-
-    return buffer;
+    return true;
 }
 
 static VkShaderModule create_shader_module(const char *filename) {
-    size_t code_size;
-    char *code = read_file(filename, &code_size);
-    if (!code) {
+    poc_file_map code;
+    if (!read_file(filename, &code)) {
         return VK_NULL_HANDLE;
     }
 
     VkShaderModuleCreateInfo create_info = {
         .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-        .codeSize = code_size,
-        .pCode = (const uint32_t*)code
+        .codeSize = code.size,
+        .pCode = (const uint32_t*)code.data
     };
 
     VkShaderModule shader_module;
     VkResult result = vkCreateShaderModule(g_vk_state.device, &create_info, NULL, &shader_module);
 
-    free(code);
+    poc_file_map_close(&code);
 
     if (result != VK_SUCCESS) {
         printf("Failed to create shader module from %s: %d\n", filename, result);
@@ -1616,9 +1705,10 @@ static poc_result create_graphics_pipeline(poc_context *ctx) {
     };
 
     // Create descriptor set layout for uniform buffer
+    // Dynamic, so one set per renderable can address each range's uniform slot
     VkDescriptorSetLayoutBinding ubo_layout_binding = {
         .binding = 0,
-        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
         .descriptorCount = 1,
         .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
         .pImmutableSamplers = NULL
@@ -1730,7 +1820,7 @@ static poc_result create_buffer(VkDeviceSize size, VkBufferUsageFlags usage,
 
 static poc_result create_descriptor_pool(poc_context *ctx) {
     VkDescriptorPoolSize pool_size = {
-        .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+        .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
         .descriptorCount = MAX_FRAMES_IN_FLIGHT
     };
 
@@ -1753,7 +1843,7 @@ static poc_result copy_buffer(VkBuffer src_buffer, VkBuffer dst_buffer, VkDevice
     VkCommandBufferAllocateInfo alloc_info = {
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
         .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-        .commandPool = ctx->command_pool,
+        .commandPool = ctx->upload_command_pool,
         .commandBufferCount = 1
     };
 
@@ -1782,10 +1872,12 @@ static poc_result copy_buffer(VkBuffer src_buffer, VkBuffer dst_buffer, VkDevice
         .pCommandBuffers = &command_buffer
     };
 
+    pthread_mutex_lock(&ctx->queue_mutex);
     vkQueueSubmit(g_vk_state.graphics_queue, 1, &submit_info, VK_NULL_HANDLE);
     vkQueueWaitIdle(g_vk_state.graphics_queue);
+    pthread_mutex_unlock(&ctx->queue_mutex);
 
-    vkFreeCommandBuffers(g_vk_state.device, ctx->command_pool, 1, &command_buffer);
+    vkFreeCommandBuffers(g_vk_state.device, ctx->upload_command_pool, 1, &command_buffer);
 
     return POC_RESULT_SUCCESS;
 }
@@ -1935,6 +2027,35 @@ static poc_result create_depth_resources(poc_context *ctx) {
     return POC_RESULT_SUCCESS;
 }
 
+// Give every object showing a reloaded mesh a fresh renderable. Setting the
+// mesh again retires the old buffers once the GPU is done with them, uploads
+// the new contents and refreshes the object's bounds.
+static uint32_t refresh_scene_mesh(poc_scene *scene, poc_mesh *mesh) {
+    uint32_t refreshed = 0;
+    for (uint32_t i = 0; scene && i < scene->object_count; i++) {
+        poc_scene_object *obj = scene->objects[i];
+        if (obj && obj->mesh == mesh) {
+            poc_scene_object_set_mesh(obj, mesh);
+            refreshed++;
+        }
+    }
+    return refreshed;
+}
+
+static void context_mesh_reloaded(poc_mesh *mesh, void *user_data) {
+    poc_context *ctx = user_data;
+    uint32_t refreshed = refresh_scene_mesh(ctx->edit_scene, mesh);
+    if (ctx->runtime_scene != ctx->edit_scene) {
+        refreshed += refresh_scene_mesh(ctx->runtime_scene, mesh);
+    }
+    if (ctx->active_scene != ctx->edit_scene && ctx->active_scene != ctx->runtime_scene) {
+        refreshed += refresh_scene_mesh(ctx->active_scene, mesh);
+    }
+    if (refreshed > 0) {
+        printf("✓ Re-uploaded %s for %u scene objects\n", poc_mesh_get_source_path(mesh), refreshed);
+    }
+}
+
 
 poc_context *vulkan_context_create(podi_window *window) {
     if (!window) {
@@ -1978,6 +2099,11 @@ poc_context *vulkan_context_create(podi_window *window) {
     }
 
     memset(ctx, 0, sizeof(poc_context));
+    pthread_mutex_init(&ctx->queue_mutex, NULL);
+    pthread_mutex_init(&ctx->retire_mutex, NULL);
+    atomic_init(&ctx->render_thread_active, false);
+    atomic_init(&ctx->snapshot_counter, 0);
+    atomic_init(&ctx->cluster_culling, true);
     ctx->vk = &g_vk_state;
     ctx->surface = surface;
     ctx->window = window;
@@ -1997,8 +2123,7 @@ poc_context *vulkan_context_create(podi_window *window) {
     ctx->runtime_scene = NULL;
     ctx->edit_scene = NULL;
     ctx->active_scene = NULL;
-    ctx->play_scene_cache_valid = false;
-    ctx->play_scene_cache_path[0] = '\0';
+    ctx->play_snapshot = NULL;
     ctx->has_camera_backup = false;
     ctx->has_window_backup = false;
     ctx->window_backup_width = 0;
@@ -2096,6 +2221,9 @@ poc_context *vulkan_context_create(podi_window *window) {
     // Initialize current frame
     ctx->current_frame = 0;
 
+    // Swap in meshes edited on disk while the context runs
+    poc_asset_add_reload_listener(context_mesh_reloaded, ctx);
+
     printf("✓ Vulkan context created successfully\n");
     return ctx;
 }
@@ -2111,15 +2239,15 @@ void vulkan_context_destroy(poc_context *ctx) {
 
     printf("=== Destroying Vulkan Context ===\n");
 
+    poc_asset_remove_reload_listener(context_mesh_reloaded, ctx);
+
     if (ctx->runtime_scene) {
         poc_scene_destroy(ctx->runtime_scene, true);
         ctx->runtime_scene = NULL;
     }
 
-    if (ctx->play_scene_cache_valid) {
-        unlink(ctx->play_scene_cache_path);
-        ctx->play_scene_cache_valid = false;
-    }
+    poc_scene_snapshot_destroy(ctx->play_snapshot);
+    ctx->play_snapshot = NULL;
 
     // Wait for device to be idle before cleanup
     if (g_vk_state.device != VK_NULL_HANDLE) {
@@ -2153,10 +2281,13 @@ void vulkan_context_destroy(poc_context *ctx) {
         }
     }
 
-    // Destroy command pool (this also frees command buffers)
+    // Destroy command pools (this also frees command buffers)
     if (ctx->command_pool != VK_NULL_HANDLE) {
         vkDestroyCommandPool(g_vk_state.device, ctx->command_pool, NULL);
     }
+    if (ctx->upload_command_pool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(g_vk_state.device, ctx->upload_command_pool, NULL);
+    }
 
     // Free command buffers array
     if (ctx->command_buffers) {
@@ -2189,27 +2320,8 @@ void vulkan_context_destroy(poc_context *ctx) {
         for (uint32_t i = 0; i < ctx->renderable_count; i++) {
             poc_renderable *renderable = ctx->renderables[i];
             if (renderable) {
-                // Destroy vertex buffer
-                if (renderable->vertex_buffer != VK_NULL_HANDLE) {
-                    vkDestroyBuffer(g_vk_state.device, renderable->vertex_buffer, NULL);
-                }
-                if (renderable->vertex_buffer_memory != VK_NULL_HANDLE) {
-                    vkFreeMemory(g_vk_state.device, renderable->vertex_buffer_memory, NULL);
-                }
-                // Destroy index buffer
-                if (renderable->index_buffer != VK_NULL_HANDLE) {
-                    vkDestroyBuffer(g_vk_state.device, renderable->index_buffer, NULL);
-                }
-                if (renderable->index_buffer_memory != VK_NULL_HANDLE) {
-                    vkFreeMemory(g_vk_state.device, renderable->index_buffer_memory, NULL);
-                }
-                // Destroy per-renderable uniform buffer
-                if (renderable->uniform_buffer != VK_NULL_HANDLE) {
-                    vkDestroyBuffer(g_vk_state.device, renderable->uniform_buffer, NULL);
-                }
-                if (renderable->uniform_buffer_memory != VK_NULL_HANDLE) {
-                    vkFreeMemory(g_vk_state.device, renderable->uniform_buffer_memory, NULL);
-                }
+                // Buffers are destroyed once per shared set
+                free_renderable_gpu(renderable->gpu);
                 free(renderable);
             }
         }
@@ -2259,6 +2371,14 @@ void vulkan_context_destroy(poc_context *ctx) {
         vkDestroySurfaceKHR(g_vk_state.instance, ctx->surface, NULL);
     }
 
+    // GPU resources still awaiting deferred destruction
+    for (uint32_t i = 0; i < ctx->retired_count; i++) {
+        free_renderable_gpu(ctx->retired_renderables[i].gpu);
+    }
+    free(ctx->retired_renderables);
+    pthread_mutex_destroy(&ctx->retire_mutex);
+    pthread_mutex_destroy(&ctx->queue_mutex);
+
     free(ctx);
     printf("✓ Vulkan context destroyed\n");
 }
@@ -2278,21 +2398,8 @@ void vulkan_context_set_camera(poc_context *ctx, poc_camera *camera) {
     printf("✓ Camera set on Vulkan context\n");
 }
 
-static void update_renderable_uniform_buffer(poc_renderable *renderable) {
-    if (!renderable || !renderable->uniform_buffer_mapped) {
-        return;
-    }
-
-    static float time = 0.0f;
-    time += 0.016f; // Approximate 60 FPS
-
-    UniformBufferObject ubo = {0};
-
-    // Model matrix from renderable
-    memcpy(ubo.model, renderable->model_matrix, sizeof(mat4));
-
-    // View and projection matrices from camera
-    poc_context *ctx = renderable->ctx;
+// Camera matrices in Vulkan clip space, with the hardcoded fallback camera
+static void compute_frame_camera(poc_context *ctx, mat4 view, mat4 proj, vec3 view_pos) {
     if (ctx->camera) {
         // Update camera matrices if dirty
         if (ctx->camera->matrices_dirty) {
@@ -2300,49 +2407,96 @@ static void update_renderable_uniform_buffer(poc_renderable *renderable) {
         }
 
         // Use camera matrices
-        memcpy(ubo.view, ctx->camera->view_matrix, sizeof(mat4));
-        memcpy(ubo.proj, ctx->camera->projection_matrix, sizeof(mat4));
+        glm_mat4_copy(ctx->camera->view_matrix, view);
+        glm_mat4_copy(ctx->camera->projection_matrix, proj);
+        glm_vec3_copy(ctx->camera->position, view_pos);
     } else {
         // Fallback to hardcoded camera if no camera is set
         vec3 eye = {0.0f, 2.0f, 6.0f};
         vec3 center = {0.0f, 0.0f, 0.0f};
         vec3 up = {0.0f, 1.0f, 0.0f};
-        glm_lookat(eye, center, up, ubo.view);
+        glm_lookat(eye, center, up, view);
 
         float aspect_ratio = (float)ctx->swapchain_extent.width / (float)ctx->swapchain_extent.height;
-        glm_perspective(glm_rad(45.0f), aspect_ratio, 0.1f, 10.0f, ubo.proj);
+        glm_perspective(glm_rad(45.0f), aspect_ratio, 0.1f, 10.0f, proj);
+        glm_vec3_copy(eye, view_pos);
     }
 
     // GLM was originally designed for OpenGL, where the Y coordinate of the clip coordinates is inverted
     // Since we're using Vulkan, we need to flip the Y coordinate of the projection matrix
-    ubo.proj[1][1] *= -1;
-
-    // Material properties
-    if (renderable->has_material) {
-        const poc_material *material = &renderable->material;
-        ubo.ambient_color[0] = material->ambient[0];
-        ubo.ambient_color[1] = material->ambient[1];
-        ubo.ambient_color[2] = material->ambient[2];
-        ubo.diffuse_color[0] = material->diffuse[0];
-        ubo.diffuse_color[1] = material->diffuse[1];
-        ubo.diffuse_color[2] = material->diffuse[2];
-        ubo.specular_color[0] = material->specular[0];
-        ubo.specular_color[1] = material->specular[1];
-        ubo.specular_color[2] = material->specular[2];
-        ubo.shininess = material->shininess;
-    } else {
-        // Default material
-        ubo.ambient_color[0] = 0.2f;
-        ubo.ambient_color[1] = 0.2f;
-        ubo.ambient_color[2] = 0.2f;
-        ubo.diffuse_color[0] = 0.8f;
-        ubo.diffuse_color[1] = 0.6f;
-        ubo.diffuse_color[2] = 0.4f;
-        ubo.specular_color[0] = 1.0f;
-        ubo.specular_color[1] = 1.0f;
-        ubo.specular_color[2] = 1.0f;
-        ubo.shininess = 32.0f;
+    proj[1][1] *= -1;
+}
+
+// Store camera and mode state shared by every renderable's UBO for this frame
+static void set_frame_uniforms(poc_context *ctx, mat4 view, mat4 proj, vec3 view_pos, bool play_mode) {
+    float play_flag = play_mode ? 1.0f : 0.0f;
+
+    bool changed = ctx->frame_globals_version == 0 ||
+                   memcmp(view, ctx->frame_view, sizeof(mat4)) != 0 ||
+                   memcmp(proj, ctx->frame_proj, sizeof(mat4)) != 0 ||
+                   memcmp(view_pos, ctx->frame_view_pos, sizeof(vec3)) != 0 ||
+                   play_flag != ctx->frame_play_flag;
+
+    if (changed) {
+        glm_mat4_copy(view, ctx->frame_view);
+        glm_mat4_copy(proj, ctx->frame_proj);
+        glm_mat4_mul(proj, view, ctx->frame_view_proj);
+        glm_vec3_copy(view_pos, ctx->frame_view_pos);
+        ctx->frame_play_flag = play_flag;
+        ctx->frame_globals_version++;
     }
+}
+
+static void refresh_frame_uniforms(poc_context *ctx) {
+    mat4 view, proj;
+    vec3 view_pos;
+
+    compute_frame_camera(ctx, view, proj, view_pos);
+    set_frame_uniforms(ctx, view, proj, view_pos, ctx->play_mode);
+}
+
+// Used for ranges whose mesh assigns no material
+static const poc_material default_material = {
+    .ambient = {0.2f, 0.2f, 0.2f},
+    .diffuse = {0.8f, 0.6f, 0.4f},
+    .specular = {1.0f, 1.0f, 1.0f},
+    .shininess = 32.0f,
+    .opacity = 1.0f,
+    .illum_model = 2,
+};
+
+static void set_ubo_material(UniformBufferObject *ubo, const poc_material *material) {
+    ubo->ambient_color[0] = material->ambient[0];
+    ubo->ambient_color[1] = material->ambient[1];
+    ubo->ambient_color[2] = material->ambient[2];
+    ubo->diffuse_color[0] = material->diffuse[0];
+    ubo->diffuse_color[1] = material->diffuse[1];
+    ubo->diffuse_color[2] = material->diffuse[2];
+    ubo->specular_color[0] = material->specular[0];
+    ubo->specular_color[1] = material->specular[1];
+    ubo->specular_color[2] = material->specular[2];
+    ubo->shininess = material->shininess;
+}
+
+static uint32_t renderable_slot_count(const poc_renderable_gpu *gpu) {
+    return gpu->range_count > 0 ? gpu->range_count : 1;
+}
+
+// Write every uniform slot from the given transform and per-slot materials
+// plus the frame state; never reads the poc_renderable, so the render thread
+// can build UBOs purely from a snapshot
+static void update_renderable_uniform_buffer(poc_context *ctx, poc_renderable_gpu *gpu, const mat4 model,
+                                             const poc_material *materials) {
+    if (!gpu->uniform_buffer_mapped) {
+        return;
+    }
+
+    UniformBufferObject ubo = {0};
+
+    // Model matrix from the caller, view and projection from the frame state
+    memcpy(ubo.model, model, sizeof(mat4));
+    memcpy(ubo.view, ctx->frame_view, sizeof(mat4));
+    memcpy(ubo.proj, ctx->frame_proj, sizeof(mat4));
 
     // Lighting
     ubo.light_pos[0] = 2.0f;
@@ -2350,24 +2504,23 @@ static void update_renderable_uniform_buffer(poc_renderable *renderable) {
     ubo.light_pos[2] = 2.0f;
 
     // Set view position from camera or fallback
-    if (ctx->camera) {
-        ubo.view_pos[0] = ctx->camera->position[0];
-        ubo.view_pos[1] = ctx->camera->position[1];
-        ubo.view_pos[2] = ctx->camera->position[2];
-    } else {
-        ubo.view_pos[0] = 0.0f;
-        ubo.view_pos[1] = 2.0f;
-        ubo.view_pos[2] = 6.0f;
-    }
+    ubo.view_pos[0] = ctx->frame_view_pos[0];
+    ubo.view_pos[1] = ctx->frame_view_pos[1];
+    ubo.view_pos[2] = ctx->frame_view_pos[2];
 
     // Encode play/edit mode flag for shader logic
-    ubo.render_params[0] = ctx->play_mode ? 1.0f : 0.0f;
+    ubo.render_params[0] = ctx->frame_play_flag;
     ubo.render_params[1] = 0.0f;
     ubo.render_params[2] = 0.0f;
     ubo.render_params[3] = 0.0f;
 
-    // Copy data to this renderable's uniform buffer
-    memcpy(renderable->uniform_buffer_mapped, &ubo, sizeof(ubo));
+    // Each range gets its own slot that differs only in material
+    for (uint32_t i = 0; i < renderable_slot_count(gpu); i++) {
+        set_ubo_material(&ubo, &materials[i]);
+        memcpy((char *)gpu->uniform_buffer_mapped + i * gpu->uniform_stride, &ubo, sizeof(ubo));
+    }
+    memcpy(gpu->uniform_model, model, sizeof(mat4));
+    gpu->uniform_globals_version = ctx->frame_globals_version;
 }
 
 // DEPRECATED: update_uniform_buffer function removed - uniform buffers are now updated per-renderable
@@ -2435,6 +2588,132 @@ static void render_title_bar_if_needed(poc_context *ctx, uint32_t image_index) {
 #endif
 }
 
+// Make the counts of the frame just recorded visible to other threads
+static void publish_frame_counts(poc_context *ctx) {
+    atomic_store_explicit(&ctx->draw_calls, ctx->frame_draw_calls, memory_order_relaxed);
+    atomic_store_explicit(&ctx->triangles_submitted, ctx->frame_triangles_submitted, memory_order_relaxed);
+    atomic_store_explicit(&ctx->triangles_total, ctx->frame_triangles_total, memory_order_relaxed);
+}
+
+// Record one renderable's draws from its GPU resources, the transform to draw
+// it with and one material per uniform slot
+static void record_renderable_draw(poc_context *ctx, VkCommandBuffer command_buffer, poc_renderable_gpu *gpu,
+                                   const mat4 model, const poc_material *materials) {
+    if (!gpu || gpu->vertex_buffer == VK_NULL_HANDLE || gpu->index_buffer == VK_NULL_HANDLE) {
+        return;
+    }
+
+    // Update uniform buffer only if the transform or the frame state changed
+    // since it was last written. Materials never change for a given gpu.
+    if (gpu->uniform_globals_version != ctx->frame_globals_version ||
+        memcmp(gpu->uniform_model, model, sizeof(mat4)) != 0) {
+        update_renderable_uniform_buffer(ctx, gpu, model, materials);
+    }
+
+    // Bind vertex and index buffers once; every range draws from them
+    VkBuffer vertex_buffers[] = {gpu->vertex_buffer};
+    VkDeviceSize offsets[] = {0};
+    vkCmdBindVertexBuffers(command_buffer, 0, 1, vertex_buffers, offsets);
+    vkCmdBindIndexBuffer(command_buffer, gpu->index_buffer, 0, VK_INDEX_TYPE_UINT32);
+
+    bool cull = gpu->cluster_count > 0 &&
+                atomic_load_explicit(&ctx->cluster_culling, memory_order_relaxed);
+    poc_cluster_view view;
+    if (cull) {
+        mat4 model_copy;
+        memcpy(model_copy, model, sizeof(mat4));
+        poc_cluster_view_init(&view, ctx->frame_view_proj, model_copy, ctx->frame_view_pos);
+    }
+
+    // Draw each range with its material's uniform slot
+    for (uint32_t i = 0; i < renderable_slot_count(gpu); i++) {
+        uint32_t dynamic_offset = (uint32_t)(i * gpu->uniform_stride);
+        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                               ctx->pipeline_layout, 0, 1, &gpu->descriptor_set, 1, &dynamic_offset);
+
+        if (gpu->range_count == 0) {
+            vkCmdDrawIndexed(command_buffer, gpu->index_count, 1, 0, 0, 0);
+            ctx->frame_draw_calls++;
+            ctx->frame_triangles_submitted += gpu->index_count / 3;
+            ctx->frame_triangles_total += gpu->index_count / 3;
+            continue;
+        }
+
+        const renderable_range *range = &gpu->ranges[i];
+        ctx->frame_triangles_total += range->index_count / 3;
+        if (!cull || range->cluster_count == 0) {
+            vkCmdDrawIndexed(command_buffer, range->index_count, 1, range->first_index, 0, 0);
+            ctx->frame_draw_calls++;
+            ctx->frame_triangles_submitted += range->index_count / 3;
+            continue;
+        }
+
+        // Visible clusters next to each other in the index buffer share a draw
+        uint32_t run_first = 0;
+        uint32_t run_count = 0;
+        for (uint32_t c = range->first_cluster; c < range->first_cluster + range->cluster_count; c++) {
+            const poc_mesh_cluster *cluster = &gpu->clusters[c];
+            if (poc_cluster_is_visible(&view, cluster)) {
+                if (run_count > 0 && run_first + run_count == cluster->index_offset) {
+                    run_count += cluster->index_count;
+                    continue;
+                }
+                if (run_count > 0) {
+                    vkCmdDrawIndexed(command_buffer, run_count, 1, run_first, 0, 0);
+                    ctx->frame_draw_calls++;
+                    ctx->frame_triangles_submitted += run_count / 3;
+                }
+                run_first = cluster->index_offset;
+                run_count = cluster->index_count;
+            }
+        }
+        if (run_count > 0) {
+            vkCmdDrawIndexed(command_buffer, run_count, 1, run_first, 0, 0);
+            ctx->frame_draw_calls++;
+            ctx->frame_triangles_submitted += run_count / 3;
+        }
+    }
+}
+
+// Draw a renderable with its own transform and materials (single-threaded
+// rendering only; the render thread goes through snapshots)
+static void record_renderable(poc_context *ctx, VkCommandBuffer command_buffer, poc_renderable *renderable) {
+    if (renderable && renderable->gpu) {
+        record_renderable_draw(ctx, command_buffer, renderable->gpu, renderable->model_matrix,
+                               renderable->gpu->materials);
+    }
+}
+
+// Render thread: draw exactly what the simulation captured, without touching
+// the scene, the camera or any poc_renderable
+static void record_snapshot_draws(poc_context *ctx, VkCommandBuffer command_buffer, const poc_render_snapshot *snapshot) {
+    mat4 view, proj;
+    vec3 view_pos;
+    memcpy(view, snapshot->view, sizeof(mat4));
+    memcpy(proj, snapshot->proj, sizeof(mat4));
+    memcpy(view_pos, snapshot->view_pos, sizeof(vec3));
+    set_frame_uniforms(ctx, view, proj, view_pos, snapshot->play_mode);
+
+    for (uint32_t i = 0; i < snapshot->item_count; i++) {
+        const poc_render_item *item = &snapshot->items[i];
+        record_renderable_draw(ctx, command_buffer, item->gpu, item->model,
+                               &snapshot->materials[item->first_material]);
+    }
+}
+
+// Copy an object's transform into its renderable unless it already holds
+// that generation. Comparing generations instead of walking the scene's
+// changed list keeps renderables current when something else consumed the
+// list first: the snapshot capture, or the application calling
+// poc_scene_update() itself.
+static void sync_renderable_transform(poc_scene_object *obj) {
+    poc_renderable *renderable = obj->renderable;
+    if (renderable && renderable->transform_generation != obj->transform_generation) {
+        glm_mat4_copy(obj->transform_matrix, renderable->model_matrix);
+        renderable->transform_generation = obj->transform_generation;
+    }
+}
+
 poc_result vulkan_context_begin_frame(poc_context *ctx) {
     if (!ctx) {
         return POC_RESULT_ERROR_INIT_FAILED;
@@ -2494,6 +2773,11 @@ poc_result vulkan_context_begin_frame(poc_context *ctx) {
         return POC_RESULT_ERROR_INIT_FAILED;
     }
 
+    // The snapshot carries the clear color requested by the simulation thread
+    if (ctx->frame_snapshot) {
+        memcpy(ctx->clear_color, ctx->frame_snapshot->clear_color, sizeof(ctx->clear_color));
+    }
+
     // Reset command buffer
     vkResetCommandBuffer(ctx->command_buffers[image_index], 0);
 
@@ -2581,13 +2865,26 @@ poc_result vulkan_context_begin_frame(poc_context *ctx) {
 #endif
 
     // Render objects - prioritize active scene if available
+    ctx->frame_draw_calls = 0;
+    ctx->frame_triangles_submitted = 0;
+    ctx->frame_triangles_total = 0;
     uint32_t render_count = 0;
     poc_renderable **render_list = NULL;
     bool *is_scene_temporary = NULL;
 
-    if (ctx->active_scene) {
-        // Use scene renderables
+    // Camera/mode state shared by all uniform buffers this frame; a snapshot
+    // brings its own
+    if (!ctx->frame_snapshot) {
+        refresh_frame_uniforms(ctx);
+    }
+
+    if (ctx->frame_snapshot) {
+        record_snapshot_draws(ctx, ctx->command_buffers[image_index], ctx->frame_snapshot);
+    } else if (ctx->active_scene) {
+        // Use scene renderables; their transforms are pushed as they are
+        // collected if they missed a rebuild
         poc_scene_update(ctx->active_scene);
+
         uint32_t scene_renderable_count;
         poc_scene_object **scene_objects = poc_scene_get_renderable_objects(ctx->active_scene, &scene_renderable_count);
 
@@ -2598,18 +2895,11 @@ poc_result vulkan_context_begin_frame(poc_context *ctx) {
             if (render_list && is_scene_temporary) {
                 for (uint32_t i = 0; i < scene_renderable_count; i++) {
                     poc_scene_object *obj = scene_objects[i];
-                    if (obj->renderable && obj->renderable->vertex_buffer != VK_NULL_HANDLE) {
+                    if (obj->renderable && obj->renderable->gpu) {
                         // Use scene object's own renderable
+                        sync_renderable_transform(obj);
                         render_list[render_count] = obj->renderable;
                         is_scene_temporary[render_count] = false;
-
-                        // Update transform
-                        const mat4 *transform = poc_scene_object_get_transform_matrix(obj);
-                        if (transform) {
-                            mat4 transform_copy;
-                            memcpy(transform_copy, *transform, sizeof(mat4));
-                            poc_renderable_set_transform(render_list[render_count], transform_copy);
-                        }
                         render_count++;
                     } else {
                         // Create temporary renderable
@@ -2640,26 +2930,7 @@ poc_result vulkan_context_begin_frame(poc_context *ctx) {
         }
 
         for (uint32_t i = 0; i < render_count; i++) {
-            poc_renderable *renderable = render_list[i];
-            if (!renderable || renderable->vertex_buffer == VK_NULL_HANDLE || renderable->index_buffer == VK_NULL_HANDLE) {
-                continue;
-            }
-
-            // Update uniform buffer for this renderable
-            update_renderable_uniform_buffer(renderable);
-
-            // Bind descriptor set for this renderable
-            vkCmdBindDescriptorSets(ctx->command_buffers[image_index], VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                   ctx->pipeline_layout, 0, 1, &renderable->descriptor_set, 0, NULL);
-
-            // Bind vertex and index buffers for this renderable
-            VkBuffer vertex_buffers[] = {renderable->vertex_buffer};
-            VkDeviceSize offsets[] = {0};
-            vkCmdBindVertexBuffers(ctx->command_buffers[image_index], 0, 1, vertex_buffers, offsets);
-            vkCmdBindIndexBuffer(ctx->command_buffers[image_index], renderable->index_buffer, 0, VK_INDEX_TYPE_UINT32);
-
-            // Draw this renderable
-            vkCmdDrawIndexed(ctx->command_buffers[image_index], renderable->index_count, 1, 0, 0, 0);
+            record_renderable(ctx, ctx->command_buffers[image_index], render_list[i]);
         }
     }
 
@@ -2673,6 +2944,7 @@ poc_result vulkan_context_begin_frame(poc_context *ctx) {
         free(render_list);
         free(is_scene_temporary);
     }
+    publish_frame_counts(ctx);
     // DEPRECATED: Removed fallback rendering code that used shared uniform buffers
     // All rendering now uses the per-renderable system
 
@@ -2717,7 +2989,12 @@ poc_result vulkan_context_end_frame(poc_context *ctx) {
     submit_info.signalSemaphoreCount = 1;
     submit_info.pSignalSemaphores = signal_semaphores;
 
-    VK_CHECK(vkQueueSubmit(g_vk_state.graphics_queue, 1, &submit_info, ctx->in_flight_fences[ctx->current_frame]));
+    pthread_mutex_lock(&ctx->queue_mutex);
+    VkResult submit_result = vkQueueSubmit(g_vk_state.graphics_queue, 1, &submit_info, ctx->in_flight_fences[ctx->current_frame]);
+    if (submit_result != VK_SUCCESS) {
+        pthread_mutex_unlock(&ctx->queue_mutex);
+        VK_CHECK(submit_result);
+    }
 
     // Present
     VkPresentInfoKHR present_info = {
@@ -2734,6 +3011,7 @@ poc_result vulkan_context_end_frame(poc_context *ctx) {
     present_info.pResults = NULL;
 
     VkResult result = vkQueuePresentKHR(g_vk_state.present_queue, &present_info);
+    pthread_mutex_unlock(&ctx->queue_mutex);
     if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
         poc_result recreate_result = recreate_swapchain(ctx);
         if (recreate_result != POC_RESULT_SUCCESS) {
@@ -2755,6 +3033,15 @@ void vulkan_context_clear_color(poc_context *ctx, float r, float g, float b, flo
         return;
     }
 
+    // The render thread owns clear_color; hand the value over via the next snapshot
+    if (atomic_load(&ctx->render_thread_active)) {
+        ctx->snapshot_clear_color[0] = r;
+        ctx->snapshot_clear_color[1] = g;
+        ctx->snapshot_clear_color[2] = b;
+        ctx->snapshot_clear_color[3] = a;
+        return;
+    }
+
     ctx->clear_color[0] = r;
     ctx->clear_color[1] = g;
     ctx->clear_color[2] = b;
@@ -2869,10 +3156,11 @@ poc_renderable *poc_context_create_renderable(poc_context *ctx, const char *name
 
     // Set name
     if (name) {
-        strncpy(renderable->name, name, sizeof(renderable->name) - 1);
-        renderable->name[sizeof(renderable->name) - 1] = '\0';
+        renderable->name = poc_string_intern(name);
     } else {
-        snprintf(renderable->name, sizeof(renderable->name), "Renderable_%u", ctx->renderable_count);
+        char default_name[32];
+        snprintf(default_name, sizeof(default_name), "Renderable_%u", ctx->renderable_count);
+        renderable->name = poc_string_intern(default_name);
     }
 
     // Initialize transform to identity matrix
@@ -2882,10 +3170,199 @@ poc_renderable *poc_context_create_renderable(poc_context *ctx, const char *name
     ctx->renderables[ctx->renderable_count] = renderable;
     ctx->renderable_count++;
 
-    printf("✓ Created renderable '%s'\n", renderable->name);
+    printf("✓ Created renderable '%s'\n", poc_string_get(renderable->name));
     return renderable;
 }
 
+poc_renderable *poc_context_clone_renderable(poc_context *ctx, const poc_renderable *source, const char *name) {
+    if (!ctx || !source) {
+        return NULL;
+    }
+
+    poc_renderable *clone = poc_context_create_renderable(ctx, name ? name : poc_string_get(source->name));
+    if (!clone) {
+        return NULL;
+    }
+    memcpy(clone->model_matrix, source->model_matrix, sizeof(mat4));
+    clone->transform_generation = source->transform_generation;
+
+    const poc_renderable_gpu *shared = source->gpu;
+    if (!shared) {
+        return clone;
+    }
+
+    // Own ranges, materials and uniforms; vertex/index buffers are shared
+    poc_renderable_gpu *gpu = calloc(1, sizeof(poc_renderable_gpu));
+    uint32_t slot_count = renderable_slot_count(shared);
+    if (gpu) {
+        gpu->ranges = shared->range_count > 0 ? malloc(shared->range_count * sizeof(renderable_range)) : NULL;
+        gpu->materials = malloc(slot_count * sizeof(poc_material));
+        gpu->clusters = shared->cluster_count > 0 ? malloc(shared->cluster_count * sizeof(poc_mesh_cluster)) : NULL;
+    }
+    if (!gpu || (shared->range_count > 0 && !gpu->ranges) || !gpu->materials ||
+        (shared->cluster_count > 0 && !gpu->clusters)) {
+        free_renderable_gpu(gpu);
+        poc_context_destroy_renderable(ctx, clone);
+        return NULL;
+    }
+
+    if (shared->range_count > 0) {
+        memcpy(gpu->ranges, shared->ranges, shared->range_count * sizeof(renderable_range));
+    }
+    gpu->range_count = shared->range_count;
+    memcpy(gpu->materials, shared->materials, slot_count * sizeof(poc_material));
+    if (shared->cluster_count > 0) {
+        memcpy(gpu->clusters, shared->clusters, shared->cluster_count * sizeof(poc_mesh_cluster));
+    }
+    gpu->cluster_count = shared->cluster_count;
+
+    atomic_fetch_add(shared->geometry_refs, 1);
+    gpu->geometry_refs = shared->geometry_refs;
+    gpu->vertex_buffer = shared->vertex_buffer;
+    gpu->vertex_buffer_memory = shared->vertex_buffer_memory;
+    gpu->index_buffer = shared->index_buffer;
+    gpu->index_buffer_memory = shared->index_buffer_memory;
+    gpu->vertex_count = shared->vertex_count;
+    gpu->index_count = shared->index_count;
+
+    if (create_renderable_uniforms(ctx, gpu) != POC_RESULT_SUCCESS) {
+        free_renderable_gpu(gpu);
+        poc_context_destroy_renderable(ctx, clone);
+        return NULL;
+    }
+    clone->gpu = gpu;
+
+    return clone;
+}
+
+// Drop this renderable's reference to its vertex/index buffers, destroying
+// them when no clone still uses them
+static void release_renderable_geometry(poc_renderable_gpu *gpu) {
+    if (gpu->geometry_refs) {
+        if (atomic_fetch_sub(gpu->geometry_refs, 1) != 1) {
+            gpu->geometry_refs = NULL;
+            gpu->vertex_buffer = VK_NULL_HANDLE;
+            gpu->vertex_buffer_memory = VK_NULL_HANDLE;
+            gpu->index_buffer = VK_NULL_HANDLE;
+            gpu->index_buffer_memory = VK_NULL_HANDLE;
+            return;
+        }
+        free(gpu->geometry_refs);
+        gpu->geometry_refs = NULL;
+    }
+
+    if (gpu->vertex_buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(g_vk_state.device, gpu->vertex_buffer, NULL);
+        gpu->vertex_buffer = VK_NULL_HANDLE;
+    }
+    if (gpu->vertex_buffer_memory != VK_NULL_HANDLE) {
+        vkFreeMemory(g_vk_state.device, gpu->vertex_buffer_memory, NULL);
+        gpu->vertex_buffer_memory = VK_NULL_HANDLE;
+    }
+    if (gpu->index_buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(g_vk_state.device, gpu->index_buffer, NULL);
+        gpu->index_buffer = VK_NULL_HANDLE;
+    }
+    if (gpu->index_buffer_memory != VK_NULL_HANDLE) {
+        vkFreeMemory(g_vk_state.device, gpu->index_buffer_memory, NULL);
+        gpu->index_buffer_memory = VK_NULL_HANDLE;
+    }
+}
+
+// Free GPU resources, including partially built ones (NULL is ignored)
+static void free_renderable_gpu(poc_renderable_gpu *gpu) {
+    if (!gpu) {
+        return;
+    }
+
+    release_renderable_geometry(gpu);
+
+    // Destroy per-renderable uniform buffer resources
+    if (gpu->uniform_buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(g_vk_state.device, gpu->uniform_buffer, NULL);
+    }
+    if (gpu->uniform_buffer_memory != VK_NULL_HANDLE) {
+        vkFreeMemory(g_vk_state.device, gpu->uniform_buffer_memory, NULL);
+    }
+    // Note: descriptor sets are automatically freed when the descriptor pool is destroyed
+    free(gpu->ranges);
+    free(gpu->materials);
+    free(gpu->clusters);
+    free(gpu);
+}
+
+// Queue GPU resources for destruction once no in-flight snapshot or frame uses them
+static void retire_renderable_gpu(poc_context *ctx, poc_renderable_gpu *gpu) {
+    pthread_mutex_lock(&ctx->retire_mutex);
+
+    if (ctx->retired_count >= ctx->retired_capacity) {
+        uint32_t new_capacity = ctx->retired_capacity == 0 ? 16 : ctx->retired_capacity * 2;
+        retired_renderable *new_retired = realloc(ctx->retired_renderables, sizeof(retired_renderable) * new_capacity);
+        if (!new_retired) {
+            // Leak rather than free something the GPU may still read
+            pthread_mutex_unlock(&ctx->retire_mutex);
+            printf("Warning: Failed to defer destruction of renderable GPU resources\n");
+            return;
+        }
+        ctx->retired_renderables = new_retired;
+        ctx->retired_capacity = new_capacity;
+    }
+
+    ctx->retired_renderables[ctx->retired_count++] = (retired_renderable){
+        .gpu = gpu,
+        .retire_after_snapshot = atomic_load(&ctx->snapshot_counter) + 1,
+        .safe_render_frame = 0
+    };
+
+    pthread_mutex_unlock(&ctx->retire_mutex);
+}
+
+// Release GPU resources a renderable no longer uses: immediately when
+// single-threaded, after the render thread is done with them otherwise
+static void discard_renderable_gpu(poc_context *ctx, poc_renderable_gpu *gpu) {
+    if (!gpu) {
+        return;
+    }
+    if (atomic_load(&ctx->render_thread_active)) {
+        retire_renderable_gpu(ctx, gpu);
+    } else {
+        free_renderable_gpu(gpu);
+    }
+}
+
+// Show new GPU resources, retiring the previous ones. A snapshot captured
+// before the swap keeps drawing the old resources until it is done.
+static void replace_renderable_gpu(poc_renderable *renderable, poc_renderable_gpu *gpu) {
+    poc_renderable_gpu *previous = renderable->gpu;
+    renderable->gpu = gpu;
+    discard_renderable_gpu(renderable->ctx, previous);
+}
+
+// Render thread: free retired GPU resources whose last use has left the GPU
+static void process_retired_renderables(poc_context *ctx, uint64_t drawn_snapshot) {
+    pthread_mutex_lock(&ctx->retire_mutex);
+
+    uint32_t i = 0;
+    while (i < ctx->retired_count) {
+        retired_renderable *entry = &ctx->retired_renderables[i];
+        if (entry->safe_render_frame == 0 && drawn_snapshot >= entry->retire_after_snapshot) {
+            entry->safe_render_frame = ctx->render_frame_counter;
+        }
+
+        // Frames submitted before safe_render_frame are fenced within
+        // MAX_FRAMES_IN_FLIGHT further frames
+        if (entry->safe_render_frame != 0 &&
+            ctx->render_frame_counter > entry->safe_render_frame + MAX_FRAMES_IN_FLIGHT) {
+            free_renderable_gpu(entry->gpu);
+            ctx->retired_renderables[i] = ctx->retired_renderables[--ctx->retired_count];
+        } else {
+            i++;
+        }
+    }
+
+    pthread_mutex_unlock(&ctx->retire_mutex);
+}
+
 void poc_context_destroy_renderable(poc_context *ctx, poc_renderable *renderable) {
     if (!ctx || !renderable) {
         return;
@@ -2905,74 +3382,25 @@ void poc_context_destroy_renderable(poc_context *ctx, poc_renderable *renderable
         return;
     }
 
-    // Destroy GPU resources
-    if (renderable->vertex_buffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(g_vk_state.device, renderable->vertex_buffer, NULL);
-    }
-    if (renderable->vertex_buffer_memory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_vk_state.device, renderable->vertex_buffer_memory, NULL);
-    }
-    if (renderable->index_buffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(g_vk_state.device, renderable->index_buffer, NULL);
-    }
-    if (renderable->index_buffer_memory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_vk_state.device, renderable->index_buffer_memory, NULL);
-    }
-
-    // Destroy per-renderable uniform buffer resources
-    if (renderable->uniform_buffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(g_vk_state.device, renderable->uniform_buffer, NULL);
-    }
-    if (renderable->uniform_buffer_memory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_vk_state.device, renderable->uniform_buffer_memory, NULL);
-    }
-    // Note: descriptor sets are automatically freed when the descriptor pool is destroyed
-
-    printf("✓ Destroyed renderable '%s'\n", renderable->name);
-    free(renderable);
-
     // Remove from array by shifting remaining elements
     for (uint32_t i = index; i < ctx->renderable_count - 1; i++) {
         ctx->renderables[i] = ctx->renderables[i + 1];
     }
     ctx->renderable_count--;
+
+    // Snapshots only reference the GPU resources, so the renderable itself
+    // can go right away
+    discard_renderable_gpu(ctx, renderable->gpu);
+    printf("✓ Destroyed renderable '%s'\n", poc_string_get(renderable->name));
+    free(renderable);
 }
 
-static poc_result create_renderable_buffers(poc_renderable *renderable, poc_vertex *vertices, uint32_t vertex_count, uint32_t *indices, uint32_t index_count) {
-    if (!renderable || !vertices || !indices || vertex_count == 0 || index_count == 0) {
+// Upload vertices and indices into new buffers of a freshly built gpu
+static poc_result create_renderable_buffers(poc_context *ctx, poc_renderable_gpu *gpu, poc_vertex *vertices, uint32_t vertex_count, uint32_t *indices, uint32_t index_count) {
+    if (!vertices || !indices || vertex_count == 0 || index_count == 0) {
         return POC_RESULT_ERROR_INIT_FAILED;
     }
 
-    // Clean up existing buffers if any
-    if (renderable->vertex_buffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(g_vk_state.device, renderable->vertex_buffer, NULL);
-        renderable->vertex_buffer = VK_NULL_HANDLE;
-    }
-    if (renderable->vertex_buffer_memory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_vk_state.device, renderable->vertex_buffer_memory, NULL);
-        renderable->vertex_buffer_memory = VK_NULL_HANDLE;
-    }
-    if (renderable->index_buffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(g_vk_state.device, renderable->index_buffer, NULL);
-        renderable->index_buffer = VK_NULL_HANDLE;
-    }
-    if (renderable->index_buffer_memory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_vk_state.device, renderable->index_buffer_memory, NULL);
-        renderable->index_buffer_memory = VK_NULL_HANDLE;
-    }
-    if (renderable->uniform_buffer != VK_NULL_HANDLE) {
-        if (renderable->uniform_buffer_mapped) {
-            vkUnmapMemory(g_vk_state.device, renderable->uniform_buffer_memory);
-            renderable->uniform_buffer_mapped = NULL;
-        }
-        vkDestroyBuffer(g_vk_state.device, renderable->uniform_buffer, NULL);
-        renderable->uniform_buffer = VK_NULL_HANDLE;
-    }
-    if (renderable->uniform_buffer_memory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_vk_state.device, renderable->uniform_buffer_memory, NULL);
-        renderable->uniform_buffer_memory = VK_NULL_HANDLE;
-    }
-
     // Create vertex buffer
     VkDeviceSize vertex_buffer_size = sizeof(poc_vertex) * vertex_count;
     VkBuffer staging_buffer;
@@ -3014,9 +3442,9 @@ static poc_result create_renderable_buffers(poc_renderable *renderable, poc_vert
         .sharingMode = VK_SHARING_MODE_EXCLUSIVE
     };
 
-    VK_CHECK(vkCreateBuffer(g_vk_state.device, &vertex_buffer_info, NULL, &renderable->vertex_buffer));
+    VK_CHECK(vkCreateBuffer(g_vk_state.device, &vertex_buffer_info, NULL, &gpu->vertex_buffer));
 
-    vkGetBufferMemoryRequirements(g_vk_state.device, renderable->vertex_buffer, &mem_requirements);
+    vkGetBufferMemoryRequirements(g_vk_state.device, gpu->vertex_buffer, &mem_requirements);
 
     VkMemoryAllocateInfo vertex_alloc_info = {
         .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
@@ -3024,11 +3452,11 @@ static poc_result create_renderable_buffers(poc_renderable *renderable, poc_vert
         .memoryTypeIndex = find_memory_type(mem_requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
     };
 
-    VK_CHECK(vkAllocateMemory(g_vk_state.device, &vertex_alloc_info, NULL, &renderable->vertex_buffer_memory));
-    vkBindBufferMemory(g_vk_state.device, renderable->vertex_buffer, renderable->vertex_buffer_memory, 0);
+    VK_CHECK(vkAllocateMemory(g_vk_state.device, &vertex_alloc_info, NULL, &gpu->vertex_buffer_memory));
+    vkBindBufferMemory(g_vk_state.device, gpu->vertex_buffer, gpu->vertex_buffer_memory, 0);
 
     // Copy from staging buffer to vertex buffer
-    poc_result copy_result = copy_buffer(staging_buffer, renderable->vertex_buffer, vertex_buffer_size, renderable->ctx);
+    poc_result copy_result = copy_buffer(staging_buffer, gpu->vertex_buffer, vertex_buffer_size, ctx);
     if (copy_result != POC_RESULT_SUCCESS) {
         vkDestroyBuffer(g_vk_state.device, staging_buffer, NULL);
         vkFreeMemory(g_vk_state.device, staging_buffer_memory, NULL);
@@ -3076,9 +3504,9 @@ static poc_result create_renderable_buffers(poc_renderable *renderable, poc_vert
         .sharingMode = VK_SHARING_MODE_EXCLUSIVE
     };
 
-    VK_CHECK(vkCreateBuffer(g_vk_state.device, &index_buffer_info, NULL, &renderable->index_buffer));
+    VK_CHECK(vkCreateBuffer(g_vk_state.device, &index_buffer_info, NULL, &gpu->index_buffer));
 
-    vkGetBufferMemoryRequirements(g_vk_state.device, renderable->index_buffer, &mem_requirements);
+    vkGetBufferMemoryRequirements(g_vk_state.device, gpu->index_buffer, &mem_requirements);
 
     VkMemoryAllocateInfo index_alloc_info = {
         .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
@@ -3086,11 +3514,11 @@ static poc_result create_renderable_buffers(poc_renderable *renderable, poc_vert
         .memoryTypeIndex = find_memory_type(mem_requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
     };
 
-    VK_CHECK(vkAllocateMemory(g_vk_state.device, &index_alloc_info, NULL, &renderable->index_buffer_memory));
-    vkBindBufferMemory(g_vk_state.device, renderable->index_buffer, renderable->index_buffer_memory, 0);
+    VK_CHECK(vkAllocateMemory(g_vk_state.device, &index_alloc_info, NULL, &gpu->index_buffer_memory));
+    vkBindBufferMemory(g_vk_state.device, gpu->index_buffer, gpu->index_buffer_memory, 0);
 
     // Copy from staging buffer to index buffer
-    copy_result = copy_buffer(staging_buffer, renderable->index_buffer, index_buffer_size, renderable->ctx);
+    copy_result = copy_buffer(staging_buffer, gpu->index_buffer, index_buffer_size, ctx);
     if (copy_result != POC_RESULT_SUCCESS) {
         vkDestroyBuffer(g_vk_state.device, staging_buffer, NULL);
         vkFreeMemory(g_vk_state.device, staging_buffer_memory, NULL);
@@ -3102,11 +3530,26 @@ static poc_result create_renderable_buffers(poc_renderable *renderable, poc_vert
     vkFreeMemory(g_vk_state.device, staging_buffer_memory, NULL);
 
     // Store counts
-    renderable->vertex_count = vertex_count;
-    renderable->index_count = index_count;
+    gpu->vertex_count = vertex_count;
+    gpu->index_count = index_count;
 
-    // Create uniform buffer for this renderable
-    VkDeviceSize uniform_buffer_size = sizeof(UniformBufferObject);
+    gpu->geometry_refs = malloc(sizeof(atomic_uint));
+    if (!gpu->geometry_refs) {
+        return POC_RESULT_ERROR_INIT_FAILED;
+    }
+    atomic_init(gpu->geometry_refs, 1);
+
+    return create_renderable_uniforms(ctx, gpu);
+}
+
+// Create the per-renderable uniform buffer and descriptor set
+static poc_result create_renderable_uniforms(poc_context *ctx, poc_renderable_gpu *gpu) {
+    VkMemoryRequirements mem_requirements;
+
+    // One uniform slot per range, aligned for use as a dynamic offset
+    VkDeviceSize alignment = g_vk_state.min_uniform_alignment > 0 ? g_vk_state.min_uniform_alignment : 1;
+    gpu->uniform_stride = (sizeof(UniformBufferObject) + alignment - 1) / alignment * alignment;
+    VkDeviceSize uniform_buffer_size = gpu->uniform_stride * renderable_slot_count(gpu);
 
     VkBufferCreateInfo uniform_buffer_info = {
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
@@ -3115,9 +3558,9 @@ static poc_result create_renderable_buffers(poc_renderable *renderable, poc_vert
         .sharingMode = VK_SHARING_MODE_EXCLUSIVE
     };
 
-    VK_CHECK(vkCreateBuffer(g_vk_state.device, &uniform_buffer_info, NULL, &renderable->uniform_buffer));
+    VK_CHECK(vkCreateBuffer(g_vk_state.device, &uniform_buffer_info, NULL, &gpu->uniform_buffer));
 
-    vkGetBufferMemoryRequirements(g_vk_state.device, renderable->uniform_buffer, &mem_requirements);
+    vkGetBufferMemoryRequirements(g_vk_state.device, gpu->uniform_buffer, &mem_requirements);
 
     VkMemoryAllocateInfo uniform_alloc_info = {
         .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
@@ -3126,21 +3569,21 @@ static poc_result create_renderable_buffers(poc_renderable *renderable, poc_vert
                                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
     };
 
-    VK_CHECK(vkAllocateMemory(g_vk_state.device, &uniform_alloc_info, NULL, &renderable->uniform_buffer_memory));
-    vkBindBufferMemory(g_vk_state.device, renderable->uniform_buffer, renderable->uniform_buffer_memory, 0);
+    VK_CHECK(vkAllocateMemory(g_vk_state.device, &uniform_alloc_info, NULL, &gpu->uniform_buffer_memory));
+    vkBindBufferMemory(g_vk_state.device, gpu->uniform_buffer, gpu->uniform_buffer_memory, 0);
 
     // Map the uniform buffer memory for persistent mapping
-    VK_CHECK(vkMapMemory(g_vk_state.device, renderable->uniform_buffer_memory, 0, uniform_buffer_size, 0, &renderable->uniform_buffer_mapped));
+    VK_CHECK(vkMapMemory(g_vk_state.device, gpu->uniform_buffer_memory, 0, uniform_buffer_size, 0, &gpu->uniform_buffer_mapped));
 
     // Allocate descriptor set for this renderable
     VkDescriptorSetAllocateInfo desc_alloc_info = {
         .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-        .descriptorPool = renderable->ctx->descriptor_pool,
+        .descriptorPool = ctx->descriptor_pool,
         .descriptorSetCount = 1,
-        .pSetLayouts = &renderable->ctx->descriptor_set_layout
+        .pSetLayouts = &ctx->descriptor_set_layout
     };
 
-    VkResult desc_result = vkAllocateDescriptorSets(g_vk_state.device, &desc_alloc_info, &renderable->descriptor_set);
+    VkResult desc_result = vkAllocateDescriptorSets(g_vk_state.device, &desc_alloc_info, &gpu->descriptor_set);
     if (desc_result != VK_SUCCESS) {
         printf("Failed to allocate descriptor set for renderable: %d\n", desc_result);
         return POC_RESULT_ERROR_INIT_FAILED;
@@ -3148,17 +3591,17 @@ static poc_result create_renderable_buffers(poc_renderable *renderable, poc_vert
 
     // Update descriptor set to point to this renderable's uniform buffer
     VkDescriptorBufferInfo buffer_info = {
-        .buffer = renderable->uniform_buffer,
+        .buffer = gpu->uniform_buffer,
         .offset = 0,
         .range = sizeof(UniformBufferObject)
     };
 
     VkWriteDescriptorSet descriptor_write = {
         .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-        .dstSet = renderable->descriptor_set,
+        .dstSet = gpu->descriptor_set,
         .dstBinding = 0,
         .dstArrayElement = 0,
-        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
         .descriptorCount = 1,
         .pBufferInfo = &buffer_info
     };
@@ -3168,62 +3611,104 @@ static poc_result create_renderable_buffers(poc_renderable *renderable, poc_vert
     return POC_RESULT_SUCCESS;
 }
 
-poc_result poc_renderable_load_model(poc_renderable *renderable, const char *obj_filename) {
-    if (!renderable || !obj_filename) {
+// Copy the mesh's submesh ranges, their materials and the culling clusters
+// into a new gpu
+static poc_result set_renderable_ranges(poc_renderable_gpu *gpu, const poc_mesh *mesh) {
+    uint32_t count = poc_mesh_get_submesh_count(mesh);
+    renderable_range *ranges = count > 0 ? calloc(count, sizeof(renderable_range)) : NULL;
+    poc_material *materials = malloc((count > 0 ? count : 1) * sizeof(poc_material));
+    poc_mesh_cluster *clusters = mesh->cluster_count > 0 ? malloc(mesh->cluster_count * sizeof(poc_mesh_cluster)) : NULL;
+    if ((count > 0 && !ranges) || !materials || (mesh->cluster_count > 0 && !clusters)) {
+        free(ranges);
+        free(materials);
+        free(clusters);
         return POC_RESULT_ERROR_INIT_FAILED;
     }
-
-    printf("Loading model '%s' into renderable '%s'\n", obj_filename, renderable->name);
-
-    poc_model model;
-    poc_obj_result obj_result = poc_model_load(obj_filename, &model);
-    if (obj_result != POC_OBJ_RESULT_SUCCESS) {
-        printf("Failed to load OBJ file %s: %s\n", obj_filename, poc_obj_result_to_string(obj_result));
-        return POC_RESULT_ERROR_INIT_FAILED;
+    if (clusters) {
+        memcpy(clusters, mesh->clusters, mesh->cluster_count * sizeof(poc_mesh_cluster));
     }
+    materials[0] = default_material;
 
-    printf("✓ OBJ file loaded: %u objects, %u materials\n", model.object_count, model.material_count);
+    // Clusters are in index order and never cross a submesh, so each range
+    // owns the run of clusters that starts inside it
+    uint32_t cluster = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        poc_submesh submesh;
+        const poc_material *material;
+        poc_mesh_get_submesh(mesh, i, &submesh, &material);
+        ranges[i].first_index = submesh.index_offset;
+        ranges[i].index_count = submesh.index_count;
+        materials[i] = material ? *material : default_material;
 
-    // Find the first non-empty group in any object
-    poc_mesh_group *group = NULL;
-    for (uint32_t obj_idx = 0; obj_idx < model.object_count && !group; obj_idx++) {
-        for (uint32_t grp_idx = 0; grp_idx < model.objects[obj_idx].group_count; grp_idx++) {
-            if (model.objects[obj_idx].groups[grp_idx].vertex_count > 0) {
-                group = &model.objects[obj_idx].groups[grp_idx];
-                break;
-            }
+        while (cluster < mesh->cluster_count && clusters[cluster].index_offset < submesh.index_offset) {
+            cluster++;
+        }
+        ranges[i].first_cluster = cluster;
+        while (cluster < mesh->cluster_count &&
+               clusters[cluster].index_offset < submesh.index_offset + submesh.index_count) {
+            cluster++;
         }
+        ranges[i].cluster_count = cluster - ranges[i].first_cluster;
     }
 
-    if (!group) {
-        printf("Warning: No geometry found in OBJ file\n");
-        poc_model_destroy(&model);
-        return POC_RESULT_ERROR_INIT_FAILED;
+    gpu->ranges = ranges;
+    gpu->range_count = count;
+    gpu->materials = materials;
+    gpu->clusters = clusters;
+    gpu->cluster_count = clusters ? mesh->cluster_count : 0;
+    return POC_RESULT_SUCCESS;
+}
+
+// Build GPU resources for a mesh whose geometry is resident
+static poc_renderable_gpu *create_renderable_gpu(poc_context *ctx, const poc_mesh *mesh) {
+    poc_renderable_gpu *gpu = calloc(1, sizeof(poc_renderable_gpu));
+    if (!gpu) {
+        return NULL;
     }
 
-    // Create GPU buffers for the renderable
-    poc_result result = create_renderable_buffers(renderable, group->vertices, group->vertex_count, group->indices, group->index_count);
+    // Ranges decide how many uniform slots the buffers below get
+    poc_result result = set_renderable_ranges(gpu, mesh);
+    if (result == POC_RESULT_SUCCESS) {
+        result = create_renderable_buffers(ctx, gpu, mesh->vertices, mesh->vertex_count,
+                                           mesh->indices, mesh->index_count);
+    }
     if (result != POC_RESULT_SUCCESS) {
-        poc_model_destroy(&model);
-        return result;
+        free_renderable_gpu(gpu);
+        return NULL;
     }
+    return gpu;
+}
 
-    // Copy material if available
-    if (group->material_index < model.material_count) {
-        renderable->material = model.materials[group->material_index];
-        renderable->has_material = true;
-        printf("✓ Material loaded: %s\n", renderable->material.name);
-    } else {
-        // Use default material
-        renderable->has_material = false;
-        printf("Using default material\n");
+poc_result poc_renderable_load_model(poc_renderable *renderable, const char *obj_filename) {
+    if (!renderable || !obj_filename) {
+        return POC_RESULT_ERROR_INIT_FAILED;
     }
 
-    poc_model_destroy(&model);
-    printf("✓ Model loaded into renderable '%s': %u vertices, %u indices\n",
-           renderable->name, renderable->vertex_count, renderable->index_count);
+    printf("Loading model '%s' into renderable '%s'\n", obj_filename, poc_string_get(renderable->name));
 
-    return POC_RESULT_SUCCESS;
+    // Go through the asset manager so every group is packed into one buffer
+    // pair and a file already loaded elsewhere is not parsed again
+    poc_mesh *mesh = poc_asset_acquire_mesh(obj_filename);
+    if (!mesh) {
+        printf("Failed to load OBJ file %s\n", obj_filename);
+        return POC_RESULT_ERROR_INIT_FAILED;
+    }
+
+    poc_result result = poc_renderable_load_mesh(renderable, mesh);
+    poc_asset_release_mesh(mesh);
+    return result;
+}
+
+const char *poc_renderable_get_name(const poc_renderable *renderable) {
+    return renderable ? poc_string_get(renderable->name) : "";
+}
+
+void poc_renderable_get_transform(const poc_renderable *renderable, mat4 transform) {
+    if (!renderable) {
+        glm_mat4_identity(transform);
+        return;
+    }
+    memcpy(transform, renderable->model_matrix, sizeof(mat4));
 }
 
 poc_result poc_renderable_load_mesh(poc_renderable *renderable, poc_mesh *mesh) {
@@ -3231,7 +3716,7 @@ poc_result poc_renderable_load_mesh(poc_renderable *renderable, poc_mesh *mesh)
         return POC_RESULT_ERROR_INIT_FAILED;
     }
 
-    printf("Loading mesh into renderable '%s'\n", renderable->name);
+    printf("Loading mesh into renderable '%s'\n", poc_string_get(renderable->name));
 
     // Validate mesh
     if (!poc_mesh_is_valid(mesh)) {
@@ -3239,26 +3724,27 @@ poc_result poc_renderable_load_mesh(poc_renderable *renderable, poc_mesh *mesh)
         return POC_RESULT_ERROR_INIT_FAILED;
     }
 
-    // Create GPU buffers for the renderable
-    poc_result result = create_renderable_buffers(renderable, mesh->vertices, mesh->vertex_count,
-                                                  mesh->indices, mesh->index_count);
-    if (result != POC_RESULT_SUCCESS) {
-        return result;
+    if (!poc_mesh_restore_geometry(mesh)) {
+        printf("Could not map released geometry of '%s' again\n", poc_mesh_get_source_path(mesh));
+        return POC_RESULT_ERROR_INIT_FAILED;
     }
 
-    // Copy material if available from mesh
-    if (mesh->has_material) {
-        renderable->material = mesh->material;
-        renderable->has_material = true;
-        printf("✓ Material loaded: %s\n", renderable->material.name);
-    } else {
-        // Use default material
-        renderable->has_material = false;
-        printf("Using default material for mesh renderable\n");
+    // Build the new resources next to the old ones, which a snapshot being
+    // drawn may still use, then retire the old ones
+    poc_renderable_gpu *gpu = create_renderable_gpu(renderable->ctx, mesh);
+    if (!gpu) {
+        return POC_RESULT_ERROR_INIT_FAILED;
     }
+    replace_renderable_gpu(renderable, gpu);
 
-    printf("✓ Mesh loaded into renderable '%s': %u vertices, %u indices\n",
-           renderable->name, renderable->vertex_count, renderable->index_count);
+    // The GPU has its copy; keep only bounds and submesh tables on the CPU
+    if (poc_mesh_get_release_after_upload()) {
+        poc_mesh_release_geometry(mesh);
+    }
+
+    printf("✓ Mesh loaded into renderable '%s': %u vertices, %u indices, %u draw ranges, %u culling clusters\n",
+           poc_string_get(renderable->name), gpu->vertex_count, gpu->index_count,
+           gpu->range_count, gpu->cluster_count);
 
     return POC_RESULT_SUCCESS;
 }
@@ -3294,11 +3780,10 @@ static poc_renderable* create_renderable_from_scene_object(poc_context *ctx, poc
         return NULL;
     }
 
-    // Set vertex data directly from the mesh
-    poc_result result = create_renderable_buffers(renderable, mesh->vertices, mesh->vertex_count,
-                                                  mesh->indices, mesh->index_count);
-    if (result != POC_RESULT_SUCCESS) {
-        printf("Failed to create vertex data for scene object %u: %s\n", obj->id, poc_result_to_string(result));
+    // Set vertex data and material ranges directly from the mesh
+    renderable->gpu = poc_mesh_restore_geometry(mesh) ? create_renderable_gpu(ctx, mesh) : NULL;
+    if (!renderable->gpu) {
+        printf("Failed to create vertex data for scene object %u\n", obj->id);
         poc_context_destroy_renderable(ctx, renderable);
         return NULL;
     }
@@ -3335,7 +3820,7 @@ poc_result vulkan_context_render_scene(poc_context *ctx, poc_scene *scene) {
         return POC_RESULT_ERROR_INIT_FAILED;
     }
 
-    // Update all scene objects to ensure transforms and bounds are current
+    // Update changed scene objects; transforms are pushed as renderables are collected
     poc_scene_update(scene);
 
     // Get renderable objects from the scene
@@ -3363,15 +3848,9 @@ poc_result vulkan_context_render_scene(poc_context *ctx, poc_scene *scene) {
         bool temp = false;
 
         // Use scene object's own renderable if it exists and has valid buffers
-        if (obj->renderable && obj->renderable->vertex_buffer != VK_NULL_HANDLE) {
+        if (obj->renderable && obj->renderable->gpu) {
+            sync_renderable_transform(obj);
             renderable = obj->renderable;
-            // Update transform in case it changed
-            const mat4 *transform = poc_scene_object_get_transform_matrix(obj);
-            if (transform) {
-                mat4 transform_copy;
-                memcpy(transform_copy, *transform, sizeof(mat4));
-                poc_renderable_set_transform(renderable, transform_copy);
-            }
             temp = false;
         } else {
             // Fall back to creating temporary renderable
@@ -3406,27 +3885,9 @@ poc_result vulkan_context_render_scene(poc_context *ctx, poc_scene *scene) {
     uint32_t image_index = ctx->current_image_index;
 
     for (uint32_t i = 0; i < valid_renderables; i++) {
-        poc_renderable *renderable = scene_renderables[i];
-        if (!renderable || renderable->vertex_buffer == VK_NULL_HANDLE || renderable->index_buffer == VK_NULL_HANDLE) {
-            continue;
-        }
-
-        // Update uniform buffer for this renderable
-        update_renderable_uniform_buffer(renderable);
-
-        // Bind descriptor set for this renderable
-        vkCmdBindDescriptorSets(ctx->command_buffers[image_index], VK_PIPELINE_BIND_POINT_GRAPHICS,
-                               ctx->pipeline_layout, 0, 1, &renderable->descriptor_set, 0, NULL);
-
-        // Bind vertex and index buffers for this renderable
-        VkBuffer vertex_buffers[] = {renderable->vertex_buffer};
-        VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers(ctx->command_buffers[image_index], 0, 1, vertex_buffers, offsets);
-        vkCmdBindIndexBuffer(ctx->command_buffers[image_index], renderable->index_buffer, 0, VK_INDEX_TYPE_UINT32);
-
-        // Draw this renderable
-        vkCmdDrawIndexed(ctx->command_buffers[image_index], renderable->index_count, 1, 0, 0, 0);
+        record_renderable(ctx, ctx->command_buffers[image_index], scene_renderables[i]);
     }
+    publish_frame_counts(ctx);
 
     // Restore original renderables
     ctx->renderables = old_renderables;
@@ -3444,33 +3905,6 @@ poc_result vulkan_context_render_scene(poc_context *ctx, poc_scene *scene) {
     return POC_RESULT_SUCCESS;
 }
 
-static bool create_scene_cache(poc_context *ctx) {
-    if (!ctx || !ctx->edit_scene) {
-        printf("[playmode] create_scene_cache: missing context or edit scene\n");
-        return false;
-    }
-
-    char template_path[] = "/tmp/poc_scene_cacheXXXXXX";
-    int fd = mkstemp(template_path);
-    if (fd == -1) {
-        printf("Failed to create temporary scene cache: %s\n", strerror(errno));
-        return false;
-    }
-    close(fd);
-
-    if (!poc_scene_save_to_file(ctx->edit_scene, template_path)) {
-        printf("Failed to write scene cache to '%s'\n", template_path);
-        unlink(template_path);
-        return false;
-    }
-
-    strncpy(ctx->play_scene_cache_path, template_path, sizeof(ctx->play_scene_cache_path) - 1);
-    ctx->play_scene_cache_path[sizeof(ctx->play_scene_cache_path) - 1] = '\0';
-    ctx->play_scene_cache_valid = true;
-    printf("[playmode] Scene cache created at '%s'\n", ctx->play_scene_cache_path);
-    return true;
-}
-
 void vulkan_context_set_play_mode(poc_context *ctx, bool enabled) {
     if (!ctx) {
         return;
@@ -3508,34 +3942,27 @@ void vulkan_context_set_play_mode(poc_context *ctx, bool enabled) {
             printf("[playmode] Discarded previous runtime scene\n");
         }
 
-        if (ctx->play_scene_cache_valid) {
-            unlink(ctx->play_scene_cache_path);
-            ctx->play_scene_cache_valid = false;
-            printf("[playmode] Removed stale scene cache\n");
-        }
-
-        if (!create_scene_cache(ctx)) {
-            if (ctx->window) {
-                podi_window_set_fullscreen_exclusive(ctx->window, false);
-                printf("[playmode] fullscreen_exclusive -> disabled (cache failure)\n");
-            }
-            printf("[playmode] Failed to create scene cache; aborting play mode enter\n");
-            return;
-        }
+        poc_scene_snapshot_destroy(ctx->play_snapshot);
+        double start_time = poc_get_time();
 
-        ctx->runtime_scene = poc_scene_load_from_file(ctx->play_scene_cache_path);
+        // Snapshot the edit scene in memory; the runtime copy shares its meshes
+        // and GPU buffers instead of re-reading and re-uploading them
+        ctx->play_snapshot = poc_scene_snapshot_capture(ctx->edit_scene);
+        ctx->runtime_scene = ctx->play_snapshot ? poc_scene_snapshot_instantiate(ctx->play_snapshot) : NULL;
         if (!ctx->runtime_scene) {
-            printf("Failed to load runtime scene from cache '%s'\n", ctx->play_scene_cache_path);
-            unlink(ctx->play_scene_cache_path);
-            ctx->play_scene_cache_valid = false;
-            ctx->play_scene_cache_path[0] = '\0';
+            printf("Failed to create runtime scene from edit scene snapshot\n");
+            poc_scene_snapshot_destroy(ctx->play_snapshot);
+            ctx->play_snapshot = NULL;
             if (ctx->window) {
                 podi_window_set_fullscreen_exclusive(ctx->window, false);
-                printf("[playmode] fullscreen_exclusive -> disabled (load failure)\n");
+                printf("[playmode] fullscreen_exclusive -> disabled (snapshot failure)\n");
             }
             return;
         }
 
+        printf("[playmode] Runtime scene created from snapshot (%u objects, %.2f ms)\n",
+               ctx->runtime_scene->object_count, (poc_get_time() - start_time) * 1000.0);
+
         if (ctx->camera) {
             ctx->camera_backup = *ctx->camera;
             ctx->has_camera_backup = true;
@@ -3548,7 +3975,7 @@ void vulkan_context_set_play_mode(poc_context *ctx, bool enabled) {
 
         ctx->active_scene = ctx->runtime_scene;
         ctx->play_mode = true;
-        printf("[playmode] Entered play mode with runtime scene from cache\n");
+        printf("[playmode] Entered play mode with runtime scene from snapshot\n");
     } else {
         if (ctx->window) {
             podi_window_set_fullscreen_exclusive(ctx->window, false);
@@ -3561,29 +3988,17 @@ void vulkan_context_set_play_mode(poc_context *ctx, bool enabled) {
             printf("[playmode] Destroyed runtime scene on exit\n");
         }
 
-        if (ctx->play_scene_cache_valid && ctx->edit_scene) {
-            poc_scene *restored = poc_scene_load_from_file(ctx->play_scene_cache_path);
-            if (restored) {
-                if (!poc_scene_copy_from(ctx->edit_scene, restored)) {
-                    printf("Failed to restore edit scene after play mode\n");
-                } else {
-                    printf("[playmode] Restored edit scene from cache\n");
-                }
-
-                for (uint32_t i = 0; i < restored->mesh_asset_count; i++) {
-                    restored->mesh_assets[i].owned = false;
-                }
-
-                poc_scene_destroy(restored, true);
+        if (ctx->play_snapshot && ctx->edit_scene) {
+            double start_time = poc_get_time();
+            if (!poc_scene_snapshot_restore(ctx->edit_scene, ctx->play_snapshot)) {
+                printf("Failed to restore edit scene after play mode\n");
             } else {
-                printf("Failed to reload scene cache '%s'\n", ctx->play_scene_cache_path);
+                printf("[playmode] Restored edit scene from snapshot (%.2f ms)\n",
+                       (poc_get_time() - start_time) * 1000.0);
             }
-
-            unlink(ctx->play_scene_cache_path);
-            ctx->play_scene_cache_valid = false;
-            ctx->play_scene_cache_path[0] = '\0';
-            printf("[playmode] Cleared scene cache file\n");
         }
+        poc_scene_snapshot_destroy(ctx->play_snapshot);
+        ctx->play_snapshot = NULL;
 
         if (ctx->has_camera_backup && ctx->camera) {
             printf("[playmode] Restoring camera backup (pos %.2f %.2f %.2f)\n",
@@ -3611,6 +4026,133 @@ void vulkan_context_set_play_mode(poc_context *ctx, bool enabled) {
     }
 }
 
+poc_result vulkan_context_capture_snapshot(poc_context *ctx, poc_render_snapshot *snapshot) {
+    if (!ctx || !snapshot) {
+        return POC_RESULT_ERROR_INIT_FAILED;
+    }
+
+    snapshot->item_count = 0;
+    snapshot->material_count = 0;
+
+    if (ctx->active_scene) {
+        poc_scene_update(ctx->active_scene);
+
+        uint32_t object_count;
+        poc_scene_object **objects = poc_scene_get_renderable_objects(ctx->active_scene, &object_count);
+
+        if (object_count > snapshot->item_capacity) {
+            uint32_t new_capacity = snapshot->item_capacity == 0 ? 16 : snapshot->item_capacity;
+            while (new_capacity < object_count) {
+                new_capacity *= 2;
+            }
+            poc_render_item *new_items = realloc(snapshot->items, sizeof(poc_render_item) * new_capacity);
+            if (!new_items) {
+                printf("Failed to grow render snapshot to %u items\n", new_capacity);
+                return POC_RESULT_ERROR_OUT_OF_MEMORY;
+            }
+            snapshot->items = new_items;
+            snapshot->item_capacity = new_capacity;
+        }
+
+        // Objects without uploaded GPU buffers are skipped; temporary
+        // renderables cannot be created from the render thread. The item
+        // references the renderable's current GPU resources, which stay
+        // alive until this snapshot is drawn even if the mesh is replaced.
+        for (uint32_t i = 0; i < object_count; i++) {
+            poc_scene_object *obj = objects[i];
+            if (!obj->renderable || !obj->renderable->gpu) {
+                continue;
+            }
+
+            poc_renderable_gpu *gpu = obj->renderable->gpu;
+            uint32_t slot_count = renderable_slot_count(gpu);
+            if (snapshot->material_count + slot_count > snapshot->material_capacity) {
+                uint32_t new_capacity = snapshot->material_capacity == 0 ? 16 : snapshot->material_capacity;
+                while (new_capacity < snapshot->material_count + slot_count) {
+                    new_capacity *= 2;
+                }
+                poc_material *new_materials = realloc(snapshot->materials, sizeof(poc_material) * new_capacity);
+                if (!new_materials) {
+                    printf("Failed to grow render snapshot to %u materials\n", new_capacity);
+                    return POC_RESULT_ERROR_OUT_OF_MEMORY;
+                }
+                snapshot->materials = new_materials;
+                snapshot->material_capacity = new_capacity;
+            }
+
+            poc_render_item *item = &snapshot->items[snapshot->item_count++];
+            item->gpu = gpu;
+            item->object_id = obj->id;
+            item->first_material = snapshot->material_count;
+            item->material_count = slot_count;
+            memcpy(item->model, obj->transform_matrix, sizeof(mat4));
+            memcpy(&snapshot->materials[snapshot->material_count], gpu->materials, slot_count * sizeof(poc_material));
+            snapshot->material_count += slot_count;
+        }
+    }
+
+    // Keep the camera aspect in step with the window, which the render thread
+    // resizes the swapchain to
+    if (ctx->camera) {
+        int width, height;
+        podi_window_get_framebuffer_size(ctx->window, &width, &height);
+        if (width > 0 && height > 0) {
+            poc_camera_set_aspect_ratio(ctx->camera, (float)width / (float)height);
+        }
+    }
+
+    compute_frame_camera(ctx, snapshot->view, snapshot->proj, snapshot->view_pos);
+    memcpy(snapshot->clear_color, ctx->snapshot_clear_color, sizeof(snapshot->clear_color));
+    snapshot->play_mode = ctx->play_mode;
+    snapshot->frame = atomic_fetch_add(&ctx->snapshot_counter, 1) + 1;
+
+    return POC_RESULT_SUCCESS;
+}
+
+poc_result vulkan_context_draw_snapshot(poc_context *ctx, const poc_render_snapshot *snapshot) {
+    if (!ctx || !snapshot) {
+        return POC_RESULT_ERROR_INIT_FAILED;
+    }
+
+    ctx->frame_snapshot = snapshot;
+    poc_result result = vulkan_context_begin_frame(ctx);
+    if (result == POC_RESULT_SUCCESS) {
+        result = vulkan_context_end_frame(ctx);
+    }
+    ctx->frame_snapshot = NULL;
+
+    ctx->render_frame_counter++;
+    process_retired_renderables(ctx, snapshot->frame);
+
+    return result;
+}
+
+void vulkan_context_set_threaded(poc_context *ctx, bool threaded) {
+    if (!ctx) {
+        return;
+    }
+
+    if (threaded) {
+        memcpy(ctx->snapshot_clear_color, ctx->clear_color, sizeof(ctx->clear_color));
+        atomic_store(&ctx->render_thread_active, true);
+        return;
+    }
+
+    atomic_store(&ctx->render_thread_active, false);
+
+    // The render thread has stopped; once the GPU is idle all deferred GPU
+    // resources can go
+    device_wait_idle_locked(ctx);
+    pthread_mutex_lock(&ctx->retire_mutex);
+    for (uint32_t i = 0; i < ctx->retired_count; i++) {
+        free_renderable_gpu(ctx->retired_renderables[i].gpu);
+    }
+    ctx->retired_count = 0;
+    pthread_mutex_unlock(&ctx->retire_mutex);
+
+    memcpy(ctx->clear_color, ctx->snapshot_clear_color, sizeof(ctx->clear_color));
+}
+
 bool vulkan_context_is_play_mode(const poc_context *ctx) {
     if (!ctx) {
         return false;
@@ -3619,4 +4161,29 @@ bool vulkan_context_is_play_mode(const poc_context *ctx) {
     return ctx->play_mode;
 }
 
+uint32_t vulkan_context_get_draw_call_count(const poc_context *ctx) {
+    if (!ctx) {
+        return 0;
+    }
+
+    return atomic_load_explicit(&ctx->draw_calls, memory_order_relaxed);
+}
+
+void vulkan_context_set_cluster_culling(poc_context *ctx, bool enabled) {
+    if (!ctx) {
+        return;
+    }
+
+    atomic_store_explicit(&ctx->cluster_culling, enabled, memory_order_relaxed);
+}
+
+void vulkan_context_get_triangle_counts(const poc_context *ctx, uint64_t *submitted, uint64_t *total) {
+    if (submitted) {
+        *submitted = ctx ? atomic_load_explicit(&ctx->triangles_submitted, memory_order_relaxed) : 0;
+    }
+    if (total) {
+        *total = ctx ? atomic_load_explicit(&ctx->triangles_total, memory_order_relaxed) : 0;
+    }
+}
+
 #endif
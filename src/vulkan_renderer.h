@@ -18,6 +18,7 @@
 #include "poc_engine.h"
 #include "obj_loader.h"
 #include "camera.h"
+#include "frame_loop.h"
 
 #ifdef POC_PLATFORM_LINUX
 
@@ -196,4 +197,40 @@ void vulkan_context_set_play_mode(poc_context *ctx, bool enabled);
  */
 bool vulkan_context_is_play_mode(const poc_context *ctx);
 
+/**
+ * @brief Number of draw calls recorded for the last frame.
+ */
+uint32_t vulkan_context_get_draw_call_count(const poc_context *ctx);
+
+/**
+ * @brief Enable or disable per-cluster culling of meshes.
+ */
+void vulkan_context_set_cluster_culling(poc_context *ctx, bool enabled);
+
+/**
+ * @brief Triangles drawn after cluster culling and triangles in every drawn renderable, for the last frame.
+ */
+void vulkan_context_get_triangle_counts(const poc_context *ctx, uint64_t *submitted, uint64_t *total);
+
+/**
+ * @brief Capture the active scene and camera into a render snapshot
+ *
+ * @note This is an internal function - use poc_context_capture_snapshot() instead.
+ */
+poc_result vulkan_context_capture_snapshot(poc_context *ctx, poc_render_snapshot *snapshot);
+
+/**
+ * @brief Draw one frame from a render snapshot on the render thread
+ *
+ * @note This is an internal function - use poc_context_draw_snapshot() instead.
+ */
+poc_result vulkan_context_draw_snapshot(poc_context *ctx, const poc_render_snapshot *snapshot);
+
+/**
+ * @brief Enable or disable render-thread operation for a context
+ *
+ * @note This is an internal function - use poc_context_set_threaded() instead.
+ */
+void vulkan_context_set_threaded(poc_context *ctx, bool threaded);
+
 #endif
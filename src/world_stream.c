@@ -0,0 +1,706 @@
+#define _POSIX_C_SOURCE 200809L
+#include "world_stream.h"
+#include "scene.h"
+#include "scene_object.h"
+#include "scene_file.h"
+#include "mesh.h"
+#include "job_system.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define CELL_TABLE_EMPTY UINT32_MAX
+
+typedef enum {
+    CELL_UNLOADED = 0,
+    CELL_LOADING,       // Background job reading records and meshes
+    CELL_LOADED,        // Job finished; waiting for integration
+    CELL_INTEGRATING,   // Objects being created across updates
+    CELL_RESIDENT,      // Objects are in the scene
+} cell_state;
+
+typedef struct {
+    poc_string_id path;
+    poc_mesh *mesh;
+    uint32_t ref_count;
+    uint64_t bytes;
+} stream_mesh;
+
+typedef struct world_cell {
+    poc_scene_file_cell file;
+    poc_world_stream *stream;
+    atomic_int state;
+
+    // Filled by the load job
+    poc_scene_file_records records; // Objects and prefab overrides of the cell
+    poc_mesh **record_meshes;       // One acquired mesh reference per record (or NULL)
+    uint32_t record_count;
+
+    // Filled during integration
+    poc_scene_object **objects;
+    uint32_t integrated_count;
+
+    uint32_t active_slot;           // Index in the stream's active list
+} world_cell;
+
+struct poc_world_stream {
+    char *path;
+    poc_scene *scene;
+    poc_world_stream_config config;
+    float cell_size;
+
+    world_cell *cells;
+    uint32_t cell_count;
+
+    // Open-addressed (x, z) -> cell index lookup
+    uint32_t *cell_table;
+    uint32_t cell_table_mask;
+
+    // Cells in any state other than CELL_UNLOADED
+    uint32_t *active_cells;
+    uint32_t active_count;
+
+    // Meshes shared between cells, keyed by path. The stream holds one asset
+    // manager reference per entry and purges after dropping the last one, so
+    // evictions give memory back under the budget
+    pthread_mutex_t mesh_mutex;
+    stream_mesh *meshes;
+    uint32_t mesh_count;
+    uint32_t mesh_capacity;
+    atomic_uint_fast64_t resident_bytes;
+    bool purge_pending;
+
+    poc_job_counter jobs;
+    uint32_t loads_in_flight;
+
+    // Statistics
+    uint64_t cells_evicted;
+    uint32_t objects_resident;
+    double last_update_ms;
+    double max_update_ms;
+};
+
+void poc_world_stream_config_defaults(poc_world_stream_config *config) {
+    if (!config) {
+        return;
+    }
+
+    config->load_radius = 100.0f;
+    config->unload_radius = 130.0f;
+    config->memory_budget_bytes = 512ull * 1024ull * 1024ull;
+    config->max_loads_in_flight = 4;
+    config->integrate_budget_ms = 2.0;
+}
+
+static uint32_t cell_hash(int32_t x, int32_t z) {
+    return ((uint32_t)x * 73856093u) ^ ((uint32_t)z * 19349663u);
+}
+
+static world_cell *find_cell(poc_world_stream *stream, int32_t x, int32_t z) {
+    uint32_t slot = cell_hash(x, z) & stream->cell_table_mask;
+    while (stream->cell_table[slot] != CELL_TABLE_EMPTY) {
+        world_cell *cell = &stream->cells[stream->cell_table[slot]];
+        if (cell->file.x == x && cell->file.z == z) {
+            return cell;
+        }
+        slot = (slot + 1) & stream->cell_table_mask;
+    }
+    return NULL;
+}
+
+// XZ distance from a point to the nearest point of a cell
+static float cell_distance(const poc_world_stream *stream, const world_cell *cell, const vec3 position) {
+    float min_x = (float)cell->file.x * stream->cell_size;
+    float min_z = (float)cell->file.z * stream->cell_size;
+    float dx = fmaxf(fmaxf(min_x - position[0], 0.0f), position[0] - (min_x + stream->cell_size));
+    float dz = fmaxf(fmaxf(min_z - position[2], 0.0f), position[2] - (min_z + stream->cell_size));
+    return sqrtf(dx * dx + dz * dz);
+}
+
+static uint64_t mesh_bytes(const poc_mesh *mesh) {
+    return (uint64_t)mesh->vertex_count * sizeof(poc_vertex) + (uint64_t)mesh->index_count * sizeof(uint32_t);
+}
+
+// Worker or owner thread: take a reference to a mesh, loading it on first use
+static poc_mesh *acquire_mesh(poc_world_stream *stream, const char *path) {
+    poc_string_id path_id = poc_string_intern(path);
+
+    pthread_mutex_lock(&stream->mesh_mutex);
+    for (uint32_t i = 0; i < stream->mesh_count; i++) {
+        if (stream->meshes[i].path == path_id) {
+            stream->meshes[i].ref_count++;
+            pthread_mutex_unlock(&stream->mesh_mutex);
+            return stream->meshes[i].mesh;
+        }
+    }
+    pthread_mutex_unlock(&stream->mesh_mutex);
+
+    // Load outside the lock so other cells keep streaming
+    poc_mesh *mesh = poc_asset_acquire_mesh(path);
+    if (!mesh) {
+        printf("⚠ World stream failed to load mesh '%s'\n", path);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&stream->mesh_mutex);
+
+    // Another cell may have loaded the same mesh meanwhile
+    for (uint32_t i = 0; i < stream->mesh_count; i++) {
+        if (stream->meshes[i].path == path_id) {
+            stream->meshes[i].ref_count++;
+            poc_mesh *existing = stream->meshes[i].mesh;
+            pthread_mutex_unlock(&stream->mesh_mutex);
+            poc_asset_release_mesh(mesh);
+            return existing;
+        }
+    }
+
+    if (stream->mesh_count >= stream->mesh_capacity) {
+        uint32_t new_capacity = stream->mesh_capacity == 0 ? 16 : stream->mesh_capacity * 2;
+        stream_mesh *new_meshes = realloc(stream->meshes, sizeof(stream_mesh) * new_capacity);
+        if (!new_meshes) {
+            pthread_mutex_unlock(&stream->mesh_mutex);
+            poc_asset_release_mesh(mesh);
+            return NULL;
+        }
+        stream->meshes = new_meshes;
+        stream->mesh_capacity = new_capacity;
+    }
+
+    stream_mesh *entry = &stream->meshes[stream->mesh_count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->path = path_id;
+    entry->mesh = mesh;
+    entry->ref_count = 1;
+    entry->bytes = mesh_bytes(mesh);
+    atomic_fetch_add(&stream->resident_bytes, entry->bytes);
+
+    pthread_mutex_unlock(&stream->mesh_mutex);
+    return mesh;
+}
+
+static void release_mesh(poc_world_stream *stream, poc_mesh *mesh) {
+    if (!mesh) {
+        return;
+    }
+
+    poc_mesh *to_release = NULL;
+
+    pthread_mutex_lock(&stream->mesh_mutex);
+    for (uint32_t i = 0; i < stream->mesh_count; i++) {
+        stream_mesh *entry = &stream->meshes[i];
+        if (entry->mesh != mesh) {
+            continue;
+        }
+
+        if (--entry->ref_count == 0) {
+            atomic_fetch_sub(&stream->resident_bytes, entry->bytes);
+            to_release = entry->mesh;
+            stream->meshes[i] = stream->meshes[--stream->mesh_count];
+        }
+        break;
+    }
+    pthread_mutex_unlock(&stream->mesh_mutex);
+
+    if (to_release) {
+        poc_asset_release_mesh(to_release);
+        stream->purge_pending = true;
+    }
+}
+
+static void load_cell_job(void *user_data) {
+    world_cell *cell = user_data;
+    poc_world_stream *stream = cell->stream;
+
+    poc_scene_file_records records;
+    if (poc_scene_file_read_cell(stream->path, &cell->file, &records) && records.count > 0) {
+        cell->record_meshes = calloc(records.count, sizeof(poc_mesh *));
+        if (cell->record_meshes) {
+            for (uint32_t i = 0; i < records.count; i++) {
+                if (records.objects[i].mesh_path[0] != '\0') {
+                    cell->record_meshes[i] = acquire_mesh(stream, records.objects[i].mesh_path);
+                }
+            }
+            cell->records = records;
+            cell->record_count = records.count;
+        } else {
+            poc_scene_file_records_free(&records);
+        }
+    } else {
+        poc_scene_file_records_free(&records);
+    }
+
+    // Publishes records and meshes to the owning thread
+    atomic_store_explicit(&cell->state, CELL_LOADED, memory_order_release);
+}
+
+static void activate_cell(poc_world_stream *stream, world_cell *cell) {
+    cell->active_slot = stream->active_count;
+    stream->active_cells[stream->active_count++] = (uint32_t)(cell - stream->cells);
+}
+
+static void deactivate_cell(poc_world_stream *stream, world_cell *cell) {
+    uint32_t slot = cell->active_slot;
+    uint32_t last = stream->active_cells[--stream->active_count];
+    stream->active_cells[slot] = last;
+    stream->cells[last].active_slot = slot;
+    atomic_store_explicit(&cell->state, CELL_UNLOADED, memory_order_relaxed);
+}
+
+// Drop a loaded, integrating or resident cell and everything it holds
+static void unload_cell(poc_world_stream *stream, world_cell *cell) {
+    int state = atomic_load_explicit(&cell->state, memory_order_acquire);
+    bool was_visible = state == CELL_RESIDENT || cell->integrated_count > 0;
+
+    if (cell->objects) {
+        if (state == CELL_RESIDENT) {
+            poc_scene_remove_objects(stream->scene, cell->objects, cell->integrated_count);
+            stream->objects_resident -= cell->integrated_count;
+        }
+        for (uint32_t i = 0; i < cell->integrated_count; i++) {
+            poc_scene_object_destroy(cell->objects[i]);
+        }
+        free(cell->objects);
+        cell->objects = NULL;
+    }
+    cell->integrated_count = 0;
+
+    if (cell->record_meshes) {
+        for (uint32_t i = 0; i < cell->record_count; i++) {
+            release_mesh(stream, cell->record_meshes[i]);
+        }
+        free(cell->record_meshes);
+        cell->record_meshes = NULL;
+    }
+
+    poc_scene_file_records_free(&cell->records);
+    cell->record_count = 0;
+
+    if (was_visible) {
+        stream->cells_evicted++;
+    }
+
+    deactivate_cell(stream, cell);
+}
+
+typedef struct {
+    uint32_t id;
+    uint32_t index;
+} id_entry;
+
+static int compare_id_entry(const void *a, const void *b) {
+    const id_entry *lhs = a;
+    const id_entry *rhs = b;
+    return lhs->id < rhs->id ? -1 : (lhs->id > rhs->id ? 1 : 0);
+}
+
+// Restore parent links within the cell (hierarchies never span cells)
+static void bind_cell_parents(world_cell *cell) {
+    id_entry *ids = malloc(sizeof(id_entry) * cell->record_count);
+    if (!ids) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < cell->record_count; i++) {
+        ids[i].id = cell->records.objects[i].id;
+        ids[i].index = i;
+    }
+    qsort(ids, cell->record_count, sizeof(id_entry), compare_id_entry);
+
+    for (uint32_t i = 0; i < cell->record_count; i++) {
+        if (cell->records.objects[i].parent_id == 0) {
+            continue;
+        }
+
+        id_entry key = { .id = cell->records.objects[i].parent_id };
+        id_entry *parent = bsearch(&key, ids, cell->record_count, sizeof(id_entry), compare_id_entry);
+        if (parent) {
+            poc_scene_object_add_child(cell->objects[parent->index], cell->objects[i]);
+        }
+    }
+
+    free(ids);
+}
+
+// Create objects (and upload their meshes) until the deadline; the cell joins
+// the scene only once every record has been handled. A record that cannot be
+// instantiated is logged and skipped, leaving a NULL slot, so one bad record
+// cannot keep the cell integrating forever.
+static bool integrate_cell(poc_world_stream *stream, world_cell *cell, double deadline) {
+    if (!cell->objects && cell->record_count > 0) {
+        cell->objects = calloc(cell->record_count, sizeof(poc_scene_object *));
+        if (!cell->objects) {
+            printf("⚠ Out of memory integrating world cell (%d, %d); retrying next update\n",
+                   cell->file.x, cell->file.z);
+            return false;
+        }
+    }
+
+    while (cell->integrated_count < cell->record_count) {
+        const poc_scene_file_object *record = &cell->records.objects[cell->integrated_count];
+        poc_scene_object *obj = poc_scene_file_object_instantiate(record);
+        if (obj) {
+            poc_mesh *mesh = cell->record_meshes[cell->integrated_count];
+            if (mesh) {
+                poc_scene_object_set_mesh(obj, mesh);
+            }
+            // Prefab instances take their node overrides while still collapsed
+            if (obj->prefab_instance && !poc_scene_file_records_apply_overrides(&cell->records, obj)) {
+                printf("⚠ Failed to apply prefab overrides of '%s' (id %u) in world cell (%d, %d)\n",
+                       record->name, record->id, cell->file.x, cell->file.z);
+            }
+        } else {
+            printf("⚠ Skipping object '%s' (id %u) in world cell (%d, %d): could not be created\n",
+                   record->name, record->id, cell->file.x, cell->file.z);
+        }
+
+        cell->objects[cell->integrated_count++] = obj;
+
+        if (poc_get_time() >= deadline) {
+            break;
+        }
+    }
+
+    if (cell->integrated_count < cell->record_count) {
+        return false;
+    }
+
+    // Children of a skipped parent stay at the root
+    bind_cell_parents(cell);
+
+    // Keep only objects the scene accepted, so the cell owns and counts
+    // exactly what it will later remove
+    uint32_t resident = 0;
+    for (uint32_t i = 0; i < cell->integrated_count; i++) {
+        poc_scene_object *obj = cell->objects[i];
+        if (!obj) {
+            continue;
+        }
+        if (!poc_scene_add_object(stream->scene, obj)) {
+            printf("⚠ Dropping object '%s' from world cell (%d, %d): scene is out of memory\n",
+                   poc_scene_object_get_name(obj), cell->file.x, cell->file.z);
+            poc_scene_object_destroy(obj);
+            continue;
+        }
+        cell->objects[resident++] = obj;
+    }
+    cell->integrated_count = resident;
+    stream->objects_resident += resident;
+
+    // Records are no longer needed once the objects exist
+    poc_scene_file_records_free(&cell->records);
+
+    atomic_store_explicit(&cell->state, CELL_RESIDENT, memory_order_relaxed);
+    return true;
+}
+
+typedef struct {
+    world_cell *cell;
+    float distance;
+} cell_candidate;
+
+static int compare_candidate_near_first(const void *a, const void *b) {
+    const cell_candidate *lhs = a;
+    const cell_candidate *rhs = b;
+    return lhs->distance < rhs->distance ? -1 : (lhs->distance > rhs->distance ? 1 : 0);
+}
+
+static int compare_candidate_far_first(const void *a, const void *b) {
+    return compare_candidate_near_first(b, a);
+}
+
+poc_world_stream *poc_world_stream_open(const char *path, poc_scene *scene, const poc_world_stream_config *config) {
+    if (!path || !scene) {
+        return NULL;
+    }
+
+    poc_scene_file_index index;
+    if (!poc_scene_file_read_index(path, &index)) {
+        return NULL;
+    }
+
+    poc_world_stream *stream = malloc(sizeof(poc_world_stream));
+    if (!stream) {
+        poc_scene_file_index_free(&index);
+        return NULL;
+    }
+
+    memset(stream, 0, sizeof(poc_world_stream));
+    stream->scene = scene;
+    stream->cell_size = index.cell_size;
+    stream->cell_count = index.cell_count;
+    pthread_mutex_init(&stream->mesh_mutex, NULL);
+    atomic_init(&stream->resident_bytes, 0);
+    atomic_init(&stream->jobs.pending, 0);
+
+    if (config) {
+        stream->config = *config;
+    } else {
+        poc_world_stream_config_defaults(&stream->config);
+    }
+    if (stream->config.unload_radius < stream->config.load_radius) {
+        stream->config.unload_radius = stream->config.load_radius;
+    }
+    if (stream->config.max_loads_in_flight == 0) {
+        stream->config.max_loads_in_flight = 1;
+    }
+
+    uint32_t table_size = 16;
+    while (table_size < stream->cell_count * 2) {
+        table_size *= 2;
+    }
+
+    stream->path = strdup(path);
+    stream->cells = calloc(stream->cell_count > 0 ? stream->cell_count : 1, sizeof(world_cell));
+    stream->active_cells = malloc(sizeof(uint32_t) * (stream->cell_count > 0 ? stream->cell_count : 1));
+    stream->cell_table = malloc(sizeof(uint32_t) * table_size);
+    if (!stream->path || !stream->cells || !stream->active_cells || !stream->cell_table) {
+        printf("Failed to allocate world stream for '%s'\n", path);
+        poc_scene_file_index_free(&index);
+        poc_world_stream_close(stream);
+        return NULL;
+    }
+
+    stream->cell_table_mask = table_size - 1;
+    memset(stream->cell_table, 0xFF, sizeof(uint32_t) * table_size);
+
+    for (uint32_t i = 0; i < stream->cell_count; i++) {
+        world_cell *cell = &stream->cells[i];
+        cell->file = index.cells[i];
+        cell->stream = stream;
+        atomic_init(&cell->state, CELL_UNLOADED);
+
+        uint32_t slot = cell_hash(cell->file.x, cell->file.z) & stream->cell_table_mask;
+        while (stream->cell_table[slot] != CELL_TABLE_EMPTY) {
+            slot = (slot + 1) & stream->cell_table_mask;
+        }
+        stream->cell_table[slot] = i;
+    }
+
+    // Streamed objects keep their file IDs; keep new IDs clear of them
+    if (index.next_id > scene->next_object_id) {
+        scene->next_object_id = index.next_id;
+    }
+
+    printf("✓ World stream opened '%s' (%u cells of %.1f units)\n", path, stream->cell_count, stream->cell_size);
+    poc_scene_file_index_free(&index);
+    return stream;
+}
+
+void poc_world_stream_close(poc_world_stream *stream) {
+    if (!stream) {
+        return;
+    }
+
+    // Let in-flight loads finish before tearing down what they write to
+    poc_job_wait(&stream->jobs);
+
+    while (stream->active_count > 0) {
+        world_cell *cell = &stream->cells[stream->active_cells[stream->active_count - 1]];
+        unload_cell(stream, cell);
+    }
+    if (stream->purge_pending) {
+        poc_asset_purge();
+    }
+
+    free(stream->meshes);
+    free(stream->cell_table);
+    free(stream->active_cells);
+    free(stream->cells);
+    free(stream->path);
+    pthread_mutex_destroy(&stream->mesh_mutex);
+    free(stream);
+}
+
+static void request_cells(poc_world_stream *stream, const vec3 camera_position) {
+    uint64_t budget = stream->config.memory_budget_bytes;
+    if (stream->loads_in_flight >= stream->config.max_loads_in_flight ||
+        (budget > 0 && atomic_load(&stream->resident_bytes) >= budget)) {
+        return;
+    }
+
+    float radius = stream->config.load_radius;
+    int32_t min_x = (int32_t)floorf((camera_position[0] - radius) / stream->cell_size);
+    int32_t max_x = (int32_t)floorf((camera_position[0] + radius) / stream->cell_size);
+    int32_t min_z = (int32_t)floorf((camera_position[2] - radius) / stream->cell_size);
+    int32_t max_z = (int32_t)floorf((camera_position[2] + radius) / stream->cell_size);
+
+    cell_candidate candidates[64];
+    uint32_t candidate_count = 0;
+    uint32_t candidate_limit = sizeof(candidates) / sizeof(candidates[0]);
+
+    // Probe only the grid squares the radius covers, unless that is more
+    // work than walking every cell of a small world
+    uint64_t probe_count = (uint64_t)(max_x - min_x + 1) * (uint64_t)(max_z - min_z + 1);
+    if (probe_count > stream->cell_count) {
+        for (uint32_t i = 0; i < stream->cell_count && candidate_count < candidate_limit; i++) {
+            world_cell *cell = &stream->cells[i];
+            float distance = cell_distance(stream, cell, camera_position);
+            if (atomic_load_explicit(&cell->state, memory_order_relaxed) == CELL_UNLOADED && distance <= radius) {
+                candidates[candidate_count++] = (cell_candidate){ cell, distance };
+            }
+        }
+    } else {
+        for (int32_t z = min_z; z <= max_z; z++) {
+            for (int32_t x = min_x; x <= max_x && candidate_count < candidate_limit; x++) {
+                world_cell *cell = find_cell(stream, x, z);
+                if (!cell || atomic_load_explicit(&cell->state, memory_order_relaxed) != CELL_UNLOADED) {
+                    continue;
+                }
+                float distance = cell_distance(stream, cell, camera_position);
+                if (distance <= radius) {
+                    candidates[candidate_count++] = (cell_candidate){ cell, distance };
+                }
+            }
+        }
+    }
+
+    qsort(candidates, candidate_count, sizeof(cell_candidate), compare_candidate_near_first);
+
+    for (uint32_t i = 0; i < candidate_count && stream->loads_in_flight < stream->config.max_loads_in_flight; i++) {
+        world_cell *cell = candidates[i].cell;
+        atomic_store_explicit(&cell->state, CELL_LOADING, memory_order_relaxed);
+        activate_cell(stream, cell);
+
+        if (!poc_job_submit(load_cell_job, cell, &stream->jobs)) {
+            deactivate_cell(stream, cell);
+            break;
+        }
+        stream->loads_in_flight++;
+    }
+}
+
+static void enforce_memory_budget(poc_world_stream *stream, const vec3 camera_position) {
+    uint64_t budget = stream->config.memory_budget_bytes;
+    if (budget == 0 || atomic_load(&stream->resident_bytes) <= budget || stream->active_count == 0) {
+        return;
+    }
+
+    cell_candidate *candidates = malloc(sizeof(cell_candidate) * stream->active_count);
+    if (!candidates) {
+        return;
+    }
+
+    // Only cells outside the load radius are evicted for memory; evicting
+    // wanted cells would just reload them next update
+    uint32_t candidate_count = 0;
+    for (uint32_t i = 0; i < stream->active_count; i++) {
+        world_cell *cell = &stream->cells[stream->active_cells[i]];
+        int state = atomic_load_explicit(&cell->state, memory_order_acquire);
+        float distance = cell_distance(stream, cell, camera_position);
+        if (state != CELL_LOADING && distance > stream->config.load_radius) {
+            candidates[candidate_count++] = (cell_candidate){ cell, distance };
+        }
+    }
+
+    qsort(candidates, candidate_count, sizeof(cell_candidate), compare_candidate_far_first);
+
+    for (uint32_t i = 0; i < candidate_count && atomic_load(&stream->resident_bytes) > budget; i++) {
+        unload_cell(stream, candidates[i].cell);
+    }
+
+    free(candidates);
+}
+
+void poc_world_stream_update(poc_world_stream *stream, const vec3 camera_position) {
+    if (!stream) {
+        return;
+    }
+
+    double start = poc_get_time();
+    double deadline = start + stream->config.integrate_budget_ms / 1000.0;
+
+    // Retire finished loads and evict cells outside the hysteresis band.
+    // Iterate backwards: unloading swaps the last active cell into place
+    world_cell *pending[64];
+    float pending_distance[64];
+    uint32_t pending_count = 0;
+
+    for (uint32_t i = stream->active_count; i-- > 0;) {
+        world_cell *cell = &stream->cells[stream->active_cells[i]];
+        int state = atomic_load_explicit(&cell->state, memory_order_acquire);
+        if (state == CELL_LOADING) {
+            continue;
+        }
+
+        float distance = cell_distance(stream, cell, camera_position);
+        if (state == CELL_LOADED) {
+            stream->loads_in_flight--;
+            atomic_store_explicit(&cell->state, CELL_INTEGRATING, memory_order_relaxed);
+            state = CELL_INTEGRATING;
+        }
+
+        if (distance > stream->config.unload_radius) {
+            unload_cell(stream, cell);
+            continue;
+        }
+
+        if (state == CELL_INTEGRATING && pending_count < 64) {
+            pending[pending_count] = cell;
+            pending_distance[pending_count] = distance;
+            pending_count++;
+        }
+    }
+
+    // Integrate nearest cells first within the time budget; always make some
+    // progress so a tiny budget cannot stall streaming
+    while (pending_count > 0) {
+        uint32_t nearest = 0;
+        for (uint32_t i = 1; i < pending_count; i++) {
+            if (pending_distance[i] < pending_distance[nearest]) {
+                nearest = i;
+            }
+        }
+
+        world_cell *cell = pending[nearest];
+        pending[nearest] = pending[--pending_count];
+        pending_distance[nearest] = pending_distance[pending_count];
+
+        integrate_cell(stream, cell, deadline);
+        if (poc_get_time() >= deadline) {
+            break;
+        }
+    }
+
+    enforce_memory_budget(stream, camera_position);
+    if (stream->purge_pending) {
+        stream->purge_pending = false;
+        poc_asset_purge();
+    }
+    request_cells(stream, camera_position);
+
+    stream->last_update_ms = (poc_get_time() - start) * 1000.0;
+    if (stream->last_update_ms > stream->max_update_ms) {
+        stream->max_update_ms = stream->last_update_ms;
+    }
+}
+
+void poc_world_stream_get_stats(const poc_world_stream *stream, poc_world_stream_stats *stats) {
+    if (!stats) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(poc_world_stream_stats));
+    if (!stream) {
+        return;
+    }
+
+    stats->cells_total = stream->cell_count;
+    for (uint32_t i = 0; i < stream->active_count; i++) {
+        const world_cell *cell = &stream->cells[stream->active_cells[i]];
+        if (atomic_load_explicit(&((world_cell *)cell)->state, memory_order_relaxed) == CELL_RESIDENT) {
+            stats->cells_resident++;
+        } else {
+            stats->cells_loading++;
+        }
+    }
+    stats->cells_evicted = stream->cells_evicted;
+    stats->objects_resident = stream->objects_resident;
+    stats->resident_bytes = atomic_load(&((poc_world_stream *)stream)->resident_bytes);
+    stats->memory_budget_bytes = stream->config.memory_budget_bytes;
+    stats->last_update_ms = stream->last_update_ms;
+    stats->max_update_ms = stream->max_update_ms;
+}
@@ -0,0 +1,32 @@
+/**
+ * @file world_stream.h
+ * @brief Cell-based world streaming around the camera
+ *
+ * A world stream reads the cell directory of a partitioned scene file (see
+ * scene_file.h) and keeps the cells near the camera resident in a target scene.
+ * Cell files are parsed and their meshes loaded on job system workers; the
+ * owning thread then creates objects and uploads meshes under a per-update
+ * time budget, adding a cell's objects to the scene only once all of them
+ * have their resources.
+ */
+
+#pragma once
+
+#include "poc_engine.h"
+#include <cglm/cglm.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void poc_world_stream_config_defaults(poc_world_stream_config *config);
+poc_world_stream *poc_world_stream_open(const char *path, poc_scene *scene, const poc_world_stream_config *config);
+void poc_world_stream_close(poc_world_stream *stream);
+void poc_world_stream_update(poc_world_stream *stream, const vec3 camera_position);
+void poc_world_stream_get_stats(const poc_world_stream *stream, poc_world_stream_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,201 @@
+/**
+ * @file archive_bench.c
+ * @brief Compare reading many small asset files loose and from an archive
+ *
+ * Usage:
+ *   archive_bench [file_count] [base_directory]
+ *
+ * Creates file_count (default 300) text files of 1-64 KiB, like a project's
+ * OBJ, MTL, shader and script files, in a temporary directory under
+ * base_directory (default: the current directory; /tmp is often tmpfs,
+ * whose pages cannot be dropped), and packs them with poc_archive_build().
+ *
+ * Each round reads every byte of every file through poc_file_map_open(),
+ * once from the loose files and once from the mounted archive (mount
+ * included), first after dropping both from the page cache (cold start)
+ * and then again right away (warm). If the kernel keeps the pages anyway
+ * the cold rows are reported as warm.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../src/asset_archive.h"
+#include "../src/file_map.h"
+#include "bench_util.h"
+
+#define ROUNDS 5
+
+static void file_name(char *out, size_t size, uint32_t index) {
+    snprintf(out, size, "assets/file_%04u.obj", index);
+}
+
+static bool write_assets(uint32_t count) {
+    if (mkdir("assets", 0755) != 0) {
+        return false;
+    }
+
+    srand(42);
+    for (uint32_t i = 0; i < count; i++) {
+        char path[64];
+        file_name(path, sizeof(path), i);
+        FILE *file = fopen(path, "w");
+        if (!file) {
+            return false;
+        }
+        size_t target = 1024 + (size_t)(rand() % (63 * 1024));
+        size_t written = 0;
+        while (written < target) {
+            int length = fprintf(file, "v %.4f %.4f %.4f\n", rand() / (double)RAND_MAX,
+                                 rand() / (double)RAND_MAX, rand() / (double)RAND_MAX);
+            if (length < 0) {
+                fclose(file);
+                return false;
+            }
+            written += (size_t)length;
+        }
+        if (fclose(file) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Write back and evict a file's pages; returns false if some stay resident
+static bool drop_cached(const char *path) {
+    if (!bench_evict(path)) {
+        return false;
+    }
+
+    // Checking residency through a mapping does not fault pages in
+    poc_file_map map;
+    if (!poc_file_map_open(path, &map)) {
+        return false;
+    }
+    bool dropped = poc_file_map_resident_bytes(&map) == 0;
+    poc_file_map_close(&map);
+    return dropped;
+}
+
+static bool drop_all(uint32_t count) {
+    bool dropped = drop_cached("assets.pocpak");
+    for (uint32_t i = 0; i < count; i++) {
+        char path[64];
+        file_name(path, sizeof(path), i);
+        dropped = drop_cached(path) && dropped;
+    }
+    return dropped;
+}
+
+static uint64_t checksum(const char *data, size_t size) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; i++) {
+        sum = sum * 31 + (uint8_t)data[i];
+    }
+    return sum;
+}
+
+static bool read_loose(uint32_t count, uint64_t *sum) {
+    for (uint32_t i = 0; i < count; i++) {
+        char path[64];
+        file_name(path, sizeof(path), i);
+        poc_file_map map;
+        if (!poc_file_map_open(path, &map)) {
+            return false;
+        }
+        *sum += checksum(map.data, map.size);
+        poc_file_map_close(&map);
+    }
+    return true;
+}
+
+static bool read_archived(uint32_t count, uint64_t *sum) {
+    if (!poc_archive_mount("assets.pocpak")) {
+        return false;
+    }
+    bool ok = true;
+    for (uint32_t i = 0; ok && i < count; i++) {
+        char path[64];
+        file_name(path, sizeof(path), i);
+        poc_file_map map;
+        ok = poc_file_map_open(path, &map) && map.archived;
+        if (ok) {
+            *sum += checksum(map.data, map.size);
+        }
+        poc_file_map_close(&map);
+    }
+    poc_archive_unmount();
+    return ok;
+}
+
+typedef struct {
+    double loose;
+    double archived;
+} timings;
+
+static bool run_round(uint32_t count, bool cold, timings *result, bool *was_cold) {
+    uint64_t loose_sum = 0, archived_sum = 0;
+
+    if (cold) {
+        *was_cold = drop_all(count) && *was_cold;
+    }
+    double start = poc_get_time();
+    bool ok = read_loose(count, &loose_sum);
+    result->loose += poc_get_time() - start;
+
+    if (cold) {
+        *was_cold = drop_all(count) && *was_cold;
+    }
+    start = poc_get_time();
+    ok = ok && read_archived(count, &archived_sum);
+    result->archived += poc_get_time() - start;
+
+    return ok && loose_sum == archived_sum;
+}
+
+int main(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 300;
+    const char *base = argc > 2 ? argv[2] : ".";
+    if (count < 1) count = 1;
+
+    char directory[BENCH_PATH_SIZE];
+    if (!bench_make_temp_dir(directory, base, "archive_bench")) {
+        return 1;
+    }
+    if (chdir(directory) != 0) {
+        bench_remove_temp_dir(directory);
+        return 1;
+    }
+
+    const char *inputs[] = {"assets"};
+    bool ok = write_assets((uint32_t)count) && poc_archive_build("assets.pocpak", inputs, 1);
+
+    timings cold = {0}, warm = {0};
+    bool was_cold = true;
+    for (int round = 0; ok && round < ROUNDS; round++) {
+        ok = run_round((uint32_t)count, true, &cold, &was_cold) &&
+             run_round((uint32_t)count, false, &warm, &was_cold);
+    }
+
+    if (ok) {
+        printf("\n%d files, %d rounds, every byte read:\n", count, ROUNDS);
+        printf("  %-6s loose %8.2f ms   archive %8.2f ms   (%.1fx)\n", was_cold ? "cold" : "warm*",
+               cold.loose * 1000.0 / ROUNDS, cold.archived * 1000.0 / ROUNDS, cold.loose / cold.archived);
+        printf("  %-6s loose %8.2f ms   archive %8.2f ms   (%.1fx)\n", "warm",
+               warm.loose * 1000.0 / ROUNDS, warm.archived * 1000.0 / ROUNDS, warm.loose / warm.archived);
+        if (!was_cold) {
+            printf("  * the page cache could not be dropped here (tmpfs?); pass a directory on disk\n");
+        }
+    } else {
+        printf("Could not write, pack or read back the test files\n");
+    }
+
+    if (chdir("..") == 0) {
+        bench_remove_temp_dir(strrchr(directory, '/') + 1);
+    }
+    return ok ? 0 : 1;
+}
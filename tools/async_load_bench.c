@@ -0,0 +1,148 @@
+/**
+ * @file async_load_bench.c
+ * @brief Compare loading many meshes one after another against all at once
+ *
+ * Usage:
+ *   async_load_bench [count] [max_triangles]
+ *
+ * Writes [count] (default 200) grid OBJs of varied size, up to
+ * [max_triangles] (default 20000) triangles, into a temporary directory and
+ * reports:
+ *   - serial:  poc_asset_acquire_mesh() of every file in turn, which is what
+ *              scene loading did before requests
+ *   - async:   poc_mesh_load_async() of every file, then a wait on each
+ *   - largest: poc_asset_acquire_mesh() of the biggest file alone
+ *
+ * With enough cores the async time approaches the largest single load. The
+ * registry is purged between runs and the cooked cache and optimize stage are
+ * disabled so every run parses every file.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/asset_manager.h"
+#include "../src/job_system.h"
+#include "../src/mesh.h"
+#include "../src/mesh_cache.h"
+#include "../src/mesh_optimize.h"
+#include "bench_util.h"
+
+static bool load_serial(char **paths, uint32_t count) {
+    poc_mesh **meshes = calloc(count, sizeof(poc_mesh *));
+    bool ok = meshes != NULL;
+    for (uint32_t i = 0; ok && i < count; i++) {
+        meshes[i] = poc_asset_acquire_mesh(paths[i]);
+        ok = meshes[i] != NULL;
+    }
+    for (uint32_t i = 0; meshes && i < count; i++) {
+        poc_asset_release_mesh(meshes[i]);
+    }
+    free(meshes);
+    return ok;
+}
+
+static bool load_async(char **paths, uint32_t count) {
+    poc_mesh_request **requests = calloc(count, sizeof(poc_mesh_request *));
+    if (!requests) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        requests[i] = poc_mesh_load_async(paths[i], NULL, NULL);
+    }
+
+    bool ok = true;
+    for (uint32_t i = 0; i < count; i++) {
+        ok = poc_mesh_request_wait(requests[i]) != NULL && ok;
+        poc_mesh_request_release(requests[i]);
+    }
+    free(requests);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 200;
+    int max_triangles = argc > 2 ? atoi(argv[2]) : 20000;
+    if (count < 1) count = 1;
+    if (max_triangles < 2) max_triangles = 2;
+
+    poc_mesh_cache_set_enabled(false);
+    poc_mesh_set_optimize_on_load(false);
+    poc_jobs_init(0);
+
+    char directory[BENCH_PATH_SIZE];
+    if (!bench_make_temp_dir(directory, NULL, "async_load_bench")) {
+        return 1;
+    }
+
+    // Sizes spread from small props to one mesh of max_triangles
+    char **paths = calloc((size_t)count, sizeof(char *));
+    uint32_t created = 0;
+    uint32_t largest = 0;
+    uint32_t largest_side = 0;
+    uint64_t total_triangles = 0;
+    bool ok = paths != NULL;
+    for (int i = 0; ok && i < count; i++) {
+        uint32_t triangles = (uint32_t)((uint64_t)max_triangles * (uint32_t)(i + 1) / (uint32_t)count);
+        uint32_t side = 1;
+        while (2 * (side + 1) * (side + 1) <= triangles) {
+            side++;
+        }
+
+        char name[32], path[BENCH_PATH_SIZE];
+        snprintf(name, sizeof(name), "mesh_%d.obj", i);
+        bench_path(path, directory, name);
+        ok = bench_write_grid_file(path, &(bench_grid){.side = side, .attributes = true});
+        if (!ok) {
+            printf("Could not write %s\n", path);
+            break;
+        }
+        paths[created++] = strdup(path);
+        total_triangles += 2ull * side * side;
+        if (side > largest_side) {
+            largest_side = side;
+            largest = created - 1;
+        }
+    }
+
+    double serial = 0.0, async = 0.0, single = 0.0;
+    if (ok) {
+        poc_asset_purge();
+        double start = poc_get_time();
+        ok = load_serial(paths, created);
+        serial = poc_get_time() - start;
+        poc_asset_purge();
+
+        start = poc_get_time();
+        ok = ok && load_async(paths, created);
+        async = poc_get_time() - start;
+        poc_asset_purge();
+
+        start = poc_get_time();
+        ok = ok && load_serial(&paths[largest], 1);
+        single = poc_get_time() - start;
+        poc_asset_purge();
+    }
+
+    if (ok) {
+        printf("\n%u meshes, %llu triangles, %u worker threads\n", created,
+               (unsigned long long)total_triangles, poc_jobs_get_worker_count());
+        printf("%-8s %10s\n", "", "load ms");
+        printf("%-8s %10.2f\n", "serial", serial * 1000.0);
+        printf("%-8s %10.2f\n", "async", async * 1000.0);
+        printf("%-8s %10.2f  (%u triangles)\n", "largest", single * 1000.0, 2 * largest_side * largest_side);
+    } else {
+        printf("Loading failed\n");
+    }
+
+    poc_jobs_shutdown();
+
+    for (uint32_t i = 0; i < created; i++) {
+        free(paths[i]);
+    }
+    free(paths);
+    bench_remove_temp_dir(directory);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bench_util.h"
+#include <stdlib.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <unistd.h>
+
+bool bench_make_temp_dir(char directory[BENCH_PATH_SIZE], const char *base, const char *prefix) {
+    snprintf(directory, BENCH_PATH_SIZE, "%s/%s_XXXXXX", base ? base : "/tmp", prefix);
+    if (!mkdtemp(directory)) {
+        printf("Could not create a temporary directory in %s\n", base ? base : "/tmp");
+        return false;
+    }
+    return true;
+}
+
+const char *bench_path(char out[BENCH_PATH_SIZE], const char *directory, const char *name) {
+    snprintf(out, BENCH_PATH_SIZE, "%s/%s", directory, name);
+    return out;
+}
+
+static int remove_entry(const char *path, const struct stat *info, int type, struct FTW *walk) {
+    (void)info;
+    (void)walk;
+    return type == FTW_DP ? rmdir(path) : unlink(path);
+}
+
+void bench_remove_temp_dir(const char *directory) {
+    // Children first, without following symlinks out of the directory
+    nftw(directory, remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+uint64_t bench_touch_mesh(const poc_mesh *mesh) {
+    uint64_t sum = 0;
+    const uint8_t *bytes = (const uint8_t *)mesh->vertices;
+    size_t size = (size_t)mesh->vertex_count * sizeof(poc_vertex);
+    for (size_t i = 0; i < size; i += 64) sum += bytes[i];
+    for (uint32_t i = 0; i < mesh->index_count; i += 16) sum += mesh->indices[i];
+    return sum;
+}
+
+bool bench_evict(const char *path) {
+#ifdef POC_PLATFORM_MACOS
+    (void)path;
+    return false;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    fdatasync(fd);
+    int result = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+    return result == 0;
+#endif
+}
+
+void bench_grid_vertex(const bench_grid *grid, uint32_t x, uint32_t z, poc_vertex *out) {
+    float bump = grid->bumpy ? 0.25f * (float)((x ^ z) & 3) : 0.0f;
+    *out = (poc_vertex){
+        .position = {(float)x, grid->height + bump, (float)z},
+        .normal = {0.0f, 1.0f, 0.0f},
+        .texcoord = {(float)x / (float)grid->side, (float)z / (float)grid->side},
+    };
+}
+
+bool bench_write_grid(FILE *file, const bench_grid *grid) {
+    uint32_t side = grid->side;
+    if (grid->material_library) {
+        fprintf(file, "mtllib %s\nusemtl surface\n", grid->material_library);
+    }
+
+    for (uint32_t z = 0; z <= side; z++) {
+        for (uint32_t x = 0; x <= side; x++) {
+            poc_vertex v;
+            bench_grid_vertex(grid, x, z, &v);
+            fprintf(file, "v %.6f %.6f %.6f\n", v.position[0], v.position[1], v.position[2]);
+            if (grid->attributes) {
+                fprintf(file, "vt %.6f %.6f\nvn 0 1 0\n", v.texcoord[0], v.texcoord[1]);
+            }
+        }
+    }
+
+    for (uint32_t z = 0; z < side; z++) {
+        for (uint32_t x = 0; x < side; x++) {
+            uint32_t a = z * (side + 1) + x + 1;
+            uint32_t c = a + side + 1;
+            if (grid->attributes) {
+                fprintf(file, "f %u/%u/%u %u/%u/%u %u/%u/%u\nf %u/%u/%u %u/%u/%u %u/%u/%u\n",
+                        a, a, a, c, c, c, c + 1, c + 1, c + 1, a, a, a, c + 1, c + 1, c + 1, a + 1, a + 1, a + 1);
+            } else {
+                fprintf(file, "f %u %u %u\nf %u %u %u\n", a, c, c + 1, a, c + 1, a + 1);
+            }
+        }
+    }
+    return !ferror(file);
+}
+
+bool bench_write_grid_file(const char *path, const bench_grid *grid) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    bool ok = bench_write_grid(file, grid);
+    return fclose(file) == 0 && ok;
+}
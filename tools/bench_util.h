@@ -0,0 +1,93 @@
+/**
+ * @file bench_util.h
+ * @brief Scaffolding shared by the benchmarks in tools/
+ *
+ * Benchmarks write their inputs into a temporary directory, time with
+ * poc_get_time() (which works without poc_init()) and remove the directory
+ * when done. The Makefile links bench_util.c into every tool.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../include/poc_engine.h"
+#include "../src/mesh.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of the buffers bench_make_temp_dir() and bench_path() fill */
+#define BENCH_PATH_SIZE 4200
+
+/**
+ * @brief Create a fresh directory "<base>/<prefix>_XXXXXX"
+ *
+ * @param directory Receives the directory path
+ * @param base Parent directory, or NULL for /tmp
+ * @param prefix Start of the directory name, usually the tool's name
+ * @return true on success; prints a message on failure
+ */
+bool bench_make_temp_dir(char directory[BENCH_PATH_SIZE], const char *base, const char *prefix);
+
+/**
+ * @brief Join a directory and a file name
+ *
+ * @return out, for use as an argument
+ */
+const char *bench_path(char out[BENCH_PATH_SIZE], const char *directory, const char *name);
+
+/**
+ * @brief Delete a directory made by bench_make_temp_dir() and everything in it
+ */
+void bench_remove_temp_dir(const char *directory);
+
+/**
+ * @brief Read every byte the renderer would upload, one per cache line
+ *
+ * @return A checksum, to keep the reads from being optimized away
+ */
+uint64_t bench_touch_mesh(const poc_mesh *mesh);
+
+/**
+ * @brief Write back a file and drop its pages from the page cache
+ *
+ * @return false where that is not supported (posix_fadvise() is Linux only)
+ */
+bool bench_evict(const char *path);
+
+/**
+ * @brief A square grid of quads in the xz plane, two triangles per quad
+ */
+typedef struct {
+    uint32_t side;                  /**< Quads along each edge */
+    float height;                   /**< y of every vertex */
+    bool bumpy;                     /**< Raise vertices by up to 0.75 in a fixed pattern */
+    bool attributes;                /**< Give every vertex a texture coordinate and an up normal */
+    const char *material_library;   /**< Written as "mtllib" with "usemtl surface", or NULL */
+} bench_grid;
+
+/**
+ * @brief Vertex (x, z) of a grid, as bench_write_grid() writes it
+ */
+void bench_grid_vertex(const bench_grid *grid, uint32_t x, uint32_t z, poc_vertex *out);
+
+/**
+ * @brief Append a grid to an open OBJ file
+ *
+ * Vertex (x, z) is OBJ vertex z * (side + 1) + x + 1.
+ *
+ * @return false if writing failed
+ */
+bool bench_write_grid(FILE *file, const bench_grid *grid);
+
+/**
+ * @brief Write a grid as a new OBJ file
+ */
+bool bench_write_grid_file(const char *path, const bench_grid *grid);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,181 @@
+/**
+ * @file bounds_bench.c
+ * @brief Compare ways of refreshing world bounds for many moved objects
+ *
+ * Usage:
+ *   bounds_bench [object_count] [runs]
+ *
+ * Creates object_count (default 100000) scene objects with random
+ * positions, rotations and scales, all sharing one small grid mesh, and
+ * reports the best of [runs] (default 5) passes over every object for:
+ *   - corners: the previous method, transforming all 8 box corners by the
+ *              full matrix and taking their min/max
+ *   - single:  poc_scene_object_update_transform() and
+ *              poc_scene_object_update_bounds() per object (center/extent)
+ *   - list:    poc_scene_object_update_bounds_list() over the array, the
+ *              same kernel with objects prefetched ahead
+ *
+ * First with transforms already built (bounds only), then with transforms
+ * dirty too, as after a move, where the matrix rebuild is shared by all
+ * three. The list results are checked against the single ones.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+
+#include "../src/mesh_cache.h"
+#include "../src/scene_object.h"
+#include "bench_util.h"
+
+// The 8-corner transform poc_scene_object_update_bounds() used before
+static void corner_bounds(poc_scene_object *obj) {
+    const vec3 *lo = &obj->mesh->local_aabb_min;
+    const vec3 *hi = &obj->mesh->local_aabb_max;
+    glm_vec3_copy((vec3){FLT_MAX, FLT_MAX, FLT_MAX}, obj->world_aabb_min);
+    glm_vec3_copy((vec3){-FLT_MAX, -FLT_MAX, -FLT_MAX}, obj->world_aabb_max);
+    for (int i = 0; i < 8; i++) {
+        vec4 corner = {(i & 1) ? (*hi)[0] : (*lo)[0], (i & 2) ? (*hi)[1] : (*lo)[1],
+                       (i & 4) ? (*hi)[2] : (*lo)[2], 1.0f};
+        vec4 world;
+        glm_mat4_mulv(obj->transform_matrix, corner, world);
+        for (int axis = 0; axis < 3; axis++) {
+            obj->world_aabb_min[axis] = fminf(obj->world_aabb_min[axis], world[axis]);
+            obj->world_aabb_max[axis] = fmaxf(obj->world_aabb_max[axis], world[axis]);
+        }
+    }
+    obj->bounds_dirty = false;
+}
+
+static float random_range(float low, float high) {
+    return low + (high - low) * (float)rand() / (float)RAND_MAX;
+}
+
+static void mark_dirty(poc_scene_object **objects, uint32_t count, bool moved) {
+    for (uint32_t i = 0; i < count; i++) {
+        objects[i]->bounds_dirty = true;
+        objects[i]->transform_dirty = moved;
+    }
+}
+
+typedef enum {
+    METHOD_CORNERS,
+    METHOD_SINGLE,
+    METHOD_LIST,
+} method;
+
+static double measure(poc_scene_object **objects, uint32_t count, int runs, method m, bool moved) {
+    double best = 1e30;
+    for (int run = 0; run < runs; run++) {
+        mark_dirty(objects, count, moved);
+        double start = poc_get_time();
+        if (m == METHOD_LIST) {
+            poc_scene_object_update_bounds_list(objects, count);
+        } else {
+            for (uint32_t i = 0; i < count; i++) {
+                if (m == METHOD_SINGLE) {
+                    poc_scene_object_update_transform(objects[i]);
+                    poc_scene_object_update_bounds(objects[i]);
+                } else {
+                    poc_scene_object_update_transform(objects[i]);
+                    corner_bounds(objects[i]);
+                }
+            }
+        }
+        double elapsed = poc_get_time() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+// List results must match the per-object update
+static bool check_list(poc_scene_object **objects, uint32_t count) {
+    vec3 *expected = malloc((size_t)count * 2 * sizeof(vec3));
+    if (!expected) {
+        return false;
+    }
+    mark_dirty(objects, count, false);
+    for (uint32_t i = 0; i < count; i++) {
+        poc_scene_object_update_bounds(objects[i]);
+        glm_vec3_copy(objects[i]->world_aabb_min, expected[2 * i]);
+        glm_vec3_copy(objects[i]->world_aabb_max, expected[2 * i + 1]);
+    }
+    mark_dirty(objects, count, false);
+    poc_scene_object_update_bounds_list(objects, count);
+
+    bool ok = true;
+    for (uint32_t i = 0; ok && i < count; i++) {
+        for (int axis = 0; axis < 3; axis++) {
+            float tolerance = 1e-4f * (1.0f + fabsf(expected[2 * i][axis]) + fabsf(expected[2 * i + 1][axis]));
+            ok = ok && !objects[i]->bounds_dirty &&
+                 fabsf(objects[i]->world_aabb_min[axis] - expected[2 * i][axis]) <= tolerance &&
+                 fabsf(objects[i]->world_aabb_max[axis] - expected[2 * i + 1][axis]) <= tolerance;
+        }
+    }
+    free(expected);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 100000;
+    int runs = argc > 2 ? atoi(argv[2]) : 5;
+    if (count < 1) count = 1;
+    if (runs < 1) runs = 1;
+
+    char directory[BENCH_PATH_SIZE], path[BENCH_PATH_SIZE];
+    if (!bench_make_temp_dir(directory, NULL, "bounds_bench")) {
+        return 1;
+    }
+    poc_mesh_cache_set_enabled(false);
+    bool ok = bench_write_grid_file(bench_path(path, directory, "grid.obj"),
+                                    &(bench_grid){.side = 4, .bumpy = true});
+    poc_mesh *mesh = ok ? poc_mesh_load(path) : NULL;
+
+    poc_scene_object **objects = calloc((size_t)count, sizeof(poc_scene_object *));
+    ok = mesh && objects;
+    srand(42);
+    for (int i = 0; ok && i < count; i++) {
+        objects[i] = poc_scene_object_create("object", (uint32_t)i);
+        ok = objects[i] != NULL;
+        if (ok) {
+            // Set directly: the mesh is not managed and no renderable is wanted
+            objects[i]->mesh = mesh;
+            glm_vec3_copy((vec3){random_range(-500, 500), random_range(-20, 20), random_range(-500, 500)},
+                          objects[i]->position);
+            glm_vec3_copy((vec3){random_range(-180, 180), random_range(-180, 180), random_range(-180, 180)},
+                          objects[i]->rotation);
+            float scale = random_range(0.5f, 2.0f);
+            glm_vec3_copy((vec3){scale, scale * random_range(0.5f, 2.0f), scale}, objects[i]->scale);
+            objects[i]->transform_dirty = true;
+            poc_scene_object_update_transform(objects[i]);
+        }
+    }
+
+    ok = ok && check_list(objects, (uint32_t)count);
+    if (ok) {
+        printf("\n%d objects, best of %d:\n", count, runs);
+        printf("  %-13s %10s %10s %10s %9s %9s\n", "", "corners", "single", "list", "vs corner", "vs single");
+        for (int moved = 0; moved < 2; moved++) {
+            double corners = measure(objects, (uint32_t)count, runs, METHOD_CORNERS, moved);
+            double single = measure(objects, (uint32_t)count, runs, METHOD_SINGLE, moved);
+            double list = measure(objects, (uint32_t)count, runs, METHOD_LIST, moved);
+            printf("  %-13s %7.2f ms %7.2f ms %7.2f ms %8.1fx %8.2fx\n", moved ? "moved" : "bounds only",
+                   corners * 1000.0, single * 1000.0, list * 1000.0, corners / list, single / list);
+        }
+    } else {
+        printf("Could not set up the objects, or list bounds differ from single ones\n");
+    }
+
+    for (int i = 0; objects && i < count; i++) {
+        if (objects[i]) {
+            objects[i]->mesh = NULL;
+            poc_scene_object_destroy(objects[i]);
+        }
+    }
+    free(objects);
+    poc_mesh_destroy(mesh);
+    bench_remove_temp_dir(directory);
+    return ok ? 0 : 1;
+}
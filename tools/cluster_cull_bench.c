@@ -0,0 +1,228 @@
+/**
+ * @file cluster_cull_bench.c
+ * @brief Measure how many triangles cluster culling keeps from the GPU
+ *
+ * Usage:
+ *   cluster_cull_bench [terrain_side] [sphere_rings]
+ *
+ * Writes two OBJs into a temporary directory and loads them with clustering
+ * switched off, so both kinds of cluster can be built from the same mesh:
+ *   - terrain: a heightfield of terrain_side^2 quads (default 512), seen
+ *              from eye height in eight directions; mostly frustum culling
+ *   - sphere:  a closed sphere of sphere_rings rings (default 256), seen
+ *              from outside in eight directions; mostly normal cone culling
+ *
+ * For each mesh and view the triangles and draws (runs of adjacent visible
+ * clusters) that would be submitted are compared with the whole mesh, along
+ * with the vertex cache miss ratio of each order, for
+ *   - runs:  consecutive POC_MESH_CLUSTER_TRIANGLES runs of the optimized order
+ *   - grown: clusters grown through shared vertices, as poc_mesh_load() builds
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../src/mesh.h"
+#include "../src/mesh_cache.h"
+#include "../src/mesh_cluster.h"
+#include "../src/mesh_optimize.h"
+#include "bench_util.h"
+
+#define VIEW_COUNT 8
+
+static float terrain_height(float x, float z) {
+    return 2.0f * sinf(x * 0.05f) * cosf(z * 0.07f) + 0.3f * sinf(x * 0.9f + z * 0.4f);
+}
+
+// Heightfield over [-100, 100] on both axes, faces wound upward
+static bool write_terrain(const char *path, uint32_t side) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+
+    for (uint32_t z = 0; z <= side; z++) {
+        for (uint32_t x = 0; x <= side; x++) {
+            float px = -100.0f + 200.0f * (float)x / (float)side;
+            float pz = -100.0f + 200.0f * (float)z / (float)side;
+            fprintf(file, "v %.5f %.5f %.5f\n", px, terrain_height(px, pz), pz);
+        }
+    }
+    for (uint32_t z = 0; z < side; z++) {
+        for (uint32_t x = 0; x < side; x++) {
+            uint32_t a = z * (side + 1) + x + 1;
+            uint32_t b = a + 1;
+            uint32_t c = a + side + 1;
+            uint32_t d = c + 1;
+            fprintf(file, "f %u %u %u\nf %u %u %u\n", a, c, d, a, d, b);
+        }
+    }
+
+    bool ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+// Unit sphere with shared poles, faces wound outward
+static bool write_sphere(const char *path, uint32_t rings) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+
+    uint32_t segments = 2 * rings;
+    fprintf(file, "v 0 1 0\n");
+    for (uint32_t r = 1; r < rings; r++) {
+        float theta = (float)r / (float)rings * (float)M_PI;
+        for (uint32_t s = 0; s < segments; s++) {
+            float phi = (float)s / (float)segments * 2.0f * (float)M_PI;
+            fprintf(file, "v %.6f %.6f %.6f\n", sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi));
+        }
+    }
+    fprintf(file, "v 0 -1 0\n");
+
+    uint32_t bottom = 2 + (rings - 1) * segments;
+    for (uint32_t s = 0; s < segments; s++) {
+        uint32_t next = (s + 1) % segments;
+        fprintf(file, "f 1 %u %u\n", 2 + next, 2 + s);
+        fprintf(file, "f %u %u %u\n", bottom, 2 + (rings - 2) * segments + s, 2 + (rings - 2) * segments + next);
+    }
+    for (uint32_t r = 0; r + 2 < rings; r++) {
+        for (uint32_t s = 0; s < segments; s++) {
+            uint32_t next = (s + 1) % segments;
+            uint32_t a = 2 + r * segments + s;
+            uint32_t b = 2 + r * segments + next;
+            uint32_t c = a + segments;
+            uint32_t d = b + segments;
+            fprintf(file, "f %u %u %u\nf %u %u %u\n", a, b, d, a, d, c);
+        }
+    }
+
+    bool ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+typedef struct {
+    uint64_t triangles;
+    uint64_t draws;
+    double seconds;
+} cull_result;
+
+static void cull_view(const poc_mesh *mesh, mat4 view_projection, vec3 eye, cull_result *result) {
+    mat4 model;
+    glm_mat4_identity(model);
+
+    double start = poc_get_time();
+    poc_cluster_view view;
+    poc_cluster_view_init(&view, view_projection, model, eye);
+
+    uint32_t run_end = UINT32_MAX;
+    for (uint32_t i = 0; i < mesh->cluster_count; i++) {
+        const poc_mesh_cluster *cluster = &mesh->clusters[i];
+        if (!poc_cluster_is_visible(&view, cluster)) {
+            continue;
+        }
+        result->triangles += cluster->index_count / 3;
+        result->draws += cluster->index_offset != run_end;
+        run_end = cluster->index_offset + cluster->index_count;
+    }
+    result->seconds += poc_get_time() - start;
+}
+
+// Eight views around the mesh: from eye height on the terrain, from
+// outside on the sphere
+static void run_views(const poc_mesh *mesh, bool terrain, cull_result *result) {
+    memset(result, 0, sizeof(*result));
+    mat4 projection;
+    glm_perspective(glm_rad(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f, projection);
+
+    for (int i = 0; i < VIEW_COUNT; i++) {
+        float angle = (float)i / VIEW_COUNT * 2.0f * (float)M_PI;
+        vec3 eye, target;
+        if (terrain) {
+            glm_vec3_copy((vec3){10.0f * cosf(angle), 0.0f, 10.0f * sinf(angle)}, eye);
+            eye[1] = terrain_height(eye[0], eye[2]) + 2.0f;
+            glm_vec3_copy((vec3){eye[0] + cosf(angle), eye[1] - 0.1f, eye[2] + sinf(angle)}, target);
+        } else {
+            glm_vec3_copy((vec3){3.0f * cosf(angle), 0.5f, 3.0f * sinf(angle)}, eye);
+            glm_vec3_zero(target);
+        }
+
+        mat4 view, view_projection;
+        glm_lookat(eye, target, (vec3){0.0f, 1.0f, 0.0f}, view);
+        glm_mat4_mul(projection, view, view_projection);
+        cull_view(mesh, view_projection, eye, result);
+    }
+}
+
+static void report(const char *label, const poc_mesh *mesh, const cull_result *result) {
+    uint64_t total = (uint64_t)mesh->index_count / 3 * VIEW_COUNT;
+    double radius = 0.0;
+    for (uint32_t i = 0; i < mesh->cluster_count; i++) {
+        radius += mesh->clusters[i].radius;
+    }
+    poc_vertex_cache_stats cache = poc_mesh_analyze_vertex_cache(mesh->indices, mesh->index_count,
+                                                                 mesh->vertex_count, POC_MESH_CACHE_SIZE);
+    printf("  %-6s %7u clusters  ACMR %.3f  radius %7.3f  %6.1f%% of triangles  %7.1f draws  %8.1f us/view\n",
+           label, mesh->cluster_count, cache.acmr, radius / mesh->cluster_count,
+           100.0 * (double)result->triangles / (double)total,
+           (double)result->draws / VIEW_COUNT, result->seconds * 1e6 / VIEW_COUNT);
+}
+
+static bool measure(const char *path, bool terrain) {
+    poc_mesh *mesh = poc_mesh_load(path);
+    if (!mesh || !mesh->owns_data) {
+        poc_mesh_destroy(mesh);
+        return false;
+    }
+    printf("\n%s: %u triangles, %d views\n", terrain ? "terrain" : "sphere", mesh->index_count / 3, VIEW_COUNT);
+
+    cull_result result;
+    bool ok = poc_mesh_build_clusters(mesh, false);
+    if (ok) {
+        run_views(mesh, terrain, &result);
+        report("runs", mesh, &result);
+    }
+
+    double start = poc_get_time();
+    ok = ok && poc_mesh_build_clusters(mesh, true);
+    double build = poc_get_time() - start;
+    if (ok) {
+        run_views(mesh, terrain, &result);
+        report("grown", mesh, &result);
+        printf("  grown clusters built in %.1f ms\n", build * 1000.0);
+    }
+
+    poc_mesh_destroy(mesh);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    int side = argc > 1 ? atoi(argv[1]) : 512;
+    int rings = argc > 2 ? atoi(argv[2]) : 256;
+    if (side < 1) side = 1;
+    if (rings < 3) rings = 3;
+
+    char directory[BENCH_PATH_SIZE];
+    if (!bench_make_temp_dir(directory, NULL, "cluster_cull_bench")) {
+        return 1;
+    }
+    char terrain[BENCH_PATH_SIZE], sphere[BENCH_PATH_SIZE];
+    bench_path(terrain, directory, "terrain.obj");
+    bench_path(sphere, directory, "sphere.obj");
+
+    // Parse every time, and leave clustering to the measurements
+    poc_mesh_cache_set_enabled(false);
+    poc_mesh_set_cluster_on_load(false);
+
+    bool ok = write_terrain(terrain, (uint32_t)side) && write_sphere(sphere, (uint32_t)rings);
+    ok = ok && measure(terrain, true) && measure(sphere, false);
+    if (!ok) {
+        printf("Could not write, load or cluster the test meshes\n");
+    }
+
+    bench_remove_temp_dir(directory);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+/**
+ * @file gltf_bench.c
+ * @brief Compare importing the same mesh from OBJ and from GLB
+ *
+ * Usage:
+ *   gltf_bench [grid_side] [runs]
+ *
+ * Writes a grid of grid_side^2 quads (default 512) with positions, normals
+ * and texture coordinates into a temporary directory, three ways:
+ *   - grid.obj with its MTL library
+ *   - grid.glb, one interleaved buffer view laid out like poc_vertex and
+ *     32-bit indices, which the importer copies out in one block; loaded
+ *     again from an asset archive, it is read in place (zero-copy)
+ *   - grid_split.glb, one buffer view per attribute, which is converted
+ *
+ * Reports the best of [runs] (default 3) poc_mesh_load() times with the
+ * cooked cache off and the default optimize and cluster settings, first
+ * as returned and then with a pass reading every vertex and index, which
+ * is what an upload costs on top. Zero-copy loads defer that reading.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/mesh.h"
+#include "../src/mesh_cache.h"
+#include "../src/asset_archive.h"
+#include "bench_util.h"
+
+static bool write_obj(const char *mtl_path, const char *obj_path, const bench_grid *grid) {
+    FILE *file = fopen(mtl_path, "w");
+    if (!file) {
+        return false;
+    }
+    fprintf(file, "newmtl surface\nKd 0.8 0.6 0.4\nKa 0.16 0.12 0.08\nKs 0.04 0.04 0.04\nNs 16\n");
+    if (fclose(file) != 0) {
+        return false;
+    }
+    return bench_write_grid_file(obj_path, grid);
+}
+
+static void write_u32(FILE *file, uint32_t value) {
+    fwrite(&value, sizeof(value), 1, file);
+}
+
+// Write a GLB whose binary chunk holds the vertices, then the indices.
+// Interleaved: one view of poc_vertex records. Split: one view per attribute.
+static bool write_glb(const char *path, const bench_grid *grid, bool interleaved) {
+    uint32_t side = grid->side;
+    uint32_t vertex_count = (side + 1) * (side + 1);
+    uint32_t index_count = side * side * 6;
+    poc_vertex *vertices = malloc((size_t)vertex_count * sizeof(poc_vertex));
+    uint32_t *indices = malloc((size_t)index_count * sizeof(uint32_t));
+    if (!vertices || !indices) {
+        free(vertices);
+        free(indices);
+        return false;
+    }
+    for (uint32_t z = 0, i = 0; z <= side; z++) {
+        for (uint32_t x = 0; x <= side; x++) {
+            bench_grid_vertex(grid, x, z, &vertices[i++]);
+        }
+    }
+    for (uint32_t z = 0, i = 0; z < side; z++) {
+        for (uint32_t x = 0; x < side; x++) {
+            uint32_t a = z * (side + 1) + x;
+            uint32_t c = a + side + 1;
+            uint32_t quad[6] = {a, c, c + 1, a, c + 1, a + 1};
+            memcpy(&indices[i], quad, sizeof(quad));
+            i += 6;
+        }
+    }
+
+    size_t vertex_bytes = (size_t)vertex_count * sizeof(poc_vertex);
+    size_t index_bytes = (size_t)index_count * sizeof(uint32_t);
+    size_t position_bytes = (size_t)vertex_count * 12, texcoord_bytes = (size_t)vertex_count * 8;
+    float max_height = 0.75f;
+
+    char json[4096];
+    int length;
+    if (interleaved) {
+        length = snprintf(json, sizeof(json),
+            "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],"
+            "\"nodes\":[{\"name\":\"grid\",\"mesh\":0}],"
+            "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},"
+            "\"indices\":3,\"material\":0}]}],"
+            "\"materials\":[{\"name\":\"surface\",\"pbrMetallicRoughness\":{\"baseColorFactor\":[0.8,0.6,0.4,1],"
+            "\"metallicFactor\":0,\"roughnessFactor\":0.6}}],"
+            "\"buffers\":[{\"byteLength\":%zu}],"
+            "\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":%zu,\"byteStride\":32},"
+            "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu}],"
+            "\"accessors\":["
+            "{\"bufferView\":0,\"byteOffset\":0,\"componentType\":5126,\"count\":%u,\"type\":\"VEC3\","
+            "\"min\":[0,0,0],\"max\":[%u,%g,%u]},"
+            "{\"bufferView\":0,\"byteOffset\":12,\"componentType\":5126,\"count\":%u,\"type\":\"VEC3\"},"
+            "{\"bufferView\":0,\"byteOffset\":24,\"componentType\":5126,\"count\":%u,\"type\":\"VEC2\"},"
+            "{\"bufferView\":1,\"componentType\":5125,\"count\":%u,\"type\":\"SCALAR\"}]}",
+            vertex_bytes + index_bytes, vertex_bytes, vertex_bytes, index_bytes,
+            vertex_count, side, max_height, side, vertex_count, vertex_count, index_count);
+    } else {
+        length = snprintf(json, sizeof(json),
+            "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],"
+            "\"nodes\":[{\"name\":\"grid\",\"mesh\":0}],"
+            "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},"
+            "\"indices\":3,\"material\":0}]}],"
+            "\"materials\":[{\"name\":\"surface\",\"pbrMetallicRoughness\":{\"baseColorFactor\":[0.8,0.6,0.4,1],"
+            "\"metallicFactor\":0,\"roughnessFactor\":0.6}}],"
+            "\"buffers\":[{\"byteLength\":%zu}],"
+            "\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":%zu},"
+            "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu},"
+            "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu},"
+            "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu}],"
+            "\"accessors\":["
+            "{\"bufferView\":0,\"componentType\":5126,\"count\":%u,\"type\":\"VEC3\","
+            "\"min\":[0,0,0],\"max\":[%u,%g,%u]},"
+            "{\"bufferView\":1,\"componentType\":5126,\"count\":%u,\"type\":\"VEC3\"},"
+            "{\"bufferView\":2,\"componentType\":5126,\"count\":%u,\"type\":\"VEC2\"},"
+            "{\"bufferView\":3,\"componentType\":5125,\"count\":%u,\"type\":\"SCALAR\"}]}",
+            vertex_bytes + index_bytes,
+            position_bytes, position_bytes, position_bytes,
+            2 * position_bytes, texcoord_bytes, 2 * position_bytes + texcoord_bytes, index_bytes,
+            vertex_count, side, max_height, side, vertex_count, vertex_count, index_count);
+    }
+    uint32_t json_size = ((uint32_t)length + 3) & ~3u;
+    uint32_t bin_size = (uint32_t)(vertex_bytes + index_bytes);
+
+    FILE *file = fopen(path, "wb");
+    bool ok = file && length > 0 && (size_t)length < sizeof(json);
+    if (ok) {
+        write_u32(file, 0x46546C67u);
+        write_u32(file, 2);
+        write_u32(file, 12 + 8 + json_size + 8 + bin_size);
+        write_u32(file, json_size);
+        write_u32(file, 0x4E4F534Au);
+        fwrite(json, 1, (size_t)length, file);
+        fwrite("   ", 1, json_size - (uint32_t)length, file);
+        write_u32(file, bin_size);
+        write_u32(file, 0x004E4942u);
+        if (interleaved) {
+            fwrite(vertices, sizeof(poc_vertex), vertex_count, file);
+        } else {
+            for (uint32_t i = 0; i < vertex_count; i++) fwrite(vertices[i].position, 12, 1, file);
+            for (uint32_t i = 0; i < vertex_count; i++) fwrite(vertices[i].normal, 12, 1, file);
+            for (uint32_t i = 0; i < vertex_count; i++) fwrite(vertices[i].texcoord, 8, 1, file);
+        }
+        fwrite(indices, sizeof(uint32_t), index_count, file);
+        ok = !ferror(file);
+    }
+    if (file) {
+        ok = fclose(file) == 0 && ok;
+    }
+    free(vertices);
+    free(indices);
+    return ok;
+}
+
+typedef struct {
+    double load;
+    double touched;
+    uint32_t vertices;
+    uint32_t indices;
+} timing;
+
+static bool measure(const char *path, int runs, timing *best) {
+    best->load = best->touched = 1e30;
+    for (int i = 0; i < runs; i++) {
+        double start = poc_get_time();
+        poc_mesh *mesh = poc_mesh_load(path);
+        double loaded = poc_get_time();
+        if (!mesh) {
+            return false;
+        }
+        volatile uint64_t sum = bench_touch_mesh(mesh);
+        (void)sum;
+        double touched = poc_get_time();
+
+        if (loaded - start < best->load) best->load = loaded - start;
+        if (touched - start < best->touched) best->touched = touched - start;
+        best->vertices = mesh->vertex_count;
+        best->indices = mesh->index_count;
+        poc_mesh_destroy(mesh);
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int side = argc > 1 ? atoi(argv[1]) : 512;
+    int runs = argc > 2 ? atoi(argv[2]) : 3;
+    if (side < 1) side = 1;
+    if (side > 4096) side = 4096;
+    if (runs < 1) runs = 1;
+
+    char directory[BENCH_PATH_SIZE];
+    if (!bench_make_temp_dir(directory, NULL, "gltf_bench")) {
+        return 1;
+    }
+    char obj_path[BENCH_PATH_SIZE], mtl_path[BENCH_PATH_SIZE], glb_path[BENCH_PATH_SIZE], split_path[BENCH_PATH_SIZE];
+    char archive_path[BENCH_PATH_SIZE];
+    bench_path(obj_path, directory, "grid.obj");
+    bench_path(mtl_path, directory, "grid.mtl");
+    bench_path(glb_path, directory, "grid.glb");
+    bench_path(split_path, directory, "grid_split.glb");
+    bench_path(archive_path, directory, "grid.pocpak");
+
+    poc_mesh_cache_set_enabled(false);
+    bench_grid grid = {.side = (uint32_t)side, .bumpy = true, .attributes = true, .material_library = "grid.mtl"};
+    timing obj = {0}, glb = {0}, archived = {0}, split = {0};
+    const char *inputs[] = {glb_path};
+    bool ok = write_obj(mtl_path, obj_path, &grid) &&
+              write_glb(glb_path, &grid, true) &&
+              write_glb(split_path, &grid, false) &&
+              measure(obj_path, runs, &obj) &&
+              measure(glb_path, runs, &glb) &&
+              measure(split_path, runs, &split) &&
+              poc_archive_build(archive_path, inputs, 1) &&
+              poc_archive_mount(archive_path);
+    if (ok) {
+        ok = measure(glb_path, runs, &archived);
+        poc_archive_unmount();
+    }
+
+    if (ok) {
+        printf("\n%u-triangle grid, best of %d:\n", (uint32_t)side * (uint32_t)side * 2, runs);
+        printf("  %-16s %9s %9s %10s %10s\n", "", "load", "+ read", "vertices", "indices");
+        printf("  %-16s %7.2f ms %7.2f ms %10u %10u\n", "OBJ", obj.load * 1000.0, obj.touched * 1000.0, obj.vertices, obj.indices);
+        printf("  %-16s %7.2f ms %7.2f ms %10u %10u\n", "GLB copied", glb.load * 1000.0, glb.touched * 1000.0, glb.vertices, glb.indices);
+        printf("  %-16s %7.2f ms %7.2f ms %10u %10u\n", "GLB zero-copy", archived.load * 1000.0, archived.touched * 1000.0, archived.vertices, archived.indices);
+        printf("  %-16s %7.2f ms %7.2f ms %10u %10u\n", "GLB converted", split.load * 1000.0, split.touched * 1000.0, split.vertices, split.indices);
+    } else {
+        printf("Could not write or load the test files\n");
+    }
+
+    bench_remove_temp_dir(directory);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file hot_reload_bench.c
+ * @brief Measure how long an edited mesh takes to reach the running engine
+ *
+ * Usage:
+ *   hot_reload_bench [grid_side] [edits]
+ *
+ * Writes a grid OBJ of grid_side^2 quads (default 256) with an MTL library
+ * into a temporary directory, acquires it through the asset manager and
+ * starts the file watcher. Each edit (default 10) saves a new version the
+ * way editors do, to a temporary name renamed over the original, alternating
+ * between a raised grid and a changed material colour. The main loop then
+ * dispatches loads once per millisecond, like a frame loop running at
+ * 1000 fps, until the reload listener sees the new contents.
+ *
+ * Reported per edit kind: average and worst time from the save to the
+ * listener, which is when the next frame shows the edit. The engine's log
+ * adds the parse time of each reload.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+
+#include "../src/asset_manager.h"
+#include "../src/file_watch.h"
+#include "../src/mesh.h"
+#include "bench_util.h"
+
+// Save through a temporary file and rename, as most editors and exporters do
+static FILE *begin_save(const char *path, char *temp_path, size_t temp_size) {
+    snprintf(temp_path, temp_size, "%s.save", path);
+    return fopen(temp_path, "w");
+}
+
+static bool finish_save(FILE *file, const char *path, const char *temp_path) {
+    bool ok = !ferror(file);
+    ok = fclose(file) == 0 && ok;
+    return ok && rename(temp_path, path) == 0;
+}
+
+static bool write_grid(const char *path, uint32_t side, float height) {
+    char temp_path[BENCH_PATH_SIZE + 8];
+    FILE *file = begin_save(path, temp_path, sizeof(temp_path));
+    if (!file) {
+        return false;
+    }
+    bench_write_grid(file, &(bench_grid){.side = side, .height = height, .material_library = "grid.mtl"});
+    return finish_save(file, path, temp_path);
+}
+
+static bool write_material(const char *path, float red) {
+    char temp_path[BENCH_PATH_SIZE + 8];
+    FILE *file = begin_save(path, temp_path, sizeof(temp_path));
+    if (!file) {
+        return false;
+    }
+    fprintf(file, "newmtl surface\nKd %.3f 0.5 0.5\nKa 0.1 0.1 0.1\nNs 16\n", red);
+    return finish_save(file, path, temp_path);
+}
+
+typedef struct {
+    poc_mesh *mesh;
+    bool seen;
+} reload_state;
+
+static void on_reloaded(poc_mesh *mesh, void *user_data) {
+    reload_state *state = user_data;
+    if (mesh == state->mesh) {
+        state->seen = true;
+    }
+}
+
+typedef struct {
+    double total;
+    double worst;
+    uint32_t count;
+} latency;
+
+// Wait for the edit to be swapped in, dispatching like a frame loop would
+static bool wait_for_reload(reload_state *state, double saved, latency *result) {
+    state->seen = false;
+    while (!state->seen) {
+        if (poc_get_time() - saved > 5.0) {
+            return false;
+        }
+        usleep(1000);
+        poc_mesh_dispatch_loads();
+    }
+
+    double elapsed = poc_get_time() - saved;
+    result->total += elapsed;
+    if (elapsed > result->worst) {
+        result->worst = elapsed;
+    }
+    result->count++;
+    return true;
+}
+
+static void report(const char *label, const latency *result) {
+    if (result->count == 0) {
+        return;
+    }
+    printf("  %-9s %2u edits  save -> visible %7.2f ms avg, %7.2f ms worst\n",
+           label, result->count, result->total * 1000.0 / result->count, result->worst * 1000.0);
+}
+
+int main(int argc, char **argv) {
+    int side = argc > 1 ? atoi(argv[1]) : 256;
+    int edits = argc > 2 ? atoi(argv[2]) : 10;
+    if (side < 1) side = 1;
+    if (edits < 1) edits = 1;
+
+    char directory[BENCH_PATH_SIZE];
+    if (!bench_make_temp_dir(directory, NULL, "hot_reload_bench")) {
+        return 1;
+    }
+    char obj_path[BENCH_PATH_SIZE], mtl_path[BENCH_PATH_SIZE];
+    bench_path(obj_path, directory, "grid.obj");
+    bench_path(mtl_path, directory, "grid.mtl");
+
+    bool ok = write_material(mtl_path, 0.5f) && write_grid(obj_path, (uint32_t)side, 0.0f);
+    poc_mesh *mesh = ok ? poc_asset_acquire_mesh(obj_path) : NULL;
+    reload_state state = {mesh, false};
+    ok = mesh && poc_asset_add_reload_listener(on_reloaded, &state) && poc_file_watch_start();
+
+    latency geometry = {0}, material = {0};
+    for (int i = 0; ok && i < edits; i++) {
+        bool edit_material = i % 2 == 1;
+        ok = edit_material ? write_material(mtl_path, (float)i / (float)edits)
+                           : write_grid(obj_path, (uint32_t)side, (float)(i + 1));
+        double saved = poc_get_time();
+        ok = ok && wait_for_reload(&state, saved, edit_material ? &material : &geometry);
+
+        // Check the new version is what the mesh now holds
+        if (ok && edit_material) {
+            ok = mesh->has_material && fabsf(mesh->material.diffuse[0] - (float)i / (float)edits) < 1e-3f;
+        } else if (ok) {
+            ok = mesh->local_aabb_min[1] == (float)(i + 1);
+        }
+    }
+
+    if (ok) {
+        printf("\nhot reload of a %u-triangle mesh:\n", (uint32_t)side * (uint32_t)side * 2);
+        report("geometry", &geometry);
+        report("material", &material);
+    } else {
+        printf("Reload did not arrive or did not carry the edit\n");
+    }
+
+    poc_file_watch_stop();
+    poc_asset_remove_reload_listener(on_reloaded, &state);
+    poc_asset_release_mesh(mesh);
+    poc_asset_purge();
+
+    bench_remove_temp_dir(directory);
+    return ok ? 0 : 1;
+}
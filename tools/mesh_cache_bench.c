@@ -0,0 +1,88 @@
+/**
+ * @file mesh_cache_bench.c
+ * @brief Compare OBJ parsing against cooked .pocmesh loads
+ *
+ * Usage:
+ *   mesh_cache_bench <file.obj> [runs]
+ *
+ * Reports the best of [runs] (default 3) for:
+ *   - parse: poc_mesh_load() with the cooked cache disabled
+ *   - warm:  cooked load with the file in the page cache
+ *   - cold:  cooked load after evicting the file from the page cache
+ *            (Linux only; uses posix_fadvise(POSIX_FADV_DONTNEED))
+ *
+ * Cooked loads map the file lazily, so each is also timed with a pass that
+ * reads every vertex and index, which is what an upload costs on top.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/mesh.h"
+#include "../src/mesh_cache.h"
+#include "bench_util.h"
+
+typedef struct {
+    double load;
+    double touched;
+} timing;
+
+static bool run(const char *path, const char *cooked_path, bool cold, timing *best) {
+    if (cold && !bench_evict(cooked_path)) return false;
+
+    double start = poc_get_time();
+    poc_mesh *mesh = poc_mesh_load(path);
+    double loaded = poc_get_time();
+    if (!mesh) return false;
+    volatile uint64_t sink = bench_touch_mesh(mesh);
+    (void)sink;
+    double touched = poc_get_time();
+    poc_mesh_destroy(mesh);
+
+    if (loaded - start < best->load) best->load = loaded - start;
+    if (touched - start < best->touched) best->touched = touched - start;
+    return true;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        printf("Usage: %s <file.obj> [runs]\n", argv[0]);
+        return 1;
+    }
+    const char *path = argv[1];
+    int runs = argc > 2 ? atoi(argv[2]) : 3;
+    if (runs < 1) runs = 1;
+
+    char cooked_path[4096];
+    snprintf(cooked_path, sizeof(cooked_path), "%s%s", path, POC_MESH_CACHE_EXTENSION);
+
+    timing parse = {1e9, 1e9}, warm = {1e9, 1e9}, cold = {1e9, 1e9};
+
+    poc_mesh_cache_set_enabled(false);
+    for (int i = 0; i < runs; i++) {
+        if (!run(path, cooked_path, false, &parse)) return 1;
+    }
+
+    // Cook (or validate an existing cooked file), then time cached loads
+    poc_mesh_cache_set_enabled(true);
+    poc_mesh_destroy(poc_mesh_load(path));
+    bool have_cold = true;
+    for (int i = 0; i < runs; i++) {
+        if (!run(path, cooked_path, false, &warm)) return 1;
+        have_cold = have_cold && run(path, cooked_path, true, &cold);
+    }
+
+    printf("\n%-6s %10s %16s\n", "", "load ms", "load+read ms");
+    printf("%-6s %10.2f %16.2f\n", "parse", parse.load * 1000.0, parse.touched * 1000.0);
+    printf("%-6s %10.2f %16.2f  (%.0fx)\n", "warm", warm.load * 1000.0, warm.touched * 1000.0,
+           parse.touched / warm.touched);
+    if (have_cold) {
+        printf("%-6s %10.2f %16.2f  (%.0fx)\n", "cold", cold.load * 1000.0, cold.touched * 1000.0,
+               parse.touched / cold.touched);
+    } else {
+        printf("cold   unavailable (page cache eviction not supported here)\n");
+    }
+    return 0;
+}
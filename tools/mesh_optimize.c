@@ -0,0 +1,132 @@
+/**
+ * @file mesh_optimize.c
+ * @brief Run the mesh optimize stage on an OBJ file and report its effect
+ *
+ * Usage:
+ *   mesh_optimize <file.obj> [-o out.obj]
+ *
+ * Loads the mesh without the on-load optimization, then applies the vertex
+ * cache, overdraw and vertex fetch passes one at a time and prints ACMR and
+ * ATVR after each. With -o the optimized mesh is written back out as OBJ so
+ * the reordered triangles survive into assets that are loaded with
+ * optimization switched off.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/mesh.h"
+#include "../src/mesh_optimize.h"
+#include "../src/mesh_cache.h"
+#include "../include/poc_engine.h"
+
+static void report(const char *stage, const poc_mesh *mesh, double milliseconds) {
+    poc_vertex_cache_stats stats = poc_mesh_analyze_vertex_cache(mesh->indices, mesh->index_count,
+                                                                 mesh->vertex_count, POC_MESH_CACHE_SIZE);
+    printf("  %-14s ACMR %.3f  ATVR %.3f  %8.1f ms\n", stage, stats.acmr, stats.atvr, milliseconds);
+}
+
+static bool write_obj(const char *path, const poc_mesh *mesh) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+
+    fprintf(file, "# optimized by mesh_optimize\n");
+    for (uint32_t i = 0; i < mesh->vertex_count; i++) {
+        const poc_vertex *v = &mesh->vertices[i];
+        fprintf(file, "v %.9g %.9g %.9g\n", v->position[0], v->position[1], v->position[2]);
+        fprintf(file, "vt %.9g %.9g\n", v->texcoord[0], v->texcoord[1]);
+        fprintf(file, "vn %.9g %.9g %.9g\n", v->normal[0], v->normal[1], v->normal[2]);
+    }
+    // Material names are kept; the source's mtllib line has to be carried over by hand
+    for (uint32_t r = 0; r < poc_mesh_get_submesh_count(mesh); r++) {
+        poc_submesh range;
+        const poc_material *material;
+        poc_mesh_get_submesh(mesh, r, &range, &material);
+        if (material) {
+            fprintf(file, "usemtl %s\n", poc_string_get(material->name));
+        }
+        for (uint32_t i = range.index_offset; i + 2 < range.index_offset + range.index_count; i += 3) {
+            uint32_t a = mesh->indices[i] + 1;
+            uint32_t b = mesh->indices[i + 1] + 1;
+            uint32_t c = mesh->indices[i + 2] + 1;
+            fprintf(file, "f %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, b, b, b, c, c, c);
+        }
+    }
+
+    bool ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2 && !(argc == 4 && strcmp(argv[2], "-o") == 0)) {
+        printf("Usage: %s <file.obj> [-o out.obj]\n", argv[0]);
+        return 1;
+    }
+
+    // Parse the source every time; a cooked file is already optimized and read-only
+    poc_mesh_set_optimize_on_load(false);
+    poc_mesh_cache_set_enabled(false);
+    poc_mesh *mesh = poc_mesh_load(argv[1]);
+    if (!mesh) {
+        return 1;
+    }
+    if (!mesh->indices || mesh->index_count < 3) {
+        printf("%s has no indexed triangles\n", argv[1]);
+        poc_mesh_destroy(mesh);
+        return 1;
+    }
+
+    printf("%s: %u vertices, %u triangles, cache size %u\n",
+           argv[1], mesh->vertex_count, mesh->index_count / 3, POC_MESH_CACHE_SIZE);
+    report("input", mesh, 0.0);
+
+    // Triangles stay inside their submesh so material ranges remain valid
+    uint32_t range_count = poc_mesh_get_submesh_count(mesh);
+    double start = poc_get_time();
+    for (uint32_t i = 0; i < range_count; i++) {
+        poc_submesh range;
+        poc_mesh_get_submesh(mesh, i, &range, NULL);
+        poc_mesh_optimize_vertex_cache(mesh->indices + range.index_offset, range.index_count,
+                                       mesh->vertex_count, POC_MESH_CACHE_SIZE);
+    }
+    report("vertex cache", mesh, (poc_get_time() - start) * 1000.0);
+
+    start = poc_get_time();
+    uint32_t clusters = 0;
+    for (uint32_t i = 0; i < range_count; i++) {
+        poc_submesh range;
+        poc_mesh_get_submesh(mesh, i, &range, NULL);
+        clusters += poc_mesh_optimize_overdraw(mesh->indices + range.index_offset, range.index_count,
+                                               mesh->vertices, mesh->vertex_count,
+                                               mesh->center, mesh->bounding_radius,
+                                               POC_MESH_OVERDRAW_THRESHOLD);
+    }
+    report("overdraw", mesh, (poc_get_time() - start) * 1000.0);
+    printf("  %u clusters sorted in %u submeshes\n", clusters, range_count);
+
+    start = poc_get_time();
+    uint32_t used = mesh->vertex_count;
+    poc_mesh_optimize_vertex_fetch(mesh->vertices, mesh->vertex_count, mesh->indices, mesh->index_count, &used);
+    if (used < mesh->vertex_count) {
+        printf("  dropped %u unreferenced vertices\n", mesh->vertex_count - used);
+        mesh->vertex_count = used;
+    }
+    report("vertex fetch", mesh, (poc_get_time() - start) * 1000.0);
+
+    int status = 0;
+    if (argc == 4) {
+        if (write_obj(argv[3], mesh)) {
+            printf("Wrote %s\n", argv[3]);
+        } else {
+            printf("Could not write %s\n", argv[3]);
+            status = 1;
+        }
+    }
+
+    poc_mesh_destroy(mesh);
+    return status;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file mesh_residency.c
+ * @brief Report how much CPU memory a mesh holds in each storage mode
+ *
+ * Usage:
+ *   mesh_residency <file.obj>
+ *
+ * Loads the mesh three ways and prints poc_mesh_get_resident_bytes():
+ *   - parsed:   cooked cache off, vertex/index data on the heap
+ *   - mapped:   read through the cooked .pocmesh mapping, before and after
+ *               every vertex and index has been read (as an upload would)
+ *   - released: after poc_mesh_release_geometry(), and again after
+ *               poc_mesh_restore_geometry() maps the file back
+ *
+ * The cooked file is written next to the source if it is missing. At the
+ * end it is re-cooked while the geometry is released, which restoring must
+ * refuse since the mesh's tables belong to the file it was loaded from.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/mesh.h"
+#include "../src/mesh_cache.h"
+
+// Read every byte of the geometry, like a staging buffer copy does
+static uint64_t touch_geometry(const poc_mesh *mesh) {
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < mesh->vertex_count; i++) {
+        sum += (uint64_t)(mesh->vertices[i].position[0] != 0.0f);
+    }
+    for (uint32_t i = 0; i < mesh->index_count; i++) {
+        sum += mesh->indices[i];
+    }
+    return sum;
+}
+
+static void report(const char *stage, const poc_mesh *mesh) {
+    printf("  %-18s %12.1f KiB\n", stage, (double)poc_mesh_get_resident_bytes(mesh) / 1024.0);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        printf("Usage: %s <file.obj>\n", argv[0]);
+        return 1;
+    }
+
+    poc_mesh_cache_set_enabled(false);
+    poc_mesh *parsed = poc_mesh_load(argv[1]);
+    if (!parsed) {
+        return 1;
+    }
+    uint64_t geometry = (uint64_t)parsed->vertex_count * sizeof(poc_vertex) +
+                        (uint64_t)parsed->index_count * sizeof(uint32_t);
+    printf("\n%s: %u vertices, %u indices, %.1f KiB of geometry\n", argv[1],
+           parsed->vertex_count, parsed->index_count, (double)geometry / 1024.0);
+    report("parsed", parsed);
+    poc_mesh_destroy(parsed);
+
+    // Cooks the file if needed; either way the mesh ends up reading the mapping
+    poc_mesh_cache_set_enabled(true);
+    poc_mesh *mesh = poc_mesh_load(argv[1]);
+    if (!mesh || !mesh->mapping.data) {
+        printf("No cooked file could be written or mapped for %s\n", argv[1]);
+        poc_mesh_destroy(mesh);
+        return 1;
+    }
+
+    report("mapped", mesh);
+    uint64_t checksum = touch_geometry(mesh);
+    report("mapped, read", mesh);
+
+    poc_mesh_release_geometry(mesh);
+    report("released", mesh);
+
+    int status = 0;
+    if (!poc_mesh_restore_geometry(mesh) || touch_geometry(mesh) != checksum) {
+        printf("Restored geometry does not match\n");
+        status = 1;
+    }
+    report("restored, read", mesh);
+
+    // Same contents under a new inode; the mesh must not pick it up
+    if (poc_mesh_cache_write(mesh, argv[1], mesh->dependencies, mesh->dependency_count)) {
+        poc_mesh_release_geometry(mesh);
+        if (poc_mesh_restore_geometry(mesh)) {
+            printf("Restored geometry from a re-cooked file\n");
+            status = 1;
+        }
+    }
+
+    poc_mesh_destroy(mesh);
+    return status;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file mtl_bench.c
+ * @brief Measure importing an OBJ with a large material library
+ *
+ * Usage:
+ *   mtl_bench [material_count] [runs]
+ *
+ * Writes an MTL library of material_count (default 10000) materials, the
+ * way CAD exporters emit one per part, into a temporary directory, plus
+ * two OBJ files referencing it:
+ *   - library.obj only loads the library, which times MTL parsing
+ *   - parts.obj has one triangle per material, each selected by usemtl in
+ *     shuffled order, which adds a material lookup per part
+ *
+ * Reports the best of [runs] (default 3) poc_model_load() times, and checks
+ * that every part got its own material and that a usemtl naming no material
+ * in the library falls back to the default material.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/obj_loader.h"
+#include "bench_util.h"
+
+static bool write_library(const char *path, uint32_t count) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        float shade = (float)(i % 256) / 255.0f;
+        fprintf(file, "newmtl part_%05u_steel\nKa 0.100000 0.100000 0.100000\nKd %.6f 0.500000 %.6f\n"
+                      "Ks 0.500000 0.500000 0.500000\nNs %u.000000\nd 1.000000\nillum 2\n\n",
+                i, shade, 1.0f - shade, 16 + i % 64);
+    }
+    bool ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+static bool write_obj(const char *path, uint32_t count, bool parts) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    fprintf(file, "mtllib parts.mtl\nv 0 0 0\nv 1 0 0\nv 0 1 0\n");
+    if (parts) {
+        // A fixed shuffle, so lookups do not follow library order
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t material = (uint32_t)(((uint64_t)i * 7919u) % count);
+            fprintf(file, "g part_%u\nusemtl part_%05u_steel\nf 1 2 3\n", i, material);
+        }
+        fprintf(file, "g stray\nusemtl no_such_material\nf 1 2 3\n");
+    }
+    bool ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+// Every part got a distinct material and the stray group none; the empty
+// group before the first g statement is skipped
+static bool check_parts(const poc_model *model, uint32_t count) {
+    if (model->material_count != count) {
+        return false;
+    }
+    bool *used = calloc(count, sizeof(bool));
+    if (!used) {
+        return false;
+    }
+    const poc_mesh_object *object = &model->objects[0];
+    uint32_t matched = 0;
+    bool stray_default = false;
+    for (uint32_t i = 0; i < object->group_count; i++) {
+        const poc_mesh_group *group = &object->groups[i];
+        if (group->index_count == 0) {
+            continue;
+        }
+        if (strcmp(poc_string_get(group->name), "stray") == 0) {
+            stray_default = group->material_index == UINT32_MAX;
+        } else if (group->material_index < count && !used[group->material_index]) {
+            used[group->material_index] = true;
+            matched++;
+        }
+    }
+    free(used);
+    return matched == count && stray_default;
+}
+
+static bool measure(const char *path, int runs, uint32_t count, bool parts, double *best) {
+    *best = 1e30;
+    for (int i = 0; i < runs; i++) {
+        poc_model model;
+        double start = poc_get_time();
+        poc_obj_result result = poc_model_load(path, &model);
+        double elapsed = poc_get_time() - start;
+        if (result != POC_OBJ_RESULT_SUCCESS) {
+            return false;
+        }
+        bool ok = !parts || check_parts(&model, count);
+        poc_model_destroy(&model);
+        if (!ok) {
+            return false;
+        }
+        if (elapsed < *best) *best = elapsed;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 10000;
+    int runs = argc > 2 ? atoi(argv[2]) : 3;
+    if (count < 2) count = 2;
+    if (count > 99999) count = 99999;
+    if (runs < 1) runs = 1;
+
+    char directory[BENCH_PATH_SIZE];
+    if (!bench_make_temp_dir(directory, NULL, "mtl_bench")) {
+        return 1;
+    }
+    char mtl_path[BENCH_PATH_SIZE], library_path[BENCH_PATH_SIZE], parts_path[BENCH_PATH_SIZE];
+    bench_path(mtl_path, directory, "parts.mtl");
+    bench_path(library_path, directory, "library.obj");
+    bench_path(parts_path, directory, "parts.obj");
+
+    double library = 0.0, parts = 0.0;
+    bool ok = write_library(mtl_path, (uint32_t)count) &&
+              write_obj(library_path, (uint32_t)count, false) &&
+              write_obj(parts_path, (uint32_t)count, true) &&
+              measure(library_path, runs, (uint32_t)count, false, &library) &&
+              measure(parts_path, runs, (uint32_t)count, true, &parts);
+
+    if (ok) {
+        printf("\n%d materials, best of %d:\n", count, runs);
+        printf("  parse library            %8.2f ms\n", library * 1000.0);
+        printf("  parse + %5d usemtl      %8.2f ms\n", count, parts * 1000.0);
+    } else {
+        printf("Could not write or load the test files, or a part got the wrong material\n");
+    }
+
+    bench_remove_temp_dir(directory);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+/**
+ * @file normals_bench.c
+ * @brief Measure import cost of normal generation and mesh bounds
+ *
+ * Usage:
+ *   normals_bench [triangles] [runs]
+ *
+ * Writes a scan-like OBJ: a bumpy sphere of about [triangles] (default
+ * 2000000) triangles with positions only, as photogrammetry and laser scan
+ * exports often are, plus the same surface with "vn" normals. Reports the
+ * best of [runs] (default 3) for:
+ *   - poc_model_load() of both files; the difference is normal generation
+ *   - poc_calculate_smooth_normals() alone, with smoothing off and on
+ *   - poc_mesh_calculate_bounds() against the previous two-pass scalar loop,
+ *     with the radius each one reports
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+#include "../src/obj_loader.h"
+#include "../src/mesh.h"
+#include "../src/job_system.h"
+#include "bench_util.h"
+
+static void sphere_point(uint32_t ring, uint32_t rings, uint32_t segment, uint32_t segments, vec3 out) {
+    float theta = (float)ring / (float)rings * (float)M_PI;
+    float phi = (float)segment / (float)segments * 2.0f * (float)M_PI;
+    float bump = 1.0f + 0.02f * sinf(phi * 37.0f) * sinf(theta * 23.0f);
+    out[0] = bump * sinf(theta) * cosf(phi);
+    out[1] = bump * cosf(theta);
+    out[2] = bump * sinf(theta) * sinf(phi);
+}
+
+// Latitude/longitude grid with a duplicated seam column, like an unwrapped scan
+static bool write_scan(const char *path, uint32_t rings, uint32_t segments, bool with_normals) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+
+    for (uint32_t r = 0; r <= rings; r++) {
+        for (uint32_t s = 0; s <= segments; s++) {
+            vec3 p;
+            sphere_point(r, rings, s, segments, p);
+            fprintf(file, "v %.6f %.6f %.6f\n", p[0], p[1], p[2]);
+            if (with_normals) {
+                glm_vec3_normalize(p);
+                fprintf(file, "vn %.6f %.6f %.6f\n", p[0], p[1], p[2]);
+            }
+        }
+    }
+    for (uint32_t r = 0; r < rings; r++) {
+        for (uint32_t s = 0; s < segments; s++) {
+            uint32_t a = r * (segments + 1) + s + 1;
+            uint32_t b = a + 1;
+            uint32_t c = a + segments + 1;
+            uint32_t d = c + 1;
+            if (with_normals) {
+                fprintf(file, "f %u//%u %u//%u %u//%u\n", a, a, c, c, d, d);
+                fprintf(file, "f %u//%u %u//%u %u//%u\n", a, a, d, d, b, b);
+            } else {
+                fprintf(file, "f %u %u %u\n", a, c, d);
+                fprintf(file, "f %u %u %u\n", a, d, b);
+            }
+        }
+    }
+
+    bool ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+static double time_load(const char *path, int runs, poc_model *keep) {
+    double best = 1e9;
+    for (int i = 0; i < runs; i++) {
+        poc_model model;
+        double start = poc_get_time();
+        if (poc_model_load(path, &model) != POC_OBJ_RESULT_SUCCESS) {
+            return -1.0;
+        }
+        double elapsed = poc_get_time() - start;
+        if (elapsed < best) best = elapsed;
+
+        if (keep && i == runs - 1) {
+            *keep = model;
+        } else {
+            poc_model_destroy(&model);
+        }
+    }
+    return best;
+}
+
+static double time_normals(poc_model *model, uint32_t smoothing_group, int runs) {
+    double best = 1e9;
+    for (int i = 0; i < runs; i++) {
+        for (uint32_t o = 0; o < model->object_count; o++) {
+            for (uint32_t g = 0; g < model->objects[o].group_count; g++) {
+                poc_mesh_group *group = &model->objects[o].groups[g];
+                group->smoothing_group = smoothing_group;
+                for (uint32_t v = 0; v < group->vertex_count; v++) {
+                    glm_vec3_zero(group->vertices[v].normal);
+                }
+            }
+        }
+        double start = poc_get_time();
+        poc_calculate_smooth_normals(model);
+        double elapsed = poc_get_time() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+// The loop poc_mesh_calculate_bounds() used to run: AABB, then radius
+static float two_pass_bounds(const poc_vertex *vertices, uint32_t count, vec3 min, vec3 max) {
+    glm_vec3_copy((vec3){FLT_MAX, FLT_MAX, FLT_MAX}, min);
+    glm_vec3_copy((vec3){-FLT_MAX, -FLT_MAX, -FLT_MAX}, max);
+    for (uint32_t i = 0; i < count; i++) {
+        for (int a = 0; a < 3; a++) {
+            if (vertices[i].position[a] < min[a]) min[a] = vertices[i].position[a];
+            if (vertices[i].position[a] > max[a]) max[a] = vertices[i].position[a];
+        }
+    }
+
+    vec3 center;
+    glm_vec3_add(min, max, center);
+    glm_vec3_scale(center, 0.5f, center);
+    float max_distance_sq = 0.0f;
+    for (uint32_t i = 0; i < count; i++) {
+        vec3 diff;
+        glm_vec3_sub((float *)vertices[i].position, center, diff);
+        float distance_sq = glm_vec3_norm2(diff);
+        if (distance_sq > max_distance_sq) max_distance_sq = distance_sq;
+    }
+    return sqrtf(max_distance_sq);
+}
+
+int main(int argc, char **argv) {
+    long triangles = argc > 1 ? atol(argv[1]) : 2000000;
+    int runs = argc > 2 ? atoi(argv[2]) : 3;
+    if (triangles < 8) triangles = 8;
+    if (runs < 1) runs = 1;
+
+    uint32_t rings = (uint32_t)sqrt((double)triangles / 4.0);
+    uint32_t segments = 2 * rings;
+
+    char directory[BENCH_PATH_SIZE];
+    if (!bench_make_temp_dir(directory, NULL, "normals_bench")) {
+        return 1;
+    }
+    char bare[BENCH_PATH_SIZE], with_normals[BENCH_PATH_SIZE];
+    bench_path(bare, directory, "scan.obj");
+    bench_path(with_normals, directory, "scan_vn.obj");
+
+    poc_jobs_init(0);
+    bool ok = write_scan(bare, rings, segments, false) && write_scan(with_normals, rings, segments, true);
+
+    poc_model model = {0};
+    double load_bare = ok ? time_load(bare, runs, &model) : -1.0;
+    double load_normals = ok ? time_load(with_normals, runs, NULL) : -1.0;
+    ok = ok && load_bare >= 0.0 && load_normals >= 0.0;
+
+    if (ok) {
+        const poc_mesh_group *group = &model.objects[0].groups[0];
+        printf("\n%u vertices, %u triangles, %u worker threads\n",
+               group->vertex_count, group->index_count / 3, poc_jobs_get_worker_count());
+        printf("%-30s %10.2f ms\n", "load, positions only", load_bare * 1000.0);
+        printf("%-30s %10.2f ms\n", "load, with vn", load_normals * 1000.0);
+        printf("%-30s %10.2f ms\n", "normals, smoothing off", time_normals(&model, 0, runs) * 1000.0);
+        printf("%-30s %10.2f ms\n", "normals, smoothing group", time_normals(&model, 1, runs) * 1000.0);
+
+        poc_mesh *mesh = poc_mesh_create();
+        ok = mesh != NULL;
+        if (ok) {
+            mesh->vertices = group->vertices;
+            mesh->vertex_count = group->vertex_count;
+
+            double one_pass = 1e9, two_pass = 1e9;
+            float reference = 0.0f;
+            for (int i = 0; i < runs; i++) {
+                double start = poc_get_time();
+                poc_mesh_calculate_bounds(mesh);
+                double elapsed = poc_get_time() - start;
+                if (elapsed < one_pass) one_pass = elapsed;
+
+                vec3 min, max;
+                start = poc_get_time();
+                reference = two_pass_bounds(group->vertices, group->vertex_count, min, max);
+                elapsed = poc_get_time() - start;
+                if (elapsed < two_pass) two_pass = elapsed;
+            }
+            printf("%-30s %10.2f ms  (radius %.5f)\n", "bounds, one pass", one_pass * 1000.0, mesh->bounding_radius);
+            printf("%-30s %10.2f ms  (radius %.5f)\n", "bounds, two pass scalar", two_pass * 1000.0, reference);
+
+            // The mesh borrows the model's arrays
+            mesh->vertices = NULL;
+            poc_mesh_destroy(mesh);
+        }
+        poc_model_destroy(&model);
+    } else {
+        printf("Could not write or load the scan\n");
+    }
+
+    poc_jobs_shutdown();
+    bench_remove_temp_dir(directory);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file obj_bench.c
+ * @brief OBJ parse throughput benchmark
+ *
+ * Usage:
+ *   obj_bench <file.obj> [runs] [chunks]  Load a file and report MB/s
+ *   obj_bench --generate <out.obj> <MB>   Write a synthetic textured grid mesh
+ *
+ * Each run loads the file with poc_model_load(); the best run is reported so
+ * the numbers reflect parsing rather than a cold page cache. Passing a chunk
+ * count overrides the parallel split (1 parses on the calling thread).
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/obj_loader.h"
+#include "bench_util.h"
+
+// Grid of quads split into triangles, written in the layout exporters use
+static int generate(const char *path, double megabytes) {
+    // A grid vertex costs about 180 bytes of text with its two faces
+    bench_grid grid = {.side = 1, .bumpy = true, .attributes = true};
+    while ((double)(grid.side + 1) * (grid.side + 1) * 180.0 < megabytes * 1024.0 * 1024.0) grid.side++;
+
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        printf("Could not create %s\n", path);
+        return 1;
+    }
+    fprintf(file, "# obj_bench grid %ux%u\no grid\ng surface\ns 1\n", grid.side, grid.side);
+    bool ok = bench_write_grid(file, &grid);
+    long size = ftell(file);
+    if (fclose(file) != 0 || !ok) {
+        printf("Could not write %s\n", path);
+        return 1;
+    }
+    printf("✓ Wrote %s: %.1f MB, %u vertices\n", path, (double)size / (1024.0 * 1024.0),
+           (grid.side + 1) * (grid.side + 1));
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 4 && strcmp(argv[1], "--generate") == 0) {
+        return generate(argv[2], atof(argv[3]));
+    }
+    if (argc < 2) {
+        printf("Usage: %s <file.obj> [runs] [chunks]\n       %s --generate <out.obj> <MB>\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    const char *path = argv[1];
+    int runs = argc >= 3 ? atoi(argv[2]) : 3;
+    if (runs < 1) runs = 1;
+    if (argc >= 4) {
+        poc_obj_set_chunk_count((uint32_t)atoi(argv[3]));
+    }
+
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        printf("Could not open %s\n", path);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    double megabytes = (double)ftell(file) / (1024.0 * 1024.0);
+    fclose(file);
+
+    double best = 0.0;
+    for (int run = 0; run < runs; run++) {
+        poc_model model;
+        double start = poc_get_time();
+        poc_obj_result result = poc_model_load(path, &model);
+        double elapsed = poc_get_time() - start;
+
+        if (result != POC_OBJ_RESULT_SUCCESS) {
+            printf("Failed to load %s: %s\n", path, poc_obj_result_to_string(result));
+            return 1;
+        }
+
+        uint64_t vertices = 0;
+        uint64_t triangles = 0;
+        for (uint32_t i = 0; i < model.object_count; i++) {
+            for (uint32_t j = 0; j < model.objects[i].group_count; j++) {
+                vertices += model.objects[i].groups[j].vertex_count;
+                triangles += model.objects[i].groups[j].index_count / 3;
+            }
+        }
+
+        printf("Run %d: %.3f s, %.1f MB/s (%u positions, %llu vertices, %llu triangles)\n",
+               run + 1, elapsed, megabytes / elapsed, model.position_count,
+               (unsigned long long)vertices, (unsigned long long)triangles);
+        if (run == 0 && vertices > 0) {
+            printf("Welded %llu face corners into %llu vertices: %.2fx, %.1f MB saved\n",
+                   (unsigned long long)model.corner_count, (unsigned long long)vertices,
+                   (double)model.corner_count / (double)vertices,
+                   (double)(model.corner_count - vertices) * sizeof(poc_vertex) / (1024.0 * 1024.0));
+        }
+        if (run == 0 || elapsed < best) best = elapsed;
+
+        poc_model_destroy(&model);
+    }
+
+    printf("✓ %s: %.1f MB, best %.3f s, %.1f MB/s\n", path, megabytes, best, megabytes / best);
+    return 0;
+}
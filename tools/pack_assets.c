@@ -0,0 +1,33 @@
+/**
+ * @file pack_assets.c
+ * @brief Pack asset files and directories into a .pocpak archive
+ *
+ * Usage:
+ *   pack_assets <archive> <file or directory>...
+ *
+ * Run from the directory the engine runs in and name inputs relative to it,
+ * since files are stored (and looked up) under the paths given here:
+ *
+ *   tools/pack_assets assets.pocpak models scripts shaders deps/teal/tl.lua
+ *
+ * Cooked meshes lying next to their sources are packed when they are still
+ * current, so run the engine once (or let it cook) before packing to skip
+ * OBJ parsing at startup as well.
+ */
+
+#include <stdio.h>
+
+#include "../src/asset_archive.h"
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        printf("Usage: %s <archive> <file or directory>...\n", argv[0]);
+        return 1;
+    }
+
+    if (!poc_archive_build(argv[1], (const char *const *)(argv + 2), (uint32_t)(argc - 2))) {
+        printf("Could not write %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
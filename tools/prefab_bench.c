@@ -0,0 +1,247 @@
+/**
+ * @file prefab_bench.c
+ * @brief Measure what prefab instances save over plain object hierarchies
+ *
+ * Usage:
+ *   prefab_bench [instances]
+ *
+ * Places [instances] (default 10000) copies of a three-node lamp post (base,
+ * pole, light) on a grid three ways and reports CPU-side scene memory (see
+ * poc_scene_get_memory_stats) and saved file size for each:
+ *   - flat:      every copy is a root with three ordinary child objects
+ *   - expanded:  every copy is a prefab instance, all of them expanded
+ *   - ranged:    the same instances with poc_scene_set_prefab_range()
+ *                covering a corner of the grid
+ *
+ * The ranged layout is also checked while the range center crosses the
+ * grid: after every update, instances within the radius must be expanded
+ * and those beyond 1.25 times the radius collapsed. A node edit made before
+ * its instance collapses must be back after it expands again. Runs without
+ * a renderer, so renderables (one per node with a mesh, each with its own
+ * uniform buffer) are not part of the numbers; collapsed instances hold
+ * none.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/stat.h>
+
+#include "../src/prefab.h"
+#include "../src/scene.h"
+#include "../src/scene_object.h"
+#include "bench_util.h"
+
+#define SPACING 4.0f
+#define RANGE_RADIUS 40.0f
+#define NODE_COUNT 3
+
+static const char *g_node_names[NODE_COUNT] = {"base", "pole", "light"};
+static const float g_node_heights[NODE_COUNT] = {0.0f, 0.5f, 4.0f};
+
+static bool write_prefab(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    fprintf(file, "poc_scene v1\n");
+    for (uint32_t i = 0; i < NODE_COUNT; i++) {
+        fprintf(file, "[object]\nid=%u\nname=\"%s\"\nposition=0 %.1f 0\n", i + 1, g_node_names[i], g_node_heights[i]);
+        if (i > 0) {
+            fprintf(file, "parent=%u\n", i);
+        }
+        fprintf(file, "[end]\n");
+    }
+    return fclose(file) == 0;
+}
+
+static void grid_position(uint32_t index, uint32_t side, vec3 out) {
+    out[0] = (float)(index % side) * SPACING;
+    out[1] = 0.0f;
+    out[2] = (float)(index / side) * SPACING;
+}
+
+static poc_scene *build_flat(uint32_t count, uint32_t side) {
+    poc_scene *scene = poc_scene_create();
+    for (uint32_t i = 0; scene && i < count; i++) {
+        poc_scene_object *root = poc_scene_object_create("lamp", poc_scene_get_next_object_id(scene));
+        vec3 position;
+        grid_position(i, side, position);
+        poc_scene_object_set_position(root, position);
+        poc_scene_add_object(scene, root);
+
+        poc_scene_object *parent = root;
+        for (uint32_t n = 0; n < NODE_COUNT; n++) {
+            poc_scene_object *node = poc_scene_object_create(g_node_names[n], poc_scene_get_next_object_id(scene));
+            poc_scene_object_set_position(node, (vec3){0.0f, g_node_heights[n], 0.0f});
+            poc_scene_add_object(scene, node);
+            poc_scene_object_add_child(parent, node);
+            parent = node;
+        }
+    }
+    poc_scene_update(scene);
+    return scene;
+}
+
+static poc_scene *build_instanced(poc_prefab *prefab, uint32_t count, uint32_t side) {
+    poc_scene *scene = poc_scene_create();
+    for (uint32_t i = 0; scene && i < count; i++) {
+        poc_scene_object *root = poc_prefab_instantiate(prefab, "lamp", poc_scene_get_next_object_id(scene));
+        vec3 position;
+        grid_position(i, side, position);
+        poc_scene_object_set_position(root, position);
+        poc_scene_add_object(scene, root);
+    }
+    return scene;
+}
+
+typedef struct {
+    uint64_t bytes;
+    uint32_t objects;
+    long file_size;
+} measurement;
+
+static bool measure(poc_scene *scene, const char *path, measurement *out) {
+    poc_scene_memory_stats stats;
+    poc_scene_get_memory_stats(scene, &stats);
+    out->bytes = stats.object_bytes + stats.bookkeeping_bytes;
+    out->objects = stats.object_count;
+
+    struct stat info;
+    if (!poc_scene_save_to_file(scene, path) || stat(path, &info) != 0) {
+        return false;
+    }
+    out->file_size = (long)info.st_size;
+    return true;
+}
+
+// Every instance within the radius expanded, every one beyond the margin collapsed
+static bool check_range(poc_scene *scene, const vec3 center, uint32_t *expanded) {
+    *expanded = 0;
+    for (uint32_t i = 0; i < scene->object_count; i++) {
+        poc_scene_object *root = scene->objects[i];
+        if (!root->prefab_instance) {
+            continue;
+        }
+
+        vec3 position = {root->position[0], root->position[1], root->position[2]};
+        vec3 focus = {center[0], center[1], center[2]};
+        float distance = glm_vec3_distance(position, focus);
+        bool is_expanded = root->prefab_instance->nodes != NULL;
+        if ((distance <= RANGE_RADIUS && !is_expanded) || (distance > RANGE_RADIUS * 1.25f && is_expanded)) {
+            printf("Instance %u at distance %.1f is %s\n", root->id, distance, is_expanded ? "expanded" : "collapsed");
+            return false;
+        }
+        *expanded += is_expanded ? 1 : 0;
+    }
+    return true;
+}
+
+static bool run_range(poc_scene *scene, uint32_t side, const char *path, measurement *out) {
+    vec3 center = {0.0f, 0.0f, 0.0f};
+    poc_scene_set_prefab_range(scene, center, RANGE_RADIUS);
+    poc_scene_update(scene);
+
+    uint32_t expanded = 0;
+    if (!check_range(scene, center, &expanded) || !measure(scene, path, out)) {
+        return false;
+    }
+    printf("ranged: %u instances expanded around the origin\n", expanded);
+
+    // Move the first instance's light; the edit must survive a collapse
+    poc_scene_object *first = scene->objects[0];
+    poc_scene_object *light = first->prefab_instance ? first->prefab_instance->nodes[NODE_COUNT - 1] : NULL;
+    if (!light) {
+        printf("First instance did not expand\n");
+        return false;
+    }
+    poc_scene_object_set_position(light, (vec3){1.0f, 6.0f, 0.0f});
+
+    // Walk the range center diagonally across the grid and back
+    float extent = (float)(side - 1) * SPACING;
+    double worst = 0.0;
+    for (int step = 0; step <= 40; step++) {
+        float t = step <= 20 ? (float)step / 20.0f : (float)(40 - step) / 20.0f;
+        center[0] = center[2] = t * extent;
+        poc_scene_set_prefab_range(scene, center, RANGE_RADIUS);
+
+        double start = poc_get_time();
+        poc_scene_update(scene);
+        double elapsed = poc_get_time() - start;
+        if (elapsed > worst) worst = elapsed;
+
+        if (!check_range(scene, center, &expanded)) {
+            return false;
+        }
+    }
+    printf("ranged: walk passed, %.2f ms slowest update\n", worst * 1000.0);
+
+    light = first->prefab_instance->nodes ? first->prefab_instance->nodes[NODE_COUNT - 1] : NULL;
+    if (!light || light->position[1] != 6.0f) {
+        printf("Node edit was lost across collapse and expansion\n");
+        return false;
+    }
+
+    // Clearing the range expands everything again
+    poc_scene_set_prefab_range(scene, center, 0.0f);
+    poc_scene_update(scene);
+    for (uint32_t i = 0; i < scene->object_count; i++) {
+        if (scene->objects[i]->prefab_instance && !scene->objects[i]->prefab_instance->nodes) {
+            printf("Instance %u stayed collapsed without a range\n", scene->objects[i]->id);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 10000;
+    if (count < 1) count = 1;
+    uint32_t side = (uint32_t)ceil(sqrt((double)count));
+
+    char directory[BENCH_PATH_SIZE];
+    if (!bench_make_temp_dir(directory, NULL, "prefab_bench")) {
+        return 1;
+    }
+    char prefab_path[BENCH_PATH_SIZE], scene_path[BENCH_PATH_SIZE];
+    bench_path(prefab_path, directory, "lamp.scene");
+    bench_path(scene_path, directory, "level.scene");
+
+    measurement flat = {0}, expanded = {0}, ranged = {0};
+    poc_prefab *prefab = write_prefab(prefab_path) ? poc_prefab_load(prefab_path) : NULL;
+    bool ok = prefab != NULL;
+
+    if (ok) {
+        poc_scene *scene = build_flat((uint32_t)count, side);
+        ok = scene && measure(scene, scene_path, &flat);
+        poc_scene_destroy(scene, true);
+    }
+    if (ok) {
+        poc_scene *scene = build_instanced(prefab, (uint32_t)count, side);
+        poc_scene_update(scene);
+        ok = scene && measure(scene, scene_path, &expanded);
+        poc_scene_destroy(scene, true);
+    }
+    if (ok) {
+        poc_scene *scene = build_instanced(prefab, (uint32_t)count, side);
+        ok = scene && run_range(scene, side, scene_path, &ranged);
+        poc_scene_destroy(scene, true);
+    }
+    poc_prefab_release(prefab);
+
+    if (ok) {
+        printf("\n%d lamp posts of %d nodes:\n", count, NODE_COUNT);
+        printf("  %-10s %10s %12s %12s\n", "", "objects", "memory", "file");
+        printf("  %-10s %10u %9.1f KiB %9.1f KiB\n", "flat", flat.objects, flat.bytes / 1024.0, flat.file_size / 1024.0);
+        printf("  %-10s %10u %9.1f KiB %9.1f KiB\n", "expanded", expanded.objects, expanded.bytes / 1024.0, expanded.file_size / 1024.0);
+        printf("  %-10s %10u %9.1f KiB %9.1f KiB\n", "ranged", ranged.objects, ranged.bytes / 1024.0, ranged.file_size / 1024.0);
+        printf("All prefab checks passed\n");
+    } else {
+        printf("Prefab checks failed\n");
+    }
+
+    bench_remove_temp_dir(directory);
+    return ok ? 0 : 1;
+}
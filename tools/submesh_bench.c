@@ -0,0 +1,226 @@
+/**
+ * @file submesh_bench.c
+ * @brief Compare a packed multi-material mesh against one file per group
+ *
+ * Usage:
+ *   submesh_bench <file.obj> [runs]
+ *
+ * Splits every non-empty group of the OBJ into its own OBJ in a temporary
+ * directory (material libraries are copied along), then reports the best of
+ * [runs] (default 3) for:
+ *   - packed: poc_mesh_load() of the original, which puts all groups into
+ *             one vertex/index buffer with a submesh range per material
+ *   - split:  poc_mesh_load() of every group file
+ *
+ * Besides load time it prints CPU mesh bytes, the draw calls each variant
+ * needs and the GPU objects it would create (vertex buffer, index buffer,
+ * uniform buffer and descriptor set per mesh). The cooked cache and the
+ * optimize stage are disabled so both sides do the same parsing work.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/mesh.h"
+#include "../src/mesh_cache.h"
+#include "../src/mesh_optimize.h"
+#include "bench_util.h"
+
+// GPU objects per loaded mesh: vertex buffer, index buffer, uniform buffer, descriptor set
+#define GPU_OBJECTS_PER_MESH 4
+
+static uint64_t mesh_bytes(const poc_mesh *mesh) {
+    return sizeof(poc_mesh) +
+           (uint64_t)mesh->vertex_count * sizeof(poc_vertex) +
+           (uint64_t)mesh->index_count * sizeof(uint32_t) +
+           (uint64_t)mesh->submesh_count * sizeof(poc_submesh) +
+           (uint64_t)mesh->material_count * sizeof(poc_material);
+}
+
+static bool copy_file(const char *from, const char *to) {
+    FILE *in = fopen(from, "rb");
+    if (!in) {
+        return false;
+    }
+    FILE *out = fopen(to, "wb");
+    if (!out) {
+        fclose(in);
+        return false;
+    }
+
+    char buffer[65536];
+    size_t n;
+    bool ok = true;
+    while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        ok = ok && fwrite(buffer, 1, n, out) == n;
+    }
+    ok = ok && !ferror(in);
+    fclose(in);
+    return fclose(out) == 0 && ok;
+}
+
+static bool write_group(const char *path, const poc_model *model, const poc_mesh_group *group) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+
+    // Copies of the libraries sit next to the group files
+    for (uint32_t i = 0; i < model->material_library_count; i++) {
+        const char *library = poc_string_get(model->material_libraries[i]);
+        const char *slash = strrchr(library, '/');
+        fprintf(file, "mtllib %s\n", slash ? slash + 1 : library);
+    }
+    for (uint32_t i = 0; i < group->vertex_count; i++) {
+        const poc_vertex *v = &group->vertices[i];
+        fprintf(file, "v %.9g %.9g %.9g\n", v->position[0], v->position[1], v->position[2]);
+        fprintf(file, "vt %.9g %.9g\n", v->texcoord[0], v->texcoord[1]);
+        fprintf(file, "vn %.9g %.9g %.9g\n", v->normal[0], v->normal[1], v->normal[2]);
+    }
+    if (group->material_index < model->material_count) {
+        fprintf(file, "usemtl %s\n", poc_string_get(model->materials[group->material_index].name));
+    }
+    for (uint32_t i = 0; i + 2 < group->index_count; i += 3) {
+        uint32_t a = group->indices[i] + 1;
+        uint32_t b = group->indices[i + 1] + 1;
+        uint32_t c = group->indices[i + 2] + 1;
+        fprintf(file, "f %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, b, b, b, c, c, c);
+    }
+
+    bool ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+// Write one OBJ per non-empty group into directory and return how many.
+// out_paths lists every file created, group files first
+static uint32_t split_model(const char *source, const char *directory, char ***out_paths, uint32_t *out_created) {
+    poc_model model;
+    if (poc_model_load(source, &model) != POC_OBJ_RESULT_SUCCESS) {
+        return 0;
+    }
+
+    uint32_t group_total = 0;
+    for (uint32_t o = 0; o < model.object_count; o++) {
+        group_total += model.objects[o].group_count;
+    }
+    char **paths = calloc(group_total + model.material_library_count + 1, sizeof(char *));
+    uint32_t count = 0;
+    for (uint32_t o = 0; paths && o < model.object_count; o++) {
+        for (uint32_t g = 0; g < model.objects[o].group_count; g++) {
+            const poc_mesh_group *group = &model.objects[o].groups[g];
+            if (group->index_count == 0) {
+                continue;
+            }
+            char name[32], path[BENCH_PATH_SIZE];
+            snprintf(name, sizeof(name), "group_%u.obj", count);
+            bench_path(path, directory, name);
+            if (!write_group(path, &model, group)) {
+                printf("Could not write %s\n", path);
+                continue;
+            }
+            paths[count++] = strdup(path);
+        }
+    }
+
+    // Material libraries are resolved relative to the OBJ, so copy them
+    // next to the group files; the model records their full paths
+    uint32_t created = count;
+    for (uint32_t i = 0; paths && i < model.material_library_count; i++) {
+        const char *library = poc_string_get(model.material_libraries[i]);
+        const char *slash = strrchr(library, '/');
+        char to[BENCH_PATH_SIZE];
+        bench_path(to, directory, slash ? slash + 1 : library);
+        if (!copy_file(library, to)) {
+            printf("⚠ Could not copy material library %s\n", library);
+            continue;
+        }
+        paths[created++] = strdup(to);
+    }
+
+    poc_model_destroy(&model);
+    *out_paths = paths;
+    *out_created = created;
+    return count;
+}
+
+typedef struct {
+    double seconds;
+    uint64_t bytes;
+    uint32_t meshes;
+    uint32_t draws;
+} variant;
+
+static bool load_all(char **paths, uint32_t count, variant *best) {
+    uint64_t bytes = 0;
+    uint32_t draws = 0;
+    double start = poc_get_time();
+    for (uint32_t i = 0; i < count; i++) {
+        poc_mesh *mesh = poc_mesh_load(paths[i]);
+        if (!mesh) {
+            return false;
+        }
+        bytes += mesh_bytes(mesh);
+        draws += poc_mesh_get_submesh_count(mesh);
+        poc_mesh_destroy(mesh);
+    }
+    double elapsed = poc_get_time() - start;
+
+    if (elapsed < best->seconds) {
+        best->seconds = elapsed;
+    }
+    best->bytes = bytes;
+    best->meshes = count;
+    best->draws = draws;
+    return true;
+}
+
+static void print_variant(const char *name, const variant *v) {
+    printf("%-7s %10.2f %12.1f %8u %8u %12u\n", name, v->seconds * 1000.0, (double)v->bytes / 1024.0,
+           v->meshes, v->draws, v->meshes * GPU_OBJECTS_PER_MESH);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        printf("Usage: %s <file.obj> [runs]\n", argv[0]);
+        return 1;
+    }
+    char *source = argv[1];
+    int runs = argc > 2 ? atoi(argv[2]) : 3;
+    if (runs < 1) runs = 1;
+
+    poc_mesh_cache_set_enabled(false);
+    poc_mesh_set_optimize_on_load(false);
+
+    char directory[BENCH_PATH_SIZE];
+    if (!bench_make_temp_dir(directory, NULL, "submesh_bench")) {
+        return 1;
+    }
+
+    char **paths = NULL;
+    uint32_t created = 0;
+    uint32_t file_count = split_model(source, directory, &paths, &created);
+
+    variant packed = {1e9, 0, 0, 0}, split = {1e9, 0, 0, 0};
+    bool ok = file_count > 0;
+    if (!ok) {
+        printf("%s has no groups with geometry\n", source);
+    }
+    for (int i = 0; ok && i < runs; i++) {
+        ok = load_all(&source, 1, &packed) && load_all(paths, file_count, &split);
+    }
+
+    if (ok) {
+        printf("\n%-7s %10s %12s %8s %8s %12s\n", "", "load ms", "CPU KiB", "meshes", "draws", "GPU objects");
+        print_variant("packed", &packed);
+        print_variant("split", &split);
+    }
+
+    for (uint32_t i = 0; i < created; i++) {
+        free(paths[i]);
+    }
+    free(paths);
+    bench_remove_temp_dir(directory);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file transform_sync.c
+ * @brief Check that renderables pick up transforms consumed elsewhere
+ *
+ * Usage:
+ *   transform_sync
+ *
+ * Renderables receive their object's transform when they are drawn, which
+ * must work even when something else ran poc_scene_update() and took the
+ * scene's changed list first. Two cases are checked:
+ *   - threaded: objects move while snapshots are captured for a render
+ *               thread; after switching back to drawing on this thread,
+ *               one frame must leave every model matrix current
+ *   - external: the application calls poc_scene_update() itself before
+ *               the frame
+ *
+ * Needs a window and a Vulkan device; exits 0 without checking when none
+ * can be created.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "poc_engine.h"
+#include "../src/frame_loop.h"
+#include "../src/scene_object.h"
+#include "../src/scripting.h"
+
+#define OBJECT_COUNT 8
+
+static bool draw_frame(poc_context *ctx) {
+    poc_result result = poc_context_begin_frame(ctx);
+    if (result == POC_RESULT_SUCCESS) {
+        result = poc_context_end_frame(ctx);
+    }
+    if (result != POC_RESULT_SUCCESS) {
+        printf("Frame failed: %s\n", poc_result_to_string(result));
+        return false;
+    }
+    return true;
+}
+
+static void move_objects(poc_scene_object **objects, float offset) {
+    for (uint32_t i = 0; i < OBJECT_COUNT; i++) {
+        poc_scene_object_set_position(objects[i], (vec3){(float)i * 3.0f, offset, -10.0f});
+        poc_scene_object_set_rotation(objects[i], (vec3){0.0f, offset * 10.0f, 0.0f});
+    }
+}
+
+static uint32_t count_stale(poc_scene_object **objects) {
+    uint32_t stale = 0;
+    for (uint32_t i = 0; i < OBJECT_COUNT; i++) {
+        mat4 drawn;
+        poc_renderable_get_transform(objects[i]->renderable, drawn);
+        if (memcmp(drawn, *poc_scene_object_get_transform_matrix(objects[i]), sizeof(mat4)) != 0) {
+            stale++;
+        }
+    }
+    return stale;
+}
+
+static int run(podi_application *app) {
+    if (poc_init(&(poc_config){ .renderer_type = POC_RENDERER_VULKAN, .app_name = "transform_sync" }) != POC_RESULT_SUCCESS) {
+        printf("No renderer available, skipping\n");
+        return 0;
+    }
+
+    podi_window *window = podi_window_create(app, "transform_sync", 320, 240);
+    poc_context *ctx = window ? poc_context_create(window) : NULL;
+    if (!ctx) {
+        printf("No window or rendering context available, skipping\n");
+        if (window) podi_window_destroy(window);
+        poc_shutdown();
+        return 0;
+    }
+    poc_scripting_set_context(ctx);
+
+    poc_scene *scene = poc_scene_create();
+    poc_mesh *mesh = poc_asset_acquire_mesh("models/cube.obj");
+    poc_scene_object *objects[OBJECT_COUNT];
+    int status = scene && mesh ? 0 : 1;
+    for (uint32_t i = 0; status == 0 && i < OBJECT_COUNT; i++) {
+        objects[i] = poc_scene_object_create("cube", poc_scene_get_next_object_id(scene));
+        poc_scene_object_set_mesh(objects[i], mesh);
+        if (!objects[i]->renderable || !poc_scene_add_object(scene, objects[i])) {
+            printf("Could not set up object %u\n", i);
+            status = 1;
+        }
+    }
+
+    if (status == 0) {
+        poc_context_set_scene(ctx, scene);
+        move_objects(objects, 0.0f);
+        status = draw_frame(ctx) && count_stale(objects) == 0 ? 0 : 1;
+    }
+
+    if (status == 0 && poc_context_supports_snapshots(ctx)) {
+        // Captures consume the changed list the way the frame loop does
+        poc_render_snapshot snapshot = {0};
+        poc_context_set_threaded(ctx, true);
+        for (int frame = 1; frame <= 3; frame++) {
+            move_objects(objects, (float)frame);
+            poc_context_capture_snapshot(ctx, &snapshot);
+        }
+        poc_context_set_threaded(ctx, false);
+        free(snapshot.items);
+        free(snapshot.materials);
+
+        if (!draw_frame(ctx)) {
+            status = 1;
+        } else {
+            uint32_t stale = count_stale(objects);
+            printf("threaded: %u of %u model matrices stale\n", stale, OBJECT_COUNT);
+            status = stale == 0 ? 0 : 1;
+        }
+    }
+
+    if (status == 0) {
+        move_objects(objects, 5.0f);
+        poc_scene_update(scene);
+        if (!draw_frame(ctx)) {
+            status = 1;
+        } else {
+            uint32_t stale = count_stale(objects);
+            printf("external: %u of %u model matrices stale\n", stale, OBJECT_COUNT);
+            status = stale == 0 ? 0 : 1;
+        }
+    }
+
+    poc_context_set_scene(ctx, NULL);
+    if (scene) poc_scene_destroy(scene, true);
+    poc_asset_release_mesh(mesh);
+    poc_context_destroy(ctx);
+    podi_window_destroy(window);
+    poc_shutdown();
+    return status;
+}
+
+int main(void) {
+    return podi_main(run);
+}
@@ -0,0 +1,368 @@
+/**
+ * @file world_stream_bench.c
+ * @brief Stream a generated world and check which cells are resident
+ *
+ * Usage:
+ *   world_stream_bench [grid] [objects_per_cell]
+ *
+ * Writes a partitioned scene of [grid] x [grid] (default 12) cells with
+ * [objects_per_cell] (default 16) objects each into a temporary directory,
+ * then drives poc_world_stream_update() without a renderer:
+ *   - walk:     a viewpoint crosses the grid; after each step settles, the
+ *               cells in the scene must be exactly those inside the load
+ *               radius plus those still inside the unload radius that were
+ *               resident before (the hysteresis band)
+ *   - budget:   with a zero integration budget every update creates one
+ *               object, so no more than one cell per objects_per_cell
+ *               updates may become resident
+ *   - inflight: cells requested while every worker is busy are left behind
+ *               before their loads run; none of their objects may appear
+ *               once the loads finish
+ *
+ * After every update a cell must have all of its objects in the scene or
+ * none. Each phase ends by closing the stream, which must leave the scene
+ * empty. Update times are reported per phase.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdatomic.h>
+
+#include "../src/job_system.h"
+#include "../src/mesh_cache.h"
+#include "../src/scene.h"
+#include "../src/scene_file.h"
+#include "../src/scene_object.h"
+#include "../src/world_stream.h"
+#include "bench_util.h"
+
+#define CELL_SIZE 10.0f
+#define LOAD_RADIUS 14.5f
+#define UNLOAD_RADIUS 24.5f
+#define SETTLE_LIMIT 100000
+
+typedef struct {
+    const char *path;
+    uint32_t grid;
+    uint32_t objects_per_cell;
+    uint32_t *counts;       // Streamed objects per cell, refreshed by count_cells()
+    bool *expected;         // Cells that should be resident
+} world;
+
+static float cell_distance(uint32_t x, uint32_t z, const vec3 position) {
+    float min_x = (float)x * CELL_SIZE;
+    float min_z = (float)z * CELL_SIZE;
+    float dx = fmaxf(fmaxf(min_x - position[0], 0.0f), position[0] - (min_x + CELL_SIZE));
+    float dz = fmaxf(fmaxf(min_z - position[2], 0.0f), position[2] - (min_z + CELL_SIZE));
+    return sqrtf(dx * dx + dz * dz);
+}
+
+// Count scene objects per cell; false if a cell is only partly in the scene
+static bool count_cells(world *w, const poc_scene *scene) {
+    memset(w->counts, 0, sizeof(uint32_t) * w->grid * w->grid);
+    for (uint32_t i = 0; i < scene->object_count; i++) {
+        const poc_scene_object *obj = scene->objects[i];
+        if (!obj) {
+            continue;
+        }
+        int32_t x, z;
+        poc_scene_file_cell_of(CELL_SIZE, obj->position, &x, &z);
+        if (x < 0 || z < 0 || (uint32_t)x >= w->grid || (uint32_t)z >= w->grid) {
+            printf("Object '%s' lies outside the grid\n", poc_scene_object_get_name(obj));
+            return false;
+        }
+        w->counts[(uint32_t)z * w->grid + (uint32_t)x]++;
+    }
+
+    for (uint32_t i = 0; i < w->grid * w->grid; i++) {
+        if (w->counts[i] != 0 && w->counts[i] != w->objects_per_cell) {
+            printf("Cell (%u, %u) has %u of %u objects in the scene\n",
+                   i % w->grid, i / w->grid, w->counts[i], w->objects_per_cell);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Hysteresis: keep what is still inside the unload radius, add what is
+// inside the load radius
+static void expect_around(world *w, const vec3 position) {
+    for (uint32_t z = 0; z < w->grid; z++) {
+        for (uint32_t x = 0; x < w->grid; x++) {
+            bool *expected = &w->expected[z * w->grid + x];
+            float distance = cell_distance(x, z, position);
+            *expected = distance <= LOAD_RADIUS || (*expected && distance <= UNLOAD_RADIUS);
+        }
+    }
+}
+
+static bool check_expected(world *w, const char *phase, const vec3 position) {
+    bool ok = true;
+    for (uint32_t i = 0; i < w->grid * w->grid; i++) {
+        bool resident = w->counts[i] != 0;
+        if (resident != w->expected[i]) {
+            printf("%s at (%.1f, %.1f): cell (%u, %u) is %s but should %s\n", phase, position[0], position[2],
+                   i % w->grid, i / w->grid, resident ? "resident" : "missing", w->expected[i] ? "be" : "not be");
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// Update until nothing is loading or waiting to be integrated
+static bool settle(world *w, poc_world_stream *stream, poc_scene *scene, const vec3 position, uint32_t *updates) {
+    for (uint32_t i = 0; i < SETTLE_LIMIT; i++) {
+        poc_world_stream_update(stream, position);
+        (*updates)++;
+        if (!count_cells(w, scene)) {
+            return false;
+        }
+
+        poc_world_stream_stats stats;
+        poc_world_stream_get_stats(stream, &stats);
+        if (stats.cells_loading == 0) {
+            return true;
+        }
+        poc_sleep(0.0002);
+    }
+    printf("Streaming did not settle at (%.1f, %.1f)\n", position[0], position[2]);
+    return false;
+}
+
+static poc_world_stream *open_stream(world *w, poc_scene *scene, double integrate_budget_ms) {
+    poc_world_stream_config config;
+    poc_world_stream_config_defaults(&config);
+    config.load_radius = LOAD_RADIUS;
+    config.unload_radius = UNLOAD_RADIUS;
+    config.memory_budget_bytes = 0;
+    config.integrate_budget_ms = integrate_budget_ms;
+    memset(w->expected, 0, sizeof(bool) * w->grid * w->grid);
+    return poc_world_stream_open(w->path, scene, &config);
+}
+
+// Closing must take every streamed object out of the scene
+static bool close_stream(poc_world_stream *stream, poc_scene *scene, const char *phase) {
+    poc_world_stream_stats stats;
+    poc_world_stream_get_stats(stream, &stats);
+    printf("%-8s %8u cells evicted  %8.3f ms max update\n", phase, (unsigned)stats.cells_evicted, stats.max_update_ms);
+
+    poc_world_stream_close(stream);
+    if (scene->object_count != 0) {
+        printf("%s: %u objects left in the scene after closing\n", phase, scene->object_count);
+        return false;
+    }
+    return true;
+}
+
+static bool run_walk(world *w, poc_scene *scene) {
+    poc_world_stream *stream = open_stream(w, scene, 2.0);
+    if (!stream) {
+        return false;
+    }
+
+    // Diagonal steps shorter than the hysteresis band, then back again
+    float extent = (float)w->grid * CELL_SIZE;
+    bool ok = true;
+    uint32_t updates = 0;
+    for (int pass = 0; pass < 2 && ok; pass++) {
+        for (float t = 0.3f; t < extent && ok; t += 7.0f) {
+            float along = pass == 0 ? t : extent - t;
+            vec3 position = {along, 0.0f, 0.5f * extent + 0.37f * (along - 0.5f * extent)};
+            ok = settle(w, stream, scene, position, &updates);
+            if (ok) {
+                expect_around(w, position);
+                ok = check_expected(w, "walk", position);
+            }
+        }
+    }
+
+    return close_stream(stream, scene, "walk") && ok;
+}
+
+static bool run_budget(world *w, poc_scene *scene) {
+    poc_world_stream *stream = open_stream(w, scene, 0.0);
+    if (!stream) {
+        return false;
+    }
+
+    vec3 position = {0.5f * (float)w->grid * CELL_SIZE + 0.3f, 0.0f, 0.5f * (float)w->grid * CELL_SIZE + 0.3f};
+    bool ok = true;
+    uint32_t updates = 0;
+    for (uint32_t i = 0; i < SETTLE_LIMIT && ok; i++) {
+        poc_world_stream_update(stream, position);
+        updates++;
+        ok = count_cells(w, scene);
+
+        poc_world_stream_stats stats;
+        poc_world_stream_get_stats(stream, &stats);
+        if (ok && stats.cells_resident * w->objects_per_cell > updates) {
+            printf("budget: %u cells resident after %u updates at one object per update\n",
+                   stats.cells_resident, updates);
+            ok = false;
+        }
+        if (stats.cells_loading == 0) {
+            break;
+        }
+        poc_sleep(0.0002);
+    }
+
+    if (ok) {
+        expect_around(w, position);
+        ok = check_expected(w, "budget", position);
+    }
+    return close_stream(stream, scene, "budget") && ok;
+}
+
+static atomic_bool g_release_workers;
+
+static void block_worker(void *user_data) {
+    (void)user_data;
+    while (!atomic_load(&g_release_workers)) {
+        poc_sleep(0.0005);
+    }
+}
+
+static bool run_inflight(world *w, poc_scene *scene) {
+    poc_world_stream *stream = open_stream(w, scene, 2.0);
+    if (!stream) {
+        return false;
+    }
+
+    // Occupy every worker so the requested loads stay queued
+    poc_job_counter blockers = {0};
+    atomic_store(&g_release_workers, false);
+    uint32_t workers = poc_jobs_get_worker_count();
+    for (uint32_t i = 0; i < workers; i++) {
+        poc_job_submit(block_worker, NULL, &blockers);
+    }
+
+    vec3 near = {5.3f, 0.0f, 5.3f};
+    vec3 far = {-10.0f * UNLOAD_RADIUS, 0.0f, -10.0f * UNLOAD_RADIUS};
+    poc_world_stream_update(stream, near);
+
+    poc_world_stream_stats stats;
+    poc_world_stream_get_stats(stream, &stats);
+    bool ok = stats.cells_loading > 0;
+    if (!ok) {
+        printf("inflight: no cells were requested\n");
+    }
+
+    // Leave while every load is still queued, then let them run
+    poc_world_stream_update(stream, far);
+    atomic_store(&g_release_workers, true);
+    poc_job_wait(&blockers);
+
+    uint32_t updates = 0;
+    ok = ok && settle(w, stream, scene, far, &updates);
+    poc_world_stream_get_stats(stream, &stats);
+    if (ok && (scene->object_count != 0 || stats.resident_bytes != 0)) {
+        printf("inflight: %u objects and %llu mesh bytes left after leaving loading cells\n",
+               scene->object_count, (unsigned long long)stats.resident_bytes);
+        ok = false;
+    }
+
+    // The abandoned loads must not keep holding load slots
+    if (ok) {
+        ok = settle(w, stream, scene, near, &updates);
+        expect_around(w, near);
+        ok = ok && check_expected(w, "inflight", near);
+    }
+
+    return close_stream(stream, scene, "inflight") && ok;
+}
+
+static bool write_world(const char *directory, const char *path, uint32_t grid, uint32_t objects_per_cell) {
+    char mesh_paths[2][BENCH_PATH_SIZE];
+    bench_path(mesh_paths[0], directory, "rock.obj");
+    bench_path(mesh_paths[1], directory, "tree.obj");
+    if (!bench_write_grid_file(mesh_paths[0], &(bench_grid){.side = 4, .bumpy = true}) ||
+        !bench_write_grid_file(mesh_paths[1], &(bench_grid){.side = 8, .attributes = true})) {
+        printf("Could not write meshes into %s\n", directory);
+        return false;
+    }
+
+    poc_scene *scene = poc_scene_create();
+    poc_mesh *meshes[2] = {poc_asset_acquire_mesh(mesh_paths[0]), poc_asset_acquire_mesh(mesh_paths[1])};
+    bool ok = scene && meshes[0] && meshes[1];
+
+    for (uint32_t z = 0; ok && z < grid; z++) {
+        for (uint32_t x = 0; ok && x < grid; x++) {
+            for (uint32_t i = 0; ok && i < objects_per_cell; i++) {
+                char name[64];
+                snprintf(name, sizeof(name), "prop_%u_%u_%u", x, z, i);
+                poc_scene_object *obj = poc_scene_object_create(name, poc_scene_get_next_object_id(scene));
+                if (!obj) {
+                    ok = false;
+                    break;
+                }
+
+                // Spread inside the cell, clear of its edges
+                float u = 0.1f + 0.8f * (float)(i % 4) / 3.0f;
+                float v = 0.1f + 0.8f * (float)((i / 4) % 4) / 3.0f;
+                poc_scene_object_set_position(obj, (vec3){((float)x + u) * CELL_SIZE, 0.0f, ((float)z + v) * CELL_SIZE});
+                poc_scene_object_set_mesh(obj, meshes[i % 2]);
+                ok = poc_scene_add_object(scene, obj);
+                if (!ok) {
+                    poc_scene_object_destroy(obj);
+                }
+            }
+        }
+    }
+
+    ok = ok && poc_scene_save_partitioned(scene, path, CELL_SIZE);
+    if (scene) {
+        poc_scene_destroy(scene, true);
+    }
+    poc_asset_release_mesh(meshes[0]);
+    poc_asset_release_mesh(meshes[1]);
+    poc_asset_purge();
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    int grid = argc > 1 ? atoi(argv[1]) : 12;
+    int objects_per_cell = argc > 2 ? atoi(argv[2]) : 16;
+    if (grid < 4) grid = 4;
+    if (objects_per_cell < 1) objects_per_cell = 1;
+
+    poc_mesh_cache_set_enabled(false);
+    poc_jobs_init(0);
+
+    char directory[BENCH_PATH_SIZE], path[BENCH_PATH_SIZE];
+    if (!bench_make_temp_dir(directory, NULL, "world_stream_bench")) {
+        return 1;
+    }
+    bench_path(path, directory, "world.scene");
+
+    world w = {
+        .path = path,
+        .grid = (uint32_t)grid,
+        .objects_per_cell = (uint32_t)objects_per_cell,
+        .counts = calloc((size_t)grid * (size_t)grid, sizeof(uint32_t)),
+        .expected = calloc((size_t)grid * (size_t)grid, sizeof(bool)),
+    };
+    poc_scene *scene = poc_scene_create();
+
+    bool ok = w.counts && w.expected && scene &&
+              write_world(directory, path, w.grid, w.objects_per_cell);
+    if (ok) {
+        printf("\n%u x %u cells of %.0f units, %u objects each, %u worker threads\n",
+               w.grid, w.grid, CELL_SIZE, w.objects_per_cell, poc_jobs_get_worker_count());
+    }
+    ok = ok && run_walk(&w, scene);
+    ok = ok && run_budget(&w, scene);
+    ok = ok && run_inflight(&w, scene);
+    printf("%s\n", ok ? "All streaming checks passed" : "Streaming checks failed");
+
+    if (scene) {
+        poc_scene_destroy(scene, true);
+    }
+    free(w.counts);
+    free(w.expected);
+    poc_jobs_shutdown();
+    bench_remove_temp_dir(directory);
+    return ok ? 0 : 1;
+}